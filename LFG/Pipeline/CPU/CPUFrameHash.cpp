@@ -0,0 +1,192 @@
+#include "CPUFrameHash.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LFG_CPU_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace CPU;
+
+// xxHash32 primes, same as CS_FrameHash
+static constexpr uint32_t Prime1 = 2654435761u;
+static constexpr uint32_t Prime2 = 2246822519u;
+static constexpr uint32_t Prime3 = 3266489917u;
+static constexpr uint32_t Prime4 = 668265263u;
+static constexpr uint32_t Prime5 = 374761393u;
+
+static inline uint32_t RotateLeft(uint32_t x, uint32_t r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t Round(uint32_t acc, uint32_t input)
+{
+	return RotateLeft(acc + input * Prime2, 13) * Prime1;
+}
+
+static inline uint32_t Avalanche(uint32_t h)
+{
+	h ^= h >> 15;
+	h *= Prime2;
+	h ^= h >> 13;
+	h *= Prime3;
+	h ^= h >> 16;
+	return h;
+}
+
+static inline uint32_t Lane(const uint32_t* bits, uint32_t index)
+{
+	uint32_t lane = Prime5 + index * Prime4;
+	lane = Round(lane, bits[0]);
+	lane = Round(lane, bits[1]);
+	lane = Round(lane, bits[2]);
+	lane = Round(lane, bits[3]);
+	return Avalanche(lane);
+}
+
+#ifdef LFG_CPU_SSE2
+// SSE2 has no 32-bit mullo: two 32x32->64 products on the even / odd lanes ('b' is the same in every lane)
+static inline __m128i MulLo32(__m128i a, __m128i b)
+{
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline __m128i Round4(__m128i acc, __m128i input, __m128i prime1, __m128i prime2)
+{
+	acc = _mm_add_epi32(acc, MulLo32(input, prime2));
+	acc = _mm_or_si128(_mm_slli_epi32(acc, 13), _mm_srli_epi32(acc, 19));
+	return MulLo32(acc, prime1);
+}
+
+static inline __m128i Avalanche4(__m128i h, __m128i prime2, __m128i prime3)
+{
+	h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+	h = MulLo32(h, prime2);
+	h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+	h = MulLo32(h, prime3);
+	return _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+}
+#endif
+
+uint32_t CPUFrameHash::TileHash(const ColorImage& frame, int x0, int y0, int x1, int y1)
+{
+	static_assert(sizeof(Float4) == 4 * sizeof(uint32_t), "Float4 is hashed as 4 raw words");
+
+	// The lanes are summed, so the order they are visited in does not matter
+	uint32_t sum = 0;
+	for (int y = y0; y < y1; ++y)
+	{
+		const uint32_t rowIndex = (uint32_t)(y - y0) * TileSize;
+		const Float4* row = &frame.At(x0, y);
+		const int count = x1 - x0;
+		int x = 0;
+
+#ifdef LFG_CPU_SSE2
+		const __m128i prime1 = _mm_set1_epi32((int)Prime1);
+		const __m128i prime2 = _mm_set1_epi32((int)Prime2);
+		const __m128i prime3 = _mm_set1_epi32((int)Prime3);
+		__m128i sum4 = _mm_setzero_si128();
+		// Prime5 + index * Prime4 for the 4 texels, advanced by 4 * Prime4
+		const uint32_t first = Prime5 + rowIndex * Prime4;
+		__m128i seed = _mm_setr_epi32((int)first, (int)(first + Prime4), (int)(first + 2 * Prime4), (int)(first + 3 * Prime4));
+		const __m128i seedStep = _mm_set1_epi32((int)(4 * Prime4));
+		for (; x + 4 <= count; x += 4)
+		{
+			// 4 texels, transposed to one register per channel
+			__m128i t0 = _mm_loadu_si128((const __m128i*)(row + x));
+			__m128i t1 = _mm_loadu_si128((const __m128i*)(row + x + 1));
+			__m128i t2 = _mm_loadu_si128((const __m128i*)(row + x + 2));
+			__m128i t3 = _mm_loadu_si128((const __m128i*)(row + x + 3));
+			__m128i lo01 = _mm_unpacklo_epi32(t0, t1), hi01 = _mm_unpackhi_epi32(t0, t1);
+			__m128i lo23 = _mm_unpacklo_epi32(t2, t3), hi23 = _mm_unpackhi_epi32(t2, t3);
+			__m128i r = _mm_unpacklo_epi64(lo01, lo23);
+			__m128i g = _mm_unpackhi_epi64(lo01, lo23);
+			__m128i b = _mm_unpacklo_epi64(hi01, hi23);
+			__m128i a = _mm_unpackhi_epi64(hi01, hi23);
+
+			__m128i lane = seed;
+			seed = _mm_add_epi32(seed, seedStep);
+			lane = Round4(lane, r, prime1, prime2);
+			lane = Round4(lane, g, prime1, prime2);
+			lane = Round4(lane, b, prime1, prime2);
+			lane = Round4(lane, a, prime1, prime2);
+			sum4 = _mm_add_epi32(sum4, Avalanche4(lane, prime2, prime3));
+		}
+		uint32_t partial[4];
+		_mm_storeu_si128((__m128i*)partial, sum4);
+		sum += partial[0] + partial[1] + partial[2] + partial[3];
+#endif
+
+		for (; x < count; ++x)
+		{
+			uint32_t bits[4];
+			std::memcpy(bits, &row[x], sizeof(bits));
+			sum += Lane(bits, rowIndex + (uint32_t)x);
+		}
+	}
+	return Avalanche(sum);
+}
+
+void CPUFrameHash::Hash(const ColorImage& frame)
+{
+	const int tilesX = (frame.Width + TileSize - 1) / TileSize;
+	const int tilesY = (frame.Height + TileSize - 1) / TileSize;
+
+	m_HadHistory = m_Unchanged.SameSize(tilesX, tilesY) && m_Hashes.size() == (size_t)tilesX * tilesY;
+	m_PrevHashes.swap(m_Hashes);
+	m_Hashes.resize((size_t)tilesX * tilesY);
+	if (!m_Unchanged.SameSize(tilesX, tilesY)) m_Unchanged.Resize(tilesX, tilesY);
+
+	m_FrameWidth = frame.Width;
+	m_FrameHeight = frame.Height;
+	m_ChangedCount = 0;
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			const int x0 = tx * TileSize;
+			const int y0 = ty * TileSize;
+			const uint32_t hash = TileHash(frame, x0, y0, std::min(x0 + TileSize, frame.Width), std::min(y0 + TileSize, frame.Height));
+
+			const size_t tile = (size_t)ty * tilesX + tx;
+			const bool unchanged = m_HadHistory && m_PrevHashes[tile] == hash;
+			m_Hashes[tile] = hash;
+			m_Unchanged.At(tx, ty) = unchanged ? 1 : 0;
+			if (!unchanged) ++m_ChangedCount;
+		}
+	}
+}
+
+void CPUFrameHash::MapUnchanged(int flowWidth, int flowHeight, Image<uint8_t>& flowTiles) const
+{
+	const int tilesX = (flowWidth + TileSize - 1) / TileSize;
+	const int tilesY = (flowHeight + TileSize - 1) / TileSize;
+	if (!flowTiles.SameSize(tilesX, tilesY)) flowTiles.Resize(tilesX, tilesY);
+	if (m_Unchanged.Empty() || flowWidth <= 0 || flowHeight <= 0) return;
+
+	const float scaleX = (float)m_FrameWidth / flowWidth;
+	const float scaleY = (float)m_FrameHeight / flowHeight;
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			// Frame pixels the flow tile's texels are sampled from, widened by the filter's reach
+			const int x0 = std::max((int)std::floor((tx * TileSize * scaleX - FilterReach) / TileSize), 0);
+			const int y0 = std::max((int)std::floor((ty * TileSize * scaleY - FilterReach) / TileSize), 0);
+			const int x1 = std::min((int)std::floor(((tx + 1) * TileSize * scaleX + FilterReach) / TileSize), m_Unchanged.Width - 1);
+			const int y1 = std::min((int)std::floor(((ty + 1) * TileSize * scaleY + FilterReach) / TileSize), m_Unchanged.Height - 1);
+
+			uint8_t unchanged = 1;
+			for (int y = y0; y <= y1; ++y)
+			{
+				for (int x = x0; x <= x1; ++x)
+					unchanged = std::min(unchanged, m_Unchanged.At(x, y));
+			}
+			flowTiles.At(tx, ty) = unchanged;
+		}
+	}
+}
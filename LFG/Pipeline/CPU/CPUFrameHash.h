@@ -0,0 +1,41 @@
+#pragma once
+#include "CPUImage.h"
+#include <cstdint>
+
+// CPU reference implementation of the per-tile frame hash (CS_FrameHash.hlsl / FrameHash).
+// Bit-exact with the GPU: one xxHash32 lane per texel (seeded with its index in the tile, rounds over the raw
+// float bits), lanes summed and avalanched per 16x16 tile. Four texels per SSE2 step where available.
+class CPUFrameHash
+{
+public:
+	CPUFrameHash() = default;
+	~CPUFrameHash() = default;
+
+	// Hashes every tile of 'frame' and compares it with the last frame hashed (a new size drops the history)
+	void Hash(const CPU::ColorImage& frame);
+
+	// One texel per tile, 1 = same hash as last frame (CPUOpticalFlow::SetUnchangedTiles)
+	const CPU::Image<uint8_t>& GetUnchanged() const { return m_Unchanged; }
+	// GetUnchanged carried over to the tiles of a 'flowWidth' x 'flowHeight' flow downscaled from the hashed frame
+	// (CSMapTiles): a flow tile is unchanged only if every frame tile its texels sample from is
+	void MapUnchanged(int flowWidth, int flowHeight, CPU::Image<uint8_t>& flowTiles) const;
+	const std::vector<uint32_t>& GetHashes() const { return m_Hashes; }
+	int GetChangedCount() const { return m_ChangedCount; }
+	// Every tile matched: SceneCut treats the frame like a cut, nothing is estimated or generated
+	bool IsDuplicate() const { return m_HadHistory && m_ChangedCount == 0; }
+
+	// Hash of the pixel rectangle [x0, x1) x [y0, y1) (at most TileSize x TileSize)
+	static uint32_t TileHash(const CPU::ColorImage& frame, int x0, int y0, int x1, int y1);
+
+	static constexpr int TileSize = 16; // FrameHash::TileSize
+	static constexpr int FilterReach = 4; // FILTER_REACH in CS_FrameHash, frame pixels CPUUpscale reads around a sample
+
+private:
+	std::vector<uint32_t> m_Hashes;
+	std::vector<uint32_t> m_PrevHashes;
+	CPU::Image<uint8_t> m_Unchanged;
+	int m_FrameWidth = 0;
+	int m_FrameHeight = 0;
+	int m_ChangedCount = 0;
+	bool m_HadHistory = false; // The last Hash had something to compare against
+};
@@ -0,0 +1,309 @@
+#include "CPUFrameInterpolation.h"
+#include <thread>
+
+using namespace CPU;
+
+// [Forward Warp] Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12), the smallest wins (CS_MotionSplat)
+static constexpr uint32_t SplatEmpty = 0xFFFFFFFFu;
+static constexpr int SplatOffsetBias = 2048;
+
+// Splits [0, count) into one contiguous band per thread, band i runs on thread i
+template<typename Fn>
+static void ForEachBand(int count, int threadCount, Fn&& fn)
+{
+	if (threadCount <= 1)
+	{
+		fn(0, 0, count);
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	workers.reserve(threadCount);
+	for (int i = 0; i < threadCount; ++i)
+		workers.emplace_back([&fn, i, count, threadCount]() { fn(i, count * i / threadCount, count * (i + 1) / threadCount); });
+	for (std::thread& worker : workers) worker.join();
+}
+
+Float4 CPUFrameInterpolation::ClampToNeighborhood(const ColorImage& frame, int x, int y, const Float4& color, float strength)
+{
+	if (strength <= 0.0f) return color;
+
+	// 5-tap neighborhood (Center + Plus), same as the shaders
+	const Float4 taps[5] = { frame.Clamped(x, y), frame.Clamped(x, y + 1), frame.Clamped(x, y - 1), frame.Clamped(x + 1, y), frame.Clamped(x - 1, y) };
+	Float4 lo = taps[0], hi = taps[0];
+	for (const Float4& t : taps)
+	{
+		lo = { std::min(lo.r, t.r), std::min(lo.g, t.g), std::min(lo.b, t.b), std::min(lo.a, t.a) };
+		hi = { std::max(hi.r, t.r), std::max(hi.g, t.g), std::max(hi.b, t.b), std::max(hi.a, t.a) };
+	}
+
+	Float4 clamped = {
+		std::clamp(color.r, lo.r, hi.r),
+		std::clamp(color.g, lo.g, hi.g),
+		std::clamp(color.b, lo.b, hi.b),
+		std::clamp(color.a, lo.a, hi.a) };
+	return Lerp(color, clamped, strength);
+}
+
+void CPUFrameInterpolation::Interpolate(const ColorImage& texCurrent,
+	const ColorImage& texPrev,
+	const MotionField& texMotion,
+	ColorImage& texGenerated,
+	float factor,
+	float ghostingStrength,
+	int motionBlockSize,
+	const VisibilityMap* visibility,
+	int visibilityScale,
+	bool forwardWarp,
+	const CPULumaPyramid* luma,
+	bool skipStaticTiles)
+{
+	const int width = texCurrent.Width;
+	const int height = texCurrent.Height;
+	if (!texGenerated.SameSize(width, height)) texGenerated.Resize(width, height);
+
+	// [Native Synthesis] Motion (and visibility) at the pyramid's size, warp at texCurrent's
+	const MotionField* motionField = &texMotion;
+	if (luma && luma->GetCurrent().Empty()) luma = nullptr;
+	const Float2 flowScale = luma ?
+		Float2{ (float)width / luma->GetCurrent().Width, (float)height / luma->GetCurrent().Height } : Float2{ 1.0f, 1.0f };
+	if (forwardWarp && luma)
+	{
+		ProjectMotion(luma->GetCurrent(), luma->GetPrevious(), texMotion, m_WarpMotion, factor, motionBlockSize, visibility, visibilityScale);
+		motionField = &m_WarpMotion;
+		motionBlockSize = 1;
+	}
+
+	auto synthesize = [&](int x, int y)
+	{
+		Float2 motion = SampleMotion(*motionField, (float)x, (float)y, motionBlockSize, flowScale);
+
+		Float2 posPrev = { x + motion.x * factor, y + motion.y * factor };
+		Float2 posCurr = { x - motion.x * (1.0f - factor), y - motion.y * (1.0f - factor) };
+		Float4 pixelPrev = SampleBilinear(texPrev, posPrev.x, posPrev.y);
+		Float4 pixelCurr = SampleBilinear(texCurrent, posCurr.x, posCurr.y);
+
+		Float4 result = Lerp(pixelPrev, pixelCurr, factor);
+
+		// [Occlusion] Drop the source the content is not visible in
+		float consistency = 0.0f; // Unknown without a visibility map, always clamp
+		if (visibility)
+		{
+			// Visibility texels sit at cell centers, same mapping as a block motion field
+			float currVisible = SampleMotion(*visibility, (posCurr.x + 0.5f) / flowScale.x - 0.5f, (posCurr.y + 0.5f) / flowScale.y - 0.5f, visibilityScale).x;
+			float prevVisible = SampleMotion(*visibility, (posPrev.x + 0.5f) / flowScale.x - 0.5f, (posPrev.y + 0.5f) / flowScale.y - 0.5f, visibilityScale).y;
+
+			float weightPrev = (1.0f - factor) * currVisible;
+			float weightCurr = factor * prevVisible;
+			float weightSum = weightPrev + weightCurr;
+			if (weightSum > 1e-3f)
+				result = (pixelPrev * weightPrev + pixelCurr * weightCurr) * (1.0f / weightSum);
+
+			consistency = std::min(currVisible, prevVisible);
+		}
+
+		float strength = consistency < ConsistentLevel ? ghostingStrength : 0.0f;
+		texGenerated.At(x, y) = ClampToNeighborhood(texCurrent, x, y, result, strength);
+	};
+
+	// [Tile Skip] Classified on the field that is sampled (after the forward warp), like on the GPU
+	if (skipStaticTiles)
+	{
+		m_Tiles.Classify(texCurrent, texPrev, *motionField, motionBlockSize, flowScale);
+		for (int i = 0; i < m_Tiles.GetDynamicCount(); ++i)
+		{
+			int x0, y0, x1, y1;
+			CPUTileClassifier::TileBounds(m_Tiles.GetDynamicTile(i), width, height, x0, y0, x1, y1);
+			for (int y = y0; y < y1; ++y)
+			{
+				for (int x = x0; x < x1; ++x) synthesize(x, y);
+			}
+		}
+		m_Tiles.CopyStatic(texCurrent, texGenerated);
+		return;
+	}
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x) synthesize(x, y);
+	}
+}
+
+bool CPUFrameInterpolation::ClaimedVector(const MotionField& texMotion, int motionBlockSize, int x, int y, Float2& v) const
+{
+	const uint32_t packed = m_Splat.At(x, y);
+	v = {};
+	if (packed == SplatEmpty) return false;
+
+	const int ox = (int)((packed >> 12) & 0xFFF) - SplatOffsetBias;
+	const int oy = (int)(packed & 0xFFF) - SplatOffsetBias;
+	v = SampleMotion(texMotion, (float)(x + ox), (float)(y + oy), motionBlockSize);
+	return true;
+}
+
+void CPUFrameInterpolation::ProjectMotion(const LumaImage& lumaCurrent,
+	const LumaImage& lumaPrev,
+	const MotionField& texMotion,
+	MotionField& projected,
+	float factor,
+	int motionBlockSize,
+	const VisibilityMap* visibility,
+	int visibilityScale,
+	int threadCount)
+{
+	const int width = lumaCurrent.Width;
+	const int height = lumaCurrent.Height;
+	if (!projected.SameSize(width, height)) projected.Resize(width, height);
+	if (motionBlockSize < 1) motionBlockSize = 1;
+	if (visibilityScale < 1) visibilityScale = 1;
+
+	if (threadCount <= 0) threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+	threadCount = std::clamp(threadCount, 1, std::max(1, height));
+	m_SplatTiles.resize(threadCount);
+
+	// 1. Splat: each thread projects its band of source rows into its own tile, no atomics needed
+	ForEachBand(height, threadCount, [&](int thread, int rowBegin, int rowEnd)
+	{
+		struct Claim { int X, Y; uint32_t Packed; };
+		std::vector<Claim> claims;
+		claims.reserve((size_t)(rowEnd - rowBegin) * width);
+		int minRow = height, maxRow = -1;
+
+		for (int y = rowBegin; y < rowEnd; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				// Content at p in the current frame was at p + v in the previous one, at p + v * (1 - factor) in between
+				const Float2 v = SampleMotion(texMotion, (float)x, (float)y, motionBlockSize);
+				const int tx = (int)std::round(x + v.x * (1.0f - factor));
+				const int ty = (int)std::round(y + v.y * (1.0f - factor));
+				if (!lumaCurrent.Contains(tx, ty)) continue; // Leaves the frame
+				if (std::abs(x - tx) >= SplatOffsetBias || std::abs(y - ty) >= SplatOffsetBias) continue;
+
+				// Priority: 3x3 match cost of the vector, plus the forward/backward disagreement if known
+				const int mx = (int)std::round(x + v.x);
+				const int my = (int)std::round(y + v.y);
+				float sad = 0.0f;
+				for (int wy = -1; wy <= 1; ++wy)
+				{
+					for (int wx = -1; wx <= 1; ++wx)
+						sad += AbsDiff(lumaCurrent.Clamped(x + wx, y + wy), lumaPrev.Clamped(mx + wx, my + wy));
+				}
+				float cost = sad / 9.0f;
+				if (visibility) cost += 1.0f - SampleMotion(*visibility, (float)x, (float)y, visibilityScale).x;
+
+				const uint32_t quantized = (uint32_t)(std::clamp(cost, 0.0f, 1.0f) * 255.0f + 0.5f);
+				const uint32_t packed = (quantized << 24) | ((uint32_t)(x - tx + SplatOffsetBias) << 12) | (uint32_t)(y - ty + SplatOffsetBias);
+				claims.push_back({ tx, ty, packed });
+				minRow = std::min(minRow, ty);
+				maxRow = std::max(maxRow, ty);
+			}
+		}
+
+		SplatTile& tile = m_SplatTiles[thread];
+		tile.FirstRow = minRow;
+		tile.Claims.Resize(width, std::max(0, maxRow - minRow + 1), SplatEmpty);
+		for (const Claim& claim : claims)
+		{
+			uint32_t& slot = tile.Claims.At(claim.X, claim.Y - minRow);
+			slot = std::min(slot, claim.Packed);
+		}
+	});
+
+	// 2. Merge: smallest claim over every tile reaching the row
+	m_Splat.Resize(width, height, SplatEmpty);
+	ForEachBand(height, threadCount, [&](int, int rowBegin, int rowEnd)
+	{
+		for (const SplatTile& tile : m_SplatTiles)
+		{
+			const int first = std::max(rowBegin, tile.FirstRow);
+			const int last = std::min(rowEnd, tile.FirstRow + tile.Claims.Height);
+			for (int y = first; y < last; ++y)
+			{
+				const uint32_t* src = &tile.Claims.At(0, y - tile.FirstRow);
+				uint32_t* dst = &m_Splat.At(0, y);
+				for (int x = 0; x < width; ++x) dst[x] = std::min(dst[x], src[x]);
+			}
+		}
+	});
+
+	// 3. Resolve: claimed pixels take the claimant's vector, holes the slowest claim around them
+	ForEachBand(height, threadCount, [&](int, int rowBegin, int rowEnd)
+	{
+		static const int dirs[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+		for (int y = rowBegin; y < rowEnd; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				Float2 v;
+				if (ClaimedVector(texMotion, motionBlockSize, x, y, v))
+				{
+					projected.At(x, y) = v;
+					continue;
+				}
+
+				// Nothing claimed around: keep the backward-lookup vector
+				Float2 best = SampleMotion(texMotion, (float)x, (float)y, motionBlockSize);
+				float bestLengthSq = 1e9f;
+				for (const auto& dir : dirs)
+				{
+					for (int r = 1; r <= WarpHoleRadius; r *= 2)
+					{
+						const int px = x + dir[0] * r;
+						const int py = y + dir[1] * r;
+						if (!m_Splat.Contains(px, py)) break;
+						if (!ClaimedVector(texMotion, motionBlockSize, px, py, v)) continue;
+
+						if (LengthSq(v) < bestLengthSq)
+						{
+							bestLengthSq = LengthSq(v);
+							best = v;
+						}
+						break;
+					}
+				}
+				projected.At(x, y) = best;
+			}
+		}
+	});
+}
+
+void CPUFrameInterpolation::Extrapolate(const ColorImage& texCurrent,
+	const MotionField& texMotion,
+	ColorImage& texGenerated,
+	float factor,
+	float ghostingStrength,
+	int motionBlockSize)
+{
+	const int width = texCurrent.Width;
+	const int height = texCurrent.Height;
+	if (!texGenerated.SameSize(width, height)) texGenerated.Resize(width, height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			// Content at p in frame N+factor was at p + motion * factor in frame N
+			Float2 motion = SampleMotion(texMotion, (float)x, (float)y, motionBlockSize);
+			Float2 src = { x + motion.x * factor, y + motion.y * factor };
+
+			// [Hole Filling]
+			// If the vector at the source disagrees with ours, p is being uncovered (or covered).
+			// The revealed content belongs to the background, which is the slower of the two vectors.
+			Float2 srcMotion = SampleMotion(texMotion, src.x, src.y, motionBlockSize);
+			if (Length(srcMotion - motion) > HoleTolerance)
+			{
+				if (LengthSq(srcMotion) < LengthSq(motion)) motion = srcMotion;
+				src = { x + motion.x * factor, y + motion.y * factor };
+			}
+
+			Float4 result;
+			if (src.x < -0.5f || src.y < -0.5f || src.x > width - 0.5f || src.y > height - 0.5f)
+				result = texCurrent.At(x, y); // Nothing to pull from outside the frame, hold the real pixel
+			else
+				result = SampleBilinear(texCurrent, src.x, src.y);
+
+			texGenerated.At(x, y) = ClampToNeighborhood(texCurrent, x, y, result, ghostingStrength);
+		}
+	}
+}
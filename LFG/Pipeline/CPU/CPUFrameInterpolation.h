@@ -0,0 +1,85 @@
+#pragma once
+#include "CPUImage.h"
+#include "CPULumaPyramid.h"
+#include "CPUTileClassifier.h"
+#include <cstdint>
+
+// CPU reference implementation of the frame synthesis stage (CS_Interpolate / CS_Extrapolate).
+class CPUFrameInterpolation
+{
+public:
+	CPUFrameInterpolation() = default;
+	~CPUFrameInterpolation() = default;
+
+	// Generates the frame at 'factor' (0 = prev, 1 = current) between two real frames.
+	// motionBlockSize > 1: texMotion holds one vector per block (sampled bilinearly).
+	// visibility (CPUOpticalFlow::GetVisibility): occluded pixels take only the frame they are visible in,
+	// and the ghosting clamp is skipped where both flows agree.
+	// forwardWarp: sample with the motion projected to 'factor' (ProjectMotion) instead of the backward lookup,
+	// needs the luma pyramid of the two frames (ignored without it, as on the GPU).
+	// [Native Synthesis] The pyramid sets the flow resolution: when it is smaller than texCurrent, texMotion and
+	// visibility are at its size and are sampled bilinearly with the vectors scaled up to texCurrent's pixels.
+	// skipStaticTiles: [Tile Skip] only the dynamic tiles of GetTiles() are synthesized, static ones are copied.
+	void Interpolate(const CPU::ColorImage& texCurrent,
+		const CPU::ColorImage& texPrev,
+		const CPU::MotionField& texMotion,
+		CPU::ColorImage& texGenerated,
+		float factor,
+		float ghostingStrength,
+		int motionBlockSize = 1,
+		const CPU::VisibilityMap* visibility = nullptr,
+		int visibilityScale = 1,
+		bool forwardWarp = false,
+		const CPULumaPyramid* luma = nullptr,
+		bool skipStaticTiles = false);
+
+	// [Tile Skip] Classification of the last Interpolate(skipStaticTiles)
+	const CPUTileClassifier& GetTiles() const { return m_Tiles; }
+
+	// [Forward Warp] Port of CS_MotionSplat.hlsl + CS_MotionResolve.hlsl: per-pixel motion valid at time 'factor'.
+	// Each thread splats a band of source rows into its own tile (the rows its vectors reach), the tiles are
+	// then merged with the same min rule as InterlockedMin, so the result does not depend on the thread count.
+	// threadCount = 0: one thread per hardware thread.
+	void ProjectMotion(const CPU::LumaImage& lumaCurrent,
+		const CPU::LumaImage& lumaPrev,
+		const CPU::MotionField& texMotion,
+		CPU::MotionField& projected,
+		float factor,
+		int motionBlockSize = 1,
+		const CPU::VisibilityMap* visibility = nullptr,
+		int visibilityScale = 1,
+		int threadCount = 0);
+
+	// Predicts frame N + factor from frame N and the N-1 -> N motion field (no added latency).
+	// Disoccluded pixels are filled from the background (shorter) vector.
+	void Extrapolate(const CPU::ColorImage& texCurrent,
+		const CPU::MotionField& texMotion,
+		CPU::ColorImage& texGenerated,
+		float factor,
+		float ghostingStrength,
+		int motionBlockSize = 1);
+
+	// Vector disagreement (pixels) above which a target pixel is treated as a disocclusion
+	static constexpr float HoleTolerance = 1.0f;
+	// Visibility above which both sources are trusted (CONSISTENT_LEVEL in CS_Interpolate)
+	static constexpr float ConsistentLevel = 0.99f;
+	// [Forward Warp] Farthest claim (pixels) a hole takes its vector from (HOLE_RADIUS in CS_MotionResolve)
+	static constexpr int WarpHoleRadius = 16;
+
+private:
+	static CPU::Float4 ClampToNeighborhood(const CPU::ColorImage& frame, int x, int y, const CPU::Float4& color, float strength);
+
+	// [Forward Warp] Rows [FirstRow, FirstRow + Claims.Height) of the splat target, written by one thread
+	struct SplatTile
+	{
+		int FirstRow = 0;
+		CPU::Image<uint32_t> Claims;
+	};
+
+	bool ClaimedVector(const CPU::MotionField& texMotion, int motionBlockSize, int x, int y, CPU::Float2& v) const;
+
+	std::vector<SplatTile> m_SplatTiles;
+	CPU::Image<uint32_t> m_Splat; // Merged claims
+	CPU::MotionField m_WarpMotion; // Interpolate(forwardWarp)
+	CPUTileClassifier m_Tiles;
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// Portable (D3D-free) image containers used by the CPU reference pipeline.
+// Coordinates follow the compute shaders: integer positions are texel centers,
+// so SampleBilinear(img, x, y) matches SampleLevel(LinearSampler, (xy + 0.5) / size).
+namespace CPU
+{
+	struct Float2
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	struct Float4
+	{
+		float r = 0.0f;
+		float g = 0.0f;
+		float b = 0.0f;
+		float a = 1.0f;
+	};
+
+	inline Float2 operator+(const Float2& a, const Float2& b) { return { a.x + b.x, a.y + b.y }; }
+	inline Float2 operator-(const Float2& a, const Float2& b) { return { a.x - b.x, a.y - b.y }; }
+	inline Float2 operator*(const Float2& a, float s) { return { a.x * s, a.y * s }; }
+	inline float LengthSq(const Float2& v) { return v.x * v.x + v.y * v.y; }
+	inline float Length(const Float2& v) { return std::sqrt(LengthSq(v)); }
+
+	inline Float4 operator+(const Float4& a, const Float4& b) { return { a.r + b.r, a.g + b.g, a.b + b.b, a.a + b.a }; }
+	inline Float4 operator-(const Float4& a, const Float4& b) { return { a.r - b.r, a.g - b.g, a.b - b.b, a.a - b.a }; }
+	inline Float4 operator*(const Float4& a, float s) { return { a.r * s, a.g * s, a.b * s, a.a * s }; }
+
+	inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+	inline Float2 Lerp(const Float2& a, const Float2& b, float t) { return a + (b - a) * t; }
+	inline Float4 Lerp(const Float4& a, const Float4& b, float t) { return a + (b - a) * t; }
+
+	// Rec.709 luma, same weights as CS_LumaPyramid
+	inline float Luma(const Float4& c) { return c.r * 0.2126f + c.g * 0.7152f + c.b * 0.0722f; }
+	inline float Luma(float v) { return v; }
+
+	template<typename T>
+	struct Image
+	{
+		int Width = 0;
+		int Height = 0;
+		std::vector<T> Pixels;
+
+		Image() = default;
+		Image(int width, int height, const T& fill = T())
+			: Width(width), Height(height), Pixels((size_t)width * height, fill) {}
+
+		void Resize(int width, int height, const T& fill = T())
+		{
+			Width = width;
+			Height = height;
+			Pixels.assign((size_t)width * height, fill);
+		}
+
+		bool Empty() const { return Pixels.empty(); }
+		bool SameSize(int width, int height) const { return Width == width && Height == height; }
+		bool Contains(int x, int y) const { return x >= 0 && y >= 0 && x < Width && y < Height; }
+
+		T& At(int x, int y) { return Pixels[(size_t)y * Width + x]; }
+		const T& At(int x, int y) const { return Pixels[(size_t)y * Width + x]; }
+
+		// Clamp-to-edge fetch (D3D11_TEXTURE_ADDRESS_CLAMP)
+		const T& Clamped(int x, int y) const
+		{
+			x = std::clamp(x, 0, Width - 1);
+			y = std::clamp(y, 0, Height - 1);
+			return At(x, y);
+		}
+	};
+
+	using ColorImage = Image<Float4>;
+	using MotionField = Image<Float2>;
+	using LumaImage = Image<float>;
+	// [Occlusion] x: current-frame content visible in the previous frame, y: previous-frame content visible in the current one
+	using VisibilityMap = Image<Float2>;
+	// [Phase Correlation] Per tile, r g: strongest correlation peak, b a: second one (CS_PhaseCorrelation)
+	using CandidateField = Image<Float4>;
+	// [Farneback & DIS] Per pixel, r g: gradient, b a: curvature (CS_Farneback_Expansion)
+	using ExpansionImage = Image<Float4>;
+
+	// Bilinear fetch in texel space with clamp addressing
+	template<typename T>
+	T SampleBilinear(const Image<T>& img, float x, float y)
+	{
+		float fx = std::floor(x);
+		float fy = std::floor(y);
+		int x0 = (int)fx;
+		int y0 = (int)fy;
+		float tx = x - fx;
+		float ty = y - fy;
+
+		T top = Lerp(img.Clamped(x0, y0), img.Clamped(x0 + 1, y0), tx);
+		T bottom = Lerp(img.Clamped(x0, y0 + 1), img.Clamped(x0 + 1, y0 + 1), tx);
+		return Lerp(top, bottom, ty);
+	}
+
+	// Motion lookup at pixel (x, y) from a per-pixel (blockSize 1) or per-block field.
+	// Block vectors sit at block centers (CS_MotionExpand / CS_Interpolate)
+	inline Float2 SampleMotion(const MotionField& field, float x, float y, int blockSize)
+	{
+		if (blockSize <= 1) return SampleBilinear(field, x, y);
+		return SampleBilinear(field, (x + 0.5f) / blockSize - 0.5f, (y + 0.5f) / blockSize - 0.5f);
+	}
+
+	// [Native Synthesis] Same lookup when the field was estimated at a lower resolution: (x, y) is an output pixel,
+	// flowScale = output / flow size, the vector is returned in output pixels
+	inline Float2 SampleMotion(const MotionField& field, float x, float y, int blockSize, const Float2& flowScale)
+	{
+		Float2 v = SampleMotion(field, (x + 0.5f) / flowScale.x - 0.5f, (y + 0.5f) / flowScale.y - 0.5f, blockSize);
+		return { v.x * flowScale.x, v.y * flowScale.y };
+	}
+
+	// Sum of absolute RGB differences (color metrics; motion estimation matches luma, see CPULumaPyramid)
+	inline float AbsDiff(const Float4& a, const Float4& b)
+	{
+		return std::fabs(a.r - b.r) + std::fabs(a.g - b.g) + std::fabs(a.b - b.b);
+	}
+	inline float AbsDiff(float a, float b) { return std::fabs(a - b); }
+}
@@ -0,0 +1,38 @@
+#include "CPULumaPyramid.h"
+
+using namespace CPU;
+
+void CPULumaPyramid::ExtractLuma(const ColorImage& frame, LumaImage& luma)
+{
+	if (!luma.SameSize(frame.Width, frame.Height)) luma.Resize(frame.Width, frame.Height);
+	for (size_t i = 0; i < frame.Pixels.size(); ++i)
+		luma.Pixels[i] = Luma(frame.Pixels[i]);
+}
+
+void CPULumaPyramid::Downsample(const LumaImage& input, LumaImage& output)
+{
+	const int width = std::max(1, input.Width / 2);
+	const int height = std::max(1, input.Height / 2);
+	if (!output.SameSize(width, height)) output.Resize(width, height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			output.At(x, y) = (input.Clamped(2 * x, 2 * y) + input.Clamped(2 * x + 1, 2 * y) +
+				input.Clamped(2 * x, 2 * y + 1) + input.Clamped(2 * x + 1, 2 * y + 1)) * 0.25f;
+		}
+	}
+}
+
+void CPULumaPyramid::Build(const ColorImage& frame)
+{
+	// [Cycle] Last frame's pyramid is the previous one now
+	m_CurrentIndex ^= 1;
+
+	LumaImage* levels = m_Levels[m_CurrentIndex];
+	ExtractLuma(frame, levels[0]);
+	m_LevelCount = Pyramid::LevelCount(frame.Width, frame.Height);
+	for (int level = 1; level < m_LevelCount; ++level)
+		Downsample(levels[level - 1], levels[level]);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "CPUImage.h"
+#include "../OpticalFlow/PyramidSchedule.h"
+
+// CPU reference implementation of the shared analysis pyramid (CS_LumaPyramid.hlsl / LumaPyramid).
+// Build() once per real frame: the last frame's levels become the previous pyramid.
+class CPULumaPyramid
+{
+public:
+	CPULumaPyramid() = default;
+	~CPULumaPyramid() = default;
+
+	void Build(const CPU::ColorImage& frame);
+
+	const CPU::LumaImage& GetCurrent(int level = 0) const { return m_Levels[m_CurrentIndex][level]; }
+	const CPU::LumaImage& GetPrevious(int level = 0) const { return m_Levels[m_CurrentIndex ^ 1][level]; }
+	// Same as LumaPyramid.h: Pyramid::LevelCount of the last frame's size
+	int GetLevelCount() const { return m_LevelCount; }
+
+	// Rec.709 luma of every pixel (CSLuma)
+	static void ExtractLuma(const CPU::ColorImage& frame, CPU::LumaImage& luma);
+	// 2x2 box filter, clamped at odd edges (CSDownsample)
+	static void Downsample(const CPU::LumaImage& input, CPU::LumaImage& output);
+
+private:
+	CPU::LumaImage m_Levels[2][Pyramid::MaxLevels]; // [Current / Previous][Level]
+	int m_CurrentIndex = 0;
+	int m_LevelCount = 0;
+};
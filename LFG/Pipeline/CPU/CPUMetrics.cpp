@@ -0,0 +1,90 @@
+#include "CPUMetrics.h"
+#include "CPUOpticalFlow.h"
+#include "CPUFrameInterpolation.h"
+#include "CPULumaPyramid.h"
+
+float CPU::PSNR(const ColorImage& a, const ColorImage& b)
+{
+	if (a.Empty() || !b.SameSize(a.Width, a.Height)) return 0.0f;
+
+	double sum = 0.0;
+	for (size_t i = 0; i < a.Pixels.size(); ++i)
+	{
+		Float4 d = a.Pixels[i] - b.Pixels[i];
+		sum += (double)d.r * d.r + (double)d.g * d.g + (double)d.b * d.b;
+	}
+
+	double mse = sum / (a.Pixels.size() * 3.0);
+	if (mse <= 1e-10) return 100.0f;
+	return (float)(10.0 * std::log10(1.0 / mse));
+}
+
+float CPU::SSIM(const ColorImage& a, const ColorImage& b)
+{
+	if (a.Empty() || !b.SameSize(a.Width, a.Height)) return 0.0f;
+
+	const int window = 8;
+	const int stride = 4;
+	const double c1 = 0.01 * 0.01;
+	const double c2 = 0.03 * 0.03;
+
+	double total = 0.0;
+	int count = 0;
+	for (int wy = 0; wy + window <= a.Height; wy += stride)
+	{
+		for (int wx = 0; wx + window <= a.Width; wx += stride)
+		{
+			double sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0;
+			for (int y = wy; y < wy + window; ++y)
+			{
+				for (int x = wx; x < wx + window; ++x)
+				{
+					double la = Luma(a.At(x, y));
+					double lb = Luma(b.At(x, y));
+					sa += la; sb += lb;
+					saa += la * la; sbb += lb * lb; sab += la * lb;
+				}
+			}
+
+			const double n = window * window;
+			double ma = sa / n, mb = sb / n;
+			double va = saa / n - ma * ma;
+			double vb = sbb / n - mb * mb;
+			double cov = sab / n - ma * mb;
+
+			total += ((2.0 * ma * mb + c1) * (2.0 * cov + c2)) / ((ma * ma + mb * mb + c1) * (va + vb + c2));
+			++count;
+		}
+	}
+
+	return count > 0 ? (float)(total / count) : 0.0f;
+}
+
+CPU::DropFrameScore CPU::EvaluateDropFrame(const ColorImage& f0, const ColorImage& f1, const ColorImage& f2,
+	int blockSize, int searchRadius, bool enableSubPixel, float ghostingStrength)
+{
+	DropFrameScore score;
+	CPUOpticalFlow flow;
+	CPUFrameInterpolation synthesis;
+	CPULumaPyramid luma;
+	MotionField motion;
+	ColorImage predicted;
+
+	// Interpolation: f2 is 'current', f0 is 'prev', f1 sits at factor 0.5
+	luma.Build(f0);
+	luma.Build(f2);
+	flow.Dispatch(luma.GetCurrent(), luma.GetPrevious(), motion, blockSize, searchRadius, enableSubPixel);
+	synthesis.Interpolate(f2, f0, motion, predicted, 0.5f, ghostingStrength);
+	score.InterpolationPSNR = PSNR(predicted, f1);
+	score.InterpolationSSIM = SSIM(predicted, f1);
+
+	// Extrapolation: f1 is 'current', f0 is 'prev', f2 sits one interval ahead
+	luma.Build(f0);
+	luma.Build(f1);
+	flow.Dispatch(luma.GetCurrent(), luma.GetPrevious(), motion, blockSize, searchRadius, enableSubPixel);
+	synthesis.Extrapolate(f1, motion, predicted, 1.0f, ghostingStrength);
+	score.ExtrapolationPSNR = PSNR(predicted, f2);
+	score.ExtrapolationSSIM = SSIM(predicted, f2);
+
+	return score;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "CPUImage.h"
+
+// Image quality metrics for offline evaluation of the CPU pipeline.
+namespace CPU
+{
+	// Peak signal-to-noise ratio over RGB in dB (inputs in 0..1). Identical images return 100.
+	float PSNR(const ColorImage& a, const ColorImage& b);
+
+	// Mean structural similarity of the luma planes, 8x8 windows with stride 4.
+	float SSIM(const ColorImage& a, const ColorImage& b);
+
+	struct DropFrameScore
+	{
+		float InterpolationPSNR = 0.0f;
+		float InterpolationSSIM = 0.0f;
+		float ExtrapolationPSNR = 0.0f;
+		float ExtrapolationSSIM = 0.0f;
+	};
+
+	// Drop-one-frame comparison over three consecutive real frames f0, f1, f2:
+	//  - Interpolation rebuilds f1 halfway between f0 and f2.
+	//  - Extrapolation predicts f2 from f1 using the f0 -> f1 motion.
+	// Both predict a frame one real-frame interval away from their nearest input.
+	DropFrameScore EvaluateDropFrame(const ColorImage& f0, const ColorImage& f1, const ColorImage& f2,
+		int blockSize, int searchRadius, bool enableSubPixel, float ghostingStrength);
+}
@@ -0,0 +1,1871 @@
+#include "CPUOpticalFlow.h"
+#include "CPULumaPyramid.h"
+
+#include <cstdint>
+#include <cstring>
+
+// [Cost Aggregation] SSE2 is baseline on x64, the scalar loops cover everything else
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LFG_CPU_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using namespace CPU;
+
+void CPUOpticalFlow::Dispatch(const LumaImage& currentFrame,
+	const LumaImage& prevFrame,
+	MotionField& outputMotion,
+	int blockSize, int searchRadius,
+	bool enableSubPixel,
+	FlowAlgorithm algo,
+	bool enableWarmStart,
+	bool blockGranular,
+	bool aggregateCost)
+{
+	if (currentFrame.Empty() || !prevFrame.SameSize(currentFrame.Width, currentFrame.Height)) return;
+
+	m_SceneChangeCount = 0;
+	m_SADCount = 0;
+	m_MotionBlockSize = 1;
+	m_Visibility = VisibilityMap();
+
+	if (algo == FlowAlgorithm::RecursiveSearch || (algo == FlowAlgorithm::BlockMatching && blockGranular))
+	{
+		// Temporal candidates are built in (last frame's block field)
+		if (algo == FlowAlgorithm::RecursiveSearch)
+		{
+			blockSize = std::max(4, blockSize);
+			RecursiveSearch(currentFrame, prevFrame, blockSize, enableSubPixel);
+		}
+		else
+		{
+			blockSize = std::clamp(blockSize, 4, 32);
+			BlockSearch(currentFrame, prevFrame, blockSize, searchRadius, enableSubPixel);
+		}
+
+		if (blockGranular)
+		{
+			// [Block Motion] The synthesis samples the block field directly
+			outputMotion = m_BlockHistory;
+			m_MotionBlockSize = blockSize;
+			m_MotionHistory = MotionField();
+			return;
+		}
+
+		ExpandBlockField(m_BlockHistory, outputMotion, currentFrame.Width, currentFrame.Height, blockSize);
+		if (enableWarmStart) m_MotionHistory = outputMotion;
+		else m_MotionHistory = MotionField();
+		return;
+	}
+
+	if (!outputMotion.SameSize(currentFrame.Width, currentFrame.Height))
+		outputMotion.Resize(currentFrame.Width, currentFrame.Height);
+
+	// [Temporal Warm-Start]
+	// Unlike the GPU path the residual is known immediately, so this frame's prediction decides its own trust.
+	bool warmStart = enableWarmStart && m_MotionHistory.SameSize(currentFrame.Width, currentFrame.Height);
+	m_WarmStartResidual = 1.0f;
+	if (warmStart)
+	{
+		m_WarmStartResidual = ProjectMotion(currentFrame, prevFrame, m_Predicted);
+
+		if (m_WarmStartResidual < FlowTuning::WarmStartTrustThreshold)
+		{
+			int radius = std::max(2, searchRadius / 4);
+			BlockMatching(currentFrame, prevFrame, outputMotion, &m_Predicted, blockSize, radius, enableSubPixel, nullptr, aggregateCost);
+		}
+		else
+		{
+			BlockMatching(currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, enableSubPixel, &m_Predicted, aggregateCost);
+		}
+	}
+	else
+	{
+		BlockMatching(currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, enableSubPixel, nullptr, aggregateCost);
+	}
+
+	if (enableWarmStart) m_MotionHistory = outputMotion;
+	else m_MotionHistory = MotionField();
+}
+
+void CPUOpticalFlow::DispatchPyramid(const CPULumaPyramid& luma,
+	MotionField& outputMotion,
+	int blockSize, int searchRadius,
+	bool enableSubPixel,
+	int maxLevel, int minLevel,
+	bool enableWarmStart,
+	bool aggregateCost,
+	bool enableGlobalMotion,
+	bool enablePhaseCorrelation,
+	bool enableAdaptiveRadius)
+{
+	const LumaImage& currentFrame = luma.GetCurrent();
+	const LumaImage& prevFrame = luma.GetPrevious();
+	if (currentFrame.Empty() || !prevFrame.SameSize(currentFrame.Width, currentFrame.Height)) return;
+
+	m_SceneChangeCount = 0;
+	m_SADCount = 0;
+	m_MotionBlockSize = 1;
+	m_Visibility = VisibilityMap();
+
+	maxLevel = std::clamp(maxLevel, 0, luma.GetLevelCount() - 1);
+	minLevel = std::clamp(minLevel, 0, maxLevel);
+
+	// [Adaptive Radius] Last frame's measured motion sets the reach (searchRadius stays the cap) and the levels it takes
+	const int userRadius = searchRadius;
+	if (enableAdaptiveRadius)
+	{
+		searchRadius = m_AdaptiveRadius.GetRadius(searchRadius);
+		maxLevel = AdaptiveRadius::LevelsFor(searchRadius, maxLevel, minLevel);
+	}
+	else
+	{
+		m_AdaptiveRadius.Reset();
+		m_TileRadius = LumaImage();
+	}
+	m_TileRadiusActive = enableAdaptiveRadius && m_TileRadiusWidth == currentFrame.Width && !m_TileRadius.Empty() &&
+		m_AdaptiveRadius.TileBounds();
+
+	// [Temporal Warm-Start] Projected onto the coarsest level, as on the GPU. The residual decides this frame's trust.
+	bool warmStart = enableWarmStart && m_MotionHistory.SameSize(currentFrame.Width, currentFrame.Height);
+	m_WarmStartResidual = 1.0f;
+	if (warmStart) m_WarmStartResidual = ProjectMotion(luma.GetCurrent(maxLevel), luma.GetPrevious(maxLevel), m_Predicted);
+
+	// A trusted prediction stands in for the coarser levels
+	bool trustPrediction = warmStart && m_WarmStartResidual < FlowTuning::WarmStartTrustThreshold;
+	if (trustPrediction && maxLevel != minLevel)
+	{
+		maxLevel = minLevel;
+		ProjectMotion(luma.GetCurrent(maxLevel), luma.GetPrevious(maxLevel), m_Predicted);
+	}
+
+	// [Global Motion] Last frame's camera motion seeds the coarsest level, unless the warm-start already stands in for it
+	bool globalSeed = enableGlobalMotion && m_GlobalValid && !trustPrediction;
+	if (globalSeed && FlowTuning::TrustGlobalMotion(m_GlobalMotion.GetEstimate()) && maxLevel != minLevel)
+	{
+		// Camera motion explains nearly the whole frame: the seed stands in for the coarser levels
+		maxLevel = minLevel;
+		if (warmStart) ProjectMotion(luma.GetCurrent(maxLevel), luma.GetPrevious(maxLevel), m_Predicted);
+	}
+
+	// [Phase Correlation] Large shifts found per tile up front, offered to the coarsest search (a trusted prediction needs no help)
+	const int candidateLevel = std::min(PhaseCorrelation::CandidateLevel, luma.GetLevelCount() - 1);
+	const bool tileCandidates = enablePhaseCorrelation && !trustPrediction;
+	if (tileCandidates) PhaseCorrelateTiles(luma.GetCurrent(candidateLevel), luma.GetPrevious(candidateLevel));
+
+	for (int l = maxLevel; l >= minLevel; --l)
+	{
+		const LumaImage& current = luma.GetCurrent(l);
+		MotionField& motion = l == 0 ? outputMotion : m_MotionLevels[l];
+		if (!motion.SameSize(current.Width, current.Height))
+			motion.Resize(current.Width, current.Height);
+
+		Pyramid::Level level = Pyramid::Schedule(l, maxLevel, blockSize, searchRadius);
+		int radius = level.SearchRadius;
+		const MotionField* init = nullptr;
+		const MotionField* predicted = nullptr;
+		const CandidateField* candidates = nullptr;
+
+		if (l < maxLevel)
+		{
+			Upsample(m_MotionLevels[l + 1], m_InitLevels[l], current.Width, current.Height, &current, &luma.GetCurrent(l + 1));
+			init = &m_InitLevels[l];
+		}
+		else if (trustPrediction)
+		{
+			// Good guess, only a small correction left to find
+			init = &m_Predicted;
+			radius = std::max(Pyramid::MinSearchRadius, radius / 4);
+		}
+		else
+		{
+			if (globalSeed)
+			{
+				// The camera motion is the guess, the search only corrects what moves on its own
+				SeedGlobalMotion(current.Width, current.Height, currentFrame.Width, m_GlobalSeed);
+				init = &m_GlobalSeed;
+				radius = std::min(radius, FlowTuning::GlobalMotionResidualRadius);
+			}
+			if (warmStart) predicted = &m_Predicted;
+			if (tileCandidates) candidates = &m_TileCandidates;
+		}
+
+		// Candidates are in candidateLevel pixels, each level is half the one below
+		const float candidateScale = std::ldexp(1.0f, candidateLevel - l);
+		// [Adaptive Radius] The per-tile bounds cap the absolute search only, the finer levels correct a guess
+		BlockMatching(current, luma.GetPrevious(l), motion, init, level.BlockSize, radius, enableSubPixel && l == 0,
+			predicted, aggregateCost, candidates, candidateScale, nullptr, m_TileRadiusActive && !init);
+	}
+	m_TileRadiusActive = false;
+
+	// Finest computed level -> Output, [Guided Upsample] edge-aware so a coarse end level holds up at full resolution
+	for (int l = minLevel; l > 0; --l)
+	{
+		const LumaImage& finer = luma.GetCurrent(l - 1);
+		Upsample(m_MotionLevels[l], l - 1 == 0 ? outputMotion : m_MotionLevels[l - 1], finer.Width, finer.Height, &finer, &luma.GetCurrent(l));
+	}
+
+	// [Global Motion] Fitted for the next frame (the GPU reads the same samples back and fits them when it starts)
+	m_GlobalValid = false;
+	if (enableGlobalMotion) FitGlobalMotion(luma, outputMotion);
+	if (enableAdaptiveRadius) MeasureMotion(currentFrame, prevFrame, outputMotion, searchRadius, userRadius);
+
+	if (enableWarmStart) m_MotionHistory = outputMotion;
+	else m_MotionHistory = MotionField();
+}
+
+void CPUOpticalFlow::MeasureMotion(const LumaImage& current, const LumaImage& prev, const MotionField& motion,
+	int searchedRadius, int maxRadius)
+{
+	constexpr int tile = FlowTuning::FlowTileSize;
+	const int tilesX = (current.Width + tile - 1) / tile;
+	const int tilesY = (current.Height + tile - 1) / tile;
+	if (!m_TileMotionMax.SameSize(tilesX, tilesY)) m_TileMotionMax.Resize(tilesX, tilesY);
+	if (!m_TileRadius.SameSize(tilesX, tilesY)) m_TileRadius.Resize(tilesX, tilesY);
+	m_MotionStats.assign(AdaptiveRadius::ReadbackSize, 0);
+
+	// CSTileStats: length histogram, the tile's longest vector and mean residual
+	float longest = 0.0f;
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			const int x1 = std::min((tx + 1) * tile, current.Width);
+			const int y1 = std::min((ty + 1) * tile, current.Height);
+			float tileMax = 0.0f;
+			float residual = 0.0f;
+			for (int y = ty * tile; y < y1; ++y)
+			{
+				for (int x = tx * tile; x < x1; ++x)
+				{
+					const Float2& v = motion.At(x, y);
+					const float len = Length(v);
+					tileMax = std::max(tileMax, len);
+					residual += AbsDiff(current.At(x, y), SampleBilinear(prev, x + v.x, y + v.y));
+					++m_MotionStats[std::min((int)len, AdaptiveRadius::HistogramBins - 1)];
+				}
+			}
+			const float meanResidual = residual / (float)((x1 - tx * tile) * (y1 - ty * tile));
+			m_TileMotionMax.At(tx, ty) = tileMax;
+			longest = std::max(longest, tileMax);
+			m_MotionStats[AdaptiveRadius::ReadbackResidual] += (uint32_t)std::lround(meanResidual * AdaptiveRadius::ResidualScale);
+			++m_MotionStats[AdaptiveRadius::ReadbackTiles];
+		}
+	}
+	std::memcpy(&m_MotionStats[AdaptiveRadius::ReadbackMax], &longest, sizeof(float));
+
+	// CSTileRadius: the longest vector around each tile, with the margin
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			float around = 0.0f;
+			for (int y = -1; y <= 1; ++y)
+			{
+				for (int x = -1; x <= 1; ++x)
+				{
+					around = std::max(around, m_TileMotionMax.At(std::clamp(tx + x, 0, tilesX - 1), std::clamp(ty + y, 0, tilesY - 1)));
+				}
+			}
+			m_TileRadius.At(tx, ty) = std::ceil(around * AdaptiveRadius::Margin) + AdaptiveRadius::Padding;
+		}
+	}
+	m_TileRadiusWidth = current.Width;
+
+	m_AdaptiveRadius.Update(AdaptiveRadius::Summarize(m_MotionStats.data()), searchedRadius, maxRadius);
+}
+
+int CPUOpticalFlow::TileSearchRadius(int x, int y, int levelWidth, int searchRadius) const
+{
+	// Same lookup and rounding as the shader (the R16F bounds are whole pixels either way)
+	const float scale = (float)levelWidth / (float)std::max(1, m_TileRadiusWidth);
+	const int tx = std::min((int)(x / (FlowTuning::FlowTileSize * scale)), m_TileRadius.Width - 1);
+	const int ty = std::min((int)(y / (FlowTuning::FlowTileSize * scale)), m_TileRadius.Height - 1);
+	return std::min(std::max((int)std::ceil(m_TileRadius.At(tx, ty) * scale), Pyramid::MinSearchRadius), searchRadius);
+}
+
+void CPUOpticalFlow::DispatchRefined(const CPULumaPyramid& luma,
+	MotionField& outputMotion,
+	FlowAlgorithm algo,
+	int blockSize, int searchRadius,
+	bool enableSubPixel,
+	int maxLevel, int minLevel,
+	bool enableWarmStart,
+	bool aggregateCost)
+{
+	const LumaImage& currentFrame = luma.GetCurrent();
+	const LumaImage& prevFrame = luma.GetPrevious();
+	if (currentFrame.Empty() || !prevFrame.SameSize(currentFrame.Width, currentFrame.Height)) return;
+
+	// [Hybrid Flow] The tile stats describe the last hybrid field only
+	if (algo != FlowAlgorithm::Hybrid) m_TileStatsValid = false;
+
+	// Same fallback as the GPU: without a refinement the pyramid runs down to minLevel
+	if (algo != FlowAlgorithm::Farneback && algo != FlowAlgorithm::DIS && algo != FlowAlgorithm::Hybrid)
+	{
+		DispatchPyramid(luma, outputMotion, blockSize, searchRadius, enableSubPixel, maxLevel, minLevel, enableWarmStart, aggregateCost);
+		return;
+	}
+
+	const int width = currentFrame.Width;
+	const int height = currentFrame.Height;
+	if (!outputMotion.SameSize(width, height))
+		outputMotion.Resize(width, height);
+
+	m_SceneChangeCount = 0;
+	m_SADCount = 0;
+	m_MotionBlockSize = 1;
+	m_Visibility = VisibilityMap();
+
+	// 1. Expansion (the GPU expands each frame once, see ExpandFrame)
+	Expand(currentFrame, m_PolyCurr);
+	Expand(prevFrame, m_PolyPrev);
+
+	// 2. Initial guess, same three cases as OpticalFlow::Dispatch
+	const bool warmStart = enableWarmStart && m_MotionHistory.SameSize(width, height);
+	const float residual = warmStart ? ProjectMotion(currentFrame, prevFrame, m_Predicted) : 1.0f;
+	bool fullResolution = false;
+	if (warmStart && residual < FlowTuning::WarmStartTrustThreshold)
+	{
+		// The projected history is the initial guess, no block matching needed
+		m_RefineInit = m_Predicted;
+	}
+	else if (maxLevel > 0 && luma.GetLevelCount() > 1)
+	{
+		// Coarse levels only, the refinement below is the full resolution pass
+		DispatchPyramid(luma, m_RefineInit, blockSize, searchRadius, false, maxLevel, std::max(minLevel, 1), enableWarmStart, aggregateCost);
+	}
+	else
+	{
+		BlockMatching(currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, false, warmStart ? &m_Predicted : nullptr, aggregateCost);
+		m_RefineInit = outputMotion;
+		fullResolution = true;
+	}
+	m_WarmStartResidual = residual;
+
+	// 3. Refinement
+	if (algo == FlowAlgorithm::Farneback)
+	{
+		FarnebackFlow(m_PolyCurr, m_PolyPrev, m_RefineInit, outputMotion);
+	}
+	else if (algo == FlowAlgorithm::DIS)
+	{
+		DISFlow(currentFrame, prevFrame, m_PolyPrev, m_RefineInit, outputMotion);
+	}
+	else
+	{
+		// [Hybrid Flow] Every tile with the cheapest refinement likely to hold (a full resolution block search
+		// already is the BlockMatching result)
+		CalcVariance(currentFrame);
+		SelectTiles();
+
+		const int radius = Pyramid::Schedule(0, maxLevel, blockSize, searchRadius).SearchRadius;
+		if (!fullResolution)
+			BlockMatching(currentFrame, prevFrame, outputMotion, &m_RefineInit, blockSize, radius, enableSubPixel, nullptr, aggregateCost,
+				nullptr, 1.0f, &m_TileLists[(int)FlowAlgorithm::BlockMatching]);
+		FarnebackFlow(m_PolyCurr, m_PolyPrev, m_RefineInit, outputMotion, &m_TileLists[(int)FlowAlgorithm::Farneback]);
+		DISFlow(currentFrame, prevFrame, m_PolyPrev, m_RefineInit, outputMotion, &m_TileLists[(int)FlowAlgorithm::DIS]);
+
+		MeasureTiles(currentFrame, prevFrame, outputMotion);
+	}
+
+	if (enableWarmStart) m_MotionHistory = outputMotion;
+	else m_MotionHistory = MotionField();
+}
+
+void CPUOpticalFlow::Expand(const LumaImage& frame, ExpansionImage& poly)
+{
+	if (!poly.SameSize(frame.Width, frame.Height))
+		poly.Resize(frame.Width, frame.Height);
+
+	for (int y = 0; y < frame.Height; ++y)
+	{
+		for (int x = 0; x < frame.Width; ++x)
+		{
+			float val[5][5];
+			for (int j = 0; j < 5; ++j)
+			{
+				for (int i = 0; i < 5; ++i)
+				{
+					const int px = x + i - 2;
+					const int py = y + j - 2;
+					val[j][i] = frame.Contains(px, py) ? frame.At(px, py) : 0.0f;
+				}
+			}
+
+			// Sobel-like gradients over +-2 pixels, (1 -2 1) curvatures
+			const float gx = (-val[1][0] + val[1][4] - 2.0f * val[2][0] + 2.0f * val[2][4] - val[3][0] + val[3][4]) / 8.0f;
+			const float gy = (-val[0][1] + val[4][1] - 2.0f * val[0][2] + 2.0f * val[4][2] - val[0][3] + val[4][3]) / 8.0f;
+			const float rxx = (val[2][0] - 2.0f * val[2][2] + val[2][4]) * 0.25f;
+			const float ryy = (val[0][2] - 2.0f * val[2][2] + val[4][2]) * 0.25f;
+			poly.At(x, y) = { gx, gy, rxx, ryy };
+		}
+	}
+}
+
+bool CPUOpticalFlow::PixelUnchanged(int x, int y) const
+{
+	// Same lookup as TexUnchanged[pos / 16] (unbound reads 0)
+	return m_UnchangedTiles && m_UnchangedTiles->Contains(x / UnchangedTileSize, y / UnchangedTileSize) &&
+		m_UnchangedTiles->At(x / UnchangedTileSize, y / UnchangedTileSize);
+}
+
+void CPUOpticalFlow::FarnebackFlow(const ExpansionImage& polyCurr, const ExpansionImage& polyPrev,
+	const MotionField& initMotion, MotionField& motion, const std::vector<uint32_t>* tileList)
+{
+	ForEachPixel(polyCurr.Width, polyCurr.Height, tileList, [&](int x, int y)
+	{
+		if (PixelUnchanged(x, y))
+		{
+			motion.At(x, y) = { 0.0f, 0.0f };
+			return;
+		}
+
+		// One diagonal solve over a 5x5 window around the initial guess
+		const Float2 d0 = initMotion.At(x, y);
+		float sumRxxBx = 0.0f, sumRxx2 = 0.0f;
+		float sumRyyBy = 0.0f, sumRyy2 = 0.0f;
+		for (int dy = -2; dy <= 2; ++dy)
+		{
+			for (int dx = -2; dx <= 2; ++dx)
+			{
+				const int px = x + dx;
+				const int py = y + dy;
+				if (!polyCurr.Contains(px, py)) continue;
+
+				const Float4& c = polyCurr.At(px, py);
+				const Float4 p = SampleBilinear(polyPrev, px + d0.x, py + d0.y);
+				const float rxx = (c.b + p.b) * 0.5f;
+				const float ryy = (c.a + p.a) * 0.5f;
+				sumRxxBx += rxx * (p.r - c.r);
+				sumRxx2 += rxx * rxx;
+				sumRyyBy += ryy * (p.g - c.g);
+				sumRyy2 += ryy * ryy;
+			}
+		}
+		m_SADCount += 25;
+
+		const float dx = std::clamp(-sumRxxBx / (2.0f * sumRxx2 + 0.0001f), -2.0f, 2.0f);
+		const float dy = std::clamp(-sumRyyBy / (2.0f * sumRyy2 + 0.0001f), -2.0f, 2.0f);
+		motion.At(x, y) = { d0.x + dx, d0.y + dy };
+	});
+}
+
+void CPUOpticalFlow::DISFlow(const LumaImage& current, const LumaImage& prev, const ExpansionImage& gradsPrev,
+	const MotionField& initMotion, MotionField& motion, const std::vector<uint32_t>* tileList)
+{
+	ForEachPixel(current.Width, current.Height, tileList, [&](int x, int y)
+	{
+		if (PixelUnchanged(x, y))
+		{
+			motion.At(x, y) = { 0.0f, 0.0f };
+			return;
+		}
+
+		// Up to four Gauss-Newton steps on an 8x8 patch, diagonal normal equations
+		Float2 d = initMotion.At(x, y);
+		for (int iter = 0; iter < 4; ++iter)
+		{
+			float sumIdIx = 0.0f, sumIdIy = 0.0f;
+			float sumIx2 = 0.0f, sumIy2 = 0.0f;
+			for (int dy = -4; dy < 4; ++dy)
+			{
+				for (int dx = -4; dx < 4; ++dx)
+				{
+					const int px = x + dx;
+					const int py = y + dy;
+					if (!current.Contains(px, py)) continue;
+
+					// The expansion's Sobel spans 4 pixels: twice the per-pixel derivative
+					const Float4 g = SampleBilinear(gradsPrev, px + d.x, py + d.y);
+					const float ix = 0.5f * g.r;
+					const float iy = 0.5f * g.g;
+					const float diff = current.At(px, py) - SampleBilinear(prev, px + d.x, py + d.y);
+					sumIdIx += diff * ix;
+					sumIdIy += diff * iy;
+					sumIx2 += ix * ix;
+					sumIy2 += iy * iy;
+				}
+			}
+			m_SADCount += 64;
+
+			const Float2 delta = { sumIdIx / (sumIx2 + 0.001f), sumIdIy / (sumIy2 + 0.001f) };
+			d = d + delta;
+			if (LengthSq(delta) < 0.001f) break;
+		}
+		motion.At(x, y) = d;
+	});
+}
+
+void CPUOpticalFlow::SelectTiles()
+{
+	const int tilesX = m_VarianceGrid.Width;
+	const int tilesY = m_VarianceGrid.Height;
+	const bool useStats = m_TileStatsValid && m_TileStats.SameSize(tilesX, tilesY) && m_TileAlgorithms.SameSize(tilesX, tilesY);
+	if (!m_TileAlgorithms.SameSize(tilesX, tilesY))
+		m_TileAlgorithms.Resize(tilesX, tilesY);
+	for (std::vector<uint32_t>& list : m_TileLists) list.clear();
+
+	constexpr uint8_t blockMatching = (uint8_t)FlowAlgorithm::BlockMatching;
+	constexpr uint8_t farneback = (uint8_t)FlowAlgorithm::Farneback;
+	constexpr uint8_t dis = (uint8_t)FlowAlgorithm::DIS;
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			uint8_t algo = blockMatching; // Nothing known yet: the plain search
+			if (m_VarianceGrid.At(tx, ty) < FlowTuning::HybridFlatVariance)
+			{
+				algo = farneback;
+			}
+			else if (useStats)
+			{
+				const Float2& stats = m_TileStats.At(tx, ty);
+				const uint8_t last = m_TileAlgorithms.At(tx, ty);
+				if (stats.y > FlowTuning::HybridMaxSpread) algo = blockMatching;
+				else if (stats.x > FlowTuning::HybridHighResidual) algo = dis;
+				else if (stats.x < FlowTuning::HybridLowResidual) algo = farneback;
+				else algo = last == dis ? dis : farneback;
+			}
+
+			m_TileAlgorithms.At(tx, ty) = algo;
+			m_TileLists[algo].push_back((uint32_t)tx | ((uint32_t)ty << 16));
+		}
+	}
+}
+
+void CPUOpticalFlow::MeasureTiles(const LumaImage& current, const LumaImage& prev, const MotionField& motion)
+{
+	const int tilesX = (current.Width + FlowTuning::FlowTileSize - 1) / FlowTuning::FlowTileSize;
+	const int tilesY = (current.Height + FlowTuning::FlowTileSize - 1) / FlowTuning::FlowTileSize;
+	if (!m_TileStats.SameSize(tilesX, tilesY))
+		m_TileStats.Resize(tilesX, tilesY);
+
+	const float count = (float)((FlowTuning::FlowTileSize / 2) * (FlowTuning::FlowTileSize / 2));
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			// Every other pixel, clamped so edge tiles do not read outside
+			float residual = 0.0f;
+			Float2 sum;
+			float sumSq = 0.0f;
+			for (int y = 0; y < FlowTuning::FlowTileSize; y += 2)
+			{
+				for (int x = 0; x < FlowTuning::FlowTileSize; x += 2)
+				{
+					const int px = std::min(tx * FlowTuning::FlowTileSize + x, current.Width - 1);
+					const int py = std::min(ty * FlowTuning::FlowTileSize + y, current.Height - 1);
+					const Float2& v = motion.At(px, py);
+					residual += AbsDiff(current.At(px, py), SampleBilinear(prev, px + v.x, py + v.y));
+					sum = sum + v;
+					sumSq += LengthSq(v);
+				}
+			}
+
+			const Float2 mean = sum * (1.0f / count);
+			m_TileStats.At(tx, ty) = { residual / count, std::sqrt(std::max(sumSq / count - LengthSq(mean), 0.0f)) };
+		}
+	}
+	m_TileStatsValid = true;
+}
+
+void CPUOpticalFlow::PhaseCorrelateTiles(const LumaImage& current, const LumaImage& prev)
+{
+	const int n = PhaseCorrelation::TileWindow;
+	const int tile = PhaseCorrelation::TileSize;
+	const int tilesX = (current.Width + tile - 1) / tile;
+	const int tilesY = (current.Height + tile - 1) / tile;
+	if (!m_TileCandidates.SameSize(tilesX, tilesY))
+		m_TileCandidates.Resize(tilesX, tilesY);
+
+	m_PhaseWindows.resize(2 * (size_t)n * n);
+	float* windowCurrent = m_PhaseWindows.data();
+	float* windowPrev = windowCurrent + (size_t)n * n;
+
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			// The window centered on the tile, moved inside the frame at the borders (clamped texels correlate with
+			// themselves at zero motion)
+			const int x0 = std::max(0, std::min(tx * tile + tile / 2 - n / 2, current.Width - n));
+			const int y0 = std::max(0, std::min(ty * tile + tile / 2 - n / 2, current.Height - n));
+			for (int j = 0; j < n; ++j)
+			{
+				for (int i = 0; i < n; ++i)
+				{
+					windowCurrent[j * n + i] = current.Clamped(x0 + i, y0 + j);
+					windowPrev[j * n + i] = prev.Clamped(x0 + i, y0 + j);
+				}
+			}
+
+			PhaseCorrelation::Peak peaks[PhaseCorrelation::Candidates];
+			const int found = m_PhaseCorrelation.Correlate(windowCurrent, windowPrev, n, peaks, PhaseCorrelation::Candidates);
+
+			// Weak peaks are noise, zero motion stands in
+			Float4& candidate = m_TileCandidates.At(tx, ty);
+			candidate = { 0.0f, 0.0f, 0.0f, 0.0f };
+			if (found > 0 && peaks[0].Height >= PhaseCorrelation::MinTilePeak)
+			{
+				candidate.r = peaks[0].X;
+				candidate.g = peaks[0].Y;
+			}
+			if (found > 1 && peaks[1].Height >= PhaseCorrelation::MinTilePeak)
+			{
+				candidate.b = peaks[1].X;
+				candidate.a = peaks[1].Y;
+			}
+		}
+	}
+}
+
+void CPUOpticalFlow::TileCandidates(const CandidateField& field, float scale, int x, int y, Float2 (&out)[PhaseCorrelation::Candidates])
+{
+	const float tile = PhaseCorrelation::TileSize * scale;
+	const int tx = std::min((int)(x / tile), field.Width - 1);
+	const int ty = std::min((int)(y / tile), field.Height - 1);
+	const Float4& candidate = field.At(tx, ty);
+	out[0] = { candidate.r * scale, candidate.g * scale };
+	out[1] = { candidate.b * scale, candidate.a * scale };
+}
+
+void CPUOpticalFlow::SeedGlobalMotion(int width, int height, int flowWidth, MotionField& seed) const
+{
+	if (!seed.SameSize(width, height))
+		seed.Resize(width, height);
+
+	const GlobalMotion::Estimate& model = m_GlobalMotion.GetEstimate();
+	const float levelScale = (float)flowWidth / width;
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			// Texel centers, level -> flow pixels and back
+			float u, v;
+			model.Evaluate((x + 0.5f) * levelScale - 0.5f, (y + 0.5f) * levelScale - 0.5f, u, v);
+			seed.At(x, y) = { u / levelScale, v / levelScale };
+		}
+	}
+}
+
+void CPUOpticalFlow::FitGlobalMotion(const CPULumaPyramid& luma, const MotionField& finalMotion)
+{
+	const int grid = GlobalMotion::SampleGrid;
+	const int n = GlobalMotion::ThumbnailSize;
+
+	// CSGather
+	m_GlobalSamples.resize((size_t)grid * grid);
+	for (int j = 0; j < grid; ++j)
+	{
+		for (int i = 0; i < grid; ++i)
+		{
+			int x = std::min((int)((i + 0.5f) * finalMotion.Width / grid), finalMotion.Width - 1);
+			int y = std::min((int)((j + 0.5f) * finalMotion.Height / grid), finalMotion.Height - 1);
+			const Float2& v = finalMotion.At(x, y);
+			m_GlobalSamples[(size_t)j * grid + i] = { (float)x, (float)y, v.x, v.y };
+		}
+	}
+
+	// CSThumbnail on the coarsest level
+	const int coarsest = luma.GetLevelCount() - 1;
+	const LumaImage& current = luma.GetCurrent(coarsest);
+	const LumaImage& prev = luma.GetPrevious(coarsest);
+	m_GlobalThumbnails.resize(2 * (size_t)n * n);
+	for (int j = 0; j < n; ++j)
+	{
+		int y0 = j * current.Height / n;
+		int y1 = std::min(std::max((j + 1) * current.Height / n, y0 + 1), current.Height);
+		for (int i = 0; i < n; ++i)
+		{
+			int x0 = i * current.Width / n;
+			int x1 = std::min(std::max((i + 1) * current.Width / n, x0 + 1), current.Width);
+
+			float sumCurrent = 0.0f;
+			float sumPrev = 0.0f;
+			for (int y = y0; y < y1; ++y)
+			{
+				for (int x = x0; x < x1; ++x)
+				{
+					sumCurrent += current.At(x, y);
+					sumPrev += prev.At(x, y);
+				}
+			}
+			float count = (float)((x1 - x0) * (y1 - y0));
+			m_GlobalThumbnails[(size_t)j * n + i] = sumCurrent / count;
+			m_GlobalThumbnails[(size_t)n * n + (size_t)j * n + i] = sumPrev / count;
+		}
+	}
+
+	// Same order as OpticalFlow::BeginGlobalMotion
+	m_GlobalValid = m_GlobalMotion.Fit(m_GlobalSamples.data(), (int)m_GlobalSamples.size()).Valid() ||
+		m_GlobalMotion.PhaseCorrelate(m_GlobalThumbnails.data(), m_GlobalThumbnails.data() + (size_t)n * n, finalMotion.Width, finalMotion.Height).Valid();
+}
+
+// [Guided Upsample] Spatial and range kernels of CS_Upsample.hlsl
+static float UpsampleSpatialWeight(float d)
+{
+	return std::exp(-d * d / 2.0f); // SPATIAL_SIGMA = 1 coarse pixel
+}
+
+static float UpsampleRangeWeight(float d)
+{
+	return std::exp(-d * d / (2.0f * FlowTuning::UpsampleRangeSigma * FlowTuning::UpsampleRangeSigma)) + 0.001f; // RANGE_FLOOR
+}
+
+void CPUOpticalFlow::Upsample(const MotionField& coarse, MotionField& fine, int width, int height,
+	const LumaImage* guideFine, const LumaImage* guideCoarse)
+{
+	if (!fine.SameSize(width, height))
+		fine.Resize(width, height);
+
+	const bool guided = guideFine && guideCoarse &&
+		guideFine->SameSize(width, height) && guideCoarse->SameSize(coarse.Width, coarse.Height);
+
+	if (!guided)
+	{
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				Float2 v = coarse.Clamped(x / 2, y / 2);
+				fine.At(x, y) = { v.x * 2.0f, v.y * 2.0f };
+			}
+		}
+		return;
+	}
+
+	// Horizontal pass: every coarse row at the output width, guided by the output row pair it covers
+	if (!m_UpsampleRows.SameSize(width, coarse.Height))
+	{
+		m_UpsampleRows.Resize(width, coarse.Height);
+		m_UpsampleRowGuide.Resize(width, coarse.Height);
+	}
+
+	for (int j = 0; j < coarse.Height; ++j)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			const float rowGuide = 0.5f * (guideFine->Clamped(x, 2 * j) + guideFine->Clamped(x, 2 * j + 1));
+			const float center = (x + 0.5f) * 0.5f - 0.5f;
+			const int src = std::min(x / 2, coarse.Width - 1);
+
+			Float2 sum;
+			float weightSum = 0.0f;
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				const int i = std::clamp(src + dx, 0, coarse.Width - 1);
+				const float w = UpsampleSpatialWeight(i - center) * UpsampleRangeWeight(rowGuide - guideCoarse->At(i, j));
+				const Float2& v = coarse.At(i, j);
+				sum.x += v.x * w;
+				sum.y += v.y * w;
+				weightSum += w;
+			}
+
+			m_UpsampleRows.At(x, j) = { sum.x / weightSum, sum.y / weightSum };
+			m_UpsampleRowGuide.At(x, j) = rowGuide;
+		}
+	}
+
+	// Vertical pass
+	for (int y = 0; y < height; ++y)
+	{
+		const float center = (y + 0.5f) * 0.5f - 0.5f;
+		const int src = std::min(y / 2, coarse.Height - 1);
+
+		for (int x = 0; x < width; ++x)
+		{
+			const float guide = guideFine->At(x, y);
+
+			Float2 sum;
+			float weightSum = 0.0f;
+			for (int dy = -1; dy <= 1; ++dy)
+			{
+				const int j = std::clamp(src + dy, 0, coarse.Height - 1);
+				const float w = UpsampleSpatialWeight(j - center) * UpsampleRangeWeight(guide - m_UpsampleRowGuide.At(x, j));
+				const Float2& v = m_UpsampleRows.At(x, j);
+				sum.x += v.x * w;
+				sum.y += v.y * w;
+				weightSum += w;
+			}
+
+			fine.At(x, y) = { 2.0f * sum.x / weightSum, 2.0f * sum.y / weightSum };
+		}
+	}
+}
+
+void CPUOpticalFlow::DispatchAdaptive(const LumaImage& currentFrame,
+	const LumaImage& prevFrame,
+	MotionField& outputMotion,
+	int searchRadius,
+	bool enableWarmStart)
+{
+	if (currentFrame.Empty() || !prevFrame.SameSize(currentFrame.Width, currentFrame.Height)) return;
+
+	m_SceneChangeCount = 0;
+	m_SADCount = 0;
+	m_MotionBlockSize = 1;
+	m_Visibility = VisibilityMap();
+
+	CalcVariance(currentFrame);
+	QuadtreeSearch(currentFrame, prevFrame, searchRadius, true, enableWarmStart);
+	ExpandBlockField(m_QuadField, outputMotion, currentFrame.Width, currentFrame.Height, FlowTuning::QuadtreeLeafSize);
+
+	if (enableWarmStart) m_MotionHistory = outputMotion;
+	else m_MotionHistory = MotionField();
+}
+
+void CPUOpticalFlow::DispatchBiDirectional(const LumaImage& currentFrame,
+	const LumaImage& prevFrame,
+	MotionField& outputMotion,
+	int blockSize, int searchRadius,
+	bool enableWarmStart,
+	bool aggregateCost,
+	bool invertBackward)
+{
+	if (currentFrame.Empty() || !prevFrame.SameSize(currentFrame.Width, currentFrame.Height)) return;
+
+	m_SceneChangeCount = 0;
+	m_SADCount = 0;
+	m_MotionBlockSize = 1;
+
+	if (!outputMotion.SameSize(currentFrame.Width, currentFrame.Height))
+		outputMotion.Resize(currentFrame.Width, currentFrame.Height);
+	if (!m_MotionBackward.SameSize(currentFrame.Width, currentFrame.Height))
+		m_MotionBackward.Resize(currentFrame.Width, currentFrame.Height);
+
+	// [Temporal Warm-Start] Candidate for the forward pass only (history is forward motion)
+	const MotionField* predicted = nullptr;
+	m_WarmStartResidual = 1.0f;
+	if (enableWarmStart && m_MotionHistory.SameSize(currentFrame.Width, currentFrame.Height))
+	{
+		m_WarmStartResidual = ProjectMotion(currentFrame, prevFrame, m_Predicted);
+		predicted = &m_Predicted;
+	}
+
+	BlockMatching(currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, true, predicted, aggregateCost);
+	// [Flow Inversion] Single-pixel matches keep the second search (see OpticalFlow::DispatchBiDirectional)
+	if (invertBackward && aggregateCost)
+		InvertFlow(currentFrame, prevFrame, outputMotion, m_MotionBackward);
+	else
+		BlockMatching(prevFrame, currentFrame, m_MotionBackward, nullptr, blockSize, searchRadius, true, nullptr, aggregateCost);
+
+	CheckConsistency(outputMotion, m_MotionBackward, m_MotionRepaired, m_Visibility);
+	std::swap(outputMotion, m_MotionRepaired);
+
+	if (enableWarmStart) m_MotionHistory = outputMotion;
+	else m_MotionHistory = MotionField();
+}
+
+// [Flow Inversion] Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12), the smallest wins (CS_FlowSplat)
+static constexpr uint32_t SplatEmpty = 0xFFFFFFFFu;
+static constexpr int SplatOffsetBias = 2048;
+
+bool CPUOpticalFlow::ClaimedVector(const MotionField& forward, int x, int y, Float2& v, float& cost) const
+{
+	const uint32_t packed = m_Splat.At(x, y);
+	v = {};
+	cost = 1.0f;
+	if (packed == SplatEmpty) return false;
+
+	const int ox = (int)((packed >> 12) & 0xFFF) - SplatOffsetBias;
+	const int oy = (int)(packed & 0xFFF) - SplatOffsetBias;
+	v = forward.At(x + ox, y + oy) * -1.0f;
+	cost = (float)(packed >> 24) / 255.0f;
+	return true;
+}
+
+void CPUOpticalFlow::InvertFlow(const LumaImage& current, const LumaImage& prev,
+	const MotionField& forward, MotionField& backward)
+{
+	const int width = current.Width;
+	const int height = current.Height;
+	if (!backward.SameSize(width, height)) backward.Resize(width, height);
+	m_Splat.Resize(width, height, SplatEmpty);
+
+	// 1. Splat: every current pixel claims the previous pixel its vector lands on
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			const Float2& v = forward.At(x, y);
+			const int tx = (int)std::lround(x + v.x);
+			const int ty = (int)std::lround(y + v.y);
+			if (!m_Splat.Contains(tx, ty)) continue; // Leaves the frame
+			if (std::abs(x - tx) >= SplatOffsetBias || std::abs(y - ty) >= SplatOffsetBias) continue;
+
+			// 3x3 window: a single pixel matches too easily for the claim to vouch for the vector
+			float diff = 0.0f;
+			for (int wy = -1; wy <= 1; ++wy)
+				for (int wx = -1; wx <= 1; ++wx)
+					diff += AbsDiff(current.Clamped(x + wx, y + wy), prev.Clamped(tx + wx, ty + wy));
+			diff /= 9.0f;
+			const uint32_t cost = (uint32_t)(std::clamp(diff, 0.0f, 1.0f) * 255.0f + 0.5f);
+			const uint32_t packed = (cost << 24) | ((uint32_t)(x - tx + SplatOffsetBias) << 12) | (uint32_t)(y - ty + SplatOffsetBias);
+			uint32_t& slot = m_Splat.At(tx, ty);
+			slot = std::min(slot, packed);
+		}
+	}
+
+	// 2. Resolve: claimed pixels invert their claimant, the rest are filled and re-searched
+	static const int dirs[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			Float2 guess;
+			float cost;
+			const bool claimed = ClaimedVector(forward, x, y, guess, cost);
+			if (claimed && cost <= FlowTuning::FlowInversionCostTolerance)
+			{
+				backward.At(x, y) = guess;
+				continue;
+			}
+
+			// [Hole Filling] Nearest claim along 8 directions (stepping 1, 2, 4 ...), slowest one wins
+			if (!claimed)
+			{
+				float bestLengthSq = 1e9f;
+				for (const auto& d : dirs)
+				{
+					for (int r = 1; r <= FlowTuning::FlowInversionHoleRadius; r *= 2)
+					{
+						const int px = x + d[0] * r;
+						const int py = y + d[1] * r;
+						if (!m_Splat.Contains(px, py)) break;
+
+						Float2 v;
+						float c;
+						if (!ClaimedVector(forward, px, py, v, c)) continue;
+						if (LengthSq(v) < bestLengthSq)
+						{
+							bestLengthSq = LengthSq(v);
+							guess = v;
+						}
+						break;
+					}
+				}
+			}
+
+			// [Re-Search] 3x3 window SAD of prev against current, the guess wins ties
+			auto windowSAD = [&](const Float2& v)
+			{
+				++m_SADCount;
+				float sad = 0.0f;
+				for (int wy = -1; wy <= 1; ++wy)
+					for (int wx = -1; wx <= 1; ++wx)
+					{
+						const int px = std::clamp(x + wx, 0, width - 1);
+						const int py = std::clamp(y + wy, 0, height - 1);
+						sad += AbsDiff(prev.At(px, py), SampleBilinear(current, px + v.x, py + v.y));
+					}
+				return sad;
+			};
+
+			Float2 bestVector = guess;
+			float minSAD = windowSAD(guess);
+			for (int dy = -FlowTuning::FlowInversionRefineRadius; dy <= FlowTuning::FlowInversionRefineRadius; ++dy)
+			{
+				for (int dx = -FlowTuning::FlowInversionRefineRadius; dx <= FlowTuning::FlowInversionRefineRadius; ++dx)
+				{
+					if (dx == 0 && dy == 0) continue;
+
+					const Float2 candidate = guess + Float2{ (float)dx, (float)dy };
+					const float sad = windowSAD(candidate);
+					if (sad < minSAD)
+					{
+						minSAD = sad;
+						bestVector = candidate;
+					}
+				}
+			}
+			backward.At(x, y) = bestVector;
+		}
+	}
+}
+
+// Follows 'flow' from (x, y) and checks that 'reverse' brings it back
+static float Consistency(const MotionField& flow, const MotionField& reverse, int x, int y, float tolerance)
+{
+	const Float2 v = flow.At(x, y);
+	const int tx = (int)std::lround(x + v.x);
+	const int ty = (int)std::lround(y + v.y);
+
+	// Leaves the frame: nothing to match on the other side
+	if (!reverse.Contains(tx, ty)) return 0.0f;
+
+	const float dist = Length(v + reverse.At(tx, ty));
+	return std::clamp(1.0f - (dist - tolerance) * 0.5f, 0.0f, 1.0f);
+}
+
+// Uncovered content has no true match, so its vector is noise. It belongs to the background,
+// which is the slowest consistent vector around it (same rule as the Extrapolate hole filling).
+static Float2 RepairVector(const MotionField& forward, const MotionField& backward, int x, int y, int radius, float tolerance)
+{
+	static const int dirs[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } };
+
+	Float2 best = forward.At(x, y);
+	float bestLengthSq = 1e9f;
+	for (const auto& d : dirs)
+	{
+		// Nearest consistent pixel along each direction, stepping 2, 4, 8 ...
+		for (int r = 2; r <= radius; r *= 2)
+		{
+			const int px = x + d[0] * r;
+			const int py = y + d[1] * r;
+			if (!forward.Contains(px, py)) break;
+			if (Consistency(forward, backward, px, py, tolerance) < 0.5f) continue;
+
+			const Float2& v = forward.At(px, py);
+			if (LengthSq(v) < bestLengthSq)
+			{
+				bestLengthSq = LengthSq(v);
+				best = v;
+			}
+			break;
+		}
+	}
+	return best;
+}
+
+void CPUOpticalFlow::CheckConsistency(const MotionField& forward, const MotionField& backward,
+	MotionField& repaired, VisibilityMap& visibility)
+{
+	const int width = forward.Width;
+	const int height = forward.Height;
+	const int cellsX = (width + FlowTuning::VisibilityScale - 1) / FlowTuning::VisibilityScale;
+	const int cellsY = (height + FlowTuning::VisibilityScale - 1) / FlowTuning::VisibilityScale;
+	if (!visibility.SameSize(cellsX, cellsY)) visibility.Resize(cellsX, cellsY);
+	if (!repaired.SameSize(width, height)) repaired.Resize(width, height);
+
+	for (int cy = 0; cy < cellsY; ++cy)
+	{
+		for (int cx = 0; cx < cellsX; ++cx)
+		{
+			// Least visible pixel of the cell, a partly occluded cell counts as occluded
+			Float2 cell = { 1.0f, 1.0f };
+			for (int y = cy * FlowTuning::VisibilityScale; y < std::min((cy + 1) * FlowTuning::VisibilityScale, height); ++y)
+			{
+				for (int x = cx * FlowTuning::VisibilityScale; x < std::min((cx + 1) * FlowTuning::VisibilityScale, width); ++x)
+				{
+					const float fwd = Consistency(forward, backward, x, y, FlowTuning::ConsistencyTolerance);
+					cell.x = std::min(cell.x, fwd);
+					cell.y = std::min(cell.y, Consistency(backward, forward, x, y, FlowTuning::ConsistencyTolerance));
+
+					repaired.At(x, y) = (fwd < 0.5f)
+						? RepairVector(forward, backward, x, y, FlowTuning::OcclusionRepairRadius, FlowTuning::ConsistencyTolerance)
+						: forward.At(x, y);
+				}
+			}
+			visibility.At(cx, cy) = cell;
+		}
+	}
+}
+
+float CPUOpticalFlow::ProjectMotion(const LumaImage& current, const LumaImage& prev, MotionField& predicted) const
+{
+	const int width = current.Width;
+	const int height = current.Height;
+	if (!predicted.SameSize(width, height))
+		predicted.Resize(width, height);
+
+	// History texels per output pixel (1 at full resolution)
+	const float scaleX = (float)m_MotionHistory.Width / width;
+	const float scaleY = (float)m_MotionHistory.Height / height;
+
+	int poorPixels = 0;
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			// One fixed-point step of v = V(q + v), in history pixels
+			float hx = (x + 0.5f) * scaleX - 0.5f;
+			float hy = (y + 0.5f) * scaleY - 0.5f;
+			Float2 v0 = SampleBilinear(m_MotionHistory, hx, hy);
+			Float2 v = SampleBilinear(m_MotionHistory, hx + v0.x, hy + v0.y);
+			v = { v.x / scaleX, v.y / scaleY };
+			predicted.At(x, y) = v;
+
+			if (AbsDiff(current.At(x, y), SampleBilinear(prev, x + v.x, y + v.y)) > FlowTuning::WarmStartResidualTolerance)
+				++poorPixels;
+		}
+	}
+
+	return (float)poorPixels / std::max(1, width * height);
+}
+
+template<typename Refine>
+void CPUOpticalFlow::ForEachPixel(int width, int height, const std::vector<uint32_t>* tileList, Refine&& refine)
+{
+	if (!tileList)
+	{
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x) refine(x, y);
+		}
+		return;
+	}
+
+	// [Hybrid Flow] Packed x | y << 16 tiles, as CS_FlowSelect lists them
+	for (uint32_t tile : *tileList)
+	{
+		const int x0 = (int)(tile & 0xFFFF) * FlowTuning::FlowTileSize;
+		const int y0 = (int)(tile >> 16) * FlowTuning::FlowTileSize;
+		const int x1 = std::min(x0 + FlowTuning::FlowTileSize, width);
+		const int y1 = std::min(y0 + FlowTuning::FlowTileSize, height);
+		for (int y = y0; y < y1; ++y)
+		{
+			for (int x = x0; x < x1; ++x) refine(x, y);
+		}
+	}
+}
+
+// Port of CS_BlockMatching.hlsl (per-pixel search, early exit on exact match, bilinear half-pixel refinement)
+void CPUOpticalFlow::BlockMatching(const LumaImage& current, const LumaImage& prev, MotionField& motion,
+	const MotionField* initMotion,
+	int blockSize, int searchRadius, bool enableSubPixel,
+	const MotionField* predictedMotion,
+	bool aggregateCost,
+	const CandidateField* tileCandidates, float candidateScale,
+	const std::vector<uint32_t>* tileList,
+	bool tileRadius)
+{
+	if (aggregateCost)
+	{
+		AggregatedMatching(current, prev, motion, initMotion, blockSize, searchRadius, enableSubPixel, predictedMotion, tileCandidates, candidateScale, tileList, tileRadius);
+		return;
+	}
+
+	const int width = current.Width;
+	const int height = current.Height;
+	const float sceneNorm = (float)std::max(1, blockSize * blockSize);
+
+	// [Tile Hash] Only a mask of this frame's tile grid applies
+	const bool useUnchanged = m_UnchangedTiles &&
+		m_UnchangedTiles->SameSize((width + UnchangedTileSize - 1) / UnchangedTileSize, (height + UnchangedTileSize - 1) / UnchangedTileSize);
+
+	ForEachPixel(width, height, tileList, [&](int x, int y)
+	{
+		// [Tile Hash] Same content as last frame: zero motion, no search
+		if (useUnchanged && m_UnchangedTiles->At(x / UnchangedTileSize, y / UnchangedTileSize))
+		{
+			motion.At(x, y) = { 0.0f, 0.0f };
+			return;
+		}
+
+		const float target = current.At(x, y);
+
+		int cx = 0, cy = 0;
+		if (initMotion)
+		{
+			const Float2& init = initMotion->At(x, y);
+			cx = (int)std::lround(init.x);
+			cy = (int)std::lround(init.y);
+		}
+
+		// Fast path for static/perfect guess
+		++m_SADCount;
+		if (prev.Contains(x + cx, y + cy) && AbsDiff(target, prev.At(x + cx, y + cy)) < 0.00033f)
+		{
+			motion.At(x, y) = { (float)cx, (float)cy };
+			return;
+		}
+
+		float minSAD = 999999.0f;
+		int bestX = cx, bestY = cy;
+		bool done = false;
+
+		// Temporal candidate, competes with the search window
+		if (predictedMotion)
+		{
+			const Float2& pred = predictedMotion->At(x, y);
+			int px = (int)std::lround(pred.x);
+			int py = (int)std::lround(pred.y);
+			if (prev.Contains(x + px, y + py))
+			{
+				++m_SADCount;
+				float sad = AbsDiff(target, prev.At(x + px, y + py));
+				if (sad < 0.00033f)
+				{
+					motion.At(x, y) = { (float)px, (float)py };
+					return;
+				}
+				minSAD = sad;
+				bestX = px;
+				bestY = py;
+			}
+		}
+
+		// [Phase Correlation] The tile's correlation peaks compete the same way, reaching shifts the window does not
+		if (tileCandidates)
+		{
+			Float2 peaks[PhaseCorrelation::Candidates];
+			TileCandidates(*tileCandidates, candidateScale, x, y, peaks);
+			bool matched = false;
+			for (const Float2& peak : peaks)
+			{
+				int px = (int)std::lround(peak.x);
+				int py = (int)std::lround(peak.y);
+				if (!prev.Contains(x + px, y + py)) continue;
+
+				++m_SADCount;
+				float sad = AbsDiff(target, prev.At(x + px, y + py));
+				if (sad < 0.00033f)
+				{
+					motion.At(x, y) = { (float)px, (float)py };
+					matched = true;
+					break;
+				}
+				if (sad < minSAD)
+				{
+					minSAD = sad;
+					bestX = px;
+					bestY = py;
+				}
+			}
+			if (matched) return;
+		}
+
+		const int radius = tileRadius ? TileSearchRadius(x, y, width, searchRadius) : searchRadius;
+		for (int dy = -radius; dy <= radius && !done; ++dy)
+		{
+			for (int dx = -radius; dx <= radius; ++dx)
+			{
+				int sx = x + cx + dx;
+				int sy = y + cy + dy;
+				if (!prev.Contains(sx, sy)) continue;
+
+				++m_SADCount;
+				float sad = AbsDiff(target, prev.At(sx, sy));
+				if (sad < minSAD)
+				{
+					minSAD = sad;
+					bestX = cx + dx;
+					bestY = cy + dy;
+					if (sad < 0.00033f) { done = true; break; }
+				}
+			}
+		}
+
+		if (minSAD / sceneNorm > 0.15f)
+			++m_SceneChangeCount;
+
+		Float2 finalVector = { (float)bestX, (float)bestY };
+
+		if (enableSubPixel)
+		{
+			static const Float2 offsets[4] = { { 0.5f, 0.0f }, { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.0f, -0.5f } };
+			Float2 bestSub = finalVector;
+			float minSubSAD = minSAD;
+			for (const Float2& o : offsets)
+			{
+				Float2 candidate = finalVector + o;
+				++m_SADCount;
+				float sad = AbsDiff(target, SampleBilinear(prev, x + candidate.x, y + candidate.y));
+				if (sad < minSubSAD)
+				{
+					minSubSAD = sad;
+					bestSub = candidate;
+				}
+			}
+			finalVector = bestSub;
+		}
+
+		motion.At(x, y) = finalVector;
+	});
+}
+
+namespace
+{
+	// Luma abs diff of current(x, y) against prev(x + vx, y + vy) for x in [x0, x0 + count), clamp addressing
+	void AbsDiffRow(const LumaImage& current, const LumaImage& prev, int x0, int y, int count, int vx, int vy, float* out)
+	{
+		const float* cur = &current.At(0, std::clamp(y, 0, current.Height - 1));
+		const float* prv = &prev.At(0, std::clamp(y + vy, 0, prev.Height - 1));
+		const int maxX = current.Width - 1;
+
+		// Span where neither fetch needs clamping
+		const int begin = std::clamp(std::max(-x0, -x0 - vx), 0, count);
+		const int end = std::clamp(std::min(current.Width - x0, current.Width - x0 - vx), begin, count);
+
+		int i = 0;
+		for (; i < begin; ++i)
+			out[i] = AbsDiff(cur[std::clamp(x0 + i, 0, maxX)], prv[std::clamp(x0 + i + vx, 0, maxX)]);
+
+#ifdef LFG_CPU_SSE2
+		// Four pixels per step: |a - b| with the sign bit masked off
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 d = _mm_sub_ps(_mm_loadu_ps(cur + x0 + i), _mm_loadu_ps(prv + x0 + i + vx));
+			_mm_storeu_ps(out + i, _mm_and_ps(d, absMask));
+		}
+#endif
+		for (; i < end; ++i)
+			out[i] = AbsDiff(cur[x0 + i], prv[x0 + i + vx]);
+
+		for (; i < count; ++i)
+			out[i] = AbsDiff(cur[std::clamp(x0 + i, 0, maxX)], prv[std::clamp(x0 + i + vx, 0, maxX)]);
+	}
+
+	// Same as CS_CostAggregation SubPixelSAD: 3x3 window, bilinear taps
+	float SubPixelSAD(const LumaImage& current, const LumaImage& prev, int x, int y, const Float2& v)
+	{
+		float sad = 0.0f;
+		for (int dy = -1; dy <= 1; ++dy)
+		{
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				int px = std::clamp(x + dx, 0, current.Width - 1);
+				int py = std::clamp(y + dy, 0, current.Height - 1);
+				sad += AbsDiff(current.At(px, py), SampleBilinear(prev, px + v.x, py + v.y));
+			}
+		}
+		return sad;
+	}
+}
+
+void CPUOpticalFlow::WindowSAD(const LumaImage& current, const LumaImage& prev,
+	int x0, int y0, int width, int height, int window, int vx, int vy, std::vector<float>& sad)
+{
+	// Sliding box sums: horizontal per apron row, vertical over a ring of the last 'window' row sums
+	const int apronX = x0 - window / 2;
+	const int apronY = y0 - window / 2;
+	const int apronWidth = width + window - 1;
+	const int apronHeight = height + window - 1;
+
+	m_AbsDiffRow.resize(apronWidth);
+	m_RowSums.assign((size_t)window * width, 0.0f);
+	m_ColumnSums.assign(width, 0.0f);
+	sad.resize((size_t)width * height);
+
+	for (int ay = 0; ay < apronHeight; ++ay)
+	{
+		AbsDiffRow(current, prev, apronX, apronY + ay, apronWidth, vx, vy, m_AbsDiffRow.data());
+		const float* ad = m_AbsDiffRow.data();
+
+		// The ring slot holds the row leaving the vertical window (zeros for the first 'window' rows)
+		float* row = &m_RowSums[(size_t)(ay % window) * width];
+		float* column = m_ColumnSums.data();
+
+		float sum = 0.0f;
+		for (int k = 0; k < window; ++k) sum += ad[k];
+		for (int x = 0; x < width; ++x)
+		{
+			if (x > 0) sum += ad[x + window - 1] - ad[x - 1];
+			column[x] += sum - row[x];
+			row[x] = sum;
+		}
+
+		if (ay >= window - 1)
+			std::copy(m_ColumnSums.begin(), m_ColumnSums.end(), sad.begin() + (size_t)(ay - window + 1) * width);
+	}
+
+	m_SADCount += (long long)apronWidth * apronHeight;
+}
+
+void CPUOpticalFlow::AggregatedMatching(const LumaImage& current, const LumaImage& prev, MotionField& motion,
+	const MotionField* initMotion,
+	int window, int searchRadius, bool enableSubPixel,
+	const MotionField* predictedMotion,
+	const CandidateField* tileCandidates, float candidateScale,
+	const std::vector<uint32_t>* tileList, bool tileRadius)
+{
+	const int width = current.Width;
+	const int height = current.Height;
+	window = std::clamp(window, 1, 32);
+	const float norm = 1.0f / (float)(window * window);
+
+	m_BestCost.assign((size_t)width * height, 999999.0f);
+	m_BestSAD.assign((size_t)width * height, 0.0f);
+
+	// Without per-tile guesses every tile of the shader runs the same candidates,
+	// so the whole frame is one region (same result, no apron per tile)
+	const bool sharedCandidates = !initMotion && !predictedMotion && !tileCandidates && !tileList && !tileRadius;
+	const int tileWidth = sharedCandidates ? width : FlowTuning::CostAggregationTile;
+	const int tileHeight = sharedCandidates ? height : FlowTuning::CostAggregationTile;
+
+	auto matchTile = [&](int tx, int ty)
+	{
+		const int w = std::min(tileWidth, width - tx);
+		const int h = std::min(tileHeight, height - ty);
+
+		// Tile center as in the shader (tileOrigin + TILE / 2)
+		const int cx = std::min(tx + FlowTuning::CostAggregationTile / 2, width - 1);
+		const int cy = std::min(ty + FlowTuning::CostAggregationTile / 2, height - 1);
+
+		int centerX = 0, centerY = 0;
+		if (initMotion)
+		{
+			centerX = (int)std::lround(initMotion->At(cx, cy).x);
+			centerY = (int)std::lround(initMotion->At(cx, cy).y);
+		}
+
+		auto evaluate = [&](int vx, int vy)
+		{
+			WindowSAD(current, prev, tx, ty, w, h, window, vx, vy, m_WindowSAD);
+			const float bias = FlowTuning::CostAggregationVectorBias * std::sqrt((float)(vx * vx + vy * vy));
+			for (int y = 0; y < h; ++y)
+			{
+				for (int x = 0; x < w; ++x)
+				{
+					const float sad = m_WindowSAD[(size_t)y * w + x];
+					const size_t idx = (size_t)(ty + y) * width + (tx + x);
+					const float cost = sad * norm + bias;
+					if (cost < m_BestCost[idx])
+					{
+						m_BestCost[idx] = cost;
+						m_BestSAD[idx] = sad;
+						motion.At(tx + x, ty + y) = { (float)vx, (float)vy };
+					}
+				}
+			}
+		};
+
+		// Guess first so it wins ties
+		evaluate(centerX, centerY);
+
+		if (predictedMotion)
+		{
+			const Float2& pred = predictedMotion->At(cx, cy);
+			evaluate((int)std::lround(pred.x), (int)std::lround(pred.y));
+		}
+
+		// [Phase Correlation] The correlation peaks of the tile's center
+		if (tileCandidates)
+		{
+			Float2 peaks[PhaseCorrelation::Candidates];
+			TileCandidates(*tileCandidates, candidateScale, cx, cy, peaks);
+			for (const Float2& peak : peaks)
+				evaluate((int)std::lround(peak.x), (int)std::lround(peak.y));
+		}
+
+		// [Adaptive Radius] One window per tile, as in the shader
+		const int radius = tileRadius ? TileSearchRadius(cx, cy, width, searchRadius) : searchRadius;
+		for (int dy = -radius; dy <= radius; ++dy)
+		{
+			for (int dx = -radius; dx <= radius; ++dx)
+			{
+				if (dx == 0 && dy == 0) continue;
+				evaluate(centerX + dx, centerY + dy);
+			}
+		}
+	};
+
+	// [Hybrid Flow] The listed tiles only (CSTiles)
+	if (tileList)
+	{
+		for (uint32_t tile : *tileList) matchTile((int)(tile & 0xFFFF) * FlowTuning::CostAggregationTile, (int)(tile >> 16) * FlowTuning::CostAggregationTile);
+	}
+	else
+	{
+		for (int ty = 0; ty < height; ty += tileHeight)
+		{
+			for (int tx = 0; tx < width; tx += tileWidth) matchTile(tx, ty);
+		}
+	}
+
+	ForEachPixel(width, height, tileList, [&](int x, int y)
+	{
+		if (m_BestSAD[(size_t)y * width + x] * norm > 0.15f)
+			++m_SceneChangeCount;
+
+		if (!enableSubPixel) return;
+
+		static const Float2 offsets[4] = { { 0.5f, 0.0f }, { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.0f, -0.5f } };
+		const Float2 finalVector = motion.At(x, y);
+		Float2 bestSub = finalVector;
+		float minSubSAD = SubPixelSAD(current, prev, x, y, finalVector);
+		for (const Float2& o : offsets)
+		{
+			float sad = SubPixelSAD(current, prev, x, y, finalVector + o);
+			if (sad < minSubSAD)
+			{
+				minSubSAD = sad;
+				bestSub = finalVector + o;
+			}
+		}
+		m_SADCount += 5 * 9;
+		motion.At(x, y) = bestSub;
+	});
+}
+
+namespace
+{
+	// Must match CS_RecursiveSearch.hlsl
+	constexpr int NumCandidates = 7;
+	constexpr float PenaltyTemporal = 0.0033f;
+	constexpr float PenaltyUpdate = 0.01f;
+	constexpr float PenaltyZero = 0.0017f;
+
+	const Float2 UpdateSet[12] =
+	{
+		{ 0, 1 }, { 0, -1 }, { 1, 0 }, { -1, 0 },
+		{ 0, 2 }, { 0, -2 }, { 3, 0 }, { -3, 0 },
+		{ 0.25f, 0 }, { -0.25f, 0 }, { 0, 0.25f }, { 0, -0.25f }
+	};
+
+	uint32_t Hash(uint32_t x)
+	{
+		x ^= x >> 16;
+		x *= 0x7feb352du;
+		x ^= x >> 15;
+		x *= 0x846ca68bu;
+		x ^= x >> 16;
+		return x;
+	}
+}
+
+float CPUOpticalFlow::BlockSAD(const LumaImage& current, const LumaImage& prev,
+	int x0, int y0, int blockSize, const Float2& vector, int decimation)
+{
+	const bool integer = vector.x == std::floor(vector.x) && vector.y == std::floor(vector.y);
+	const int x1 = std::min(x0 + blockSize, current.Width);
+	const int y1 = std::min(y0 + blockSize, current.Height);
+
+	float sad = 0.0f;
+	long long count = 0;
+	for (int y = y0; y < y1; ++y)
+	{
+		for (int x = x0; x < x1; ++x)
+		{
+			// Checkerboard relative to the block origin (CS_BlockSearch)
+			if (decimation == 2 && ((x - x0 + y - y0) & 1)) continue;
+
+			++count;
+			const float target = current.At(x, y);
+			if (integer)
+				sad += AbsDiff(target, prev.Clamped(x + (int)vector.x, y + (int)vector.y));
+			else
+				sad += AbsDiff(target, SampleBilinear(prev, x + vector.x, y + vector.y));
+		}
+	}
+	m_SADCount += count;
+	return sad;
+}
+
+void CPUOpticalFlow::RecursiveSearch(const LumaImage& current, const LumaImage& prev,
+	int blockSize, bool enableSubPixel)
+{
+	const int bw = (current.Width + blockSize - 1) / blockSize;
+	const int bh = (current.Height + blockSize - 1) / blockSize;
+
+	// New size (or first frame): start from zero motion
+	if (!m_BlockHistory.SameSize(bw, bh))
+		m_BlockHistory.Resize(bw, bh);
+	m_BlockField.Resize(bw, bh);
+
+	++m_FrameIndex;
+	const uint32_t updateCount = enableSubPixel ? 12 : 8;
+
+	// Meandering scan: even rows left to right, odd rows right to left.
+	// Spatial candidates come from blocks already estimated in this frame.
+	for (int by = 0; by < bh; ++by)
+	{
+		const int d = (by % 2 == 0) ? 1 : -1;
+		for (int i = 0; i < bw; ++i)
+		{
+			const int bx = (d > 0) ? i : bw - 1 - i;
+
+			// Same row, behind
+			Float2 sa = (bx - d >= 0 && bx - d < bw) ? m_BlockField.At(bx - d, by) : m_BlockHistory.At(bx, by);
+			// Previous row, ahead
+			Float2 sb = (by > 0) ? m_BlockField.Clamped(bx + d, by - 1) : m_BlockHistory.Clamped(bx + d, by);
+
+			uint32_t rnd = Hash((uint32_t)(bx + by * 4096) ^ Hash((uint32_t)m_FrameIndex));
+
+			Float2 candidates[NumCandidates] =
+			{
+				sa,
+				sb,
+				sa + UpdateSet[rnd % updateCount],
+				sb + UpdateSet[(rnd >> 8) % updateCount],
+				m_BlockHistory.Clamped(bx, by + 1), // Not yet visited this frame
+				m_BlockHistory.At(bx, by),
+				{ 0.0f, 0.0f }
+			};
+			const float penalties[NumCandidates] = { 0.0f, 0.0f, PenaltyUpdate, PenaltyUpdate, PenaltyTemporal, PenaltyTemporal, PenaltyZero };
+
+			const int x0 = bx * blockSize;
+			const int y0 = by * blockSize;
+			const float count = (float)(std::min(blockSize, current.Width - x0) * std::min(blockSize, current.Height - y0));
+
+			if (RegionUnchanged(x0, y0, std::min(x0 + blockSize, current.Width), std::min(y0 + blockSize, current.Height)))
+			{
+				m_BlockField.At(bx, by) = { 0.0f, 0.0f };
+				continue;
+			}
+
+			float bestCost = 999999.0f;
+			float bestSAD = 0.0f;
+			Float2 bestVector;
+			for (int c = 0; c < NumCandidates; ++c)
+			{
+				float sad = BlockSAD(current, prev, x0, y0, blockSize, candidates[c]);
+				float cost = sad / count + penalties[c];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSAD = sad;
+					bestVector = candidates[c];
+				}
+			}
+
+			m_BlockField.At(bx, by) = bestVector;
+
+			if (bestSAD / count > 0.15f)
+				m_SceneChangeCount += (int)count;
+		}
+	}
+
+	m_BlockHistory = m_BlockField;
+}
+
+void CPUOpticalFlow::BlockSearch(const LumaImage& current, const LumaImage& prev,
+	int blockSize, int searchRadius, bool enableSubPixel)
+{
+	const int bw = (current.Width + blockSize - 1) / blockSize;
+	const int bh = (current.Height + blockSize - 1) / blockSize;
+
+	// New size (or first frame): the temporal candidate starts at zero
+	if (!m_BlockHistory.SameSize(bw, bh))
+		m_BlockHistory.Resize(bw, bh);
+	m_BlockField.Resize(bw, bh);
+
+	const int decimation = (blockSize >= FlowTuning::BlockSearchDecimateFrom) ? 2 : 1;
+	const int side = 2 * searchRadius + 1;
+	const int gridCount = side * side;
+
+	for (int by = 0; by < bh; ++by)
+	{
+		for (int bx = 0; bx < bw; ++bx)
+		{
+			const int x0 = bx * blockSize;
+			const int y0 = by * blockSize;
+			const int extentX = std::min(blockSize, current.Width - x0);
+			const int extentY = std::min(blockSize, current.Height - y0);
+			const int cellCount = extentX * extentY;
+			const float count = (float)((decimation == 2) ? (cellCount + 1) / 2 : cellCount);
+
+			if (RegionUnchanged(x0, y0, x0 + extentX, y0 + extentY))
+			{
+				m_BlockField.At(bx, by) = { 0.0f, 0.0f };
+				continue;
+			}
+
+			const Float2& init = m_BlockHistory.At(bx, by);
+			const Float2 initInt = { std::round(init.x), std::round(init.y) };
+
+			// Window around zero, plus last frame's vector for this block
+			float bestCost = 999999.0f;
+			Float2 bestVector;
+			for (int k = 0; k <= gridCount; ++k)
+			{
+				Float2 v = (k < gridCount)
+					? Float2{ (float)(k % side - searchRadius), (float)(k / side - searchRadius) }
+					: initInt;
+				float cost = BlockSAD(current, prev, x0, y0, blockSize, v, decimation) / count
+					+ FlowTuning::BlockSearchVectorBias * Length(v);
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestVector = v;
+				}
+			}
+
+			// [Sub-Pixel Refinement] Half-pel around the winner
+			if (enableSubPixel)
+			{
+				const Float2 offsets[4] = { { 0.5f, 0.0f }, { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.0f, -0.5f } };
+				Float2 bestSub = bestVector;
+				for (const Float2& o : offsets)
+				{
+					Float2 v = bestVector + o;
+					float cost = BlockSAD(current, prev, x0, y0, blockSize, v, decimation) / count
+						+ FlowTuning::BlockSearchVectorBias * Length(v);
+					if (cost < bestCost)
+					{
+						bestCost = cost;
+						bestSub = v;
+					}
+				}
+				bestVector = bestSub;
+			}
+
+			m_BlockField.At(bx, by) = bestVector;
+
+			if (bestCost > 0.15f)
+				m_SceneChangeCount += cellCount;
+		}
+	}
+
+	m_BlockHistory = m_BlockField;
+}
+
+bool CPUOpticalFlow::RegionUnchanged(int x0, int y0, int x1, int y1) const
+{
+	if (!m_UnchangedTiles) return false;
+	for (int ty = y0 / UnchangedTileSize; ty <= (y1 - 1) / UnchangedTileSize; ++ty)
+	{
+		for (int tx = x0 / UnchangedTileSize; tx <= (x1 - 1) / UnchangedTileSize; ++tx)
+		{
+			if (!m_UnchangedTiles->Contains(tx, ty) || !m_UnchangedTiles->At(tx, ty)) return false;
+		}
+	}
+	return true;
+}
+
+void CPUOpticalFlow::ExpandBlockField(const MotionField& field, MotionField& outputMotion, int width, int height, int blockSize)
+{
+	// CS_MotionExpand: block vectors sit at block centers
+	if (!outputMotion.SameSize(width, height))
+		outputMotion.Resize(width, height);
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			outputMotion.At(x, y) = SampleMotion(field, (float)x, (float)y, blockSize);
+		}
+	}
+}
+
+void CPUOpticalFlow::CalcVariance(const LumaImage& input)
+{
+	const int gw = (input.Width + 15) / 16;
+	const int gh = (input.Height + 15) / 16;
+	m_VarianceGrid.Resize(gw, gh);
+
+	for (int gy = 0; gy < gh; ++gy)
+	{
+		for (int gx = 0; gx < gw; ++gx)
+		{
+			// 16x16 block, every other pixel (64 samples)
+			float sum = 0.0f;
+			float sumSq = 0.0f;
+			for (int y = 0; y < 16; y += 2)
+			{
+				for (int x = 0; x < 16; x += 2)
+				{
+					float lum = input.Clamped(gx * 16 + x, gy * 16 + y);
+					sum += lum;
+					sumSq += lum * lum;
+				}
+			}
+			float mean = sum / 64.0f;
+			float variance = sumSq / 64.0f - mean * mean;
+			m_VarianceGrid.At(gx, gy) = std::clamp(variance * 100.0f, 0.0f, 1.0f);
+		}
+	}
+}
+
+void CPUOpticalFlow::QuadtreeSearch(const LumaImage& current, const LumaImage& prev,
+	int searchRadius, bool enableSubPixel, bool useHistory)
+{
+	const int fw = (current.Width + FlowTuning::QuadtreeLeafSize - 1) / FlowTuning::QuadtreeLeafSize;
+	const int fh = (current.Height + FlowTuning::QuadtreeLeafSize - 1) / FlowTuning::QuadtreeLeafSize;
+
+	if (!m_QuadHistory.SameSize(fw, fh))
+		m_QuadHistory.Resize(fw, fh);
+	m_QuadField.Resize(fw, fh);
+	m_QuadSize.Resize(fw, fh, FlowTuning::QuadtreeRootSize);
+
+	const int childRadius = std::max(2, searchRadius / 4);
+	static const Float2 offsets[4] = { { 0.5f, 0.0f }, { -0.5f, 0.0f }, { 0.0f, 0.5f }, { 0.0f, -0.5f } };
+
+	auto round = [](const Float2& v) { return Float2{ std::round(v.x), std::round(v.y) }; };
+
+	for (int nodeSize = FlowTuning::QuadtreeRootSize; nodeSize >= FlowTuning::QuadtreeLeafSize; nodeSize /= 2)
+	{
+		// Parents and neighbours come from the field before this pass
+		const MotionField parent = m_QuadField;
+		const int cellsPerNode = nodeSize / FlowTuning::QuadtreeLeafSize;
+		const int radius = (nodeSize == FlowTuning::QuadtreeRootSize) ? searchRadius : childRadius;
+		const int side = 2 * radius + 1;
+		const int decimation = (nodeSize >= 16) ? 2 : 1;
+
+		for (int y0 = 0; y0 < current.Height; y0 += nodeSize)
+		{
+			for (int x0 = 0; x0 < current.Width; x0 += nodeSize)
+			{
+				const int cx = x0 / FlowTuning::QuadtreeLeafSize;
+				const int cy = y0 / FlowTuning::QuadtreeLeafSize;
+				if (m_QuadSize.At(cx, cy) != nodeSize) continue;
+
+				const int cellCount = std::min(nodeSize, current.Width - x0) * std::min(nodeSize, current.Height - y0);
+				const float count = (float)((decimation == 2) ? (cellCount + 1) / 2 : cellCount);
+				auto cost = [&](const Float2& v)
+				{
+					return BlockSAD(current, prev, x0, y0, nodeSize, v, decimation) / count + FlowTuning::BlockSearchVectorBias * Length(v);
+				};
+
+				const Float2 parentVec = parent.At(cx, cy);
+				const Float2 center = round(parentVec);
+				const Float2 historyVec = useHistory ? m_QuadHistory.Clamped(cx + cellsPerNode / 2, cy + cellsPerNode / 2) : parentVec;
+				const Float2 extra[5] =
+				{
+					round(historyVec),
+					round(parent.Clamped(cx - cellsPerNode, cy)),
+					round(parent.Clamped(cx + cellsPerNode, cy)),
+					round(parent.Clamped(cx, cy - cellsPerNode)),
+					round(parent.Clamped(cx, cy + cellsPerNode))
+				};
+
+				float minCost = 999999.0f;
+				Float2 bestVec;
+				for (int k = 0; k < side * side + 5; ++k)
+				{
+					Float2 v = (k < side * side)
+						? center + Float2{ (float)(k % side - radius), (float)(k / side - radius) }
+						: extra[k - side * side];
+					float c = cost(v);
+					if (c < minCost)
+					{
+						minCost = c;
+						bestVec = v;
+					}
+				}
+
+				// Variance sets how deep the node may go, the residual decides whether it does
+				float variance = 0.0f;
+				const int varCells = std::max(nodeSize / 16, 1);
+				for (int vy = 0; vy < varCells; ++vy)
+					for (int vx = 0; vx < varCells; ++vx)
+						if (m_VarianceGrid.Contains(x0 / 16 + vx, y0 / 16 + vy))
+							variance = std::max(variance, m_VarianceGrid.At(x0 / 16 + vx, y0 / 16 + vy));
+
+				const int minSize = (variance > FlowTuning::QuadtreeVarianceThreshold) ? FlowTuning::QuadtreeLeafSize : 16;
+				const bool split = nodeSize > minSize && minCost > FlowTuning::QuadtreeResidualThreshold;
+
+				if (!split && enableSubPixel)
+				{
+					Float2 bestSub = bestVec;
+					for (const Float2& o : offsets)
+					{
+						float c = cost(bestVec + o);
+						if (c < minCost)
+						{
+							minCost = c;
+							bestSub = bestVec + o;
+						}
+					}
+					bestVec = bestSub;
+				}
+
+				for (int y = cy; y < std::min(cy + cellsPerNode, fh); ++y)
+				{
+					for (int x = cx; x < std::min(cx + cellsPerNode, fw); ++x)
+					{
+						m_QuadField.At(x, y) = bestVec;
+						m_QuadSize.At(x, y) = split ? nodeSize / 2 : nodeSize;
+					}
+				}
+
+				if (!split && minCost > 0.15f)
+					m_SceneChangeCount += cellCount;
+			}
+		}
+	}
+
+	m_QuadHistory = m_QuadField;
+}
@@ -0,0 +1,254 @@
+#pragma once
+#include "CPUImage.h"
+#include <cstdint>
+#include "../OpticalFlow/FlowAlgorithm.h"
+#include "../OpticalFlow/FlowTuning.h"
+#include "../OpticalFlow/PyramidSchedule.h"
+#include "../OpticalFlow/GlobalMotion.h"
+#include "../OpticalFlow/PhaseCorrelation.h"
+#include "../OpticalFlow/AdaptiveRadius.h"
+
+class CPULumaPyramid;
+
+// CPU reference implementation of the optical flow stage.
+// Mirrors the compute shaders so results can be compared offline against synthetic sequences.
+// Frames are luma planes (CPULumaPyramid level 0), as the GPU passes read the shared LumaPyramid.
+class CPUOpticalFlow
+{
+public:
+	CPUOpticalFlow() = default;
+	~CPUOpticalFlow() = default;
+
+	// blockGranular (BlockMatching/3DRS): outputMotion is resized to the block grid and holds one vector per block.
+	// Motion convention matches OpticalFlow: OutputMotion[p] points from p in the current frame to its match in the previous frame.
+	void Dispatch(const CPU::LumaImage& currentFrame,
+		const CPU::LumaImage& prevFrame,
+		CPU::MotionField& outputMotion,
+		int blockSize, int searchRadius,
+		bool enableSubPixel,
+		FlowAlgorithm algo = FlowAlgorithm::BlockMatching,
+		bool enableWarmStart = false,
+		bool blockGranular = false,
+		bool aggregateCost = false);
+
+	// [Pyramid] Port of OpticalFlow::Dispatch's hierarchical BlockMatching: maxLevel down to minLevel of 'luma'
+	// (Pyramid::Schedule per level), the finest searched level upsampled to full resolution
+	void DispatchPyramid(const CPULumaPyramid& luma,
+		CPU::MotionField& outputMotion,
+		int blockSize, int searchRadius,
+		bool enableSubPixel,
+		int maxLevel, int minLevel,
+		bool enableWarmStart = false,
+		bool aggregateCost = false,
+		bool enableGlobalMotion = false, // [Global Motion] Seeds the coarsest level with the model fitted to last frame's field
+		bool enablePhaseCorrelation = false, // [Phase Correlation] Per-tile correlation peaks join the coarsest level's candidates
+		bool enableAdaptiveRadius = false); // [Adaptive Radius] Reach and levels from last frame's measured motion
+
+	// [Farneback & DIS] Port of OpticalFlow::Dispatch's Farneback, DIS and [Hybrid Flow] paths: the coarse levels of
+	// 'luma' (maxLevel down to max(minLevel, 1)) as the initial guess, refined at full resolution. Both frames are
+	// expanded per call, where the GPU carries last frame's expansion over (ExpandFrame).
+	void DispatchRefined(const CPULumaPyramid& luma,
+		CPU::MotionField& outputMotion,
+		FlowAlgorithm algo,
+		int blockSize, int searchRadius,
+		bool enableSubPixel,
+		int maxLevel, int minLevel,
+		bool enableWarmStart = false,
+		bool aggregateCost = false);
+
+	// Port of CS_Upsample.hlsl at width x height: nearest coarse vector, doubled, or [Guided Upsample] the separable
+	// joint bilateral blend when both luma guides (the levels of 'fine' and 'coarse') are given
+	void Upsample(const CPU::MotionField& coarse, CPU::MotionField& fine, int width, int height,
+		const CPU::LumaImage* guideFine = nullptr, const CPU::LumaImage* guideCoarse = nullptr);
+
+	// [Quadtree] Port of OpticalFlow::DispatchAdaptive (variance grid + quadtree search, 32x32 down to 4x4)
+	void DispatchAdaptive(const CPU::LumaImage& currentFrame,
+		const CPU::LumaImage& prevFrame,
+		CPU::MotionField& outputMotion,
+		int searchRadius,
+		bool enableWarmStart = false);
+
+	// [Occlusion] Port of OpticalFlow::DispatchBiDirectional: forward + backward BlockMatching, then the
+	// consistency check into GetVisibility(). outputMotion is the forward (current -> previous) flow.
+	void DispatchBiDirectional(const CPU::LumaImage& currentFrame,
+		const CPU::LumaImage& prevFrame,
+		CPU::MotionField& outputMotion,
+		int blockSize, int searchRadius,
+		bool enableWarmStart = false,
+		bool aggregateCost = false,
+		bool invertBackward = false); // [Flow Inversion] Windowed cost only, as on the GPU
+
+	// Port of CS_BidirectionalConsistency.hlsl: one visibility texel per VisibilityScale x VisibilityScale pixels,
+	// and the forward flow with uncovered vectors replaced by the slowest consistent neighbour
+	static void CheckConsistency(const CPU::MotionField& forward, const CPU::MotionField& backward,
+		CPU::MotionField& repaired, CPU::VisibilityMap& visibility);
+
+	// Number of pixels whose best match exceeded the scene change tolerance (GlobalStats[0] on the GPU)
+	int GetSceneChangeCount() const { return m_SceneChangeCount; }
+	// Fraction of pixels the projected history failed to explain (1.0 = no history)
+	float GetWarmStartResidual() const { return m_WarmStartResidual; }
+	void ResetHistory() { m_MotionHistory = CPU::MotionField(); m_BlockHistory = CPU::MotionField(); m_GlobalValid = false; m_TileStatsValid = false; m_AdaptiveRadius.Reset(); m_TileRadius = CPU::LumaImage(); }
+	// [Global Motion] Model fitted to the last DispatchPyramid's field, seeds the next one (Type None when nothing fitted)
+	GlobalMotion::Estimate GetGlobalMotion() const { return m_GlobalValid ? m_GlobalMotion.GetEstimate() : GlobalMotion::Estimate(); }
+	// [Adaptive Radius] Reach the next adaptive DispatchPyramid searches, never above maxRadius
+	int GetAdaptiveRadius(int maxRadius) const { return m_AdaptiveRadius.GetRadius(maxRadius); }
+	// Per-tile bounds of the next coarsest search (FlowTuning::FlowTileSize tiles, flow pixels)
+	const CPU::LumaImage& GetTileRadius() const { return m_TileRadius; }
+	// [Phase Correlation] Tile candidates of the last DispatchPyramid that ran them (PhaseCorrelation::CandidateLevel pixels)
+	const CPU::CandidateField& GetTileCandidates() const { return m_TileCandidates; }
+	// [Tile Hash] CPUFrameHash::GetUnchanged of the current frame (nullptr = off): unchanged 16x16 tiles get
+	// zero motion without a search in BlockMatching, BlockSearch and 3DRS
+	void SetUnchangedTiles(const CPU::Image<uint8_t>* unchangedTiles) { m_UnchangedTiles = unchangedTiles; }
+
+	// [Hybrid Flow] FlowAlgorithm per FlowTileSize tile of the last hybrid DispatchRefined
+	const CPU::Image<uint8_t>& GetTileAlgorithms() const { return m_TileAlgorithms; }
+
+	// Per-pixel SAD evaluations of the last Dispatch (search cost, for comparing estimators).
+	// Farneback and DIS count their window taps, one per pixel and iteration.
+	long long GetSADCount() const { return m_SADCount; }
+	// [3DRS] Block field of the last Dispatch (one vector per block)
+	const CPU::MotionField& GetBlockField() const { return m_BlockHistory; }
+	// [Quadtree] Size of the node owning each 4x4 cell after the last DispatchAdaptive
+	const CPU::Image<int>& GetLeafSizes() const { return m_QuadSize; }
+	// [Occlusion] Visibility of the last DispatchBiDirectional (empty after the other paths)
+	const CPU::VisibilityMap& GetVisibility() const { return m_Visibility; }
+	const CPU::MotionField& GetBackwardMotion() const { return m_MotionBackward; }
+	// Block size of the last outputMotion (1 = per-pixel), pass to CPUFrameInterpolation
+	int GetMotionBlockSize() const { return m_MotionBlockSize; }
+
+private:
+	void BlockMatching(const CPU::LumaImage& current, const CPU::LumaImage& prev, CPU::MotionField& motion,
+		const CPU::MotionField* initMotion,
+		int blockSize, int searchRadius, bool enableSubPixel,
+		const CPU::MotionField* predictedMotion = nullptr,
+		bool aggregateCost = false,
+		const CPU::CandidateField* tileCandidates = nullptr, float candidateScale = 1.0f,
+		const std::vector<uint32_t>* tileList = nullptr, // [Hybrid Flow] Only these FlowTileSize tiles (CSTiles)
+		bool tileRadius = false); // [Adaptive Radius] Narrow the window per tile to m_TileRadius
+
+	// [Cost Aggregation] Port of CS_CostAggregation.hlsl (BlockSize window SAD, candidates shared per tile)
+	void AggregatedMatching(const CPU::LumaImage& current, const CPU::LumaImage& prev, CPU::MotionField& motion,
+		const CPU::MotionField* initMotion,
+		int window, int searchRadius, bool enableSubPixel,
+		const CPU::MotionField* predictedMotion,
+		const CPU::CandidateField* tileCandidates, float candidateScale,
+		const std::vector<uint32_t>* tileList, bool tileRadius);
+	// Window SAD of candidate (vx, vy) for every pixel of the region, O(1) per pixel whatever the window
+	void WindowSAD(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		int x0, int y0, int width, int height, int window, int vx, int vy, std::vector<float>& sad);
+
+	// [Flow Inversion] Ports of CS_FlowSplat.hlsl + CS_FlowInvert.hlsl: backward field from the forward one,
+	// searching only empty and poorly matched pixels
+	void InvertFlow(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		const CPU::MotionField& forward, CPU::MotionField& backward);
+	bool ClaimedVector(const CPU::MotionField& forward, int x, int y, CPU::Float2& v, float& cost) const;
+
+	// [Temporal Warm-Start] Port of CS_MotionProject.hlsl, returns the poorly predicted fraction.
+	// 'current' may be a coarser pyramid level than the history, the vectors shrink with it.
+	float ProjectMotion(const CPU::LumaImage& current, const CPU::LumaImage& prev, CPU::MotionField& predicted) const;
+
+	// [Global Motion] Ports of CS_GlobalMotion.hlsl: CSSeed at a width x height level of a 'flowWidth' wide field,
+	// CSGather + CSThumbnail followed by the fit OpticalFlow runs on the read back samples
+	void SeedGlobalMotion(int width, int height, int flowWidth, CPU::MotionField& seed) const;
+	void FitGlobalMotion(const CPULumaPyramid& luma, const CPU::MotionField& finalMotion);
+
+	// [Phase Correlation] Port of CS_PhaseCorrelation.hlsl into m_TileCandidates
+	void PhaseCorrelateTiles(const CPU::LumaImage& current, const CPU::LumaImage& prev);
+	// Candidates of the tile covering level pixel (x, y), scaled to the level
+	static void TileCandidates(const CPU::CandidateField& field, float scale, int x, int y, CPU::Float2 (&out)[PhaseCorrelation::Candidates]);
+
+	// [Adaptive Radius] Port of CS_MotionStats.hlsl (CSTileStats + CSTileRadius) into m_MotionStats / m_TileRadius,
+	// the controller is updated right away where the GPU reads the stats back a frame late
+	void MeasureMotion(const CPU::LumaImage& current, const CPU::LumaImage& prev, const CPU::MotionField& motion,
+		int searchedRadius, int maxRadius);
+	// Port of TileSearchRadius (CS_BlockMatching.hlsl): the bound of the tile covering level pixel (x, y)
+	int TileSearchRadius(int x, int y, int levelWidth, int searchRadius) const;
+
+	// [Farneback & DIS] Ports of CS_Farneback_Expansion.hlsl, CS_Farneback_Flow.hlsl and CS_DIS_Flow.hlsl
+	// (out of frame texel loads read 0, as on the GPU). The refinements cover every pixel, or the listed tiles.
+	static void Expand(const CPU::LumaImage& frame, CPU::ExpansionImage& poly);
+	void FarnebackFlow(const CPU::ExpansionImage& polyCurr, const CPU::ExpansionImage& polyPrev,
+		const CPU::MotionField& initMotion, CPU::MotionField& motion, const std::vector<uint32_t>* tileList = nullptr);
+	void DISFlow(const CPU::LumaImage& current, const CPU::LumaImage& prev, const CPU::ExpansionImage& gradsPrev,
+		const CPU::MotionField& initMotion, CPU::MotionField& motion, const std::vector<uint32_t>* tileList = nullptr);
+	// Calls 'refine(x, y)' for every pixel of the frame or of the listed tiles (packed x | y << 16)
+	template<typename Refine>
+	static void ForEachPixel(int width, int height, const std::vector<uint32_t>* tileList, Refine&& refine);
+	bool PixelUnchanged(int x, int y) const;
+
+	// [Hybrid Flow] Ports of CS_FlowSelect.hlsl: CSSelect (algorithm per tile from m_VarianceGrid and last frame's
+	// stats into m_TileAlgorithms / m_TileLists) and CSStats (residual and motion spread of the refined field)
+	void SelectTiles();
+	void MeasureTiles(const CPU::LumaImage& current, const CPU::LumaImage& prev, const CPU::MotionField& motion);
+
+	// [3DRS] Port of CS_RecursiveSearch.hlsl with a true meandering scan
+	// Result in m_BlockHistory (Dispatch expands it)
+	void RecursiveSearch(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		int blockSize, bool enableSubPixel);
+	float BlockSAD(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		int x0, int y0, int blockSize, const CPU::Float2& vector, int decimation = 1);
+
+	// [Block Motion] Port of CS_BlockSearch.hlsl, result in m_BlockHistory
+	void BlockSearch(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		int blockSize, int searchRadius, bool enableSubPixel);
+	static void ExpandBlockField(const CPU::MotionField& field, CPU::MotionField& outputMotion, int width, int height, int blockSize);
+
+	// [Tile Hash] Every hash tile the pixel rectangle [x0, x1) x [y0, y1) touches matched last frame
+	bool RegionUnchanged(int x0, int y0, int x1, int y1) const;
+	static constexpr int UnchangedTileSize = 16; // CPUFrameHash::TileSize
+
+	// [Quadtree] Ports of CS_AdaptiveVariance.hlsl and CS_QuadtreeSearch.hlsl
+	void CalcVariance(const CPU::LumaImage& input);
+	void QuadtreeSearch(const CPU::LumaImage& current, const CPU::LumaImage& prev,
+		int searchRadius, bool enableSubPixel, bool useHistory);
+
+	CPU::MotionField m_MotionHistory;
+	CPU::MotionField m_Predicted;
+	CPU::MotionField m_BlockHistory;
+	CPU::MotionField m_BlockField;
+	CPU::MotionField m_MotionLevels[Pyramid::MaxLevels]; // [Pyramid] [0] is the caller's output
+	CPU::MotionField m_InitLevels[Pyramid::MaxLevels];
+	CPU::MotionField m_UpsampleRows; // [Guided Upsample] Horizontal pass, output width x coarse height
+	CPU::LumaImage m_UpsampleRowGuide;
+	GlobalMotion m_GlobalMotion; // [Global Motion]
+	bool m_GlobalValid = false;
+	CPU::MotionField m_GlobalSeed;
+	std::vector<GlobalMotion::Sample> m_GlobalSamples;
+	std::vector<float> m_GlobalThumbnails; // Current, then previous
+	PhaseCorrelation m_PhaseCorrelation; // [Phase Correlation]
+	CPU::CandidateField m_TileCandidates;
+	std::vector<float> m_PhaseWindows; // Current, then previous window of a tile
+	AdaptiveRadius m_AdaptiveRadius; // [Adaptive Radius]
+	std::vector<uint32_t> m_MotionStats; // AdaptiveRadius readback layout
+	CPU::LumaImage m_TileMotionMax;
+	CPU::LumaImage m_TileRadius; // Empty: no bounds
+	int m_TileRadiusWidth = 0; // Flow width the bounds were measured at
+	bool m_TileRadiusActive = false;
+	int m_SceneChangeCount = 0;
+	float m_WarmStartResidual = 1.0f;
+	long long m_SADCount = 0;
+	int m_MotionBlockSize = 1;
+	CPU::MotionField m_MotionBackward; // [Occlusion]
+	CPU::MotionField m_MotionRepaired;
+	CPU::Image<uint32_t> m_Splat; // [Flow Inversion]
+	CPU::VisibilityMap m_Visibility;
+	CPU::LumaImage m_VarianceGrid; // [Quadtree]
+	CPU::MotionField m_QuadField;
+	CPU::MotionField m_QuadHistory;
+	CPU::Image<int> m_QuadSize;
+	std::vector<float> m_AbsDiffRow; // [Cost Aggregation] Scratch
+	std::vector<float> m_RowSums;
+	std::vector<float> m_ColumnSums;
+	std::vector<float> m_WindowSAD;
+	std::vector<float> m_BestCost;
+	std::vector<float> m_BestSAD;
+	CPU::ExpansionImage m_PolyCurr; // [Farneback & DIS]
+	CPU::ExpansionImage m_PolyPrev;
+	CPU::MotionField m_RefineInit;
+	CPU::Image<uint8_t> m_TileAlgorithms; // [Hybrid Flow] Last frame's choice until SelectTiles
+	CPU::MotionField m_TileStats; // x: residual, y: motion spread
+	bool m_TileStatsValid = false;
+	std::vector<uint32_t> m_TileLists[3]; // Per FlowAlgorithm (BlockMatching, Farneback, DIS)
+	int m_FrameIndex = 0;
+	const CPU::Image<uint8_t>* m_UnchangedTiles = nullptr; // [Tile Hash] Not owned
+};
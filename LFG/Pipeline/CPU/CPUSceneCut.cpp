@@ -0,0 +1,80 @@
+#include "CPUSceneCut.h"
+
+using namespace CPU;
+
+// Rec.709 luma + chroma remapped to 0 - 1, same as CS_SceneCut
+static void LumaChroma(const Float4& c, float& y, float& cb, float& cr)
+{
+	y = Luma(c);
+	cb = std::clamp((c.b - y) / 1.8556f + 0.5f, 0.0f, 1.0f);
+	cr = std::clamp((c.r - y) / 1.5748f + 0.5f, 0.0f, 1.0f);
+}
+
+// Box of 4 bilinear taps around the thumbnail cell center (cell size in pixels)
+static Float4 Thumbnail(const ColorImage& img, float u, float v, float cellU, float cellV)
+{
+	Float4 sum;
+	sum.a = 0.0f;
+	for (float dy : { -0.25f, 0.25f })
+	{
+		for (float dx : { -0.25f, 0.25f })
+		{
+			// UV -> texel-center coordinates
+			sum = sum + SampleBilinear(img, (u + cellU * dx) * img.Width - 0.5f, (v + cellV * dy) * img.Height - 0.5f);
+		}
+	}
+	return sum * 0.25f;
+}
+
+static int Bin(float value, int bins)
+{
+	return std::min((int)(value * bins), bins - 1);
+}
+
+static float HistogramDistance(const std::vector<int>& curr, const std::vector<int>& prev, float cells)
+{
+	int sum = 0;
+	for (size_t i = 0; i < curr.size(); ++i) sum += std::abs(curr[i] - prev[i]);
+	return sum / (2.0f * cells);
+}
+
+bool CPUSceneCut::Detect(const ColorImage& current, const ColorImage& prev)
+{
+	const int thumbWidth = ThumbnailWidth;
+	const int thumbHeight = std::max(1, (int)(ThumbnailWidth * (float)current.Height / current.Width + 0.5f));
+	const float cellU = 1.0f / thumbWidth;
+	const float cellV = 1.0f / thumbHeight;
+
+	std::vector<int> lumaCurr(LumaBins), lumaPrev(LumaBins);
+	std::vector<int> cbCurr(ChromaBins), cbPrev(ChromaBins), crCurr(ChromaBins), crPrev(ChromaBins);
+	double sad = 0.0;
+
+	for (int ty = 0; ty < thumbHeight; ++ty)
+	{
+		for (int tx = 0; tx < thumbWidth; ++tx)
+		{
+			const float u = (tx + 0.5f) * cellU;
+			const float v = (ty + 0.5f) * cellV;
+
+			float yc, cbc, crc, yp, cbp, crp;
+			LumaChroma(Thumbnail(current, u, v, cellU, cellV), yc, cbc, crc);
+			LumaChroma(Thumbnail(prev, u, v, cellU, cellV), yp, cbp, crp);
+
+			++lumaCurr[Bin(yc, LumaBins)];
+			++lumaPrev[Bin(yp, LumaBins)];
+			++cbCurr[Bin(cbc, ChromaBins)];
+			++cbPrev[Bin(cbp, ChromaBins)];
+			++crCurr[Bin(crc, ChromaBins)];
+			++crPrev[Bin(crp, ChromaBins)];
+			sad += std::abs(yc - yp);
+		}
+	}
+
+	const float cells = (float)(thumbWidth * thumbHeight);
+	m_HistogramDistance = std::max({ HistogramDistance(lumaCurr, lumaPrev, cells),
+		HistogramDistance(cbCurr, cbPrev, cells),
+		HistogramDistance(crCurr, crPrev, cells) });
+	m_MeanSAD = (float)(sad / cells);
+
+	return m_HistogramDistance > HistogramThreshold && m_MeanSAD > SADThreshold;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "CPUImage.h"
+
+// CPU reference implementation of the scene cut pre-pass (CS_SceneCut.hlsl / SceneCut).
+class CPUSceneCut
+{
+public:
+	CPUSceneCut() = default;
+	~CPUSceneCut() = default;
+
+	// True if 'current' starts a new scene: both the thumbnail histograms and the thumbnail SAD changed
+	bool Detect(const CPU::ColorImage& current, const CPU::ColorImage& prev);
+
+	// Measurements of the last Detect
+	float GetHistogramDistance() const { return m_HistogramDistance; } // Max over luma / Cb / Cr, 0 - 1
+	float GetMeanSAD() const { return m_MeanSAD; }
+
+	// Same as SceneCut.h
+	static constexpr int ThumbnailWidth = 128;
+	static constexpr float HistogramThreshold = 0.35f;
+	static constexpr float SADThreshold = 0.1f;
+
+	static constexpr int LumaBins = 32;
+	static constexpr int ChromaBins = 16;
+
+private:
+	float m_HistogramDistance = 0.0f;
+	float m_MeanSAD = 0.0f;
+};
@@ -0,0 +1,67 @@
+#include "CPUTileClassifier.h"
+
+using namespace CPU;
+
+void CPUTileClassifier::TileBounds(uint32_t tile, int width, int height, int& x0, int& y0, int& x1, int& y1)
+{
+	x0 = (int)(tile & 0xFFFF) * TileSize;
+	y0 = (int)(tile >> 16) * TileSize;
+	x1 = std::min(x0 + TileSize, width);
+	y1 = std::min(y0 + TileSize, height);
+}
+
+void CPUTileClassifier::Classify(const ColorImage& texCurrent,
+	const ColorImage& texPrev,
+	const MotionField& motion,
+	int motionBlockSize,
+	const Float2& flowScale,
+	const LumaImage* hudMask)
+{
+	const int width = texCurrent.Width;
+	const int height = texCurrent.Height;
+	const int tilesX = (width + TileSize - 1) / TileSize;
+	const int tilesY = (height + TileSize - 1) / TileSize;
+	const int tileCount = tilesX * tilesY;
+	if (motionBlockSize < 1) motionBlockSize = 1;
+
+	m_TileList.assign(tileCount, 0);
+	m_DynamicCount = 0;
+	int staticCount = 0;
+
+	for (int ty = 0; ty < tilesY; ++ty)
+	{
+		for (int tx = 0; tx < tilesX; ++tx)
+		{
+			const uint32_t tile = ((uint32_t)ty << 16) | (uint32_t)tx;
+			int x0, y0, x1, y1;
+			TileBounds(tile, width, height, x0, y0, x1, y1);
+
+			bool dynamic = false;
+			for (int y = y0; y < y1 && !dynamic; ++y)
+			{
+				for (int x = x0; x < x1 && !dynamic; ++x)
+				{
+					if (hudMask && hudMask->At(x, y) > 0.5f) continue;
+
+					const Float2 v = SampleMotion(motion, (float)x, (float)y, motionBlockSize, flowScale);
+					dynamic = LengthSq(v) > StaticMotionThreshold * StaticMotionThreshold ||
+						AbsDiff(texCurrent.At(x, y), texPrev.At(x, y)) > StaticDiffThreshold;
+				}
+			}
+
+			if (dynamic) m_TileList[m_DynamicCount++] = tile;
+			else m_TileList[tileCount - 1 - staticCount++] = tile;
+		}
+	}
+}
+
+void CPUTileClassifier::CopyStatic(const ColorImage& texCurrent, ColorImage& output) const
+{
+	for (int i = 0; i < GetStaticCount(); ++i)
+	{
+		int x0, y0, x1, y1;
+		TileBounds(GetStaticTile(i), texCurrent.Width, texCurrent.Height, x0, y0, x1, y1);
+		for (int y = y0; y < y1; ++y)
+			std::copy(&texCurrent.At(x0, y), &texCurrent.At(x0, y) + (x1 - x0), &output.At(x0, y));
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "CPUImage.h"
+#include <cstdint>
+
+// CPU reference implementation of the static / dynamic tile classification (CS_TileClassify.hlsl).
+// Same list layout as TileClassifier: one uint per 16x16 tile packed y << 16 | x, dynamic tiles from the front,
+// static tiles from the back. Tiles are visited in raster order, so the order within each end is deterministic.
+class CPUTileClassifier
+{
+public:
+	CPUTileClassifier() = default;
+	~CPUTileClassifier() = default;
+
+	// A tile is static when no pixel moves more than StaticMotionThreshold (output pixels, 'motion' sampled like
+	// synthesis does) or changes more than StaticDiffThreshold between the frames.
+	// hudMask (optional): pixels above 0.5 never make a tile dynamic, synthesis returns texCurrent there.
+	void Classify(const CPU::ColorImage& texCurrent,
+		const CPU::ColorImage& texPrev,
+		const CPU::MotionField& motion,
+		int motionBlockSize = 1,
+		const CPU::Float2& flowScale = { 1.0f, 1.0f },
+		const CPU::LumaImage* hudMask = nullptr);
+
+	// CSStatic without sharpening: the real frame into every static tile of 'output'
+	void CopyStatic(const CPU::ColorImage& texCurrent, CPU::ColorImage& output) const;
+
+	const std::vector<uint32_t>& GetTileList() const { return m_TileList; }
+	int GetDynamicCount() const { return m_DynamicCount; }
+	int GetStaticCount() const { return (int)m_TileList.size() - m_DynamicCount; }
+	uint32_t GetDynamicTile(int index) const { return m_TileList[index]; }
+	uint32_t GetStaticTile(int index) const { return m_TileList[m_TileList.size() - 1 - index]; }
+
+	// Pixel rectangle of a packed tile, clipped to width x height
+	static void TileBounds(uint32_t tile, int width, int height, int& x0, int& y0, int& x1, int& y1);
+
+	static constexpr int TileSize = 16; // TILE_SIZE in CS_TileClassify
+	static constexpr float StaticMotionThreshold = 0.05f; // TileClassifier::StaticMotionThreshold
+	static constexpr float StaticDiffThreshold = 0.02f; // TileClassifier::StaticDiffThreshold
+
+private:
+	std::vector<uint32_t> m_TileList;
+	int m_DynamicCount = 0;
+};
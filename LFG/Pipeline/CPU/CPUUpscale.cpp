@@ -0,0 +1,146 @@
+#include "CPUUpscale.h"
+
+using namespace CPU;
+
+// Same kernels as CS_Upscale
+static float CubicWeight(float x)
+{
+	const float B = 0.0f;
+	const float C = 0.5f;
+	float ax = std::fabs(x);
+	if (ax < 1.0f)
+		return ((12 - 9 * B - 6 * C) * ax * ax * ax + (-18 + 12 * B + 6 * C) * ax * ax + (6 - 2 * B)) / 6.0f;
+	else if (ax < 2.0f)
+		return ((-B - 6 * C) * ax * ax * ax + (6 * B + 30 * C) * ax * ax + (-12 * B - 48 * C) * ax + (8 * B + 24 * C)) / 6.0f;
+	return 0.0f;
+}
+
+static float Sinc(float x)
+{
+	if (x == 0.0f) return 1.0f;
+	float piX = 3.14159265f * x;
+	return std::sin(piX) / piX;
+}
+
+static float LanczosWeight(float x, int a)
+{
+	if (std::fabs(x) >= a) return 0.0f;
+	return Sinc(x) * Sinc(x / a);
+}
+
+// Weighted sum over the taps [first, last] around the sample position, clamp addressing
+template<typename Weight>
+static Float4 SampleWindow(const ColorImage& input, float u, float v, int first, int last, Weight&& weight, float& totalWeight)
+{
+	const float sx = u * input.Width - 0.5f;
+	const float sy = v * input.Height - 0.5f;
+	const int tx = (int)std::floor(sx);
+	const int ty = (int)std::floor(sy);
+	const float fx = sx - tx;
+	const float fy = sy - ty;
+
+	Float4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+	totalWeight = 0.0f;
+	for (int y = first; y <= last; ++y)
+	{
+		for (int x = first; x <= last; ++x)
+		{
+			float w = weight(x - fx) * weight(y - fy);
+			sum = sum + input.Clamped(tx + x, ty + y) * w;
+			totalWeight += w;
+		}
+	}
+	return sum;
+}
+
+Float4 CPUUpscale::UpscaleAt(const ColorImage& input, int x, int y, int width, int height, int mode, int radius)
+{
+	const float u = (x + 0.5f) / width;
+	const float v = (y + 0.5f) / height;
+
+	if (mode == 2)
+		return SampleBilinear(input, u * input.Width - 0.5f, v * input.Height - 0.5f);
+
+	if (mode == 3)
+	{
+		float totalWeight = 0.0f;
+		Float4 sum = SampleWindow(input, u, v, -1, 2, CubicWeight, totalWeight);
+		return sum * (1.0f / totalWeight);
+	}
+
+	if (mode == 4)
+	{
+		float totalWeight = 0.0f;
+		Float4 sum = SampleWindow(input, u, v, -radius + 1, radius, [radius](float t) { return LanczosWeight(t, radius); }, totalWeight);
+		return totalWeight > 0.0001f ? sum * (1.0f / totalWeight) : Float4{ 0.0f, 0.0f, 0.0f, 0.0f };
+	}
+
+	// Nearest (and Native / invalid)
+	return input.Clamped((int)(u * input.Width), (int)(v * input.Height));
+}
+
+Float4 CPUUpscale::SharpenAt(const Float4& c, const Float4& n, const Float4& s, const Float4& w, const Float4& e, float sharpness)
+{
+	// Same lobe as CS_RCAS: (center + lobe * neighbors) / (1 + 4 * lobe)
+	const float lobe = Lerp(0.0f, -0.2f, sharpness);
+	const float denominator = 1.0f + 4.0f * lobe;
+	auto sharpen = [&](float cc, float nn, float ss, float ww, float ee)
+	{
+		return std::clamp((cc + lobe * (nn + ss + ww + ee)) / denominator, 0.0f, 1.0f);
+	};
+	return { sharpen(c.r, n.r, s.r, w.r, e.r), sharpen(c.g, n.g, s.g, w.g, e.g), sharpen(c.b, n.b, s.b, w.b, e.b), c.a };
+}
+
+void CPUUpscale::Upscale(const ColorImage& input, ColorImage& output, int width, int height, int mode, int radius)
+{
+	if (!output.SameSize(width, height)) output.Resize(width, height);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			output.At(x, y) = UpscaleAt(input, x, y, width, height, mode, radius);
+}
+
+void CPUUpscale::RCAS(const ColorImage& input, ColorImage& output, float sharpness)
+{
+	if (!output.SameSize(input.Width, input.Height)) output.Resize(input.Width, input.Height);
+	for (int y = 0; y < input.Height; ++y)
+	{
+		for (int x = 0; x < input.Width; ++x)
+		{
+			output.At(x, y) = SharpenAt(input.At(x, y),
+				input.Clamped(x, y - 1), input.Clamped(x, y + 1), input.Clamped(x - 1, y), input.Clamped(x + 1, y), sharpness);
+		}
+	}
+}
+
+void CPUUpscale::UpscaleRCAS(const ColorImage& input, ColorImage& output, int width, int height, int mode, int radius, float sharpness)
+{
+	if (!output.SameSize(width, height)) output.Resize(width, height);
+
+	constexpr int ApronSize = TileSize + 2;
+	m_Tile.resize(ApronSize * ApronSize);
+
+	for (int ty = 0; ty < height; ty += TileSize)
+	{
+		for (int tx = 0; tx < width; tx += TileSize)
+		{
+			// 1. Upscaled tile + apron, edge texels repeated like RCAS's clamped neighbors
+			for (int i = 0; i < ApronSize * ApronSize; ++i)
+			{
+				const int x = std::clamp(tx - 1 + i % ApronSize, 0, width - 1);
+				const int y = std::clamp(ty - 1 + i / ApronSize, 0, height - 1);
+				m_Tile[i] = UpscaleAt(input, x, y, width, height, mode, radius);
+			}
+
+			// 2. RCAS from the tile
+			for (int y = ty; y < std::min(ty + TileSize, height); ++y)
+			{
+				for (int x = tx; x < std::min(tx + TileSize, width); ++x)
+				{
+					const int center = (y - ty + 1) * ApronSize + (x - tx + 1);
+					output.At(x, y) = SharpenAt(m_Tile[center],
+						m_Tile[center - ApronSize], m_Tile[center + ApronSize], m_Tile[center - 1], m_Tile[center + 1], sharpness);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "CPUImage.h"
+
+// CPU reference implementation of the output stage (CS_Upscale.hlsl / CS_RCAS.hlsl).
+// 'mode' follows FrameGenSettings::UpscaleType: 1 = Nearest, 2 = Bilinear, 3 = Bicubic, 4 = Lanczos.
+class CPUUpscale
+{
+public:
+	CPUUpscale() = default;
+	~CPUUpscale() = default;
+
+	static void Upscale(const CPU::ColorImage& input, CPU::ColorImage& output, int width, int height, int mode, int radius);
+	static void RCAS(const CPU::ColorImage& input, CPU::ColorImage& output, float sharpness);
+
+	// [Fused RCAS] Port of CSUpscaleRCAS: each tile upscales itself plus a 1 pixel apron, then sharpens from it.
+	// Same result as Upscale followed by RCAS, without the full-size intermediate.
+	void UpscaleRCAS(const CPU::ColorImage& input, CPU::ColorImage& output, int width, int height, int mode, int radius, float sharpness);
+
+	static constexpr int TileSize = 16; // TILE_SIZE in CS_Upscale
+
+private:
+	static CPU::Float4 UpscaleAt(const CPU::ColorImage& input, int x, int y, int width, int height, int mode, int radius);
+	static CPU::Float4 SharpenAt(const CPU::Float4& c, const CPU::Float4& n, const CPU::Float4& s,
+		const CPU::Float4& w, const CPU::Float4& e, float sharpness);
+
+	std::vector<CPU::Float4> m_Tile; // (TileSize + 2)^2 upscaled texels
+};
@@ -0,0 +1,199 @@
+#include "AutoTuner.h"
+#include "ScaleController.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+
+static float Median(std::vector<float> values)
+{
+	const size_t middle = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + middle, values.end());
+	return values[middle];
+}
+
+std::vector<AutoTuner::Candidate> AutoTuner::BuildCandidates(const float* presetScales, int presetCount)
+{
+	std::vector<Candidate> candidates;
+	auto add = [&](int preset, float scale)
+	{
+		for (const Candidate& c : candidates)
+		{
+			if (c.Preset == preset && std::fabs(c.RenderScale - scale) < 0.01f) return;
+		}
+		candidates.push_back({ preset, scale });
+	};
+
+	for (int preset = 0; preset < presetCount; ++preset)
+	{
+		const float scale = presetScales[preset];
+		add(preset, scale);
+		if (scale < 1.0f) add(preset, std::min(scale / ScaleController::StepRatio, 1.0f));
+		if (scale * ScaleController::StepRatio >= ScaleController::MinScale) add(preset, scale * ScaleController::StepRatio);
+	}
+	return candidates;
+}
+
+int AutoTuner::Select(const std::vector<Measurement>& measurements, int candidateCount, float budgetMs)
+{
+	// Content changes between rounds, errors only compare within one: relative to the round's mean
+	int rounds = 0;
+	for (const Measurement& m : measurements) rounds = std::max(rounds, m.Round + 1);
+	std::vector<float> roundMean(rounds, 0.0f);
+	std::vector<int> roundCount(rounds, 0);
+	for (const Measurement& m : measurements)
+	{
+		roundMean[m.Round] += m.Error;
+		++roundCount[m.Round];
+	}
+	for (int r = 0; r < rounds; ++r)
+	{
+		if (roundCount[r] > 0) roundMean[r] /= (float)roundCount[r];
+	}
+
+	// Per candidate: mean relative error, worst round's cost
+	std::vector<float> score(candidateCount, 0.0f);
+	std::vector<float> cost(candidateCount, 0.0f);
+	std::vector<int> blocks(candidateCount, 0);
+	for (const Measurement& m : measurements)
+	{
+		if (m.Candidate < 0 || m.Candidate >= candidateCount) continue;
+		score[m.Candidate] += roundMean[m.Round] > 0.0f ? m.Error / roundMean[m.Round] : 1.0f;
+		cost[m.Candidate] = std::max(cost[m.Candidate], m.CostMs);
+		++blocks[m.Candidate];
+	}
+
+	int best = -1;
+	int cheapest = -1;
+	for (int c = 0; c < candidateCount; ++c)
+	{
+		if (blocks[c] == 0) continue;
+		score[c] /= (float)blocks[c];
+		if (cheapest < 0 || cost[c] < cost[cheapest]) cheapest = c;
+		if (cost[c] <= budgetMs && (best < 0 || score[c] < score[best])) best = c;
+	}
+	// Nothing fits: the cheapest is the closest
+	if (best < 0) return cheapest;
+
+	int selected = best;
+	for (int c = 0; c < candidateCount; ++c)
+	{
+		if (blocks[c] > 0 && cost[c] <= budgetMs && score[c] <= score[best] * (1.0f + ErrorTolerance) && cost[c] < cost[selected])
+			selected = c;
+	}
+	return selected;
+}
+
+void AutoTuner::Start(const std::vector<Candidate>& candidates, float budgetMs)
+{
+	m_Candidates = candidates;
+	m_Order.clear();
+	for (int c = 0; c < (int)m_Candidates.size(); ++c) m_Order.push_back(c);
+	m_Measurements.clear();
+	m_Costs.clear();
+	m_Errors.clear();
+	m_Budget = budgetMs;
+	m_Block = 0;
+	m_Frame = 0;
+	m_Result = -1;
+	m_Running = !m_Candidates.empty();
+}
+
+void AutoTuner::Stop()
+{
+	m_Running = false;
+	m_Result = -1;
+}
+
+float AutoTuner::GetProgress() const
+{
+	if (!m_Running) return IsFinished() ? 1.0f : 0.0f;
+	return (float)m_Block / (float)(m_Order.size() * Rounds);
+}
+
+void AutoTuner::FinishBlock()
+{
+	if (!m_Costs.empty() && !m_Errors.empty())
+	{
+		const int round = m_Block / (int)m_Order.size();
+		m_Measurements.push_back({ m_Order[m_Block % m_Order.size()], round, Median(m_Costs), Median(m_Errors) });
+	}
+	m_Costs.clear();
+	m_Errors.clear();
+	m_Frame = 0;
+	++m_Block;
+}
+
+bool AutoTuner::Update(bool costValid, float costMs, bool errorValid, float error)
+{
+	if (!m_Running) return false;
+
+	if (++m_Frame > SettleFrames)
+	{
+		if (costValid) m_Costs.push_back(costMs);
+		if (errorValid) m_Errors.push_back(error);
+	}
+
+	const bool complete = (int)m_Costs.size() >= MeasureFrames && (int)m_Errors.size() >= MeasureFrames;
+	if (!complete && m_Frame < SettleFrames + MaxBlockFrames) return false;
+
+	const int blocksPerRound = (int)m_Order.size();
+	FinishBlock();
+
+	if (m_Block >= blocksPerRound * Rounds)
+	{
+		m_Running = false;
+		m_Result = Select(m_Measurements, (int)m_Candidates.size(), m_Budget);
+		return m_Result >= 0;
+	}
+
+	// Every other round runs backwards, slow content drift hits all candidates alike
+	if (m_Block % blocksPerRound == 0) std::reverse(m_Order.begin(), m_Order.end());
+	return true;
+}
+
+bool AutoTuner::Load(const std::filesystem::path& path, const std::string& key, Candidate& candidate)
+{
+	std::ifstream file(path);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		const size_t separator = line.rfind('=');
+		if (separator == std::string::npos || line.compare(0, separator, key) != 0 || separator != key.size()) continue;
+
+		// from_chars ignores the locale, a decimal comma setting can't misread the file
+		const char* last = line.data() + line.size();
+		Candidate stored;
+		auto preset = std::from_chars(line.data() + separator + 1, last, stored.Preset);
+		if (preset.ec != std::errc() || preset.ptr == last || *preset.ptr != ',') continue;
+		if (std::from_chars(preset.ptr + 1, last, stored.RenderScale).ec != std::errc()) continue;
+		candidate = stored;
+		return true;
+	}
+	return false;
+}
+
+bool AutoTuner::Save(const std::filesystem::path& path, const std::string& key, const Candidate& candidate)
+{
+	std::vector<std::string> lines;
+	{
+		std::ifstream file(path);
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.compare(0, key.size() + 1, key + "=") != 0) lines.push_back(line);
+		}
+	}
+
+	// "preset,scale" with a '.' whatever the locale
+	char value[64];
+	char* end = std::to_chars(value, value + sizeof(value), candidate.Preset).ptr;
+	*end++ = ',';
+	end = std::to_chars(end, value + sizeof(value), candidate.RenderScale, std::chars_format::fixed, 4).ptr;
+	lines.push_back(key + "=" + std::string(value, end));
+
+	std::ofstream file(path, std::ios::trunc);
+	for (const std::string& line : lines) file << line << '\n';
+	return (bool)file;
+}
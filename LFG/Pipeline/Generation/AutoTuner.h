@@ -0,0 +1,75 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// [Auto-Tune] Calibration on live frames: every candidate (each preset, and each one a Render Scale step
+// (ScaleController) above and below) runs for a block of frames, Rounds times in alternating order so they
+// all see similar content. After SettleFrames (resources, timestamps in flight) the block's GPU cost and warp
+// error (WarpError) are taken as medians. Select keeps the candidates whose cost fits the budget and picks the
+// lowest error relative to the other candidates of the same round, the cheaper one among near ties.
+// Results are kept per key (executable and resolution) in a text file. Plain CPU code, no D3D.
+class AutoTuner
+{
+public:
+	struct Candidate
+	{
+		int Preset = 0;
+		float RenderScale = 1.0f;
+	};
+
+	// One measured block
+	struct Measurement
+	{
+		int Candidate = 0;
+		int Round = 0;
+		float CostMs = 0.0f; // Median GPU time per real frame
+		float Error = 0.0f; // Median warp error
+	};
+
+	AutoTuner() = default;
+	~AutoTuner() = default;
+
+	// Candidates around the presets' Render Scales
+	static std::vector<Candidate> BuildCandidates(const float* presetScales, int presetCount);
+	// Index of the best candidate for 'budgetMs' from the measured blocks, -1 without any
+	static int Select(const std::vector<Measurement>& measurements, int candidateCount, float budgetMs);
+
+	void Start(const std::vector<Candidate>& candidates, float budgetMs);
+	void Stop();
+	// One real frame, either measurement may be missing. True when the caller has to switch to GetCurrent(),
+	// or once IsFinished() to GetResult().
+	bool Update(bool costValid, float costMs, bool errorValid, float error);
+
+	bool IsRunning() const { return m_Running; }
+	bool IsFinished() const { return !m_Running && m_Result >= 0; }
+	const Candidate& GetCurrent() const { return m_Candidates[m_Order[m_Block % m_Order.size()]]; }
+	const Candidate& GetResult() const { return m_Candidates[m_Result]; }
+	const std::vector<Candidate>& GetCandidates() const { return m_Candidates; }
+	const std::vector<Measurement>& GetMeasurements() const { return m_Measurements; }
+	float GetProgress() const;
+
+	// "key=preset,scale" lines, other keys are kept. Locale independent.
+	static bool Load(const std::filesystem::path& path, const std::string& key, Candidate& candidate);
+	static bool Save(const std::filesystem::path& path, const std::string& key, const Candidate& candidate);
+
+	static constexpr int Rounds = 2;
+	static constexpr int SettleFrames = 6; // GpuTimer::FrameLatency plus a frame for the new resources
+	static constexpr int MeasureFrames = 6; // Samples of both kinds per block
+	static constexpr int MaxBlockFrames = 30; // A block without enough samples ends with what it has
+	static constexpr float ErrorTolerance = 0.02f; // Relative errors this close are a tie, the cheaper one wins
+
+private:
+	void FinishBlock();
+
+	std::vector<Candidate> m_Candidates;
+	std::vector<int> m_Order; // Candidate per block of a round
+	std::vector<Measurement> m_Measurements;
+	std::vector<float> m_Costs;
+	std::vector<float> m_Errors;
+	float m_Budget = 0.0f;
+	int m_Block = 0; // Blocks done (all rounds)
+	int m_Frame = 0; // Frames into the current block
+	int m_Result = -1;
+	bool m_Running = false;
+};
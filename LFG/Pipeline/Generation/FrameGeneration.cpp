@@ -1,457 +1,825 @@
-#include "FrameGeneration.h"
-#include <Debug/Debug.h>
-#include <Pipeline/Shaders/EmbeddedShaders.h>
-#include <Pipeline/Shaders/Shader.h>
-
-FrameGeneration& FrameGeneration::Instance()
-{
-	static FrameGeneration instance;
-	return instance;
-}
-
-void FrameGeneration::Initialize(ID3D11Device* device)
-{
-	m_Device = device;
-	m_Device->GetImmediateContext(&m_Context);
-
-	// Load Shaders
-    // [New] Scale Shader (Renamed to CS_Upscale.hlsl)
-    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Upscale, "main", &m_csScale))
-    {
-        Debug::Error("Failed to load CS_Upscale shader");
-    }
-
-    // Create Constant Buffer for Upscale
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = sizeof(CBUpscale);
-    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    m_Device->CreateBuffer(&cbDesc, nullptr, &m_cbUpscale);
-
-	// [Async Compute] 
-	// Initialize Deferred Context for batching compute commands.
-	HRESULT hr = m_Device->CreateDeferredContext(0, &m_DeferredContext);
-	if (FAILED(hr)) {
-		Debug::Error("Failed to create Deferred Context (0x%X)", hr);
-	} else {
-		Debug::Info("Deferred Context created successfully.");
-	}
-	
-	Debug::Info("Frame Generation initialized.");
-}
-
-void FrameGeneration::DispatchScale(ID3D11Texture2D* input, ID3D11Texture2D* output)
-{
-    if (!input || !output || !m_csScale || !m_cbUpscale) return;
-
-    D3D11_TEXTURE2D_DESC inDesc;
-    input->GetDesc(&inDesc);
-    D3D11_TEXTURE2D_DESC outDesc;
-    output->GetDesc(&outDesc);
-
-    ID3D11ShaderResourceView* nullSRVs[8] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
-    m_Context->CSSetShaderResources(0, 8, nullSRVs);
-    ID3D11UnorderedAccessView* nullUAVs[1] = { nullptr };
-    m_Context->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
-
-    // Update Constant Buffer
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    if (SUCCEEDED(m_Context->Map(m_cbUpscale.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
-    {
-        CBUpscale* pData = (CBUpscale*)mapped.pData;
-        pData->Mode = (int)m_Settings.UpscaleMode;
-        pData->Radius = m_Settings.LanczosRadius;
-        pData->InputWidth = (float)inDesc.Width;
-        pData->InputHeight = (float)inDesc.Height;
-        m_Context->Unmap(m_cbUpscale.Get(), 0);
-    }
-    m_Context->CSSetConstantBuffers(0, 1, m_cbUpscale.GetAddressOf());
-
-    // Create Views
-    ComPtr<ID3D11ShaderResourceView> srv;
-    ComPtr<ID3D11UnorderedAccessView> uav;
-    
-    // Linear
-	D3D11_SAMPLER_DESC sampDesc = {};
-	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-	ComPtr<ID3D11SamplerState> linearSampler;
-	m_Device->CreateSamplerState(&sampDesc, &linearSampler);
-
-    // Point
-    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
-    ComPtr<ID3D11SamplerState> pointSampler;
-    m_Device->CreateSamplerState(&sampDesc, &pointSampler);
-
-    m_Device->CreateShaderResourceView(input, nullptr, &srv);
-    m_Device->CreateUnorderedAccessView(output, nullptr, &uav);
-
-    m_Context->CSSetShader(m_csScale.Get(), nullptr, 0);
-    m_Context->CSSetShaderResources(0, 1, srv.GetAddressOf());
-    m_Context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
-    
-    ID3D11SamplerState* samplers[] = { linearSampler.Get(), pointSampler.Get() };
-    m_Context->CSSetSamplers(0, 2, samplers);
-
-    m_Context->Dispatch((UINT)ceil(outDesc.Width / 16.0f), (UINT)ceil(outDesc.Height / 16.0f), 1);
-
-    // Unbind
-    ID3D11ShaderResourceView* nullSRV = nullptr;
-    ID3D11UnorderedAccessView* nullUAV = nullptr;
-    m_Context->CSSetShaderResources(0, 1, &nullSRV);
-    m_Context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-    m_Context->CSSetSamplers(0, 0, nullptr);
-}
-
-#include <chrono>
-
-void FrameGeneration::Capture(IDXGISwapChain* swapChain)
-{
-    auto start = std::chrono::high_resolution_clock::now();
-    
-	if (!m_Device || !m_Context) return;
-
-	ComPtr<ID3D11Texture2D> backBuffer;
-    if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer)))
-		return;
-    
-    D3D11_TEXTURE2D_DESC desc;
-	backBuffer->GetDesc(&desc);
-
-	// Lazy initialization of storage texture
-	if (!m_TexCurrent)
-	{
-		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-		desc.MiscFlags = 0;
-		desc.CPUAccessFlags = 0;
-		desc.Usage = D3D11_USAGE_DEFAULT;
-        
-        if (desc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) 
-            desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-
-		m_Device->CreateTexture2D(&desc, nullptr, &m_TexCurrent);
-		m_Device->CreateTexture2D(&desc, nullptr, &m_TexPrev);
-
-		D3D11_TEXTURE2D_DESC motionDesc = desc;
-		motionDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
-		motionDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-		m_Device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotion);
-		m_Device->CreateTexture2D(&desc, nullptr, &m_TexGenerated);
-
-		Debug::Info("GPU Resource Pool initialized.");
-
-		m_OpticalFlow.Initialize(m_Device.Get(), desc.Width, desc.Height);
-		m_FrameInterpolation.Initialize(m_Device.Get(), desc.Width, desc.Height);
-	}
-
-    // Performance Mode Resources
-    bool useScaling = (m_Settings.RenderScale < 1.0f);
-    int targetW = (int)(desc.Width * m_Settings.RenderScale);
-    int targetH = (int)(desc.Height * m_Settings.RenderScale);
-    targetW = (targetW / 2) * 2; targetH = (targetH / 2) * 2; // Align
-    if (targetW < 16) targetW = 16; if (targetH < 16) targetH = 16;
-
-    if (useScaling)
-    {
-        D3D11_TEXTURE2D_DESC lrDesc = {};
-        if (m_TexLowResCurrent) m_TexLowResCurrent->GetDesc(&lrDesc);
-        
-        if (!m_TexLowResCurrent || lrDesc.Width != targetW || lrDesc.Height != targetH)
-        {
-            D3D11_TEXTURE2D_DESC d = desc;
-            d.Width = targetW; d.Height = targetH;
-            d.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-            m_Device->CreateTexture2D(&d, nullptr, &m_TexLowResCurrent);
-            m_Device->CreateTexture2D(&d, nullptr, &m_TexLowResPrev);
-            m_Device->CreateTexture2D(&d, nullptr, &m_TexLowResGenerated); 
-            D3D11_TEXTURE2D_DESC md = d;
-            md.Format = DXGI_FORMAT_R16G16_FLOAT;
-            m_Device->CreateTexture2D(&md, nullptr, &m_TexLowResMotion);
-            
-            m_OpticalFlow.Initialize(m_Device.Get(), targetW, targetH);
-        }
-    }
-
-	// [Cycle Frames]
-	if (m_TexPrev && m_TexCurrent) m_TexPrev.Swap(m_TexCurrent);
-    if (useScaling && m_TexLowResPrev && m_TexLowResCurrent) m_TexLowResPrev.Swap(m_TexLowResCurrent);
-
-	// 2. Capture New Frame
-	m_Context->CopyResource(m_TexCurrent.Get(), backBuffer.Get());
-    
-    // Downscale if needed
-    if (useScaling)
-    {
-         DispatchScale(m_TexCurrent.Get(), m_TexLowResCurrent.Get());
-    }
-
-	// [Execute Pipeline]
-	ID3D11DeviceContext* ctxToUse = (m_Settings.EnableAsyncCompute && m_DeferredContext) ? m_DeferredContext.Get() : m_Context.Get();
-
-    // Select Resources
-    ID3D11Texture2D* inputCurr = useScaling ? m_TexLowResCurrent.Get() : m_TexCurrent.Get();
-    ID3D11Texture2D* inputPrev = useScaling ? m_TexLowResPrev.Get() : m_TexPrev.Get();
-    ID3D11Texture2D* outputMotion = useScaling ? m_TexLowResMotion.Get() : m_TexMotion.Get();
-
-	if (m_Settings.EnableBiDirFlow)
-	{
-		m_OpticalFlow.DispatchBiDirectional(ctxToUse, inputCurr, inputPrev, outputMotion,
-			m_Settings.BlockSize, m_Settings.SearchRadius);
-	}
-	else if (m_Settings.EnableAdaptiveBlock)
-	{
-		m_OpticalFlow.DispatchAdaptive(ctxToUse, inputCurr, inputPrev, outputMotion,
-			m_Settings.SearchRadius);
-	}
-	else
-	{
-		m_OpticalFlow.Dispatch(ctxToUse, inputCurr, inputPrev, outputMotion,
-			m_Settings.BlockSize, m_Settings.SearchRadius,
-			m_Settings.EnableSubPixel, m_Settings.EnableMotionSmoothing,
-			m_Settings.MaxPyramidLevel, m_Settings.MinPyramidLevel,
-			(FlowAlgorithm)m_Settings.OpticalFlowAlgorithm);	
-	}
-
-	// Execute Async Command List
-	if (ctxToUse == m_DeferredContext.Get())
-	{
-		ComPtr<ID3D11CommandList> cmdList;
-		m_DeferredContext->FinishCommandList(FALSE, &cmdList);
-		m_Context->ExecuteCommandList(cmdList.Get(), FALSE);
-	}
-
-	// [Low Latency Mode]
-	if (m_Settings.LowLatencyMode)
-	{
-		ComPtr<IDXGIDevice1> dxgiDevice;
-		if (SUCCEEDED(m_Device.As(&dxgiDevice)))
-		{
-			dxgiDevice->SetMaximumFrameLatency(1);
-		}
-	}
-
-	// 3. Frame Synthesis (Generate Intermediate Frame)
-	if (m_Settings.DebugViewMode > 0)
-	{
-		// Render Debug View into m_TexGenerated (using current flow)
-		m_FrameInterpolation.Dispatch(m_Context.Get(), 
-			m_TexCurrent.Get(), 
-			m_TexPrev.Get(), 
-			m_TexMotion.Get(), 
-			m_TexGenerated.Get(),
-			m_OpticalFlow.GetStatsSRV(),
-			m_Settings.HUDThreshold,
-			m_Settings.DebugViewMode,
-			m_Settings.MotionSensitivity,
-			0.0f, // Factor doesn't matter for debug view usually
-			m_Settings.SceneChangeThreshold,
-			0.0f, 0.0f, false); // Disable RCAS/Ghosting/Edge for debug view
-			
-		// Overwrite the Real BackBuffer with the Debug View
-		m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
-	}
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<float, std::milli> duration = end - start;
-    m_LastGenTime = duration.count();
-}
-
-bool FrameGeneration::PresentGenerated(IDXGISwapChain* swapChain, UINT syncInterval, UINT flags, float factor)
-{
-	if (!m_TexGenerated || !m_Context) return false;
-
-	// 3. Frame Synthesis (Generate Intermediate Frame)
-	ID3D11DeviceContext* ctxToUse = (m_Settings.EnableAsyncCompute && m_DeferredContext) ? m_DeferredContext.Get() : m_Context.Get();
-
-    bool useScaling = (m_Settings.RenderScale < 1.0f);
-    ID3D11Texture2D* inputCurr = useScaling ? m_TexLowResCurrent.Get() : m_TexCurrent.Get();
-    ID3D11Texture2D* inputPrev = useScaling ? m_TexLowResPrev.Get() : m_TexPrev.Get();
-    ID3D11Texture2D* inputMotion = useScaling ? m_TexLowResMotion.Get() : m_TexMotion.Get();
-    ID3D11Texture2D* outputGen = useScaling ? m_TexLowResGenerated.Get() : m_TexGenerated.Get();
-
-	m_FrameInterpolation.Dispatch(ctxToUse, 
-		inputCurr, 
-		inputPrev, 
-		inputMotion, 
-		outputGen,
-		m_OpticalFlow.GetStatsSRV(),
-		m_Settings.HUDThreshold,
-		m_Settings.DebugViewMode,
-		m_Settings.MotionSensitivity,
-		factor,
-		m_Settings.SceneChangeThreshold,
-		m_Settings.RcasStrength,
-		m_Settings.GhostingReduction,
-		m_Settings.EnableEdgeProtection);
-        
-    // [Upscale]
-    if (useScaling && m_TexLowResGenerated)
-    {
-        // Upscale LowResGenerated -> TexGenerated (Native)
-        DispatchScale(m_TexLowResGenerated.Get(), m_TexGenerated.Get());
-    }
-
-	// [Split Screen Comparison]
-	if (m_Settings.EnableSplitScreen)
-	{
-		// Use m_TexSharpened as a temp scratch buffer to avoid Read/Write hazard on m_TexGenerated
-		ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
-		if (pTemp)
-		{
-			// 1. Copy current Generated frame to Temp
-			ctxToUse->CopyResource(pTemp, m_TexGenerated.Get());
-
-			// 2. Dispatch Split Screen Shader
-			// Input A (Left/Gen): Temp
-			// Input B (Right/Real): m_TexPrev (The "No FG" experience)
-			// Output: m_TexGenerated (Overwrite with Split View)
-			m_FrameInterpolation.DispatchSplitScreen(ctxToUse, 
-				pTemp, 
-				m_TexPrev.Get(), 
-				m_TexGenerated.Get(), 
-				m_Settings.SplitScreenPosition);
-		}
-	}
-
-	// Execute Async Command List
-	if (ctxToUse == m_DeferredContext.Get())
-	{
-		ComPtr<ID3D11CommandList> cmdList;
-		m_DeferredContext->FinishCommandList(FALSE, &cmdList);
-		m_Context->ExecuteCommandList(cmdList.Get(), FALSE);
-	}
-
-	// 4. Inject
-	// Copy Generated -> BackBuffer
-	ID3D11Texture2D* pBackBuffer = nullptr;
-	if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&pBackBuffer)))
-		return false;
-
-	// Copy Generated Frame to BackBuffer
-	m_Context->CopyResource(pBackBuffer, m_TexGenerated.Get());
-	return true; 
-}
-
-void FrameGeneration::RestoreOriginal(IDXGISwapChain* swapChain)
-{
-	if (!m_TexCurrent || !m_Context) return;
-
-	ComPtr<ID3D11Texture2D> backBuffer;
-	if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer)))
-		return;
-
-	// [Debug Flicker Fix]
-	// If Debug Mode is active, we want the "Original" frame (Real Frame) to ALSO have the overlay.
-	// Since 'm_TexGenerated' was used for intermediate frames, it's dirty.
-	// We must Regenerate the Debug View for the current frame.
-	// [Split Screen Comparison] - Apply to Real Frame too for consistency (Line drawing)
-	if (m_Settings.EnableSplitScreen)
-	{
-		// For the Real Frame:
-		// Left (FG On)  = Frame N
-		// Right (FG Off)= Frame N
-		// So content is identical, but we need the LINE to be drawn so it doesn't flicker away.
-		// We use m_TexSharpened as temp again.
-		
-		ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
-		if (pTemp)
-		{
-			// Copy Current -> Temp
-			m_Context->CopyResource(pTemp, m_TexCurrent.Get());
-			
-			// Dispatch Split (Left=Temp, Right=Temp) -> Output to m_TexGenerated
-			// We write to m_TexGenerated because we will copy THAT to backbuffer.
-			m_FrameInterpolation.DispatchSplitScreen(m_Context.Get(), 
-				pTemp, 
-				pTemp, // Both sides are Frame N
-				m_TexGenerated.Get(), 
-				m_Settings.SplitScreenPosition);
-				
-			// Copy Result to BackBuffer
-			m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
-			return; // Early exit as we handled the copy
-		}
-	}
-
-	if (m_Settings.DebugViewMode > 0)
-	{
-		// ... existing Debug Logic ...
-		m_FrameInterpolation.Dispatch(m_Context.Get(), 
-			m_TexCurrent.Get(), 
-			m_TexPrev.Get(), 
-			m_TexMotion.Get(), 
-			m_TexGenerated.Get(),
-			m_OpticalFlow.GetStatsSRV(),
-			m_Settings.HUDThreshold,
-			m_Settings.DebugViewMode,
-			m_Settings.MotionSensitivity,
-			0.0f, // Factor 0.0
-			m_Settings.SceneChangeThreshold,
-			0.0f, 0.0f, false);
-
-		m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
-	}
-	else
-	{
-		// Restore Clean Original (Real Frame)
-        // [Flicker Fix] Apply RCAS to the Real Frame too!
-        bool applyRCAS = (m_Settings.RcasStrength > 0.0f);
-        
-        bool useScaling = (m_Settings.RenderScale < 0.99f);
-        if (useScaling && m_TexLowResCurrent)
-        {
-            // Upscale: LowRes -> TexGenerated (UAV safe)
-            DispatchScale(m_TexLowResCurrent.Get(), m_TexGenerated.Get());
-            
-            if (applyRCAS)
-            {
-                // Sharpen: TexGenerated -> Temp
-                ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
-                if (pTemp)
-                {
-                    m_FrameInterpolation.DispatchRCAS(m_Context.Get(), 
-                        m_TexGenerated.Get(), 
-                        pTemp, 
-                        m_Settings.RcasStrength);
-                        
-                    m_Context->CopyResource(backBuffer.Get(), pTemp);
-                    return;
-                }
-            }
-            
-            // Backup: Copy Scaled to Backbuffer
-            m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
-        }
-        else
-        {
-            // Native
-            if (applyRCAS)
-            {
-                // Unscaled but needs sharpening
-                // Sharpen: Current -> TexGenerated (as temp)
-                // Use TexGenerated as destination since we can't write UAV to BackBuffer
-                m_FrameInterpolation.DispatchRCAS(m_Context.Get(), 
-                    m_TexCurrent.Get(), 
-                    m_TexGenerated.Get(), 
-                    m_Settings.RcasStrength);
-                    
-                m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
-            }
-            else
-            {
-                 // Pure Copy
-                 m_Context->CopyResource(backBuffer.Get(), m_TexCurrent.Get());
-            }
-        }
-	}
-}
-
-void FrameGeneration::Release()
-{
-	m_TexCurrent.Reset();
-	m_Context.Reset();
-	m_Device.Reset();
-}
+#include "FrameGeneration.h"
+#include "Presets.h"
+#include <Debug/Debug.h>
+#include <Pipeline/Shaders/EmbeddedShaders.h>
+#include <Pipeline/Shaders/Shader.h>
+
+FrameGeneration& FrameGeneration::Instance()
+{
+	static FrameGeneration instance;
+	return instance;
+}
+
+void FrameGeneration::Initialize(ID3D11Device* device)
+{
+	m_Device = device;
+	m_Device->GetImmediateContext(&m_Context);
+
+	// Load Shaders
+    // [New] Scale Shader (Renamed to CS_Upscale.hlsl)
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Upscale, "main", &m_csScale))
+    {
+        Debug::Error("Failed to load CS_Upscale shader");
+    }
+    // [Fused RCAS] Optional, falls back to the separate RCAS pass
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Upscale, "CSUpscaleRCAS", &m_csScaleRCAS))
+    {
+        Debug::Error("Failed to load CS_Upscale RCAS shader");
+    }
+
+    // Create Constant Buffer for Upscale
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.ByteWidth = sizeof(CBUpscale);
+    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    m_Device->CreateBuffer(&cbDesc, nullptr, &m_cbUpscale);
+
+	// [Dynamic Resolution] Without timestamps the step stays at Render Scale
+	if (!m_GpuTimer.Initialize(device))
+		Debug::Error("GPU timer unavailable, Dynamic Resolution stays at Render Scale");
+
+	// [Async Compute] 
+	// Initialize Deferred Context for batching compute commands.
+	HRESULT hr = m_Device->CreateDeferredContext(0, &m_DeferredContext);
+	if (FAILED(hr)) {
+		Debug::Error("Failed to create Deferred Context (0x%X)", hr);
+	} else {
+		Debug::Info("Deferred Context created successfully.");
+	}
+	
+	Debug::Info("Frame Generation initialized.");
+}
+
+// [Fused RCAS] Precision of 'output', the fused pass rounds the upscaled colors to it like the two-pass chain's store did
+static int StorageFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+        return 1;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+void FrameGeneration::DispatchScale(ID3D11Texture2D* input, ID3D11Texture2D* output, float rcasStrength)
+{
+    if (!input || !output || !m_csScale || !m_cbUpscale) return;
+
+    // [Fused RCAS] Without the fused shader: upscale, then sharpen through the temp texture
+    bool fuseRCAS = rcasStrength > 0.001f;
+    if (fuseRCAS && !m_csScaleRCAS)
+    {
+        ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
+        DispatchScale(input, pTemp ? pTemp : output);
+        if (pTemp) m_FrameInterpolation.DispatchRCAS(m_Context.Get(), pTemp, output, rcasStrength);
+        return;
+    }
+
+    D3D11_TEXTURE2D_DESC inDesc;
+    input->GetDesc(&inDesc);
+    D3D11_TEXTURE2D_DESC outDesc;
+    output->GetDesc(&outDesc);
+
+    ID3D11ShaderResourceView* nullSRVs[8] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+    m_Context->CSSetShaderResources(0, 8, nullSRVs);
+    ID3D11UnorderedAccessView* nullUAVs[1] = { nullptr };
+    m_Context->CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+
+    // Update Constant Buffer
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (SUCCEEDED(m_Context->Map(m_cbUpscale.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+    {
+        CBUpscale* pData = (CBUpscale*)mapped.pData;
+        pData->Mode = (int)m_Active.UpscaleMode;
+        pData->Radius = m_Active.LanczosRadius;
+        pData->InputWidth = (float)inDesc.Width;
+        pData->InputHeight = (float)inDesc.Height;
+        pData->Sharpness = rcasStrength;
+        pData->StorageFormat = StorageFormat(outDesc.Format);
+        m_Context->Unmap(m_cbUpscale.Get(), 0);
+    }
+    m_Context->CSSetConstantBuffers(0, 1, m_cbUpscale.GetAddressOf());
+
+    // Create Views
+    ComPtr<ID3D11ShaderResourceView> srv;
+    ComPtr<ID3D11UnorderedAccessView> uav;
+    
+    // Linear
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> linearSampler;
+	m_Device->CreateSamplerState(&sampDesc, &linearSampler);
+
+    // Point
+    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+    ComPtr<ID3D11SamplerState> pointSampler;
+    m_Device->CreateSamplerState(&sampDesc, &pointSampler);
+
+    m_Device->CreateShaderResourceView(input, nullptr, &srv);
+    m_Device->CreateUnorderedAccessView(output, nullptr, &uav);
+
+    m_Context->CSSetShader(fuseRCAS ? m_csScaleRCAS.Get() : m_csScale.Get(), nullptr, 0);
+    m_Context->CSSetShaderResources(0, 1, srv.GetAddressOf());
+    m_Context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+    
+    ID3D11SamplerState* samplers[] = { linearSampler.Get(), pointSampler.Get() };
+    m_Context->CSSetSamplers(0, 2, samplers);
+
+    m_Context->Dispatch((UINT)ceil(outDesc.Width / 16.0f), (UINT)ceil(outDesc.Height / 16.0f), 1);
+
+    // Unbind
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    m_Context->CSSetShaderResources(0, 1, &nullSRV);
+    m_Context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+    m_Context->CSSetSamplers(0, 0, nullptr);
+}
+
+ID3D11Texture2D* FrameGeneration::SelectSynthesisMotion(ID3D11Texture2D* pixelMotion, int* motionBlockSize) const
+{
+	if (ID3D11Texture2D* blockMotion = m_OpticalFlow.GetBlockMotion())
+	{
+		*motionBlockSize = m_OpticalFlow.GetBlockMotionSize();
+		return blockMotion;
+	}
+
+	*motionBlockSize = 1;
+	return pixelMotion;
+}
+
+const FrameGeneration::ScaleTarget& FrameGeneration::AcquireScaleTarget(const D3D11_TEXTURE2D_DESC& frameDesc, int width, int height)
+{
+	for (const ScaleTarget& target : m_ScaleTargets)
+	{
+		if (target.Width == width && target.Height == height) return target;
+	}
+
+	ScaleTarget target;
+	target.Width = width;
+	target.Height = height;
+	D3D11_TEXTURE2D_DESC d = frameDesc;
+	d.Width = width; d.Height = height;
+	d.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	d.MiscFlags = 0;
+	d.CPUAccessFlags = 0;
+	d.Usage = D3D11_USAGE_DEFAULT;
+	if (d.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) d.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	m_Device->CreateTexture2D(&d, nullptr, &target.Current);
+	m_Device->CreateTexture2D(&d, nullptr, &target.Prev);
+	m_Device->CreateTexture2D(&d, nullptr, &target.Generated);
+	D3D11_TEXTURE2D_DESC md = d;
+	md.Format = DXGI_FORMAT_R16G16_FLOAT;
+	m_Device->CreateTexture2D(&md, nullptr, &target.Motion);
+
+	m_ScaleTargets.push_back(target);
+	return m_ScaleTargets.back();
+}
+
+// [Quality Ladder] Rungs in QualityLadder::Rung order: whether dropping it changes anything for 's' (the rungs before
+// it dropped), and the cheaper settings. SubPixel, smoothing and the pyramid only exist on the plain Dispatch path.
+struct LadderRung
+{
+	bool (*Applies)(const FrameGeneration::FrameGenSettings& s);
+	void (*Drop)(FrameGeneration::FrameGenSettings& s);
+};
+static bool IsPyramidFlow(const FrameGeneration::FrameGenSettings& s) { return !s.EnableBiDirFlow && !s.EnableAdaptiveBlock; }
+static const LadderRung s_LadderRungs[QualityLadder::RungCount] =
+{
+	{ [](const auto& s) { return s.EnableBiDirFlow; }, [](auto& s) { s.EnableBiDirFlow = false; } },
+	{ [](const auto& s) { return s.EnableSubPixel && IsPyramidFlow(s); }, [](auto& s) { s.EnableSubPixel = false; } },
+	{ [](const auto& s) { return s.EnableEdgeProtection; }, [](auto& s) { s.EnableEdgeProtection = false; } },
+	{ [](const auto& s) { return s.EnableMotionSmoothing && IsPyramidFlow(s); }, [](auto& s) { s.EnableMotionSmoothing = false; } },
+	{ [](const auto& s) { return s.MinPyramidLevel < s.MaxPyramidLevel && IsPyramidFlow(s); }, [](auto& s) { ++s.MinPyramidLevel; } },
+	{ [](const auto& s) { return s.MultiFrameCount > 1; }, [](auto& s) { s.MultiFrameCount = 1; } },
+};
+
+// [Auto-Tune] Results sit next to the DLL, keyed by the game's executable and the resolution
+static std::filesystem::path AutoTunePath()
+{
+	WCHAR modulePath[MAX_PATH];
+	HMODULE hModule = nullptr;
+	GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCWSTR)&AutoTunePath, &hModule);
+	GetModuleFileNameW(hModule, modulePath, MAX_PATH);
+	return std::filesystem::path(modulePath).replace_filename(L"LFG_AutoTune.txt");
+}
+
+static std::string AutoTuneKey(UINT width, UINT height)
+{
+	static const std::string exe = []
+	{
+		WCHAR exePath[MAX_PATH];
+		GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+		std::u8string name = std::filesystem::path(exePath).filename().u8string();
+		return std::string(name.begin(), name.end());
+	}();
+	return exe + "|" + std::to_string(width) + "x" + std::to_string(height);
+}
+
+void FrameGeneration::ApplyTuneCandidate(const AutoTuner::Candidate& candidate)
+{
+	m_Tune = candidate;
+	m_TuneApplied = true;
+}
+
+void FrameGeneration::UpdateAutoTune(bool measured, float gpuTime, UINT frameWidth, UINT frameHeight)
+{
+	if (!m_Settings.EnableAutoTune)
+	{
+		// Switched off: m_Settings were never touched, the user's own run again
+		if (m_AutoTuner.IsRunning()) m_AutoTuner.Stop();
+		m_TuneApplied = false;
+		m_AutoTuneResolved = false;
+		return;
+	}
+
+	// The key only changes with the swapchain size
+	if (frameWidth != m_AutoTuneWidth || frameHeight != m_AutoTuneHeight)
+	{
+		m_AutoTuneKey = AutoTuneKey(frameWidth, frameHeight);
+		m_AutoTuneWidth = frameWidth;
+		m_AutoTuneHeight = frameHeight;
+		m_AutoTuneResolved = false;
+	}
+
+	if (!m_AutoTuneResolved || m_CalibrationRequested)
+	{
+		if (m_AutoTuner.IsRunning()) m_AutoTuner.Stop();
+		m_TuneApplied = false;
+		m_AutoTuneResolved = true;
+
+		AutoTuner::Candidate stored;
+		if (!m_CalibrationRequested && AutoTuner::Load(AutoTunePath(), m_AutoTuneKey, stored) &&
+			stored.Preset >= 0 && stored.Preset < Presets::Count && stored.RenderScale > 0.0f && stored.RenderScale <= 1.0f)
+		{
+			ApplyTuneCandidate(stored);
+			Debug::Info("Auto-Tune: %s at Render Scale %.2f (stored for %s)", Presets::Names[stored.Preset], stored.RenderScale, m_AutoTuneKey.c_str());
+		}
+		else if (m_GpuTimer.IsAvailable() && m_WarpError.IsAvailable())
+		{
+			m_AutoTuner.Start(AutoTuner::BuildCandidates(Presets::RenderScales, Presets::Count), m_Settings.GenerationBudget);
+			ApplyTuneCandidate(m_AutoTuner.GetCurrent());
+			Debug::Info("Auto-Tune: calibrating %d configurations for %s", (int)m_AutoTuner.GetCandidates().size(), m_AutoTuneKey.c_str());
+		}
+		else
+		{
+			Debug::Error("Auto-Tune needs GPU timestamps and the warp error pass, settings unchanged");
+		}
+		m_CalibrationRequested = false;
+		return;
+	}
+
+	if (!m_AutoTuner.IsRunning()) return;
+
+	float error = 0.0f;
+	bool errorValid = m_WarpError.Collect(m_Context.Get(), error);
+	if (!m_AutoTuner.Update(measured, gpuTime, errorValid, error))
+	{
+		if (!m_AutoTuner.IsRunning())
+		{
+			// Not a single complete block
+			m_TuneApplied = false;
+			Debug::Error("Auto-Tune: no measurements, settings unchanged");
+		}
+		return;
+	}
+
+	if (m_AutoTuner.IsRunning())
+	{
+		ApplyTuneCandidate(m_AutoTuner.GetCurrent());
+		return;
+	}
+
+	const AutoTuner::Candidate& result = m_AutoTuner.GetResult();
+	ApplyTuneCandidate(result);
+	if (!AutoTuner::Save(AutoTunePath(), m_AutoTuneKey, result))
+		Debug::Error("Auto-Tune: failed to store the result");
+	Debug::Info("Auto-Tune: %s at Render Scale %.2f for %s", Presets::Names[result.Preset], result.RenderScale, m_AutoTuneKey.c_str());
+}
+
+void FrameGeneration::UpdateBudgets(UINT frameWidth, UINT frameHeight)
+{
+	// Closes last real frame (its generated frames included) and reads back the newest one the GPU finished
+	m_GpuTimer.EndFrame(m_Context.Get());
+	float gpuTime = 0.0f;
+	bool measured = m_GpuTimer.Collect(m_Context.Get(), gpuTime);
+	if (measured) m_LastGPUTime = gpuTime;
+
+	// [Auto-Tune] Candidates are measured as they are, no step or rung under them
+	UpdateAutoTune(measured, gpuTime, frameWidth, frameHeight);
+	bool tuning = m_AutoTuner.IsRunning();
+
+	// [Auto-Tune] The candidate's profile goes over a copy, m_Settings stay the user's
+	FrameGenSettings tuned = m_Settings;
+	if (m_TuneApplied)
+	{
+		Presets::Apply(m_Tune.Preset, tuned);
+		tuned.RenderScale = m_Tune.RenderScale;
+	}
+
+	if (tuned.RenderScale != m_ScaleCap)
+	{
+		// A new top step, the old ladder's textures go
+		m_ScaleCap = tuned.RenderScale;
+		m_ScaleController.Reset(m_ScaleCap);
+		m_ScaleTargets.clear();
+	}
+
+	// Native upscaling means no scaling at all
+	bool dynamic = tuned.EnableDynamicResolution && tuned.UpscaleMode != FrameGenSettings::UpscaleType::Native && !tuning;
+	if (!dynamic)
+	{
+		if (m_ScaleController.GetStep() != 0) m_ScaleController.Reset(m_ScaleCap);
+	}
+	else if (measured && m_ScaleController.Update(gpuTime, tuned.GenerationBudget))
+	{
+		// The ladder's cost just changed under it
+		m_QualityLadder.Settle();
+	}
+	m_RenderScale = dynamic ? m_ScaleController.GetScale() : tuned.RenderScale;
+
+	// [Quality Ladder] Generated frames have to be out well within a real frame
+	FrameGenSettings rungSettings = tuned;
+	unsigned available = 0;
+	for (int rung = 0; rung < QualityLadder::RungCount; ++rung)
+	{
+		if (s_LadderRungs[rung].Applies(rungSettings)) available |= 1u << rung;
+		s_LadderRungs[rung].Drop(rungSettings);
+	}
+
+	if (!tuned.EnableQualityLadder || tuning)
+	{
+		if (m_QualityLadder.GetDroppedCount() > 0) m_QualityLadder.Reset();
+	}
+	else if (measured && m_FrameInterval > 0.0f)
+	{
+		m_QualityLadder.Update(gpuTime, m_FrameInterval * tuned.LadderBudget, available);
+	}
+
+	m_Active = tuned;
+	for (int rung = 0; rung < QualityLadder::RungCount; ++rung)
+	{
+		if (m_QualityLadder.IsDropped(rung)) s_LadderRungs[rung].Drop(m_Active);
+	}
+}
+
+#include <chrono>
+
+void FrameGeneration::Capture(IDXGISwapChain* swapChain)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    
+	if (!m_Device || !m_Context) return;
+
+	ComPtr<ID3D11Texture2D> backBuffer;
+    if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer)))
+		return;
+    
+    D3D11_TEXTURE2D_DESC desc;
+	backBuffer->GetDesc(&desc);
+
+	// Lazy initialization of storage texture
+	if (!m_TexCurrent)
+	{
+		desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+		desc.MiscFlags = 0;
+		desc.CPUAccessFlags = 0;
+		desc.Usage = D3D11_USAGE_DEFAULT;
+        
+        if (desc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB) 
+            desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+		m_Device->CreateTexture2D(&desc, nullptr, &m_TexCurrent);
+		m_Device->CreateTexture2D(&desc, nullptr, &m_TexPrev);
+
+		D3D11_TEXTURE2D_DESC motionDesc = desc;
+		motionDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
+		motionDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+		m_Device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotion);
+		m_Device->CreateTexture2D(&desc, nullptr, &m_TexGenerated);
+
+		Debug::Info("GPU Resource Pool initialized.");
+
+		m_FrameInterpolation.Initialize(m_Device.Get(), desc.Width, desc.Height);
+		if (!m_SceneCut.Initialize(m_Device.Get()))
+			Debug::Error("Scene cut pre-pass unavailable, relying on the flow counter");
+		if (!m_FrameHash.Initialize(m_Device.Get()))
+			Debug::Error("Tile hash unavailable, every tile is searched");
+		if (!m_WarpError.Initialize(m_Device.Get()))
+			Debug::Error("Warp error unavailable, Auto-Tune keeps the settings");
+	}
+
+    // [Quality Ladder] Real frame interval, the ladder's budget is a share of it
+    if (m_LastCaptureTime.time_since_epoch().count() != 0)
+    {
+        std::chrono::duration<float, std::milli> interval = start - m_LastCaptureTime;
+        m_FrameInterval = m_FrameInterval > 0.0f ? m_FrameInterval + (interval.count() - m_FrameInterval) * 0.05f : interval.count();
+    }
+    m_LastCaptureTime = start;
+
+    // [Dynamic Resolution] This frame's step and rungs, then the timing of its passes starts
+    UpdateBudgets(desc.Width, desc.Height);
+    m_GpuTimer.BeginFrame(m_Context.Get());
+    m_GpuTimer.BeginSpan(m_Context.Get());
+
+    // Performance Mode Resources
+    bool useScaling = (m_RenderScale < 1.0f);
+    int targetW = (int)(desc.Width * m_RenderScale);
+    int targetH = (int)(desc.Height * m_RenderScale);
+    targetW = (targetW / 2) * 2; targetH = (targetH / 2) * 2; // Align
+    if (targetW < 16) targetW = 16; if (targetH < 16) targetH = 16;
+
+    if (useScaling)
+    {
+        D3D11_TEXTURE2D_DESC lrDesc = {};
+        if (m_TexLowResCurrent) m_TexLowResCurrent->GetDesc(&lrDesc);
+        
+        if (!m_TexLowResCurrent || lrDesc.Width != targetW || lrDesc.Height != targetH)
+        {
+            const ScaleTarget& target = AcquireScaleTarget(desc, targetW, targetH);
+            m_TexLowResCurrent = target.Current;
+            m_TexLowResPrev = target.Prev;
+            m_TexLowResGenerated = target.Generated;
+            m_TexLowResMotion = target.Motion;
+        }
+    }
+
+    // Shaders are kept, only the flow's textures follow the size
+    int flowW = useScaling ? targetW : (int)desc.Width;
+    int flowH = useScaling ? targetH : (int)desc.Height;
+    bool flowResized = false;
+    if (flowW != m_FlowWidth || flowH != m_FlowHeight)
+    {
+        flowResized = m_FlowWidth != 0;
+        m_OpticalFlow.Initialize(m_Device.Get(), flowW, flowH);
+        m_FlowWidth = flowW;
+        m_FlowHeight = flowH;
+    }
+
+	// [Cycle Frames]
+	if (m_TexPrev && m_TexCurrent) m_TexPrev.Swap(m_TexCurrent);
+    if (useScaling && m_TexLowResPrev && m_TexLowResCurrent) m_TexLowResPrev.Swap(m_TexLowResCurrent);
+
+	// 2. Capture New Frame
+	m_Context->CopyResource(m_TexCurrent.Get(), backBuffer.Get());
+    
+    // Downscale if needed
+    if (useScaling)
+    {
+         // [Dynamic Resolution] A new size has no previous frame yet: last frame's, downscaled
+         if (flowResized) DispatchScale(m_TexPrev.Get(), m_TexLowResPrev.Get());
+         DispatchScale(m_TexCurrent.Get(), m_TexLowResCurrent.Get());
+    }
+
+	// [Execute Pipeline]
+	ID3D11DeviceContext* ctxToUse = (m_Active.EnableAsyncCompute && m_DeferredContext) ? m_DeferredContext.Get() : m_Context.Get();
+
+    // Select Resources
+    ID3D11Texture2D* inputCurr = useScaling ? m_TexLowResCurrent.Get() : m_TexCurrent.Get();
+    ID3D11Texture2D* inputPrev = useScaling ? m_TexLowResPrev.Get() : m_TexPrev.Get();
+    ID3D11Texture2D* outputMotion = useScaling ? m_TexLowResMotion.Get() : m_TexMotion.Get();
+
+	// [Luma Pyramid] Built once per real frame at the flow resolution (outside the scene cut predicate,
+	// the next frame needs it as its previous pyramid). Last frame's pyramid is reused, not rebuilt.
+	D3D11_TEXTURE2D_DESC inputDesc;
+	inputCurr->GetDesc(&inputDesc);
+	if (m_LumaPyramid.GetWidth() != (int)inputDesc.Width || m_LumaPyramid.GetHeight() != (int)inputDesc.Height)
+	{
+		m_LumaPyramid.Initialize(m_Device.Get(), inputDesc.Width, inputDesc.Height, inputDesc.Format);
+		// [Dynamic Resolution] The first flow at the new size still has a previous pyramid
+		if (flowResized) m_LumaPyramid.Build(ctxToUse, inputPrev);
+	}
+	m_LumaPyramid.Build(ctxToUse, inputCurr);
+
+	// [Frame Products] Same for the polynomial expansion: this frame's is next frame's previous one
+	FlowAlgorithm flowAlgorithm = (FlowAlgorithm)m_Active.OpticalFlowAlgorithm;
+	m_OpticalFlow.ExpandFrame(ctxToUse, m_LumaPyramid, !m_Active.EnableBiDirFlow && !m_Active.EnableAdaptiveBlock &&
+		(flowAlgorithm == FlowAlgorithm::Farneback || flowAlgorithm == FlowAlgorithm::DIS || flowAlgorithm == FlowAlgorithm::Hybrid));
+
+	// [Tile Hash] Unchanged tiles skip the search, a frame without a changed tile is a duplicate (same verdict as a cut).
+	// Hashed at capture resolution, the downscaled frame can hide a change between the texels it samples.
+	bool hashed = m_Settings.EnableTileHash && m_FrameHash.Hash(ctxToUse, m_TexCurrent.Get(), inputDesc.Width, inputDesc.Height);
+	m_OpticalFlow.SetUnchangedTiles(hashed ? m_FrameHash.GetUnchangedSRV() : nullptr, inputDesc.Width);
+
+	// [Scene Cut] Decide before any motion estimation, the GPU drops the whole flow on a cut
+	m_SceneCutActive = (m_Settings.EnableSceneCutPrepass || hashed) &&
+		m_SceneCut.Detect(ctxToUse, inputCurr, inputPrev, hashed ? m_FrameHash.GetStatsSRV() : nullptr, m_Settings.EnableSceneCutPrepass);
+	if (m_SceneCutActive) m_SceneCut.BeginSkipOnCut(ctxToUse);
+
+	// [Quality Ladder] m_Active: the user's settings with the Auto-Tune profile and the dropped rungs applied
+	OpticalFlow::DispatchOptions options;
+	options.EnableSubPixel = m_Active.EnableSubPixel;
+	options.EnableSmoothing = m_Active.EnableMotionSmoothing;
+	options.EnableWarmStart = m_Active.EnableTemporalWarmStart;
+	options.BlockGranular = m_Active.EnableBlockMotion;
+	options.AggregateCost = m_Active.EnableCostAggregation;
+	options.InvertBackward = m_Active.EnableFlowInversion;
+	options.EnableGlobalMotion = m_Active.EnableGlobalMotion;
+	options.EnablePhaseCorrelation = m_Active.EnablePhaseCorrelation;
+	options.EnableAdaptiveRadius = m_Active.EnableAdaptiveRadius;
+	if (m_Active.EnableBiDirFlow)
+	{
+		m_OpticalFlow.DispatchBiDirectional(ctxToUse, m_LumaPyramid, outputMotion,
+			m_Active.BlockSize, m_Active.SearchRadius,
+			options);
+	}
+	else if (m_Active.EnableAdaptiveBlock)
+	{
+		m_OpticalFlow.DispatchAdaptive(ctxToUse, m_LumaPyramid, outputMotion,
+			m_Active.SearchRadius,
+			options);
+	}
+	else
+	{
+		m_OpticalFlow.Dispatch(ctxToUse, m_LumaPyramid, outputMotion,
+			m_Active.BlockSize, m_Active.SearchRadius,
+			m_Active.MaxPyramidLevel, m_Active.MinPyramidLevel,
+			flowAlgorithm, options);
+	}
+
+	if (m_SceneCutActive)
+	{
+		SceneCut::EndPredication(ctxToUse);
+		if (m_SceneCut.BeginOnCutOnly(ctxToUse))
+		{
+			m_OpticalFlow.ResetMotion(ctxToUse, outputMotion);
+			SceneCut::EndPredication(ctxToUse);
+		}
+	}
+
+	// Execute Async Command List
+	if (ctxToUse == m_DeferredContext.Get())
+	{
+		ComPtr<ID3D11CommandList> cmdList;
+		m_DeferredContext->FinishCommandList(FALSE, &cmdList);
+		m_Context->ExecuteCommandList(cmdList.Get(), FALSE);
+	}
+	m_GpuTimer.EndSpan(m_Context.Get());
+
+	// [Auto-Tune] Quality of this candidate's motion, outside the timed span
+	if (m_AutoTuner.IsRunning())
+	{
+		int motionBlockSize = 1;
+		m_WarpError.Measure(m_Context.Get(), m_TexCurrent.Get(), m_TexPrev.Get(), SelectSynthesisMotion(outputMotion, &motionBlockSize),
+			(float)desc.Width / (float)flowW, m_SceneCutActive ? &m_SceneCut : nullptr);
+	}
+
+	// [Low Latency Mode]
+	if (m_Active.LowLatencyMode)
+	{
+		ComPtr<IDXGIDevice1> dxgiDevice;
+		if (SUCCEEDED(m_Device.As(&dxgiDevice)))
+		{
+			dxgiDevice->SetMaximumFrameLatency(1);
+		}
+	}
+
+	// 3. Frame Synthesis (Generate Intermediate Frame)
+	if (m_Settings.DebugViewMode > 0)
+	{
+		// Render Debug View into m_TexGenerated (using current flow)
+		int motionBlockSize = 1;
+		ID3D11Texture2D* debugMotion = SelectSynthesisMotion(m_TexMotion.Get(), &motionBlockSize);
+		m_FrameInterpolation.Dispatch(m_Context.Get(), 
+			m_TexCurrent.Get(), 
+			m_TexPrev.Get(), 
+			debugMotion, 
+			m_TexGenerated.Get(),
+			m_OpticalFlow.GetStatsSRV(),
+			m_Settings.HUDThreshold,
+			m_Settings.DebugViewMode,
+			m_Settings.MotionSensitivity,
+			0.0f, // Factor doesn't matter for debug view usually
+			m_Settings.SceneChangeThreshold,
+			0.0f, 0.0f, false, // Disable RCAS/Ghosting/Edge for debug view
+			false, motionBlockSize);
+			
+		// Overwrite the Real BackBuffer with the Debug View
+		m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
+	}
+    
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<float, std::milli> duration = end - start;
+    m_LastGenTime = duration.count();
+}
+
+bool FrameGeneration::PresentGenerated(IDXGISwapChain* swapChain, UINT syncInterval, UINT flags, float factor)
+{
+	if (!m_TexGenerated || !m_Context) return false;
+
+	// 3. Frame Synthesis (Generate Intermediate Frame)
+	ID3D11DeviceContext* ctxToUse = (m_Active.EnableAsyncCompute && m_DeferredContext) ? m_DeferredContext.Get() : m_Context.Get();
+
+    bool useScaling = (m_RenderScale < 1.0f);
+    // [Native Synthesis] Flow stays at RenderScale, the warp reads the native frames and the low-res motion directly
+    bool lowResSynthesis = useScaling && !m_Settings.EnableNativeSynthesis;
+    ID3D11Texture2D* inputCurr = lowResSynthesis ? m_TexLowResCurrent.Get() : m_TexCurrent.Get();
+    ID3D11Texture2D* inputPrev = lowResSynthesis ? m_TexLowResPrev.Get() : m_TexPrev.Get();
+    ID3D11Texture2D* outputGen = lowResSynthesis ? m_TexLowResGenerated.Get() : m_TexGenerated.Get();
+
+    int motionBlockSize = 1;
+    ID3D11Texture2D* inputMotion = SelectSynthesisMotion(useScaling ? m_TexLowResMotion.Get() : m_TexMotion.Get(), &motionBlockSize);
+
+	// [Dynamic Resolution] Every generated frame counts towards its real frame's GPU time
+	m_GpuTimer.BeginSpan(m_Context.Get());
+
+	// [Scene Cut] HUD mask, synthesis and upscale are dropped on a cut, the real frame is shown instead
+	if (m_SceneCutActive) m_SceneCut.BeginSkipOnCut(ctxToUse);
+
+	m_FrameInterpolation.Dispatch(ctxToUse, 
+		inputCurr, 
+		inputPrev, 
+		inputMotion, 
+		outputGen,
+		m_OpticalFlow.GetStatsSRV(),
+		m_Settings.HUDThreshold,
+		m_Settings.DebugViewMode,
+		m_Settings.MotionSensitivity,
+		factor,
+		m_Settings.SceneChangeThreshold,
+		lowResSynthesis ? 0.0f : m_Active.RcasStrength, // [Fused RCAS] Low-res frames are sharpened by the upscale
+		m_Active.GhostingReduction,
+		m_Active.EnableEdgeProtection,
+		m_Settings.GenerationMode == FrameGenSettings::GenerationType::Extrapolation,
+		motionBlockSize,
+		m_Settings.EnableOcclusionBlend ? m_OpticalFlow.GetVisibility() : nullptr,
+		m_OpticalFlow.GetVisibilityScale(),
+		m_Settings.EnableForwardWarp,
+		&m_LumaPyramid,
+		m_Settings.EnableTileSkip);
+        
+    // [Upscale]
+    if (lowResSynthesis && m_TexLowResGenerated)
+    {
+        // Upscale LowResGenerated -> TexGenerated (Native), RCAS in the same pass like the real frames
+        DispatchScale(m_TexLowResGenerated.Get(), m_TexGenerated.Get(), m_Active.RcasStrength);
+    }
+
+	if (m_SceneCutActive)
+	{
+		SceneCut::EndPredication(ctxToUse);
+		if (m_SceneCut.BeginOnCutOnly(ctxToUse))
+		{
+			ctxToUse->CopyResource(m_TexGenerated.Get(), m_TexCurrent.Get());
+			SceneCut::EndPredication(ctxToUse);
+		}
+	}
+
+	// [Split Screen Comparison]
+	if (m_Settings.EnableSplitScreen)
+	{
+		// Use m_TexSharpened as a temp scratch buffer to avoid Read/Write hazard on m_TexGenerated
+		ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
+		if (pTemp)
+		{
+			// 1. Copy current Generated frame to Temp
+			ctxToUse->CopyResource(pTemp, m_TexGenerated.Get());
+
+			// 2. Dispatch Split Screen Shader
+			// Input A (Left/Gen): Temp
+			// Input B (Right/Real): The "No FG" experience (m_TexPrev, or m_TexCurrent when extrapolating past it)
+			// Output: m_TexGenerated (Overwrite with Split View)
+			bool extrapolating = (m_Settings.GenerationMode == FrameGenSettings::GenerationType::Extrapolation);
+			m_FrameInterpolation.DispatchSplitScreen(ctxToUse, 
+				pTemp, 
+				extrapolating ? m_TexCurrent.Get() : m_TexPrev.Get(), 
+				m_TexGenerated.Get(), 
+				m_Settings.SplitScreenPosition);
+		}
+	}
+
+	// Execute Async Command List
+	if (ctxToUse == m_DeferredContext.Get())
+	{
+		ComPtr<ID3D11CommandList> cmdList;
+		m_DeferredContext->FinishCommandList(FALSE, &cmdList);
+		m_Context->ExecuteCommandList(cmdList.Get(), FALSE);
+	}
+	m_GpuTimer.EndSpan(m_Context.Get());
+
+	// 4. Inject
+	// Copy Generated -> BackBuffer
+	ID3D11Texture2D* pBackBuffer = nullptr;
+	if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&pBackBuffer)))
+		return false;
+
+	// Copy Generated Frame to BackBuffer
+	m_Context->CopyResource(pBackBuffer, m_TexGenerated.Get());
+	return true; 
+}
+
+void FrameGeneration::RestoreOriginal(IDXGISwapChain* swapChain)
+{
+	if (!m_TexCurrent || !m_Context) return;
+
+	ComPtr<ID3D11Texture2D> backBuffer;
+	if (FAILED(swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer)))
+		return;
+
+	// [Debug Flicker Fix]
+	// If Debug Mode is active, we want the "Original" frame (Real Frame) to ALSO have the overlay.
+	// Since 'm_TexGenerated' was used for intermediate frames, it's dirty.
+	// We must Regenerate the Debug View for the current frame.
+	// [Split Screen Comparison] - Apply to Real Frame too for consistency (Line drawing)
+	if (m_Settings.EnableSplitScreen)
+	{
+		// For the Real Frame:
+		// Left (FG On)  = Frame N
+		// Right (FG Off)= Frame N
+		// So content is identical, but we need the LINE to be drawn so it doesn't flicker away.
+		// We use m_TexSharpened as temp again.
+		
+		ID3D11Texture2D* pTemp = m_FrameInterpolation.GetTempTexture();
+		if (pTemp)
+		{
+			// Copy Current -> Temp
+			m_Context->CopyResource(pTemp, m_TexCurrent.Get());
+			
+			// Dispatch Split (Left=Temp, Right=Temp) -> Output to m_TexGenerated
+			// We write to m_TexGenerated because we will copy THAT to backbuffer.
+			m_FrameInterpolation.DispatchSplitScreen(m_Context.Get(), 
+				pTemp, 
+				pTemp, // Both sides are Frame N
+				m_TexGenerated.Get(), 
+				m_Settings.SplitScreenPosition);
+				
+			// Copy Result to BackBuffer
+			m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
+			return; // Early exit as we handled the copy
+		}
+	}
+
+	if (m_Settings.DebugViewMode > 0)
+	{
+		// ... existing Debug Logic ...
+		int motionBlockSize = 1;
+		ID3D11Texture2D* debugMotion = SelectSynthesisMotion(m_TexMotion.Get(), &motionBlockSize);
+		m_FrameInterpolation.Dispatch(m_Context.Get(), 
+			m_TexCurrent.Get(), 
+			m_TexPrev.Get(), 
+			debugMotion, 
+			m_TexGenerated.Get(),
+			m_OpticalFlow.GetStatsSRV(),
+			m_Settings.HUDThreshold,
+			m_Settings.DebugViewMode,
+			m_Settings.MotionSensitivity,
+			0.0f, // Factor 0.0
+			m_Settings.SceneChangeThreshold,
+			0.0f, 0.0f, false,
+			false, motionBlockSize);
+
+		m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
+	}
+	else
+	{
+		// Restore Clean Original (Real Frame)
+        // [Flicker Fix] Apply RCAS to the Real Frame too!
+        bool applyRCAS = (m_Active.RcasStrength > 0.0f);
+        
+        // Resampled only when the generated frames are (low-res synthesis), so real and generated frames match
+        bool useScaling = (m_RenderScale < 0.99f) && !m_Settings.EnableNativeSynthesis;
+        if (useScaling && m_TexLowResCurrent)
+        {
+            // Upscale (+ RCAS in the same pass): LowRes -> TexGenerated (UAV safe)
+            DispatchScale(m_TexLowResCurrent.Get(), m_TexGenerated.Get(), applyRCAS ? m_Active.RcasStrength : 0.0f);
+            m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
+        }
+        else
+        {
+            // Native
+            if (applyRCAS)
+            {
+                // Unscaled but needs sharpening
+                // Sharpen: Current -> TexGenerated (as temp)
+                // Use TexGenerated as destination since we can't write UAV to BackBuffer
+                m_FrameInterpolation.DispatchRCAS(m_Context.Get(), 
+                    m_TexCurrent.Get(), 
+                    m_TexGenerated.Get(), 
+                    m_Active.RcasStrength);
+                    
+                m_Context->CopyResource(backBuffer.Get(), m_TexGenerated.Get());
+            }
+            else
+            {
+                 // Pure Copy
+                 m_Context->CopyResource(backBuffer.Get(), m_TexCurrent.Get());
+            }
+        }
+	}
+}
+
+void FrameGeneration::Release()
+{
+	m_ScaleTargets.clear();
+	m_TexCurrent.Reset();
+	m_Context.Reset();
+	m_Device.Reset();
+}
@@ -1,132 +1,228 @@
-#include <wrl/client.h>
-#include "../OpticalFlow/OpticalFlow.h"
-#include "../Interpolation/FrameInterpolation.h"
-
-using Microsoft::WRL::ComPtr;
-
-class FrameGeneration
-{
-public:
-	static FrameGeneration& Instance();
-
-	// Settings Structure
-	struct FrameGenSettings
-	{
-		// --- System & Core ---
-		bool EnableAsyncCompute = false;
-		bool LowLatencyMode = false;
-		bool DisableVSync = true;
-		
-		// --- FPS Control ---
-		bool FPSCap = false;
-		int TargetFPS = 0; // 0 = Unlimited
-		enum class FpsCapMode { Native, Display };
-		FpsCapMode CapMode = FpsCapMode::Native;
-
-		// --- Generation Control ---
-		int MultiFrameCount = 1; // 1 = 2x FPS (1 Gen), 2 = 3x FPS (2 Gen), etc.
-		bool EnableDynamicRatio = false;
-		bool EnableAggressiveDynamicMode = false; // [Aggressive] Allow up to 10x generation
-		int DynamicTargetFPS = 240; // Target FPS for Dynamic Ratio calculation
-
-		// --- Resolution & Upscaling ---
-		float RenderScale = 0.67f; // 0.5 - 1.0 - Balanced: 0.67f
-		enum class UpscaleType { Native = 0, Nearest = 1, Bilinear = 2, Bicubic = 3, Lanczos = 4 };
-		UpscaleType UpscaleMode = UpscaleType::Bicubic; // Balanced: Bicubic
-		int LanczosRadius = 2; // Default 2
-
-		// --- Optical Flow ---
-		int OpticalFlowAlgorithm = 1; // 0=BlockMatching, 1=Farneback, 2=DIS - Balanced: Farneback
-		int BlockSize = 16;
-		int SearchRadius = 16; // Balanced: 16
-		int MaxPyramidLevel = 1; // Start Level (0=Full, 1=Half, 2=Quarter) - Balanced: 1
-		int MinPyramidLevel = 0; // End Level (0=Full, 1=Half...) - Balanced: 0
-		
-		bool EnableBiDirFlow = false; // Balanced: False
-		bool EnableAdaptiveBlock = true; // Balanced: True
-		bool EnableSubPixel = true; // Balanced: True
-		float MotionSensitivity = 1.0f; // Multiplier for Optical Flow or Debug View scale
-
-		// --- Post-Processing & Quality ---
-		float RcasStrength = 0.5f; // Balanced: 0.5
-		float GhostingReduction = 0.3f; // Balanced: 0.3
-		bool EnableEdgeProtection = true; // Balanced: True
-		bool EnableMotionSmoothing = false; // Balanced: False
-		int SceneChangeThreshold = 1000; // > 0 to enable
-
-		// --- Debug & Telemetry ---
-		bool ShowDebugOverlay = true;
-		int DebugViewMode = 0; // 0=Off, 1=Motion, 2=Mask
-		float HUDThreshold = 0.01f;
-		
-		bool EnableSplitScreen = false;
-		float SplitScreenPosition = 0.5f; // 0.0 - 1.0
-	};
-
-	void Initialize(ID3D11Device* device);
-	void Capture(IDXGISwapChain* swapChain);
-	
-	void SetEnabled(bool enabled) { m_IsEnabled = enabled; }
-	bool IsEnabled() const { return m_IsEnabled; }
-
-    float GetLastGenerationTime() const { return m_LastGenTime; }
-
-	void SetSettings(const FrameGenSettings& settings) { m_Settings = settings; }
-	FrameGenSettings& GetSettings() { return m_Settings; }
-	
-	// Injects the generated frame into the swapchain
-	bool PresentGenerated(IDXGISwapChain* swapChain, UINT syncInterval, UINT flags, float factor);
-	// Restores the originally captured frame to the swapchain
-	void RestoreOriginal(IDXGISwapChain* swapChain);
-	void Release();
-
-	ID3D11Texture2D* GetCurrentTexture() const { return m_TexCurrent.Get(); }
-	ID3D11Texture2D* GetPrevTexture() const { return m_TexPrev.Get(); }
-	ID3D11Texture2D* GetMotionTexture() const { return m_TexMotion.Get(); }
-	ID3D11Texture2D* GetGeneratedTexture() const { return m_TexGenerated.Get(); }
-
-private:
-	FrameGeneration() = default;
-	~FrameGeneration() = default;
-	
-	// Helper for scaling
-	void DispatchScale(ID3D11Texture2D* input, ID3D11Texture2D* output);
-
-	ComPtr<ID3D11Device> m_Device;
-	ComPtr<ID3D11DeviceContext> m_Context;
-	ComPtr<ID3D11DeviceContext> m_DeferredContext; // [Async Compute]
-	
-	// Resources
-	ComPtr<ID3D11Texture2D> m_TexCurrent;   // The frame copied from the game
-	ComPtr<ID3D11Texture2D> m_TexPrev;      // The previous frame (for optical flow)
-	ComPtr<ID3D11Texture2D> m_TexMotion;    // Motion vectors
-	ComPtr<ID3D11Texture2D> m_TexGenerated; // The interpolated frame
-	
-	// Low Res Resources (for Performance Mode)
-	ComPtr<ID3D11Texture2D> m_TexLowResCurrent;
-	ComPtr<ID3D11Texture2D> m_TexLowResPrev;
-	ComPtr<ID3D11Texture2D> m_TexLowResMotion;
-	ComPtr<ID3D11Texture2D> m_TexLowResGenerated;
-	
-	struct CBUpscale
-	{
-		int Mode;
-		int Radius;
-		float InputWidth; // packed as float2 in shader
-		float InputHeight; 
-		// Padding handled by 16-byte alignment of next vector or explicit padding
-		// HLSL: int, int, float2 = 8 + 8 = 16 bytes. Perfect.
-	};
-	ComPtr<ID3D11Buffer> m_cbUpscale;
-	
-	// Shaders
-	ComPtr<ID3D11ComputeShader> m_csScale; // Now points to CS_Upscale
-
-	// Subsystems
-	OpticalFlow m_OpticalFlow;
-	FrameInterpolation m_FrameInterpolation;
-
-	bool m_IsEnabled = true;
-    float m_LastGenTime = 0.0f;
-	FrameGenSettings m_Settings;
+#pragma once
+#include <wrl/client.h>
+#include "../OpticalFlow/OpticalFlow.h"
+#include "../Interpolation/FrameInterpolation.h"
+#include "../Processing/SceneCut.h"
+#include "../Processing/FrameHash.h"
+#include "../Processing/LumaPyramid.h"
+#include "../Processing/GpuTimer.h"
+#include "../Processing/WarpError.h"
+#include "ScaleController.h"
+#include "QualityLadder.h"
+#include "AutoTuner.h"
+#include <vector>
+#include <chrono>
+#include <string>
+
+using Microsoft::WRL::ComPtr;
+
+class FrameGeneration
+{
+public:
+	static FrameGeneration& Instance();
+
+	// Settings Structure
+	struct FrameGenSettings
+	{
+		// --- System & Core ---
+		bool EnableAsyncCompute = false;
+		bool LowLatencyMode = false;
+		bool DisableVSync = true;
+		
+		// --- FPS Control ---
+		bool FPSCap = false;
+		int TargetFPS = 0; // 0 = Unlimited
+		enum class FpsCapMode { Native, Display };
+		FpsCapMode CapMode = FpsCapMode::Native;
+
+		// --- Generation Control ---
+		int MultiFrameCount = 1; // 1 = 2x FPS (1 Gen), 2 = 3x FPS (2 Gen), etc.
+		bool EnableDynamicRatio = false;
+		bool EnableAggressiveDynamicMode = false; // [Aggressive] Allow up to 10x generation
+		int DynamicTargetFPS = 240; // Target FPS for Dynamic Ratio calculation
+		enum class GenerationType { Interpolation = 0, Extrapolation = 1 };
+		GenerationType GenerationMode = GenerationType::Interpolation; // Extrapolation = no held-back real frame, some disocclusion artifacts
+
+		// --- Resolution & Upscaling ---
+		float RenderScale = 0.67f; // 0.5 - 1.0 - Balanced: 0.67f
+		enum class UpscaleType { Native = 0, Nearest = 1, Bilinear = 2, Bicubic = 3, Lanczos = 4 };
+		UpscaleType UpscaleMode = UpscaleType::Bicubic; // Balanced: Bicubic
+		int LanczosRadius = 2; // Default 2
+		bool EnableNativeSynthesis = true; // RenderScale < 1: flow at RenderScale, warp at native resolution (no per-frame upscale)
+		bool EnableDynamicResolution = false; // RenderScale is the top step, lower ones are taken while the GPU time exceeds GenerationBudget
+		float GenerationBudget = 4.0f; // ms of GPU time per real frame (analysis + every generated frame)
+		bool EnableQualityLadder = false; // Drops BiDir, sub-pixel, edge protection, smoothing, a pyramid level, then >2x in turn
+		float LadderBudget = 0.5f; // ... while the GPU time per real frame exceeds this share of the real frame interval
+		bool EnableAutoTune = false; // Preset and Render Scale calibrated on live frames per game and resolution, within GenerationBudget
+
+		// --- Optical Flow ---
+		int OpticalFlowAlgorithm = 1; // 0=BlockMatching, 1=Farneback, 2=DIS, 3=3DRS, 4=Hybrid - Balanced: Farneback
+		int BlockSize = 16;
+		int SearchRadius = 16; // Balanced: 16
+		int MaxPyramidLevel = 1; // Start Level (0=Full, 1=Half, 2=Quarter ... 4=1/16, capped by the flow resolution) - Balanced: 1
+		int MinPyramidLevel = 1; // End Level (0=Full, 1=Half...), finer levels get the guided upsample - Balanced: 1
+		
+		bool EnableBiDirFlow = false; // Balanced: False
+		bool EnableOcclusionBlend = true; // BiDir only: per-pixel source weights from the forward/backward visibility
+		bool EnableFlowInversion = true; // BiDir + Windowed Matching Cost: backward field inverted from the forward one
+		bool EnableAdaptiveBlock = true; // Quadtree 32x32 - 4x4 blocks from the variance grid - Balanced: True
+		bool EnableSubPixel = true; // Balanced: True
+		bool EnableForwardWarp = true; // Interpolation: splat motion to the generated frame's time before sampling it
+		bool EnableTemporalWarmStart = true; // Reuse last frame's motion as the initial guess
+		bool EnableGlobalMotion = false; // Camera motion (affine / homography) fitted to last frame's vectors seeds the pyramid search
+		bool EnablePhaseCorrelation = false; // Per-tile FFT phase correlation peaks as extra candidates of the coarsest search level
+		bool EnableAdaptiveRadius = false; // Search reach and pyramid depth from last frame's measured motion, SearchRadius is the cap
+		bool EnableBlockMotion = false; // One vector per BlockSize block (BlockMatching/3DRS), sampled bilinearly by synthesis
+		bool EnableCostAggregation = false; // Per-pixel matching on a BlockSize window SAD (BlockMatching/BiDir)
+		float MotionSensitivity = 1.0f; // Multiplier for Optical Flow or Debug View scale
+
+		// --- Post-Processing & Quality ---
+		float RcasStrength = 0.5f; // Balanced: 0.5
+		float GhostingReduction = 0.3f; // Balanced: 0.3
+		bool EnableEdgeProtection = true; // Balanced: True
+		bool EnableMotionSmoothing = false; // Balanced: False
+		int SceneChangeThreshold = 1000; // > 0 to enable
+		bool EnableSceneCutPrepass = true; // Thumbnail histogram check before flow, a cut skips flow + synthesis on the GPU
+		bool EnableTileSkip = true; // Only 16x16 tiles with motion / change are warped, static tiles are the real frame
+		bool EnableTileHash = true; // Tiles hashing like last frame get zero motion unsearched, an all-matching frame is not generated
+
+		// --- Debug & Telemetry ---
+		bool ShowDebugOverlay = true;
+		int DebugViewMode = 0; // 0=Off, 1=Motion, 2=Mask
+		float HUDThreshold = 0.01f;
+		
+		bool EnableSplitScreen = false;
+		float SplitScreenPosition = 0.5f; // 0.0 - 1.0
+	};
+
+	void Initialize(ID3D11Device* device);
+	void Capture(IDXGISwapChain* swapChain);
+	
+	void SetEnabled(bool enabled) { m_IsEnabled = enabled; }
+	bool IsEnabled() const { return m_IsEnabled; }
+
+    float GetLastGenerationTime() const { return m_LastGenTime; }
+	// [Dynamic Resolution] GPU time of the newest real frame the timestamps have ready (ms, 0 until one is)
+	float GetGPUGenerationTime() const { return m_LastGPUTime; }
+	// Render Scale the flow runs at (below RenderScale while Dynamic Resolution steps down)
+	float GetRenderScale() const { return m_RenderScale; }
+	// [Quality Ladder] Generated frames per real frame of the last Capture (the ladder may have fallen back to 2x)
+	int GetGeneratedFrameCount() const { return m_Active.MultiFrameCount; }
+	const QualityLadder& GetQualityLadder() const { return m_QualityLadder; }
+	// [Auto-Tune] Calibrates again on the next frame, the stored result is replaced
+	void RequestCalibration() { m_CalibrationRequested = true; }
+	const AutoTuner& GetAutoTuner() const { return m_AutoTuner; }
+	// Candidate laid over the settings (the one being measured, or the result), nullptr = none
+	const AutoTuner::Candidate* GetAppliedTune() const { return m_TuneApplied ? &m_Tune : nullptr; }
+
+	void SetSettings(const FrameGenSettings& settings) { m_Settings = settings; }
+	// The user's settings. Auto-Tune and the quality ladder never write them, GetActiveSettings has what runs.
+	FrameGenSettings& GetSettings() { return m_Settings; }
+	const FrameGenSettings& GetActiveSettings() const { return m_Active; }
+	
+	// Injects the generated frame into the swapchain
+	bool PresentGenerated(IDXGISwapChain* swapChain, UINT syncInterval, UINT flags, float factor);
+	// Restores the originally captured frame to the swapchain
+	void RestoreOriginal(IDXGISwapChain* swapChain);
+	void Release();
+
+	ID3D11Texture2D* GetCurrentTexture() const { return m_TexCurrent.Get(); }
+	ID3D11Texture2D* GetPrevTexture() const { return m_TexPrev.Get(); }
+	ID3D11Texture2D* GetMotionTexture() const { return m_TexMotion.Get(); }
+	ID3D11Texture2D* GetGeneratedTexture() const { return m_TexGenerated.Get(); }
+
+private:
+	FrameGeneration() = default;
+	~FrameGeneration() = default;
+	
+	// Helper for scaling. rcasStrength > 0: sharpens in the same pass (CSUpscaleRCAS), same result as
+	// DispatchScale followed by RCAS on 'output'
+	void DispatchScale(ID3D11Texture2D* input, ID3D11Texture2D* output, float rcasStrength = 0.0f);
+	// [Block Motion] Motion consumed by synthesis: the block field if the flow produced one, else pixelMotion
+	ID3D11Texture2D* SelectSynthesisMotion(ID3D11Texture2D* pixelMotion, int* motionBlockSize) const;
+
+	// [Dynamic Resolution] Low res textures per size, kept so a step taken before is not reallocated
+	struct ScaleTarget
+	{
+		int Width = 0;
+		int Height = 0;
+		ComPtr<ID3D11Texture2D> Current;
+		ComPtr<ID3D11Texture2D> Prev;
+		ComPtr<ID3D11Texture2D> Motion;
+		ComPtr<ID3D11Texture2D> Generated;
+	};
+	const ScaleTarget& AcquireScaleTarget(const D3D11_TEXTURE2D_DESC& frameDesc, int width, int height);
+	// Feeds the GPU time the timestamps have ready to the Render Scale step (m_RenderScale) and the quality
+	// ladder (m_Active), and the auto-tuner first
+	void UpdateBudgets(UINT frameWidth, UINT frameHeight);
+	// [Auto-Tune] Steps the calibration with this frame's measurements, switches m_Tune between candidates
+	void UpdateAutoTune(bool measured, float gpuTime, UINT frameWidth, UINT frameHeight);
+	void ApplyTuneCandidate(const AutoTuner::Candidate& candidate);
+
+	ComPtr<ID3D11Device> m_Device;
+	ComPtr<ID3D11DeviceContext> m_Context;
+	ComPtr<ID3D11DeviceContext> m_DeferredContext; // [Async Compute]
+	
+	// Resources
+	ComPtr<ID3D11Texture2D> m_TexCurrent;   // The frame copied from the game
+	ComPtr<ID3D11Texture2D> m_TexPrev;      // The previous frame (for optical flow)
+	ComPtr<ID3D11Texture2D> m_TexMotion;    // Motion vectors
+	ComPtr<ID3D11Texture2D> m_TexGenerated; // The interpolated frame
+	
+	// Low Res Resources (for Performance Mode)
+	ComPtr<ID3D11Texture2D> m_TexLowResCurrent;
+	ComPtr<ID3D11Texture2D> m_TexLowResPrev;
+	ComPtr<ID3D11Texture2D> m_TexLowResMotion;
+	ComPtr<ID3D11Texture2D> m_TexLowResGenerated; // Only without Native Synthesis
+	std::vector<ScaleTarget> m_ScaleTargets; // [Dynamic Resolution] Every step of the current ladder taken so far
+	int m_FlowWidth = 0; // Size OpticalFlow was initialized at
+	int m_FlowHeight = 0;
+	
+	struct CBUpscale
+	{
+		int Mode;
+		int Radius;
+		float InputWidth; // packed as float2 in shader
+		float InputHeight; 
+		// Padding handled by 16-byte alignment of next vector or explicit padding
+		// HLSL: int, int, float2 = 8 + 8 = 16 bytes. Perfect.
+		float Sharpness; // [Fused RCAS]
+		int StorageFormat; // 0 = Float, 1 = UNORM8, 2 = FLOAT16
+		float Padding[2];
+	};
+	ComPtr<ID3D11Buffer> m_cbUpscale;
+	
+	// Shaders
+	ComPtr<ID3D11ComputeShader> m_csScale; // Now points to CS_Upscale
+	ComPtr<ID3D11ComputeShader> m_csScaleRCAS; // [Fused RCAS] CS_Upscale::CSUpscaleRCAS
+
+	// Subsystems
+	LumaPyramid m_LumaPyramid; // [Luma Pyramid] Analysis frames for the flow, edges and warp cost
+	OpticalFlow m_OpticalFlow;
+	FrameInterpolation m_FrameInterpolation;
+	SceneCut m_SceneCut;
+	FrameHash m_FrameHash; // [Tile Hash] Unchanged tiles / duplicate frames
+	bool m_SceneCutActive = false; // [Scene Cut] This frame's flow + synthesis are predicated on the verdict
+	GpuTimer m_GpuTimer; // [Dynamic Resolution]
+	ScaleController m_ScaleController;
+	float m_ScaleCap = -1.0f; // RenderScale the ladder was built from
+	float m_RenderScale = 1.0f; // This frame's
+	float m_LastGPUTime = 0.0f;
+	QualityLadder m_QualityLadder; // [Quality Ladder]
+	FrameGenSettings m_Active; // m_Settings with m_Tune and the dropped rungs applied, what this frame's passes use
+	std::chrono::high_resolution_clock::time_point m_LastCaptureTime;
+	float m_FrameInterval = 0.0f; // Real frame interval (ms, running average)
+	AutoTuner m_AutoTuner; // [Auto-Tune]
+	WarpError m_WarpError;
+	AutoTuner::Candidate m_Tune; // Preset and Render Scale laid over m_Settings into m_Active
+	bool m_TuneApplied = false;
+	std::string m_AutoTuneKey; // Game and resolution, rebuilt when the swapchain size changes
+	UINT m_AutoTuneWidth = 0;
+	UINT m_AutoTuneHeight = 0;
+	bool m_AutoTuneResolved = false; // The key's stored result was applied, or its calibration started
+	bool m_CalibrationRequested = false;
+
+	bool m_IsEnabled = true;
+    float m_LastGenTime = 0.0f;
+	FrameGenSettings m_Settings;
 };
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "Presets.h"
+
+const char* const Presets::Names[Presets::Count] = { "Ultra Performance", "Performance", "Balanced", "Quality", "Cinematic" };
+const float Presets::RenderScales[Presets::Count] = { 0.33f, 0.5f, 0.67f, 0.85f, 1.0f };
+
+int Presets::Match(const FrameGeneration::FrameGenSettings& s)
+{
+    // 0: Ultra Performance
+    // Check all relevant settings for Ultra Performance preset
+    if (s.RenderScale == 0.33f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Nearest && 
+        s.EnableAggressiveDynamicMode &&
+        !s.EnableBiDirFlow && !s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 0 && 
+        s.BlockSize == 32 && s.SearchRadius == 4 && s.MaxPyramidLevel == 2 && s.MinPyramidLevel == 2 && 
+        !s.EnableSubPixel && !s.EnableMotionSmoothing &&
+        s.RcasStrength == 0.0f && s.GhostingReduction == 0.0f && !s.EnableEdgeProtection &&
+        s.EnableAsyncCompute && s.LowLatencyMode && s.DisableVSync) return 0;
+        
+    // 1: Performance
+    // Check all relevant settings for Performance preset
+    if (s.RenderScale == 0.5f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Bilinear && 
+        !s.EnableAggressiveDynamicMode &&
+        !s.EnableBiDirFlow && !s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 0 && 
+        s.BlockSize == 16 && s.SearchRadius == 8 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 1 && 
+        !s.EnableSubPixel && !s.EnableMotionSmoothing &&
+        s.RcasStrength == 0.2f && s.GhostingReduction == 0.1f && !s.EnableEdgeProtection) return 1;
+
+    // 2: Balanced
+    // Check all relevant settings for Balanced preset
+    if (s.RenderScale == 0.67f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Bicubic && 
+        !s.EnableAggressiveDynamicMode &&
+        !s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && 
+        s.BlockSize == 16 && s.SearchRadius == 16 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 1 && 
+        s.EnableSubPixel && !s.EnableMotionSmoothing &&
+        s.RcasStrength == 0.5f && s.GhostingReduction == 0.3f && s.EnableEdgeProtection) return 2;
+
+    // 3: Quality
+    // Check all relevant settings for Quality preset
+    if (s.RenderScale == 0.85f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos && 
+        s.LanczosRadius == 2 && !s.EnableAggressiveDynamicMode &&
+        s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && 
+        s.BlockSize == 8 && s.SearchRadius == 24 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 0 && 
+        s.EnableSubPixel && s.EnableMotionSmoothing &&
+        s.RcasStrength == 0.7f && s.GhostingReduction == 0.5f && s.EnableEdgeProtection) return 3;
+
+    // 4: Cinematic
+    // Check all relevant settings for Cinematic preset
+    if (s.RenderScale == 1.0f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos && 
+        s.LanczosRadius == 3 && !s.EnableAggressiveDynamicMode &&
+        s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && // Note: Original had DIS, but then changed to Farneback. Using Farneback for preset check.
+        s.BlockSize == 4 && s.SearchRadius == 32 && s.MaxPyramidLevel == 0 && s.MinPyramidLevel == 0 && 
+        s.EnableSubPixel && s.EnableMotionSmoothing &&
+        s.RcasStrength == 0.9f && s.GhostingReduction == 0.8f && s.EnableEdgeProtection) return 4;
+
+    return -1; // Custom
+}
+
+void Presets::Apply(int preset, FrameGeneration::FrameGenSettings& settings)
+{
+    if (preset == 0) // Ultra Performance
+    {
+        settings.RenderScale = 0.33f;
+        settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Nearest;
+        settings.EnableAggressiveDynamicMode = true; 
+        
+        settings.EnableBiDirFlow = false;
+        settings.EnableAdaptiveBlock = false;
+        settings.OpticalFlowAlgorithm = 0; // Block Matching
+        settings.BlockSize = 32; settings.SearchRadius = 4;
+        settings.MaxPyramidLevel = 2; settings.MinPyramidLevel = 2; // Coarse
+        settings.EnableSubPixel = false;
+        settings.EnableMotionSmoothing = false;
+        
+        settings.RcasStrength = 0.0f;
+        settings.GhostingReduction = 0.0f;
+        settings.EnableEdgeProtection = false;
+        
+        settings.EnableAsyncCompute = true;
+        settings.LowLatencyMode = true;
+        settings.DisableVSync = true;
+    }
+    else if (preset == 1) // Performance
+    {
+        settings.RenderScale = 0.5f;
+        settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Bilinear;
+        settings.EnableAggressiveDynamicMode = false;
+        
+        settings.EnableBiDirFlow = false;
+        settings.EnableAdaptiveBlock = false;
+        settings.OpticalFlowAlgorithm = 0; // Block Matching
+        settings.BlockSize = 16; settings.SearchRadius = 8;
+        settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 1; // Half Res
+        settings.EnableSubPixel = false;
+        settings.EnableMotionSmoothing = false;
+        
+        settings.GhostingReduction = 0.1f;
+        settings.EnableEdgeProtection = false;
+    }
+    else if (preset == 2) // Balanced
+    {
+        settings.RenderScale = 0.67f;
+        settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Bicubic;
+        settings.EnableAggressiveDynamicMode = false;
+        
+        settings.EnableBiDirFlow = false;
+        settings.EnableAdaptiveBlock = true; // [Adaptive]
+        settings.OpticalFlowAlgorithm = 1; // Farneback (Smoother)
+        settings.BlockSize = 16; settings.SearchRadius = 16;
+        settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 1; // Half Res, guided upsample to Native
+        settings.EnableSubPixel = true;
+        settings.EnableMotionSmoothing = false;
+        
+        settings.GhostingReduction = 0.3f;
+        settings.EnableEdgeProtection = true;
+    }
+    else if (preset == 3) // Quality
+    {
+        settings.RenderScale = 0.85f; // High but not full
+        settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Lanczos;
+        settings.LanczosRadius = 2;
+        settings.EnableAggressiveDynamicMode = false;
+        
+        settings.EnableBiDirFlow = true; // [Bi-Dir]
+        settings.EnableAdaptiveBlock = true;
+        settings.OpticalFlowAlgorithm = 1; // Farneback
+        settings.BlockSize = 8; settings.SearchRadius = 24;
+        settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 0;
+        settings.EnableSubPixel = true;
+        settings.EnableMotionSmoothing = true; // [Motion Smooth]
+        
+        settings.GhostingReduction = 0.5f;
+        settings.EnableEdgeProtection = true;
+    }
+    else if (preset == 4) // Cinematic
+    {
+        settings.RenderScale = 1.0f; // Native
+        settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Lanczos;
+        settings.LanczosRadius = 3; // Max Sharpness
+        settings.EnableAggressiveDynamicMode = false;
+        
+        settings.EnableBiDirFlow = true;
+        settings.EnableAdaptiveBlock = true;
+        settings.OpticalFlowAlgorithm = 1; // Farneback (Still using Farneback as per safe default logic)
+        
+        settings.BlockSize = 4; // Detail
+        settings.SearchRadius = 32; // Wide
+        settings.MaxPyramidLevel = 0; settings.MinPyramidLevel = 0; // Full Search
+        settings.EnableSubPixel = true;
+        settings.EnableMotionSmoothing = true;
+        
+        settings.GhostingReduction = 0.8f;
+        settings.EnableEdgeProtection = true;
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "FrameGeneration.h"
+
+// Performance Profiles: the Menu's combo and the [Auto-Tune] candidates
+namespace Presets
+{
+    constexpr int Count = 5; // Ultra Performance, Performance, Balanced, Quality, Cinematic
+    extern const char* const Names[Count];
+    extern const float RenderScales[Count]; // Render Scale each one sets
+
+    // Preset the settings match exactly, -1 = Custom
+    int Match(const FrameGeneration::FrameGenSettings& s);
+    // Overwrites the settings the preset covers, the rest is kept
+    void Apply(int preset, FrameGeneration::FrameGenSettings& settings);
+}
@@ -0,0 +1,145 @@
+#include "QualityLadder.h"
+
+#include <algorithm>
+#include <iterator>
+
+const QualityLadder::RungSpec QualityLadder::Rungs[RungCount] =
+{
+	{ "Bi-Directional Flow", 0.35f },
+	{ "Sub-Pixel", 0.10f },
+	{ "Edge Protection", 0.05f },
+	{ "Motion Smoothing", 0.05f },
+	{ "Pyramid Level", 0.25f },
+	{ "2x Fallback", 0.40f },
+};
+
+void QualityLadder::Reset()
+{
+	std::fill(std::begin(m_Dropped), std::end(m_Dropped), false);
+	std::fill(std::begin(m_Saving), std::end(m_Saving), 0.0f);
+	m_UpFrames = UpFrames;
+	m_SinceUp = -1;
+	Settle();
+}
+
+void QualityLadder::Settle()
+{
+	m_CostValid = false;
+	m_RecentCount = 0;
+	m_OverFrames = 0;
+	m_UnderFrames = 0;
+	m_SettleFrames = SettleFrames;
+	m_MeasureRung = -1;
+}
+
+float QualityLadder::RecentCost() const
+{
+	const int count = std::min(m_RecentCount, MeasureFrames);
+	float sum = 0.0f;
+	for (int i = 0; i < count; ++i) sum += m_Recent[i];
+	return count > 0 ? sum / (float)count : m_AverageCost;
+}
+
+int QualityLadder::GetDroppedCount() const
+{
+	return (int)std::count(std::begin(m_Dropped), std::end(m_Dropped), true);
+}
+
+int QualityLadder::GetLastDropped() const
+{
+	for (int rung = RungCount - 1; rung >= 0; --rung)
+	{
+		if (m_Dropped[rung]) return rung;
+	}
+	return -1;
+}
+
+void QualityLadder::Change(int rung, bool dropped)
+{
+	const float costBefore = RecentCost();
+	m_Dropped[rung] = dropped;
+	Settle();
+
+	// The means restart after settling, the difference to the one before is what the rung is worth
+	m_MeasureRung = rung;
+	m_MeasureDropped = dropped;
+	m_CostBefore = costBefore;
+	m_MeasureFrames = MeasureFrames;
+}
+
+bool QualityLadder::Update(float costMs, float budgetMs, unsigned available)
+{
+	if (budgetMs <= 0.0f || costMs < 0.0f) return false;
+
+	// A rung the settings no longer use (turned off by hand) is not held
+	for (int rung = 0; rung < RungCount; ++rung)
+	{
+		if (m_Dropped[rung] && !(available & (1u << rung)))
+		{
+			m_Dropped[rung] = false;
+			if (m_MeasureRung == rung) m_MeasureRung = -1;
+		}
+	}
+
+	// A restore that held long enough: the next one only waits the normal time again
+	if (m_SinceUp >= 0 && ++m_SinceUp > MaxUpFrames)
+	{
+		m_SinceUp = -1;
+		m_UpFrames = UpFrames;
+	}
+
+	if (m_SettleFrames > 0)
+	{
+		--m_SettleFrames;
+		return false;
+	}
+
+	m_AverageCost = m_CostValid ? m_AverageCost + (costMs - m_AverageCost) * CostSmoothing : costMs;
+	m_CostValid = true;
+	m_Recent[m_RecentCount++ % MeasureFrames] = costMs;
+
+	if (m_MeasureRung >= 0 && --m_MeasureFrames <= 0)
+	{
+		const float delta = m_MeasureDropped ? m_CostBefore - RecentCost() : RecentCost() - m_CostBefore;
+		m_Saving[m_MeasureRung] = std::max(delta, 0.0f);
+		m_MeasureRung = -1;
+	}
+
+	if (m_AverageCost > budgetMs)
+	{
+		m_UnderFrames = 0;
+		if (++m_OverFrames < DownFrames) return false;
+
+		for (int rung = 0; rung < RungCount; ++rung)
+		{
+			if (m_Dropped[rung] || !(available & (1u << rung))) continue;
+
+			// Restored and could not hold it: wait longer before the next try
+			if (m_SinceUp >= 0 && m_SinceUp < m_UpFrames) m_UpFrames = std::min(m_UpFrames * 2, MaxUpFrames);
+			m_SinceUp = -1;
+
+			if (m_Saving[rung] <= 0.0f) m_Saving[rung] = m_AverageCost * Rungs[rung].ExpectedSaving;
+			Change(rung, true);
+			return true;
+		}
+		return false; // Nothing left to drop
+	}
+
+	m_OverFrames = 0;
+	const int last = GetLastDropped();
+	if (last >= 0 && m_MeasureRung < 0 && m_AverageCost <= budgetMs * UpMargin)
+	{
+		const bool fits = m_AverageCost + m_Saving[last] <= budgetMs * UpMargin;
+		if (++m_UnderFrames >= (fits ? m_UpFrames : MaxUpFrames))
+		{
+			Change(last, false);
+			m_SinceUp = 0;
+			return true;
+		}
+	}
+	else
+	{
+		m_UnderFrames = 0;
+	}
+	return false;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// [Quality Ladder] Features given up, in a fixed order, while the generation's GPU time is over its share of the real
+// frame interval (a generated frame that arrives late is worse than none), and given back in reverse order once the
+// last one dropped fits again with room to spare. What each rung saves is measured when it is dropped (the mean cost
+// before minus after) and refreshed when it is restored; Rungs[].ExpectedSaving stands in until then. A rung whose
+// measured saving alone keeps it dropped is restored after MaxUpFrames anyway, so one hitch can't hold it for good.
+// Plain CPU code: the caller says which rungs would change anything and applies the dropped ones to its settings.
+class QualityLadder
+{
+public:
+	// Drop order, restored in reverse
+	enum Rung
+	{
+		BiDirFlow = 0,
+		SubPixel,
+		EdgeProtection,
+		MotionSmoothing,
+		PyramidLevel, // The finest pyramid level
+		MultiFrame, // Back to 2x
+		RungCount
+	};
+
+	struct RungSpec
+	{
+		const char* Name;
+		float ExpectedSaving; // Share of the cost, until measured
+	};
+	static const RungSpec Rungs[RungCount];
+
+	QualityLadder() = default;
+	~QualityLadder() = default;
+
+	void Reset();
+	// One real frame's GPU cost. 'available': bit per rung that changes anything for the current settings (with the
+	// rungs before it dropped). True when a rung was dropped or restored.
+	bool Update(float costMs, float budgetMs, unsigned available);
+	// The cost changed for another reason (e.g. a resolution step), the next frames are not measured
+	void Settle();
+
+	bool IsDropped(int rung) const { return m_Dropped[rung]; }
+	int GetDroppedCount() const;
+	// Last rung dropped, -1 with everything on
+	int GetLastDropped() const;
+	// Measured (or expected) ms saved by 'rung'
+	float GetSaving(int rung) const { return m_Saving[rung]; }
+	float GetAverageCost() const { return m_CostValid ? m_AverageCost : 0.0f; }
+
+	static constexpr float CostSmoothing = 0.3f; // Running average weight of the newest frame
+	static constexpr int DownFrames = 3; // Consecutive frames over budget before a rung is dropped
+	static constexpr int UpFrames = 60; // Consecutive frames the last rung is predicted to fit before it is restored
+	static constexpr float UpMargin = 0.8f; // ... under this share of the budget
+	static constexpr int SettleFrames = 4; // Frames ignored after a change
+	static constexpr int MeasureFrames = 8; // Frames averaged after settling for a rung's saving
+	static constexpr int MaxUpFrames = 960; // A restore that did not hold doubles the wait, up to this. Also the wait
+	                                        // before re-measuring a rung predicted not to fit (with the cost under margin)
+
+private:
+	void Change(int rung, bool dropped);
+	// Mean of the last MeasureFrames costs since the last change
+	float RecentCost() const;
+
+	bool m_Dropped[RungCount] = {};
+	float m_Saving[RungCount] = {};
+	float m_AverageCost = 0.0f;
+	bool m_CostValid = false;
+	float m_Recent[MeasureFrames] = {}; // Ring of the newest costs since the last change, for the savings
+	int m_RecentCount = 0;
+	int m_OverFrames = 0;
+	int m_UnderFrames = 0;
+	int m_SettleFrames = 0;
+	int m_UpFrames = UpFrames; // Current wait before restoring
+	int m_SinceUp = -1; // Frames since the last restore (-1 = it held)
+
+	// Saving of the rung just changed: mean cost before the change, measured once MeasureFrames frames are averaged
+	int m_MeasureRung = -1;
+	bool m_MeasureDropped = false;
+	float m_CostBefore = 0.0f;
+	int m_MeasureFrames = 0;
+};
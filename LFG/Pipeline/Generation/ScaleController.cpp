@@ -0,0 +1,101 @@
+#include "ScaleController.h"
+
+#include <cmath>
+#include <algorithm>
+
+float ScaleController::StepScale(float maxScale, int step)
+{
+	return maxScale * std::pow(StepRatio, (float)step);
+}
+
+int ScaleController::StepCount(float maxScale)
+{
+	int count = 1;
+	while (count < MaxSteps && maxScale * std::pow(StepRatio, (float)count) >= MinScale) ++count;
+	return count;
+}
+
+void ScaleController::Reset(float maxScale)
+{
+	m_MaxScale = std::clamp(maxScale, 0.1f, 1.0f);
+	m_StepCount = StepCount(m_MaxScale);
+	m_Step = 0;
+	m_CostValid = false;
+	m_OverFrames = 0;
+	m_UnderFrames = 0;
+	m_SettleFrames = SettleFrames; // First frames allocate and compile, not representative
+	m_UpFrames = UpFrames;
+	m_SinceUp = -1;
+}
+
+float ScaleController::Predict(int step) const
+{
+	const float ratio = StepScale(m_MaxScale, step) / GetScale();
+	return m_AverageCost * ratio * ratio;
+}
+
+void ScaleController::SetStep(int step)
+{
+	// The average carries over scaled by the area, it is replaced once the new step is measured
+	m_AverageCost = Predict(step);
+	m_Step = step;
+	m_OverFrames = 0;
+	m_UnderFrames = 0;
+	m_SettleFrames = SettleFrames;
+}
+
+bool ScaleController::Update(float costMs, float budgetMs)
+{
+	if (budgetMs <= 0.0f || costMs < 0.0f) return false;
+
+	// A step up that held long enough: the next one only waits the normal time again
+	if (m_SinceUp >= 0 && ++m_SinceUp > MaxUpFrames)
+	{
+		m_SinceUp = -1;
+		m_UpFrames = UpFrames;
+	}
+
+	if (m_SettleFrames > 0)
+	{
+		--m_SettleFrames;
+		return false;
+	}
+
+	m_AverageCost = m_CostValid ? m_AverageCost + (costMs - m_AverageCost) * CostSmoothing : costMs;
+	m_CostValid = true;
+
+	if (m_AverageCost > budgetMs)
+	{
+		m_UnderFrames = 0;
+		if (++m_OverFrames >= DownFrames && m_Step < m_StepCount - 1)
+		{
+			// Straight to the first step predicted to fit, not one step per DownFrames
+			int step = m_Step + 1;
+			while (step < m_StepCount - 1 && Predict(step) > budgetMs) ++step;
+
+			// Stepped up and could not hold it: wait longer before the next try
+			if (m_SinceUp >= 0 && m_SinceUp < m_UpFrames) m_UpFrames = std::min(m_UpFrames * 2, MaxUpFrames);
+			m_SinceUp = -1;
+
+			SetStep(step);
+			return true;
+		}
+		return false;
+	}
+
+	m_OverFrames = 0;
+	if (m_Step > 0 && Predict(m_Step - 1) <= budgetMs * UpMargin)
+	{
+		if (++m_UnderFrames >= m_UpFrames)
+		{
+			SetStep(m_Step - 1);
+			m_SinceUp = 0;
+			return true;
+		}
+	}
+	else
+	{
+		m_UnderFrames = 0;
+	}
+	return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+// [Dynamic Resolution] Render Scale from the measured generation cost: the flow and warp resolution steps down
+// when the GPU time per real frame (analysis plus every generated frame) stays over the budget, and back up once
+// the next step is predicted to fit with room to spare. Steps are quantized (each one ~71% of the area above it)
+// so the textures of every step can be kept, and the hysteresis keeps it from flipping between two of them.
+// Plain CPU code (no D3D), fed by FrameGeneration's GPU timestamps or by recorded cost traces.
+class ScaleController
+{
+public:
+	ScaleController() = default;
+	~ScaleController() = default;
+
+	// 'maxScale' (the user's Render Scale) is step 0, the steps below it go down to MinScale
+	void Reset(float maxScale);
+	// One real frame's GPU cost, true when the step changed
+	bool Update(float costMs, float budgetMs);
+
+	float GetScale() const { return StepScale(m_MaxScale, m_Step); }
+	int GetStep() const { return m_Step; }
+	int GetStepCount() const { return m_StepCount; }
+	float GetMaxScale() const { return m_MaxScale; }
+	// Smoothed cost of the current step (ms), 0 until measured
+	float GetAverageCost() const { return m_CostValid ? m_AverageCost : 0.0f; }
+
+	static float StepScale(float maxScale, int step);
+	static int StepCount(float maxScale);
+
+	static constexpr float StepRatio = 0.8409f; // 2^-1/4 per step, two steps halve the area
+	static constexpr float MinScale = 0.33f; // Lowest preset (Performance)
+	static constexpr int MaxSteps = 8;
+	static constexpr float CostSmoothing = 0.2f; // Running average weight of the newest frame
+	static constexpr int DownFrames = 6; // Consecutive frames over budget before stepping down
+	static constexpr int UpFrames = 45; // Consecutive frames the next step up is predicted to fit
+	static constexpr float UpMargin = 0.85f; // ... under this share of the budget
+	static constexpr int SettleFrames = 8; // Frames ignored after a change (timestamps lag, caches warm up)
+	static constexpr int MaxUpFrames = 720; // A step up that did not hold doubles the wait, up to this
+
+private:
+	void SetStep(int step);
+	// Cost at 'step' from the current average, proportional to the area
+	float Predict(int step) const;
+
+	float m_MaxScale = 1.0f;
+	int m_Step = 0;
+	int m_StepCount = 1;
+	float m_AverageCost = 0.0f;
+	bool m_CostValid = false;
+	int m_OverFrames = 0;
+	int m_UnderFrames = 0;
+	int m_SettleFrames = 0;
+	int m_UpFrames = UpFrames; // Current wait before stepping up
+	int m_SinceUp = -1; // Frames since the last step up (-1 = it held)
+};
@@ -1,318 +1,538 @@
-#include "FrameInterpolation.h"
-#include "../Shaders/Shader.h"
-#include <Debug/Debug.h>
-#include <Pipeline/Shaders/EmbeddedShaders.h>
-#include <cmath>
-
-// Helper (Duplicated from OpticalFlow, ideally move to Utils)
-static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
-	if (!tex) return;
-	dev->CreateShaderResourceView(tex, nullptr, ppSRV);
-}
-
-static void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
-	if (!tex) return;
-	dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
-}
-
-bool FrameInterpolation::Initialize(ID3D11Device* device, int width, int height)
-{
-	// 1. Load Shaders
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_HUDMask, "CSMain", &m_csHUDMask))
-	{
-		Debug::Error("Failed to load HUDMask Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Interpolate, "CSMain", &m_csInterpolate))
-	{
-		Debug::Error("Failed to load Interpolate Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_DebugView, "CSMain", &m_csDebugView))
-	{
-		Debug::Error("Failed to load DebugView Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_SplitScreen, "main", &m_csSplitScreen))
-	{
-		Debug::Error("Failed to load SplitScreen Shader");
-		return false;
-	}
-    
-    // [Processing Sub-systems]
-    if (!m_Sharpening.Initialize(device))
-    {
-        Debug::Error("Failed to initialize Sharpening system");
-        return false;
-    }
-
-    if (!m_EdgeDetection.Initialize(device, width, height))
-    {
-        Debug::Error("Failed to initialize Edge Detection system");
-        // Non-fatal?
-    }
-
-	// 2. Create HUD Mask Texture (R8_UNORM)
-	D3D11_TEXTURE2D_DESC desc = {};
-	desc.Width = width;
-	desc.Height = height;
-	desc.MipLevels = 1;
-	desc.ArraySize = 1;
-	desc.Format = DXGI_FORMAT_R8_UNORM; // Single channel mask
-	desc.SampleDesc.Count = 1;
-	desc.Usage = D3D11_USAGE_DEFAULT;
-	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	
-	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexHUDMask)))
-	{
-		Debug::Error("Failed to create HUD Mask Texture");
-		return false;
-	}
-
-	// [RCAS] Sharpened Temp Texture (RGBA8/RGBA16F)
-	// Must match the Output format of the Swapchain/Generator (Usually RGBA8 for swapchain)
-	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; 
-	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexSharpened)))
-	{
-		Debug::Error("Failed to create RCAS Temp Texture");
-		return false;
-	}
-
-	// 3. Create Constant Buffers
-	{
-		D3D11_BUFFER_DESC cbDesc = {};
-		cbDesc.Usage = D3D11_USAGE_DEFAULT;
-		cbDesc.ByteWidth = sizeof(CBHUD);
-		cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-		device->CreateBuffer(&cbDesc, nullptr, &m_cbHUD);
-
-		cbDesc.ByteWidth = sizeof(CBDebug);
-		device->CreateBuffer(&cbDesc, nullptr, &m_cbDebug);
-		
-		cbDesc.ByteWidth = sizeof(CBFactor);
-		device->CreateBuffer(&cbDesc, nullptr, &m_cbFactor);
-
-		cbDesc.ByteWidth = sizeof(CBSplit);
-		device->CreateBuffer(&cbDesc, nullptr, &m_cbSplit);
-	}
-
-	Debug::Info("FrameInterpolation system initialized.");
-	return true;
-}
-
-// Update Dispatch Signature
-void FrameInterpolation::Dispatch(ID3D11DeviceContext* context, 
-	ID3D11Texture2D* texCurrent, 
-	ID3D11Texture2D* texPrev, 
-	ID3D11Texture2D* texMotion, 
-	ID3D11Texture2D* texGenerated,
-	ID3D11ShaderResourceView* statsSRV, // [Scene Change]
-	float hudThreshold,
-	int debugMode,
-	float motionScale,
-	float factor,
-	int sceneThreshold,
-	float rcasStrength,
-	float ghostingStrength,
-	bool enableEdgeProtection)
-{
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	D3D11_TEXTURE2D_DESC desc;
-	texCurrent->GetDesc(&desc);
-	UINT groupsX = (UINT)ceil(desc.Width / 8.0f); // 8x8 groups for most shaders
-	UINT groupsY = (UINT)ceil(desc.Height / 8.0f);
-
-	// Update CBuffers
-	CBHUD cbHudData = { hudThreshold, enableEdgeProtection ? 1 : 0, {0,0} };
-	context->UpdateSubresource(m_cbHUD.Get(), 0, nullptr, &cbHudData, 0, 0);
-
-	CBDebug cbDebugData = { debugMode, motionScale, {0,0} };
-	context->UpdateSubresource(m_cbDebug.Get(), 0, nullptr, &cbDebugData, 0, 0);
-	
-	CBFactor cbFactorData = { factor, sceneThreshold, ghostingStrength, 0.0f };
-	context->UpdateSubresource(m_cbFactor.Get(), 0, nullptr, &cbFactorData, 0, 0);
-
-	// ---------------------------------------------------------
-	// Pass 0: Edge Detection (If Enabled)
-	// ---------------------------------------------------------
-	if (enableEdgeProtection)
-	{
-        m_EdgeDetection.Dispatch(context, texCurrent);
-	}
-
-	// ---------------------------------------------------------
-	// Pass 1: HUD Mask Generatation
-	// ---------------------------------------------------------
-	{
-		ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvEdge; 
-		ComPtr<ID3D11UnorderedAccessView> uavMask;
-
-		CreateSRV(dev, texCurrent, &srvCurr);
-		CreateSRV(dev, texPrev, &srvPrev);
-		CreateUAV(dev, m_TexHUDMask.Get(), &uavMask);
-        
-		if (enableEdgeProtection) CreateSRV(dev, m_EdgeDetection.GetOutputTexture(), &srvEdge); 
-
-		context->CSSetShader(m_csHUDMask.Get(), nullptr, 0);
-		ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), srvEdge.Get() }; 
-		context->CSSetShaderResources(0, 3, srvs); 
-		context->CSSetUnorderedAccessViews(0, 1, uavMask.GetAddressOf(), nullptr);
-		context->CSSetConstantBuffers(0, 1, m_cbHUD.GetAddressOf());
-
-		context->Dispatch(groupsX, groupsY, 1);
-		
-		// Unbind
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		context->CSSetShaderResources(0, 3, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	}
-
-	// ---------------------------------------------------------
-	// Pass 2: Main Interpolation
-	// ---------------------------------------------------------
-	if (debugMode > 0)
-	{
-		// DEBUG VIEW
-		ComPtr<ID3D11ShaderResourceView> srvMotion, srvMask;
-		ComPtr<ID3D11UnorderedAccessView> uavOut;
-
-		CreateSRV(dev, texMotion, &srvMotion);
-		CreateSRV(dev, m_TexHUDMask.Get(), &srvMask);
-		CreateUAV(dev, texGenerated, &uavOut);
-
-		context->CSSetShader(m_csDebugView.Get(), nullptr, 0);
-		ID3D11ShaderResourceView* srvs[] = { srvMotion.Get(), srvMask.Get() };
-		context->CSSetShaderResources(0, 2, srvs);
-		context->CSSetUnorderedAccessViews(0, 1, uavOut.GetAddressOf(), nullptr);
-		context->CSSetConstantBuffers(0, 1, m_cbDebug.GetAddressOf());
-
-		context->Dispatch(groupsX, groupsY, 1);
-
-		// Unbind
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		ID3D11Buffer* nullCB = nullptr;
-		context->CSSetShaderResources(0, 2, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-		context->CSSetConstantBuffers(0, 1, &nullCB);
-	}
-	else
-	{
-		// STANDARD INTERPOLATION
-		bool useRCAS = (rcasStrength > 0.0f) && m_TexSharpened;
-		
-		ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvMotion, srvMask;
-		ComPtr<ID3D11UnorderedAccessView> uavGen;
-		
-		CreateSRV(dev, texCurrent, &srvCurr);
-		CreateSRV(dev, texPrev, &srvPrev);
-		CreateSRV(dev, texMotion, &srvMotion);
-		CreateSRV(dev, m_TexHUDMask.Get(), &srvMask);
-		
-		// If RCAS is ON, we write to the TEMP buffer first.
-		// If RCAS is OFF, we write directly to the OUTPUT buffer.
-		if (useRCAS) {
-			// Debug::Info("Dispatching Interpolation to Temp Buffer (RCAS Active: %.2f)", rcasStrength); 
-			CreateUAV(dev, m_TexSharpened.Get(), &uavGen);
-		} else {
-			// Debug::Info("Dispatching Interpolation to Final Buffer (RCAS Off: %.2f)", rcasStrength);
-			CreateUAV(dev, texGenerated, &uavGen);
-		}
-
-		context->CSSetShader(m_csInterpolate.Get(), nullptr, 0);
-		ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), srvMotion.Get(), srvMask.Get(), statsSRV };
-		context->CSSetShaderResources(0, 5, srvs);
-		context->CSSetUnorderedAccessViews(0, 1, uavGen.GetAddressOf(), nullptr);
-		context->CSSetConstantBuffers(0, 1, m_cbFactor.GetAddressOf()); // Bind Factor
-		
-		// Samplers...
-		D3D11_SAMPLER_DESC sampDesc = {};
-		sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-		sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-		sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-		sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-		ComPtr<ID3D11SamplerState> sampler;
-		dev->CreateSamplerState(&sampDesc, &sampler);
-		context->CSSetSamplers(0, 1, sampler.GetAddressOf());
-
-		context->Dispatch(groupsX, groupsY, 1);
-
-		// Unbind Interpolation
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		context->CSSetShaderResources(0, 5, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-		context->CSSetSamplers(0, 0, nullptr);
-		
-		// [RCAS PASS]
-		if (useRCAS)
-		{
-            m_Sharpening.Dispatch(context, m_TexSharpened.Get(), texGenerated, rcasStrength);
-		}
-	}
-	
-	dev->Release();
-}
-
-void FrameInterpolation::DispatchSplitScreen(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* texGen, 
-		ID3D11Texture2D* texReal, 
-		ID3D11Texture2D* output, 
-		float splitPos)
-{
-	if (!m_csSplitScreen) return;
-
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	D3D11_TEXTURE2D_DESC desc;
-	texGen->GetDesc(&desc);
-	UINT groupsX = (UINT)ceil(desc.Width / 16.0f);
-	UINT groupsY = (UINT)ceil(desc.Height / 16.0f);
-
-	// Update CB
-	CBSplit cbData = { splitPos, {0,0,0} };
-	context->UpdateSubresource(m_cbSplit.Get(), 0, nullptr, &cbData, 0, 0);
-
-	ComPtr<ID3D11ShaderResourceView> srvGen, srvReal;
-	ComPtr<ID3D11UnorderedAccessView> uavOut;
-
-	CreateSRV(dev, texGen, &srvGen);
-	CreateSRV(dev, texReal, &srvReal);
-	CreateUAV(dev, output, &uavOut);
-
-	context->CSSetShader(m_csSplitScreen.Get(), nullptr, 0);
-	ID3D11ShaderResourceView* srvs[] = { srvGen.Get(), srvReal.Get() };
-	context->CSSetShaderResources(0, 2, srvs);
-	context->CSSetUnorderedAccessViews(0, 1, uavOut.GetAddressOf(), nullptr);
-	context->CSSetConstantBuffers(0, 1, m_cbSplit.GetAddressOf());
-
-	context->Dispatch(groupsX, groupsY, 1);
-
-	// Unbind
-	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
-	ID3D11UnorderedAccessView* nullUAV = nullptr;
-	ID3D11Buffer* nullCB = nullptr;
-
-	context->CSSetShaderResources(0, 2, nullSRVs);
-	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	context->CSSetConstantBuffers(0, 1, &nullCB);
-
-	dev->Release();
-}
-
-void FrameInterpolation::DispatchRCAS(ID3D11DeviceContext* context, 
-    ID3D11Texture2D* input, 
-    ID3D11Texture2D* output, 
-    float strength)
-{
-    m_Sharpening.Dispatch(context, input, output, strength);
-}
-
-
+#include "FrameInterpolation.h"
+#include "../Processing/LumaPyramid.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+#include <Pipeline/Shaders/EmbeddedShaders.h>
+#include <cmath>
+
+// Helper (Duplicated from OpticalFlow, ideally move to Utils)
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+	if (!tex) return;
+	dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+static void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
+	if (!tex) return;
+	dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
+}
+
+bool FrameInterpolation::Initialize(ID3D11Device* device, int width, int height)
+{
+	m_MaskValid = false;
+
+	// 1. Load Shaders
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_HUDMask, "CSMain", &m_csHUDMask))
+	{
+		Debug::Error("Failed to load HUDMask Shader");
+		return false;
+	}
+
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Interpolate, "CSMain", &m_csInterpolate))
+	{
+		Debug::Error("Failed to load Interpolate Shader");
+		return false;
+	}
+
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Extrapolate, "CSMain", &m_csExtrapolate))
+	{
+		Debug::Error("Failed to load Extrapolate Shader");
+		return false;
+	}
+
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_DebugView, "CSMain", &m_csDebugView))
+	{
+		Debug::Error("Failed to load DebugView Shader");
+		return false;
+	}
+
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_SplitScreen, "main", &m_csSplitScreen))
+	{
+		Debug::Error("Failed to load SplitScreen Shader");
+		return false;
+	}
+
+	// [Forward Warp] Optional, synthesis falls back to the backward lookup
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_MotionSplat, "CSMain", &m_csMotionSplat) ||
+		!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_MotionResolve, "CSMain", &m_csMotionResolve))
+	{
+		Debug::Error("Failed to load Forward Warp Shaders");
+		m_csMotionSplat.Reset();
+		m_csMotionResolve.Reset();
+	}
+
+	// [Tile Skip] Optional, synthesis falls back to the full frame
+	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Interpolate, "CSTiles", &m_csInterpolateTiles) ||
+		!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Extrapolate, "CSTiles", &m_csExtrapolateTiles))
+	{
+		Debug::Error("Failed to load Tile Synthesis Shaders");
+		m_csInterpolateTiles.Reset();
+		m_csExtrapolateTiles.Reset();
+	}
+    
+    // [Processing Sub-systems]
+    if (!m_Sharpening.Initialize(device))
+    {
+        Debug::Error("Failed to initialize Sharpening system");
+        return false;
+    }
+
+    if (!m_EdgeDetection.Initialize(device, width, height))
+    {
+        Debug::Error("Failed to initialize Edge Detection system");
+        // Non-fatal?
+    }
+
+    if (!m_TileClassifier.Initialize(device))
+    {
+        Debug::Error("Failed to initialize Tile Classifier");
+        // Non-fatal, every tile is synthesized
+    }
+
+	// 2. Create HUD Mask Texture (R8_UNORM)
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = width;
+	desc.Height = height;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8_UNORM; // Single channel mask
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	
+	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexHUDMask)))
+	{
+		Debug::Error("Failed to create HUD Mask Texture");
+		return false;
+	}
+
+	// [RCAS] Sharpened Temp Texture (RGBA8/RGBA16F)
+	// Must match the Output format of the Swapchain/Generator (Usually RGBA8 for swapchain)
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; 
+	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexSharpened)))
+	{
+		Debug::Error("Failed to create RCAS Temp Texture");
+		return false;
+	}
+
+	// 3. Create Constant Buffers
+	{
+		D3D11_BUFFER_DESC cbDesc = {};
+		cbDesc.Usage = D3D11_USAGE_DEFAULT;
+		cbDesc.ByteWidth = sizeof(CBHUD);
+		cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		device->CreateBuffer(&cbDesc, nullptr, &m_cbHUD);
+
+		cbDesc.ByteWidth = sizeof(CBDebug);
+		device->CreateBuffer(&cbDesc, nullptr, &m_cbDebug);
+		
+		cbDesc.ByteWidth = sizeof(CBFactor);
+		device->CreateBuffer(&cbDesc, nullptr, &m_cbFactor);
+
+		cbDesc.ByteWidth = sizeof(CBSplit);
+		device->CreateBuffer(&cbDesc, nullptr, &m_cbSplit);
+
+		cbDesc.ByteWidth = sizeof(CBWarp);
+		device->CreateBuffer(&cbDesc, nullptr, &m_cbWarp);
+	}
+
+	Debug::Info("FrameInterpolation system initialized.");
+	return true;
+}
+
+// Update Dispatch Signature
+void FrameInterpolation::Dispatch(ID3D11DeviceContext* context, 
+	ID3D11Texture2D* texCurrent, 
+	ID3D11Texture2D* texPrev, 
+	ID3D11Texture2D* texMotion, 
+	ID3D11Texture2D* texGenerated,
+	ID3D11ShaderResourceView* statsSRV, // [Scene Change]
+	float hudThreshold,
+	int debugMode,
+	float motionScale,
+	float factor,
+	int sceneThreshold,
+	float rcasStrength,
+	float ghostingStrength,
+	bool enableEdgeProtection,
+	bool extrapolate,
+	int motionBlockSize,
+	ID3D11Texture2D* texVisibility,
+	int visibilityScale,
+	bool forwardWarp,
+	const LumaPyramid* luma,
+	bool skipStaticTiles)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	texCurrent->GetDesc(&desc);
+	UINT groupsX = (UINT)ceil(desc.Width / 8.0f); // 8x8 groups for most shaders
+	UINT groupsY = (UINT)ceil(desc.Height / 8.0f);
+
+	// [Native Synthesis] The pyramid is at the flow resolution, which may be below texCurrent's:
+	// motion, visibility and edges are then sampled at flow resolution while the warp runs at texCurrent's
+	if (luma && !luma->GetCurrent()) luma = nullptr;
+	float flowWidth = luma ? (float)luma->GetWidth() : (float)desc.Width;
+	float flowHeight = luma ? (float)luma->GetHeight() : (float)desc.Height;
+	float flowScaleX = desc.Width / flowWidth;
+	float flowScaleY = desc.Height / flowHeight;
+
+	// [Edge Detect] Sobel runs on the shared luma, without it there is nothing to protect with
+	enableEdgeProtection = enableEdgeProtection && luma;
+
+	// Update CBuffers
+	CBHUD cbHudData = { hudThreshold, enableEdgeProtection ? 1 : 0, { 1.0f / flowScaleX, 1.0f / flowScaleY } };
+	context->UpdateSubresource(m_cbHUD.Get(), 0, nullptr, &cbHudData, 0, 0);
+
+	if (motionBlockSize < 1) motionBlockSize = 1;
+
+	CBDebug cbDebugData = { debugMode, motionScale, motionBlockSize, flowScaleX };
+	context->UpdateSubresource(m_cbDebug.Get(), 0, nullptr, &cbDebugData, 0, 0);
+	
+	// [Occlusion] Interpolation only, extrapolation has no previous frame to fall back on
+	bool useVisibility = texVisibility && !extrapolate;
+	if (visibilityScale < 1) visibilityScale = 1;
+
+	// [Forward Warp] Vectors that belong to each pixel at time 'factor' instead of at the current frame.
+	// The projected field is per pixel at flow resolution, synthesis samples it like any other motion.
+	if (forwardWarp && !extrapolate && debugMode == 0 && luma && m_csMotionSplat && EnsureWarpTextures(dev, luma->GetWidth(), luma->GetHeight()))
+	{
+		ProjectMotion(context, luma->GetCurrent(), luma->GetPrevious(), texMotion, useVisibility ? texVisibility : nullptr, factor, motionBlockSize, visibilityScale);
+		texMotion = m_TexWarpMotion.Get();
+		motionBlockSize = 1;
+	}
+
+	CBFactor cbFactorData = { factor, sceneThreshold, ghostingStrength, (float)motionBlockSize,
+		useVisibility ? 1 : 0, (float)visibilityScale, { flowScaleX, flowScaleY } };
+	context->UpdateSubresource(m_cbFactor.Get(), 0, nullptr, &cbFactorData, 0, 0);
+
+	// [Frame Products] Edges and HUD mask only depend on the real frames: the generated frames between two
+	// real ones share them. Without the pyramid there is no frame index to key on, so they are recomputed.
+	bool reuseMask = luma && m_MaskValid && m_MaskFrame == luma->GetFrameIndex() && m_MaskSource == texCurrent &&
+		m_MaskThreshold == hudThreshold && m_MaskEdges == enableEdgeProtection && m_MaskFlowWidth == luma->GetWidth();
+	m_MaskValid = luma != nullptr;
+	if (luma)
+	{
+		m_MaskFrame = luma->GetFrameIndex();
+		m_MaskSource = texCurrent;
+		m_MaskThreshold = hudThreshold;
+		m_MaskEdges = enableEdgeProtection;
+		m_MaskFlowWidth = luma->GetWidth();
+	}
+
+	// ---------------------------------------------------------
+	// Pass 0: Edge Detection (If Enabled)
+	// ---------------------------------------------------------
+	if (enableEdgeProtection && !reuseMask)
+	{
+        m_EdgeDetection.Dispatch(context, luma->GetCurrent());
+	}
+
+	// ---------------------------------------------------------
+	// Pass 1: HUD Mask Generatation
+	// ---------------------------------------------------------
+	if (!reuseMask)
+	{
+		ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvEdge; 
+		ComPtr<ID3D11UnorderedAccessView> uavMask;
+
+		CreateSRV(dev, texCurrent, &srvCurr);
+		CreateSRV(dev, texPrev, &srvPrev);
+		CreateUAV(dev, m_TexHUDMask.Get(), &uavMask);
+        
+		if (enableEdgeProtection) CreateSRV(dev, m_EdgeDetection.GetOutputTexture(), &srvEdge); 
+
+		context->CSSetShader(m_csHUDMask.Get(), nullptr, 0);
+		ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), srvEdge.Get() }; 
+		context->CSSetShaderResources(0, 3, srvs); 
+		context->CSSetUnorderedAccessViews(0, 1, uavMask.GetAddressOf(), nullptr);
+		context->CSSetConstantBuffers(0, 1, m_cbHUD.GetAddressOf());
+
+		context->Dispatch(groupsX, groupsY, 1);
+		
+		// Unbind
+		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+		ID3D11UnorderedAccessView* nullUAV = nullptr;
+		context->CSSetShaderResources(0, 3, nullSRVs);
+		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	}
+
+	// ---------------------------------------------------------
+	// Pass 2: Main Interpolation
+	// ---------------------------------------------------------
+	if (debugMode > 0)
+	{
+		// DEBUG VIEW
+		ComPtr<ID3D11ShaderResourceView> srvMotion, srvMask;
+		ComPtr<ID3D11UnorderedAccessView> uavOut;
+
+		CreateSRV(dev, texMotion, &srvMotion);
+		CreateSRV(dev, m_TexHUDMask.Get(), &srvMask);
+		CreateUAV(dev, texGenerated, &uavOut);
+
+		context->CSSetShader(m_csDebugView.Get(), nullptr, 0);
+		ID3D11ShaderResourceView* srvs[] = { srvMotion.Get(), srvMask.Get() };
+		context->CSSetShaderResources(0, 2, srvs);
+		context->CSSetUnorderedAccessViews(0, 1, uavOut.GetAddressOf(), nullptr);
+		context->CSSetConstantBuffers(0, 1, m_cbDebug.GetAddressOf());
+
+		context->Dispatch(groupsX, groupsY, 1);
+
+		// Unbind
+		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+		ID3D11UnorderedAccessView* nullUAV = nullptr;
+		ID3D11Buffer* nullCB = nullptr;
+		context->CSSetShaderResources(0, 2, nullSRVs);
+		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+		context->CSSetConstantBuffers(0, 1, &nullCB);
+	}
+	else
+	{
+		// STANDARD INTERPOLATION
+		bool useRCAS = (rcasStrength > 0.0f) && m_TexSharpened;
+		
+		ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvMotion, srvMask, srvVisibility;
+		ComPtr<ID3D11UnorderedAccessView> uavGen;
+		
+		CreateSRV(dev, texCurrent, &srvCurr);
+		CreateSRV(dev, texPrev, &srvPrev);
+		CreateSRV(dev, texMotion, &srvMotion);
+		CreateSRV(dev, m_TexHUDMask.Get(), &srvMask);
+		if (useVisibility) CreateSRV(dev, texVisibility, &srvVisibility);
+		
+		// If RCAS is ON, we write to the TEMP buffer first.
+		// If RCAS is OFF, we write directly to the OUTPUT buffer.
+		if (useRCAS) {
+			// Debug::Info("Dispatching Interpolation to Temp Buffer (RCAS Active: %.2f)", rcasStrength); 
+			CreateUAV(dev, m_TexSharpened.Get(), &uavGen);
+		} else {
+			// Debug::Info("Dispatching Interpolation to Final Buffer (RCAS Off: %.2f)", rcasStrength);
+			CreateUAV(dev, texGenerated, &uavGen);
+		}
+
+		// [Tile Skip] Classified on the final field (after the forward warp), so the tiles a moving object
+		// is projected into are dynamic even where neither real frame shows it
+		bool extrapolateShader = extrapolate && m_csExtrapolate;
+		ID3D11ComputeShader* tileShader = extrapolateShader ? m_csExtrapolateTiles.Get() : m_csInterpolateTiles.Get();
+		bool useTiles = skipStaticTiles && tileShader && m_TileClassifier.Classify(context, texCurrent, texPrev, texMotion,
+			m_TexHUDMask.Get(), statsSRV, (float)motionBlockSize, flowScaleX, flowScaleY, sceneThreshold);
+
+		// [Extrapolation] CS_Extrapolate shares the CS_Interpolate bindings, only the warp differs
+		ID3D11ComputeShader* synthesisShader = extrapolateShader ? m_csExtrapolate.Get() : m_csInterpolate.Get();
+		context->CSSetShader(useTiles ? tileShader : synthesisShader, nullptr, 0);
+		ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), srvMotion.Get(), srvMask.Get(), statsSRV, srvVisibility.Get(),
+			useTiles ? m_TileClassifier.GetTileListSRV() : nullptr };
+		context->CSSetShaderResources(0, 7, srvs);
+		context->CSSetUnorderedAccessViews(0, 1, uavGen.GetAddressOf(), nullptr);
+		context->CSSetConstantBuffers(0, 1, m_cbFactor.GetAddressOf()); // Bind Factor
+		
+		// Samplers...
+		D3D11_SAMPLER_DESC sampDesc = {};
+		sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+		sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+		sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+		sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+		ComPtr<ID3D11SamplerState> sampler;
+		dev->CreateSamplerState(&sampDesc, &sampler);
+		context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+		if (useTiles) m_TileClassifier.DispatchDynamic(context);
+		else context->Dispatch(groupsX, groupsY, 1);
+
+		// Unbind Interpolation
+		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+		ID3D11UnorderedAccessView* nullUAV = nullptr;
+		context->CSSetShaderResources(0, 7, nullSRVs);
+		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+		context->CSSetSamplers(0, 0, nullptr);
+
+		// [Tile Skip] Static tiles: the real frame as it is presented, sharpened here already.
+		// With RCAS the temp buffer gets it too, the dynamic tiles' RCAS reads across their borders.
+		if (useTiles)
+		{
+			m_TileClassifier.DispatchStatic(context, texCurrent, texGenerated, useRCAS ? m_TexSharpened.Get() : nullptr, useRCAS ? rcasStrength : 0.0f);
+		}
+		
+		// [RCAS PASS]
+		if (useRCAS)
+		{
+			if (useTiles)
+			{
+				m_Sharpening.DispatchTiles(context, m_TexSharpened.Get(), texGenerated, rcasStrength,
+					m_TileClassifier.GetTileListSRV(), m_TileClassifier.GetArgsBuffer(), TileClassifier::DynamicArgsOffset);
+			}
+			else
+			{
+				m_Sharpening.Dispatch(context, m_TexSharpened.Get(), texGenerated, rcasStrength);
+			}
+		}
+	}
+	
+	dev->Release();
+}
+
+bool FrameInterpolation::EnsureWarpTextures(ID3D11Device* device, int width, int height)
+{
+	if (m_TexWarpMotion)
+	{
+		D3D11_TEXTURE2D_DESC current;
+		m_TexWarpMotion->GetDesc(&current);
+		if ((int)current.Width == width && (int)current.Height == height) return true;
+	}
+
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = width;
+	desc.Height = height;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R32_UINT; // Packed claims
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+	m_TexWarpSplat.Reset();
+	m_TexWarpMotion.Reset();
+	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexWarpSplat)))
+	{
+		Debug::Error("Failed to create Forward Warp Splat Texture");
+		return false;
+	}
+
+	desc.Format = DXGI_FORMAT_R16G16_FLOAT;
+	if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexWarpMotion)))
+	{
+		Debug::Error("Failed to create Forward Warp Motion Texture");
+		m_TexWarpSplat.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FrameInterpolation::ProjectMotion(ID3D11DeviceContext* context,
+	ID3D11Texture2D* lumaCurrent,
+	ID3D11Texture2D* lumaPrev,
+	ID3D11Texture2D* texMotion,
+	ID3D11Texture2D* texVisibility,
+	float factor,
+	int motionBlockSize,
+	int visibilityScale)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	lumaCurrent->GetDesc(&desc);
+	UINT groupsX = (UINT)ceil(desc.Width / 8.0f);
+	UINT groupsY = (UINT)ceil(desc.Height / 8.0f);
+
+	CBWarp cbData = { factor, (float)motionBlockSize, texVisibility ? 1 : 0, (float)visibilityScale };
+	context->UpdateSubresource(m_cbWarp.Get(), 0, nullptr, &cbData, 0, 0);
+
+	ComPtr<ID3D11ShaderResourceView> srvMotion, srvCurr, srvPrev, srvVisibility, srvSplat;
+	ComPtr<ID3D11UnorderedAccessView> uavSplat, uavWarp;
+	CreateSRV(dev, texMotion, &srvMotion);
+	CreateSRV(dev, lumaCurrent, &srvCurr);
+	CreateSRV(dev, lumaPrev, &srvPrev);
+	CreateSRV(dev, texVisibility, &srvVisibility);
+	CreateSRV(dev, m_TexWarpSplat.Get(), &srvSplat);
+	CreateUAV(dev, m_TexWarpSplat.Get(), &uavSplat);
+	CreateUAV(dev, m_TexWarpMotion.Get(), &uavWarp);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	context->CSSetConstantBuffers(0, 1, m_cbWarp.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	// 1. Splat (Empty = 0xFFFFFFFF)
+	UINT clearVals[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+	context->ClearUnorderedAccessViewUint(uavSplat.Get(), clearVals);
+
+	context->CSSetShader(m_csMotionSplat.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* splatSRVs[] = { srvMotion.Get(), srvCurr.Get(), srvPrev.Get(), srvVisibility.Get() };
+	context->CSSetShaderResources(0, 4, splatSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, uavSplat.GetAddressOf(), nullptr);
+	context->Dispatch(groupsX, groupsY, 1);
+
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr };
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetShaderResources(0, 4, nullSRVs);
+
+	// 2. Resolve + hole filling
+	context->CSSetShader(m_csMotionResolve.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* resolveSRVs[] = { srvMotion.Get(), srvSplat.Get() };
+	context->CSSetShaderResources(0, 2, resolveSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, uavWarp.GetAddressOf(), nullptr);
+	context->Dispatch(groupsX, groupsY, 1);
+
+	// Unbind
+	context->CSSetShaderResources(0, 2, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetSamplers(0, 0, nullptr);
+}
+
+void FrameInterpolation::DispatchSplitScreen(ID3D11DeviceContext* context, 
+		ID3D11Texture2D* texGen, 
+		ID3D11Texture2D* texReal, 
+		ID3D11Texture2D* output, 
+		float splitPos)
+{
+	if (!m_csSplitScreen) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	texGen->GetDesc(&desc);
+	UINT groupsX = (UINT)ceil(desc.Width / 16.0f);
+	UINT groupsY = (UINT)ceil(desc.Height / 16.0f);
+
+	// Update CB
+	CBSplit cbData = { splitPos, {0,0,0} };
+	context->UpdateSubresource(m_cbSplit.Get(), 0, nullptr, &cbData, 0, 0);
+
+	ComPtr<ID3D11ShaderResourceView> srvGen, srvReal;
+	ComPtr<ID3D11UnorderedAccessView> uavOut;
+
+	CreateSRV(dev, texGen, &srvGen);
+	CreateSRV(dev, texReal, &srvReal);
+	CreateUAV(dev, output, &uavOut);
+
+	context->CSSetShader(m_csSplitScreen.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvGen.Get(), srvReal.Get() };
+	context->CSSetShaderResources(0, 2, srvs);
+	context->CSSetUnorderedAccessViews(0, 1, uavOut.GetAddressOf(), nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbSplit.GetAddressOf());
+
+	context->Dispatch(groupsX, groupsY, 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	ID3D11Buffer* nullCB = nullptr;
+
+	context->CSSetShaderResources(0, 2, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetConstantBuffers(0, 1, &nullCB);
+
+	dev->Release();
+}
+
+void FrameInterpolation::DispatchRCAS(ID3D11DeviceContext* context, 
+    ID3D11Texture2D* input, 
+    ID3D11Texture2D* output, 
+    float strength)
+{
+    m_Sharpening.Dispatch(context, input, output, strength);
+}
+
+
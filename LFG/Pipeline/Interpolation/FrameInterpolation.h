@@ -1,83 +1,132 @@
-#pragma once
-#include <d3d11.h>
-#include <wrl/client.h>
-#include "../Processing/Sharpening.h"
-#include "../Processing/EdgeDetection.h"
-
-using Microsoft::WRL::ComPtr;
-
-class FrameInterpolation
-{
-public:
-	FrameInterpolation() = default;
-	~FrameInterpolation() = default;
-
-	bool Initialize(ID3D11Device* device, int width, int height);
-	void Dispatch(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* texCurrent, 
-		ID3D11Texture2D* texPrev, 
-		ID3D11Texture2D* texMotion, 
-		ID3D11Texture2D* texGenerated,
-		ID3D11ShaderResourceView* statsSRV, // [Scene Change]
-		float hudThreshold,
-		int debugMode,
-		float motionScale,
-		float factor,
-		int sceneThreshold,
-		float rcasStrength,
-		float ghostingStrength,
-		bool enableEdgeProtection); // [Edge Detect]
-
-	void DispatchSplitScreen(ID3D11DeviceContext* context,
-		ID3D11Texture2D* texGen,
-		ID3D11Texture2D* texReal,
-		ID3D11Texture2D* output,
-		float splitPos);
-
-	void DispatchRCAS(ID3D11DeviceContext* context,
-		ID3D11Texture2D* input,
-		ID3D11Texture2D* output,
-		float strength);
-
-	ID3D11Texture2D* GetTempTexture() const { return m_TexSharpened.Get(); }
-
-private:
-	ComPtr<ID3D11ComputeShader> m_csHUDMask;
-	ComPtr<ID3D11ComputeShader> m_csInterpolate;
-	ComPtr<ID3D11ComputeShader> m_csDebugView;
-	ComPtr<ID3D11ComputeShader> m_csSplitScreen; // [Split Screen]
-	
-    // Sub-systems
-    Sharpening m_Sharpening;
-    EdgeDetection m_EdgeDetection;
-
-	// Resources
-	ComPtr<ID3D11Texture2D> m_TexHUDMask; // R8_UNORM
-	ComPtr<ID3D11Texture2D> m_TexSharpened; 
-	
-	ComPtr<ID3D11Buffer> m_cbHUD;
-	ComPtr<ID3D11Buffer> m_cbDebug;
-	ComPtr<ID3D11Buffer> m_cbFactor;
-	ComPtr<ID3D11Buffer> m_cbSplit; // [Split Screen]
-
-	struct CBDebug {
-		int Mode;
-		float Scale;
-		int Padding[2];
-	};
-	struct CBHUD {
-		float Threshold;
-		int UseEdgeDetect; // [Edge Detect]
-		float Padding[2];
-	};
-	struct CBFactor {
-		float Factor;
-		int SceneChangeThreshold;
-		float GhostingStrength;
-		float Padding;
-	};
-	struct CBSplit {
-		float SplitPos;
-		float Padding[3];
-	};
-};
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include "../Processing/Sharpening.h"
+#include "../Processing/EdgeDetection.h"
+#include "../Processing/TileClassifier.h"
+
+class LumaPyramid;
+
+using Microsoft::WRL::ComPtr;
+
+class FrameInterpolation
+{
+public:
+	FrameInterpolation() = default;
+	~FrameInterpolation() = default;
+
+	bool Initialize(ID3D11Device* device, int width, int height);
+	void Dispatch(ID3D11DeviceContext* context, 
+		ID3D11Texture2D* texCurrent, 
+		ID3D11Texture2D* texPrev, 
+		ID3D11Texture2D* texMotion, 
+		ID3D11Texture2D* texGenerated,
+		ID3D11ShaderResourceView* statsSRV, // [Scene Change]
+		float hudThreshold,
+		int debugMode,
+		float motionScale,
+		float factor,
+		int sceneThreshold,
+		float rcasStrength,
+		float ghostingStrength,
+		bool enableEdgeProtection, // [Edge Detect]
+		bool extrapolate = false, // [Extrapolation] Predict past texCurrent instead of blending texPrev/texCurrent
+		int motionBlockSize = 1, // [Block Motion] texMotion holds one vector per NxN block
+		ID3D11Texture2D* texVisibility = nullptr, // [Occlusion] RG visibility from OpticalFlow::GetVisibility
+		int visibilityScale = 1,
+		bool forwardWarp = false, // [Forward Warp] Splat texMotion to time 'factor' before sampling it
+		const LumaPyramid* luma = nullptr, // [Luma Pyramid] Analysis frames, edge protection and forward warp need it.
+		// [Native Synthesis] Its size is the flow resolution: texMotion / texVisibility at that size are warped onto texCurrent's
+		bool skipStaticTiles = false); // [Tile Skip] Warp / clamp / sharpen the dynamic tiles only, static tiles get the real frame
+
+	void DispatchSplitScreen(ID3D11DeviceContext* context,
+		ID3D11Texture2D* texGen,
+		ID3D11Texture2D* texReal,
+		ID3D11Texture2D* output,
+		float splitPos);
+
+	void DispatchRCAS(ID3D11DeviceContext* context,
+		ID3D11Texture2D* input,
+		ID3D11Texture2D* output,
+		float strength);
+
+	ID3D11Texture2D* GetTempTexture() const { return m_TexSharpened.Get(); }
+
+private:
+	// [Forward Warp] Projects texMotion to time 'factor' into m_TexWarpMotion (per pixel), ranking claims on luma
+	void ProjectMotion(ID3D11DeviceContext* context,
+		ID3D11Texture2D* lumaCurrent,
+		ID3D11Texture2D* lumaPrev,
+		ID3D11Texture2D* texMotion,
+		ID3D11Texture2D* texVisibility,
+		float factor,
+		int motionBlockSize,
+		int visibilityScale);
+	bool EnsureWarpTextures(ID3D11Device* device, int width, int height);
+
+	ComPtr<ID3D11ComputeShader> m_csHUDMask;
+	ComPtr<ID3D11ComputeShader> m_csInterpolate;
+	ComPtr<ID3D11ComputeShader> m_csExtrapolate; // [Extrapolation]
+	ComPtr<ID3D11ComputeShader> m_csInterpolateTiles; // [Tile Skip] Indirect over the dynamic tiles
+	ComPtr<ID3D11ComputeShader> m_csExtrapolateTiles;
+	ComPtr<ID3D11ComputeShader> m_csDebugView;
+	ComPtr<ID3D11ComputeShader> m_csSplitScreen; // [Split Screen]
+	ComPtr<ID3D11ComputeShader> m_csMotionSplat; // [Forward Warp]
+	ComPtr<ID3D11ComputeShader> m_csMotionResolve;
+	
+    // Sub-systems
+    Sharpening m_Sharpening;
+    EdgeDetection m_EdgeDetection;
+    TileClassifier m_TileClassifier;
+
+	// Resources
+	ComPtr<ID3D11Texture2D> m_TexHUDMask; // R8_UNORM
+	ComPtr<ID3D11Texture2D> m_TexSharpened; 
+	ComPtr<ID3D11Texture2D> m_TexWarpSplat; // [Forward Warp] R32_UINT claims, synthesis resolution
+	ComPtr<ID3D11Texture2D> m_TexWarpMotion; // [Forward Warp] R16G16_FLOAT motion at time 'factor'
+
+	// [Frame Products] What m_TexHUDMask (and the edge map) were last built from
+	UINT m_MaskFrame = 0;
+	ID3D11Texture2D* m_MaskSource = nullptr;
+	float m_MaskThreshold = 0.0f;
+	bool m_MaskEdges = false;
+	int m_MaskFlowWidth = 0;
+	bool m_MaskValid = false;
+	
+	ComPtr<ID3D11Buffer> m_cbHUD;
+	ComPtr<ID3D11Buffer> m_cbDebug;
+	ComPtr<ID3D11Buffer> m_cbFactor;
+	ComPtr<ID3D11Buffer> m_cbSplit; // [Split Screen]
+	ComPtr<ID3D11Buffer> m_cbWarp; // [Forward Warp]
+
+	struct CBDebug {
+		int Mode;
+		float Scale;
+		int MotionBlockSize;
+		float FlowScale;
+	};
+	struct CBHUD {
+		float Threshold;
+		int UseEdgeDetect; // [Edge Detect]
+		float EdgeScale[2]; // [Native Synthesis] Flow / output resolution
+	};
+	struct CBFactor {
+		float Factor;
+		int SceneChangeThreshold;
+		float GhostingStrength;
+		float MotionBlockSize;
+		int UseVisibility; // [Occlusion]
+		float VisibilityScale;
+		float FlowScale[2]; // [Native Synthesis] Output / flow resolution
+	};
+	struct CBWarp {
+		float Factor;
+		float MotionBlockSize;
+		int UseVisibility;
+		float VisibilityScale;
+	};
+	struct CBSplit {
+		float SplitPos;
+		float Padding[3];
+	};
+};
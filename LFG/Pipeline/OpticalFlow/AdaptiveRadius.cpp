@@ -0,0 +1,95 @@
+#include "AdaptiveRadius.h"
+#include "PyramidSchedule.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+AdaptiveRadius::Measurement AdaptiveRadius::Summarize(const uint32_t* readback)
+{
+	Measurement result;
+	if (!readback || readback[ReadbackTiles] == 0) return result;
+
+	uint64_t count = 0;
+	for (int i = 0; i < HistogramBins; ++i) count += readback[i];
+	if (count == 0) return result;
+
+	std::memcpy(&result.MaxLength, &readback[ReadbackMax], sizeof(float));
+
+	// Upper edge of the bin holding the percentile, the open ended last bin only knows the max
+	auto percentile = [&](uint64_t percent)
+	{
+		const uint64_t target = (count * percent + 99) / 100;
+		uint64_t sum = 0;
+		for (int bin = 0; bin < HistogramBins - 1; ++bin)
+		{
+			sum += readback[bin];
+			if (sum >= target) return std::min((float)(bin + 1), result.MaxLength);
+		}
+		return result.MaxLength;
+	};
+	result.P95Length = percentile(95);
+	result.P99Length = percentile(99);
+
+	result.Residual = readback[ReadbackResidual] / (ResidualScale * readback[ReadbackTiles]);
+	result.Valid = true;
+	return result;
+}
+
+void AdaptiveRadius::Update(const Measurement& measurement, int searchedRadius, int maxRadius)
+{
+	maxRadius = std::max(maxRadius, Pyramid::MinSearchRadius);
+	if (!measurement.Valid)
+	{
+		// Nothing to go by: the full reach until the motion is known again
+		m_Radius = maxRadius;
+		m_OpenFrames = OpenFrames;
+		m_ResidualValid = false;
+		m_Valid = true;
+		return;
+	}
+
+	int target = (int)std::ceil(measurement.P95Length * Margin) + Padding;
+
+	// Vectors at the edge of the window may have been cut short by it
+	if (measurement.P99Length >= searchedRadius - 1) target = std::max(target, 2 * searchedRadius);
+
+	// Residual spike: whatever moved is out of reach
+	if (m_ResidualValid && measurement.Residual > SpikeFloor && measurement.Residual > SpikeRatio * m_ResidualAverage)
+		m_OpenFrames = OpenFrames;
+	if (m_OpenFrames > 0)
+	{
+		--m_OpenFrames;
+		target = maxRadius;
+	}
+	target = std::clamp(target, Pyramid::MinSearchRadius, maxRadius);
+
+	// Grow at once, shrink slowly (a pause in the motion should not cost the next frame its reach)
+	if (!m_Valid || target >= m_Radius) m_Radius = target;
+	else m_Radius = std::max(target, m_Radius - ShrinkStep);
+	m_Valid = true;
+
+	m_ResidualAverage = m_ResidualValid ? m_ResidualAverage + (measurement.Residual - m_ResidualAverage) * ResidualSmoothing : measurement.Residual;
+	m_ResidualValid = true;
+}
+
+int AdaptiveRadius::GetRadius(int maxRadius) const
+{
+	return m_Valid ? std::min(m_Radius, maxRadius) : maxRadius;
+}
+
+void AdaptiveRadius::Reset()
+{
+	m_Radius = 0;
+	m_Valid = false;
+	m_OpenFrames = 0;
+	m_ResidualAverage = 0.0f;
+	m_ResidualValid = false;
+}
+
+int AdaptiveRadius::LevelsFor(int radius, int maxLevel, int minLevel)
+{
+	int level = maxLevel;
+	while (level > minLevel && (radius >> level) < Pyramid::MinSearchRadius) --level;
+	return level;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+// [Adaptive Radius] Next frame's search reach from the motion actually measured: a histogram of the final field's
+// vector lengths (max, 95th and 99th percentile) and its mean warp residual. The reach settles just above the observed
+// motion with a margin, grows at once when the vectors crowd its edge, and opens up to the user's Search Radius for
+// a few frames when the residual spikes (something moved that a narrow window cannot reach).
+// Plain CPU code shared by OpticalFlow (CS_MotionStats read back one frame late) and CPUOpticalFlow.
+// Lengths and radii are flow resolution pixels.
+class AdaptiveRadius
+{
+public:
+	struct Measurement
+	{
+		float MaxLength = 0.0f;
+		float P95Length = 0.0f;
+		float P99Length = 0.0f; // Saturation test (the max alone is one stray vector at the frame edge)
+		float Residual = 0.0f; // Mean abs luma difference, current vs motion compensated previous
+		bool Valid = false; // False: nothing measured (e.g. a cleared readback after a scene cut)
+	};
+
+	AdaptiveRadius() = default;
+	~AdaptiveRadius() = default;
+
+	// Readback layout of CS_MotionStats (ReadbackSize uints)
+	static Measurement Summarize(const uint32_t* readback);
+
+	// Feeds the frame that was searched with 'searchedRadius', 'maxRadius' is the user's Search Radius
+	void Update(const Measurement& measurement, int searchedRadius, int maxRadius);
+	// This frame's reach, never above maxRadius (the full reach until something was measured)
+	int GetRadius(int maxRadius) const;
+	// Per-tile bounds may narrow the coarsest search (not while opened up after a residual spike)
+	bool TileBounds() const { return m_Valid && m_OpenFrames == 0; }
+	void Reset();
+
+	// Coarsest level still worth searching for 'radius': a level whose share of the reach falls below
+	// Pyramid::MinSearchRadius adds nothing. Never below minLevel (the caller's end level), never above maxLevel.
+	static int LevelsFor(int radius, int maxLevel, int minLevel);
+
+	static constexpr int HistogramBins = 64; // One per pixel of vector length, the last one open ended
+	static constexpr int ReadbackMax = HistogramBins; // asuint of the longest vector
+	static constexpr int ReadbackResidual = HistogramBins + 1; // Sum of the tiles' mean residuals, ResidualScale fixed point
+	static constexpr int ReadbackTiles = HistogramBins + 2;
+	static constexpr int ReadbackSize = HistogramBins + 3;
+	static constexpr float ResidualScale = 4096.0f;
+
+	static constexpr float Margin = 1.25f; // Reach per pixel of observed motion
+	static constexpr int Padding = 2; // ... plus this much, so a static scene still searches +-2
+	static constexpr float SpikeRatio = 2.0f; // Residual over its running average that opens the reach
+	static constexpr float SpikeFloor = 0.02f; // Residuals below never count as a spike
+	static constexpr int OpenFrames = 8; // Frames at the full reach after a spike
+	static constexpr int ShrinkStep = 1; // Pixels the reach may lose per frame (it grows at once)
+	static constexpr float ResidualSmoothing = 0.1f; // Running average weight of the newest frame
+
+private:
+	int m_Radius = 0;
+	bool m_Valid = false;
+	int m_OpenFrames = 0;
+	float m_ResidualAverage = 0.0f;
+	bool m_ResidualValid = false;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+// Shared by the GPU (OpticalFlow) and CPU reference (CPUOpticalFlow) implementations
+enum class FlowAlgorithm {
+	BlockMatching = 0,
+	Farneback = 1,
+	DIS = 2,
+	RecursiveSearch = 3, // 3DRS (block recursive search)
+	Hybrid = 4 // [Hybrid Flow] BlockMatching, Farneback or DIS per 16x16 tile
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include "GlobalMotion.h"
+
+// Tuning constants of the optical flow stage.
+// Shared by the GPU (OpticalFlow) and CPU reference (CPUOpticalFlow) implementations, the ones a shader
+// hardcodes name its #define.
+namespace FlowTuning
+{
+	// [Temporal Warm-Start]
+	// Fraction of poorly predicted pixels below which the prediction replaces the coarse levels
+	constexpr float WarmStartTrustThreshold = 0.1f;
+	// Per-pixel luma abs diff above which a predicted pixel counts as poor
+	constexpr float WarmStartResidualTolerance = 0.033f;
+
+	// [Block Motion]
+	constexpr int BlockSearchDecimateFrom = 16; // Block size from which the SAD is taken on a checkerboard (half the fetches)
+	constexpr float BlockSearchVectorBias = 0.00033f; // CS_BlockSearch / CS_QuadtreeSearch VECTOR_BIAS
+
+	// [Cost Aggregation]
+	constexpr int CostAggregationTile = 16;
+	constexpr float CostAggregationVectorBias = 0.00033f; // CS_CostAggregation VECTOR_BIAS
+
+	// [Quadtree]
+	constexpr int QuadtreeRootSize = 32;
+	constexpr int QuadtreeLeafSize = 4; // Leaf field resolution
+	constexpr float QuadtreeVarianceThreshold = 0.1f; // CS_AdaptiveVariance scale, below: nodes stop at 16x16
+	constexpr float QuadtreeResidualThreshold = 0.013f; // Average luma SAD per pixel above which a node splits
+
+	// [Occlusion]
+	constexpr int VisibilityScale = 2; // One visibility texel per 2x2 pixels
+	constexpr float ConsistencyTolerance = 1.0f; // Forward/backward disagreement (pixels) still counted as visible
+	constexpr int OcclusionRepairRadius = 16; // Uncovered pixels take the slowest consistent vector up to this far
+
+	// [Flow Inversion]
+	constexpr int FlowInversionRefineRadius = 2; // Re-search window around the filled guess
+	constexpr float FlowInversionCostTolerance = 0.02f; // Avg 3x3 luma abs diff a claim may have
+	constexpr int FlowInversionHoleRadius = 16; // CS_FlowInvert HOLE_RADIUS
+
+	// [Guided Upsample]
+	constexpr float UpsampleRangeSigma = 0.1f; // Luma difference, see CS_Upsample
+
+	// [Global Motion]
+	constexpr int GlobalMotionResidualRadius = 2; // Search radius left at the seeded level
+	constexpr float GlobalMotionTrustRatio = 0.8f; // Fitted to this many samples the model replaces the coarser levels
+
+	inline bool TrustGlobalMotion(const GlobalMotion::Estimate& model)
+	{
+		return model.Type != GlobalMotion::Model::Translation && model.InlierRatio >= GlobalMotionTrustRatio;
+	}
+
+	// [Hybrid Flow]
+	constexpr int FlowTileSize = 16; // The variance grid's block, one group of every CSTiles entry
+	constexpr float HybridFlatVariance = 0.05f; // CS_AdaptiveVariance scale, below: nothing to search, Farneback
+	constexpr float HybridLowResidual = 0.004f; // Mean warp residual (luma) Farneback holds below
+	constexpr float HybridHighResidual = 0.008f; // ... and above which smooth motion goes to DIS
+	constexpr float HybridMaxSpread = 1.0f; // Vector spread (pixels) from which a tile is a motion boundary, BlockMatching
+}
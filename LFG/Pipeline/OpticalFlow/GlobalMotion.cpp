@@ -0,0 +1,333 @@
+#include "GlobalMotion.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+	constexpr int RansacIterations = 64; // Upper bound, a clear majority stops after a dozen
+	constexpr double RansacConfidence = 0.99;
+	constexpr int RansacScoreSamples = 256; // Hypotheses are scored on a strided subset, the refit uses every sample
+	constexpr int IrlsIterations = 3;
+	constexpr float HomographyGain = 0.05f; // Extra fraction of samples a homography has to explain to replace the affine model
+	constexpr float TukeyScale = 2.0f; // Biweight cutoff in inlier tolerances
+
+	// Gaussian elimination with partial pivoting, 'a' is n x n row major and destroyed, the result replaces 'b'
+	bool Solve(double* a, double* b, int n)
+	{
+		for (int col = 0; col < n; ++col)
+		{
+			int pivot = col;
+			for (int row = col + 1; row < n; ++row)
+			{
+				if (std::fabs(a[row * n + col]) > std::fabs(a[pivot * n + col])) pivot = row;
+			}
+			if (std::fabs(a[pivot * n + col]) < 1e-12) return false;
+
+			if (pivot != col)
+			{
+				for (int k = 0; k < n; ++k) std::swap(a[col * n + k], a[pivot * n + k]);
+				std::swap(b[col], b[pivot]);
+			}
+
+			for (int row = col + 1; row < n; ++row)
+			{
+				double f = a[row * n + col] / a[col * n + col];
+				for (int k = col; k < n; ++k) a[row * n + k] -= f * a[col * n + k];
+				b[row] -= f * b[col];
+			}
+		}
+
+		for (int row = n - 1; row >= 0; --row)
+		{
+			double sum = b[row];
+			for (int k = row + 1; k < n; ++k) sum -= a[row * n + k] * b[k];
+			b[row] = sum / a[row * n + row];
+		}
+		return true;
+	}
+
+	// Squared distance between the model's match and the sample's
+	float Residual(const GlobalMotion::Estimate& model, const GlobalMotion::Sample& s)
+	{
+		float u, v;
+		model.Evaluate(s.X, s.Y, u, v);
+		float dx = u - s.U;
+		float dy = v - s.V;
+		return dx * dx + dy * dy;
+	}
+}
+
+void GlobalMotion::Estimate::Evaluate(float x, float y, float& u, float& v) const
+{
+	float w = H[6] * x + H[7] * y + H[8];
+	if (std::fabs(w) < 1e-6f) w = 1e-6f;
+	u = (H[0] * x + H[1] * y + H[2]) / w - x;
+	v = (H[3] * x + H[4] * y + H[5]) / w - y;
+}
+
+uint32_t GlobalMotion::Random()
+{
+	// xorshift32
+	m_RandomState ^= m_RandomState << 13;
+	m_RandomState ^= m_RandomState >> 17;
+	m_RandomState ^= m_RandomState << 5;
+	return m_RandomState;
+}
+
+int GlobalMotion::CountInliers(const Estimate& model, const Sample* samples, int count) const
+{
+	const float tolerance = InlierTolerance * InlierTolerance;
+	int inliers = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		if (Residual(model, samples[i]) <= tolerance) ++inliers;
+	}
+	return inliers;
+}
+
+void GlobalMotion::UpdateWeights(const Estimate& model, const Sample* samples, int count, std::vector<float>& weights) const
+{
+	// Tukey biweight: full weight near the model, none beyond the cutoff
+	const float cutoff = TukeyScale * InlierTolerance;
+	for (int i = 0; i < count; ++i)
+	{
+		float r = std::sqrt(Residual(model, samples[i])) / cutoff;
+		float t = 1.0f - r * r;
+		weights[i] = r < 1.0f ? t * t : 0.0f;
+	}
+}
+
+bool GlobalMotion::FitAffine(const Sample* samples, int count, const float* weights, Estimate& model) const
+{
+	// Both rows share the normal matrix. Centered on the samples, pixel coordinates stay well conditioned.
+	double cx = 0.0, cy = 0.0, wsum = 0.0;
+	for (int i = 0; i < count; ++i)
+	{
+		double w = weights ? weights[i] : 1.0;
+		cx += w * samples[i].X;
+		cy += w * samples[i].Y;
+		wsum += w;
+	}
+	if (wsum <= 0.0) return false;
+	cx /= wsum;
+	cy /= wsum;
+
+	double m[9] = {};
+	double bx[3] = {};
+	double by[3] = {};
+	for (int i = 0; i < count; ++i)
+	{
+		double w = weights ? weights[i] : 1.0;
+		if (w <= 0.0) continue;
+
+		const Sample& s = samples[i];
+		double p[3] = { s.X - cx, s.Y - cy, 1.0 };
+		double qx = s.X + s.U - cx;
+		double qy = s.Y + s.V - cy;
+		for (int r = 0; r < 3; ++r)
+		{
+			for (int c = 0; c < 3; ++c) m[r * 3 + c] += w * p[r] * p[c];
+			bx[r] += w * p[r] * qx;
+			by[r] += w * p[r] * qy;
+		}
+	}
+
+	double m2[9];
+	std::copy(m, m + 9, m2);
+	if (!Solve(m, bx, 3) || !Solve(m2, by, 3)) return false;
+
+	// Back from centered coordinates: q - c = A (p - c) + t
+	model.H[0] = (float)bx[0];
+	model.H[1] = (float)bx[1];
+	model.H[2] = (float)(bx[2] + cx - bx[0] * cx - bx[1] * cy);
+	model.H[3] = (float)by[0];
+	model.H[4] = (float)by[1];
+	model.H[5] = (float)(by[2] + cy - by[0] * cx - by[1] * cy);
+	model.H[6] = 0.0f;
+	model.H[7] = 0.0f;
+	model.H[8] = 1.0f;
+	return true;
+}
+
+bool GlobalMotion::FitHomography(const Sample* samples, int count, const float* weights, Estimate& model) const
+{
+	// Linearised with H[8] = 1 (the model is close to identity), in coordinates centered on the samples and
+	// scaled to unit spread
+	double cx = 0.0, cy = 0.0, wsum = 0.0;
+	for (int i = 0; i < count; ++i)
+	{
+		cx += weights[i] * samples[i].X;
+		cy += weights[i] * samples[i].Y;
+		wsum += weights[i];
+	}
+	if (wsum <= 0.0) return false;
+	cx /= wsum;
+	cy /= wsum;
+
+	double spread = 0.0;
+	for (int i = 0; i < count; ++i)
+	{
+		spread += weights[i] * (std::fabs(samples[i].X - cx) + std::fabs(samples[i].Y - cy));
+	}
+	spread /= wsum;
+	if (spread < 1e-3) return false;
+	const double k = 1.0 / spread;
+
+	double m[64] = {};
+	double b[8] = {};
+	for (int i = 0; i < count; ++i)
+	{
+		double w = weights[i];
+		if (w <= 0.0) continue;
+
+		const Sample& s = samples[i];
+		double x = (s.X - cx) * k;
+		double y = (s.Y - cy) * k;
+		double qx = (s.X + s.U - cx) * k;
+		double qy = (s.Y + s.V - cy) * k;
+
+		// The two equations touch 5 of the 8 unknowns each: [x y 1 . . . -x*qx -y*qx] and [. . . x y 1 -x*qy -y*qy]
+		static const int columns[2][5] = { { 0, 1, 2, 6, 7 }, { 3, 4, 5, 6, 7 } };
+		double rows[2][5] = {
+			{ x, y, 1.0, -x * qx, -y * qx },
+			{ x, y, 1.0, -x * qy, -y * qy },
+		};
+		double rhs[2] = { qx, qy };
+		for (int e = 0; e < 2; ++e)
+		{
+			for (int r = 0; r < 5; ++r)
+			{
+				double wr = w * rows[e][r];
+				for (int c = r; c < 5; ++c) m[columns[e][r] * 8 + columns[e][c]] += wr * rows[e][c];
+				b[columns[e][r]] += wr * rhs[e];
+			}
+		}
+	}
+	for (int r = 1; r < 8; ++r)
+		for (int c = 0; c < r; ++c) m[r * 8 + c] = m[c * 8 + r];
+
+	if (!Solve(m, b, 8)) return false;
+
+	// H = T^-1 Hn T with T = [k 0 -k cx; 0 k -k cy; 0 0 1]
+	double hn[9] = { b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7], 1.0 };
+	double t[9] = { k, 0.0, -k * cx, 0.0, k, -k * cy, 0.0, 0.0, 1.0 };
+	double tInv[9] = { spread, 0.0, cx, 0.0, spread, cy, 0.0, 0.0, 1.0 };
+	double tmp[9] = {};
+	double h[9] = {};
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 3; ++c)
+			for (int i = 0; i < 3; ++i) tmp[r * 3 + c] += hn[r * 3 + i] * t[i * 3 + c];
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 3; ++c)
+			for (int i = 0; i < 3; ++i) h[r * 3 + c] += tInv[r * 3 + i] * tmp[i * 3 + c];
+
+	if (std::fabs(h[8]) < 1e-9) return false;
+	for (int i = 0; i < 9; ++i) model.H[i] = (float)(h[i] / h[8]);
+	return true;
+}
+
+const GlobalMotion::Estimate& GlobalMotion::Fit(const Sample* samples, int count)
+{
+	m_Estimate = Estimate();
+	if (!samples || count < MinSamples) return m_Estimate;
+
+	// 1. RANSAC: affine through 3 random samples, scored on a strided subset
+	const int scoreStride = std::max(1, count / RansacScoreSamples);
+	const float tolerance = InlierTolerance * InlierTolerance;
+	Estimate best;
+	int bestScore = -1;
+	int scored = 0;
+	for (int i = 0; i < count; i += scoreStride) ++scored;
+
+	for (int iteration = 0; iteration < RansacIterations; ++iteration)
+	{
+		Sample triple[3];
+		int index[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			index[k] = (int)(Random() % (uint32_t)count);
+			triple[k] = samples[index[k]];
+		}
+		if (index[0] == index[1] || index[0] == index[2] || index[1] == index[2]) continue;
+
+		// Nearly collinear triples do not pin down an affine model
+		float area = (triple[1].X - triple[0].X) * (triple[2].Y - triple[0].Y) - (triple[2].X - triple[0].X) * (triple[1].Y - triple[0].Y);
+		if (std::fabs(area) < 1.0f) continue;
+
+		Estimate hypothesis;
+		if (!FitAffine(triple, 3, nullptr, hypothesis)) continue;
+
+		int score = 0;
+		for (int i = 0; i < count; i += scoreStride)
+		{
+			if (Residual(hypothesis, samples[i]) <= tolerance) ++score;
+		}
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = hypothesis;
+		}
+
+		// Enough draws for a 99% chance of one all-inlier triple at the best inlier ratio so far
+		double ratio = (double)bestScore / scored;
+		double miss = 1.0 - ratio * ratio * ratio;
+		if (miss <= 0.0 || iteration + 1 >= std::log(1.0 - RansacConfidence) / std::log(miss)) break;
+	}
+	if (bestScore < 0) return m_Estimate;
+
+	// 2. IRLS on all samples, starting from the consensus
+	if ((int)m_Weights.size() < count) m_Weights.resize(count);
+	Estimate affine = best;
+	for (int iteration = 0; iteration < IrlsIterations; ++iteration)
+	{
+		UpdateWeights(affine, samples, count, m_Weights);
+		Estimate refined;
+		if (!FitAffine(samples, count, m_Weights.data(), refined)) break;
+		affine = refined;
+	}
+	int affineInliers = CountInliers(affine, samples, count);
+
+	// 3. Perspective: the same IRLS from the affine weights, kept only when it explains clearly more
+	Estimate homography = affine;
+	bool perspective = true;
+	for (int iteration = 0; iteration < IrlsIterations && perspective; ++iteration)
+	{
+		UpdateWeights(homography, samples, count, m_Weights);
+		perspective = FitHomography(samples, count, m_Weights.data(), homography);
+	}
+
+	m_Estimate = affine;
+	m_Estimate.Type = Model::Affine;
+	int inliers = affineInliers;
+	if (perspective)
+	{
+		int homographyInliers = CountInliers(homography, samples, count);
+		if (homographyInliers >= affineInliers + (int)(HomographyGain * count))
+		{
+			m_Estimate = homography;
+			m_Estimate.Type = Model::Homography;
+			inliers = homographyInliers;
+		}
+	}
+
+	m_Estimate.InlierRatio = (float)inliers / count;
+	if (m_Estimate.InlierRatio < MinInlierRatio) m_Estimate.Type = Model::None;
+	return m_Estimate;
+}
+
+const GlobalMotion::Estimate& GlobalMotion::PhaseCorrelate(const float* current, const float* previous, int width, int height)
+{
+	m_Estimate = Estimate();
+	if (!current || !previous || width <= 0 || height <= 0) return m_Estimate;
+
+	PhaseCorrelation::Peak peak;
+	if (!m_Correlation.Correlate(current, previous, ThumbnailSize, &peak, 1)) return m_Estimate;
+
+	m_Estimate.H[2] = peak.X * (float)width / ThumbnailSize;
+	m_Estimate.H[5] = peak.Y * (float)height / ThumbnailSize;
+	m_Estimate.InlierRatio = peak.Height;
+	m_Estimate.Type = m_Estimate.InlierRatio >= MinCorrelationPeak ? Model::Translation : Model::None;
+	return m_Estimate;
+}
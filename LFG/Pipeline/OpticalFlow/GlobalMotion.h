@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "PhaseCorrelation.h"
+
+// [Global Motion] Camera motion (pan, zoom, roll, perspective) fitted to a sparse grid of flow vectors and used as
+// every pixel's initial guess, so the local search only has to find the residual of what moves on its own.
+// Plain CPU code shared by OpticalFlow (samples read back one frame late) and CPUOpticalFlow.
+// Positions are flow resolution pixels, integer = texel center, like CPU::SampleBilinear.
+class GlobalMotion
+{
+public:
+	enum class Model { None, Translation, Affine, Homography };
+
+	// Flow vector 'U, V' found at 'X, Y' of the current frame (the match in the previous frame is at X + U, Y + V)
+	struct Sample
+	{
+		float X, Y;
+		float U, V;
+	};
+
+	struct Estimate
+	{
+		Model Type = Model::None;
+		// Current -> previous position, row major, H[8] = 1. Translation and affine models keep H[6] = H[7] = 0.
+		float H[9] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+		float InlierRatio = 0.0f; // Fraction of the samples the model explains (phase correlation: peak height)
+
+		bool Valid() const { return Type != Model::None; }
+		// Motion of pixel (x, y), same convention as the flow fields
+		void Evaluate(float x, float y, float& u, float& v) const;
+	};
+
+	GlobalMotion() = default;
+	~GlobalMotion() = default;
+
+	// RANSAC over affine minimal sets, then IRLS on the consensus. A homography replaces the affine model when it
+	// explains clearly more samples. Type = None when no model reaches MinInlierRatio. Allocation free once warm.
+	const Estimate& Fit(const Sample* samples, int count);
+
+	// Pure translation between two ThumbnailSize x ThumbnailSize luma thumbnails of the whole frame (FFT phase
+	// correlation, independent of how far the frame moved), for when the vectors themselves are unreliable.
+	// 'width' x 'height' is the frame the thumbnails cover, the estimate is in its pixels.
+	const Estimate& PhaseCorrelate(const float* current, const float* previous, int width, int height);
+
+	const Estimate& GetEstimate() const { return m_Estimate; }
+	void Reset() { m_Estimate = Estimate(); }
+
+	// Samples per frame: a SampleGrid x SampleGrid grid over the flow field
+	static constexpr int SampleGrid = 32;
+	static constexpr int ThumbnailSize = 64; // Power of two (PhaseCorrelation)
+
+	static constexpr int MinSamples = 16;
+	static constexpr float InlierTolerance = 1.5f; // Flow pixels between a sample and the model
+	static constexpr float MinInlierRatio = 0.5f; // Below: the scene is not dominated by camera motion
+	static constexpr float MinCorrelationPeak = 0.08f; // Phase correlation peak (1 = identical shifted frames)
+
+private:
+	int CountInliers(const Estimate& model, const Sample* samples, int count) const;
+	bool FitAffine(const Sample* samples, int count, const float* weights, Estimate& model) const;
+	bool FitHomography(const Sample* samples, int count, const float* weights, Estimate& model) const;
+	void UpdateWeights(const Estimate& model, const Sample* samples, int count, std::vector<float>& weights) const;
+	uint32_t Random();
+
+	Estimate m_Estimate;
+	std::vector<float> m_Weights; // IRLS scratch
+	PhaseCorrelation m_Correlation{ ThumbnailSize };
+	uint32_t m_RandomState = 0x9E3779B9u; // Fixed seed, the same vectors give the same model
+};
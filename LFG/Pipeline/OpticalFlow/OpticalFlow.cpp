@@ -1,704 +1,2107 @@
-#include "OpticalFlow.h"
-#include <Pipeline/Shaders/Shader.h>
-#include <Debug/Debug.h>
-#include <Pipeline/Shaders/EmbeddedShaders.h>
-
-#include <cmath>
-
-bool OpticalFlow::Initialize(ID3D11Device* device, int width, int height)
-{
-	// 1. Load Compute Shaders
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Downsample, "CSMain", &m_csDownsample))
-	{
-		Debug::Error("Failed to load Downsample Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Upsample, "CSMain", &m_csUpsample))
-	{
-		Debug::Error("Failed to load Upsample Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_BlockMatching, "CSMain", &m_csBlockMatching))
-	{
-		Debug::Error("Failed to load BlockMatching Shader");
-		return false;
-	}
-
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_MotionSmooth, "CSMain", &m_csMotionSmooth))
-	{
-		Debug::Error("Failed to load MotionSmooth Shader");
-		return false;
-	}
-
-	// [Farneback & DIS] Shaders
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Farneback_Expansion, "CSMain", &m_csFarnebackExpansion) ||
-		!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_Farneback_Flow, "CSMain", &m_csFarnebackFlow) ||
-		!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_DIS_Flow, "CSMain", &m_csDISFlow))
-	{
-		Debug::Error("Failed to load Advanced Optical Flow Shaders");
-		// return false; // Optional
-	}
-
-	// Create Temp Texture for Smoothing
-	D3D11_TEXTURE2D_DESC desc = {};
-	desc.Width = width;
-	desc.Height = height;
-	desc.MipLevels = 1;
-	desc.ArraySize = 1;
-	desc.Format = DXGI_FORMAT_R16G16_FLOAT; // Motion Vector Format
-	desc.SampleDesc.Count = 1;
-	desc.Usage = D3D11_USAGE_DEFAULT;
-	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	device->CreateTexture2D(&desc, nullptr, &m_TexSmoothTemp);
-
-	// [Farneback] Poly Expansion Textures (RGBA16_FLOAT for precision)
-	D3D11_TEXTURE2D_DESC polyDesc = desc;
-	polyDesc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
-	if (FAILED(device->CreateTexture2D(&polyDesc, nullptr, &m_TexPolyCurr)) ||
-		FAILED(device->CreateTexture2D(&polyDesc, nullptr, &m_TexPolyPrev)))
-	{
-		Debug::Error("Failed to create Optical Flow Poly Textures");
-	}
-
-	// 2. Create Constant Buffer
-	D3D11_BUFFER_DESC cbDesc = {};
-	cbDesc.ByteWidth = sizeof(CBuffer);
-	cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-	cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-	cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-	
-	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_ConstantBuffer)))
-	{
-		Debug::Error("Failed to create Optical Flow Constant Buffer");
-		return false;
-	}
-
-	// [New] Variance CB
-	cbDesc.ByteWidth = sizeof(CBVariance);
-	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbVariance)))
-	{
-		Debug::Error("Failed to create Variance Const Buffer");
-	}
-
-	// [New] Shaders
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_BidirectionalConsistency, "main", &m_csBidirectionalConsistency))
-	{
-		Debug::Error("Failed to load Bi-Directional Shader");
-	}
-	if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_AdaptiveVariance, "main", &m_csAdaptiveVariance)) // Typo in plan filename fixed
-	{
-		Debug::Error("Failed to load Adaptive Variance Shader");
-	}
-	
-	// Backward Motion
-	D3D11_TEXTURE2D_DESC moDesc = {};
-	moDesc.Width = width;
-	moDesc.Height = height;
-	moDesc.MipLevels = 1;
-	moDesc.ArraySize = 1;
-	moDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
-	moDesc.SampleDesc.Count = 1;
-	moDesc.Usage = D3D11_USAGE_DEFAULT;
-	moDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	device->CreateTexture2D(&moDesc, nullptr, &m_TexMotionBackward);
-
-	// Variance Grid (Width/16)
-	D3D11_TEXTURE2D_DESC varDesc = {};
-	varDesc.Width = (UINT)ceil(width / 16.0f);
-	varDesc.Height = (UINT)ceil(height / 16.0f);
-	varDesc.MipLevels = 1;
-	varDesc.ArraySize = 1;
-	varDesc.Format = DXGI_FORMAT_R8_UNORM;
-	varDesc.SampleDesc.Count = 1;
-	varDesc.Usage = D3D11_USAGE_DEFAULT;
-	varDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	device->CreateTexture2D(&varDesc, nullptr, &m_TexVarianceGrid);
-
-	// 3. Initialize Pyramid (Fixed Level 1 for now)
-	D3D11_TEXTURE2D_DESC pyramidDesc = {};
-	pyramidDesc.Width = width / 2;
-	pyramidDesc.Height = height / 2;
-	pyramidDesc.MipLevels = 1;
-	pyramidDesc.ArraySize = 1;
-	pyramidDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; 
-	pyramidDesc.SampleDesc.Count = 1;
-	pyramidDesc.Usage = D3D11_USAGE_DEFAULT;
-	pyramidDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	
-	device->CreateTexture2D(&pyramidDesc, nullptr, &m_TexCurrentLevel1);
-	device->CreateTexture2D(&pyramidDesc, nullptr, &m_TexPrevLevel1);
-	
-	// Motion Textures for Pyramid
-	D3D11_TEXTURE2D_DESC motionDesc = {};
-	motionDesc.Width = width / 2;
-	motionDesc.Height = height / 2;
-	motionDesc.MipLevels = 1;
-	motionDesc.ArraySize = 1;
-	motionDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
-	motionDesc.SampleDesc.Count = 1;
-	motionDesc.Usage = D3D11_USAGE_DEFAULT;
-	motionDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
-	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionLevel1);
-	
-	// Level 2 (1/4 Res)
-	pyramidDesc.Width = width / 4;
-	pyramidDesc.Height = height / 4;
-	device->CreateTexture2D(&pyramidDesc, nullptr, &m_TexCurrentLevel2);
-	device->CreateTexture2D(&pyramidDesc, nullptr, &m_TexPrevLevel2);
-
-	motionDesc.Width = width / 4;
-	motionDesc.Height = height / 4;
-	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionLevel2);
-	
-	motionDesc.Width = width;
-	motionDesc.Height = height;
-	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionUpsampled);
-
-	// [Scene Change Stats Buffer]
-	D3D11_BUFFER_DESC bufDesc = {};
-	bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
-	bufDesc.ByteWidth = 4; // Single uint
-	bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-	bufDesc.StructureByteStride = 4;
-	
-	if (SUCCEEDED(device->CreateBuffer(&bufDesc, nullptr, &m_GlobalStatsBuffer)))
-	{
-		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
-		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
-		uavDesc.Buffer.NumElements = 1;
-		device->CreateUnorderedAccessView(m_GlobalStatsBuffer.Get(), &uavDesc, &m_GlobalStatsUAV);
-		
-		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
-		srvDesc.Buffer.NumElements = 1;
-		device->CreateShaderResourceView(m_GlobalStatsBuffer.Get(), &srvDesc, &m_GlobalStatsSRV);
-	}
-
-	Debug::Info("Pyramid Level 1 created (%dx%d)", pyramidDesc.Width, pyramidDesc.Height);
-
-	Debug::Info("OpticalFlow system initialized (Resolution: %dx%d).", width, height);
-	return true;
-}
-
-void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
-	if (!tex) return;
-	dev->CreateShaderResourceView(tex, nullptr, ppSRV);
-}
-
-void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
-	if (!tex) return;
-	dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
-}
-
-void OpticalFlow::Dispatch(ID3D11DeviceContext* context, 
-	ID3D11Texture2D* currentFrame, 
-	ID3D11Texture2D* prevFrame, 
-	ID3D11Texture2D* outputMotion,
-	int blockSize, int searchRadius,
-	bool enableSubPixel, bool enableSmoothing, int maxLevel, int minLevel,
-	FlowAlgorithm algo)
-{
-	if (!m_csDownsample || !m_csBlockMatching || !m_ConstantBuffer) return;
-	if (!currentFrame || !prevFrame || !outputMotion) return;
-
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	// Clear Stats Buffer
-	if (m_GlobalStatsUAV)
-	{
-		UINT clearVals[4] = { 0, 0, 0, 0 };
-		context->ClearUnorderedAccessViewUint(m_GlobalStatsUAV.Get(), clearVals);
-	}
-
-	// Update Constants
-	D3D11_TEXTURE2D_DESC texDesc;
-	currentFrame->GetDesc(&texDesc);
-	
-	CBuffer cbData;
-	cbData.Width = texDesc.Width;
-	cbData.Height = texDesc.Height;
-	cbData.BlockSize = blockSize;
-	cbData.SearchRadius = searchRadius;
-	cbData.EnableSubPixel = enableSubPixel ? 1 : 0;
-	cbData.UseInitMotion = 0; // Default off
-	
-	context->UpdateSubresource(m_ConstantBuffer.Get(), 0, nullptr, &cbData, 0, 0);
-	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
-
-	// [Algorithm Selection]
-	if (algo == FlowAlgorithm::Farneback && m_csFarnebackExpansion && m_csFarnebackFlow)
-	{
-		// 1. Expansion Pass (Current & Prev)
-		ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev;
-		ComPtr<ID3D11UnorderedAccessView> uavPolyCurr, uavPolyPrev;
-		CreateSRV(dev, currentFrame, &srvCurr);
-		CreateSRV(dev, prevFrame, &srvPrev);
-		CreateUAV(dev, m_TexPolyCurr.Get(), &uavPolyCurr);
-		CreateUAV(dev, m_TexPolyPrev.Get(), &uavPolyPrev);
-
-		// Expansion Dispatch (16x16 threads)
-		D3D11_TEXTURE2D_DESC desc;
-		currentFrame->GetDesc(&desc);
-		UINT gx = (UINT)ceil(desc.Width / 16.0f);
-		UINT gy = (UINT)ceil(desc.Height / 16.0f);
-
-		context->CSSetShader(m_csFarnebackExpansion.Get(), nullptr, 0);
-		context->CSSetShaderResources(0, 1, srvCurr.GetAddressOf());
-		context->CSSetUnorderedAccessViews(0, 1, uavPolyCurr.GetAddressOf(), nullptr);
-		context->Dispatch(gx, gy, 1);
-		
-		context->CSSetShaderResources(0, 1, srvPrev.GetAddressOf());
-		context->CSSetUnorderedAccessViews(0, 1, uavPolyPrev.GetAddressOf(), nullptr);
-		context->Dispatch(gx, gy, 1);
-
-		// Unbind Expansion
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		ID3D11ShaderResourceView* nullSRV = nullptr;
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-		context->CSSetShaderResources(0, 1, &nullSRV);
-
-		// 2. Initial Guess via Hierarchical Block Matching (Reuse existing logic)
-		if (maxLevel > 0)
-		{
-			Downsample(context, currentFrame, m_TexCurrentLevel1.Get());
-			Downsample(context, prevFrame, m_TexPrevLevel1.Get());
-			BlockMatching(context, m_TexCurrentLevel1.Get(), m_TexPrevLevel1.Get(), m_TexMotionLevel1.Get(), nullptr,
-				blockSize / 2, searchRadius / 2, false);
-			Upsample(context, m_TexMotionLevel1.Get(), m_TexMotionUpsampled.Get());
-		}
-
-		// 3. Farneback Flow (Refinement)
-		ComPtr<ID3D11ShaderResourceView> srvPolyCurr, srvPolyPrev, srvInitMotion;
-		ComPtr<ID3D11UnorderedAccessView> uavFlow;
-		
-		CreateSRV(dev, m_TexPolyCurr.Get(), &srvPolyCurr);
-		CreateSRV(dev, m_TexPolyPrev.Get(), &srvPolyPrev);
-
-		if (maxLevel == 0) {
-			// Default Block Matching for initialization if H-Search is off
-			BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, false); 
-			// Copy outputMotion -> init input for Farneback
-			context->CopyResource(m_TexMotionUpsampled.Get(), outputMotion);
-			CreateSRV(dev, m_TexMotionUpsampled.Get(), &srvInitMotion);
-		} else {
-			CreateSRV(dev, m_TexMotionUpsampled.Get(), &srvInitMotion); 
-		}
-
-		CreateUAV(dev, outputMotion, &uavFlow);
-
-		context->CSSetShader(m_csFarnebackFlow.Get(), nullptr, 0);
-		ID3D11ShaderResourceView* flowSRVs[] = { srvPolyCurr.Get(), srvPolyPrev.Get(), srvInitMotion.Get() };
-		context->CSSetShaderResources(0, 3, flowSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, uavFlow.GetAddressOf(), nullptr);
-		
-		context->Dispatch(gx, gy, 1);
-
-		// Unbind Flow
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
-		context->CSSetShaderResources(0, 3, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	}
-	else if (algo == FlowAlgorithm::DIS && m_csDISFlow && m_csFarnebackExpansion)
-	{
-		// DIS Logic: Use Gradient of Prev Frame + Inverse Compositional
-		ComPtr<ID3D11ShaderResourceView> srvPrev;
-		ComPtr<ID3D11UnorderedAccessView> uavPolyPrev;
-		CreateSRV(dev, prevFrame, &srvPrev);
-		CreateUAV(dev, m_TexPolyPrev.Get(), &uavPolyPrev);
-		
-		D3D11_TEXTURE2D_DESC desc; // reuse desc
-		currentFrame->GetDesc(&desc);
-		UINT gx = (UINT)ceil(desc.Width / 16.0f);
-		UINT gy = (UINT)ceil(desc.Height / 16.0f);
-		
-		context->CSSetShader(m_csFarnebackExpansion.Get(), nullptr, 0);
-		context->CSSetShaderResources(0, 1, srvPrev.GetAddressOf());
-		context->CSSetUnorderedAccessViews(0, 1, uavPolyPrev.GetAddressOf(), nullptr);
-		context->Dispatch(gx, gy, 1);
-		
-		// Unbind
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		ID3D11ShaderResourceView* nullSRV = nullptr;
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-		context->CSSetShaderResources(0, 1, &nullSRV);
-
-		// 2. Initialization (Block Matching)
-		if (maxLevel > 0)
-		{
-			Downsample(context, currentFrame, m_TexCurrentLevel1.Get());
-			Downsample(context, prevFrame, m_TexPrevLevel1.Get());
-			BlockMatching(context, m_TexCurrentLevel1.Get(), m_TexPrevLevel1.Get(), m_TexMotionLevel1.Get(), nullptr, blockSize/2, searchRadius/2, false);
-			Upsample(context, m_TexMotionLevel1.Get(), m_TexMotionUpsampled.Get());
-		}
-		else
-		{
-			BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, false);
-			context->CopyResource(m_TexMotionUpsampled.Get(), outputMotion);
-		}
-
-		// 3. DIS Flow (Gradient Descent Refinement)
-		ComPtr<ID3D11ShaderResourceView> srvCurrRaw, srvPrevRaw, srvPolyPrev, srvInitMotion;
-		ComPtr<ID3D11UnorderedAccessView> uavFlow;
-		CreateSRV(dev, currentFrame, &srvCurrRaw);
-		CreateSRV(dev, prevFrame, &srvPrevRaw); // Need Raw Prev too
-		CreateSRV(dev, m_TexPolyPrev.Get(), &srvPolyPrev); // Gradients
-		CreateSRV(dev, m_TexMotionUpsampled.Get(), &srvInitMotion);
-		CreateUAV(dev, outputMotion, &uavFlow);
-
-		context->CSSetShader(m_csDISFlow.Get(), nullptr, 0);
-		ID3D11ShaderResourceView* disSRVs[] = { srvCurrRaw.Get(), srvPrevRaw.Get(), srvPolyPrev.Get(), srvInitMotion.Get() };
-		context->CSSetShaderResources(0, 4, disSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, uavFlow.GetAddressOf(), nullptr);
-		
-		context->Dispatch(gx, gy, 1);
-		
-		// Unbind
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr };
-		context->CSSetShaderResources(0, 4, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	}
-	else
-	{
-		// Resources Map
-		ID3D11Texture2D* texCurr[3] = { currentFrame, m_TexCurrentLevel1.Get(), m_TexCurrentLevel2.Get() };
-		ID3D11Texture2D* texPrev[3] = { prevFrame, m_TexPrevLevel1.Get(), m_TexPrevLevel2.Get() };
-		ID3D11Texture2D* texMotion[3] = { outputMotion, m_TexMotionLevel1.Get(), m_TexMotionLevel2.Get() };
-		
-		// Valid Range Check
-		if (maxLevel > 2) maxLevel = 2;
-		if (minLevel < 0) minLevel = 0;
-		if (minLevel > maxLevel) minLevel = maxLevel;
-
-		// 1. Downsample Chain (Need to fill levels down to maxLevel)
-		// If maxLevel is 0, no downsampling needed.
-		// If maxLevel is 1, need L0->L1.
-		// If maxLevel is 2, need L0->L1->L2.
-		for (int l = 1; l <= maxLevel; ++l)
-		{
-			Downsample(context, texCurr[l-1], texCurr[l]);
-			Downsample(context, texPrev[l-1], texPrev[l]);
-		}
-		
-		// Manual Implementation for robustness
-		
-		// Level 2 (Quarter)
-		if (maxLevel >= 2 && minLevel <= 2)
-		{
-			// Calc L2
-			// Init = Null (Coarsest)
-			int blk = blockSize / 4; if (blk < 4) blk = 4;
-			int rad = searchRadius / 4; if (rad < 2) rad = 2;
-			
-			BlockMatching(context, texCurr[2], texPrev[2], texMotion[2], nullptr, blk, rad, false); // u0 = MotionL2
-		}
-		
-		// Level 1 (Half)
-		if (maxLevel >= 1 && minLevel <= 1)
-		{
-			ID3D11Texture2D* init = nullptr;
-			
-			if (maxLevel >= 2) // If coming from L2
-			{
-				// Upsample L2 -> L1
-				Upsample(context, texMotion[2], texMotion[1]); 
-				init = texMotion[1];
-
-				// Impl:
-				if (maxLevel == 2)
-				{
-					int blk = blockSize/4; if (blk<4) blk=4;
-					BlockMatching(context, texCurr[2], texPrev[2], texMotion[2], nullptr, blk, searchRadius/4, false);
-					
-					if (minLevel == 2) {
-						// L2 -> L0
-						Upsample(context, texMotion[2], outputMotion); // Direct upsample to output
-						return;
-					}
-					
-					Upsample(context, texMotion[2], texMotion[1]);
-				}
-				else if (maxLevel == 1)
-				{
-					int blk = blockSize/2; if (blk<4) blk=4;
-					BlockMatching(context, texCurr[1], texPrev[1], texMotion[1], nullptr, blk, searchRadius/2, false);
-				}
-				
-				// Level 1 (Result in texMotion[1]).
-				if (minLevel == 1)
-				{
-					// L1 -> L0
-					Upsample(context, texMotion[1], outputMotion);
-					return;
-				}
-				
-				// Level 0 (Full)
-				Upsample(context, texMotion[1], m_TexMotionUpsampled.Get());
-				
-				// Calc L0
-				BlockMatching(context, texCurr[0], texPrev[0], texMotion[0], m_TexMotionUpsampled.Get(), blockSize, searchRadius, enableSubPixel);
-			}
-		}
-	// 5. Motion Smoothing (Optional)
-	if (enableSmoothing && m_TexSmoothTemp)
-	{
-		// Copy Output -> Temp
-		context->CopyResource(m_TexSmoothTemp.Get(), outputMotion);
-		
-		ComPtr<ID3D11ShaderResourceView> srvInput;
-		ComPtr<ID3D11UnorderedAccessView> uavOutput;
-		CreateSRV(dev, m_TexSmoothTemp.Get(), &srvInput);
-		CreateUAV(dev, outputMotion, &uavOutput); // Write back to Output
-
-		context->CSSetShader(m_csMotionSmooth.Get(), nullptr, 0);
-		context->CSSetShaderResources(0, 1, srvInput.GetAddressOf());
-		context->CSSetUnorderedAccessViews(0, 1, uavOutput.GetAddressOf(), nullptr);
-		
-		D3D11_TEXTURE2D_DESC texDesc;
-		currentFrame->GetDesc(&texDesc);
-		context->Dispatch((UINT)ceil(texDesc.Width / 8.0f), (UINT)ceil(texDesc.Height / 8.0f), 1);
-
-		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
-		ID3D11UnorderedAccessView* nullUAV = nullptr;
-		context->CSSetShaderResources(0, 1, nullSRVs);
-		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	}
-	
-	dev->Release();
-	}
-}
-
-void OpticalFlow::Downsample(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* output)
-{
-	if (!input || !output) return;
-
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	ComPtr<ID3D11ShaderResourceView> srv;
-	ComPtr<ID3D11UnorderedAccessView> uav;
-	CreateSRV(dev, input, &srv);
-	CreateUAV(dev, output, &uav);
-	dev->Release();
-
-	context->CSSetShader(m_csDownsample.Get(), nullptr, 0);
-	context->CSSetShaderResources(0, 1, srv.GetAddressOf());
-	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
-
-	D3D11_TEXTURE2D_DESC desc;
-	output->GetDesc(&desc);
-	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
-
-	// Unbind
-	ID3D11ShaderResourceView* nullSRV = nullptr;
-	ID3D11UnorderedAccessView* nullUAV = nullptr;
-	context->CSSetShaderResources(0, 1, &nullSRV);
-	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	context->CSSetShader(nullptr, nullptr, 0);
-}
-
-void OpticalFlow::Upsample(ID3D11DeviceContext* context, ID3D11Texture2D* inputLowRes, ID3D11Texture2D* outputHighRes)
-{
-	if (!inputLowRes || !outputHighRes) return;
-
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	ComPtr<ID3D11ShaderResourceView> srv;
-	ComPtr<ID3D11UnorderedAccessView> uav;
-	CreateSRV(dev, inputLowRes, &srv);
-	CreateUAV(dev, outputHighRes, &uav);
-	dev->Release();
-
-	context->CSSetShader(m_csUpsample.Get(), nullptr, 0);
-	context->CSSetShaderResources(0, 1, srv.GetAddressOf());
-	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
-
-	D3D11_TEXTURE2D_DESC desc;
-	outputHighRes->GetDesc(&desc);
-	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
-
-	// Unbind
-	ID3D11ShaderResourceView* nullSRV = nullptr;
-	ID3D11UnorderedAccessView* nullUAV = nullptr;
-	context->CSSetShaderResources(0, 1, &nullSRV);
-	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	context->CSSetShader(nullptr, nullptr, 0);
-}
-
-void OpticalFlow::BlockMatching(ID3D11DeviceContext* context, 
-	ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion, 
-	ID3D11Texture2D* initMotion,
-	int blockSize, int searchRadius, bool enableSubPixel)
-{
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	// Update CBuffer params for this pass
-	D3D11_TEXTURE2D_DESC desc;
-	current->GetDesc(&desc);
-
-	D3D11_MAPPED_SUBRESOURCE mapped;
-	if (SUCCEEDED(context->Map(m_ConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
-	{
-		CBuffer* pData = (CBuffer*)mapped.pData;
-		pData->Width = desc.Width;
-		pData->Height = desc.Height;
-		pData->BlockSize = blockSize;
-		pData->SearchRadius = searchRadius;
-		pData->EnableSubPixel = enableSubPixel ? 1 : 0;
-		pData->UseInitMotion = (initMotion != nullptr) ? 1 : 0;
-		context->Unmap(m_ConstantBuffer.Get(), 0);
-	}
-	// Bind CB
-	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
-
-	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvInit;
-	ComPtr<ID3D11UnorderedAccessView> uavMotion;
-	CreateSRV(dev, current, &srvCurrent);
-	CreateSRV(dev, prev, &srvPrev);
-	if (initMotion) CreateSRV(dev, initMotion, &srvInit);
-	CreateUAV(dev, motion, &uavMotion);
-	
-	// Create common sampler (should be member to avoid recreation, but fine for now)
-	D3D11_SAMPLER_DESC sampDesc = {};
-	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-	ComPtr<ID3D11SamplerState> sampler;
-	dev->CreateSamplerState(&sampDesc, &sampler);
-	
-	dev->Release();
-
-	context->CSSetShader(m_csBlockMatching.Get(), nullptr, 0);
-	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvInit.Get() };
-	context->CSSetShaderResources(0, 3, srvs);
-	ID3D11UnorderedAccessView* uavs[] = { uavMotion.Get(), m_GlobalStatsUAV.Get() }; // Slot 0: Motion, Slot 1: Stats
-	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
-	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
-
-	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
-
-	// Unbind
-	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
-	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
-	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
-	context->CSSetSamplers(0, 0, nullptr);
-}
-
-void OpticalFlow::DispatchBiDirectional(ID3D11DeviceContext* context,
-		ID3D11Texture2D* currentFrame, 
-		ID3D11Texture2D* prevFrame, 
-		ID3D11Texture2D* outputMotion,
-		int blockSize, int searchRadius)
-{
-	// 1. Calculate Forward Flow (Prev -> Curr)
-	// Output: outputMotion
-	BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, true);
-
-	// 2. Calculate Backward Flow (Curr -> Prev)
-	// Inputs swapped!
-	// Output: m_TexMotionBackward
-	if (m_TexMotionBackward)
-	{
-		BlockMatching(context, prevFrame, currentFrame, m_TexMotionBackward.Get(), nullptr, blockSize, searchRadius, true);
-	}
-
-	// 3. Consistency Check (Fusion)
-	// Output: outputMotion (Refined)
-	if (m_csBidirectionalConsistency)
-	{
-		CheckConsistency(context, outputMotion, m_TexMotionBackward.Get(), outputMotion);
-	}
-}
-
-void OpticalFlow::DispatchAdaptive(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* currentFrame, 
-		ID3D11Texture2D* prevFrame, 
-		ID3D11Texture2D* outputMotion,
-		int searchRadius)
-{
-	if (!m_TexVarianceGrid || !m_csAdaptiveVariance) return;
-
-	// 1. Calculate Variance Grid
-	CalcVariance(context, currentFrame, m_TexVarianceGrid.Get());
-
-	// 2. Block Matching with Adaptive Variance
-	// For now, running standard BlockMatching 16x16.
-	// Future improvement: Run 2 passes (16x16 and 8x8) and blend?
-	// Or trust that the Shader is updated (we didn't update BlockMatching.hlsl yet).
-	// Let's stick to base implementation for now.
-	BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, 16, searchRadius, true);
-}
-
-void OpticalFlow::CalcVariance(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* outputVar)
-{
-	if (!input || !outputVar || !m_csAdaptiveVariance) return;
-	
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	ComPtr<ID3D11ShaderResourceView> srv;
-	ComPtr<ID3D11UnorderedAccessView> uav;
-	CreateSRV(dev, input, &srv);
-	CreateUAV(dev, outputVar, &uav);
-	dev->Release();
-
-	context->CSSetShader(m_csAdaptiveVariance.Get(), nullptr, 0);
-	context->CSSetShaderResources(0, 1, srv.GetAddressOf());
-	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
-	
-	D3D11_TEXTURE2D_DESC desc;
-	outputVar->GetDesc(&desc);
-	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
-
-	// Unbind
-	ID3D11ShaderResourceView* nullSRV = nullptr;
-	ID3D11UnorderedAccessView* nullUAV = nullptr;
-	context->CSSetShaderResources(0, 1, &nullSRV);
-	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	context->CSSetShader(nullptr, nullptr, 0);
-}
-
-void OpticalFlow::CheckConsistency(ID3D11DeviceContext* context, ID3D11Texture2D* fwd, ID3D11Texture2D* bwd, ID3D11Texture2D* output)
-{
-	if (!fwd || !bwd || !output) return;
-
-	ID3D11Device* dev = nullptr;
-	context->GetDevice(&dev);
-
-	ComPtr<ID3D11ShaderResourceView> srvFwd, srvBwd;
-	ComPtr<ID3D11UnorderedAccessView> uavOut; 
-	
-	CreateSRV(dev, fwd, &srvFwd);
-	CreateSRV(dev, bwd, &srvBwd);
-	
-	if (!m_TexSmoothTemp) return; 
-	CreateUAV(dev, m_TexSmoothTemp.Get(), &uavOut);
-	
-	context->CSSetShader(m_csBidirectionalConsistency.Get(), nullptr, 0);
-	ID3D11ShaderResourceView* srvs[] = { srvFwd.Get(), srvBwd.Get() };
-	context->CSSetShaderResources(0, 2, srvs);
-	context->CSSetUnorderedAccessViews(0, 1, uavOut.GetAddressOf(), nullptr); 
-	
-	D3D11_TEXTURE2D_DESC desc;
-	fwd->GetDesc(&desc);
-	context->Dispatch((UINT)ceil(desc.Width / 16.0f), (UINT)ceil(desc.Height / 16.0f), 1);
-	
-	// Unbind
-	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
-	ID3D11UnorderedAccessView* nullUAV = nullptr;
-	context->CSSetShaderResources(0, 2, nullSRVs);
-	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
-	
-	// Copy Temp -> Output
-	context->CopyResource(output, m_TexSmoothTemp.Get());
-	
-	dev->Release();
-}
-
+#include "OpticalFlow.h"
+#include <Pipeline/Processing/LumaPyramid.h>
+#include <Pipeline/Processing/FrameHash.h>
+#include <Pipeline/Shaders/Shader.h>
+#include <Debug/Debug.h>
+#include <Pipeline/Shaders/EmbeddedShaders.h>
+
+#include <cmath>
+
+// Shaders survive a re-Initialize at another size ([Dynamic Resolution] steps), only the textures are recreated
+static bool LoadShader(ID3D11Device* device, const std::string& source, const char* entryPoint, ComPtr<ID3D11ComputeShader>& shader)
+{
+	return shader || Shader::CompileComputeShaderFromMemory(device, source, entryPoint, &shader);
+}
+
+bool OpticalFlow::Initialize(ID3D11Device* device, int width, int height)
+{
+	// 1. Load Compute Shaders
+	if (!LoadShader(device, EmbeddedShaders::CS_Upsample, "CSMain", m_csUpsample))
+	{
+		Debug::Error("Failed to load Upsample Shader");
+		return false;
+	}
+
+	if (!LoadShader(device, EmbeddedShaders::CS_BlockMatching, "CSMain", m_csBlockMatching))
+	{
+		Debug::Error("Failed to load BlockMatching Shader");
+		return false;
+	}
+
+	if (!LoadShader(device, EmbeddedShaders::CS_CostAggregation, "CSMain", m_csCostAggregation))
+	{
+		Debug::Error("Failed to load CostAggregation Shader");
+	}
+
+	if (!LoadShader(device, EmbeddedShaders::CS_MotionSmooth, "CSMain", m_csMotionSmooth))
+	{
+		Debug::Error("Failed to load MotionSmooth Shader");
+		return false;
+	}
+
+	// [Farneback & DIS] Shaders
+	if (!LoadShader(device, EmbeddedShaders::CS_Farneback_Expansion, "CSMain", m_csFarnebackExpansion) ||
+		!LoadShader(device, EmbeddedShaders::CS_Farneback_Flow, "CSMain", m_csFarnebackFlow) ||
+		!LoadShader(device, EmbeddedShaders::CS_DIS_Flow, "CSMain", m_csDISFlow))
+	{
+		Debug::Error("Failed to load Advanced Optical Flow Shaders");
+		// return false; // Optional
+	}
+
+	// [Hybrid Flow] Tile list entry points of the refinements and the selection passes
+	if (!LoadShader(device, EmbeddedShaders::CS_BlockMatching, "CSTiles", m_csBlockMatchingTiles) ||
+		!LoadShader(device, EmbeddedShaders::CS_CostAggregation, "CSTiles", m_csCostAggregationTiles) ||
+		!LoadShader(device, EmbeddedShaders::CS_Farneback_Flow, "CSTiles", m_csFarnebackFlowTiles) ||
+		!LoadShader(device, EmbeddedShaders::CS_DIS_Flow, "CSTiles", m_csDISFlowTiles) ||
+		!LoadShader(device, EmbeddedShaders::CS_FlowSelect, "CSStats", m_csFlowStats) ||
+		!LoadShader(device, EmbeddedShaders::CS_FlowSelect, "CSSelect", m_csFlowSelect))
+	{
+		Debug::Error("Failed to load Hybrid Flow Shaders");
+	}
+
+	// Create Temp Texture for Smoothing
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = width;
+	desc.Height = height;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R16G16_FLOAT; // Motion Vector Format
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	device->CreateTexture2D(&desc, nullptr, &m_TexSmoothTemp);
+
+	// [Farneback] Poly Expansion Textures (RGBA16_FLOAT for precision)
+	D3D11_TEXTURE2D_DESC polyDesc = desc;
+	polyDesc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
+	m_PolyCurrValid = m_PolyPrevValid = false;
+	if (FAILED(device->CreateTexture2D(&polyDesc, nullptr, &m_TexPoly[0])) ||
+		FAILED(device->CreateTexture2D(&polyDesc, nullptr, &m_TexPoly[1])))
+	{
+		Debug::Error("Failed to create Optical Flow Poly Textures");
+	}
+
+	// 2. Create Constant Buffer
+	D3D11_BUFFER_DESC cbDesc = {};
+	cbDesc.ByteWidth = sizeof(CBuffer);
+	cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+	cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	
+	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_ConstantBuffer)))
+	{
+		Debug::Error("Failed to create Optical Flow Constant Buffer");
+		return false;
+	}
+
+	// [New] Variance CB
+	cbDesc.ByteWidth = sizeof(CBVariance);
+	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbVariance)))
+	{
+		Debug::Error("Failed to create Variance Const Buffer");
+	}
+
+	// [Occlusion] Consistency CB
+	cbDesc.ByteWidth = sizeof(CBConsistency);
+	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbConsistency)))
+	{
+		Debug::Error("Failed to create Consistency Const Buffer");
+	}
+
+	// [Guided Upsample] Without it the upsampling falls back to nearest
+	cbDesc.ByteWidth = sizeof(CBUpsample);
+	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbUpsample)))
+	{
+		Debug::Error("Failed to create Upsample Const Buffer");
+	}
+
+	// [New] Shaders
+	if (!LoadShader(device, EmbeddedShaders::CS_BidirectionalConsistency, "main", m_csBidirectionalConsistency))
+	{
+		Debug::Error("Failed to load Bi-Directional Shader");
+	}
+	if (!LoadShader(device, EmbeddedShaders::CS_AdaptiveVariance, "CSMain", m_csAdaptiveVariance))
+	{
+		Debug::Error("Failed to load Adaptive Variance Shader");
+	}
+	
+	// Backward Motion
+	D3D11_TEXTURE2D_DESC moDesc = {};
+	moDesc.Width = width;
+	moDesc.Height = height;
+	moDesc.MipLevels = 1;
+	moDesc.ArraySize = 1;
+	moDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
+	moDesc.SampleDesc.Count = 1;
+	moDesc.Usage = D3D11_USAGE_DEFAULT;
+	moDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	device->CreateTexture2D(&moDesc, nullptr, &m_TexMotionBackward);
+
+	// [Occlusion] Visibility (Width/2)
+	D3D11_TEXTURE2D_DESC visDesc = moDesc;
+	visDesc.Width = (width + FlowTuning::VisibilityScale - 1) / FlowTuning::VisibilityScale;
+	visDesc.Height = (height + FlowTuning::VisibilityScale - 1) / FlowTuning::VisibilityScale;
+	visDesc.Format = DXGI_FORMAT_R8G8_UNORM;
+	if (FAILED(device->CreateTexture2D(&visDesc, nullptr, &m_TexVisibility)))
+	{
+		Debug::Error("Failed to create Visibility Texture");
+	}
+
+	// Variance Grid (Width/16)
+	D3D11_TEXTURE2D_DESC varDesc = {};
+	varDesc.Width = (UINT)ceil(width / 16.0f);
+	varDesc.Height = (UINT)ceil(height / 16.0f);
+	varDesc.MipLevels = 1;
+	varDesc.ArraySize = 1;
+	varDesc.Format = DXGI_FORMAT_R8_UNORM;
+	varDesc.SampleDesc.Count = 1;
+	varDesc.Usage = D3D11_USAGE_DEFAULT;
+	varDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+	device->CreateTexture2D(&varDesc, nullptr, &m_TexVarianceGrid);
+
+	// [Hybrid Flow] Per tile of the variance grid: the chosen algorithm, its stats and the lists it lands in
+	cbDesc.ByteWidth = sizeof(CBFlowSelect);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbFlowSelect);
+
+	D3D11_TEXTURE2D_DESC tileDesc = varDesc;
+	tileDesc.Format = DXGI_FORMAT_R32_UINT; // Typed UAV loads
+	m_TexTileAlgorithm.Reset();
+	device->CreateTexture2D(&tileDesc, nullptr, &m_TexTileAlgorithm);
+	tileDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
+	m_TexTileStats.Reset();
+	device->CreateTexture2D(&tileDesc, nullptr, &m_TexTileStats);
+
+	m_MaxTiles = (int)(varDesc.Width * varDesc.Height);
+	m_TileListBuffer.Reset();
+	m_TileListUAV.Reset();
+	m_TileArgsBuffer.Reset();
+	m_TileArgsUAV.Reset();
+	for (ComPtr<ID3D11ShaderResourceView>& srv : m_TileListSRV) srv.Reset();
+
+	D3D11_BUFFER_DESC listDesc = {};
+	listDesc.ByteWidth = HybridAlgorithms * m_MaxTiles * sizeof(UINT);
+	listDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+	listDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	listDesc.StructureByteStride = sizeof(UINT);
+	if (SUCCEEDED(device->CreateBuffer(&listDesc, nullptr, &m_TileListBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = HybridAlgorithms * m_MaxTiles;
+		device->CreateUnorderedAccessView(m_TileListBuffer.Get(), &uavDesc, &m_TileListUAV);
+
+		// Each refinement sees its own list from element 0
+		for (int i = 0; i < HybridAlgorithms; ++i)
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+			srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+			srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+			srvDesc.Buffer.FirstElement = i * m_MaxTiles;
+			srvDesc.Buffer.NumElements = m_MaxTiles;
+			device->CreateShaderResourceView(m_TileListBuffer.Get(), &srvDesc, &m_TileListSRV[i]);
+		}
+	}
+
+	D3D11_BUFFER_DESC argsDesc = {};
+	argsDesc.ByteWidth = HybridAlgorithms * 3 * sizeof(UINT);
+	argsDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+	argsDesc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+	if (SUCCEEDED(device->CreateBuffer(&argsDesc, nullptr, &m_TileArgsBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_R32_UINT; // Typed, CSSelect counts with InterlockedAdd
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = HybridAlgorithms * 3;
+		device->CreateUnorderedAccessView(m_TileArgsBuffer.Get(), &uavDesc, &m_TileArgsUAV);
+	}
+	if (!m_TexTileAlgorithm || !m_TexTileStats || !m_TileListUAV || !m_TileArgsUAV)
+	{
+		Debug::Error("Failed to create Hybrid Flow Resources");
+	}
+
+	// [Adaptive Radius] Stats readback and the per-tile bounds, same tile grid
+	if (!LoadShader(device, EmbeddedShaders::CS_MotionStats, "CSTileStats", m_csMotionTileStats) ||
+		!LoadShader(device, EmbeddedShaders::CS_MotionStats, "CSTileRadius", m_csMotionTileRadius))
+	{
+		Debug::Error("Failed to load Motion Stats Shaders");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBMotionStats);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbMotionStats);
+
+	tileDesc.Format = DXGI_FORMAT_R16_FLOAT;
+	m_TexTileMotionMax.Reset();
+	m_TexTileRadius.Reset();
+	device->CreateTexture2D(&tileDesc, nullptr, &m_TexTileMotionMax);
+	device->CreateTexture2D(&tileDesc, nullptr, &m_TexTileRadius);
+
+	D3D11_BUFFER_DESC statsDesc = {};
+	statsDesc.ByteWidth = AdaptiveRadius::ReadbackSize * sizeof(UINT);
+	statsDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+	statsDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	statsDesc.StructureByteStride = sizeof(UINT);
+	m_MotionStatsBuffer.Reset();
+	m_MotionStatsUAV.Reset();
+	m_MotionStatsStaging.Reset();
+	if (SUCCEEDED(device->CreateBuffer(&statsDesc, nullptr, &m_MotionStatsBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = AdaptiveRadius::ReadbackSize;
+		device->CreateUnorderedAccessView(m_MotionStatsBuffer.Get(), &uavDesc, &m_MotionStatsUAV);
+
+		D3D11_BUFFER_DESC stagingDesc = statsDesc;
+		stagingDesc.Usage = D3D11_USAGE_STAGING;
+		stagingDesc.BindFlags = 0;
+		stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+		stagingDesc.MiscFlags = 0;
+		device->CreateBuffer(&stagingDesc, nullptr, &m_MotionStatsStaging);
+	}
+
+	// 3. Motion Textures for Pyramid (the frame levels come from the LumaPyramid, same level count and sizes)
+	D3D11_TEXTURE2D_DESC motionDesc = {};
+	motionDesc.MipLevels = 1;
+	motionDesc.ArraySize = 1;
+	motionDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
+	motionDesc.SampleDesc.Count = 1;
+	motionDesc.Usage = D3D11_USAGE_DEFAULT;
+	motionDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+	int levelCount = Pyramid::LevelCount(width, height);
+	for (int level = 1; level < Pyramid::MaxLevels; ++level)
+	{
+		m_TexMotionLevels[level].Reset();
+		m_TexMotionInitLevels[level].Reset();
+		if (level >= levelCount) continue;
+
+		motionDesc.Width = width >> level;
+		motionDesc.Height = height >> level;
+		device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionLevels[level]);
+		device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionInitLevels[level]); // [Temporal Warm-Start]
+	}
+	
+	motionDesc.Width = width;
+	motionDesc.Height = height;
+	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionUpsampled);
+
+	// [Scene Change Stats Buffer]
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+	bufDesc.ByteWidth = 4; // Single uint
+	bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+	bufDesc.StructureByteStride = 4;
+	
+	if (SUCCEEDED(device->CreateBuffer(&bufDesc, nullptr, &m_GlobalStatsBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = 1;
+		device->CreateUnorderedAccessView(m_GlobalStatsBuffer.Get(), &uavDesc, &m_GlobalStatsUAV);
+		
+		D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+		srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+		srvDesc.Buffer.NumElements = 1;
+		device->CreateShaderResourceView(m_GlobalStatsBuffer.Get(), &srvDesc, &m_GlobalStatsSRV);
+	}
+
+	// [Temporal Warm-Start] Resources
+	if (!LoadShader(device, EmbeddedShaders::CS_MotionProject, "CSMain", m_csMotionProject))
+	{
+		Debug::Error("Failed to load MotionProject Shader");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBMotionProject);
+	if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbMotionProject)))
+	{
+		Debug::Error("Failed to create MotionProject Const Buffer");
+	}
+
+	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionHistory);
+	device->CreateTexture2D(&motionDesc, nullptr, &m_TexMotionPredicted);
+
+	if (SUCCEEDED(device->CreateBuffer(&bufDesc, nullptr, &m_WarmStartStatsBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = 1;
+		device->CreateUnorderedAccessView(m_WarmStartStatsBuffer.Get(), &uavDesc, &m_WarmStartStatsUAV);
+
+		D3D11_BUFFER_DESC stagingDesc = bufDesc;
+		stagingDesc.Usage = D3D11_USAGE_STAGING;
+		stagingDesc.BindFlags = 0;
+		stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+		device->CreateBuffer(&stagingDesc, nullptr, &m_WarmStartStatsStaging);
+	}
+
+	if (!LoadShader(device, EmbeddedShaders::CS_BlockSearch, "CSMain", m_csBlockSearch))
+	{
+		Debug::Error("Failed to load BlockSearch Shader");
+	}
+
+	// [3DRS] Shaders (block fields are created on first use)
+	if (!LoadShader(device, EmbeddedShaders::CS_RecursiveSearch, "CSMain", m_csRecursiveSearch) ||
+		!LoadShader(device, EmbeddedShaders::CS_MotionExpand, "CSMain", m_csMotionExpand))
+	{
+		Debug::Error("Failed to load Recursive Search Shaders");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBRecursiveSearch);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbRecursiveSearch);
+	cbDesc.ByteWidth = sizeof(CBMotionExpand);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbMotionExpand);
+	cbDesc.ByteWidth = sizeof(CBBlockSearch);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbBlockSearch);
+
+	// [Quadtree] Leaf fields at 1/4 res
+	if (!LoadShader(device, EmbeddedShaders::CS_QuadtreeSearch, "CSMain", m_csQuadtreeSearch))
+	{
+		Debug::Error("Failed to load QuadtreeSearch Shader");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBQuadtree);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbQuadtree);
+
+	D3D11_TEXTURE2D_DESC quadDesc = motionDesc;
+	quadDesc.Width = (width + FlowTuning::QuadtreeLeafSize - 1) / FlowTuning::QuadtreeLeafSize;
+	quadDesc.Height = (height + FlowTuning::QuadtreeLeafSize - 1) / FlowTuning::QuadtreeLeafSize;
+	device->CreateTexture2D(&quadDesc, nullptr, &m_TexQuadField);
+	device->CreateTexture2D(&quadDesc, nullptr, &m_TexQuadParent);
+	device->CreateTexture2D(&quadDesc, nullptr, &m_TexQuadHistory);
+	quadDesc.Format = DXGI_FORMAT_R32_UINT; // Typed UAV loads
+	device->CreateTexture2D(&quadDesc, nullptr, &m_TexQuadSize);
+
+	// [Flow Inversion] Backward field for BiDir without a second search
+	if (!LoadShader(device, EmbeddedShaders::CS_FlowSplat, "CSMain", m_csFlowSplat) ||
+		!LoadShader(device, EmbeddedShaders::CS_FlowInvert, "CSMain", m_csFlowInvert))
+	{
+		Debug::Error("Failed to load Flow Inversion Shaders");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBFlowInvert);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbFlowInvert);
+
+	D3D11_TEXTURE2D_DESC splatDesc = motionDesc;
+	splatDesc.Format = DXGI_FORMAT_R32_UINT; // InterlockedMin claims
+	device->CreateTexture2D(&splatDesc, nullptr, &m_TexFlowSplat);
+
+	// [Global Motion] Gather / seed passes, a fixed size readback and one seed texture per pyramid level
+	if (!LoadShader(device, EmbeddedShaders::CS_GlobalMotion, "CSGather", m_csGlobalGather) ||
+		!LoadShader(device, EmbeddedShaders::CS_GlobalMotion, "CSThumbnail", m_csGlobalThumbnail) ||
+		!LoadShader(device, EmbeddedShaders::CS_GlobalMotion, "CSSeed", m_csGlobalSeed))
+	{
+		Debug::Error("Failed to load Global Motion Shaders");
+	}
+
+	cbDesc.ByteWidth = sizeof(CBGlobalMotion);
+	device->CreateBuffer(&cbDesc, nullptr, &m_cbGlobalMotion);
+
+	D3D11_BUFFER_DESC readbackDesc = bufDesc;
+	readbackDesc.ByteWidth = GlobalReadbackFloats * sizeof(float);
+	if (SUCCEEDED(device->CreateBuffer(&readbackDesc, nullptr, &m_GlobalReadbackBuffer)))
+	{
+		D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+		uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+		uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+		uavDesc.Buffer.NumElements = GlobalReadbackFloats;
+		device->CreateUnorderedAccessView(m_GlobalReadbackBuffer.Get(), &uavDesc, &m_GlobalReadbackUAV);
+
+		D3D11_BUFFER_DESC stagingDesc = readbackDesc;
+		stagingDesc.Usage = D3D11_USAGE_STAGING;
+		stagingDesc.BindFlags = 0;
+		stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+		stagingDesc.MiscFlags = 0;
+		device->CreateBuffer(&stagingDesc, nullptr, &m_GlobalReadbackStaging);
+	}
+
+	for (int level = 0; level < Pyramid::MaxLevels; ++level)
+	{
+		m_TexGlobalSeedLevels[level].Reset();
+		if (level >= levelCount) continue;
+
+		motionDesc.Width = width >> level;
+		motionDesc.Height = height >> level;
+		device->CreateTexture2D(&motionDesc, nullptr, &m_TexGlobalSeedLevels[level]);
+	}
+
+	// [Phase Correlation] Candidates from a coarse level, one texel per tile
+	if (!LoadShader(device, EmbeddedShaders::CS_PhaseCorrelation, "CSMain", m_csPhaseCorrelation))
+	{
+		Debug::Error("Failed to load PhaseCorrelation Shader");
+	}
+
+	m_CandidateLevel = PhaseCorrelation::CandidateLevel < levelCount ? PhaseCorrelation::CandidateLevel : levelCount - 1;
+	D3D11_TEXTURE2D_DESC candidateDesc = motionDesc;
+	candidateDesc.Width = ((width >> m_CandidateLevel) + PhaseCorrelation::TileSize - 1) / PhaseCorrelation::TileSize;
+	candidateDesc.Height = ((height >> m_CandidateLevel) + PhaseCorrelation::TileSize - 1) / PhaseCorrelation::TileSize;
+	candidateDesc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
+	m_TexTileCandidates.Reset();
+	if (FAILED(device->CreateTexture2D(&candidateDesc, nullptr, &m_TexTileCandidates)))
+	{
+		Debug::Error("Failed to create Tile Candidates Texture");
+	}
+
+	m_FlowWidth = width;
+	m_FlowHeight = height;
+	m_BlockFieldSize = 0;
+	m_BlockMotionValid = false;
+	m_VisibilityValid = false;
+	m_TileStatsValid = false;
+
+	// New resolution, old vectors are meaningless
+	m_HasMotionHistory = false;
+	m_WarmStartPending = false;
+	m_WarmStartResidual = 1.0f;
+	m_GlobalPending = false;
+	m_GlobalValid = false;
+	m_GlobalMotion.Reset();
+	m_AdaptivePending = false;
+	m_TileRadiusValid = false;
+	m_TileRadiusActive = false;
+	m_AdaptiveRadius.Reset();
+
+	Debug::Info("OpticalFlow system initialized (Resolution: %dx%d).", width, height);
+	return true;
+}
+
+void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+	if (!tex) return;
+	dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
+	if (!tex) return;
+	dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
+}
+
+void OpticalFlow::Dispatch(ID3D11DeviceContext* context, 
+	const LumaPyramid& luma, 
+	ID3D11Texture2D* outputMotion,
+	int blockSize, int searchRadius,
+	int maxLevel, int minLevel,
+	FlowAlgorithm algo, const DispatchOptions& options)
+{
+	ID3D11Texture2D* currentFrame = luma.GetCurrent();
+	ID3D11Texture2D* prevFrame = luma.GetPrevious();
+	if (!m_csBlockMatching || !m_ConstantBuffer) return;
+	if (!currentFrame || !prevFrame || !outputMotion) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	m_BlockMotionValid = false;
+	m_VisibilityValid = false;
+
+	// Clear Stats Buffer
+	if (m_GlobalStatsUAV)
+	{
+		UINT clearVals[4] = { 0, 0, 0, 0 };
+		context->ClearUnorderedAccessViewUint(m_GlobalStatsUAV.Get(), clearVals);
+	}
+
+	// [Adaptive Radius] Last measured motion sets this frame's reach (searchRadius stays the cap) and the levels it takes.
+	// The block field estimators keep their own temporal candidates and are not measured.
+	bool adaptive = BeginAdaptiveRadius(context, options.EnableAdaptiveRadius && !options.BlockGranular && algo != FlowAlgorithm::RecursiveSearch, searchRadius);
+	if (adaptive)
+	{
+		searchRadius = m_AdaptiveRadius.GetRadius(searchRadius);
+		maxLevel = AdaptiveRadius::LevelsFor(searchRadius, maxLevel, minLevel);
+	}
+	m_TileRadiusActive = adaptive && m_TileRadiusValid && m_AdaptiveRadius.TileBounds();
+
+	// Update Constants
+	D3D11_TEXTURE2D_DESC texDesc;
+	currentFrame->GetDesc(&texDesc);
+	
+	CBuffer cbData = {};
+	cbData.Width = texDesc.Width;
+	cbData.Height = texDesc.Height;
+	cbData.BlockSize = blockSize;
+	cbData.SearchRadius = searchRadius;
+	cbData.EnableSubPixel = options.EnableSubPixel ? 1 : 0;
+	cbData.UseInitMotion = 0; // Default off
+	
+	context->UpdateSubresource(m_ConstantBuffer.Get(), 0, nullptr, &cbData, 0, 0);
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	// [Temporal Warm-Start]
+	// Last frame's motion, projected forward, is always offered as a candidate.
+	// If it explained the previous frame well, it replaces the coarse search outright.
+	bool warmStart = BeginWarmStart(context, options.EnableWarmStart);
+	bool trustPrediction = warmStart && m_WarmStartResidual < FlowTuning::WarmStartTrustThreshold;
+
+	// [Global Motion] Last frame's camera motion seeds the coarsest level, unless the warm-start already stands in for it
+	bool globalSeed = BeginGlobalMotion(context, options.EnableGlobalMotion) && !trustPrediction;
+
+	// [Hybrid Flow] The tile stats describe the last hybrid field only
+	bool hybrid = algo == FlowAlgorithm::Hybrid && m_csFlowSelect && m_csFlowStats && m_csBlockMatchingTiles &&
+		m_csFarnebackFlowTiles && m_csDISFlowTiles && m_TileListUAV && m_TileArgsUAV && m_TexTileAlgorithm && m_TexTileStats;
+	if (!hybrid) m_TileStatsValid = false;
+
+	// [Algorithm Selection]
+	if (algo == FlowAlgorithm::Farneback && m_csFarnebackExpansion && m_csFarnebackFlow)
+	{
+		// 1. Expansion Pass: carried over from ExpandFrame, only what it did not provide is expanded here
+		if (!m_PolyCurrValid) Expand(context, currentFrame, GetPolyCurr());
+		if (!m_PolyPrevValid) Expand(context, prevFrame, GetPolyPrev());
+
+		// 2. Initial Guess via Hierarchical Block Matching (Reuse existing logic)
+		InitRefinement(context, luma, outputMotion, blockSize, searchRadius, maxLevel, minLevel,
+			warmStart, trustPrediction, options.AggregateCost, globalSeed, options.EnablePhaseCorrelation);
+
+		// 3. Farneback Flow (Refinement)
+		Refine(context, FlowAlgorithm::Farneback, currentFrame, prevFrame, outputMotion);
+	}
+	else if (algo == FlowAlgorithm::DIS && m_csDISFlow && m_csFarnebackExpansion)
+	{
+		// DIS Logic: Use Gradient of Prev Frame + Inverse Compositional
+		// (last frame's expansion from ExpandFrame, expanded here only without one)
+		if (!m_PolyPrevValid) Expand(context, prevFrame, GetPolyPrev());
+
+		// 2. Initialization (Block Matching)
+		InitRefinement(context, luma, outputMotion, blockSize, searchRadius, maxLevel, minLevel,
+			warmStart, trustPrediction, options.AggregateCost, globalSeed, options.EnablePhaseCorrelation);
+
+		// 3. DIS Flow (Gradient Descent Refinement)
+		Refine(context, FlowAlgorithm::DIS, currentFrame, prevFrame, outputMotion);
+	}
+	else if (hybrid && m_csFarnebackExpansion && m_csFarnebackFlow && m_csDISFlow && m_TexVarianceGrid)
+	{
+		// [Hybrid Flow] Every tile with the cheapest refinement likely to hold, all of them from the same initial guess
+		if (!m_PolyCurrValid) Expand(context, currentFrame, GetPolyCurr());
+		if (!m_PolyPrevValid) Expand(context, prevFrame, GetPolyPrev());
+
+		bool fullResolution = InitRefinement(context, luma, outputMotion, blockSize, searchRadius, maxLevel, minLevel,
+			warmStart, trustPrediction, options.AggregateCost, globalSeed, options.EnablePhaseCorrelation);
+
+		CalcVariance(context, currentFrame, m_TexVarianceGrid.Get());
+		SelectTiles(context);
+
+		// The search tiles get the finest level's radius around the guess (a full resolution search already is their result)
+		if (!fullResolution)
+		{
+			int radius = Pyramid::Schedule(0, maxLevel, blockSize, searchRadius).SearchRadius;
+			BlockMatching(context, currentFrame, prevFrame, outputMotion, m_TexMotionUpsampled.Get(), blockSize, radius, options.EnableSubPixel,
+				nullptr, options.AggregateCost, nullptr, 1.0f, true);
+		}
+		Refine(context, FlowAlgorithm::Farneback, currentFrame, prevFrame, outputMotion, true);
+		Refine(context, FlowAlgorithm::DIS, currentFrame, prevFrame, outputMotion, true);
+
+		// Next frame's choice
+		MeasureTiles(context, currentFrame, prevFrame, outputMotion);
+	}
+	else if (algo == FlowAlgorithm::RecursiveSearch && m_csRecursiveSearch && m_csMotionExpand)
+	{
+		// Temporal candidates are built in, the warm-start prediction is not needed here
+		RecursiveSearch(context, currentFrame, prevFrame, options.BlockGranular ? nullptr : outputMotion, blockSize, options.EnableSubPixel);
+		m_BlockMotionValid = options.BlockGranular;
+	}
+	else if (algo == FlowAlgorithm::BlockMatching && options.BlockGranular && m_csBlockSearch)
+	{
+		// Last frame's block field is the temporal candidate
+		BlockSearch(context, currentFrame, prevFrame, blockSize, searchRadius, options.EnableSubPixel);
+		m_BlockMotionValid = true;
+	}
+	else
+	{
+		SearchPyramid(context, luma, outputMotion, blockSize, searchRadius, maxLevel, minLevel,
+			options.EnableSubPixel, warmStart, trustPrediction, options.AggregateCost, globalSeed, options.EnablePhaseCorrelation);
+	}
+	m_TileRadiusActive = false;
+
+	// [Block Motion] outputMotion was not written, synthesis samples the block field
+	if (m_BlockMotionValid)
+	{
+		m_HasMotionHistory = false;
+		dev->Release();
+		return;
+	}
+
+	// 5. Motion Smoothing (Optional)
+	if (options.EnableSmoothing && m_TexSmoothTemp)
+	{
+		// Copy Output -> Temp
+		context->CopyResource(m_TexSmoothTemp.Get(), outputMotion);
+		
+		ComPtr<ID3D11ShaderResourceView> srvInput;
+		ComPtr<ID3D11UnorderedAccessView> uavOutput;
+		CreateSRV(dev, m_TexSmoothTemp.Get(), &srvInput);
+		CreateUAV(dev, outputMotion, &uavOutput); // Write back to Output
+
+		context->CSSetShader(m_csMotionSmooth.Get(), nullptr, 0);
+		context->CSSetShaderResources(0, 1, srvInput.GetAddressOf());
+		context->CSSetUnorderedAccessViews(0, 1, uavOutput.GetAddressOf(), nullptr);
+		
+		context->Dispatch((UINT)ceil(texDesc.Width / 8.0f), (UINT)ceil(texDesc.Height / 8.0f), 1);
+
+		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+		ID3D11UnorderedAccessView* nullUAV = nullptr;
+		context->CSSetShaderResources(0, 1, nullSRVs);
+		context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	}
+
+	if (options.EnableGlobalMotion) GatherGlobalMotion(context, luma, outputMotion);
+	if (adaptive) MeasureMotion(context, luma, outputMotion, searchRadius);
+	StoreMotionHistory(context, outputMotion, options.EnableWarmStart);
+	
+	dev->Release();
+}
+
+void OpticalFlow::SearchPyramid(ID3D11DeviceContext* context,
+	const LumaPyramid& luma,
+	ID3D11Texture2D* output,
+	int blockSize, int searchRadius,
+	int maxLevel, int minLevel,
+	bool enableSubPixel, bool warmStart, bool trustPrediction,
+	bool aggregateCost, bool globalSeed, bool tileCandidates)
+{
+	// Level 0 is written straight into the output, the coarser ones into the level textures
+	ID3D11Texture2D* texMotion[Pyramid::MaxLevels] = { output };
+	ID3D11Texture2D* texInit[Pyramid::MaxLevels] = { m_TexMotionUpsampled.Get() };
+	for (int l = 1; l < Pyramid::MaxLevels; ++l)
+	{
+		texMotion[l] = m_TexMotionLevels[l].Get();
+		texInit[l] = m_TexMotionInitLevels[l].Get();
+	}
+
+	// Valid Range Check (the luma pyramid may be shallower at low flow resolutions)
+	int levelCount = luma.GetLevelCount();
+	if (maxLevel > levelCount - 1) maxLevel = levelCount - 1;
+	while (maxLevel > 0 && !texMotion[maxLevel]) --maxLevel;
+	if (maxLevel < 0) maxLevel = 0;
+	if (minLevel < 0) minLevel = 0;
+	if (minLevel > maxLevel) minLevel = maxLevel;
+
+	// A trusted prediction stands in for the coarser levels, so does camera motion that explains nearly the whole frame
+	// (the phase correlation fallback only moves the window of the coarsest one)
+	if (trustPrediction || (globalSeed && FlowTuning::TrustGlobalMotion(m_GlobalMotion.GetEstimate()))) maxLevel = minLevel;
+
+	// [Phase Correlation] Large shifts found per tile up front, offered to the coarsest search (a trusted prediction needs no help)
+	tileCandidates = tileCandidates && !trustPrediction && m_csPhaseCorrelation && m_TexTileCandidates && m_CandidateLevel < levelCount;
+	if (tileCandidates) PhaseCorrelateTiles(context, luma);
+
+	// 1. Coarse to fine (the frame levels were built once with the LumaPyramid) (each level refines the upsampled result of the one below)
+	for (int l = maxLevel; l >= minLevel; --l)
+	{
+		Pyramid::Level level = Pyramid::Schedule(l, maxLevel, blockSize, searchRadius);
+		int rad = level.SearchRadius;
+
+		ID3D11Texture2D* init = nullptr;
+		ID3D11Texture2D* predicted = nullptr;
+		ID3D11Texture2D* candidates = nullptr;
+
+		if (l < maxLevel)
+		{
+			Upsample(context, texMotion[l+1], texInit[l], luma.GetCurrent(l), luma.GetCurrent(l+1));
+			init = texInit[l];
+		}
+		else if (trustPrediction)
+		{
+			// Good guess, only a small correction left to find
+			ProjectMotion(context, luma.GetCurrent(l), luma.GetPrevious(l), texInit[l]);
+			init = texInit[l];
+			rad /= 4; if (rad < Pyramid::MinSearchRadius) rad = Pyramid::MinSearchRadius;
+		}
+		else
+		{
+			if (globalSeed && m_TexGlobalSeedLevels[l])
+			{
+				// [Global Motion] The camera motion is the guess, the search only corrects what moves on its own
+				SeedGlobalMotion(context, m_TexGlobalSeedLevels[l].Get());
+				init = m_TexGlobalSeedLevels[l].Get();
+				if (rad > FlowTuning::GlobalMotionResidualRadius) rad = FlowTuning::GlobalMotionResidualRadius;
+			}
+			if (warmStart)
+			{
+				ProjectMotion(context, luma.GetCurrent(l), luma.GetPrevious(l), texInit[l]);
+				predicted = texInit[l];
+			}
+			if (tileCandidates) candidates = m_TexTileCandidates.Get();
+		}
+
+		// Candidates are in m_CandidateLevel pixels, each level is half the one below
+		float candidateScale = std::ldexp(1.0f, m_CandidateLevel - l);
+		// [Adaptive Radius] The per-tile bounds cap the absolute search only, the finer levels correct a guess
+		BlockMatching(context, luma.GetCurrent(l), luma.GetPrevious(l), texMotion[l], init, level.BlockSize, rad, enableSubPixel && l == 0,
+			predicted, aggregateCost, candidates, candidateScale, false, m_TileRadiusActive && !init);
+	}
+
+	// 2. Finest computed level -> Output, [Guided Upsample] edge-aware so a coarse end level holds up at full resolution
+	for (int l = minLevel; l > 0; --l)
+	{
+		Upsample(context, texMotion[l], texMotion[l-1], luma.GetCurrent(l-1), luma.GetCurrent(l));
+	}
+}
+
+void OpticalFlow::Expand(ID3D11DeviceContext* context, ID3D11Texture2D* frame, ID3D11Texture2D* poly)
+{
+	if (!m_csFarnebackExpansion || !frame || !poly) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	ComPtr<ID3D11ShaderResourceView> srvFrame;
+	ComPtr<ID3D11UnorderedAccessView> uavPoly;
+	CreateSRV(dev, frame, &srvFrame);
+	CreateUAV(dev, poly, &uavPoly);
+
+	dev->Release();
+
+	// Expansion Dispatch (16x16 threads)
+	D3D11_TEXTURE2D_DESC desc;
+	frame->GetDesc(&desc);
+
+	context->CSSetShader(m_csFarnebackExpansion.Get(), nullptr, 0);
+	context->CSSetShaderResources(0, 1, srvFrame.GetAddressOf());
+	context->CSSetUnorderedAccessViews(0, 1, uavPoly.GetAddressOf(), nullptr);
+	context->Dispatch((UINT)ceil(desc.Width / 16.0f), (UINT)ceil(desc.Height / 16.0f), 1);
+
+	// Unbind
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	ID3D11ShaderResourceView* nullSRV = nullptr;
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetShaderResources(0, 1, &nullSRV);
+}
+
+bool OpticalFlow::InitRefinement(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* outputMotion,
+	int blockSize, int searchRadius, int maxLevel, int minLevel,
+	bool warmStart, bool trustPrediction, bool aggregateCost, bool globalSeed, bool tileCandidates)
+{
+	ID3D11Texture2D* currentFrame = luma.GetCurrent();
+	ID3D11Texture2D* prevFrame = luma.GetPrevious();
+
+	if (trustPrediction)
+	{
+		// The projected history is the initial guess, no block matching needed
+		ProjectMotion(context, currentFrame, prevFrame, m_TexMotionUpsampled.Get());
+		return false;
+	}
+
+	if (maxLevel > 0 && luma.GetLevelCount() > 1)
+	{
+		// Coarse levels only, the refinement is the full resolution pass
+		SearchPyramid(context, luma, m_TexMotionUpsampled.Get(), blockSize, searchRadius,
+			maxLevel, minLevel > 1 ? minLevel : 1, false, warmStart, false, aggregateCost, globalSeed, tileCandidates);
+		return false;
+	}
+
+	// Default Block Matching for initialization if H-Search is off
+	ID3D11Texture2D* predicted = nullptr;
+	if (warmStart)
+	{
+		ProjectMotion(context, currentFrame, prevFrame, m_TexMotionPredicted.Get());
+		predicted = m_TexMotionPredicted.Get();
+	}
+
+	BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, false, predicted, aggregateCost,
+		nullptr, 1.0f, false, m_TileRadiusActive);
+	// Copy outputMotion -> init input for the refinement
+	context->CopyResource(m_TexMotionUpsampled.Get(), outputMotion);
+	return true;
+}
+
+void OpticalFlow::Refine(ID3D11DeviceContext* context, FlowAlgorithm algo,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion, bool tiles)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	// Farneback: both expansions. DIS: both frames and the previous frame's gradients (inverse compositional)
+	bool dis = algo == FlowAlgorithm::DIS;
+	ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvPolyCurr, srvPolyPrev, srvInitMotion;
+	ComPtr<ID3D11UnorderedAccessView> uavFlow;
+	if (dis)
+	{
+		CreateSRV(dev, current, &srvCurr);
+		CreateSRV(dev, prev, &srvPrev);
+	}
+	else
+	{
+		CreateSRV(dev, GetPolyCurr(), &srvPolyCurr);
+	}
+	CreateSRV(dev, GetPolyPrev(), &srvPolyPrev);
+	CreateSRV(dev, m_TexMotionUpsampled.Get(), &srvInitMotion);
+	CreateUAV(dev, outputMotion, &uavFlow);
+	dev->Release();
+
+	// [Hybrid Flow] The tile list goes right after the unchanged mask (Farneback t4, DIS t5)
+	ID3D11ShaderResourceView* tileList = tiles ? m_TileListSRV[(int)algo].Get() : nullptr;
+	ID3D11ShaderResourceView* farnebackSRVs[] = { srvPolyCurr.Get(), srvPolyPrev.Get(), srvInitMotion.Get(), m_UnchangedTilesSRV, tileList };
+	ID3D11ShaderResourceView* disSRVs[] = { srvCurr.Get(), srvPrev.Get(), srvPolyPrev.Get(), srvInitMotion.Get(), m_UnchangedTilesSRV, tileList };
+	UINT srvCount = dis ? 6 : 5;
+
+	ID3D11ComputeShader* shader = dis ? (tiles ? m_csDISFlowTiles.Get() : m_csDISFlow.Get()) :
+		(tiles ? m_csFarnebackFlowTiles.Get() : m_csFarnebackFlow.Get());
+	context->CSSetShader(shader, nullptr, 0);
+	context->CSSetShaderResources(0, srvCount, dis ? disSRVs : farnebackSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, uavFlow.GetAddressOf(), nullptr);
+
+	if (tiles)
+	{
+		// One group per listed tile, the count comes from CSSelect
+		context->DispatchIndirect(m_TileArgsBuffer.Get(), (int)algo * 3 * sizeof(UINT));
+	}
+	else
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		current->GetDesc(&desc);
+		context->Dispatch((UINT)ceil(desc.Width / 16.0f), (UINT)ceil(desc.Height / 16.0f), 1);
+	}
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, srvCount, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+}
+
+void OpticalFlow::ExpandFrame(ID3D11DeviceContext* context, const LumaPyramid& luma, bool enable)
+{
+	bool carried = m_PolyCurrValid;
+	m_PolyCurrValid = m_PolyPrevValid = false;
+
+	ID3D11Texture2D* frame = luma.GetCurrent();
+	if (!enable || !m_csFarnebackExpansion || !frame || !m_TexPoly[0] || !m_TexPoly[1]) return;
+
+	// The coefficients have to match the flow input, otherwise Dispatch keeps expanding on its own
+	D3D11_TEXTURE2D_DESC polyDesc;
+	m_TexPoly[0]->GetDesc(&polyDesc);
+	if ((int)polyDesc.Width != luma.GetWidth() || (int)polyDesc.Height != luma.GetHeight()) return;
+
+	// [Cycle] Last frame's coefficients are the previous ones now
+	m_PolyIndex ^= 1;
+	Expand(context, frame, GetPolyCurr());
+	m_PolyCurrValid = true;
+	m_PolyPrevValid = carried;
+}
+
+void OpticalFlow::Upsample(ID3D11DeviceContext* context, ID3D11Texture2D* inputLowRes, ID3D11Texture2D* outputHighRes,
+	ID3D11Texture2D* guideHighRes, ID3D11Texture2D* guideLowRes)
+{
+	if (!inputLowRes || !outputHighRes) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	// [Guided Upsample] Both guides or none
+	bool guided = guideHighRes && guideLowRes && m_cbUpsample;
+	if (m_cbUpsample)
+	{
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		if (SUCCEEDED(context->Map(m_cbUpsample.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+		{
+			CBUpsample* pData = (CBUpsample*)mapped.pData;
+			pData->UseGuide = guided ? 1 : 0;
+			pData->RangeSigma = FlowTuning::UpsampleRangeSigma;
+			context->Unmap(m_cbUpsample.Get(), 0);
+		}
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srv, srvGuideHigh, srvGuideLow;
+	ComPtr<ID3D11UnorderedAccessView> uav;
+	CreateSRV(dev, inputLowRes, &srv);
+	if (guided) CreateSRV(dev, guideHighRes, &srvGuideHigh);
+	if (guided) CreateSRV(dev, guideLowRes, &srvGuideLow);
+	CreateUAV(dev, outputHighRes, &uav);
+	dev->Release();
+
+	context->CSSetShader(m_csUpsample.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srv.Get(), srvGuideHigh.Get(), srvGuideLow.Get() };
+	context->CSSetShaderResources(0, 3, srvs);
+	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+	// An unbound CB reads UseGuide = 0
+	ID3D11Buffer* cb = m_cbUpsample.Get();
+	context->CSSetConstantBuffers(0, 1, &cb);
+
+	D3D11_TEXTURE2D_DESC desc;
+	outputHighRes->GetDesc(&desc);
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 3, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	// Restore the flow constants for the passes that follow
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+	context->CSSetShader(nullptr, nullptr, 0);
+}
+
+void OpticalFlow::BlockMatching(ID3D11DeviceContext* context, 
+	ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion, 
+	ID3D11Texture2D* initMotion,
+	int blockSize, int searchRadius, bool enableSubPixel,
+	ID3D11Texture2D* predictedMotion,
+	bool aggregateCost,
+	ID3D11Texture2D* tileCandidates, float candidateScale,
+	bool tiles, bool tileRadius)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	// [Cost Aggregation] BlockSize becomes the matching window
+	aggregateCost = aggregateCost && m_csCostAggregation;
+	if (aggregateCost)
+	{
+		if (blockSize < 1) blockSize = 1;
+		if (blockSize > MaxAggregationWindow) blockSize = MaxAggregationWindow;
+	}
+
+	// Update CBuffer params for this pass
+	D3D11_TEXTURE2D_DESC desc;
+	current->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_ConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBuffer* pData = (CBuffer*)mapped.pData;
+		pData->Width = desc.Width;
+		pData->Height = desc.Height;
+		pData->BlockSize = blockSize;
+		pData->SearchRadius = searchRadius;
+		pData->EnableSubPixel = enableSubPixel ? 1 : 0;
+		pData->UseInitMotion = (initMotion != nullptr) ? 1 : 0;
+		pData->UsePredictedMotion = (predictedMotion != nullptr) ? 1 : 0;
+		// [Tile Hash] The mask is at flow resolution, the pyramid levels scale its tiles down
+		pData->UnchangedTileSize = (m_UnchangedTilesSRV && m_UnchangedFlowWidth > 0) ? FrameHash::TileSize * (int)desc.Width / m_UnchangedFlowWidth : 0;
+		pData->UseTileCandidates = (tileCandidates != nullptr) ? 1 : 0;
+		pData->CandidateScale = candidateScale;
+		// [Adaptive Radius] The bounds are in flow pixels, the levels scale them down like the unchanged mask
+		pData->UseTileRadius = (tileRadius && m_TexTileRadius) ? 1 : 0;
+		pData->TileRadiusScale = m_FlowWidth > 0 ? (float)desc.Width / m_FlowWidth : 1.0f;
+		context->Unmap(m_ConstantBuffer.Get(), 0);
+	}
+	// Bind CB
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvInit, srvPredicted, srvCandidates, srvTileRadius;
+	ComPtr<ID3D11UnorderedAccessView> uavMotion;
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	if (initMotion) CreateSRV(dev, initMotion, &srvInit);
+	if (predictedMotion) CreateSRV(dev, predictedMotion, &srvPredicted);
+	if (tileCandidates) CreateSRV(dev, tileCandidates, &srvCandidates);
+	if (tileRadius) CreateSRV(dev, m_TexTileRadius.Get(), &srvTileRadius);
+	CreateUAV(dev, motion, &uavMotion);
+	
+	// Create common sampler (should be member to avoid recreation, but fine for now)
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+	
+	dev->Release();
+
+	// [Hybrid Flow] One FlowTileSize group per listed tile (CostAggregationTile is the same size)
+	tiles = tiles && (aggregateCost ? m_csCostAggregationTiles : m_csBlockMatchingTiles) && m_TileArgsBuffer;
+	if (tiles) context->CSSetShader(aggregateCost ? m_csCostAggregationTiles.Get() : m_csBlockMatchingTiles.Get(), nullptr, 0);
+	else context->CSSetShader(aggregateCost ? m_csCostAggregation.Get() : m_csBlockMatching.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvInit.Get(), srvPredicted.Get(), m_UnchangedTilesSRV, srvCandidates.Get(),
+		tiles ? m_TileListSRV[(int)FlowAlgorithm::BlockMatching].Get() : nullptr, srvTileRadius.Get() };
+	context->CSSetShaderResources(0, 8, srvs);
+	ID3D11UnorderedAccessView* uavs[] = { uavMotion.Get(), m_GlobalStatsUAV.Get() }; // Slot 0: Motion, Slot 1: Stats
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	if (tiles)
+	{
+		context->DispatchIndirect(m_TileArgsBuffer.Get(), (int)FlowAlgorithm::BlockMatching * 3 * sizeof(UINT));
+	}
+	else
+	{
+		float groupSize = aggregateCost ? (float)FlowTuning::CostAggregationTile : 8.0f;
+		context->Dispatch((UINT)ceil(desc.Width / groupSize), (UINT)ceil(desc.Height / groupSize), 1);
+	}
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+	context->CSSetShaderResources(0, 8, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+	context->CSSetSamplers(0, 0, nullptr);
+}
+
+void OpticalFlow::PhaseCorrelateTiles(ID3D11DeviceContext* context, const LumaPyramid& luma)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev;
+	ComPtr<ID3D11UnorderedAccessView> uavCandidates;
+	CreateSRV(dev, luma.GetCurrent(m_CandidateLevel), &srvCurrent);
+	CreateSRV(dev, luma.GetPrevious(m_CandidateLevel), &srvPrev);
+	CreateUAV(dev, m_TexTileCandidates.Get(), &uavCandidates);
+	dev->Release();
+
+	D3D11_TEXTURE2D_DESC desc;
+	m_TexTileCandidates->GetDesc(&desc);
+
+	context->CSSetShader(m_csPhaseCorrelation.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get() };
+	context->CSSetShaderResources(0, 2, srvs);
+	context->CSSetUnorderedAccessViews(0, 1, uavCandidates.GetAddressOf(), nullptr);
+
+	// One group per tile
+	context->Dispatch(desc.Width, desc.Height, 1);
+
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 2, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+}
+
+void OpticalFlow::SelectTiles(ID3D11DeviceContext* context)
+{
+	D3D11_TEXTURE2D_DESC desc;
+	m_TexTileAlgorithm->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbFlowSelect.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBFlowSelect* pData = (CBFlowSelect*)mapped.pData;
+		pData->TilesX = desc.Width;
+		pData->TilesY = desc.Height;
+		pData->MaxTiles = m_MaxTiles;
+		pData->UseStats = m_TileStatsValid ? 1 : 0;
+		pData->FlatVariance = FlowTuning::HybridFlatVariance;
+		pData->LowResidual = FlowTuning::HybridLowResidual;
+		pData->HighResidual = FlowTuning::HybridHighResidual;
+		pData->MaxSpread = FlowTuning::HybridMaxSpread;
+		context->Unmap(m_cbFlowSelect.Get(), 0);
+	}
+
+	// Empty lists, one group high and deep
+	const UINT emptyArgs[HybridAlgorithms * 3] = { 0, 1, 1, 0, 1, 1, 0, 1, 1 };
+	context->UpdateSubresource(m_TileArgsBuffer.Get(), 0, nullptr, emptyArgs, 0, 0);
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+	ComPtr<ID3D11ShaderResourceView> srvVariance, srvStats;
+	ComPtr<ID3D11UnorderedAccessView> uavAlgorithm;
+	CreateSRV(dev, m_TexVarianceGrid.Get(), &srvVariance);
+	CreateSRV(dev, m_TexTileStats.Get(), &srvStats);
+	CreateUAV(dev, m_TexTileAlgorithm.Get(), &uavAlgorithm);
+	dev->Release();
+
+	context->CSSetShader(m_csFlowSelect.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvVariance.Get(), srvStats.Get() };
+	context->CSSetShaderResources(3, 2, srvs);
+	ID3D11UnorderedAccessView* uavs[] = { uavAlgorithm.Get(), m_TileListUAV.Get(), m_TileArgsUAV.Get() };
+	context->CSSetUnorderedAccessViews(0, 3, uavs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbFlowSelect.GetAddressOf());
+
+	// One thread per tile
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr, nullptr };
+	context->CSSetShaderResources(3, 2, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 3, nullUAVs, nullptr);
+	// Restore the flow constants for the passes that follow
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+}
+
+void OpticalFlow::MeasureTiles(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvMotion;
+	ComPtr<ID3D11UnorderedAccessView> uavStats;
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateSRV(dev, motion, &srvMotion);
+	CreateUAV(dev, m_TexTileStats.Get(), &uavStats);
+	dev->Release();
+
+	D3D11_TEXTURE2D_DESC desc;
+	m_TexTileStats->GetDesc(&desc);
+
+	// m_cbFlowSelect still holds this frame's grid
+	context->CSSetShader(m_csFlowStats.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvMotion.Get() };
+	context->CSSetShaderResources(0, 3, srvs);
+	context->CSSetUnorderedAccessViews(0, 1, uavStats.GetAddressOf(), nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbFlowSelect.GetAddressOf());
+
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 3, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	m_TileStatsValid = true;
+}
+
+void OpticalFlow::DispatchBiDirectional(ID3D11DeviceContext* context,
+		const LumaPyramid& luma, 
+		ID3D11Texture2D* outputMotion,
+		int blockSize, int searchRadius,
+		const DispatchOptions& options)
+{
+	m_BlockMotionValid = false;
+	m_VisibilityValid = false;
+
+	ID3D11Texture2D* currentFrame = luma.GetCurrent();
+	ID3D11Texture2D* prevFrame = luma.GetPrevious();
+	if (!currentFrame || !prevFrame || !outputMotion) return;
+
+	// [Temporal Warm-Start] Candidate for the forward pass only (history is forward motion)
+	ID3D11Texture2D* predicted = nullptr;
+	if (BeginWarmStart(context, options.EnableWarmStart))
+	{
+		ProjectMotion(context, currentFrame, prevFrame, m_TexMotionPredicted.Get());
+		predicted = m_TexMotionPredicted.Get();
+	}
+
+	// 1. Calculate Forward Flow (Prev -> Curr)
+	// Output: outputMotion
+	BlockMatching(context, currentFrame, prevFrame, outputMotion, nullptr, blockSize, searchRadius, true, predicted, options.AggregateCost);
+
+	// 2. Calculate Backward Flow (Curr -> Prev)
+	// Output: m_TexMotionBackward
+	// [Flow Inversion] With the windowed cost the forward field is reliable enough to invert, only empty and
+	// poorly matched pixels are searched again. Single-pixel matches are not: their second search is what
+	// lets the consistency check catch bad vectors, so that mode keeps it.
+	if (m_TexMotionBackward)
+	{
+		if (options.InvertBackward && options.AggregateCost && m_csCostAggregation && m_csFlowSplat && m_csFlowInvert && m_TexFlowSplat)
+		{
+			InvertFlow(context, currentFrame, prevFrame, outputMotion, m_TexMotionBackward.Get());
+		}
+		else
+		{
+			// Inputs swapped!
+			BlockMatching(context, prevFrame, currentFrame, m_TexMotionBackward.Get(), nullptr, blockSize, searchRadius, true, nullptr, options.AggregateCost);
+		}
+	}
+
+	// 3. Consistency Check (Occlusion)
+	// Output: outputMotion (Repaired) and m_TexVisibility, consumed by the interpolation blend
+	if (m_csBidirectionalConsistency && m_TexMotionBackward)
+	{
+		CheckConsistency(context, outputMotion, m_TexMotionBackward.Get(), outputMotion);
+	}
+
+	StoreMotionHistory(context, outputMotion, options.EnableWarmStart);
+}
+
+void OpticalFlow::InvertFlow(ID3D11DeviceContext* context,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev,
+	ID3D11Texture2D* forward, ID3D11Texture2D* outputBackward)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	forward->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbFlowInvert.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBFlowInvert* pData = (CBFlowInvert*)mapped.pData;
+		pData->Width = desc.Width;
+		pData->Height = desc.Height;
+		pData->RefineRadius = FlowTuning::FlowInversionRefineRadius;
+		pData->CostTolerance = FlowTuning::FlowInversionCostTolerance;
+		context->Unmap(m_cbFlowInvert.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srvForward, srvCurrent, srvPrev, srvSplat;
+	ComPtr<ID3D11UnorderedAccessView> uavSplat, uavBackward;
+	CreateSRV(dev, forward, &srvForward);
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateSRV(dev, m_TexFlowSplat.Get(), &srvSplat);
+	CreateUAV(dev, m_TexFlowSplat.Get(), &uavSplat);
+	CreateUAV(dev, outputBackward, &uavBackward);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	UINT groupsX = (UINT)ceil(desc.Width / 8.0f);
+	UINT groupsY = (UINT)ceil(desc.Height / 8.0f);
+	context->CSSetConstantBuffers(0, 1, m_cbFlowInvert.GetAddressOf());
+
+	// 1. Splat (Empty = 0xFFFFFFFF)
+	UINT clearVals[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF };
+	context->ClearUnorderedAccessViewUint(uavSplat.Get(), clearVals);
+
+	context->CSSetShader(m_csFlowSplat.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* splatSRVs[] = { srvForward.Get(), srvCurrent.Get(), srvPrev.Get() };
+	context->CSSetShaderResources(0, 3, splatSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, uavSplat.GetAddressOf(), nullptr);
+	context->Dispatch(groupsX, groupsY, 1);
+
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+
+	// 2. Resolve + targeted re-search
+	context->CSSetShader(m_csFlowInvert.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* invertSRVs[] = { srvForward.Get(), srvCurrent.Get(), srvPrev.Get(), srvSplat.Get() };
+	context->CSSetShaderResources(0, 4, invertSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, uavBackward.GetAddressOf(), nullptr);
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+	context->Dispatch(groupsX, groupsY, 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr };
+	context->CSSetShaderResources(0, 4, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetSamplers(0, 0, nullptr);
+}
+
+void OpticalFlow::DispatchAdaptive(ID3D11DeviceContext* context, 
+		const LumaPyramid& luma, 
+		ID3D11Texture2D* outputMotion,
+		int searchRadius,
+		const DispatchOptions& options)
+{
+	m_BlockMotionValid = false;
+	m_VisibilityValid = false;
+	if (!m_TexVarianceGrid || !m_csAdaptiveVariance || !m_csQuadtreeSearch || !m_TexQuadField) return;
+
+	ID3D11Texture2D* currentFrame = luma.GetCurrent();
+	ID3D11Texture2D* prevFrame = luma.GetPrevious();
+	if (!currentFrame || !prevFrame || !outputMotion) return;
+
+	// Clear Stats Buffer
+	if (m_GlobalStatsUAV)
+	{
+		UINT clearVals[4] = { 0, 0, 0, 0 };
+		context->ClearUnorderedAccessViewUint(m_GlobalStatsUAV.Get(), clearVals);
+	}
+
+	// 1. Calculate Variance Grid
+	CalcVariance(context, currentFrame, m_TexVarianceGrid.Get());
+
+	// 2. Quadtree Block Matching
+	// Flat regions keep 32x32 / 16x16 blocks, textured regions split down to 4x4 where the match is poor.
+	// Last frame's leaf field is a candidate at every node, so the warm-start projection is not needed here.
+	QuadtreeSearch(context, currentFrame, prevFrame, outputMotion, searchRadius, true, options.EnableWarmStart);
+
+	StoreMotionHistory(context, outputMotion, options.EnableWarmStart);
+}
+
+void OpticalFlow::CalcVariance(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* outputVar)
+{
+	if (!input || !outputVar || !m_csAdaptiveVariance) return;
+	
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	ComPtr<ID3D11ShaderResourceView> srv;
+	ComPtr<ID3D11UnorderedAccessView> uav;
+	CreateSRV(dev, input, &srv);
+	CreateUAV(dev, outputVar, &uav);
+	dev->Release();
+
+	context->CSSetShader(m_csAdaptiveVariance.Get(), nullptr, 0);
+	context->CSSetShaderResources(0, 1, srv.GetAddressOf());
+	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+	
+	D3D11_TEXTURE2D_DESC desc;
+	outputVar->GetDesc(&desc);
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRV = nullptr;
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 1, &nullSRV);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetShader(nullptr, nullptr, 0);
+}
+
+void OpticalFlow::CheckConsistency(ID3D11DeviceContext* context, ID3D11Texture2D* fwd, ID3D11Texture2D* bwd, ID3D11Texture2D* output)
+{
+	if (!fwd || !bwd || !output || !m_TexSmoothTemp || !m_TexVisibility || !m_cbConsistency) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	ComPtr<ID3D11ShaderResourceView> srvFwd, srvBwd;
+	ComPtr<ID3D11UnorderedAccessView> uavOut, uavVisibility; 
+	
+	CreateSRV(dev, fwd, &srvFwd);
+	CreateSRV(dev, bwd, &srvBwd);
+	CreateUAV(dev, m_TexSmoothTemp.Get(), &uavOut);
+	CreateUAV(dev, m_TexVisibility.Get(), &uavVisibility);
+	dev->Release();
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbConsistency.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBConsistency* pData = (CBConsistency*)mapped.pData;
+		pData->Tolerance = FlowTuning::ConsistencyTolerance;
+		pData->Scale = FlowTuning::VisibilityScale;
+		pData->RepairRadius = FlowTuning::OcclusionRepairRadius;
+		context->Unmap(m_cbConsistency.Get(), 0);
+	}
+	
+	context->CSSetShader(m_csBidirectionalConsistency.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvFwd.Get(), srvBwd.Get() };
+	context->CSSetShaderResources(0, 2, srvs);
+	ID3D11UnorderedAccessView* uavs[] = { uavOut.Get(), uavVisibility.Get() };
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr); 
+	context->CSSetConstantBuffers(0, 1, m_cbConsistency.GetAddressOf());
+	
+	D3D11_TEXTURE2D_DESC desc;
+	m_TexVisibility->GetDesc(&desc);
+	context->Dispatch((UINT)ceil(desc.Width / 16.0f), (UINT)ceil(desc.Height / 16.0f), 1);
+	
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+	context->CSSetShaderResources(0, 2, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+	// Copy Temp -> Output
+	context->CopyResource(output, m_TexSmoothTemp.Get());
+
+	m_VisibilityValid = true;
+}
+
+bool OpticalFlow::BeginWarmStart(ID3D11DeviceContext* context, bool enable)
+{
+	m_WarmStartMeasured = false;
+	if (!enable || !m_csMotionProject || !m_TexMotionHistory)
+	{
+		m_HasMotionHistory = false;
+		return false;
+	}
+
+	// Collect last frame's residual without waiting on the GPU.
+	// Staging reads need the immediate context (this one may be deferred).
+	if (m_WarmStartPending && m_WarmStartStatsStaging)
+	{
+		ID3D11Device* dev = nullptr;
+		context->GetDevice(&dev);
+		ID3D11DeviceContext* immediate = nullptr;
+		dev->GetImmediateContext(&immediate);
+		dev->Release();
+
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		if (SUCCEEDED(immediate->Map(m_WarmStartStatsStaging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+		{
+			UINT poorPixels = *(UINT*)mapped.pData;
+			immediate->Unmap(m_WarmStartStatsStaging.Get(), 0);
+
+			m_WarmStartResidual = m_WarmStartPendingPixels > 0 ? (float)poorPixels / m_WarmStartPendingPixels : 1.0f;
+			m_WarmStartPending = false;
+		}
+		immediate->Release();
+	}
+
+	return m_HasMotionHistory;
+}
+
+void OpticalFlow::ProjectMotion(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* output)
+{
+	if (!current || !prev || !output || !m_csMotionProject) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	output->GetDesc(&desc);
+
+	// Only the first projection of a frame feeds the residual (and only while no readback is in flight)
+	bool measure = !m_WarmStartMeasured && !m_WarmStartPending && m_WarmStartStatsUAV;
+	if (measure)
+	{
+		UINT clearVals[4] = { 0, 0, 0, 0 };
+		context->ClearUnorderedAccessViewUint(m_WarmStartStatsUAV.Get(), clearVals);
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbMotionProject.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBMotionProject* pData = (CBMotionProject*)mapped.pData;
+		pData->ResidualTolerance = FlowTuning::WarmStartResidualTolerance;
+		context->Unmap(m_cbMotionProject.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srvHistory, srvCurrent, srvPrev;
+	ComPtr<ID3D11UnorderedAccessView> uavOutput;
+	CreateSRV(dev, m_TexMotionHistory.Get(), &srvHistory);
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateUAV(dev, output, &uavOutput);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	context->CSSetShader(m_csMotionProject.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvHistory.Get(), srvCurrent.Get(), srvPrev.Get() };
+	context->CSSetShaderResources(0, 3, srvs);
+	// Unbound u1 discards the residual writes
+	ID3D11UnorderedAccessView* uavs[] = { uavOutput.Get(), measure ? m_WarmStartStatsUAV.Get() : nullptr };
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbMotionProject.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+	context->CSSetShaderResources(0, 3, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+	// Restore the flow constants for the passes that follow
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	if (measure)
+	{
+		if (m_WarmStartStatsStaging)
+		{
+			context->CopyResource(m_WarmStartStatsStaging.Get(), m_WarmStartStatsBuffer.Get());
+			m_WarmStartPending = true;
+			m_WarmStartPendingPixels = desc.Width * desc.Height;
+		}
+		m_WarmStartMeasured = true;
+	}
+}
+
+void OpticalFlow::StoreMotionHistory(ID3D11DeviceContext* context, ID3D11Texture2D* finalMotion, bool enable)
+{
+	if (!enable || !finalMotion || !m_TexMotionHistory) return;
+
+	context->CopyResource(m_TexMotionHistory.Get(), finalMotion);
+	m_HasMotionHistory = true;
+}
+
+bool OpticalFlow::BeginGlobalMotion(ID3D11DeviceContext* context, bool enable)
+{
+	m_GlobalValid = false;
+	if (!enable || !m_csGlobalSeed || !m_GlobalReadbackStaging)
+	{
+		// A readback left over from before would be stale when re-enabled
+		m_GlobalPending = false;
+		return false;
+	}
+	if (!m_GlobalPending) return false;
+
+	// Collect last frame's samples without waiting on the GPU.
+	// Staging reads need the immediate context (this one may be deferred).
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+	ID3D11DeviceContext* immediate = nullptr;
+	dev->GetImmediateContext(&immediate);
+	dev->Release();
+
+	++m_GlobalPendingAge;
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(immediate->Map(m_GlobalReadbackStaging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+	{
+		// Too old: the camera may have changed course since
+		if (m_GlobalPendingAge <= GlobalMotionMaxAge)
+		{
+			const float* data = (const float*)mapped.pData;
+			const GlobalMotion::Sample* samples = (const GlobalMotion::Sample*)data;
+			const float* thumbnails = data + GlobalMotion::SampleGrid * GlobalMotion::SampleGrid * 4;
+
+			// Vectors first, the thumbnails only when no model explains them (e.g. a pan beyond the search reach)
+			m_GlobalValid = m_GlobalMotion.Fit(samples, GlobalMotion::SampleGrid * GlobalMotion::SampleGrid).Valid() ||
+				m_GlobalMotion.PhaseCorrelate(thumbnails, thumbnails + GlobalMotion::ThumbnailSize * GlobalMotion::ThumbnailSize,
+					m_FlowWidth, m_FlowHeight).Valid();
+		}
+		immediate->Unmap(m_GlobalReadbackStaging.Get(), 0);
+		m_GlobalPending = false;
+	}
+	immediate->Release();
+
+	return m_GlobalValid;
+}
+
+void OpticalFlow::SeedGlobalMotion(ID3D11DeviceContext* context, ID3D11Texture2D* output)
+{
+	if (!output || !m_csGlobalSeed || !m_cbGlobalMotion) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	output->GetDesc(&desc);
+
+	const GlobalMotion::Estimate& model = m_GlobalMotion.GetEstimate();
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbGlobalMotion.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBGlobalMotion* pData = (CBGlobalMotion*)mapped.pData;
+		*pData = {};
+		for (int i = 0; i < 3; ++i)
+		{
+			pData->Row0[i] = model.H[i];
+			pData->Row1[i] = model.H[3 + i];
+			pData->Row2[i] = model.H[6 + i];
+		}
+		pData->LevelScale = (float)m_FlowWidth / desc.Width;
+		pData->SampleGrid = GlobalMotion::SampleGrid;
+		pData->ThumbnailSize = GlobalMotion::ThumbnailSize;
+		context->Unmap(m_cbGlobalMotion.Get(), 0);
+	}
+
+	ComPtr<ID3D11UnorderedAccessView> uav;
+	CreateUAV(dev, output, &uav);
+	dev->Release();
+
+	context->CSSetShader(m_csGlobalSeed.Get(), nullptr, 0);
+	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbGlobalMotion.GetAddressOf());
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	// Unbind
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	// Restore the flow constants for the passes that follow
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+}
+
+void OpticalFlow::GatherGlobalMotion(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* finalMotion)
+{
+	// One readback in flight at a time
+	if (m_GlobalPending || !finalMotion || !m_csGlobalGather || !m_csGlobalThumbnail || !m_GlobalReadbackUAV || !m_GlobalReadbackStaging) return;
+
+	int coarsest = luma.GetLevelCount() - 1;
+	ID3D11Texture2D* lumaCurrent = luma.GetCurrent(coarsest);
+	ID3D11Texture2D* lumaPrev = luma.GetPrevious(coarsest);
+	if (!lumaCurrent || !lumaPrev) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbGlobalMotion.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBGlobalMotion* pData = (CBGlobalMotion*)mapped.pData;
+		*pData = {};
+		pData->SampleGrid = GlobalMotion::SampleGrid;
+		pData->ThumbnailSize = GlobalMotion::ThumbnailSize;
+		context->Unmap(m_cbGlobalMotion.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srvMotion, srvCurrent, srvPrev;
+	CreateSRV(dev, finalMotion, &srvMotion);
+	CreateSRV(dev, lumaCurrent, &srvCurrent);
+	CreateSRV(dev, lumaPrev, &srvPrev);
+	dev->Release();
+
+	ID3D11ShaderResourceView* srvs[] = { srvMotion.Get(), srvCurrent.Get(), srvPrev.Get() };
+	context->CSSetShaderResources(0, 3, srvs);
+	context->CSSetUnorderedAccessViews(0, 1, m_GlobalReadbackUAV.GetAddressOf(), nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbGlobalMotion.GetAddressOf());
+
+	UINT sampleGroups = (GlobalMotion::SampleGrid + 7) / 8;
+	context->CSSetShader(m_csGlobalGather.Get(), nullptr, 0);
+	context->Dispatch(sampleGroups, sampleGroups, 1);
+
+	UINT thumbnailGroups = (GlobalMotion::ThumbnailSize + 7) / 8;
+	context->CSSetShader(m_csGlobalThumbnail.Get(), nullptr, 0);
+	context->Dispatch(thumbnailGroups, thumbnailGroups, 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 3, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	context->CopyResource(m_GlobalReadbackStaging.Get(), m_GlobalReadbackBuffer.Get());
+	m_GlobalPending = true;
+	m_GlobalPendingAge = 0;
+}
+
+bool OpticalFlow::BeginAdaptiveRadius(ID3D11DeviceContext* context, bool enable, int maxRadius)
+{
+	if (!enable || !m_csMotionTileStats || !m_csMotionTileRadius || !m_MotionStatsUAV || !m_MotionStatsStaging || !m_TexTileRadius)
+	{
+		// Stats left over from before would be stale when re-enabled
+		m_AdaptiveRadius.Reset();
+		m_AdaptivePending = false;
+		m_TileRadiusValid = false;
+		return false;
+	}
+	if (!m_AdaptivePending) return true;
+
+	// Collect the last stats without waiting on the GPU.
+	// Staging reads need the immediate context (this one may be deferred).
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+	ID3D11DeviceContext* immediate = nullptr;
+	dev->GetImmediateContext(&immediate);
+	dev->Release();
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(immediate->Map(m_MotionStatsStaging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+	{
+		m_AdaptiveRadius.Update(AdaptiveRadius::Summarize((const uint32_t*)mapped.pData), m_AdaptivePendingRadius, maxRadius);
+		immediate->Unmap(m_MotionStatsStaging.Get(), 0);
+		m_AdaptivePending = false;
+	}
+	immediate->Release();
+
+	return true;
+}
+
+void OpticalFlow::MeasureMotion(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* finalMotion, int searchedRadius)
+{
+	ID3D11Texture2D* lumaCurrent = luma.GetCurrent();
+	ID3D11Texture2D* lumaPrev = luma.GetPrevious();
+	if (!finalMotion || !lumaCurrent || !lumaPrev || !m_TexTileMotionMax || !m_cbMotionStats) return;
+
+	D3D11_TEXTURE2D_DESC desc;
+	m_TexTileRadius->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbMotionStats.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBMotionStats* pData = (CBMotionStats*)mapped.pData;
+		pData->TilesX = desc.Width;
+		pData->TilesY = desc.Height;
+		pData->Margin = AdaptiveRadius::Margin;
+		pData->Padding = (float)AdaptiveRadius::Padding;
+		context->Unmap(m_cbMotionStats.Get(), 0);
+	}
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+	ComPtr<ID3D11ShaderResourceView> srvMotion, srvCurrent, srvPrev, srvTileMax;
+	ComPtr<ID3D11UnorderedAccessView> uavTileMax, uavTileRadius;
+	CreateSRV(dev, finalMotion, &srvMotion);
+	CreateSRV(dev, lumaCurrent, &srvCurrent);
+	CreateSRV(dev, lumaPrev, &srvPrev);
+	CreateSRV(dev, m_TexTileMotionMax.Get(), &srvTileMax);
+	CreateUAV(dev, m_TexTileMotionMax.Get(), &uavTileMax);
+	CreateUAV(dev, m_TexTileRadius.Get(), &uavTileRadius);
+	dev->Release();
+
+	UINT clearVals[4] = { 0, 0, 0, 0 };
+	context->ClearUnorderedAccessViewUint(m_MotionStatsUAV.Get(), clearVals);
+	context->CSSetConstantBuffers(0, 1, m_cbMotionStats.GetAddressOf());
+
+	// 1. One group per tile
+	ID3D11ShaderResourceView* srvs[] = { srvMotion.Get(), srvCurrent.Get(), srvPrev.Get() };
+	ID3D11UnorderedAccessView* uavs[] = { m_MotionStatsUAV.Get(), uavTileMax.Get() };
+	context->CSSetShader(m_csMotionTileStats.Get(), nullptr, 0);
+	context->CSSetShaderResources(0, 3, srvs);
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+	context->Dispatch(desc.Width, desc.Height, 1);
+
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr, nullptr };
+	context->CSSetShaderResources(0, 3, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+
+	// 2. One thread per tile
+	context->CSSetShader(m_csMotionTileRadius.Get(), nullptr, 0);
+	context->CSSetShaderResources(3, 1, srvTileMax.GetAddressOf());
+	context->CSSetUnorderedAccessViews(2, 1, uavTileRadius.GetAddressOf(), nullptr);
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	context->CSSetShaderResources(3, 1, nullSRVs);
+	context->CSSetUnorderedAccessViews(2, 1, nullUAVs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+	m_TileRadiusValid = true;
+
+	// One readback in flight at a time, the tile bounds above are refreshed every frame regardless
+	if (!m_AdaptivePending)
+	{
+		context->CopyResource(m_MotionStatsStaging.Get(), m_MotionStatsBuffer.Get());
+		m_AdaptivePending = true;
+		m_AdaptivePendingRadius = searchedRadius;
+	}
+}
+
+void OpticalFlow::ResetMotion(ID3D11DeviceContext* context, ID3D11Texture2D* outputMotion)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	ID3D11Texture2D* fields[] = { outputMotion, m_TexMotionHistory.Get(), m_TexBlockHistory.Get(), m_TexQuadHistory.Get() };
+	for (ID3D11Texture2D* field : fields)
+	{
+		ComPtr<ID3D11UnorderedAccessView> uav;
+		CreateUAV(dev, field, &uav);
+		if (uav) context->ClearUnorderedAccessViewFloat(uav.Get(), zero);
+	}
+
+	// [Hybrid Flow] A spread no tile reaches sends every textured tile back to the plain search, as without stats
+	ComPtr<ID3D11UnorderedAccessView> uavTileStats;
+	CreateUAV(dev, m_TexTileStats.Get(), &uavTileStats);
+	float boundary[4] = { 0.0f, 1e4f, 0.0f, 0.0f };
+	if (uavTileStats) context->ClearUnorderedAccessViewFloat(uavTileStats.Get(), boundary);
+
+	// [Adaptive Radius] No bound survives a cut, and an empty readback opens the reach up
+	ComPtr<ID3D11UnorderedAccessView> uavTileRadius;
+	CreateUAV(dev, m_TexTileRadius.Get(), &uavTileRadius);
+	float unbounded[4] = { 1e4f, 0.0f, 0.0f, 0.0f };
+	if (uavTileRadius) context->ClearUnorderedAccessViewFloat(uavTileRadius.Get(), unbounded);
+	if (m_AdaptivePending && m_MotionStatsUAV && m_MotionStatsStaging)
+	{
+		UINT clearVals[4] = { 0, 0, 0, 0 };
+		context->ClearUnorderedAccessViewUint(m_MotionStatsUAV.Get(), clearVals);
+		context->CopyResource(m_MotionStatsStaging.Get(), m_MotionStatsBuffer.Get());
+	}
+
+	// [Global Motion] The samples in flight describe the old scene: an empty readback fits nothing
+	if (m_GlobalPending && m_GlobalReadbackUAV && m_GlobalReadbackStaging)
+	{
+		UINT clearVals[4] = { 0, 0, 0, 0 };
+		context->ClearUnorderedAccessViewUint(m_GlobalReadbackUAV.Get(), clearVals);
+		context->CopyResource(m_GlobalReadbackStaging.Get(), m_GlobalReadbackBuffer.Get());
+	}
+
+	dev->Release();
+}
+
+bool OpticalFlow::EnsureBlockFields(ID3D11DeviceContext* context, int blockSize)
+{
+	if (blockSize == m_BlockFieldSize && m_TexBlockHistory) return true;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = (m_FlowWidth + blockSize - 1) / blockSize;
+	desc.Height = (m_FlowHeight + blockSize - 1) / blockSize;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R16G16_FLOAT;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+	m_TexBlockField.Reset();
+	m_TexBlockFieldReverse.Reset();
+	m_TexBlockHistory.Reset();
+	m_BlockFieldSize = 0;
+	if (FAILED(dev->CreateTexture2D(&desc, nullptr, &m_TexBlockField)) ||
+		FAILED(dev->CreateTexture2D(&desc, nullptr, &m_TexBlockFieldReverse)) ||
+		FAILED(dev->CreateTexture2D(&desc, nullptr, &m_TexBlockHistory)))
+	{
+		Debug::Error("Failed to create Block Motion Fields");
+		dev->Release();
+		return false;
+	}
+
+	// History starts at zero motion
+	ComPtr<ID3D11UnorderedAccessView> uavHistory;
+	CreateUAV(dev, m_TexBlockHistory.Get(), &uavHistory);
+	float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	context->ClearUnorderedAccessViewFloat(uavHistory.Get(), zero);
+	dev->Release();
+
+	m_BlockFieldSize = blockSize;
+	Debug::Info("Block motion field created (%dx%d, Block %d)", desc.Width, desc.Height, blockSize);
+	return true;
+}
+
+void OpticalFlow::RecursiveSearch(ID3D11DeviceContext* context,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion,
+	int blockSize, bool enableSubPixel)
+{
+	if (blockSize < 4) blockSize = 4;
+	if (!EnsureBlockFields(context, blockSize)) return;
+
+	++m_FrameIndex;
+
+	// Forward scan (spatial candidates from last frame), then reverse scan (from the forward result)
+	RecursiveSearchPass(context, current, prev, m_TexBlockHistory.Get(), m_TexBlockHistory.Get(), m_TexBlockField.Get(), blockSize, 1, enableSubPixel);
+	RecursiveSearchPass(context, current, prev, m_TexBlockField.Get(), m_TexBlockHistory.Get(), m_TexBlockFieldReverse.Get(), blockSize, -1, enableSubPixel);
+
+	if (outputMotion) ExpandBlockField(context, m_TexBlockFieldReverse.Get(), outputMotion, blockSize);
+
+	// Final field becomes next frame's temporal candidates
+	m_TexBlockHistory.Swap(m_TexBlockFieldReverse);
+
+	// Restore the flow constants for the passes that follow
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+}
+
+void OpticalFlow::RecursiveSearchPass(ID3D11DeviceContext* context,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev,
+	ID3D11Texture2D* spatialField, ID3D11Texture2D* temporalField, ID3D11Texture2D* outputField,
+	int blockSize, int scanDirection, bool enableSubPixel)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	current->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbRecursiveSearch.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBRecursiveSearch* pData = (CBRecursiveSearch*)mapped.pData;
+		pData->Width = desc.Width;
+		pData->Height = desc.Height;
+		pData->BlockSize = blockSize;
+		pData->ScanDirection = scanDirection;
+		pData->FrameIndex = m_FrameIndex;
+		pData->EnableSubPixel = enableSubPixel ? 1 : 0;
+		pData->Padding[0] = pData->Padding[1] = 0;
+		context->Unmap(m_cbRecursiveSearch.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvSpatial, srvTemporal;
+	ComPtr<ID3D11UnorderedAccessView> uavOutput;
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateSRV(dev, spatialField, &srvSpatial);
+	CreateSRV(dev, temporalField, &srvTemporal);
+	CreateUAV(dev, outputField, &uavOutput);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	context->CSSetShader(m_csRecursiveSearch.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvSpatial.Get(), srvTemporal.Get(), m_UnchangedTilesSRV };
+	context->CSSetShaderResources(0, 5, srvs);
+	ID3D11UnorderedAccessView* uavs[] = { uavOutput.Get(), m_GlobalStatsUAV.Get() };
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbRecursiveSearch.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	// One group per block
+	D3D11_TEXTURE2D_DESC fieldDesc;
+	outputField->GetDesc(&fieldDesc);
+	context->Dispatch(fieldDesc.Width, fieldDesc.Height, 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+	context->CSSetShaderResources(0, 5, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+}
+
+void OpticalFlow::ExpandBlockField(ID3D11DeviceContext* context, ID3D11Texture2D* blockField, ID3D11Texture2D* outputMotion, int blockSize)
+{
+	if (!blockField || !outputMotion || !m_csMotionExpand) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbMotionExpand.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBMotionExpand* pData = (CBMotionExpand*)mapped.pData;
+		pData->BlockSize = blockSize;
+		context->Unmap(m_cbMotionExpand.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srv;
+	ComPtr<ID3D11UnorderedAccessView> uav;
+	CreateSRV(dev, blockField, &srv);
+	CreateUAV(dev, outputMotion, &uav);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	context->CSSetShader(m_csMotionExpand.Get(), nullptr, 0);
+	context->CSSetShaderResources(0, 1, srv.GetAddressOf());
+	context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbMotionExpand.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	D3D11_TEXTURE2D_DESC desc;
+	outputMotion->GetDesc(&desc);
+	context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRV = nullptr;
+	ID3D11UnorderedAccessView* nullUAV = nullptr;
+	context->CSSetShaderResources(0, 1, &nullSRV);
+	context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+}
+
+void OpticalFlow::BlockSearch(ID3D11DeviceContext* context,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev,
+	int blockSize, int searchRadius, bool enableSubPixel)
+{
+	if (blockSize < 4) blockSize = 4;
+	if (blockSize > MaxBlockSize) blockSize = MaxBlockSize;
+	if (!EnsureBlockFields(context, blockSize)) return;
+
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	current->GetDesc(&desc);
+
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	if (SUCCEEDED(context->Map(m_cbBlockSearch.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+	{
+		CBBlockSearch* pData = (CBBlockSearch*)mapped.pData;
+		pData->Width = desc.Width;
+		pData->Height = desc.Height;
+		pData->BlockSize = blockSize;
+		pData->SearchRadius = searchRadius;
+		pData->EnableSubPixel = enableSubPixel ? 1 : 0;
+		pData->UseInitField = 1;
+		pData->Decimation = (blockSize >= FlowTuning::BlockSearchDecimateFrom) ? 2 : 1;
+		pData->Padding = 0;
+		context->Unmap(m_cbBlockSearch.Get(), 0);
+	}
+
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvInit;
+	ComPtr<ID3D11UnorderedAccessView> uavOutput;
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateSRV(dev, m_TexBlockHistory.Get(), &srvInit);
+	CreateUAV(dev, m_TexBlockFieldReverse.Get(), &uavOutput);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	context->CSSetShader(m_csBlockSearch.Get(), nullptr, 0);
+	ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvInit.Get(), m_UnchangedTilesSRV };
+	context->CSSetShaderResources(0, 4, srvs);
+	ID3D11UnorderedAccessView* uavs[] = { uavOutput.Get(), m_GlobalStatsUAV.Get() };
+	context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_cbBlockSearch.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	// One group per block
+	D3D11_TEXTURE2D_DESC fieldDesc;
+	m_TexBlockFieldReverse->GetDesc(&fieldDesc);
+	context->Dispatch(fieldDesc.Width, fieldDesc.Height, 1);
+
+	// Unbind
+	ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr };
+	ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+	context->CSSetShaderResources(0, 4, nullSRVs);
+	context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	// Result becomes the synthesis input and next frame's candidate
+	m_TexBlockHistory.Swap(m_TexBlockFieldReverse);
+}
+
+void OpticalFlow::QuadtreeSearch(ID3D11DeviceContext* context,
+	ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion,
+	int searchRadius, bool enableSubPixel, bool useHistory)
+{
+	ID3D11Device* dev = nullptr;
+	context->GetDevice(&dev);
+
+	D3D11_TEXTURE2D_DESC desc;
+	current->GetDesc(&desc);
+
+	ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvVariance, srvParent, srvHistory;
+	ComPtr<ID3D11UnorderedAccessView> uavField, uavSize;
+	CreateSRV(dev, current, &srvCurrent);
+	CreateSRV(dev, prev, &srvPrev);
+	CreateSRV(dev, m_TexVarianceGrid.Get(), &srvVariance);
+	CreateSRV(dev, m_TexQuadParent.Get(), &srvParent);
+	CreateSRV(dev, m_TexQuadHistory.Get(), &srvHistory);
+	CreateUAV(dev, m_TexQuadField.Get(), &uavField);
+	CreateUAV(dev, m_TexQuadSize.Get(), &uavSize);
+
+	D3D11_SAMPLER_DESC sampDesc = {};
+	sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+	sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+	sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+	ComPtr<ID3D11SamplerState> sampler;
+	dev->CreateSamplerState(&sampDesc, &sampler);
+
+	dev->Release();
+
+	// Every cell starts owned by a root node, roots search around zero
+	UINT rootSize[4] = { (UINT)FlowTuning::QuadtreeRootSize, 0, 0, 0 };
+	context->ClearUnorderedAccessViewUint(uavSize.Get(), rootSize);
+	float zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	context->ClearUnorderedAccessViewFloat(uavField.Get(), zero);
+
+	context->CSSetShader(m_csQuadtreeSearch.Get(), nullptr, 0);
+	context->CSSetConstantBuffers(0, 1, m_cbQuadtree.GetAddressOf());
+	context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+	// Children only refine around their parent's (and neighbours') vectors
+	int childRadius = searchRadius / 4; if (childRadius < 2) childRadius = 2;
+
+	// Coarse to fine, one pass per level
+	for (int nodeSize = FlowTuning::QuadtreeRootSize; nodeSize >= FlowTuning::QuadtreeLeafSize; nodeSize /= 2)
+	{
+		// Parents and neighbours are read from a snapshot, the pass rewrites the field
+		context->CopyResource(m_TexQuadParent.Get(), m_TexQuadField.Get());
+
+		D3D11_MAPPED_SUBRESOURCE mapped;
+		if (SUCCEEDED(context->Map(m_cbQuadtree.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+		{
+			CBQuadtree* pData = (CBQuadtree*)mapped.pData;
+			pData->Width = desc.Width;
+			pData->Height = desc.Height;
+			pData->NodeSize = nodeSize;
+			pData->SearchRadius = (nodeSize == FlowTuning::QuadtreeRootSize) ? searchRadius : childRadius;
+			pData->EnableSubPixel = enableSubPixel ? 1 : 0;
+			pData->UseHistory = useHistory ? 1 : 0;
+			pData->VarianceThreshold = FlowTuning::QuadtreeVarianceThreshold;
+			pData->ResidualThreshold = FlowTuning::QuadtreeResidualThreshold;
+			context->Unmap(m_cbQuadtree.Get(), 0);
+		}
+
+		ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvVariance.Get(), srvParent.Get(), srvHistory.Get() };
+		context->CSSetShaderResources(0, 5, srvs);
+		ID3D11UnorderedAccessView* uavs[] = { uavField.Get(), uavSize.Get(), m_GlobalStatsUAV.Get() };
+		context->CSSetUnorderedAccessViews(0, 3, uavs, nullptr);
+
+		// One group per node
+		context->Dispatch((desc.Width + nodeSize - 1) / nodeSize, (desc.Height + nodeSize - 1) / nodeSize, 1);
+
+		ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
+		ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr, nullptr };
+		context->CSSetShaderResources(0, 5, nullSRVs);
+		context->CSSetUnorderedAccessViews(0, 3, nullUAVs, nullptr);
+	}
+	context->CSSetConstantBuffers(0, 1, m_ConstantBuffer.GetAddressOf());
+
+	// Variable-size blocks -> per-pixel (bilinear between 4x4 cell centers)
+	ExpandBlockField(context, m_TexQuadField.Get(), outputMotion, FlowTuning::QuadtreeLeafSize);
+
+	context->CopyResource(m_TexQuadHistory.Get(), m_TexQuadField.Get());
+}
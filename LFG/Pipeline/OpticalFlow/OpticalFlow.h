@@ -1,119 +1,471 @@
-#include <d3d11.h>
-#include <wrl/client.h>
-#include <vector>
-
-using Microsoft::WRL::ComPtr;
-
-enum class FlowAlgorithm {
-	BlockMatching = 0,
-	Farneback = 1,
-	DIS = 2
-};
-
-class OpticalFlow
-{
-public:
-	OpticalFlow() = default;
-	~OpticalFlow() = default;
-
-	bool Initialize(ID3D11Device* device, int width, int height);
-	void Dispatch(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* currentFrame, 
-		ID3D11Texture2D* prevFrame, 
-		ID3D11Texture2D* outputMotion,
-		int blockSize, int searchRadius,
-		bool enableSubPixel, bool enableSmoothing, 
-		int maxLevel, int minLevel,
-		FlowAlgorithm algo = FlowAlgorithm::BlockMatching);
-		
-	// Advanced Features
-	void DispatchBiDirectional(ID3D11DeviceContext* context,
-		ID3D11Texture2D* currentFrame, 
-		ID3D11Texture2D* prevFrame, 
-		ID3D11Texture2D* outputMotion,
-		int blockSize, int searchRadius);
-
-	void DispatchAdaptive(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* currentFrame, 
-		ID3D11Texture2D* prevFrame, 
-		ID3D11Texture2D* outputMotion,
-		int searchRadius);
-
-private:
-	// Implementation of Hierarchical Search
-	void Downsample(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* output);
-	void Upsample(ID3D11DeviceContext* context, ID3D11Texture2D* inputLowRes, ID3D11Texture2D* outputHighRes);
-	void BlockMatching(ID3D11DeviceContext* context, 
-		ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion, 
-		ID3D11Texture2D* initMotion,
-		int blockSize, int searchRadius, bool enableSubPixel);
-		
-	// New Implementation for Adaptive
-	void CalcVariance(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* outputVar);
-	void CheckConsistency(ID3D11DeviceContext* context, ID3D11Texture2D* fwd, ID3D11Texture2D* bwd, ID3D11Texture2D* output);
-
-	ComPtr<ID3D11ComputeShader> m_csDownsample;
-	ComPtr<ID3D11ComputeShader> m_csUpsample;
-	ComPtr<ID3D11ComputeShader> m_csBlockMatching;
-	
-	// New Shaders
-	ComPtr<ID3D11ComputeShader> m_csBidirectionalConsistency;
-	ComPtr<ID3D11ComputeShader> m_csAdaptiveVariance;
-	
-	// Helper to store pyramid levels
-	std::vector<ComPtr<ID3D11Texture2D>> m_PyramidLevels;
-	
-	struct CBuffer
-	{
-		int Width;
-		int Height;
-		int BlockSize;
-		int SearchRadius;
-		int EnableSubPixel;
-		int UseInitMotion;
-		int Padding[2];
-	};
-	
-	struct CBVariance {
-		float Threshold; // For Adaptive
-		float Padding[3];
-	};
-	
-	ComPtr<ID3D11Buffer> m_ConstantBuffer;
-	ComPtr<ID3D11Buffer> m_cbVariance; // New CB
-	
-	ComPtr<ID3D11ComputeShader> m_csMotionSmooth;
-	ComPtr<ID3D11Texture2D> m_TexSmoothTemp; // Temp buffer for smoothing
-	
-	// Resources for BiDir/Adaptive
-	ComPtr<ID3D11Texture2D> m_TexMotionBackward; // for BiDir
-	ComPtr<ID3D11Texture2D> m_TexVarianceGrid;   // for Adaptive
-	
-	// Hierarchy Resources
-	ComPtr<ID3D11Texture2D> m_TexMotionLevel1; // Half-res motion
-	ComPtr<ID3D11Texture2D> m_TexMotionUpsampled; // Upsampled motion for init
-	ComPtr<ID3D11Texture2D> m_TexCurrentLevel1; // Half-res current frame
-	ComPtr<ID3D11Texture2D> m_TexPrevLevel1; // Half-res prev frame
-	
-	// Level 2 (1/4 Res)
-	ComPtr<ID3D11Texture2D> m_TexMotionLevel2; 
-	ComPtr<ID3D11Texture2D> m_TexCurrentLevel2; 
-	ComPtr<ID3D11Texture2D> m_TexPrevLevel2;
-	
-	// Scene Change Stats
-	ComPtr<ID3D11Buffer> m_GlobalStatsBuffer;
-	ComPtr<ID3D11UnorderedAccessView> m_GlobalStatsUAV;
-	ComPtr<ID3D11ShaderResourceView> m_GlobalStatsSRV;
-	
-	// Advanced Optical Flow
-	ComPtr<ID3D11ComputeShader> m_csFarnebackExpansion;
-	ComPtr<ID3D11ComputeShader> m_csFarnebackFlow;
-	ComPtr<ID3D11ComputeShader> m_csDISFlow;
-	
-	ComPtr<ID3D11Texture2D> m_TexPolyCurr; // Coeffs for Current Frame
-	ComPtr<ID3D11Texture2D> m_TexPolyPrev; // Coeffs for Previous Frame
-
-public:
-	ID3D11ShaderResourceView* GetStatsSRV() const { return m_GlobalStatsSRV.Get(); }
-	ID3D11Texture2D* GetVarianceGrid() const { return m_TexVarianceGrid.Get(); } // Expose for debugging if needed
-};
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <vector>
+#include "FlowAlgorithm.h"
+#include "FlowTuning.h"
+#include "PyramidSchedule.h"
+#include "GlobalMotion.h"
+#include "PhaseCorrelation.h"
+#include "AdaptiveRadius.h"
+
+class LumaPyramid;
+
+using Microsoft::WRL::ComPtr;
+
+class OpticalFlow
+{
+public:
+	OpticalFlow() = default;
+	~OpticalFlow() = default;
+
+	bool Initialize(ID3D11Device* device, int width, int height);
+	// Optional stages of the Dispatch entry points, named so callers cannot swap two of them.
+	// An entry point ignores the ones it has no stage for.
+	struct DispatchOptions
+	{
+		bool EnableSubPixel = false;
+		bool EnableSmoothing = false;
+		bool EnableWarmStart = false; // [Temporal Warm-Start] Last frame's motion, projected, as a candidate or the coarse guess
+		bool BlockGranular = false; // [Block Motion] BlockMatching/3DRS keep one vector per block (see GetBlockMotion)
+		bool AggregateCost = false; // [Cost Aggregation] Per-pixel BlockMatching with a BlockSize window SAD
+		bool InvertBackward = false; // [Flow Inversion] BiDir: backward field from the forward one (windowed cost only)
+		bool EnableGlobalMotion = false; // [Global Motion] Camera motion fitted to last frame's vectors seeds the coarsest level
+		bool EnablePhaseCorrelation = false; // [Phase Correlation] Per-tile correlation peaks join the coarsest level's candidates
+		bool EnableAdaptiveRadius = false; // [Adaptive Radius] Reach and levels from last frame's motion, searchRadius is the cap
+	};
+
+	// [Luma Pyramid] Every entry point matches luma.GetCurrent() against luma.GetPrevious(), coarser
+	// levels come from the same pyramid (built once per frame by the caller, never here)
+	void Dispatch(ID3D11DeviceContext* context, 
+		const LumaPyramid& luma, 
+		ID3D11Texture2D* outputMotion,
+		int blockSize, int searchRadius,
+		int maxLevel, int minLevel,
+		FlowAlgorithm algo,
+		const DispatchOptions& options);
+		
+	// Advanced Features
+	void DispatchBiDirectional(ID3D11DeviceContext* context,
+		const LumaPyramid& luma, 
+		ID3D11Texture2D* outputMotion,
+		int blockSize, int searchRadius,
+		const DispatchOptions& options);
+
+	void DispatchAdaptive(ID3D11DeviceContext* context, 
+		const LumaPyramid& luma, 
+		ID3D11Texture2D* outputMotion,
+		int searchRadius,
+		const DispatchOptions& options);
+
+	// [Scene Cut] Zeroes outputMotion and every motion history, so nothing from before a cut seeds the next frame.
+	// Meant to be recorded under SceneCut::BeginOnCutOnly, the GPU drops it on ordinary frames.
+	void ResetMotion(ID3D11DeviceContext* context, ID3D11Texture2D* outputMotion);
+
+	// [Frame Products] Polynomial expansion (Farneback coefficients / DIS gradients) of luma.GetCurrent(), kept
+	// for the next frame: last frame's expansion is this frame's previous one, so each frame is expanded once.
+	// Call once per real frame outside the scene cut predicate (like LumaPyramid::Build), 'enable' = false
+	// when no expansion-based flow runs this frame (drops the history).
+	void ExpandFrame(ID3D11DeviceContext* context, const LumaPyramid& luma, bool enable);
+
+	// [Tile Hash] FrameHash::GetUnchangedSRV for this frame (16x16 tiles of the 'flowWidth' wide flow input),
+	// nullptr = off. Unchanged tiles get zero motion without a search in every search pass.
+	void SetUnchangedTiles(ID3D11ShaderResourceView* unchangedTiles, int flowWidth) { m_UnchangedTilesSRV = unchangedTiles; m_UnchangedFlowWidth = flowWidth; }
+
+private:
+	// Implementation of Hierarchical Search
+	// [Pyramid] BlockMatching from maxLevel down to minLevel (Pyramid::Schedule per level), each level refining the
+	// upsampled result of the coarser one. The finest searched level is upsampled into 'output' (level 0).
+	void SearchPyramid(ID3D11DeviceContext* context,
+		const LumaPyramid& luma,
+		ID3D11Texture2D* output,
+		int blockSize, int searchRadius,
+		int maxLevel, int minLevel,
+		bool enableSubPixel, bool warmStart, bool trustPrediction,
+		bool aggregateCost, bool globalSeed = false, bool tileCandidates = false);
+	// [Guided Upsample] Joint bilateral when both luma guides (the levels of outputHighRes and inputLowRes) are given,
+	// nearest otherwise
+	void Upsample(ID3D11DeviceContext* context, ID3D11Texture2D* inputLowRes, ID3D11Texture2D* outputHighRes,
+		ID3D11Texture2D* guideHighRes = nullptr, ID3D11Texture2D* guideLowRes = nullptr);
+	void BlockMatching(ID3D11DeviceContext* context, 
+		ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion, 
+		ID3D11Texture2D* initMotion,
+		int blockSize, int searchRadius, bool enableSubPixel,
+		ID3D11Texture2D* predictedMotion = nullptr,
+		bool aggregateCost = false,
+		ID3D11Texture2D* tileCandidates = nullptr, float candidateScale = 1.0f,
+		bool tiles = false, // [Hybrid Flow] Only the BlockMatching list's tiles (CSTiles, indirect)
+		bool tileRadius = false); // [Adaptive Radius] Narrow the window per tile to m_TexTileRadius
+		
+	// New Implementation for Adaptive
+	void CalcVariance(ID3D11DeviceContext* context, ID3D11Texture2D* input, ID3D11Texture2D* outputVar);
+	// [Occlusion] Forward/backward agreement into m_TexVisibility, fwd with its occluded vectors repaired into output
+	void CheckConsistency(ID3D11DeviceContext* context, ID3D11Texture2D* fwd, ID3D11Texture2D* bwd, ID3D11Texture2D* output);
+
+	// [Temporal Warm-Start]
+	// Reads back last frame's residual and returns true if a motion history exists to project
+	bool BeginWarmStart(ID3D11DeviceContext* context, bool enable);
+	// Projects the history onto the pyramid level of 'current' (the first call per frame also measures the residual)
+	void ProjectMotion(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* output);
+	void StoreMotionHistory(ID3D11DeviceContext* context, ID3D11Texture2D* finalMotion, bool enable);
+
+	// [Global Motion]
+	// Fits the last read back samples (phase correlation when no model explains them), true if a model seeds this frame
+	bool BeginGlobalMotion(ID3D11DeviceContext* context, bool enable);
+	// The model's motion at every pixel of 'output' (any pyramid level)
+	void SeedGlobalMotion(ID3D11DeviceContext* context, ID3D11Texture2D* output);
+	// Samples 'finalMotion' and the coarsest luma level into the readback buffer (read one frame late, never stalls)
+	void GatherGlobalMotion(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* finalMotion);
+
+	// [Adaptive Radius]
+	// Feeds the last read back stats to m_AdaptiveRadius, true if its reach applies this frame
+	bool BeginAdaptiveRadius(ID3D11DeviceContext* context, bool enable, int maxRadius);
+	// CS_MotionStats of the final field: the readback for the controller, m_TexTileRadius for the next frame
+	void MeasureMotion(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* finalMotion, int searchedRadius);
+
+	// [Phase Correlation] CS_PhaseCorrelation over the tiles of luma level m_CandidateLevel into m_TexTileCandidates
+	void PhaseCorrelateTiles(ID3D11DeviceContext* context, const LumaPyramid& luma);
+
+	// [3DRS] One vector per block, expanded to outputMotion unless outputMotion is null
+	void RecursiveSearch(ID3D11DeviceContext* context,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion,
+		int blockSize, bool enableSubPixel);
+	void RecursiveSearchPass(ID3D11DeviceContext* context,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev,
+		ID3D11Texture2D* spatialField, ID3D11Texture2D* temporalField, ID3D11Texture2D* outputField,
+		int blockSize, int scanDirection, bool enableSubPixel);
+	void ExpandBlockField(ID3D11DeviceContext* context, ID3D11Texture2D* blockField, ID3D11Texture2D* outputMotion, int blockSize);
+	bool EnsureBlockFields(ID3D11DeviceContext* context, int blockSize);
+
+	// [Flow Inversion] Splat the forward field onto the previous frame, fill holes and re-search only
+	// empty / poorly matched pixels (CS_FlowSplat + CS_FlowInvert)
+	void InvertFlow(ID3D11DeviceContext* context,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev,
+		ID3D11Texture2D* forward, ID3D11Texture2D* outputBackward);
+
+	// CS_Farneback_Expansion of 'frame' into 'poly'
+	void Expand(ID3D11DeviceContext* context, ID3D11Texture2D* frame, ID3D11Texture2D* poly);
+	// [Farneback & DIS] Initial guess of the full resolution refinement into m_TexMotionUpsampled: the projected
+	// history, the coarse levels or (no pyramid) a full resolution search, which also stays in outputMotion (returns true)
+	bool InitRefinement(ID3D11DeviceContext* context, const LumaPyramid& luma, ID3D11Texture2D* outputMotion,
+		int blockSize, int searchRadius, int maxLevel, int minLevel,
+		bool warmStart, bool trustPrediction, bool aggregateCost, bool globalSeed, bool tileCandidates);
+	// Farneback or DIS from m_TexMotionUpsampled into outputMotion, over the frame or [Hybrid Flow] the tiles of its list
+	void Refine(ID3D11DeviceContext* context, FlowAlgorithm algo,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion, bool tiles = false);
+
+	// [Hybrid Flow] CS_FlowSelect: CSSelect (algorithm per tile from m_TexVarianceGrid and last frame's stats into the
+	// tile lists and their indirect arguments), CSStats (residual and motion spread of the refined field)
+	void SelectTiles(ID3D11DeviceContext* context);
+	void MeasureTiles(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* motion);
+
+	// [Quadtree] Variable block size search (32x32 down to 4x4) driven by m_TexVarianceGrid and the match residual
+	void QuadtreeSearch(ID3D11DeviceContext* context,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev, ID3D11Texture2D* outputMotion,
+		int searchRadius, bool enableSubPixel, bool useHistory);
+
+	// [Block Motion] Full search with block-aggregated SAD, result in m_TexBlockHistory
+	void BlockSearch(ID3D11DeviceContext* context,
+		ID3D11Texture2D* current, ID3D11Texture2D* prev,
+		int blockSize, int searchRadius, bool enableSubPixel);
+
+	ComPtr<ID3D11ComputeShader> m_csUpsample;
+	ComPtr<ID3D11ComputeShader> m_csBlockMatching;
+	
+	// New Shaders
+	ComPtr<ID3D11ComputeShader> m_csBidirectionalConsistency;
+	ComPtr<ID3D11ComputeShader> m_csAdaptiveVariance;
+	
+	// Helper to store pyramid levels
+	std::vector<ComPtr<ID3D11Texture2D>> m_PyramidLevels;
+	
+	struct CBuffer
+	{
+		int Width;
+		int Height;
+		int BlockSize;
+		int SearchRadius;
+		int EnableSubPixel;
+		int UseInitMotion;
+		int UsePredictedMotion;
+		int UnchangedTileSize; // [Tile Hash] Level pixels per unchanged tile, 0 = no mask
+		int UseTileCandidates; // [Phase Correlation]
+		float CandidateScale; // Level pixels per pixel of m_CandidateLevel
+		int UseTileRadius; // [Adaptive Radius]
+		float TileRadiusScale; // Level pixels per flow pixel
+	};
+	
+	struct CBConsistency {
+		float Tolerance;
+		int Scale;
+		int RepairRadius;
+		float Padding;
+	};
+
+	ComPtr<ID3D11Buffer> m_cbConsistency;
+	bool m_VisibilityValid = false; // Last dispatch was BiDir and filled m_TexVisibility
+
+	// [Guided Upsample]
+	struct CBUpsample {
+		int UseGuide;
+		float RangeSigma;
+		float Padding[2];
+	};
+
+	ComPtr<ID3D11Buffer> m_cbUpsample;
+
+	struct CBVariance {
+		float Threshold; // For Adaptive
+		float Padding[3];
+	};
+	
+	ComPtr<ID3D11Buffer> m_ConstantBuffer;
+	ComPtr<ID3D11Buffer> m_cbVariance; // New CB
+
+	// [Cost Aggregation] Same bindings and CBuffer as m_csBlockMatching, one group per tile
+	ComPtr<ID3D11ComputeShader> m_csCostAggregation;
+	static constexpr int MaxAggregationWindow = 32; // CS_CostAggregation groupshared apron
+	
+	ComPtr<ID3D11ComputeShader> m_csMotionSmooth;
+	ComPtr<ID3D11Texture2D> m_TexSmoothTemp; // Temp buffer for smoothing
+	
+	// Resources for BiDir/Adaptive
+	ComPtr<ID3D11Texture2D> m_TexMotionBackward; // for BiDir
+	ComPtr<ID3D11Texture2D> m_TexVisibility;     // for BiDir, RG8 (see CS_BidirectionalConsistency)
+	ComPtr<ID3D11Texture2D> m_TexVarianceGrid;   // for Adaptive
+	
+	// Hierarchy Resources, the frame levels themselves live in the LumaPyramid
+	ComPtr<ID3D11Texture2D> m_TexMotionLevels[Pyramid::MaxLevels]; // [Pyramid] Motion per level, [0] is the caller's output
+	ComPtr<ID3D11Texture2D> m_TexMotionUpsampled; // Upsampled motion for init
+	
+	// Scene Change Stats
+	ComPtr<ID3D11Buffer> m_GlobalStatsBuffer;
+	ComPtr<ID3D11UnorderedAccessView> m_GlobalStatsUAV;
+	ComPtr<ID3D11ShaderResourceView> m_GlobalStatsSRV;
+
+	// [Tile Hash] Set every frame by the caller, not owned
+	ID3D11ShaderResourceView* m_UnchangedTilesSRV = nullptr;
+	int m_UnchangedFlowWidth = 0;
+	
+	// Advanced Optical Flow
+	ComPtr<ID3D11ComputeShader> m_csFarnebackExpansion;
+	ComPtr<ID3D11ComputeShader> m_csFarnebackFlow;
+	ComPtr<ID3D11ComputeShader> m_csDISFlow;
+	
+	ComPtr<ID3D11Texture2D> m_TexPoly[2]; // [Frame Products] Coeffs, swapped every ExpandFrame
+	int m_PolyIndex = 0; // Current frame's slot, the other one is the previous frame's
+	bool m_PolyCurrValid = false; // ExpandFrame expanded this frame
+	bool m_PolyPrevValid = false; // ... and the last one
+	ID3D11Texture2D* GetPolyCurr() const { return m_TexPoly[m_PolyIndex].Get(); }
+	ID3D11Texture2D* GetPolyPrev() const { return m_TexPoly[m_PolyIndex ^ 1].Get(); }
+
+	// [Temporal Warm-Start]
+	struct CBMotionProject {
+		float ResidualTolerance;
+		float Padding[3];
+	};
+
+	ComPtr<ID3D11ComputeShader> m_csMotionProject;
+	ComPtr<ID3D11Buffer> m_cbMotionProject;
+	ComPtr<ID3D11Texture2D> m_TexMotionHistory; // Last frame's final motion
+	ComPtr<ID3D11Texture2D> m_TexMotionPredicted; // Projected history at full flow res
+	ComPtr<ID3D11Texture2D> m_TexMotionInitLevels[Pyramid::MaxLevels]; // Init / prediction per level, [0] is m_TexMotionUpsampled
+
+	ComPtr<ID3D11Buffer> m_WarmStartStatsBuffer; // [0] = Poorly predicted pixels
+	ComPtr<ID3D11UnorderedAccessView> m_WarmStartStatsUAV;
+	ComPtr<ID3D11Buffer> m_WarmStartStatsStaging; // Read back one frame late (never stalls)
+
+	bool m_HasMotionHistory = false;
+	bool m_WarmStartMeasured = false; // Residual already measured this frame
+	bool m_WarmStartPending = false; // Staging copy in flight
+	UINT m_WarmStartPendingPixels = 0;
+	float m_WarmStartResidual = 1.0f; // Last read back fraction, 1.0 = untrusted
+
+	// [Global Motion]
+	struct CBGlobalMotion {
+		float Row0[4];
+		float Row1[4];
+		float Row2[4];
+		float LevelScale;
+		int SampleGrid;
+		int ThumbnailSize;
+		float Padding;
+	};
+
+	static constexpr int GlobalMotionMaxAge = 2; // Frames a readback may lag before its model is dropped
+	static constexpr int GlobalReadbackFloats = GlobalMotion::SampleGrid * GlobalMotion::SampleGrid * 4 +
+		2 * GlobalMotion::ThumbnailSize * GlobalMotion::ThumbnailSize;
+
+	ComPtr<ID3D11ComputeShader> m_csGlobalGather;
+	ComPtr<ID3D11ComputeShader> m_csGlobalThumbnail;
+	ComPtr<ID3D11ComputeShader> m_csGlobalSeed;
+	ComPtr<ID3D11Buffer> m_cbGlobalMotion;
+	ComPtr<ID3D11Buffer> m_GlobalReadbackBuffer;
+	ComPtr<ID3D11UnorderedAccessView> m_GlobalReadbackUAV;
+	ComPtr<ID3D11Buffer> m_GlobalReadbackStaging;
+	ComPtr<ID3D11Texture2D> m_TexGlobalSeedLevels[Pyramid::MaxLevels]; // Seed per level, apart from the warm-start prediction
+
+	GlobalMotion m_GlobalMotion;
+	bool m_GlobalPending = false; // Staging copy in flight
+	int m_GlobalPendingAge = 0; // Frames since it was issued
+	bool m_GlobalValid = false; // m_GlobalMotion holds a model for this frame
+
+	// [Phase Correlation] One candidate pair per PhaseCorrelation::TileSize tile of luma level m_CandidateLevel
+	ComPtr<ID3D11ComputeShader> m_csPhaseCorrelation;
+	ComPtr<ID3D11Texture2D> m_TexTileCandidates; // RGBA16F, see CS_PhaseCorrelation
+	int m_CandidateLevel = 0;
+
+	// [Adaptive Radius] Stats of the final field, read back one frame late; per-tile bounds stay on the GPU
+	struct CBMotionStats {
+		int TilesX;
+		int TilesY;
+		float Margin;
+		float Padding;
+	};
+
+	ComPtr<ID3D11ComputeShader> m_csMotionTileStats;
+	ComPtr<ID3D11ComputeShader> m_csMotionTileRadius;
+	ComPtr<ID3D11Buffer> m_cbMotionStats;
+	ComPtr<ID3D11Buffer> m_MotionStatsBuffer; // AdaptiveRadius::ReadbackSize uints
+	ComPtr<ID3D11UnorderedAccessView> m_MotionStatsUAV;
+	ComPtr<ID3D11Buffer> m_MotionStatsStaging;
+	ComPtr<ID3D11Texture2D> m_TexTileMotionMax; // Longest vector per FlowTuning::FlowTileSize tile (R16F)
+	ComPtr<ID3D11Texture2D> m_TexTileRadius; // Next frame's bound per tile, flow pixels (R16F)
+
+	AdaptiveRadius m_AdaptiveRadius;
+	bool m_AdaptivePending = false; // Staging copy in flight
+	int m_AdaptivePendingRadius = 0; // Reach the measured frame was searched with
+	bool m_TileRadiusValid = false; // m_TexTileRadius holds last frame's bounds
+	bool m_TileRadiusActive = false; // ... and they narrow this frame's coarsest search
+
+	// [3DRS]
+	struct CBRecursiveSearch {
+		int Width;
+		int Height;
+		int BlockSize;
+		int ScanDirection;
+		int FrameIndex;
+		int EnableSubPixel;
+		int Padding[2];
+	};
+
+	struct CBMotionExpand {
+		int BlockSize;
+		int Padding[3];
+	};
+
+	ComPtr<ID3D11ComputeShader> m_csRecursiveSearch;
+	ComPtr<ID3D11ComputeShader> m_csMotionExpand;
+	ComPtr<ID3D11Buffer> m_cbRecursiveSearch;
+	ComPtr<ID3D11Buffer> m_cbMotionExpand;
+
+	// [Block Motion]
+	struct CBBlockSearch {
+		int Width;
+		int Height;
+		int BlockSize;
+		int SearchRadius;
+		int EnableSubPixel;
+		int UseInitField;
+		int Decimation;
+		int Padding;
+	};
+
+	static constexpr int MaxBlockSize = 32; // CS_BlockSearch groupshared cache
+
+	ComPtr<ID3D11ComputeShader> m_csBlockSearch;
+	ComPtr<ID3D11Buffer> m_cbBlockSearch;
+
+	// Block-res fields, (re)created when the block size changes
+	ComPtr<ID3D11Texture2D> m_TexBlockField; // Forward scan result
+	ComPtr<ID3D11Texture2D> m_TexBlockFieldReverse; // Reverse scan result (final)
+	ComPtr<ID3D11Texture2D> m_TexBlockHistory; // Last frame's final block field
+	int m_BlockFieldSize = 0; // Block size the fields were created for
+	bool m_BlockMotionValid = false; // Last Dispatch left its result as a block field only
+	int m_FlowWidth = 0;
+	int m_FlowHeight = 0;
+	int m_FrameIndex = 0;
+
+	// [Quadtree]
+	struct CBQuadtree {
+		int Width;
+		int Height;
+		int NodeSize;
+		int SearchRadius;
+		int EnableSubPixel;
+		int UseHistory;
+		float VarianceThreshold;
+		float ResidualThreshold;
+	};
+
+	ComPtr<ID3D11ComputeShader> m_csQuadtreeSearch;
+	ComPtr<ID3D11Buffer> m_cbQuadtree;
+	ComPtr<ID3D11Texture2D> m_TexQuadField; // One vector per 4x4 cell
+	ComPtr<ID3D11Texture2D> m_TexQuadParent; // Snapshot before each pass (parents and neighbours)
+	ComPtr<ID3D11Texture2D> m_TexQuadHistory; // Last frame's leaf field
+	ComPtr<ID3D11Texture2D> m_TexQuadSize; // Node size owning each cell (R32_UINT)
+
+	// [Flow Inversion]
+	struct CBFlowInvert {
+		int Width;
+		int Height;
+		int RefineRadius;
+		float CostTolerance;
+	};
+
+	ComPtr<ID3D11ComputeShader> m_csFlowSplat;
+	ComPtr<ID3D11ComputeShader> m_csFlowInvert;
+	ComPtr<ID3D11Buffer> m_cbFlowInvert;
+	ComPtr<ID3D11Texture2D> m_TexFlowSplat; // Packed claims (R32_UINT)
+
+	// [Hybrid Flow] BlockMatching, Farneback or DIS per FlowTileSize tile, each run indirectly over its own tile list
+	struct CBFlowSelect {
+		int TilesX;
+		int TilesY;
+		int MaxTiles;
+		int UseStats;
+		float FlatVariance;
+		float LowResidual;
+		float HighResidual;
+		float MaxSpread;
+	};
+
+	static constexpr int HybridAlgorithms = 3; // BlockMatching, Farneback, DIS: the FlowAlgorithm values below Hybrid
+
+	ComPtr<ID3D11ComputeShader> m_csFlowStats;
+	ComPtr<ID3D11ComputeShader> m_csFlowSelect;
+	ComPtr<ID3D11ComputeShader> m_csBlockMatchingTiles;
+	ComPtr<ID3D11ComputeShader> m_csCostAggregationTiles;
+	ComPtr<ID3D11ComputeShader> m_csFarnebackFlowTiles;
+	ComPtr<ID3D11ComputeShader> m_csDISFlowTiles;
+	ComPtr<ID3D11Buffer> m_cbFlowSelect;
+	ComPtr<ID3D11Texture2D> m_TexTileAlgorithm; // FlowAlgorithm per tile (R32_UINT), last frame's until CSSelect
+	ComPtr<ID3D11Texture2D> m_TexTileStats; // (residual, spread) per tile of the last hybrid field
+	ComPtr<ID3D11Buffer> m_TileListBuffer; // HybridAlgorithms lists of m_MaxTiles packed tiles (x | y << 16)
+	ComPtr<ID3D11UnorderedAccessView> m_TileListUAV;
+	ComPtr<ID3D11ShaderResourceView> m_TileListSRV[HybridAlgorithms]; // One list each
+	ComPtr<ID3D11Buffer> m_TileArgsBuffer; // DispatchIndirect (count, 1, 1) per list
+	ComPtr<ID3D11UnorderedAccessView> m_TileArgsUAV;
+	int m_MaxTiles = 0;
+	bool m_TileStatsValid = false; // Last Dispatch was Hybrid and measured m_TexTileStats
+
+public:
+	ID3D11ShaderResourceView* GetStatsSRV() const { return m_GlobalStatsSRV.Get(); }
+	ID3D11Texture2D* GetVarianceGrid() const { return m_TexVarianceGrid.Get(); } // Expose for debugging if needed
+	float GetWarmStartResidual() const { return m_WarmStartResidual; }
+	// [Global Motion] Model seeding the current frame (Type None when off or nothing fitted)
+	GlobalMotion::Estimate GetGlobalMotion() const { return m_GlobalValid ? m_GlobalMotion.GetEstimate() : GlobalMotion::Estimate(); }
+	// [Adaptive Radius] Reach of the current frame for a 'maxRadius' Search Radius
+	int GetAdaptiveRadius(int maxRadius) const { return m_AdaptiveRadius.GetRadius(maxRadius); }
+
+	// [Block Motion] Block field of the last Dispatch (nullptr when it wrote per-pixel motion)
+	ID3D11Texture2D* GetBlockMotion() const { return m_BlockMotionValid ? m_TexBlockHistory.Get() : nullptr; }
+	int GetBlockMotionSize() const { return m_BlockMotionValid ? m_BlockFieldSize : 1; }
+
+	// [Occlusion] Visibility map of the last DispatchBiDirectional (nullptr after the other paths)
+	ID3D11Texture2D* GetVisibility() const { return m_VisibilityValid ? m_TexVisibility.Get() : nullptr; }
+	int GetVisibilityScale() const { return FlowTuning::VisibilityScale; }
+
+	// [Hybrid Flow] FlowAlgorithm per FlowTileSize tile of the last hybrid Dispatch (nullptr after the other algorithms)
+	ID3D11Texture2D* GetTileAlgorithms() const { return m_TileStatsValid ? m_TexTileAlgorithm.Get() : nullptr; }
+};
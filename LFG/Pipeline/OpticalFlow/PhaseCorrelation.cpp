@@ -0,0 +1,236 @@
+#include "PhaseCorrelation.h"
+
+#include <cmath>
+#include <algorithm>
+
+// SSE2 is baseline on x64, the scalar loops cover everything else
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LFG_CPU_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	constexpr int PeakExclusion = 2; // Neighbours of a peak that only hold its sub-pixel spread
+	constexpr int MaxPeaks = 4;
+
+	// In-place radix-2 FFT down every column of an n x n plane, inverse without the 1/n scale.
+	// A butterfly pairs two rows, so the columns are independent lanes.
+	void ColumnFFT(float* re, float* im, int n, const float* cosTable, const float* sinTable, bool inverse)
+	{
+		for (int i = 1, j = 0; i < n; ++i)
+		{
+			int bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j)
+			{
+				std::swap_ranges(re + i * n, re + (i + 1) * n, re + j * n);
+				std::swap_ranges(im + i * n, im + (i + 1) * n, im + j * n);
+			}
+		}
+
+		for (int len = 2; len <= n; len <<= 1)
+		{
+			const int half = len / 2;
+			const int step = n / len;
+			for (int start = 0; start < n; start += len)
+			{
+				for (int k = 0; k < half; ++k)
+				{
+					const float wRe = cosTable[k * step];
+					const float wIm = inverse ? -sinTable[k * step] : sinTable[k * step];
+					float* aRe = re + (start + k) * n;
+					float* aIm = im + (start + k) * n;
+					float* bRe = aRe + half * n;
+					float* bIm = aIm + half * n;
+
+					int x = 0;
+#ifdef LFG_CPU_SSE2
+					const __m128 vRe = _mm_set1_ps(wRe);
+					const __m128 vIm = _mm_set1_ps(wIm);
+					for (; x + 4 <= n; x += 4)
+					{
+						__m128 br = _mm_loadu_ps(bRe + x);
+						__m128 bi = _mm_loadu_ps(bIm + x);
+						__m128 tRe = _mm_sub_ps(_mm_mul_ps(br, vRe), _mm_mul_ps(bi, vIm));
+						__m128 tIm = _mm_add_ps(_mm_mul_ps(br, vIm), _mm_mul_ps(bi, vRe));
+						__m128 ar = _mm_loadu_ps(aRe + x);
+						__m128 ai = _mm_loadu_ps(aIm + x);
+						_mm_storeu_ps(bRe + x, _mm_sub_ps(ar, tRe));
+						_mm_storeu_ps(bIm + x, _mm_sub_ps(ai, tIm));
+						_mm_storeu_ps(aRe + x, _mm_add_ps(ar, tRe));
+						_mm_storeu_ps(aIm + x, _mm_add_ps(ai, tIm));
+					}
+#endif
+					for (; x < n; ++x)
+					{
+						float tRe = bRe[x] * wRe - bIm[x] * wIm;
+						float tIm = bRe[x] * wIm + bIm[x] * wRe;
+						bRe[x] = aRe[x] - tRe;
+						bIm[x] = aIm[x] - tIm;
+						aRe[x] += tRe;
+						aIm[x] += tIm;
+					}
+				}
+			}
+		}
+	}
+
+	void Transpose(float* plane, int n)
+	{
+		for (int y = 0; y < n; ++y)
+		{
+			for (int x = y + 1; x < n; ++x) std::swap(plane[y * n + x], plane[x * n + y]);
+		}
+	}
+
+	// Sub-pixel offset of a correlation peak 'c' between its neighbours 'l' and 'r': a shifted impulse spreads
+	// over the two samples it falls between in proportion to its distance to them
+	float PeakOffset(float l, float c, float r)
+	{
+		if (r >= l && r > 0.0f) return r / (r + c);
+		if (l > 0.0f) return -l / (l + c);
+		return 0.0f;
+	}
+}
+
+PhaseCorrelation::PhaseCorrelation(int size)
+{
+	m_Size = size;
+	const size_t planeSize = (size_t)size * size;
+	m_Re.resize(planeSize);
+	m_Im.resize(planeSize);
+	m_CrossRe.resize(planeSize);
+	m_CrossIm.resize(planeSize);
+
+	m_Window.resize(size);
+	for (int i = 0; i < size; ++i) m_Window[i] = 0.5f - 0.5f * std::cos(6.2831853f * (i + 0.5f) / size);
+
+	m_Cos.resize(size / 2);
+	m_Sin.resize(size / 2);
+	for (int k = 0; k < size / 2; ++k)
+	{
+		double angle = -2.0 * 3.14159265358979323846 * k / size;
+		m_Cos[k] = (float)std::cos(angle);
+		m_Sin[k] = (float)std::sin(angle);
+	}
+}
+
+void PhaseCorrelation::Transform(float* re, float* im, bool inverse)
+{
+	const int n = m_Size;
+	ColumnFFT(re, im, n, m_Cos.data(), m_Sin.data(), inverse);
+	Transpose(re, n);
+	Transpose(im, n);
+	ColumnFFT(re, im, n, m_Cos.data(), m_Sin.data(), inverse);
+}
+
+int PhaseCorrelation::Correlate(const float* current, const float* previous, int stride, Peak* peaks, int maxPeaks)
+{
+	const int n = m_Size;
+	const int mask = n - 1;
+	if (!current || !previous || !peaks || maxPeaks <= 0 || n < 4) return 0;
+
+	// Mean removed and Hann windowed, so the patch borders do not correlate with themselves
+	double meanCurrent = 0.0, meanPrevious = 0.0;
+	for (int y = 0; y < n; ++y)
+	{
+		for (int x = 0; x < n; ++x)
+		{
+			meanCurrent += current[y * stride + x];
+			meanPrevious += previous[y * stride + x];
+		}
+	}
+	const float mc = (float)(meanCurrent / ((double)n * n));
+	const float mp = (float)(meanPrevious / ((double)n * n));
+
+	for (int y = 0; y < n; ++y)
+	{
+		for (int x = 0; x < n; ++x)
+		{
+			float w = m_Window[x] * m_Window[y];
+			m_Re[y * n + x] = (current[y * stride + x] - mc) * w;
+			m_Im[y * n + x] = (previous[y * stride + x] - mp) * w;
+		}
+	}
+	Transform(m_Re.data(), m_Im.data(), false);
+
+	// Both spectra out of the one transform (real inputs: C(k) = (Z(k) + Z*(-k)) / 2, P(k) = (Z(k) - Z*(-k)) / 2i),
+	// then the normalised cross-power C P*: only the phase difference, i.e. the shift, is left.
+	// The 1/2 factors cancel in the normalisation, the -k pairing does not care about the transposed layout.
+	for (int r = 0; r < n; ++r)
+	{
+		for (int c = 0; c < n; ++c)
+		{
+			const int i = r * n + c;
+			const int j = ((n - r) & mask) * n + ((n - c) & mask);
+			float cRe = m_Re[i] + m_Re[j];
+			float cIm = m_Im[i] - m_Im[j];
+			float pRe = m_Im[i] + m_Im[j];
+			float pIm = m_Re[j] - m_Re[i];
+
+			float re = cRe * pRe + cIm * pIm;
+			float im = cIm * pRe - cRe * pIm;
+			float magnitude = std::sqrt(re * re + im * im);
+			if (i == 0 || magnitude < 1e-12f)
+			{
+				// DC carries no shift
+				m_CrossRe[i] = m_CrossIm[i] = 0.0f;
+				continue;
+			}
+			m_CrossRe[i] = re / magnitude;
+			m_CrossIm[i] = im / magnitude;
+		}
+	}
+	Transform(m_CrossRe.data(), m_CrossIm.data(), true);
+
+	const float* surface = m_CrossRe.data();
+	auto at = [&](int x, int y) { return surface[(size_t)(y & mask) * n + (x & mask)]; };
+	const float scale = 1.0f / ((float)n * n);
+
+	maxPeaks = std::min(maxPeaks, MaxPeaks);
+	int peakX[MaxPeaks], peakY[MaxPeaks];
+	int found = 0;
+	for (; found < maxPeaks; ++found)
+	{
+		int px = -1, py = -1;
+		float best = 0.0f;
+		for (int y = 0; y < n; ++y)
+		{
+			for (int x = 0; x < n; ++x)
+			{
+				// Toroidal distance to the stronger peaks
+				bool excluded = false;
+				for (int k = 0; k < found && !excluded; ++k)
+				{
+					int dx = std::abs(x - peakX[k]); dx = std::min(dx, n - dx);
+					int dy = std::abs(y - peakY[k]); dy = std::min(dy, n - dy);
+					excluded = dx <= PeakExclusion && dy <= PeakExclusion;
+				}
+				if (excluded) continue;
+
+				if (px < 0 || surface[y * n + x] > best)
+				{
+					best = surface[y * n + x];
+					px = x;
+					py = y;
+				}
+			}
+		}
+		if (px < 0) break;
+
+		float fx = px + PeakOffset(at(px - 1, py), at(px, py), at(px + 1, py));
+		float fy = py + PeakOffset(at(px, py - 1), at(px, py), at(px, py + 1));
+		if (fx > n / 2) fx -= n;
+		if (fy > n / 2) fy -= n;
+
+		// current(p) = previous(p + d) puts the peak at -d
+		peaks[found].X = -fx;
+		peaks[found].Y = -fy;
+		peaks[found].Height = best * scale;
+		peakX[found] = px;
+		peakY[found] = py;
+	}
+	return found;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+
+// [Phase Correlation] Translation between two n x n luma patches from the phase of their cross-power spectrum:
+// O(n^2 log n) whatever the shift, where a block search grows with the square of its radius.
+// Plain CPU code shared by GlobalMotion (whole-frame thumbnails) and CPUOpticalFlow (tile candidates, the port of
+// CS_PhaseCorrelation.hlsl). Both frames go through one complex FFT (current as the real part, previous as the
+// imaginary part), the columns four at a time with SSE2.
+class PhaseCorrelation
+{
+public:
+	// Shift 'X, Y' with current(p) = previous(p + (X, Y)), the flow convention.
+	// Height is the normalised correlation at the peak (1 = identical shifted patches).
+	struct Peak
+	{
+		float X = 0.0f, Y = 0.0f;
+		float Height = 0.0f;
+	};
+
+	// 'size' x 'size' patches, a power of two from 4
+	explicit PhaseCorrelation(int size = TileWindow);
+	~PhaseCorrelation() = default;
+
+	int GetSize() const { return m_Size; }
+
+	// Mean removed, Hann windowed correlation of two patches ('stride' floats per row). Writes up to 'maxPeaks' (4)
+	// separate peaks, strongest first, and returns how many. Allocation free.
+	int Correlate(const float* current, const float* previous, int stride, Peak* peaks, int maxPeaks);
+
+	// [Tile Candidates] Tiled estimator run before the coarsest search (OpticalFlow::PhaseCorrelateTiles /
+	// CPUOpticalFlow::PhaseCorrelateTiles), must match CS_PhaseCorrelation.hlsl
+	static constexpr int TileSize = 16; // One candidate pair per tile
+	static constexpr int TileWindow = 32; // Patch correlated around each tile, shifts up to +-TileWindow / 2
+	static constexpr int CandidateLevel = 2; // Pyramid level the tiles are taken from (the coarsest one when shallower)
+	static constexpr int Candidates = 2; // Peaks kept per tile (camera and one moving layer)
+	static constexpr float MinTilePeak = 0.1f; // Weaker peaks are noise, the candidate falls back to zero motion
+
+private:
+	// Forward: columns, transpose, columns (the spectrum comes out transposed).
+	// The same sequence inverts it back into the original orientation.
+	void Transform(float* re, float* im, bool inverse);
+
+	int m_Size = 0;
+	std::vector<float> m_Window; // Hann, per row / column
+	std::vector<float> m_Cos; // Twiddles, m_Size / 2 each
+	std::vector<float> m_Sin;
+	std::vector<float> m_Re; // Spectrum planes, m_Size^2 each
+	std::vector<float> m_Im;
+	std::vector<float> m_CrossRe;
+	std::vector<float> m_CrossIm;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+// [Pyramid] Coarse-to-fine layout and search schedule.
+// Shared by the GPU (LumaPyramid / OpticalFlow) and CPU reference (CPULumaPyramid / CPUOpticalFlow) implementations.
+// Level l is (width >> l) x (height >> l), level 0 is the flow resolution.
+namespace Pyramid
+{
+	constexpr int MaxLevels = 5; // Full down to 1/16 (the UI's Start Level 0 - 4)
+	constexpr int MinLevelSize = 16; // Short side in pixels, a smaller level holds too few blocks to match
+	constexpr int MinBlockSize = 4;
+	constexpr int MinSearchRadius = 2;
+
+	// Levels a width x height frame gets, at least the full resolution one
+	inline int LevelCount(int width, int height)
+	{
+		int count = 1;
+		while (count < MaxLevels && (width >> count) >= MinLevelSize && (height >> count) >= MinLevelSize) ++count;
+		return count;
+	}
+
+	struct Level
+	{
+		int BlockSize;
+		int SearchRadius;
+	};
+
+	// Blocks shrink with the level. The radius does not grow on the way down: the coarsest level covers
+	// 'searchRadius' full resolution pixels, every finer one only corrects the upsampled estimate by the same
+	// per-level window. A large pan gets more levels instead of a wider (quadratically costlier) window.
+	inline Level Schedule(int level, int maxLevel, int blockSize, int searchRadius)
+	{
+		Level result;
+		result.BlockSize = blockSize >> level;
+		if (result.BlockSize < MinBlockSize) result.BlockSize = MinBlockSize;
+		result.SearchRadius = searchRadius >> maxLevel;
+		if (result.SearchRadius < MinSearchRadius) result.SearchRadius = MinSearchRadius;
+		return result;
+	}
+}
@@ -0,0 +1,202 @@
+#include "FrameHash.h"
+#include "../../Pipeline/Shaders/EmbeddedShaders.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+
+using Microsoft::WRL::ComPtr;
+
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+    if (!tex) return;
+    dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+// Structured uint buffer with a UAV and an SRV over all of it
+static bool CreateUintBuffer(ID3D11Device* dev, UINT count, ID3D11Buffer** ppBuffer,
+    ID3D11UnorderedAccessView** ppUAV, ID3D11ShaderResourceView** ppSRV)
+{
+    D3D11_BUFFER_DESC bufDesc = {};
+    bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bufDesc.ByteWidth = count * 4;
+    bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufDesc.StructureByteStride = 4;
+    if (FAILED(dev->CreateBuffer(&bufDesc, nullptr, ppBuffer))) return false;
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = count;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = count;
+
+    return SUCCEEDED(dev->CreateUnorderedAccessView(*ppBuffer, &uavDesc, ppUAV)) &&
+        SUCCEEDED(dev->CreateShaderResourceView(*ppBuffer, &srvDesc, ppSRV));
+}
+
+// R8_UNORM tile grid with a UAV and an SRV
+static bool CreateTileMask(ID3D11Device* dev, int tilesX, int tilesY, ID3D11Texture2D** ppTex,
+    ID3D11UnorderedAccessView** ppUAV, ID3D11ShaderResourceView** ppSRV)
+{
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = tilesX;
+    desc.Height = tilesY;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+    return SUCCEEDED(dev->CreateTexture2D(&desc, nullptr, ppTex)) &&
+        SUCCEEDED(dev->CreateUnorderedAccessView(*ppTex, nullptr, ppUAV)) &&
+        SUCCEEDED(dev->CreateShaderResourceView(*ppTex, nullptr, ppSRV));
+}
+
+bool FrameHash::Initialize(ID3D11Device* device)
+{
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_FrameHash, "CSHash", &m_csHash) ||
+        !Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_FrameHash, "CSMapTiles", &m_csMapTiles))
+    {
+        Debug::Error("Failed to load Frame Hash Shader");
+        return false;
+    }
+
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.Usage = D3D11_USAGE_DEFAULT;
+    cbDesc.ByteWidth = sizeof(CBHash);
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbHash)))
+    {
+        Debug::Error("Failed to create Frame Hash Constant Buffer");
+        return false;
+    }
+
+    if (!CreateUintBuffer(device, StatsSize, &m_StatsBuffer, &m_StatsUAV, &m_StatsSRV))
+    {
+        Debug::Error("Failed to create Frame Hash Stats Buffer");
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameHash::EnsureTiles(ID3D11Device* device, int tilesX, int tilesY)
+{
+    if (m_TexUnchanged && m_TilesX == tilesX && m_TilesY == tilesY) return true;
+
+    m_TilesX = tilesX;
+    m_TilesY = tilesY;
+    m_HasHistory = false;
+    m_TexUnchanged.Reset();
+    m_UnchangedUAV.Reset();
+    m_UnchangedSRV.Reset();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        m_HashBuffers[i].Reset();
+        m_HashUAVs[i].Reset();
+        m_HashSRVs[i].Reset();
+        if (!CreateUintBuffer(device, (UINT)(tilesX * tilesY), &m_HashBuffers[i], &m_HashUAVs[i], &m_HashSRVs[i]))
+        {
+            Debug::Error("Failed to create Frame Hash Buffers");
+            return false;
+        }
+    }
+
+    if (!CreateTileMask(device, tilesX, tilesY, &m_TexUnchanged, &m_UnchangedUAV, &m_UnchangedSRV))
+    {
+        Debug::Error("Failed to create Unchanged Tile Mask");
+        m_TexUnchanged.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameHash::EnsureFlowTiles(ID3D11Device* device, int tilesX, int tilesY)
+{
+    if (m_TexFlowUnchanged && m_FlowTilesX == tilesX && m_FlowTilesY == tilesY) return true;
+
+    m_FlowTilesX = tilesX;
+    m_FlowTilesY = tilesY;
+    m_TexFlowUnchanged.Reset();
+    m_FlowUnchangedUAV.Reset();
+    m_FlowUnchangedSRV.Reset();
+    if (!CreateTileMask(device, tilesX, tilesY, &m_TexFlowUnchanged, &m_FlowUnchangedUAV, &m_FlowUnchangedSRV))
+    {
+        Debug::Error("Failed to create Flow Unchanged Tile Mask");
+        m_TexFlowUnchanged.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool FrameHash::Hash(ID3D11DeviceContext* context, ID3D11Texture2D* frame, int flowWidth, int flowHeight)
+{
+    if (!m_csHash || !m_csMapTiles || !m_StatsUAV || !frame) return false;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    D3D11_TEXTURE2D_DESC desc;
+    frame->GetDesc(&desc);
+    int tilesX = (int)(desc.Width + TileSize - 1) / TileSize;
+    int tilesY = (int)(desc.Height + TileSize - 1) / TileSize;
+    // A scaled flow: its tiles cover other frame pixels than the frame's tiles
+    m_Mapped = flowWidth != (int)desc.Width || flowHeight != (int)desc.Height;
+    int flowTilesX = (flowWidth + TileSize - 1) / TileSize;
+    int flowTilesY = (flowHeight + TileSize - 1) / TileSize;
+    if (!EnsureTiles(dev, tilesX, tilesY) || (m_Mapped && !EnsureFlowTiles(dev, flowTilesX, flowTilesY)))
+    {
+        dev->Release();
+        return false;
+    }
+
+    // [Cycle] Last frame's hashes are the previous ones now
+    m_CurrentIndex ^= 1;
+
+    CBHash cbData = { m_HasHistory ? 1 : 0, 0, { (float)desc.Width / flowWidth, (float)desc.Height / flowHeight } };
+    context->UpdateSubresource(m_cbHash.Get(), 0, nullptr, &cbData, 0, 0);
+
+    ComPtr<ID3D11ShaderResourceView> srvFrame;
+    CreateSRV(dev, frame, &srvFrame);
+
+    dev->Release();
+
+    UINT clearVals[4] = { 0, 0, 0, 0 };
+    context->ClearUnorderedAccessViewUint(m_StatsUAV.Get(), clearVals);
+
+    context->CSSetShader(m_csHash.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* srvs[] = { srvFrame.Get(), m_HashSRVs[m_CurrentIndex ^ 1].Get() };
+    context->CSSetShaderResources(0, 2, srvs);
+    ID3D11UnorderedAccessView* uavs[] = { m_HashUAVs[m_CurrentIndex].Get(), m_UnchangedUAV.Get(), m_StatsUAV.Get() };
+    context->CSSetUnorderedAccessViews(0, 3, uavs, nullptr);
+    context->CSSetConstantBuffers(0, 1, m_cbHash.GetAddressOf());
+
+    context->Dispatch((UINT)tilesX, (UINT)tilesY, 1);
+
+    // Unbind
+    ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr };
+    ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr, nullptr };
+    context->CSSetShaderResources(0, 2, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 3, nullUAVs, nullptr);
+
+    if (m_Mapped)
+    {
+        context->CSSetShader(m_csMapTiles.Get(), nullptr, 0);
+        ID3D11ShaderResourceView* mapSRVs[] = { m_UnchangedSRV.Get() };
+        context->CSSetShaderResources(2, 1, mapSRVs);
+        ID3D11UnorderedAccessView* mapUAVs[] = { m_FlowUnchangedUAV.Get() };
+        context->CSSetUnorderedAccessViews(3, 1, mapUAVs, nullptr);
+
+        context->Dispatch((UINT)(flowTilesX + 7) / 8, (UINT)(flowTilesY + 7) / 8, 1);
+
+        context->CSSetShaderResources(2, 1, nullSRVs);
+        context->CSSetUnorderedAccessViews(3, 1, nullUAVs, nullptr);
+    }
+
+    m_HasHistory = true;
+    return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+
+
+
+// [Tile Hash] Per-tile content hash of every captured frame (xxHash32 rounds over the raw texels, CS_FrameHash),
+// compared on the GPU with last frame's. Tiles that match are handed to the motion searches as unchanged
+// (zero motion, no search), and a frame where every tile matches is a duplicate present (SceneCut skips it).
+// Hashed at capture resolution: a downscaled frame hides changes between the texels it samples.
+class FrameHash
+{
+public:
+    FrameHash() = default;
+    ~FrameHash() = default;
+
+    bool Initialize(ID3D11Device* device);
+
+    // Hashes 'frame' (capture resolution) and compares it with the last frame hashed.
+    // A new size drops the history: nothing is unchanged on that frame. False if the pass is unavailable.
+    // A flow smaller than the frame gets its own tile grid (CSMapTiles): a flow tile is unchanged only if
+    // every frame tile the downscale samples it from is.
+    bool Hash(ID3D11DeviceContext* context, ID3D11Texture2D* frame, int flowWidth, int flowHeight);
+
+    // R8 grid of 16x16 flow resolution tiles, 1 = unchanged (OpticalFlow::SetUnchangedTiles)
+    ID3D11ShaderResourceView* GetUnchangedSRV() const { return m_Mapped ? m_FlowUnchangedSRV.Get() : m_UnchangedSRV.Get(); }
+    // [0] = Changed tiles, [1] = History valid (SceneCut::Detect)
+    ID3D11ShaderResourceView* GetStatsSRV() const { return m_StatsSRV.Get(); }
+
+    static constexpr int TileSize = 16; // TILE_SIZE in CS_FrameHash
+
+private:
+    bool EnsureTiles(ID3D11Device* device, int tilesX, int tilesY);
+    bool EnsureFlowTiles(ID3D11Device* device, int tilesX, int tilesY);
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csHash;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csMapTiles;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_cbHash;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_HashBuffers[2]; // [Current / Previous], swapped every frame
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_HashUAVs[2];
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_HashSRVs[2];
+    int m_CurrentIndex = 0;
+    bool m_HasHistory = false;
+    int m_TilesX = 0;
+    int m_TilesY = 0;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_TexUnchanged;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_UnchangedUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_UnchangedSRV;
+
+    // Tile grid of a scaled flow (CSMapTiles)
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_TexFlowUnchanged;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_FlowUnchangedUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_FlowUnchangedSRV;
+    int m_FlowTilesX = 0;
+    int m_FlowTilesY = 0;
+    bool m_Mapped = false; // This frame's flow is scaled, GetUnchangedSRV is the mapped grid
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_StatsBuffer;
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_StatsUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_StatsSRV;
+
+    struct CBHash {
+        int HasHistory;
+        int Padding;
+        float FrameScale[2]; // Capture pixels per flow pixel (CSMapTiles)
+    };
+
+    static constexpr UINT StatsSize = 2;
+};
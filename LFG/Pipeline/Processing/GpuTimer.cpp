@@ -0,0 +1,115 @@
+#include "GpuTimer.h"
+#include <Debug/Debug.h>
+
+bool GpuTimer::Initialize(ID3D11Device* device)
+{
+    D3D11_QUERY_DESC disjointDesc = { D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+    D3D11_QUERY_DESC timestampDesc = { D3D11_QUERY_TIMESTAMP, 0 };
+    m_Available = false;
+    for (Frame& frame : m_Frames)
+    {
+        frame.Disjoint.Reset();
+        if (FAILED(device->CreateQuery(&disjointDesc, &frame.Disjoint)))
+        {
+            Debug::Error("Failed to create GPU Timer Queries");
+            return false;
+        }
+        for (int i = 0; i < MaxSpans; ++i)
+        {
+            frame.Start[i].Reset();
+            frame.End[i].Reset();
+            if (FAILED(device->CreateQuery(&timestampDesc, &frame.Start[i])) ||
+                FAILED(device->CreateQuery(&timestampDesc, &frame.End[i])))
+            {
+                Debug::Error("Failed to create GPU Timer Queries");
+                frame.Disjoint.Reset();
+                return false;
+            }
+        }
+        frame.Spans = 0;
+        frame.Pending = false;
+    }
+
+    m_Next = 0;
+    m_Oldest = 0;
+    m_FrameOpen = false;
+    m_SpanOpen = false;
+    m_Available = true;
+    return true;
+}
+
+void GpuTimer::BeginFrame(ID3D11DeviceContext* context)
+{
+    Frame& frame = m_Frames[m_Next];
+    if (!m_Available || m_FrameOpen || frame.Pending) return;
+
+    context->Begin(frame.Disjoint.Get());
+    frame.Spans = 0;
+    m_FrameOpen = true;
+}
+
+void GpuTimer::EndFrame(ID3D11DeviceContext* context)
+{
+    if (!m_FrameOpen) return;
+    if (m_SpanOpen) EndSpan(context);
+
+    Frame& frame = m_Frames[m_Next];
+    context->End(frame.Disjoint.Get());
+    frame.Pending = true;
+    m_Next = (m_Next + 1) % FrameLatency;
+    m_FrameOpen = false;
+}
+
+void GpuTimer::BeginSpan(ID3D11DeviceContext* context)
+{
+    Frame& frame = m_Frames[m_Next];
+    if (!m_FrameOpen || m_SpanOpen || frame.Spans >= MaxSpans) return;
+
+    context->End(frame.Start[frame.Spans].Get());
+    m_SpanOpen = true;
+}
+
+void GpuTimer::EndSpan(ID3D11DeviceContext* context)
+{
+    if (!m_SpanOpen) return;
+
+    Frame& frame = m_Frames[m_Next];
+    context->End(frame.End[frame.Spans].Get());
+    ++frame.Spans;
+    m_SpanOpen = false;
+}
+
+bool GpuTimer::Collect(ID3D11DeviceContext* context, float& milliseconds)
+{
+    bool collected = false;
+    while (m_Frames[m_Oldest].Pending)
+    {
+        Frame& frame = m_Frames[m_Oldest];
+
+        // Never flush or wait, the frame is retried next time
+        D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+        if (context->GetData(frame.Disjoint.Get(), &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            break;
+
+        UINT64 ticks = 0;
+        bool ready = true;
+        for (int i = 0; i < frame.Spans && ready; ++i)
+        {
+            UINT64 start = 0, end = 0;
+            ready = context->GetData(frame.Start[i].Get(), &start, sizeof(start), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK &&
+                context->GetData(frame.End[i].Get(), &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+            if (ready && end > start) ticks += end - start;
+        }
+        if (!ready) break;
+
+        frame.Pending = false;
+        m_Oldest = (m_Oldest + 1) % FrameLatency;
+
+        if (!disjoint.Disjoint && disjoint.Frequency > 0 && frame.Spans > 0)
+        {
+            milliseconds = (float)((double)ticks * 1000.0 / (double)disjoint.Frequency);
+            collected = true;
+        }
+    }
+    return collected;
+}
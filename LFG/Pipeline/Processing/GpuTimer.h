@@ -0,0 +1,45 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+
+// [Dynamic Resolution] GPU time of the generation passes per real frame: timestamp pairs around each span
+// (the capture's analysis, every generated frame's synthesis) inside one disjoint query, read back a few frames
+// late without waiting. Recorded on the immediate context, a deferred context's work is timed where it executes.
+class GpuTimer
+{
+public:
+    GpuTimer() = default;
+    ~GpuTimer() = default;
+
+    bool Initialize(ID3D11Device* device);
+    bool IsAvailable() const { return m_Available; }
+
+    // A frame collects spans until EndFrame. Skipped (nothing recorded) while every slot is still in flight.
+    void BeginFrame(ID3D11DeviceContext* context);
+    void EndFrame(ID3D11DeviceContext* context);
+    void BeginSpan(ID3D11DeviceContext* context);
+    void EndSpan(ID3D11DeviceContext* context);
+
+    // Summed spans of the newest frame the GPU finished (ms). False while none is ready or its clock was disjoint.
+    bool Collect(ID3D11DeviceContext* context, float& milliseconds);
+
+    static constexpr int FrameLatency = 4; // Frames in flight
+    static constexpr int MaxSpans = 12; // Capture + up to 10 generated frames (Aggressive Dynamic Ratio)
+
+private:
+    struct Frame
+    {
+        Microsoft::WRL::ComPtr<ID3D11Query> Disjoint;
+        Microsoft::WRL::ComPtr<ID3D11Query> Start[MaxSpans];
+        Microsoft::WRL::ComPtr<ID3D11Query> End[MaxSpans];
+        int Spans = 0;
+        bool Pending = false;
+    };
+
+    Frame m_Frames[FrameLatency];
+    int m_Next = 0; // Slot of the next frame
+    int m_Oldest = 0; // Oldest pending slot
+    bool m_FrameOpen = false;
+    bool m_SpanOpen = false;
+    bool m_Available = false;
+};
@@ -0,0 +1,132 @@
+#include "LumaPyramid.h"
+#include "../../Pipeline/Shaders/EmbeddedShaders.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+#include <cmath>
+
+using Microsoft::WRL::ComPtr;
+
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+    if (!tex) return;
+    dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+static void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
+    if (!tex) return;
+    dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
+}
+
+// 8-bit swapchains lose nothing in R8, wider ones keep their range / precision in R16F
+static DXGI_FORMAT LumaFormat(DXGI_FORMAT sourceFormat)
+{
+    switch (sourceFormat)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return DXGI_FORMAT_R8_UNORM;
+    default:
+        return DXGI_FORMAT_R16_FLOAT;
+    }
+}
+
+bool LumaPyramid::Initialize(ID3D11Device* device, int width, int height, DXGI_FORMAT sourceFormat)
+{
+    // Recorded even on failure, so the caller does not retry every frame at this size
+    m_Width = width;
+    m_Height = height;
+    m_CurrentIndex = 0;
+    m_LevelCount = 0;
+
+    if (!m_csLuma || !m_csDownsample)
+    {
+        if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_LumaPyramid, "CSLuma", &m_csLuma) ||
+            !Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_LumaPyramid, "CSDownsample", &m_csDownsample))
+        {
+            Debug::Error("Failed to load Luma Pyramid Shaders");
+            return false;
+        }
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = LumaFormat(sourceFormat);
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS;
+
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        for (int level = 0; level < Pyramid::MaxLevels; ++level) m_Levels[frame][level].Reset();
+    }
+
+    int levelCount = Pyramid::LevelCount(width, height);
+    for (int level = 0; level < levelCount; ++level)
+    {
+        // Same level sizes as OpticalFlow's motion levels
+        desc.Width = (UINT)(width >> level);
+        desc.Height = (UINT)(height >> level);
+        if (desc.Width < 1) desc.Width = 1;
+        if (desc.Height < 1) desc.Height = 1;
+
+        for (int frame = 0; frame < 2; ++frame)
+        {
+            if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_Levels[frame][level])))
+            {
+                Debug::Error("Failed to create Luma Pyramid Level %d", level);
+                m_Levels[0][0].Reset(); // Build() and the consumers check level 0
+                m_Levels[1][0].Reset();
+                return false;
+            }
+        }
+    }
+
+    m_LevelCount = levelCount;
+    Debug::Info("Luma Pyramid created (%dx%d, %d levels, %s).", width, height, m_LevelCount,
+        desc.Format == DXGI_FORMAT_R8_UNORM ? "R8" : "R16F");
+    return true;
+}
+
+void LumaPyramid::Build(ID3D11DeviceContext* context, ID3D11Texture2D* frame)
+{
+    if (!m_csLuma || !m_csDownsample || !frame || !m_Levels[0][0]) return;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    // [Cycle] Last frame's pyramid is the previous one now, nothing is rebuilt for it
+    m_CurrentIndex ^= 1;
+    ++m_FrameIndex;
+
+    for (int level = 0; level < m_LevelCount; ++level)
+    {
+        ID3D11Texture2D* input = (level == 0) ? frame : m_Levels[m_CurrentIndex][level - 1].Get();
+        ID3D11Texture2D* output = m_Levels[m_CurrentIndex][level].Get();
+
+        ComPtr<ID3D11ShaderResourceView> srv;
+        ComPtr<ID3D11UnorderedAccessView> uav;
+        CreateSRV(dev, input, &srv);
+        CreateUAV(dev, output, &uav);
+
+        context->CSSetShader(level == 0 ? m_csLuma.Get() : m_csDownsample.Get(), nullptr, 0);
+        context->CSSetShaderResources(0, 1, srv.GetAddressOf());
+        context->CSSetUnorderedAccessViews(0, 1, uav.GetAddressOf(), nullptr);
+
+        D3D11_TEXTURE2D_DESC desc;
+        output->GetDesc(&desc);
+        context->Dispatch((UINT)ceil(desc.Width / 8.0f), (UINT)ceil(desc.Height / 8.0f), 1);
+
+        // Unbind (the level is the next pass's input)
+        ID3D11ShaderResourceView* nullSRV = nullptr;
+        ID3D11UnorderedAccessView* nullUAV = nullptr;
+        context->CSSetShaderResources(0, 1, &nullSRV);
+        context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+    }
+    context->CSSetShader(nullptr, nullptr, 0);
+
+    dev->Release();
+}
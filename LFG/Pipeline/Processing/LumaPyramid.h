@@ -0,0 +1,45 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include "../OpticalFlow/PyramidSchedule.h"
+
+
+
+// [Luma Pyramid] Single-channel analysis frames shared by every motion / analysis pass.
+// Build() runs once per real frame: the last frame's levels become the previous pyramid, so each frame is
+// converted and downsampled exactly once. RGBA is left to the final warp.
+class LumaPyramid
+{
+public:
+    LumaPyramid() = default;
+    ~LumaPyramid() = default;
+
+    // (Re)creates both pyramids at the flow resolution, Pyramid::LevelCount levels deep. The history is dropped.
+    // HDR / float sources get R16_FLOAT levels, everything else R8_UNORM.
+    bool Initialize(ID3D11Device* device, int width, int height, DXGI_FORMAT sourceFormat);
+
+    // Cycles current -> previous, then converts 'frame' (flow resolution) into the current pyramid
+    void Build(ID3D11DeviceContext* context, ID3D11Texture2D* frame);
+
+    ID3D11Texture2D* GetCurrent(int level = 0) const { return IsLevel(level) ? m_Levels[m_CurrentIndex][level].Get() : nullptr; }
+    ID3D11Texture2D* GetPrevious(int level = 0) const { return IsLevel(level) ? m_Levels[m_CurrentIndex ^ 1][level].Get() : nullptr; }
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    int GetLevelCount() const { return m_LevelCount; }
+    // Counts the Builds: products derived from one real frame are computed once per value
+    UINT GetFrameIndex() const { return m_FrameIndex; }
+
+private:
+    bool IsLevel(int level) const { return level >= 0 && level < m_LevelCount; }
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csLuma;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csDownsample;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_Levels[2][Pyramid::MaxLevels]; // [Current / Previous][Level]
+    int m_LevelCount = 0;
+    int m_CurrentIndex = 0;
+    UINT m_FrameIndex = 0;
+    int m_Width = 0;
+    int m_Height = 0;
+};
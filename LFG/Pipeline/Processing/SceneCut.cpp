@@ -0,0 +1,226 @@
+#include "SceneCut.h"
+#include "../../Pipeline/Shaders/EmbeddedShaders.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+#include <cmath>
+
+using Microsoft::WRL::ComPtr;
+
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+    if (!tex) return;
+    dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+bool SceneCut::Initialize(ID3D11Device* device)
+{
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_SceneCut, "CSMain", &m_csHistogram) ||
+        !Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_SceneCut, "CSResolve", &m_csResolve))
+    {
+        Debug::Error("Failed to load SceneCut Shaders");
+        return false;
+    }
+
+    if (!Shader::CompileVertexShaderFromMemory(device, EmbeddedShaders::PS_SceneCut, "VSMain", &m_vsPredicate) ||
+        !Shader::CompilePixelShaderFromMemory(device, EmbeddedShaders::PS_SceneCut, "PSMain", &m_psPredicate))
+    {
+        Debug::Error("Failed to load SceneCut Predicate Shaders");
+        return false;
+    }
+
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.Usage = D3D11_USAGE_DEFAULT;
+    cbDesc.ByteWidth = sizeof(CBSceneCut);
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbSceneCut)))
+    {
+        Debug::Error("Failed to create SceneCut Constant Buffer");
+        return false;
+    }
+
+    // Stats (structured uint buffer, UAV for the compute passes, SRV for the predicate draw)
+    D3D11_BUFFER_DESC bufDesc = {};
+    bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bufDesc.ByteWidth = StatsSize * 4;
+    bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufDesc.StructureByteStride = 4;
+    if (FAILED(device->CreateBuffer(&bufDesc, nullptr, &m_StatsBuffer)))
+    {
+        Debug::Error("Failed to create SceneCut Stats Buffer");
+        return false;
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = StatsSize;
+    device->CreateUnorderedAccessView(m_StatsBuffer.Get(), &uavDesc, &m_StatsUAV);
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = StatsSize;
+    device->CreateShaderResourceView(m_StatsBuffer.Get(), &srvDesc, &m_StatsSRV);
+
+    // 1x1 predicate target
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = 1;
+    desc.Height = 1;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET;
+    if (FAILED(device->CreateTexture2D(&desc, nullptr, &m_TexPredicateTarget)) ||
+        FAILED(device->CreateRenderTargetView(m_TexPredicateTarget.Get(), nullptr, &m_PredicateRTV)))
+    {
+        Debug::Error("Failed to create SceneCut Predicate Target");
+        return false;
+    }
+
+    D3D11_QUERY_DESC queryDesc = {};
+    queryDesc.Query = D3D11_QUERY_OCCLUSION_PREDICATE;
+    queryDesc.MiscFlags = D3D11_QUERY_MISC_PREDICATEHINT;
+    if (FAILED(device->CreatePredicate(&queryDesc, &m_Predicate)))
+    {
+        Debug::Error("Failed to create SceneCut Predicate");
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneCut::Detect(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev,
+    ID3D11ShaderResourceView* hashStats, bool detectCuts)
+{
+    m_HasVerdict = false;
+    if (!m_csHistogram || !m_csResolve || !m_Predicate || !current || !prev) return false;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    D3D11_TEXTURE2D_DESC desc;
+    current->GetDesc(&desc);
+    int thumbHeight = (int)(ThumbnailWidth * (float)desc.Height / desc.Width + 0.5f);
+    if (thumbHeight < 1) thumbHeight = 1;
+
+    CBSceneCut cbData = { ThumbnailWidth, thumbHeight, HistogramThreshold, SADThreshold,
+        hashStats ? 1 : 0, detectCuts ? 1 : 0, { 0.0f, 0.0f } };
+    context->UpdateSubresource(m_cbSceneCut.Get(), 0, nullptr, &cbData, 0, 0);
+
+    ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev;
+    CreateSRV(dev, current, &srvCurr);
+    CreateSRV(dev, prev, &srvPrev);
+
+    D3D11_SAMPLER_DESC sampDesc = {};
+    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    ComPtr<ID3D11SamplerState> sampler;
+    dev->CreateSamplerState(&sampDesc, &sampler);
+
+    dev->Release();
+
+    // 1. Thumbnail histograms + SAD, 2. Verdict
+    UINT clearVals[4] = { 0, 0, 0, 0 };
+    context->ClearUnorderedAccessViewUint(m_StatsUAV.Get(), clearVals);
+
+    ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), hashStats };
+    context->CSSetShaderResources(0, 3, srvs);
+    context->CSSetUnorderedAccessViews(0, 1, m_StatsUAV.GetAddressOf(), nullptr);
+    context->CSSetConstantBuffers(0, 1, m_cbSceneCut.GetAddressOf());
+    context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+    if (detectCuts)
+    {
+        context->CSSetShader(m_csHistogram.Get(), nullptr, 0);
+        context->Dispatch((UINT)ceil(ThumbnailWidth / 16.0f), (UINT)ceil(thumbHeight / 16.0f), 1);
+    }
+
+    context->CSSetShader(m_csResolve.Get(), nullptr, 0);
+    context->Dispatch(1, 1, 1);
+
+    ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    context->CSSetShaderResources(0, 3, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+    context->CSSetSamplers(0, 0, nullptr);
+
+    // 3. Verdict -> Predicate: one point that the pixel shader discards on a cut.
+    // This runs on the game's context inside Present, so every graphics state touched is restored.
+    ID3D11RenderTargetView* oldRTVs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+    ComPtr<ID3D11DepthStencilView> oldDSV;
+    context->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, oldRTVs, &oldDSV);
+    UINT oldViewportCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    D3D11_VIEWPORT oldViewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+    context->RSGetViewports(&oldViewportCount, oldViewports);
+    ComPtr<ID3D11RasterizerState> oldRasterizer;
+    context->RSGetState(&oldRasterizer);
+    ComPtr<ID3D11InputLayout> oldLayout;
+    context->IAGetInputLayout(&oldLayout);
+    D3D11_PRIMITIVE_TOPOLOGY oldTopology;
+    context->IAGetPrimitiveTopology(&oldTopology);
+    ComPtr<ID3D11VertexShader> oldVS;
+    ComPtr<ID3D11HullShader> oldHS;
+    ComPtr<ID3D11DomainShader> oldDS;
+    ComPtr<ID3D11GeometryShader> oldGS;
+    ComPtr<ID3D11PixelShader> oldPS;
+    context->VSGetShader(&oldVS, nullptr, nullptr);
+    context->HSGetShader(&oldHS, nullptr, nullptr);
+    context->DSGetShader(&oldDS, nullptr, nullptr);
+    context->GSGetShader(&oldGS, nullptr, nullptr);
+    context->PSGetShader(&oldPS, nullptr, nullptr);
+    ComPtr<ID3D11ShaderResourceView> oldPSSRV;
+    context->PSGetShaderResources(0, 1, &oldPSSRV);
+
+    D3D11_VIEWPORT viewport = { 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+    context->OMSetRenderTargets(1, m_PredicateRTV.GetAddressOf(), nullptr); // No depth: only the discard decides
+    context->RSSetViewports(1, &viewport);
+    context->RSSetState(nullptr);
+    context->IASetInputLayout(nullptr);
+    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+    context->VSSetShader(m_vsPredicate.Get(), nullptr, 0);
+    context->HSSetShader(nullptr, nullptr, 0);
+    context->DSSetShader(nullptr, nullptr, 0);
+    context->GSSetShader(nullptr, nullptr, 0);
+    context->PSSetShader(m_psPredicate.Get(), nullptr, 0);
+    context->PSSetShaderResources(0, 1, m_StatsSRV.GetAddressOf());
+
+    context->Begin(m_Predicate.Get());
+    context->Draw(1, 0);
+    context->End(m_Predicate.Get());
+
+    context->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, oldRTVs, oldDSV.Get());
+    for (ID3D11RenderTargetView* rtv : oldRTVs) if (rtv) rtv->Release();
+    context->RSSetViewports(oldViewportCount, oldViewports);
+    context->RSSetState(oldRasterizer.Get());
+    context->IASetInputLayout(oldLayout.Get());
+    context->IASetPrimitiveTopology(oldTopology);
+    context->VSSetShader(oldVS.Get(), nullptr, 0);
+    context->HSSetShader(oldHS.Get(), nullptr, 0);
+    context->DSSetShader(oldDS.Get(), nullptr, 0);
+    context->GSSetShader(oldGS.Get(), nullptr, 0);
+    context->PSSetShader(oldPS.Get(), nullptr, 0);
+    context->PSSetShaderResources(0, 1, oldPSSRV.GetAddressOf());
+
+    m_HasVerdict = true;
+    return true;
+}
+
+void SceneCut::BeginSkipOnCut(ID3D11DeviceContext* context) const
+{
+    // Predicate FALSE = nothing drawn = cut: skip
+    if (m_HasVerdict) context->SetPredication(m_Predicate.Get(), FALSE);
+}
+
+bool SceneCut::BeginOnCutOnly(ID3D11DeviceContext* context) const
+{
+    if (!m_HasVerdict) return false;
+    context->SetPredication(m_Predicate.Get(), TRUE);
+    return true;
+}
+
+void SceneCut::EndPredication(ID3D11DeviceContext* context)
+{
+    context->SetPredication(nullptr, FALSE);
+}
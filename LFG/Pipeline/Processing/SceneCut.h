@@ -0,0 +1,62 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+
+
+
+// [Scene Cut] Histogram + thumbnail SAD pre-pass that decides on a cut before any motion estimation.
+// The verdict stays on the GPU: it drives an occlusion predicate, so the flow, HUD mask and interpolation
+// recorded inside BeginSkipOnCut / EndPredication are dropped by the GPU on a cut, with no readback stall.
+class SceneCut
+{
+public:
+    SceneCut() = default;
+    ~SceneCut() = default;
+
+    bool Initialize(ID3D11Device* device);
+
+    // Compares 'current' against 'prev' and updates the predicate. False if the pre-pass is unavailable.
+    // 'hashStats' (FrameHash::GetStatsSRV, optional) adds duplicate frames to the verdict, 'detectCuts' = false
+    // leaves only them (the histogram pass is skipped).
+    bool Detect(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev,
+        ID3D11ShaderResourceView* hashStats = nullptr, bool detectCuts = true);
+
+    // Commands until EndPredication only execute when the last Detect found NO cut (or duplicate)
+    void BeginSkipOnCut(ID3D11DeviceContext* context) const;
+    // Commands until EndPredication only execute when the last Detect found a cut.
+    // False without a verdict: the caller must not record the cut-only work at all.
+    bool BeginOnCutOnly(ID3D11DeviceContext* context) const;
+    static void EndPredication(ID3D11DeviceContext* context);
+
+    static constexpr int ThumbnailWidth = 128; // Height follows the frame aspect
+    static constexpr float HistogramThreshold = 0.35f; // Normalized L1 distance, max over luma / Cb / Cr
+    static constexpr float SADThreshold = 0.1f; // Mean thumbnail luma difference
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csHistogram;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csResolve;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> m_vsPredicate;
+    Microsoft::WRL::ComPtr<ID3D11PixelShader> m_psPredicate;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_cbSceneCut;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_StatsBuffer; // Histograms, SAD, verdict (CS_SceneCut layout)
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_StatsUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_StatsSRV;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_TexPredicateTarget; // 1x1, only its sample count matters
+    Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_PredicateRTV;
+    Microsoft::WRL::ComPtr<ID3D11Predicate> m_Predicate;
+    bool m_HasVerdict = false;
+
+    struct CBSceneCut {
+        int ThumbWidth;
+        int ThumbHeight;
+        float HistogramThreshold;
+        float SADThreshold;
+        int UseHashStats;
+        int DetectCuts;
+        float Padding[2];
+    };
+
+    static constexpr UINT StatsSize = 130; // HISTOGRAM_SIZE + SAD_SUM + VERDICT
+};
@@ -0,0 +1,220 @@
+#include "TileClassifier.h"
+#include "../../Pipeline/Shaders/EmbeddedShaders.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+
+using Microsoft::WRL::ComPtr;
+
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+    if (!tex) return;
+    dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+static void CreateUAV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11UnorderedAccessView** ppUAV) {
+    if (!tex) return;
+    dev->CreateUnorderedAccessView(tex, nullptr, ppUAV);
+}
+
+bool TileClassifier::Initialize(ID3D11Device* device)
+{
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_TileClassify, "CSClassify", &m_csClassify) ||
+        !Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_TileClassify, "CSStatic", &m_csStatic))
+    {
+        Debug::Error("Failed to load Tile Classify Shaders");
+        return false;
+    }
+
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.Usage = D3D11_USAGE_DEFAULT;
+    cbDesc.ByteWidth = sizeof(CBTiles);
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbTiles)))
+    {
+        Debug::Error("Failed to create Tile Classify Constant Buffer");
+        return false;
+    }
+
+    // Indirect args (typed R32_UINT UAV, the counts are atomics)
+    D3D11_BUFFER_DESC argsDesc = {};
+    argsDesc.Usage = D3D11_USAGE_DEFAULT;
+    argsDesc.ByteWidth = 6 * sizeof(UINT);
+    argsDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    argsDesc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+    if (FAILED(device->CreateBuffer(&argsDesc, nullptr, &m_ArgsBuffer)))
+    {
+        Debug::Error("Failed to create Tile Args Buffer");
+        return false;
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_UINT;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = 6;
+    if (FAILED(device->CreateUnorderedAccessView(m_ArgsBuffer.Get(), &uavDesc, &m_ArgsUAV)))
+    {
+        Debug::Error("Failed to create Tile Args UAV");
+        m_ArgsBuffer.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+bool TileClassifier::EnsureTileList(ID3D11Device* device, UINT tileCount)
+{
+    if (m_TileListBuffer && m_TileCount == tileCount) return true;
+
+    m_TileListBuffer.Reset();
+    m_TileListUAV.Reset();
+    m_TileListSRV.Reset();
+    m_TileCount = 0;
+
+    D3D11_BUFFER_DESC bufDesc = {};
+    bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
+    bufDesc.ByteWidth = tileCount * 4;
+    bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufDesc.StructureByteStride = 4;
+    if (FAILED(device->CreateBuffer(&bufDesc, nullptr, &m_TileListBuffer)))
+    {
+        Debug::Error("Failed to create Tile List Buffer");
+        return false;
+    }
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = tileCount;
+    device->CreateUnorderedAccessView(m_TileListBuffer.Get(), &uavDesc, &m_TileListUAV);
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.NumElements = tileCount;
+    device->CreateShaderResourceView(m_TileListBuffer.Get(), &srvDesc, &m_TileListSRV);
+
+    if (!m_TileListUAV || !m_TileListSRV)
+    {
+        m_TileListBuffer.Reset();
+        return false;
+    }
+
+    m_TileCount = tileCount;
+    return true;
+}
+
+bool TileClassifier::Classify(ID3D11DeviceContext* context,
+    ID3D11Texture2D* current,
+    ID3D11Texture2D* prev,
+    ID3D11Texture2D* motion,
+    ID3D11Texture2D* hudMask,
+    ID3D11ShaderResourceView* statsSRV,
+    float motionBlockSize,
+    float flowScaleX,
+    float flowScaleY,
+    int sceneThreshold)
+{
+    if (!m_csClassify || !m_ArgsUAV || !current || !prev || !motion || !hudMask || !statsSRV) return false;
+
+    D3D11_TEXTURE2D_DESC desc;
+    current->GetDesc(&desc);
+    UINT tilesX = (desc.Width + TileSize - 1) / TileSize;
+    UINT tilesY = (desc.Height + TileSize - 1) / TileSize;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    if (!EnsureTileList(dev, tilesX * tilesY))
+    {
+        dev->Release();
+        return false;
+    }
+
+    m_cbData.MotionBlockSize = motionBlockSize;
+    m_cbData.SceneChangeThreshold = sceneThreshold;
+    m_cbData.FlowScale[0] = flowScaleX;
+    m_cbData.FlowScale[1] = flowScaleY;
+    m_cbData.TileCount = m_TileCount;
+    m_cbData.StaticMotion = StaticMotionThreshold;
+    m_cbData.StaticDiff = StaticDiffThreshold;
+    m_cbData.Sharpness = 0.0f;
+    m_cbData.WriteCopy = 0;
+    context->UpdateSubresource(m_cbTiles.Get(), 0, nullptr, &m_cbData, 0, 0);
+
+    ComPtr<ID3D11ShaderResourceView> srvCurr, srvPrev, srvMotion, srvMask;
+    CreateSRV(dev, current, &srvCurr);
+    CreateSRV(dev, prev, &srvPrev);
+    CreateSRV(dev, motion, &srvMotion);
+    CreateSRV(dev, hudMask, &srvMask);
+
+    D3D11_SAMPLER_DESC sampDesc = {};
+    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    ComPtr<ID3D11SamplerState> sampler;
+    dev->CreateSamplerState(&sampDesc, &sampler);
+
+    dev->Release();
+
+    UINT clearVals[4] = { 0, 0, 0, 0 };
+    context->ClearUnorderedAccessViewUint(m_ArgsUAV.Get(), clearVals);
+
+    context->CSSetShader(m_csClassify.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* srvs[] = { srvCurr.Get(), srvPrev.Get(), srvMotion.Get(), srvMask.Get(), statsSRV };
+    context->CSSetShaderResources(0, 5, srvs);
+    ID3D11UnorderedAccessView* uavs[] = { m_TileListUAV.Get(), m_ArgsUAV.Get() };
+    context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+    context->CSSetConstantBuffers(0, 1, m_cbTiles.GetAddressOf());
+    context->CSSetSamplers(0, 1, sampler.GetAddressOf());
+
+    context->Dispatch(tilesX, tilesY, 1);
+
+    // Unbind (the args buffer is the next dispatches' indirect source)
+    ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+    context->CSSetShaderResources(0, 5, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+    context->CSSetSamplers(0, 0, nullptr);
+
+    return true;
+}
+
+void TileClassifier::DispatchStatic(ID3D11DeviceContext* context,
+    ID3D11Texture2D* current,
+    ID3D11Texture2D* output,
+    ID3D11Texture2D* copy,
+    float sharpness)
+{
+    if (!m_csStatic || !m_TileListSRV) return;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    m_cbData.Sharpness = sharpness;
+    m_cbData.WriteCopy = copy ? 1 : 0;
+    context->UpdateSubresource(m_cbTiles.Get(), 0, nullptr, &m_cbData, 0, 0);
+
+    ComPtr<ID3D11ShaderResourceView> srvCurr;
+    ComPtr<ID3D11UnorderedAccessView> uavOutput, uavCopy;
+    CreateSRV(dev, current, &srvCurr);
+    CreateUAV(dev, output, &uavOutput);
+    CreateUAV(dev, copy, &uavCopy);
+
+    dev->Release();
+
+    context->CSSetShader(m_csStatic.Get(), nullptr, 0);
+    context->CSSetShaderResources(0, 1, srvCurr.GetAddressOf());
+    context->CSSetShaderResources(5, 1, m_TileListSRV.GetAddressOf());
+    ID3D11UnorderedAccessView* uavs[] = { uavOutput.Get(), uavCopy.Get() };
+    context->CSSetUnorderedAccessViews(0, 2, uavs, nullptr);
+    context->CSSetConstantBuffers(0, 1, m_cbTiles.GetAddressOf());
+
+    context->DispatchIndirect(m_ArgsBuffer.Get(), StaticArgsOffset);
+
+    // Unbind
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    ID3D11UnorderedAccessView* nullUAVs[] = { nullptr, nullptr };
+    context->CSSetShaderResources(0, 1, &nullSRV);
+    context->CSSetShaderResources(5, 1, &nullSRV);
+    context->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+
+
+
+// [Tile Skip] Splits the output into 16x16 tiles and sorts them into dynamic (warped) and static (real frame) ones.
+// The tile list and the indirect arguments stay on the GPU: synthesis and RCAS run indirect over the dynamic tiles,
+// DispatchStatic over the rest, so static content costs a copy instead of a warp + ghosting clamp + sharpen.
+class TileClassifier
+{
+public:
+    TileClassifier() = default;
+    ~TileClassifier() = default;
+
+    bool Initialize(ID3D11Device* device);
+
+    // Classifies every tile of 'current' (output resolution). 'motion' is the field synthesis samples, at flow
+    // resolution ('flowScaleX/Y' output pixels per flow pixel). False if the pass is unavailable.
+    bool Classify(ID3D11DeviceContext* context,
+        ID3D11Texture2D* current,
+        ID3D11Texture2D* prev,
+        ID3D11Texture2D* motion,
+        ID3D11Texture2D* hudMask,
+        ID3D11ShaderResourceView* statsSRV,
+        float motionBlockSize,
+        float flowScaleX,
+        float flowScaleY,
+        int sceneThreshold);
+
+    // Static tiles: 'current' into 'output', sharpened by 'sharpness' (0 = copy). 'copy' (optional) receives the
+    // unsharpened frame, so RCAS of the dynamic tiles reads valid neighbors across tile borders.
+    void DispatchStatic(ID3D11DeviceContext* context,
+        ID3D11Texture2D* current,
+        ID3D11Texture2D* output,
+        ID3D11Texture2D* copy,
+        float sharpness);
+
+    // Dynamic tiles: the caller binds a 16x16 tile entry point and GetTileListSRV
+    void DispatchDynamic(ID3D11DeviceContext* context) const { context->DispatchIndirect(m_ArgsBuffer.Get(), DynamicArgsOffset); }
+
+    ID3D11ShaderResourceView* GetTileListSRV() const { return m_TileListSRV.Get(); }
+    ID3D11Buffer* GetArgsBuffer() const { return m_ArgsBuffer.Get(); }
+
+    static constexpr int TileSize = 16;
+    static constexpr float StaticMotionThreshold = 0.05f; // Output pixels
+    static constexpr float StaticDiffThreshold = 0.02f; // Sum of the RGB differences (0 - 3)
+    static constexpr UINT DynamicArgsOffset = 0; // Byte offsets into the args buffer
+    static constexpr UINT StaticArgsOffset = 12;
+
+private:
+    bool EnsureTileList(ID3D11Device* device, UINT tileCount);
+
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csClassify;
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csStatic;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_cbTiles;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_TileListBuffer; // uint y << 16 | x, dynamic from the front, static from the back
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_TileListUAV;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_TileListSRV;
+    UINT m_TileCount = 0;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_ArgsBuffer; // 2x DispatchIndirect args: dynamic, static
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_ArgsUAV;
+
+    struct CBTiles {
+        float MotionBlockSize;
+        int SceneChangeThreshold;
+        float FlowScale[2];
+        UINT TileCount;
+        float StaticMotion;
+        float StaticDiff;
+        float Sharpness;
+        int WriteCopy;
+        float Padding[3];
+    };
+    CBTiles m_cbData = {}; // Classify fills the frame, DispatchStatic the sharpening
+};
@@ -0,0 +1,126 @@
+#include "WarpError.h"
+#include "SceneCut.h"
+#include "../../Pipeline/Shaders/EmbeddedShaders.h"
+#include "../Shaders/Shader.h"
+#include <Debug/Debug.h>
+
+using Microsoft::WRL::ComPtr;
+
+static void CreateSRV(ID3D11Device* dev, ID3D11Texture2D* tex, ID3D11ShaderResourceView** ppSRV) {
+    if (!tex) return;
+    dev->CreateShaderResourceView(tex, nullptr, ppSRV);
+}
+
+bool WarpError::Initialize(ID3D11Device* device)
+{
+    if (!Shader::CompileComputeShaderFromMemory(device, EmbeddedShaders::CS_WarpError, "CSWarpError", &m_csWarpError))
+    {
+        Debug::Error("Failed to load Warp Error Shader");
+        return false;
+    }
+
+    D3D11_BUFFER_DESC cbDesc = {};
+    cbDesc.Usage = D3D11_USAGE_DEFAULT;
+    cbDesc.ByteWidth = sizeof(CBWarpError);
+    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    if (FAILED(device->CreateBuffer(&cbDesc, nullptr, &m_cbWarpError)))
+    {
+        Debug::Error("Failed to create Warp Error Constant Buffer");
+        return false;
+    }
+
+    D3D11_BUFFER_DESC bufDesc = {};
+    bufDesc.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    bufDesc.ByteWidth = StatsSize * sizeof(UINT);
+    bufDesc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    bufDesc.StructureByteStride = sizeof(UINT);
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_UNKNOWN;
+    uavDesc.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = StatsSize;
+
+    D3D11_BUFFER_DESC stagingDesc = bufDesc;
+    stagingDesc.Usage = D3D11_USAGE_STAGING;
+    stagingDesc.BindFlags = 0;
+    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    stagingDesc.MiscFlags = 0;
+
+    if (FAILED(device->CreateBuffer(&bufDesc, nullptr, &m_StatsBuffer)) ||
+        FAILED(device->CreateUnorderedAccessView(m_StatsBuffer.Get(), &uavDesc, &m_StatsUAV)) ||
+        FAILED(device->CreateBuffer(&stagingDesc, nullptr, &m_StatsStaging)))
+    {
+        Debug::Error("Failed to create Warp Error Stats Buffer");
+        m_StatsUAV.Reset();
+        return false;
+    }
+
+    m_Pending = false;
+    return true;
+}
+
+void WarpError::Measure(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev,
+    ID3D11Texture2D* motion, float motionScale, const SceneCut* sceneCut)
+{
+    if (m_Pending || !m_csWarpError || !m_StatsUAV || !current || !prev || !motion) return;
+
+    ID3D11Device* dev = nullptr;
+    context->GetDevice(&dev);
+
+    D3D11_TEXTURE2D_DESC desc;
+    current->GetDesc(&desc);
+
+    CBWarpError cbData = { motionScale, Step, { 0, 0 } };
+    context->UpdateSubresource(m_cbWarpError.Get(), 0, nullptr, &cbData, 0, 0);
+
+    ComPtr<ID3D11ShaderResourceView> srvCurrent, srvPrev, srvMotion;
+    CreateSRV(dev, current, &srvCurrent);
+    CreateSRV(dev, prev, &srvPrev);
+    CreateSRV(dev, motion, &srvMotion);
+
+    dev->Release();
+
+    // Clear and copy stay outside the predicate, only the dispatch is dropped on a cut
+    UINT clearVals[4] = { 0, 0, 0, 0 };
+    context->ClearUnorderedAccessViewUint(m_StatsUAV.Get(), clearVals);
+
+    context->CSSetShader(m_csWarpError.Get(), nullptr, 0);
+    ID3D11ShaderResourceView* srvs[] = { srvCurrent.Get(), srvPrev.Get(), srvMotion.Get() };
+    context->CSSetShaderResources(0, 3, srvs);
+    context->CSSetUnorderedAccessViews(0, 1, m_StatsUAV.GetAddressOf(), nullptr);
+    context->CSSetConstantBuffers(0, 1, m_cbWarpError.GetAddressOf());
+
+    if (sceneCut) sceneCut->BeginSkipOnCut(context);
+    UINT pixelsX = (desc.Width + Step - 1) / Step;
+    UINT pixelsY = (desc.Height + Step - 1) / Step;
+    context->Dispatch((pixelsX + 15) / 16, (pixelsY + 15) / 16, 1);
+    if (sceneCut) SceneCut::EndPredication(context);
+
+    // Unbind
+    ID3D11ShaderResourceView* nullSRVs[] = { nullptr, nullptr, nullptr };
+    ID3D11UnorderedAccessView* nullUAV = nullptr;
+    context->CSSetShaderResources(0, 3, nullSRVs);
+    context->CSSetUnorderedAccessViews(0, 1, &nullUAV, nullptr);
+
+    context->CopyResource(m_StatsStaging.Get(), m_StatsBuffer.Get());
+    m_Pending = true;
+}
+
+bool WarpError::Collect(ID3D11DeviceContext* context, float& error)
+{
+    if (!m_Pending) return false;
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(context->Map(m_StatsStaging.Get(), 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+        return false;
+
+    const UINT* stats = (const UINT*)mapped.pData;
+    UINT errorSum = stats[0];
+    UINT pixels = stats[1];
+    context->Unmap(m_StatsStaging.Get(), 0);
+    m_Pending = false;
+
+    if (pixels == 0) return false;
+    error = (float)errorSum / ErrorScale / (float)pixels;
+    return true;
+}
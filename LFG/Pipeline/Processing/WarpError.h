@@ -0,0 +1,46 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+
+class SceneCut;
+
+// [Auto-Tune] Mean luma error of the previous frame warped onto the current one by the final motion (CS_WarpError),
+// the quality proxy the auto-tuner compares configurations by. Measured at the frames' resolution whatever the
+// flow ran at, on every Step-th pixel, and read back a frame or more late without waiting. Record it on the
+// immediate context (the readback maps there).
+class WarpError
+{
+public:
+    WarpError() = default;
+    ~WarpError() = default;
+
+    bool Initialize(ID3D11Device* device);
+    bool IsAvailable() const { return m_csWarpError && m_StatsUAV; }
+
+    // Queues a measurement unless the last one is still in flight. 'motionScale': frame pixels per flow pixel.
+    // 'sceneCut' (optional): a cut frame stays unmeasured.
+    void Measure(ID3D11DeviceContext* context, ID3D11Texture2D* current, ID3D11Texture2D* prev,
+        ID3D11Texture2D* motion, float motionScale, const SceneCut* sceneCut = nullptr);
+
+    // Newest finished measurement (0 - 1). False while none is ready, or it was a cut.
+    bool Collect(ID3D11DeviceContext* context, float& error);
+
+    static constexpr int Step = 2;
+    static constexpr float ErrorScale = 256.0f; // CS_WarpError ERROR_SCALE
+
+private:
+    Microsoft::WRL::ComPtr<ID3D11ComputeShader> m_csWarpError;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_cbWarpError;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_StatsBuffer; // [0] error sum, [1] pixels
+    Microsoft::WRL::ComPtr<ID3D11UnorderedAccessView> m_StatsUAV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> m_StatsStaging;
+    bool m_Pending = false; // Staging copy in flight
+
+    struct CBWarpError {
+        float MotionScale;
+        int Step;
+        float Padding[2];
+    };
+
+    static constexpr UINT StatsSize = 2;
+};
@@ -1,1092 +1,3828 @@
-#pragma once
-
-namespace EmbeddedShaders
-{
-    inline const char* CS_AdaptiveVariance = R"(
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float> OutputVariance : register(u0); // Stores variance 0.0-1.0
-
-// Block Size for assessment (e.g. 16x16)
-#define BLOCK_SIZE 16
-
-[numthreads(16, 16, 1)]
-void main(uint3 groupID : SV_GroupID, uint3 groupThreadID : SV_GroupThreadID)
-{
-    // Each thread group processes one 16x16 block of the image
-    // But we want to output ONE value per block? 
-    // Usually easier to run one thread per output pixel, gathering source pixels.
-    // If we do 1:1 map, it's slow.
-    // Let's assume OutputVariance is 1/16th size of Input.
-    
-    // Dispatch is (InputWidth/16, InputHeight/16, 1)
-    // Flattened Thread ID doesn't help if we only launch 1 thread per group?
-    // Let's use [numthreads(8,8,1)] acting on a region.
-    
-    // SIMPLIFIED APPROACH:
-    // This shader runs per PIXEL of the Output Grid (Low Res).
-    // Each thread samples the corresponding 16x16 block in Input.
-}
-
-// Redefine to run per Low-Res Pixel
-[numthreads(8, 8, 1)]
-void CalculateVariance(uint3 id : SV_DispatchThreadID)
-{
-    uint gridW, gridH;
-    OutputVariance.GetDimensions(gridW, gridH);
-    if (id.x >= gridW || id.y >= gridH) return;
-
-    uint2 basePos = id.xy * BLOCK_SIZE;
-    
-    float sum = 0;
-    float sumSq = 0;
-    
-    // Sample 16x16 block
-    // Unrolling loops for performance if possible, but 256 samples is a lot.
-    // Use strided sampling for speed (e.g. step 2 or 4)
-    for (uint y = 0; y < BLOCK_SIZE; y+=2)
-    {
-        for (uint x = 0; x < BLOCK_SIZE; x+=2)
-        {
-            float3 col = Input[uint2(basePos.x + x, basePos.y + y)].rgb;
-            float lum = dot(col, float3(0.299, 0.587, 0.114));
-            sum += lum;
-            sumSq += lum * lum;
-        }
-    }
-    
-    // Count = (16/2) * (16/2) = 64 samples
-    float count = 64.0f;
-    float mean = sum / count;
-    float variance = (sumSq / count) - (mean * mean);
-    
-    // Normalize (Variance can be small, so scale it up)
-    // Heuristic: Variance > 0.01 is "complex"
-    float normalizedVar = saturate(variance * 100.0f);
-    
-    OutputVariance[id.xy] = normalizedVar;
-}
-)";
-
-    inline const char* CS_BidirectionalConsistency = R"(
-Texture2D<float2> FwdFlow : register(t0);
-Texture2D<float2> BwdFlow : register(t1);
-
-RWTexture2D<float2> OutputFlow : register(u0);
-RWTexture2D<float> OutputConfidence : register(u1); // Optional confidence map
-
-cbuffer CB : register(b0)
-{
-	float Tolerance; // e.g. 1.0 - 5.0 pixels
-	float3 Padding;
-};
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-	uint width, height;
-	OutputFlow.GetDimensions(width, height);
-	if (id.x >= width || id.y >= height) return;
-
-	float2 fwd = FwdFlow[id.xy];
-	
-	// Backward flow is at the position pointed to by forward flow
-	int2 targetPos = int2(id.x + fwd.x, id.y + fwd.y);
-	
-	// Boundary check
-	float confidence = 1.0f;
-	if (targetPos.x < 0 || targetPos.y < 0 || targetPos.x >= (int)width || targetPos.y >= (int)height)
-	{
-		confidence = 0.0f;
-	}
-	else
-	{
-		float2 bwd = BwdFlow[targetPos];
-		
-		// Ideally: Fwd + Bwd approx 0.
-		// Delta = |Fwd + Bwd|
-		float2 diff = abs(fwd + bwd);
-		float dist = length(diff);
-		
-		if (dist > Tolerance)
-		{
-			// Occlusion or Bad Match
-			confidence = max(0.0f, 1.0f - (dist - Tolerance) * 0.5f);
-		}
-	}
-	
-	// Write sanitized flow (maybe damped by confidence, or just passed through)
-	// For now, we pass through Forward Flow, but write Confidence for the Interpolator to use.
-	OutputFlow[id.xy] = fwd;
-	OutputConfidence[id.xy] = confidence;
-}
-)";
-
-    inline const char* CS_BilinearScale = R"(
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float4> Output : register(u0);
-
-SamplerState LinearClampSampler : register(s0);
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-    uint outW, outH;
-    Output.GetDimensions(outW, outH);
-    
-    if (id.x >= outW || id.y >= outH) return;
-
-    // Calculate UV coordinates for the center of the output pixel
-    float2 uv = (float2(id.xy) + 0.5f) / float2(outW, outH);
-    
-    // Sample Input with Linear filtering
-    // Note: Compute Shaders usually require 'SamplerState' and 'SampleLevel' (lod 0)
-    float4 color = Input.SampleLevel(LinearClampSampler, uv, 0);
-    
-    Output[id.xy] = color;
-}
-)";
-
-    inline const char* CS_BlockMatching = R"(
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float2> InputInitMotion : register(t2); // NEW: Initial guess from lower level
-RWTexture2D<float2> OutputMotion : register(u0);
-RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
-
-SamplerState LinearSampler : register(s0);
-
-// Parameters
-cbuffer CB : register(b0)
-{
-    int Width;
-    int Height;
-    int BlockSize; 
-    int SearchRadius; 
-    int EnableSubPixel;
-    int UseInitMotion; // NEW: 0 or 1
-    int2 Padding;      // Alignment
-};
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    // Global pixel position
-    int2 pos = int2(dispatchThreadId.xy);
-    
-    if (pos.x >= Width || pos.y >= Height)
-        return;
-
-    // Center pixel of the block
-    float4 targetPixel = TexCurrent[pos];
-    
-    // Initial Guess
-    int2 searchCenter = int2(0, 0);
-    if (UseInitMotion)
-    {
-        // Read from lower level (already upsampled or same size)
-        float2 initVec = InputInitMotion[pos];
-        searchCenter = int2(round(initVec.x), round(initVec.y));
-    }
-
-    // [Ultra Optimization] Fast Path for Static/Perfect Guess
-    // Check the exact guess position first.
-    {
-         int2 searchPos = pos + searchCenter;
-         if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
-         {
-             float4 candidatePixel = TexPrev[searchPos];
-             float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-             float sad = diff.r + diff.g + diff.b;
-             
-             if (sad < 0.001f) // Virtually identical
-             {
-                 OutputMotion[pos] = float2(searchCenter.x, searchCenter.y);
-                 return; // <--- EARLY EXIT: Skip entire loop
-             }
-         }
-    }
-
-    float minSAD = 999999.0f;
-    int2 bestVector = searchCenter; // Default to initial guess
-
-    // Refined Search around Center (Reduced radius is adequate if guess is good)
-    // If not using init motion, we search full radius.
-    // If using init motion, we could technically search a smaller radius, but for safety lets keep it.
-    
-    [loop] // Use loop for variable radius, unroll is only for constant
-    for (int y = -SearchRadius; y <= SearchRadius; ++y)
-    {
-        for (int x = -SearchRadius; x <= SearchRadius; ++x)
-        {
-            int2 offset = int2(x, y);
-            int2 searchPos = pos + searchCenter + offset;
-            
-            // Boundary check
-            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
-                continue;
-
-            float4 candidatePixel = TexPrev[searchPos];
-            
-            float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-            float sad = diff.r + diff.g + diff.b;
-
-            if (sad < minSAD)
-            {
-                minSAD = sad;
-                bestVector = searchCenter + offset;
-                
-                // Early Exit: Perfect match found (SAD ~ 0)
-                // This speeds up static areas massively (HUD, Skyboxes)
-                if (sad < 0.001f) 
-                {
-                     // Break outer loop manually
-                     y = SearchRadius + 1; 
-                     break;
-                }
-            }
-        }
-    }
-
-    // Write integer result first
-    float2 finalVector = float2(bestVector.x, bestVector.y);
-    
-    // [Scene Change Detection]
-    // If the best match is still terrible, it means we found NOTHING similar.
-    // If many blocks fail, it's a scene change.
-    // Normalized threshold: 0.15 (15% avg diff per pixel)
-    // Scale: Sad is sum of 3 channels * BlockSize^2
-    float avgDiff = minSAD / (max(1, BlockSize * BlockSize) * 3.0f);
-    if (avgDiff > 0.15f)
-    {
-        InterlockedAdd(GlobalStats[0], 1);
-    }
-    
-
-
-    // Sub-Pixel Refinement (Bilinear Check)
-    if (EnableSubPixel > 0)
-    {
-        float2 bestSub = finalVector;
-        float minSubSAD = minSAD;
-        
-        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
-        
-        uint w, h;
-        TexPrev.GetDimensions(w, h);
-        float2 texSize = float2(w, h);
-        
-        for(int i=0; i<4; ++i)
-        {
-             // Candidate Pos in Prev: Original Pos + BestIntegerVec + Offset
-             float2 checkPos = float2(pos) + finalVector + offsets[i];
-             float2 uv = (checkPos + 0.5f) / texSize;
-             
-             float4 candidatePixel = TexPrev.SampleLevel(LinearSampler, uv, 0);
-             
-             float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-             float sad = diff.r + diff.g + diff.b;
-             
-             if (sad < minSubSAD)
-             {
-                 minSubSAD = sad;
-                 bestSub = finalVector + offsets[i];
-             }
-        }
-        finalVector = bestSub;
-    }
-    
-    OutputMotion[pos] = finalVector;
-}
-)";
-
-    inline const char* CS_DIS_Flow = R"(
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float4> GradsPrev : register(t2); // Gradient of Prev Frame (from Expansion shader)
-Texture2D<float2> MotionInput : register(t3);
-RWTexture2D<float2> MotionOutput : register(u0);
-
-SamplerState LinearSampler : register(s0);
-
-// DIS (Dense Inverse Search) Approximation
-// "Inverse Compositional" logic:
-// We align the Current patch to the Previous patch using gradients of Prev.
-// This allows pre-computation of gradients.
-
-[numthreads(16, 16, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    uint w, h;
-    TexCurrent.GetDimensions(w, h);
-    if (pos.x >= w || pos.y >= h) return;
-
-    // 1. Initial Guess
-    float2 d = MotionInput[pos];
-    
-    // 2. Iterative Refinement (Gradient Descent)
-    // 8x8 Patch
-    const int RADIUS = 4;
-    
-    // Iterations (Fast convergence for small tweaks)
-    [unroll]
-    for(int iter = 0; iter < 4; ++iter)
-    {
-        float sum_IdIxx = 0; // Sum (ImagesDiff * I_x)
-        float sum_IdIyy = 0; // Sum (ImagesDiff * I_y)
-        float sum_Ixx2 = 0;  // Sum (I_x^2)
-        float sum_Iyy2 = 0;  // Sum (I_y^2)
-        
-        for(int y = -RADIUS; y < RADIUS; ++y) {
-            for(int x = -RADIUS; x < RADIUS; ++x) {
-                int2 p = pos + int2(x,y);
-                if(p.x < 0 || p.y < 0) continue; 
-                
-                // I_cur(x)
-                float I_curr = TexCurrent[p].r;
-                
-                // I_prev(x + d)
-                float2 uv = (float2(p) + d) / float2(w, h);
-                float I_prev = TexPrev.SampleLevel(LinearSampler, uv, 0).r;
-                
-                // Gradients of Prev(x + d)
-                // Note: Standard IC uses Grads of Template (Cur) but for tracking usually we align Cur to Prev
-                // Let's use Gradients of Previous interpolated.
-                float4 g = GradsPrev.SampleLevel(LinearSampler, uv, 0);
-                float Ix = g.x; // Gradient X
-                float Iy = g.y; // Gradient Y
-                
-                float diff = I_curr - I_prev; // Error
-                
-                sum_IdIxx += diff * Ix;
-                sum_IdIyy += diff * Iy;
-                sum_Ixx2 += Ix * Ix;
-                sum_Iyy2 += Iy * Iy;
-            }
-        }
-        
-        // Solve JT J d = JT e
-        // Making diagonal assumption for speed
-        float eps = 0.001;
-        float2 delta;
-        delta.x = sum_IdIxx / (sum_Ixx2 + eps);
-        delta.y = sum_IdIyy / (sum_Iyy2 + eps);
-        
-        // Update
-        d += delta;
-        
-        // Early transform break?
-        if (dot(delta, delta) < 0.001) break;
-    }
-    
-    MotionOutput[pos] = d;
-}
-)";
-
-    inline const char* CS_DebugView = R"(
-Texture2D<float2> TexMotion : register(t0);
-Texture2D<float> TexMask : register(t1);
-RWTexture2D<float4> Output : register(u0);
-
-cbuffer Settings : register(b0)
-{
-    int Mode; // 1 = Motion, 2 = Mask
-    float Scale; // For motion visualization
-    int2 Padding;
-}
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    
-    float4 color = float4(0, 0, 0, 1);
-    
-    if (Mode == 1) // Motion Vectors
-    {
-        float2 motion = TexMotion[pos];
-        // map x/y directly to r/g. Scale up to see small movements.
-        // abs() to see negative motion as color too.
-        color.rgb = float3(abs(motion.x), abs(motion.y), 0) * Scale; 
-        // Add a small blue component to show static areas
-        if (length(motion) == 0) color.b = 0.2f;
-    }
-    else if (Mode == 2) // HUD Mask
-    {
-        float mask = TexMask[pos];
-        // Mask is 1.0 for HUD (Static), 0.0 for World (Dynamic)
-        // Let's make HUD Red and World Grayscale/Dark
-        color.rgb = lerp(float3(0.1, 0.1, 0.1), float3(1.0, 0.0, 0.0), mask);
-    }
-    
-    Output[pos] = color;
-}
-)";
-
-    inline const char* CS_Downsample = R"(
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float4> Output : register(u0);
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    // Simple 2x2 box filter downsampling
-    uint2 srcPos = dispatchThreadId.xy * 2;
-    
-    float4 c0 = Input[srcPos + uint2(0, 0)];
-    float4 c1 = Input[srcPos + uint2(1, 0)];
-    float4 c2 = Input[srcPos + uint2(0, 1)];
-    float4 c3 = Input[srcPos + uint2(1, 1)];
-    
-    float4 average = (c0 + c1 + c2 + c3) * 0.25f;
-    
-    Output[dispatchThreadId.xy] = average;
-}
-)";
-
-    inline const char* CS_EdgeDetect = R"(
-Texture2D<float4> InputTexture : register(t0);
-RWTexture2D<float4> OutputEdge : register(u0);
-
-[numthreads(32, 32, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    uint w, h;
-    InputTexture.GetDimensions(w, h);
-
-    if (pos.x >= w || pos.y >= h)
-        return;
-
-    // Sobel Kernels
-    // Gx: -1 0 1   Gy: -1 -2 -1
-    //     -2 0 2       0  0  0
-    //     -1 0 1       1  2  1
-
-    float3 c00 = InputTexture[pos + int2(-1, -1)].rgb;
-    float3 c10 = InputTexture[pos + int2( 0, -1)].rgb;
-    float3 c20 = InputTexture[pos + int2( 1, -1)].rgb;
-    float3 c01 = InputTexture[pos + int2(-1,  0)].rgb;
-    float3 c21 = InputTexture[pos + int2( 1,  0)].rgb;
-    float3 c02 = InputTexture[pos + int2(-1,  1)].rgb;
-    float3 c12 = InputTexture[pos + int2( 0,  1)].rgb;
-    float3 c22 = InputTexture[pos + int2( 1,  1)].rgb;
-
-    // Luminance weights (Rec. 709)
-    const float3 lum = float3(0.2126, 0.7152, 0.0722);
-    
-    // Convert neighborhood to luminance
-    float l00 = dot(c00, lum);
-    float l10 = dot(c10, lum);
-    float l20 = dot(c20, lum);
-    float l01 = dot(c01, lum);
-    float l21 = dot(c21, lum);
-    float l02 = dot(c02, lum);
-    float l12 = dot(c12, lum);
-    float l22 = dot(c22, lum);
-
-    float Gx = -l00 + l20 - 2.0*l01 + 2.0*l21 - l02 + l22;
-    float Gy = -l00 - 2.0*l10 - l20 + l02 + 2.0*l12 + l22;
-
-    float magnitude = sqrt(Gx*Gx + Gy*Gy);
-    
-    // Store edge magnitude (Clamp to 0-1)
-    OutputEdge[pos] = float4(magnitude, magnitude, magnitude, 1.0);
-}
-)";
-
-    inline const char* CS_Farneback_Expansion = R"(
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float4> Output : register(u0);
-
-[numthreads(16, 16, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    uint w, h;
-    Input.GetDimensions(w, h);
-    if (pos.x >= w || pos.y >= h) return;
-
-    // Use a 5x5 neighborhood to compute:
-    // b_x (Gradient X)
-    // b_y (Gradient Y)
-    // r_xx (Curvature X)
-    // r_yy (Curvature Y)
-    
-    // Explicit 5x5 load
-    float val[5][5];
-    [unroll]
-    for(int y = -2; y <= 2; ++y) {
-        [unroll]
-        for(int x = -2; x <= 2; ++x) {
-            val[y+2][x+2] = Input[pos + int2(x,y)].r;
-        }
-    }
-
-    // Gradient X (Smoothed Sobel-like)
-    // -1 0 1
-    // -2 0 2
-    // -1 0 1
-    float gx = 0;
-    gx += -1*val[1][0] + 1*val[1][4]; 
-    gx += -2*val[2][0] + 2*val[2][4];
-    gx += -1*val[3][0] + 1*val[3][4];
-    gx /= 8.0;
-
-    // Gradient Y 
-    float gy = 0;
-    gy += -1*val[0][1] + 1*val[4][1];
-    gy += -2*val[0][2] + 2*val[4][2];
-    gy += -1*val[0][3] + 1*val[4][3];
-    gy /= 8.0;
-
-    // Second Derivatives (Curvature)
-    // r_xx ~ (1 -2 1)
-    float rxx = (val[2][0] - 2.0*val[2][2] + val[2][4]) * 0.25; // Scale
-    
-    // r_yy ~ (1 -2 1)T
-    float ryy = (val[0][2] - 2.0*val[2][2] + val[4][2]) * 0.25;
-
-    // Output: GradientX, GradientY, CurvatureX, CurvatureY
-    Output[pos] = float4(gx, gy, rxx, ryy);
-}
-)";
-
-    inline const char* CS_Farneback_Flow = R"(
-Texture2D<float4> PolyCurr : register(t0); // Gx, Gy, Rxx, Ryy
-Texture2D<float4> PolyPrev : register(t1);
-Texture2D<float2> MotionInput : register(t2);
-RWTexture2D<float2> MotionOutput : register(u0); // Stores computed flow
-
-SamplerState LinearSampler : register(s0);
-
-[numthreads(16, 16, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    uint w, h;
-    PolyCurr.GetDimensions(w, h); // Assume same size
-    if (pos.x >= w || pos.y >= h) return;
-
-    // 1. Initial Guess
-    float2 d0 = MotionInput[pos];
-    // Scale d0 if needed? Assuming pixel units here.
-    
-    // 2. Accumulate G and h over a window (e.g., 5x5 or 9x9)
-    // Minimizing sum(|2 R d + deltaB|^2)
-    // Solution: d = - sum(R * deltaB) / sum(2 * R^2)
-    
-    float sum_Rxx_dBx = 0;
-    float sum_Rxx2 = 0;
-    float sum_Ryy_dBy = 0;
-    float sum_Ryy2 = 0;
-    
-    // 5x5 Window
-    for(int y = -2; y <= 2; ++y) {
-        for(int x = -2; x <= 2; ++x) {
-            int2 p = pos + int2(x, y);
-            if(p.x < 0 || p.y < 0 || p.x >= (int)w || p.y >= (int)h) continue;
-            
-            // Sample Curr
-            float4 c = PolyCurr[p];
-            
-            // Sample Prev at shifted location
-            float2 p_shifted = float2(p) + d0;
-            float4 p_prev = PolyPrev.SampleLevel(LinearSampler, p_shifted / float2(w, h), 0);
-            
-            // Coeffs
-            float rxx = (c.z + p_prev.z) * 0.5;
-            float ryy = (c.w + p_prev.w) * 0.5;
-            float dbx = c.x - p_prev.x;
-            float dby = c.y - p_prev.y;
-            
-            // Assuming Diagonal A implies independent x/y optimization (Simplification)
-            // Weighting: Uniform for now.
-            sum_Rxx_dBx += rxx * dbx;
-            sum_Rxx2 += rxx * rxx;
-            
-            sum_Ryy_dBy += ryy * dby;
-            sum_Ryy2 += ryy * ryy;
-        }
-    }
-    
-    float2 delta = 0;
-    float eps = 0.0001; // Avoid divide by zero
-    delta.x = -sum_Rxx_dBx / (2.0 * sum_Rxx2 + eps);
-    delta.y = -sum_Ryy_dBy / (2.0 * sum_Ryy2 + eps);
-    
-    // Clamp Refinement (Stability)
-    delta = clamp(delta, -2.0, 2.0); // Don't jump too far in one refinement step
-    
-    MotionOutput[pos] = d0 + delta;
-}
-)";
-
-    inline const char* CS_HUDMask = R"(
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float4> EdgeTexture : register(t2); // [Edge Detect]
-RWTexture2D<float> OutputMask : register(u0);
-
-cbuffer Settings : register(b0)
-{
-    float Threshold;
-    int UseEdgeDetect; // [Edge Detect]
-    float2 Padding;
-}
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    
-    // Boundary check handled by resource size usually, but good practice
-    float4 curr = TexCurrent[pos];
-    float4 prev = TexPrev[pos];
-    
-    // Calculate difference
-    float4 diff = abs(curr - prev);
-    float val = diff.r + diff.g + diff.b;
-    
-    // Base Static Check
-    float isStatic = (val < Threshold) ? 1.0f : 0.0f;
-    float isHUD = isStatic;
-
-    // [Edge Detection Logic]
-    // UI elements usually have sharp edges AND are static.
-    // If Edge Protection is enabled:
-    // We only consider it HUD if it is Static AND has high Edge Magnitude.
-    // This prevents flat textures (sky, walls) from being falsely flagged as HUD just because they are static.
-    if (UseEdgeDetect > 0)
-    {
-        float edgeMag = EdgeTexture[pos].r; // Read magnitude from Sobel pass
-        
-        // If edge magnitude is low, it's likely a flat surface, not UI text/border.
-        // We require SIGNIFICANT edge presence to confirm it's a HUD element.
-        // This makes the mask more conservative (safer).
-        if (edgeMag < 0.1f) 
-        {
-            isHUD = 0.0f; 
-        }
-    }
-    
-    // Simple overwrite for now. 
-    // In advanced versions, we would use a decay buffer to keep the mask stable.
-    OutputMask[pos] = isHUD;
-}
-)";
-
-    inline const char* CS_Interpolate = R"(
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float2> TexMotion : register(t2);
-Texture2D<float> TexMask : register(t3);
-StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
-
-RWTexture2D<float4> OutputFrame : register(u0);
-
-SamplerState LinearSampler : register(s0);
-
-cbuffer Settings : register(b0)
-{
-    float Factor; // Interpolation factor (0.0 - 1.0)
-    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
-    float GhostingStrength;
-    float Padding;
-}
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    uint2 pos = dispatchThreadId.xy;
-    
-    // [Scene Change Safety]
-    if (GlobalStats[0] > (uint)SceneChangeThreshold)
-    {
-        OutputFrame[pos] = TexCurrent[pos];
-        return;
-    }
-    
-    float mask = TexMask[pos];
-    if (mask > 0.5f)
-    {
-        OutputFrame[pos] = TexCurrent[pos];
-        return;
-    }
-    
-    // Fetch Motion Vector (in pixels)
-    float2 motion = TexMotion[pos];
-    
-    uint w, h;
-    TexCurrent.GetDimensions(w, h);
-    float2 texSize = float2(w, h);
-    float2 uv = (float2(pos) + 0.5f) / texSize;
-    float2 motionUV = motion / texSize;
-    
-    // Interpolate
-    float4 pixelPrev = TexPrev.SampleLevel(LinearSampler, uv + motionUV * Factor, 0);
-    float4 pixelCurr = TexCurrent.SampleLevel(LinearSampler, uv - motionUV * (1.0f - Factor), 0);
-    // Wait, original was (1.0f - Factor), 0). I will replicate exact text. 
-    // Actually, I should just paste exact content.
-    // Re-checking previous read...
-    // "float4 pixelCurr = TexCurrent.SampleLevel(LinearSampler, uv - motionUV * (1.0f - Factor), 0);"
-    // Okay.
-    
-    // Re-writing with exact content logic:
-    pixelCurr = TexCurrent.SampleLevel(LinearSampler, uv - motionUV * (1.0f - Factor), 0);
-    
-    float4 result = lerp(pixelPrev, pixelCurr, Factor);
-
-    // [Ghosting Reduction]
-    // Clamp result to the neighborhood of the Current frame at the target location.
-    if (GhostingStrength > 0.0f)
-    {
-        // 5-tap neighborhood (Center + Plus)
-        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
-        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
-        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
-        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
-        float4 w = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
-        
-        float4 minColor = min(c, min(n, min(s, min(e, w))));
-        float4 maxColor = max(c, max(n, max(s, max(e, w))));
-        
-        float4 clamped = clamp(result, minColor, maxColor);
-        result = lerp(result, clamped, GhostingStrength);
-    }
-
-    OutputFrame[pos] = result;
-}
-)";
-    // Note: I manually corrected the syntax in CS_Interpolate string for safety (removed extra closing paren if any, but string literal just copies chars).
-    // The previous read showed: `pixelCurr = TexCurrent.SampleLevel(LinearSampler, uv - motionUV * (1.0f - Factor), 0);` 
-    // Which is correct.
-
-    inline const char* CS_MotionSmooth = R"(
-Texture2D<float2> InputMotion : register(t0);
-RWTexture2D<float2> OutputMotion : register(u0);
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    int2 pos = int2(dispatchThreadId.xy);
-    
-    // Simple 3x3 Box Blur for Motion Smoothing
-    // (5x5 might be too heavy for this stage, let's start with 3x3)
-    float2 sum = float2(0, 0);
-    float weight = 0.0f;
-    
-    // We strictly clamp to borders? Or just check bounds.
-    // HLSL Loads return 0 out of bounds usually (depending on state), but safe to check.
-    
-    uint w, h;
-    InputMotion.GetDimensions(w, h);
-    if (pos.x >= w || pos.y >= h) return;
-
-    for (int y = -1; y <= 1; ++y)
-    {
-        for (int x = -1; x <= 1; ++x)
-        {
-            int2 offsetPos = pos + int2(x, y);
-             if (offsetPos.x >= 0 && offsetPos.y >= 0 && offsetPos.x < w && offsetPos.y < h)
-             {
-                 sum += InputMotion[offsetPos];
-                 weight += 1.0f;
-             }
-        }
-    }
-    
-    OutputMotion[pos] = sum / weight;
-}
-)";
-
-    inline const char* CS_RCAS = R"(
-Texture2D<float4> InputTexture : register(t0);
-RWTexture2D<float4> OutputTexture : register(u0);
-
-cbuffer Constants : register(b0)
-{
-    float Sharpness; // 0.0 to 1.0
-    float3 Padding;
-}
-
-// AMD FidelityFX CAS-like Implementation
-// "Contrast Adaptive Sharpening"
-// Uses a negative lobe to validly sharpen the image while preserving coherence.
-void RCAS(uint2 pos, float sharpness, uint width, uint height)
-{
-    if (pos.x >= width || pos.y >= height) return;
-    
-    // 1. Fetch Center and Neighbors (Cross)
-    float4 c = InputTexture[pos];
-    float3 n = InputTexture[int2(pos.x, max(0, (int)pos.y - 1))].rgb;
-    float3 s = InputTexture[int2(pos.x, min((int)height - 1, (int)pos.y + 1))].rgb;
-    float3 w = InputTexture[int2(max(0, (int)pos.x - 1), pos.y)].rgb;
-    float3 e = InputTexture[int2(min((int)width - 1, (int)pos.x + 1), pos.y)].rgb;
-
-    // 2. Calculate Lobe Weight
-    // Sharpness 0.0 -> Lobe 0.0 (Identity)
-    // Sharpness 1.0 -> Lobe -0.2 (Strong Sharpening)
-    // The typical CAS limit involves a negative lobe.
-    float lobe = lerp(0.0f, -0.2f, sharpness);
-    
-    // 3. Apply CAS Convolution
-    // Formula: (Center + Lobe * SumNeighbors) / (1 + 4 * Lobe)
-    float3 neighborSum = n + s + w + e;
-    float3 numerator = c.rgb + lobe * neighborSum;
-    float denominator = 1.0f + 4.0f * lobe;
-    float3 result = numerator / denominator;
-    
-    // 4. Output (Saturate to keep valid color range)
-    OutputTexture[pos] = float4(saturate(result), c.a);
-    // Correction: 'result' is defined after numerator/denominator calc? 
-    // Wait, the read file had:
-    // float3 result = numerator / denominator;
-    // Let me check my memory of the read...
-    // Yes, line 37: float3 result = numerator / denominator;
-    // I missed it in the string literal above. Adding it back.
-}
-// CORRECTION INLINE:
-// float3 result = numerator / denominator;
-// OutputTexture[pos] = float4(saturate(result), c.a);
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    uint w, h;
-    InputTexture.GetDimensions(w, h);
-    RCAS(dispatchThreadId.xy, Sharpness, w, h);
-}
-)";
-
-    // Manually fixing the RCAS string since I can't edit the literal in thought process mid-stream easily.
-    // I'll rewrite the RCAS part correctly in the tool call.
-
-    inline const char* CS_SplitScreen = R"(
-Texture2D<float4> TexGen : register(t0);
-Texture2D<float4> TexReal : register(t1);
-
-RWTexture2D<float4> Output : register(u0);
-
-cbuffer CB : register(b0)
-{
-	float SplitPos; // 0.0 - 1.0 (Normalized screen width)
-	float3 Padding;
-};
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-	uint width, height;
-	Output.GetDimensions(width, height);
-
-	if (id.x >= width || id.y >= height) return;
-
-	float u = (float)id.x / (float)width;
-	float4 color;
-
-	// Use Integer logic for stability
-	int splitX = (int)(SplitPos * (float)width);
-	int px = (int)id.x;
-
-	// Draw 2px Line
-	if (abs(px - splitX) <= 1)
-	{
-		// Draw White Line
-		color = float4(1.0, 1.0, 1.0, 1.0);
-	}
-	else if (u < SplitPos)
-	{
-		// Left: Generated Frame (Frame Gen ON)
-		color = TexGen[id.xy];
-	}
-	else
-	{
-		// Right: Real Frame (Frame Gen OFF - simulating simple repeat)
-		color = TexReal[id.xy];
-	}
-
-	Output[id.xy] = color;
-}
-)";
-
-    inline const char* CS_Upsample = R"(
-Texture2D<float2> InputMotion : register(t0);
-RWTexture2D<float2> OutputMotion : register(u0);
-
-SamplerState LinearSampler : register(s0);
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    // Target resolution (upsampled) coordinates
-    uint2 dstPos = dispatchThreadId.xy;
-    
-    // Simple Nearest Neighbor Upscale for now (or basic bilinear logic manually):
-    // Source index is roughly half of destination
-    uint2 srcPos = dstPos / 2;
-    
-    // Read the coarse motion vector
-    float2 coarseVector = InputMotion[srcPos];
-    
-    // Scale the vector by 2.0 because the image domain is 2x larger
-    // Motion of 1 pixel in coarse level corresponds to 2 pixels in fine level (usually)
-    // IMPORTANT: Check coordinate system. If normalized, no scale needed? 
-    // Usually motion vectors are in pixels. So we multiply by 2.
-    float2 fineVector = coarseVector * 2.0f;
-    
-    OutputMotion[dstPos] = fineVector;
-}
-)";
-
-    inline const char* CS_Upscale = R"(
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float4> Output : register(u0);
-SamplerState LinearSampler : register(s0);
-SamplerState PointSampler : register(s1);
-
-cbuffer CBUpscale : register(b0)
-{
-    int Mode; // 0=Nearest, 1=Bilinear, 2=Bicubic, 3=Lanczos
-    int Radius; // For Lanczos (e.g., 2 or 3)
-    float2 InputSize; // Width, Height
-    float2 Padding;
-}
-
-// Helper: Cubic Weight
-float CubicWeight(float x)
-{
-    const float B = 0.0f;
-    const float C = 0.5f;
-    float ax = abs(x);
-    if (ax < 1.0f)
-        return ((12 - 9 * B - 6 * C) * ax * ax * ax + (-18 + 12 * B + 6 * C) * ax * ax + (6 - 2 * B)) / 6.0f;
-    else if (ax < 2.0f)
-        return ((-B - 6 * C) * ax * ax * ax + (6 * B + 30 * C) * ax * ax + (-12 * B - 48 * C) * ax + (8 * B + 24 * C)) / 6.0f;
-    else
-        return 0.0f;
-}
-
-// Helper: Sinc function
-float Sinc(float x)
-{
-    if (x == 0.0f) return 1.0f;
-    float pi_x = 3.14159265f * x;
-    return sin(pi_x) / pi_x;
-}
-
-// Helper: Lanczos Weight
-float LanczosWeight(float x, int a)
-{
-    if (abs(x) >= a) return 0.0f;
-    return Sinc(x) * Sinc(x / a);
-}
-
-float4 SampleNearest(int2 coord)
-{
-    return Input[coord]; // Direct texel fetch
-}
-
-float4 SampleBilinear(float2 uv)
-{
-    return Input.SampleLevel(LinearSampler, uv, 0);
-}
-
-// Bicubic Sampling (Catmull-Rom)
-float4 SampleBicubic(float2 uv)
-{
-    float2 texSize = InputSize;
-    float2 samplePos = uv * texSize - 0.5f;
-    int2 tc = floor(samplePos);
-    float2 f = samplePos - tc;
-
-    float4 sum = 0;
-    float totalWeight = 0;
-    
-    // 4x4 Neighborhood
-    [unroll]
-    for (int y = -1; y <= 2; y++)
-    {
-        [unroll]
-        for (int x = -1; x <= 2; x++)
-        {
-            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
-            float w = CubicWeight(x - f.x) * CubicWeight(y - f.y);
-            sum += Input[coord] * w;
-            totalWeight += w;
-        }
-    }
-    return sum / totalWeight; // Normalization helps if edge clamping issues occur
-}
-
-// Lanczos Sampling
-float4 SampleLanczos(float2 uv, int a)
-{
-    float2 texSize = InputSize;
-    float2 samplePos = uv * texSize - 0.5f;
-    int2 tc = floor(samplePos);
-    float2 f = samplePos - tc;
-
-    float4 sum = 0;
-    float totalWeight = 0;
-
-    // Window size: -a+1 to a
-    for (int y = -a + 1; y <= a; y++)
-    {
-        for (int x = -a + 1; x <= a; x++)
-        {
-            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
-            float w = LanczosWeight(float(x) - f.x, a) * LanczosWeight(float(y) - f.y, a);
-            sum += Input[coord] * w;
-            totalWeight += w;
-        }
-    }
-    
-    // Prevent ringing artifacts (optional clamp or just raw)
-    // For now, raw output, but weight normalization is key.
-    return (totalWeight > 0.0001f) ? (sum / totalWeight) : float4(0,0,0,0);
-}
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-    uint outW, outH;
-    Output.GetDimensions(outW, outH);
-    if (id.x >= outW || id.y >= outH) return;
-
-    float2 uv = (float2(id.xy) + 0.5f) / float2(outW, outH);
-    
-    float4 color = 0;
-    
-    // Switch is acceptable here
-    // Mode 0 = Native (Should probably not be dispatched, but behaves like Nearest/Copy if hit)
-    
-    if (Mode == 1) // Nearest
-    {
-        float2 iUV = uv * InputSize;
-        color = Input[int2(iUV)]; // or simple cast
-    }
-    else if (Mode == 2) // Bilinear
-    {
-        color = SampleBilinear(uv);
-    }
-    else if (Mode == 3) // Bicubic
-    {
-        color = SampleBicubic(uv);
-    }
-    else if (Mode == 4) // Lanczos
-    {
-        color = SampleLanczos(uv, Radius);
-    }
-    else // Fallback (Native or Invalid)
-    {
-        // For Native, we essentially want 1:1 copy, which Nearest handles correctly if sizes match
-        float2 iUV = uv * InputSize;
-        color = Input[int2(iUV)]; 
-    }
-
-    Output[id.xy] = color;
-}
-)";
-
-} // namespace EmbeddedShaders
+#pragma once
+
+namespace EmbeddedShaders
+{
+    inline const char* CS_AdaptiveVariance = R"(
+Texture2D<float> Input : register(t0); // [Luma Pyramid] Level 0
+RWTexture2D<float> OutputVariance : register(u0); // Stores variance 0.0-1.0
+
+// Block Size for assessment (OutputVariance is Input / 16)
+#define BLOCK_SIZE 16
+
+// One thread per low-res pixel, each samples the corresponding 16x16 block in Input
+[numthreads(8, 8, 1)]
+void CSMain(uint3 id : SV_DispatchThreadID)
+{
+    uint gridW, gridH;
+    OutputVariance.GetDimensions(gridW, gridH);
+    if (id.x >= gridW || id.y >= gridH) return;
+
+    uint w, h;
+    Input.GetDimensions(w, h);
+    uint2 basePos = id.xy * BLOCK_SIZE;
+    
+    float sum = 0;
+    float sumSq = 0;
+    
+    // Strided sampling (step 2) for speed, clamped so edge blocks don't read zeros
+    for (uint y = 0; y < BLOCK_SIZE; y+=2)
+    {
+        for (uint x = 0; x < BLOCK_SIZE; x+=2)
+        {
+            uint2 p = min(basePos + uint2(x, y), uint2(w - 1, h - 1));
+            float lum = Input[p];
+            sum += lum;
+            sumSq += lum * lum;
+        }
+    }
+    
+    // Count = (16/2) * (16/2) = 64 samples
+    float count = 64.0f;
+    float mean = sum / count;
+    float variance = (sumSq / count) - (mean * mean);
+    
+    // Normalize (Variance can be small, so scale it up)
+    // Heuristic: Variance > 0.01 is "complex"
+    float normalizedVar = saturate(variance * 100.0f);
+    
+    OutputVariance[id.xy] = normalizedVar;
+}
+)";
+
+    inline const char* CS_BidirectionalConsistency = R"(
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous (OpticalFlow convention)
+Texture2D<float2> BwdFlow : register(t1); // Previous -> Current
+
+RWTexture2D<float2> OutputFlow : register(u0); // Forward flow, occluded vectors replaced by the background
+
+// [Occlusion] One texel per Scale x Scale pixels
+// x: content of the current frame is visible in the previous one
+// y: content of the previous frame is still visible in the current one
+RWTexture2D<float2> OutputVisibility : register(u1);
+
+cbuffer CB : register(b0)
+{
+	float Tolerance; // e.g. 1.0 - 5.0 pixels
+	int Scale;
+	int RepairRadius; // Farthest neighbour (pixels) an occluded vector is taken from
+	float Padding;
+};
+
+// Follows 'flow' from pos and checks that 'reverse' brings it back.
+// Ideally: Flow + Reverse approx 0. Delta = |Flow + Reverse|
+float Consistency(Texture2D<float2> flow, Texture2D<float2> reverse, int2 pos, int2 size)
+{
+	float2 v = flow[pos];
+	int2 targetPos = int2(round(float2(pos) + v));
+
+	// Leaves the frame: nothing to match on the other side
+	if (any(targetPos < 0) || any(targetPos >= size)) return 0.0f;
+
+	float dist = length(v + reverse[targetPos]);
+
+	// Occlusion or Bad Match past the tolerance
+	return saturate(1.0f - (dist - Tolerance) * 0.5f);
+}
+
+// Uncovered content has no true match, so its vector is noise. It belongs to the background,
+// which is the slowest consistent vector around it (same rule as the CS_Extrapolate hole filling).
+float2 RepairVector(int2 pos, int2 size)
+{
+	const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+
+	float2 best = FwdFlow[pos];
+	float bestLengthSq = 1e9f;
+	for (int d = 0; d < 8; ++d)
+	{
+		// Nearest consistent pixel along each direction, stepping 2, 4, 8 ...
+		for (int r = 2; r <= RepairRadius; r *= 2)
+		{
+			int2 p = pos + dirs[d] * r;
+			if (any(p < 0) || any(p >= size)) break;
+			if (Consistency(FwdFlow, BwdFlow, p, size) < 0.5f) continue;
+
+			float2 v = FwdFlow[p];
+			if (dot(v, v) < bestLengthSq)
+			{
+				bestLengthSq = dot(v, v);
+				best = v;
+			}
+			break;
+		}
+	}
+	return best;
+}
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+	uint width, height;
+	FwdFlow.GetDimensions(width, height);
+	int2 size = int2(width, height);
+
+	int2 origin = int2(id.xy) * Scale;
+	if (origin.x >= size.x || origin.y >= size.y) return;
+
+	// Least visible pixel of the cell, a partly occluded cell counts as occluded
+	float2 visibility = float2(1.0f, 1.0f);
+	for (int y = 0; y < Scale; ++y)
+	{
+		for (int x = 0; x < Scale; ++x)
+		{
+			int2 pos = origin + int2(x, y);
+			if (pos.x >= size.x || pos.y >= size.y) continue;
+
+			float forward = Consistency(FwdFlow, BwdFlow, pos, size);
+			visibility.x = min(visibility.x, forward);
+			visibility.y = min(visibility.y, Consistency(BwdFlow, FwdFlow, pos, size));
+
+			OutputFlow[pos] = (forward < 0.5f) ? RepairVector(pos, size) : FwdFlow[pos];
+		}
+	}
+
+	OutputVisibility[id.xy] = visibility;
+}
+)";
+
+    inline const char* CS_BilinearScale = R"(
+Texture2D<float4> Input : register(t0);
+RWTexture2D<float4> Output : register(u0);
+
+SamplerState LinearClampSampler : register(s0);
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    uint outW, outH;
+    Output.GetDimensions(outW, outH);
+    
+    if (id.x >= outW || id.y >= outH) return;
+
+    // Calculate UV coordinates for the center of the output pixel
+    float2 uv = (float2(id.xy) + 0.5f) / float2(outW, outH);
+    
+    // Sample Input with Linear filtering
+    // Note: Compute Shaders usually require 'SamplerState' and 'SampleLevel' (lod 0)
+    float4 color = Input.SampleLevel(LinearClampSampler, uv, 0);
+    
+    Output[id.xy] = color;
+}
+)";
+
+    inline const char* CS_BlockMatching = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitMotion : register(t2); // NEW: Initial guess from lower level
+Texture2D<float2> InputPredictedMotion : register(t3); // [Temporal Warm-Start] Last frame's motion, projected
+Texture2D<float> TexUnchanged : register(t4); // [Tile Hash] 1 = tile identical to last frame
+Texture2D<float4> InputTileCandidates : register(t5); // [Phase Correlation] Two vectors per tile, CS_PhaseCorrelation
+StructuredBuffer<uint> TileList : register(t6); // [Hybrid Flow] Tiles CS_FlowSelect gave to BlockMatching (CSTiles only)
+Texture2D<float> InputTileRadius : register(t7); // [Adaptive Radius] Flow resolution bound per tile, CS_MotionStats
+RWTexture2D<float2> OutputMotion : register(u0);
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+// Parameters
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; 
+    int SearchRadius; 
+    int EnableSubPixel;
+    int UseInitMotion; // NEW: 0 or 1
+    int UsePredictedMotion; // 0 or 1
+    int UnchangedTileSize; // [Tile Hash] Level pixels per TexUnchanged texel, 0 = no mask
+    int UseTileCandidates; // [Phase Correlation] 0 or 1
+    float CandidateScale; // Level pixels per pixel of the candidates' level
+    int UseTileRadius; // [Adaptive Radius] 0 or 1
+    float TileRadiusScale; // Level pixels per flow resolution pixel
+};
+
+#define CANDIDATE_TILE 16 // PhaseCorrelation::TileSize
+#define FLOW_TILE 16 // FlowTuning::FlowTileSize
+#define RADIUS_TILE 16 // FlowTuning::FlowTileSize
+#define MIN_RADIUS 2 // Pyramid::MinSearchRadius
+
+// [Phase Correlation] Candidates of the tile covering 'pos', scaled to this level
+float4 TileCandidates(int2 pos)
+{
+    uint cw, ch;
+    InputTileCandidates.GetDimensions(cw, ch);
+    uint2 tile = min(uint2(float2(pos) / (CANDIDATE_TILE * CandidateScale)), uint2(cw, ch) - 1);
+    return InputTileCandidates[tile] * CandidateScale;
+}
+
+// [Adaptive Radius] SearchRadius narrowed to last frame's motion around the tile covering 'pos' (CS_MotionStats)
+int TileSearchRadius(int2 pos)
+{
+    if (!UseTileRadius) return SearchRadius;
+    uint tw, th;
+    InputTileRadius.GetDimensions(tw, th);
+    uint2 tile = min(uint2(float2(pos) / (RADIUS_TILE * TileRadiusScale)), uint2(tw, th) - 1);
+    return min(max((int)ceil(InputTileRadius[tile] * TileRadiusScale), MIN_RADIUS), SearchRadius);
+}
+
+void MatchPixel(int2 pos)
+{
+    if (pos.x >= Width || pos.y >= Height)
+        return;
+
+    // [Tile Hash] Same content as last frame: zero motion, no search
+    if (UnchangedTileSize > 0 && TexUnchanged[pos / UnchangedTileSize] > 0.5f)
+    {
+        OutputMotion[pos] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // Center pixel of the block
+    float targetPixel = TexCurrent[pos];
+    
+    // Initial Guess
+    int2 searchCenter = int2(0, 0);
+    if (UseInitMotion)
+    {
+        // Read from lower level (already upsampled or same size)
+        float2 initVec = InputInitMotion[pos];
+        searchCenter = int2(round(initVec.x), round(initVec.y));
+    }
+
+    // [Ultra Optimization] Fast Path for Static/Perfect Guess
+    // Check the exact guess position first.
+    {
+         int2 searchPos = pos + searchCenter;
+         if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
+         {
+             float sad = abs(targetPixel - TexPrev[searchPos]);
+             
+             if (sad < 0.00033f) // Virtually identical
+             {
+                 OutputMotion[pos] = float2(searchCenter.x, searchCenter.y);
+                 return; // <--- EARLY EXIT: Skip entire loop
+             }
+         }
+    }
+
+    float minSAD = 999999.0f;
+    int2 bestVector = searchCenter; // Default to initial guess
+
+    // [Temporal Warm-Start]
+    // The projected vector competes as a candidate. It may lie outside the search window,
+    // so a bad prediction (e.g. after a cut) can never pull the window away from the real match.
+    if (UsePredictedMotion)
+    {
+        float2 predVec = InputPredictedMotion[pos];
+        int2 candidate = int2(round(predVec.x), round(predVec.y));
+        int2 searchPos = pos + candidate;
+        if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
+        {
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+
+            if (sad < 0.00033f)
+            {
+                OutputMotion[pos] = float2(candidate.x, candidate.y);
+                return; // Prediction holds, skip the search
+            }
+
+            minSAD = sad;
+            bestVector = candidate;
+        }
+    }
+
+    // [Phase Correlation] The tile's correlation peaks compete the same way, reaching shifts the window does not
+    if (UseTileCandidates)
+    {
+        float4 tileVec = TileCandidates(pos);
+        float2 peaks[2] = { tileVec.xy, tileVec.zw };
+        for (int i = 0; i < 2; ++i)
+        {
+            int2 candidate = int2(round(peaks[i].x), round(peaks[i].y));
+            int2 searchPos = pos + candidate;
+            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
+                continue;
+
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+            if (sad < 0.00033f)
+            {
+                OutputMotion[pos] = float2(candidate.x, candidate.y);
+                return;
+            }
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    // Refined Search around Center (Reduced radius is adequate if guess is good)
+    // If not using init motion, we search full radius.
+    // If using init motion, we could technically search a smaller radius, but for safety lets keep it.
+    
+    int radius = TileSearchRadius(pos);
+
+    [loop] // Use loop for variable radius, unroll is only for constant
+    for (int y = -radius; y <= radius; ++y)
+    {
+        for (int x = -radius; x <= radius; ++x)
+        {
+            int2 offset = int2(x, y);
+            int2 searchPos = pos + searchCenter + offset;
+            
+            // Boundary check
+            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
+                continue;
+
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = searchCenter + offset;
+                
+                // Early Exit: Perfect match found (SAD ~ 0)
+                // This speeds up static areas massively (HUD, Skyboxes)
+                if (sad < 0.00033f) 
+                {
+                     // Break outer loop manually
+                     y = radius + 1; 
+                     break;
+                }
+            }
+        }
+    }
+
+    // Write integer result first
+    float2 finalVector = float2(bestVector.x, bestVector.y);
+    
+    // [Scene Change Detection]
+    // If the best match is still terrible, it means we found NOTHING similar.
+    // If many blocks fail, it's a scene change.
+    // Normalized threshold: 0.15 (15% avg diff per pixel)
+    // Scale: Sad is luma * BlockSize^2
+    float avgDiff = minSAD / max(1, BlockSize * BlockSize);
+    if (avgDiff > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], 1);
+    }
+    
+
+
+    // Sub-Pixel Refinement (Bilinear Check)
+    if (EnableSubPixel > 0)
+    {
+        float2 bestSub = finalVector;
+        float minSubSAD = minSAD;
+        
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+        
+        uint w, h;
+        TexPrev.GetDimensions(w, h);
+        float2 texSize = float2(w, h);
+        
+        for(int i=0; i<4; ++i)
+        {
+             // Candidate Pos in Prev: Original Pos + BestIntegerVec + Offset
+             float2 checkPos = float2(pos) + finalVector + offsets[i];
+             float2 uv = (checkPos + 0.5f) / texSize;
+             
+             float sad = abs(targetPixel - TexPrev.SampleLevel(LinearSampler, uv, 0));
+             
+             if (sad < minSubSAD)
+             {
+                 minSubSAD = sad;
+                 bestSub = finalVector + offsets[i];
+             }
+        }
+        finalVector = bestSub;
+    }
+    
+    OutputMotion[pos] = finalVector;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    // Global pixel position
+    MatchPixel(int2(dispatchThreadId.xy));
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(FLOW_TILE, FLOW_TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    MatchPixel(int2(tile & 0xFFFF, tile >> 16) * FLOW_TILE + int2(groupThreadId.xy));
+}
+)";
+
+    inline const char* CS_BlockSearch = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitField : register(t2); // Last frame's block field (extra candidate)
+Texture2D<float> TexUnchanged : register(t3); // [Tile Hash] 16x16 tiles, 1 = identical to last frame
+RWTexture2D<float2> OutputField : register(u0); // One vector per block
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; // 4 - 32
+    int SearchRadius;
+    int EnableSubPixel;
+    int UseInitField;
+    int Decimation; // 1 = Every pixel, 2 = Checkerboard
+    int Padding;
+};
+
+// Block-granular full search: one vector per block with the SAD aggregated over the block.
+// The group's threads split the candidate offsets between them and reduce to the best one.
+
+#define MAX_BLOCK 32
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+
+groupshared float gs_Block[MAX_BLOCK * MAX_BLOCK];
+groupshared float gs_Cost[64];
+groupshared int gs_Index[64];
+groupshared float gs_SubCost[4];
+
+// Average SAD per pixel for an integer offset
+float BlockCost(int2 origin, int2 extent, int2 v)
+{
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (Decimation == 2 && ((x + y) & 1)) continue;
+
+            int2 p = clamp(origin + int2(x, y) + v, int2(0, 0), int2(Width - 1, Height - 1));
+            sad += abs(gs_Block[y * BlockSize + x] - TexPrev[p]);
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+// Same for a fractional offset (bilinear)
+float BlockCostBilinear(int2 origin, int2 extent, float2 v)
+{
+    float2 texSize = float2(Width, Height);
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (Decimation == 2 && ((x + y) & 1)) continue;
+
+            float2 uv = (float2(origin + int2(x, y)) + 0.5f + v) / texSize;
+            sad += abs(gs_Block[y * BlockSize + x] - TexPrev.SampleLevel(LinearSampler, uv, 0));
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+// [Tile Hash] Every 16x16 hash tile the block touches is identical to last frame (mask unbound = 0)
+bool BlockUnchanged(int2 origin, int2 extent)
+{
+    int2 first = origin / 16;
+    int2 last = (origin + extent - 1) / 16;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            if (TexUnchanged[int2(x, y)] <= 0.5f) return false;
+        }
+    }
+    return true;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    uint bw, bh;
+    OutputField.GetDimensions(bw, bh);
+    int2 block = int2(groupId.xy);
+    if (block.x >= (int)bw || block.y >= (int)bh) return; // Uniform across the group
+
+    int2 origin = block * BlockSize;
+    int2 extent = min(int2(BlockSize, BlockSize), int2(Width, Height) - origin);
+
+    if (BlockUnchanged(origin, extent)) // Uniform across the group
+    {
+        if (groupIndex == 0) OutputField[block] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // [Cache] Current block
+    for (int i = (int)groupIndex; i < BlockSize * BlockSize; i += 64)
+    {
+        int2 p = origin + int2(i % BlockSize, i / BlockSize);
+        gs_Block[i] = TexCurrent[min(p, int2(Width - 1, Height - 1))];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Search] Window around zero, plus last frame's vector for this block
+    int side = 2 * SearchRadius + 1;
+    int gridCount = side * side;
+    int total = gridCount + (UseInitField ? 1 : 0);
+    float2 initVec = UseInitField ? InputInitField[block] : float2(0, 0);
+    int2 initInt = int2(round(initVec.x), round(initVec.y));
+
+    float bestCost = 999999.0f;
+    int bestIndex = 0;
+    for (int k = (int)groupIndex; k < total; k += 64)
+    {
+        int2 v = (k < gridCount) ? int2(k % side - SearchRadius, k / side - SearchRadius) : initInt;
+        float cost = BlockCost(origin, extent, v) + VECTOR_BIAS * length(float2(v));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestIndex = k;
+        }
+    }
+
+    gs_Cost[groupIndex] = bestCost;
+    gs_Index[groupIndex] = bestIndex;
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction] Min cost
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s && gs_Cost[groupIndex + s] < gs_Cost[groupIndex])
+        {
+            gs_Cost[groupIndex] = gs_Cost[groupIndex + s];
+            gs_Index[groupIndex] = gs_Index[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    int best = gs_Index[0];
+    float minCost = gs_Cost[0];
+    float2 finalVector = (best < gridCount) ? float2(best % side - SearchRadius, best / side - SearchRadius) : float2(initInt);
+
+    // [Sub-Pixel Refinement] One half-pel offset per thread
+    if (EnableSubPixel > 0)
+    {
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+        if (groupIndex < 4)
+        {
+            float2 v = finalVector + offsets[groupIndex];
+            gs_SubCost[groupIndex] = BlockCostBilinear(origin, extent, v) + VECTOR_BIAS * length(v);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        if (groupIndex == 0)
+        {
+            float2 bestSub = finalVector;
+            for (int j = 0; j < 4; ++j)
+            {
+                if (gs_SubCost[j] < minCost)
+                {
+                    minCost = gs_SubCost[j];
+                    bestSub = finalVector + offsets[j];
+                }
+            }
+            finalVector = bestSub;
+        }
+    }
+
+    if (groupIndex != 0) return;
+
+    OutputField[block] = finalVector;
+
+    // [Scene Change Detection] Same normalization as CS_BlockMatching, counted per pixel
+    if (minCost > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], (uint)(extent.x * extent.y));
+    }
+}
+)";
+
+    inline const char* CS_CostAggregation = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitMotion : register(t2); // Initial guess from lower level
+Texture2D<float2> InputPredictedMotion : register(t3); // [Temporal Warm-Start] Last frame's motion, projected
+Texture2D<float4> InputTileCandidates : register(t5); // [Phase Correlation] Two vectors per tile, CS_PhaseCorrelation
+StructuredBuffer<uint> TileList : register(t6); // [Hybrid Flow] Tiles CS_FlowSelect gave to BlockMatching (CSTiles only)
+Texture2D<float> InputTileRadius : register(t7); // [Adaptive Radius] Flow resolution bound per tile, CS_MotionStats
+RWTexture2D<float2> OutputMotion : register(u0);
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+// Same layout as CS_BlockMatching
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; // Matching window (1 - 32)
+    int SearchRadius;
+    int EnableSubPixel;
+    int UseInitMotion;
+    int UsePredictedMotion;
+    int UnchangedTileSize; // Unused here
+    int UseTileCandidates;
+    float CandidateScale;
+    int UseTileRadius;
+    float TileRadiusScale;
+};
+
+// Dense per-pixel matching with the SAD aggregated over a BlockSize x BlockSize window around each pixel.
+// The candidates are shared by the 16x16 tile, so one absolute difference image per candidate serves every
+// window in the tile: row and column prefix sums then give each windowed SAD in O(1), whatever the window size.
+
+#define TILE 16 // FlowTuning::FlowTileSize as well
+#define MAX_WINDOW 32
+#define MAX_APRON (TILE + MAX_WINDOW - 1)
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+#define CANDIDATE_TILE 16 // PhaseCorrelation::TileSize
+#define RADIUS_TILE 16 // FlowTuning::FlowTileSize
+#define MIN_RADIUS 2 // Pyramid::MinSearchRadius
+
+groupshared float gs_Row[MAX_APRON * (MAX_APRON + 1)]; // Abs diff, then exclusive prefix sums per row
+groupshared float gs_Col[(MAX_APRON + 1) * TILE]; // Row box sums, then exclusive prefix sums per column
+
+// Windowed SAD of candidate 'v' for this thread's pixel. Called by the whole group (contains barriers).
+float WindowSAD(int2 apronOrigin, int apron, int2 v, uint groupIndex, uint2 tid)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    int stride = apron + 1;
+
+    // 1. Abs diff over the tile plus apron
+    for (int i = (int)groupIndex; i < apron * apron; i += TILE * TILE)
+    {
+        int2 a = int2(i % apron, i / apron);
+        int2 p = apronOrigin + a;
+        gs_Row[a.y * stride + a.x + 1] = abs(TexCurrent[clamp(p, int2(0, 0), maxPos)] - TexPrev[clamp(p + v, int2(0, 0), maxPos)]);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 2. Prefix sums along the rows (one row per thread)
+    if ((int)groupIndex < apron)
+    {
+        int row = groupIndex * stride;
+        float sum = 0.0f;
+        gs_Row[row] = 0.0f;
+        for (int x = 1; x <= apron; ++x)
+        {
+            sum += gs_Row[row + x];
+            gs_Row[row + x] = sum;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 3. Horizontal window sums for the tile's columns
+    for (int j = (int)groupIndex; j < apron * TILE; j += TILE * TILE)
+    {
+        int y = j / TILE;
+        int x = j % TILE;
+        gs_Col[(y + 1) * TILE + x] = gs_Row[y * stride + x + BlockSize] - gs_Row[y * stride + x];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 4. Prefix sums down the columns (one column per thread)
+    if (groupIndex < TILE)
+    {
+        float sum = 0.0f;
+        gs_Col[groupIndex] = 0.0f;
+        for (int y = 1; y <= apron; ++y)
+        {
+            sum += gs_Col[y * TILE + groupIndex];
+            gs_Col[y * TILE + groupIndex] = sum;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Safe without a trailing barrier: the next call only rewrites gs_Col after two more barriers
+    return gs_Col[(tid.y + BlockSize) * TILE + tid.x] - gs_Col[tid.y * TILE + tid.x];
+}
+
+// [Adaptive Radius] SearchRadius narrowed to last frame's motion around the tile covering 'pos' (CS_MotionStats)
+int TileSearchRadius(int2 pos)
+{
+    if (!UseTileRadius) return SearchRadius;
+    uint tw, th;
+    InputTileRadius.GetDimensions(tw, th);
+    uint2 tile = min(uint2(float2(pos) / (RADIUS_TILE * TileRadiusScale)), uint2(tw, th) - 1);
+    return min(max((int)ceil(InputTileRadius[tile] * TileRadiusScale), MIN_RADIUS), SearchRadius);
+}
+
+// Half-pel check on a 3x3 window (the bilinear taps differ per pixel, nothing to share)
+float SubPixelSAD(int2 pos, float2 v, float2 texSize)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 p = clamp(pos + int2(x, y), int2(0, 0), maxPos);
+            float2 uv = (float2(p) + 0.5f + v) / texSize;
+            sad += abs(TexCurrent[p] - TexPrev.SampleLevel(LinearSampler, uv, 0));
+        }
+    }
+    return sad;
+}
+
+// Called by the whole group for the tile at 'tileOrigin' (contains barriers)
+void MatchTile(int2 tileOrigin, uint2 groupThreadId, uint groupIndex)
+{
+    int2 pos = tileOrigin + int2(groupThreadId);
+    bool inside = pos.x < Width && pos.y < Height; // Outside threads still take part in the barriers
+
+    int apron = TILE + BlockSize - 1;
+    int2 apronOrigin = tileOrigin - BlockSize / 2;
+    float norm = 1.0f / (float)(BlockSize * BlockSize);
+
+    // Search center shared by the tile: the initial guess at the tile center
+    int2 tileCenter = min(tileOrigin + TILE / 2, int2(Width - 1, Height - 1));
+    int2 searchCenter = int2(0, 0);
+    if (UseInitMotion)
+    {
+        float2 initVec = InputInitMotion[tileCenter];
+        searchCenter = int2(round(initVec.x), round(initVec.y));
+    }
+
+    // Guess first so it wins ties. No early exit: every candidate loop below contains group barriers,
+    // so all threads of the tile run the same candidates.
+    float sad = WindowSAD(apronOrigin, apron, searchCenter, groupIndex, groupThreadId);
+    float bestCost = sad * norm + VECTOR_BIAS * length(float2(searchCenter));
+    float bestSAD = sad;
+    int2 bestVector = searchCenter;
+
+    // [Temporal Warm-Start] The tile's projected vector competes as a candidate
+    if (UsePredictedMotion)
+    {
+        float2 predVec = InputPredictedMotion[tileCenter];
+        int2 candidate = int2(round(predVec.x), round(predVec.y));
+        sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+        float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSAD = sad;
+            bestVector = candidate;
+        }
+    }
+
+    // [Phase Correlation] The correlation peaks of the tile's center, scaled to this level
+    if (UseTileCandidates)
+    {
+        uint cw, ch;
+        InputTileCandidates.GetDimensions(cw, ch);
+        uint2 tile = min(uint2(float2(tileCenter) / (CANDIDATE_TILE * CandidateScale)), uint2(cw, ch) - 1);
+        float4 tileVec = InputTileCandidates[tile] * CandidateScale;
+        float2 peaks[2] = { tileVec.xy, tileVec.zw };
+        for (int i = 0; i < 2; ++i)
+        {
+            int2 candidate = int2(round(peaks[i].x), round(peaks[i].y));
+            sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+            float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    // One window for the whole tile, the loops stay group uniform
+    int radius = TileSearchRadius(tileCenter);
+
+    [loop]
+    for (int y = -radius; y <= radius; ++y)
+    {
+        [loop]
+        for (int x = -radius; x <= radius; ++x)
+        {
+            if (x == 0 && y == 0) continue; // The guess, evaluated above
+
+            int2 candidate = searchCenter + int2(x, y);
+            sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+            float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    if (!inside) return;
+
+    float2 finalVector = float2(bestVector);
+
+    // [Scene Change Detection] Average per-pixel diff over the window, same tolerance as CS_BlockMatching
+    if (bestSAD * norm > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], 1);
+    }
+
+    // Sub-Pixel Refinement (Bilinear Check)
+    if (EnableSubPixel > 0)
+    {
+        float2 texSize = float2(Width, Height);
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+
+        float2 bestSub = finalVector;
+        float minSubSAD = SubPixelSAD(pos, finalVector, texSize);
+        for (int i = 0; i < 4; ++i)
+        {
+            float subSAD = SubPixelSAD(pos, finalVector + offsets[i], texSize);
+            if (subSAD < minSubSAD)
+            {
+                minSubSAD = subSAD;
+                bestSub = finalVector + offsets[i];
+            }
+        }
+        finalVector = bestSub;
+    }
+
+    OutputMotion[pos] = finalVector;
+}
+
+[numthreads(TILE, TILE, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    MatchTile(int2(groupId.xy) * TILE, groupThreadId.xy, groupIndex);
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(TILE, TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint tile = TileList[groupId.x];
+    MatchTile(int2(tile & 0xFFFF, tile >> 16) * TILE, groupThreadId.xy, groupIndex);
+}
+)";
+
+    inline const char* CS_DIS_Flow = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float4> GradsPrev : register(t2); // Gradient of Prev Frame (from Expansion shader)
+Texture2D<float2> MotionInput : register(t3);
+Texture2D<float> TexUnchanged : register(t4); // [Tile Hash] 16x16 tiles, 1 = identical to last frame (unbound = 0)
+StructuredBuffer<uint> TileList : register(t5); // [Hybrid Flow] Tiles CS_FlowSelect gave to DIS (CSTiles only)
+RWTexture2D<float2> MotionOutput : register(u0);
+
+SamplerState LinearSampler : register(s0);
+
+// DIS (Dense Inverse Search) Approximation
+// "Inverse Compositional" logic:
+// We align the Current patch to the Previous patch using gradients of Prev.
+// This allows pre-computation of gradients.
+
+#define FLOW_TILE 16 // FlowTuning::FlowTileSize
+
+void RefinePixel(int2 pos)
+{
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    if (TexUnchanged[pos / 16] > 0.5f)
+    {
+        MotionOutput[pos] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // 1. Initial Guess
+    float2 d = MotionInput[pos];
+    
+    // 2. Iterative Refinement (Gradient Descent)
+    // 8x8 Patch
+    const int RADIUS = 4;
+    
+    // Iterations (Fast convergence for small tweaks)
+    [unroll]
+    for(int iter = 0; iter < 4; ++iter)
+    {
+        float sum_IdIxx = 0; // Sum (ImagesDiff * I_x)
+        float sum_IdIyy = 0; // Sum (ImagesDiff * I_y)
+        float sum_Ixx2 = 0;  // Sum (I_x^2)
+        float sum_Iyy2 = 0;  // Sum (I_y^2)
+        
+        for(int y = -RADIUS; y < RADIUS; ++y) {
+            for(int x = -RADIUS; x < RADIUS; ++x) {
+                int2 p = pos + int2(x,y);
+                if(p.x < 0 || p.y < 0 || p.x >= (int)w || p.y >= (int)h) continue;
+                
+                // I_cur(x)
+                float I_curr = TexCurrent[p];
+                
+                // I_prev(x + d)
+                float2 uv = (float2(p) + d + 0.5f) / float2(w, h);
+                float I_prev = TexPrev.SampleLevel(LinearSampler, uv, 0);
+                
+                // Gradients of Prev(x + d)
+                // Note: Standard IC uses Grads of Template (Cur) but for tracking usually we align Cur to Prev
+                // Let's use Gradients of Previous interpolated.
+                float4 g = GradsPrev.SampleLevel(LinearSampler, uv, 0);
+                // The expansion's Sobel spans 4 pixels: twice the per-pixel derivative
+                float Ix = 0.5f * g.x; // Gradient X
+                float Iy = 0.5f * g.y; // Gradient Y
+                
+                float diff = I_curr - I_prev; // Error
+                
+                sum_IdIxx += diff * Ix;
+                sum_IdIyy += diff * Iy;
+                sum_Ixx2 += Ix * Ix;
+                sum_Iyy2 += Iy * Iy;
+            }
+        }
+        
+        // Solve JT J d = JT e
+        // Making diagonal assumption for speed
+        float eps = 0.001;
+        float2 delta;
+        delta.x = sum_IdIxx / (sum_Ixx2 + eps);
+        delta.y = sum_IdIyy / (sum_Iyy2 + eps);
+        
+        // Update
+        d += delta;
+        
+        // Early transform break?
+        if (dot(delta, delta) < 0.001) break;
+    }
+    
+    MotionOutput[pos] = d;
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    RefinePixel(int2(dispatchThreadId.xy));
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(FLOW_TILE, FLOW_TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    RefinePixel(int2(tile & 0xFFFF, tile >> 16) * FLOW_TILE + int2(groupThreadId.xy));
+}
+)";
+
+    inline const char* CS_DebugView = R"(
+Texture2D<float2> TexMotion : register(t0);
+Texture2D<float> TexMask : register(t1);
+RWTexture2D<float4> Output : register(u0);
+
+cbuffer Settings : register(b0)
+{
+    int Mode; // 1 = Motion, 2 = Mask
+    float Scale; // For motion visualization
+    int MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    float FlowScale; // [Native Synthesis] Output pixels per flow pixel
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    
+    float4 color = float4(0, 0, 0, 1);
+    
+    if (Mode == 1) // Motion Vectors
+    {
+        float2 motion = TexMotion[int2(float2(pos) / (max(MotionBlockSize, 1) * FlowScale))] * FlowScale; // Block fields show as blocks
+        // map x/y directly to r/g. Scale up to see small movements.
+        // abs() to see negative motion as color too.
+        color.rgb = float3(abs(motion.x), abs(motion.y), 0) * Scale; 
+        // Add a small blue component to show static areas
+        if (length(motion) == 0) color.b = 0.2f;
+    }
+    else if (Mode == 2) // HUD Mask
+    {
+        float mask = TexMask[pos];
+        // Mask is 1.0 for HUD (Static), 0.0 for World (Dynamic)
+        // Let's make HUD Red and World Grayscale/Dark
+        color.rgb = lerp(float3(0.1, 0.1, 0.1), float3(1.0, 0.0, 0.0), mask);
+    }
+    
+    Output[pos] = color;
+}
+)";
+
+    inline const char* CS_EdgeDetect = R"(
+Texture2D<float> InputTexture : register(t0); // [Luma Pyramid] Level 0
+RWTexture2D<float4> OutputEdge : register(u0);
+
+[numthreads(32, 32, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    uint w, h;
+    InputTexture.GetDimensions(w, h);
+
+    if (pos.x >= w || pos.y >= h)
+        return;
+
+    // Sobel Kernels
+    // Gx: -1 0 1   Gy: -1 -2 -1
+    //     -2 0 2       0  0  0
+    //     -1 0 1       1  2  1
+
+    // Neighborhood luminance (Rec. 709, from the shared pyramid)
+    float l00 = InputTexture[pos + int2(-1, -1)];
+    float l10 = InputTexture[pos + int2( 0, -1)];
+    float l20 = InputTexture[pos + int2( 1, -1)];
+    float l01 = InputTexture[pos + int2(-1,  0)];
+    float l21 = InputTexture[pos + int2( 1,  0)];
+    float l02 = InputTexture[pos + int2(-1,  1)];
+    float l12 = InputTexture[pos + int2( 0,  1)];
+    float l22 = InputTexture[pos + int2( 1,  1)];
+
+    float Gx = -l00 + l20 - 2.0*l01 + 2.0*l21 - l02 + l22;
+    float Gy = -l00 - 2.0*l10 - l20 + l02 + 2.0*l12 + l22;
+
+    float magnitude = sqrt(Gx*Gx + Gy*Gy);
+    
+    // Store edge magnitude (Clamp to 0-1)
+    OutputEdge[pos] = float4(magnitude, magnitude, magnitude, 1.0);
+}
+)";
+
+    inline const char* CS_Extrapolate = R"(
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1); // Unused (kept so bindings match CS_Interpolate)
+Texture2D<float2> TexMotion : register(t2);
+Texture2D<float> TexMask : register(t3);
+StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
+StructuredBuffer<uint> TileList : register(t6); // [Tile Skip] CSTiles: TileClassifier's list, dynamic tiles first
+
+RWTexture2D<float4> OutputFrame : register(u0);
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer Settings : register(b0)
+{
+    float Factor; // Prediction distance past the current frame (0.0 - 1.0 of a real frame interval)
+    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
+    float GhostingStrength;
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int UseVisibility; // Unused (CS_Interpolate layout)
+    float VisibilityScale;
+    float2 FlowScale; // [Native Synthesis] Output pixels per flow pixel, TexMotion is at flow resolution
+}
+
+// Vector disagreement (pixels) above which the pixel is treated as a disocclusion
+#define HOLE_TOLERANCE 1.0f
+
+void Synthesize(uint2 pos)
+{
+    // [Scene Change Safety]
+    if (GlobalStats[0] > (uint)SceneChangeThreshold)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+
+    float mask = TexMask[pos];
+    if (mask > 0.5f)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    float2 texSize = float2(w, h);
+    float2 uv = (float2(pos) + 0.5f) / texSize;
+
+    // Block fields are sampled bilinearly, each vector sits at its block center
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 motionScale = texSize / (MotionBlockSize * FlowScale * float2(mw, mh)); // Frame UV -> Motion UV
+
+    // Motion points from frame N back to frame N-1, so content at 'pos' in frame N+Factor
+    // was at 'pos + motion * Factor' in frame N.
+    float2 motion = TexMotion.SampleLevel(LinearSampler, uv * motionScale, 0) * FlowScale;
+    float2 srcUV = uv + (motion / texSize) * Factor;
+
+    // [Hole Filling]
+    // If the vector at the source disagrees with ours, 'pos' is being uncovered (or covered).
+    // The revealed content belongs to the background, which is the slower of the two vectors.
+    float2 srcMotion = TexMotion.SampleLevel(LinearSampler, srcUV * motionScale, 0) * FlowScale;
+    if (length(srcMotion - motion) > HOLE_TOLERANCE)
+    {
+        if (dot(srcMotion, srcMotion) < dot(motion, motion)) motion = srcMotion;
+        srcUV = uv + (motion / texSize) * Factor;
+    }
+
+    float4 result;
+    if (any(srcUV < 0.0f) || any(srcUV > 1.0f))
+    {
+        // Nothing to pull from outside the frame, hold the real pixel
+        result = TexCurrent[pos];
+    }
+    else
+    {
+        result = TexCurrent.SampleLevel(LinearSampler, srcUV, 0);
+    }
+
+    // [Ghosting Reduction]
+    if (GhostingStrength > 0.0f)
+    {
+        // 5-tap neighborhood (Center + Plus)
+        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
+        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
+        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
+        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
+        float4 wv = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
+
+        float4 minColor = min(c, min(n, min(s, min(e, wv))));
+        float4 maxColor = max(c, max(n, max(s, max(e, wv))));
+
+        float4 clamped = clamp(result, minColor, maxColor);
+        result = lerp(result, clamped, GhostingStrength);
+    }
+
+    OutputFrame[pos] = result;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    Synthesize(dispatchThreadId.xy);
+}
+
+// [Tile Skip] Indirect, one 16x16 group per dynamic tile (packed y << 16 | x)
+[numthreads(16, 16, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    uint2 pos = uint2(tile & 0xFFFF, tile >> 16) * 16 + groupThreadId.xy;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    Synthesize(pos);
+}
+)";
+
+    inline const char* CS_Farneback_Expansion = R"(
+Texture2D<float> Input : register(t0); // [Luma Pyramid]
+RWTexture2D<float4> Output : register(u0);
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    uint w, h;
+    Input.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    // Use a 5x5 neighborhood to compute:
+    // b_x (Gradient X)
+    // b_y (Gradient Y)
+    // r_xx (Curvature X)
+    // r_yy (Curvature Y)
+    
+    // Explicit 5x5 load
+    float val[5][5];
+    [unroll]
+    for(int y = -2; y <= 2; ++y) {
+        [unroll]
+        for(int x = -2; x <= 2; ++x) {
+            val[y+2][x+2] = Input[pos + int2(x,y)];
+        }
+    }
+
+    // Gradient X (Smoothed Sobel-like)
+    // -1 0 1
+    // -2 0 2
+    // -1 0 1
+    float gx = 0;
+    gx += -1*val[1][0] + 1*val[1][4]; 
+    gx += -2*val[2][0] + 2*val[2][4];
+    gx += -1*val[3][0] + 1*val[3][4];
+    gx /= 8.0;
+
+    // Gradient Y 
+    float gy = 0;
+    gy += -1*val[0][1] + 1*val[4][1];
+    gy += -2*val[0][2] + 2*val[4][2];
+    gy += -1*val[0][3] + 1*val[4][3];
+    gy /= 8.0;
+
+    // Second Derivatives (Curvature)
+    // r_xx ~ (1 -2 1)
+    float rxx = (val[2][0] - 2.0*val[2][2] + val[2][4]) * 0.25; // Scale
+    
+    // r_yy ~ (1 -2 1)T
+    float ryy = (val[0][2] - 2.0*val[2][2] + val[4][2]) * 0.25;
+
+    // Output: GradientX, GradientY, CurvatureX, CurvatureY
+    Output[pos] = float4(gx, gy, rxx, ryy);
+}
+)";
+
+    inline const char* CS_Farneback_Flow = R"(
+Texture2D<float4> PolyCurr : register(t0); // Gx, Gy, Rxx, Ryy
+Texture2D<float4> PolyPrev : register(t1);
+Texture2D<float2> MotionInput : register(t2);
+Texture2D<float> TexUnchanged : register(t3); // [Tile Hash] 16x16 tiles, 1 = identical to last frame (unbound = 0)
+StructuredBuffer<uint> TileList : register(t4); // [Hybrid Flow] Tiles CS_FlowSelect gave to Farneback (CSTiles only)
+RWTexture2D<float2> MotionOutput : register(u0); // Stores computed flow
+
+SamplerState LinearSampler : register(s0);
+
+#define FLOW_TILE 16 // FlowTuning::FlowTileSize
+
+void RefinePixel(int2 pos)
+{
+    uint w, h;
+    PolyCurr.GetDimensions(w, h); // Assume same size
+    if (pos.x >= w || pos.y >= h) return;
+
+    if (TexUnchanged[pos / 16] > 0.5f)
+    {
+        MotionOutput[pos] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // 1. Initial Guess
+    float2 d0 = MotionInput[pos];
+    // Scale d0 if needed? Assuming pixel units here.
+    
+    // 2. Accumulate G and h over a window (e.g., 5x5 or 9x9)
+    // Minimizing sum(|2 R d + deltaB|^2), deltaB = b(prev at p + d0) - b(curr at p)
+    // Solution: d = - sum(R * deltaB) / sum(2 * R^2)
+    
+    float sum_Rxx_dBx = 0;
+    float sum_Rxx2 = 0;
+    float sum_Ryy_dBy = 0;
+    float sum_Ryy2 = 0;
+    
+    // 5x5 Window
+    for(int y = -2; y <= 2; ++y) {
+        for(int x = -2; x <= 2; ++x) {
+            int2 p = pos + int2(x, y);
+            if(p.x < 0 || p.y < 0 || p.x >= (int)w || p.y >= (int)h) continue;
+            
+            // Sample Curr
+            float4 c = PolyCurr[p];
+            
+            // Sample Prev at shifted location (texel centers)
+            float2 p_shifted = float2(p) + d0 + 0.5f;
+            float4 p_prev = PolyPrev.SampleLevel(LinearSampler, p_shifted / float2(w, h), 0);
+            
+            // Coeffs
+            float rxx = (c.z + p_prev.z) * 0.5;
+            float ryy = (c.w + p_prev.w) * 0.5;
+            float dbx = p_prev.x - c.x;
+            float dby = p_prev.y - c.y;
+            
+            // Assuming Diagonal A implies independent x/y optimization (Simplification)
+            // Weighting: Uniform for now.
+            sum_Rxx_dBx += rxx * dbx;
+            sum_Rxx2 += rxx * rxx;
+            
+            sum_Ryy_dBy += ryy * dby;
+            sum_Ryy2 += ryy * ryy;
+        }
+    }
+    
+    float2 delta = 0;
+    float eps = 0.0001; // Avoid divide by zero
+    delta.x = -sum_Rxx_dBx / (2.0 * sum_Rxx2 + eps);
+    delta.y = -sum_Ryy_dBy / (2.0 * sum_Ryy2 + eps);
+    
+    // Clamp Refinement (Stability)
+    delta = clamp(delta, -2.0, 2.0); // Don't jump too far in one refinement step
+    
+    MotionOutput[pos] = d0 + delta;
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    RefinePixel(int2(dispatchThreadId.xy));
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(FLOW_TILE, FLOW_TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    RefinePixel(int2(tile & 0xFFFF, tile >> 16) * FLOW_TILE + int2(groupThreadId.xy));
+}
+)";
+
+    inline const char* CS_FlowInvert = R"(
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t2);
+Texture2D<uint> InputSplat : register(t3); // CS_FlowSplat claims
+RWTexture2D<float2> OutputBackward : register(u0); // Previous -> Current
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int RefineRadius; // Re-search window around the filled guess
+    float CostTolerance; // Claim cost (avg 3x3 luma abs diff) above which the claim is re-searched
+};
+
+// [Flow Inversion] Pass 2: the backward vector of a claimed pixel is minus the forward vector of its claimant.
+// Empty pixels (covered in the current frame, or stretched apart) take the slowest claimed neighbour, the
+// background. Only those and poorly matched claims run a small search, everything else is two fetches.
+
+#define EMPTY 0xFFFFFFFFu
+#define OFFSET_BIAS 2048
+#define HOLE_RADIUS 16
+
+// Backward vector implied by the claim at 'pos' (false if unclaimed)
+bool ClaimedVector(int2 pos, out float2 v, out float cost)
+{
+    uint packed = InputSplat[pos];
+    v = float2(0, 0);
+    cost = 1.0f;
+    if (packed == EMPTY) return false;
+
+    int2 offset = int2((packed >> 12) & 0xFFF, packed & 0xFFF) - OFFSET_BIAS;
+    v = -FwdFlow[pos + offset];
+    cost = (float)(packed >> 24) / 255.0f;
+    return true;
+}
+
+// 3x3 SAD of the previous frame at 'pos' against the current frame displaced by 'v'
+float WindowSAD(int2 pos, float2 v, float2 texSize)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 p = clamp(pos + int2(x, y), int2(0, 0), maxPos);
+            float2 uv = (float2(p) + 0.5f + v) / texSize;
+            sad += abs(TexPrev[p] - TexCurrent.SampleLevel(LinearSampler, uv, 0));
+        }
+    }
+    return sad;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= Width || pos.y >= Height) return;
+
+    float2 guess;
+    float cost;
+    bool claimed = ClaimedVector(pos, guess, cost);
+    if (claimed && cost <= CostTolerance)
+    {
+        OutputBackward[pos] = guess;
+        return;
+    }
+
+    // [Hole Filling] Unclaimed: nearest claim along 8 directions (stepping 1, 2, 4 ...), slowest one wins.
+    // A poor claim keeps its own vector as the guess.
+    if (!claimed)
+    {
+        const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+        float bestLengthSq = 1e9f;
+        for (int d = 0; d < 8; ++d)
+        {
+            for (int r = 1; r <= HOLE_RADIUS; r *= 2)
+            {
+                int2 p = pos + dirs[d] * r;
+                if (any(p < 0) || p.x >= Width || p.y >= Height) break;
+
+                float2 v;
+                float c;
+                if (!ClaimedVector(p, v, c)) continue;
+                if (dot(v, v) < bestLengthSq)
+                {
+                    bestLengthSq = dot(v, v);
+                    guess = v;
+                }
+                break;
+            }
+        }
+    }
+
+    // [Re-Search] Small window around the guess, the guess wins ties
+    float2 texSize = float2(Width, Height);
+    float2 bestVector = guess;
+    float minSAD = WindowSAD(pos, guess, texSize);
+
+    [loop]
+    for (int dy = -RefineRadius; dy <= RefineRadius; ++dy)
+    {
+        [loop]
+        for (int dx = -RefineRadius; dx <= RefineRadius; ++dx)
+        {
+            if (dx == 0 && dy == 0) continue;
+
+            float2 candidate = guess + float2(dx, dy);
+            float sad = WindowSAD(pos, candidate, texSize);
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    OutputBackward[pos] = bestVector;
+}
+)";
+
+    inline const char* CS_FlowSelect = R"(
+Texture2D<float> TexCurrent : register(t0); // CSStats: [Luma Pyramid] level 0
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputMotion : register(t2); // CSStats: this frame's refined motion
+Texture2D<float> InputVariance : register(t3); // CSSelect: CS_AdaptiveVariance grid of the current frame
+Texture2D<float2> InputStats : register(t4); // CSSelect: last frame's CSStats
+RWTexture2D<float2> OutputStats : register(u0); // CSStats: (residual, motion spread) per tile
+RWTexture2D<uint> TileAlgorithm : register(u0); // CSSelect: FlowAlgorithm per tile, last frame's choice on entry
+RWStructuredBuffer<uint> TileLists : register(u1); // CSSelect: MaxTiles packed tiles (x | y << 16) per algorithm
+RWBuffer<uint> TileArgs : register(u2); // CSSelect: DispatchIndirect arguments (count, 1, 1) per algorithm
+
+cbuffer CB : register(b0)
+{
+    int TilesX;
+    int TilesY;
+    int MaxTiles;
+    int UseStats; // InputStats and TileAlgorithm hold last frame's tiles
+    float FlatVariance;
+    float LowResidual;
+    float HighResidual;
+    float MaxSpread;
+};
+
+// [Hybrid Flow] Per-tile choice between the full resolution refinements: Farneback (one 5x5 solve), BlockMatching
+// (a search, early exits on a good guess) and DIS (up to four 8x8 iterations). Flat tiles take Farneback, there is
+// nothing to search or iterate on. Otherwise last frame's outcome decides: a motion boundary (large spread) needs the
+// search, a small residual is fine with Farneback, a large one on smooth motion goes to DIS, anything in between
+// keeps DIS once it got there so the tile does not flip every frame. Port: CPUOpticalFlow::SelectTiles / MeasureTiles.
+
+#define TILE 16 // FlowTuning::FlowTileSize, the variance grid's block
+#define ALGO_BLOCK_MATCHING 0 // FlowAlgorithm values
+#define ALGO_FARNEBACK 1
+#define ALGO_DIS 2
+
+float PrevBilinear(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = TexPrev[clamp(p, int2(0, 0), maxPos)];
+    float b = TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float c = TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float d = TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// One thread per tile: mean warp residual of the refined motion and the spread of its vectors, every other pixel
+[numthreads(8, 8, 1)]
+void CSStats(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+
+    float residual = 0.0f;
+    float2 sum = float2(0.0f, 0.0f);
+    float sumSq = 0.0f;
+    for (int y = 0; y < TILE; y += 2)
+    {
+        for (int x = 0; x < TILE; x += 2)
+        {
+            int2 p = min(int2(id.xy) * TILE + int2(x, y), maxPos);
+            float2 v = InputMotion[p];
+            residual += abs(TexCurrent[p] - PrevBilinear(float2(p) + v, maxPos));
+            sum += v;
+            sumSq += dot(v, v);
+        }
+    }
+
+    const float count = (TILE / 2) * (TILE / 2);
+    float2 mean = sum / count;
+    float spread = sqrt(max(sumSq / count - dot(mean, mean), 0.0f));
+    OutputStats[id.xy] = float2(residual / count, spread);
+}
+
+// One thread per tile: pick the algorithm and append the tile to its list
+[numthreads(8, 8, 1)]
+void CSSelect(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    uint algo = ALGO_BLOCK_MATCHING; // Nothing known yet: the plain search
+    if (InputVariance[id.xy] < FlatVariance)
+    {
+        algo = ALGO_FARNEBACK;
+    }
+    else if (UseStats)
+    {
+        float2 stats = InputStats[id.xy];
+        uint last = TileAlgorithm[id.xy];
+        if (stats.y > MaxSpread) algo = ALGO_BLOCK_MATCHING;
+        else if (stats.x > HighResidual) algo = ALGO_DIS;
+        else if (stats.x < LowResidual) algo = ALGO_FARNEBACK;
+        else algo = last == ALGO_DIS ? ALGO_DIS : ALGO_FARNEBACK;
+    }
+    TileAlgorithm[id.xy] = algo;
+
+    uint index;
+    InterlockedAdd(TileArgs[algo * 3], 1, index);
+    TileLists[algo * MaxTiles + index] = id.x | (id.y << 16);
+}
+)";
+
+    inline const char* CS_FlowSplat = R"(
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t2);
+RWTexture2D<uint> OutputSplat : register(u0); // Cleared to 0xFFFFFFFF (empty)
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int RefineRadius;
+    float CostTolerance;
+};
+
+// [Flow Inversion] Pass 1: every pixel of the current frame claims the previous-frame pixel its vector lands on.
+// Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12) and resolved with InterlockedMin, so when several
+// pixels land on the same target (occlusion) the best photometric match wins. The offset points back to the
+// claiming pixel, CS_FlowInvert reads its exact (sub-pixel) vector from there.
+
+#define OFFSET_BIAS 2048 // 12-bit signed offsets, +-2047 pixels
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= Width || pos.y >= Height) return;
+
+    float2 v = FwdFlow[pos];
+    int2 target = int2(round(float2(pos) + v));
+    if (any(target < 0) || target.x >= Width || target.y >= Height) return; // Leaves the frame
+    if (any(abs(pos - target) >= OFFSET_BIAS)) return; // Not representable
+
+    // 3x3 window: a single pixel matches too easily for the claim to vouch for the vector
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            sad += abs(TexCurrent[clamp(pos + int2(x, y), int2(0, 0), maxPos)] - TexPrev[clamp(target + int2(x, y), int2(0, 0), maxPos)]);
+        }
+    }
+    uint cost = (uint)(saturate(sad / 9.0f) * 255.0f + 0.5f);
+
+    int2 offset = pos - target + OFFSET_BIAS;
+    uint packed = (cost << 24) | ((uint)offset.x << 12) | (uint)offset.y;
+    InterlockedMin(OutputSplat[target], packed);
+}
+)";
+
+    inline const char* CS_FrameHash = R"(
+Texture2D<float4> TexFrame : register(t0); // Captured frame, capture resolution
+StructuredBuffer<uint> PrevHashes : register(t1); // Last frame's tile hashes
+Texture2D<float> FrameUnchanged : register(t2); // CSMapTiles: TileUnchanged of this frame
+
+RWStructuredBuffer<uint> Hashes : register(u0); // One per 16x16 tile, row major
+RWTexture2D<float> TileUnchanged : register(u1); // R8_UNORM tile grid, 1 = same hash as last frame
+RWStructuredBuffer<uint> HashStats : register(u2); // Cleared to 0 every frame, layout below
+RWTexture2D<float> FlowUnchanged : register(u3); // CSMapTiles: R8_UNORM grid of 16x16 flow resolution tiles
+
+cbuffer CB : register(b0)
+{
+    int HasHistory; // PrevHashes belongs to a frame of the same size
+    int Padding;
+    float2 FrameScale; // CSMapTiles: capture pixels per flow pixel
+};
+
+// [Tile Hash] xxHash32 rounds over the raw texel bits. Every texel is seeded with its position in the tile,
+// so the lanes can be summed in any order and a moved texel still changes the hash.
+// Matching tiles are unchanged: the searches write zero motion there, a frame without a changed tile is a duplicate.
+// The frame is hashed at capture resolution: a downscaled one (Nearest in particular) can hide a change between
+// the texels it samples. CSMapTiles carries the verdict over to the tiles of a scaled flow.
+
+#define TILE_SIZE 16
+
+#define CHANGED_TILES 0 // Tiles whose hash differs from last frame
+#define HAS_HISTORY 1 // 0 = nothing to compare against. Read by CS_SceneCut: history and no changed tile = duplicate
+
+#define FILTER_REACH 4 // Capture pixels CS_Upscale reads around a sample (Lanczos Radius up to 4)
+
+#define PRIME32_1 2654435761u
+#define PRIME32_2 2246822519u
+#define PRIME32_3 3266489917u
+#define PRIME32_4 668265263u
+#define PRIME32_5 374761393u
+
+groupshared uint gs_Hash;
+
+uint RotateLeft(uint x, uint r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+uint Round(uint acc, uint input)
+{
+    return RotateLeft(acc + input * PRIME32_2, 13) * PRIME32_1;
+}
+
+uint Avalanche(uint h)
+{
+    h ^= h >> 15;
+    h *= PRIME32_2;
+    h ^= h >> 13;
+    h *= PRIME32_3;
+    h ^= h >> 16;
+    return h;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSHash(uint3 groupId : SV_GroupID, uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0) gs_Hash = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    // No early return: every thread has to reach the barriers
+    uint w, h;
+    TexFrame.GetDimensions(w, h);
+    if (dispatchThreadId.x < w && dispatchThreadId.y < h)
+    {
+        uint4 bits = asuint(TexFrame[dispatchThreadId.xy]);
+        uint lane = PRIME32_5 + groupIndex * PRIME32_4;
+        lane = Round(lane, bits.r);
+        lane = Round(lane, bits.g);
+        lane = Round(lane, bits.b);
+        lane = Round(lane, bits.a);
+        InterlockedAdd(gs_Hash, Avalanche(lane));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint tilesX = (w + TILE_SIZE - 1) / TILE_SIZE;
+        uint tile = groupId.y * tilesX + groupId.x;
+        uint hash = Avalanche(gs_Hash);
+
+        bool unchanged = HasHistory && PrevHashes[tile] == hash;
+        Hashes[tile] = hash;
+        TileUnchanged[groupId.xy] = unchanged ? 1.0f : 0.0f;
+        if (!unchanged) InterlockedAdd(HashStats[CHANGED_TILES], 1);
+
+        if (groupId.x == 0 && groupId.y == 0) HashStats[HAS_HISTORY] = HasHistory ? 1 : 0;
+    }
+}
+
+// One thread per flow tile: unchanged only if every capture tile its texels sample from is
+[numthreads(8, 8, 1)]
+void CSMapTiles(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint fw, fh;
+    FlowUnchanged.GetDimensions(fw, fh);
+    if (dispatchThreadId.x >= fw || dispatchThreadId.y >= fh) return;
+
+    uint tw, th;
+    FrameUnchanged.GetDimensions(tw, th);
+    float2 lo = float2(dispatchThreadId.xy * TILE_SIZE) * FrameScale - FILTER_REACH;
+    float2 hi = float2((dispatchThreadId.xy + 1) * TILE_SIZE) * FrameScale + FILTER_REACH;
+    int2 first = max(int2(floor(lo / TILE_SIZE)), 0);
+    int2 last = min(int2(floor(hi / TILE_SIZE)), int2(tw, th) - 1);
+
+    float unchanged = 1.0f;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+            unchanged = min(unchanged, FrameUnchanged[int2(x, y)]);
+    }
+    FlowUnchanged[dispatchThreadId.xy] = unchanged;
+}
+)";
+
+    inline const char* CS_GlobalMotion = R"(
+Texture2D<float2> InputMotion : register(t0); // CSGather: final motion (flow resolution)
+Texture2D<float> LumaCurrent : register(t1); // CSThumbnail: [Luma Pyramid] coarsest level
+Texture2D<float> LumaPrev : register(t2);
+RWStructuredBuffer<float> Readback : register(u0); // CSGather / CSThumbnail, layout below
+RWTexture2D<float2> OutputMotion : register(u0); // CSSeed: initial guess at a pyramid level
+
+cbuffer CB : register(b0)
+{
+    float4 Row0; // CSSeed: current -> previous position in flow pixels (homography rows)
+    float4 Row1;
+    float4 Row2;
+    float LevelScale; // CSSeed: flow pixels per output pixel
+    int SampleGrid; // Must match GlobalMotion::SampleGrid
+    int ThumbnailSize; // Must match GlobalMotion::ThumbnailSize
+    float Padding;
+};
+
+// [Global Motion] One readback per frame, fixed size whatever the resolution:
+// [0, 4 * SampleGrid^2)  (x, y, u, v) per sample, GlobalMotion::Sample
+// then ThumbnailSize^2   current luma thumbnail (phase correlation fallback)
+// then ThumbnailSize^2   previous luma thumbnail
+
+// A SampleGrid x SampleGrid grid of vectors over the whole field, fitted on the CPU one frame later
+[numthreads(8, 8, 1)]
+void CSGather(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 cell = dispatchThreadId.xy;
+    if (cell.x >= (uint)SampleGrid || cell.y >= (uint)SampleGrid) return;
+
+    uint w, h;
+    InputMotion.GetDimensions(w, h);
+    uint2 pos = min(uint2((float2(cell) + 0.5f) * float2(w, h) / SampleGrid), uint2(w, h) - 1);
+    float2 motion = InputMotion[pos];
+
+    uint index = (cell.y * SampleGrid + cell.x) * 4;
+    Readback[index + 0] = pos.x;
+    Readback[index + 1] = pos.y;
+    Readback[index + 2] = motion.x;
+    Readback[index + 3] = motion.y;
+}
+
+// Box average of each thumbnail texel's footprint, both frames
+[numthreads(8, 8, 1)]
+void CSThumbnail(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 cell = dispatchThreadId.xy;
+    if (cell.x >= (uint)ThumbnailSize || cell.y >= (uint)ThumbnailSize) return;
+
+    uint w, h;
+    LumaCurrent.GetDimensions(w, h);
+    uint2 begin = cell * uint2(w, h) / ThumbnailSize;
+    uint2 end = max((cell + 1) * uint2(w, h) / ThumbnailSize, begin + 1);
+    end = min(end, uint2(w, h));
+
+    float current = 0.0f;
+    float prev = 0.0f;
+    for (uint y = begin.y; y < end.y; ++y)
+    {
+        for (uint x = begin.x; x < end.x; ++x)
+        {
+            current += LumaCurrent[uint2(x, y)];
+            prev += LumaPrev[uint2(x, y)];
+        }
+    }
+    float count = (float)((end.x - begin.x) * (end.y - begin.y));
+
+    uint offset = SampleGrid * SampleGrid * 4;
+    uint index = cell.y * ThumbnailSize + cell.x;
+    Readback[offset + index] = current / count;
+    Readback[offset + ThumbnailSize * ThumbnailSize + index] = prev / count;
+}
+
+// The fitted model as every pixel's initial guess, at the level of OutputMotion
+[numthreads(8, 8, 1)]
+void CSSeed(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputMotion.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    // Texel centers, level -> flow pixels and back
+    float3 p = float3((float2(pos) + 0.5f) * LevelScale - 0.5f, 1.0f);
+    float3 q = float3(dot(Row0.xyz, p), dot(Row1.xyz, p), dot(Row2.xyz, p));
+    float2 matched = q.xy / (abs(q.z) > 1e-6f ? q.z : 1e-6f);
+
+    OutputMotion[pos] = (matched - p.xy) / LevelScale;
+}
+)";
+
+    inline const char* CS_HUDMask = R"(
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1);
+Texture2D<float4> EdgeTexture : register(t2); // [Edge Detect] Flow resolution
+RWTexture2D<float> OutputMask : register(u0);
+
+cbuffer Settings : register(b0)
+{
+    float Threshold;
+    int UseEdgeDetect; // [Edge Detect]
+    float2 EdgeScale; // [Native Synthesis] Edge texels per mask pixel (flow / output resolution)
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    
+    // Boundary check handled by resource size usually, but good practice
+    float4 curr = TexCurrent[pos];
+    float4 prev = TexPrev[pos];
+    
+    // Calculate difference
+    float4 diff = abs(curr - prev);
+    float val = diff.r + diff.g + diff.b;
+    
+    // Base Static Check
+    float isStatic = (val < Threshold) ? 1.0f : 0.0f;
+    float isHUD = isStatic;
+
+    // [Edge Detection Logic]
+    // UI elements usually have sharp edges AND are static.
+    // If Edge Protection is enabled:
+    // We only consider it HUD if it is Static AND has high Edge Magnitude.
+    // This prevents flat textures (sky, walls) from being falsely flagged as HUD just because they are static.
+    if (UseEdgeDetect > 0)
+    {
+        float edgeMag = EdgeTexture[int2(float2(pos) * EdgeScale)].r; // Read magnitude from Sobel pass
+        
+        // If edge magnitude is low, it's likely a flat surface, not UI text/border.
+        // We require SIGNIFICANT edge presence to confirm it's a HUD element.
+        // This makes the mask more conservative (safer).
+        if (edgeMag < 0.1f) 
+        {
+            isHUD = 0.0f; 
+        }
+    }
+    
+    // Simple overwrite for now. 
+    // In advanced versions, we would use a decay buffer to keep the mask stable.
+    OutputMask[pos] = isHUD;
+}
+)";
+
+    inline const char* CS_Interpolate = R"(
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1);
+Texture2D<float2> TexMotion : register(t2);
+Texture2D<float> TexMask : register(t3);
+StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
+Texture2D<float2> TexVisibility : register(t5); // [Occlusion] x: current pixel seen in prev, y: prev pixel seen in current
+StructuredBuffer<uint> TileList : register(t6); // [Tile Skip] CSTiles: TileClassifier's list, dynamic tiles first
+
+RWTexture2D<float4> OutputFrame : register(u0);
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer Settings : register(b0)
+{
+    float Factor; // Interpolation factor (0.0 - 1.0)
+    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
+    float GhostingStrength;
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int UseVisibility;
+    float VisibilityScale; // One visibility texel per NxN pixels
+    float2 FlowScale; // [Native Synthesis] Output pixels per flow pixel, TexMotion / TexVisibility are at flow resolution
+}
+
+// Visibility above which both sources are trusted and the Ghosting clamp is skipped
+#define CONSISTENT_LEVEL 0.99f
+
+void Synthesize(uint2 pos)
+{
+    // [Scene Change Safety]
+    if (GlobalStats[0] > (uint)SceneChangeThreshold)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+    
+    float mask = TexMask[pos];
+    if (mask > 0.5f)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+    
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    float2 texSize = float2(w, h);
+
+    // Fetch Motion Vector (in pixels)
+    // Block fields are sampled bilinearly, each vector sits at its block center.
+    // [Native Synthesis] A low-res field is sampled the same way, its vectors scaled to output pixels.
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 motion = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * FlowScale * float2(mw, mh)), 0) * FlowScale;
+    
+    float2 uv = (float2(pos) + 0.5f) / texSize;
+    float2 motionUV = motion / texSize;
+    
+    // Interpolate
+    float2 uvPrev = uv + motionUV * Factor;
+    float2 uvCurr = uv - motionUV * (1.0f - Factor);
+    float4 pixelPrev = TexPrev.SampleLevel(LinearSampler, uvPrev, 0);
+    float4 pixelCurr = TexCurrent.SampleLevel(LinearSampler, uvCurr, 0);
+    
+    float4 result = lerp(pixelPrev, pixelCurr, Factor);
+
+    // [Occlusion]
+    // Content of the current frame with no match in the previous one (uncovered) makes the previous sample wrong,
+    // and previous content that is covered in the current frame makes the current sample wrong: drop that source.
+    float consistency = 0.0f; // Unknown without a visibility map, always clamp
+    if (UseVisibility)
+    {
+        uint vw, vh;
+        TexVisibility.GetDimensions(vw, vh);
+        float2 visibilityScale = texSize / (VisibilityScale * FlowScale * float2(vw, vh)); // Frame UV -> Visibility UV
+
+        float currVisible = TexVisibility.SampleLevel(LinearSampler, uvCurr * visibilityScale, 0).x;
+        float prevVisible = TexVisibility.SampleLevel(LinearSampler, uvPrev * visibilityScale, 0).y;
+
+        float weightPrev = (1.0f - Factor) * currVisible;
+        float weightCurr = Factor * prevVisible;
+        float weightSum = weightPrev + weightCurr;
+        if (weightSum > 1e-3f)
+        {
+            result = (pixelPrev * weightPrev + pixelCurr * weightCurr) / weightSum;
+        }
+
+        consistency = min(currVisible, prevVisible);
+    }
+
+    // [Ghosting Reduction]
+    // Clamp result to the neighborhood of the Current frame at the target location.
+    // Not needed where both flows agree.
+    if (GhostingStrength > 0.0f && consistency < CONSISTENT_LEVEL)
+    {
+        // 5-tap neighborhood (Center + Plus)
+        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
+        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
+        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
+        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
+        float4 w = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
+        
+        float4 minColor = min(c, min(n, min(s, min(e, w))));
+        float4 maxColor = max(c, max(n, max(s, max(e, w))));
+        
+        float4 clamped = clamp(result, minColor, maxColor);
+        result = lerp(result, clamped, GhostingStrength);
+    }
+
+    OutputFrame[pos] = result;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    Synthesize(dispatchThreadId.xy);
+}
+
+// [Tile Skip] Indirect, one 16x16 group per dynamic tile (packed y << 16 | x)
+[numthreads(16, 16, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    uint2 pos = uint2(tile & 0xFFFF, tile >> 16) * 16 + groupThreadId.xy;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    Synthesize(pos);
+}
+)";
+
+    inline const char* CS_LumaPyramid = R"(
+Texture2D<float4> InputColor : register(t0); // CSLuma: captured frame (flow resolution)
+Texture2D<float> InputLuma : register(t0); // CSDownsample: finer pyramid level
+RWTexture2D<float> Output : register(u0); // R8_UNORM, or R16_FLOAT for HDR swapchains
+
+// [Luma Pyramid] The one luminance definition every analysis pass works on (flow, variance, edges, splat cost).
+// Built once per real frame, the previous frame's pyramid is kept and reused as 'prev'.
+
+static const float3 LumaWeights = float3(0.2126f, 0.7152f, 0.0722f); // Rec. 709
+
+[numthreads(8, 8, 1)]
+void CSLuma(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    Output.GetDimensions(w, h);
+    if (dispatchThreadId.x >= w || dispatchThreadId.y >= h) return;
+
+    Output[dispatchThreadId.xy] = dot(InputColor[dispatchThreadId.xy].rgb, LumaWeights);
+}
+
+[numthreads(8, 8, 1)]
+void CSDownsample(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    Output.GetDimensions(w, h);
+    if (dispatchThreadId.x >= w || dispatchThreadId.y >= h) return;
+
+    // 2x2 box filter, clamped so odd sizes don't read past the edge
+    uint sw, sh;
+    InputLuma.GetDimensions(sw, sh);
+    uint2 maxPos = uint2(sw - 1, sh - 1);
+    uint2 srcPos = dispatchThreadId.xy * 2;
+
+    float l0 = InputLuma[min(srcPos + uint2(0, 0), maxPos)];
+    float l1 = InputLuma[min(srcPos + uint2(1, 0), maxPos)];
+    float l2 = InputLuma[min(srcPos + uint2(0, 1), maxPos)];
+    float l3 = InputLuma[min(srcPos + uint2(1, 1), maxPos)];
+
+    Output[dispatchThreadId.xy] = (l0 + l1 + l2 + l3) * 0.25f;
+}
+)";
+
+    inline const char* CS_MotionExpand = R"(
+Texture2D<float2> InputField : register(t0); // One vector per block
+RWTexture2D<float2> OutputMotion : register(u0); // One vector per pixel
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int BlockSize;
+    int3 Padding;
+};
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputMotion.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    uint bw, bh;
+    InputField.GetDimensions(bw, bh);
+
+    // Block vectors sit at block centers and are already in pixels (no scaling)
+    float2 blockCoord = (float2(pos) + 0.5f) / BlockSize;
+    float2 uv = blockCoord / float2(bw, bh);
+
+    OutputMotion[pos] = InputField.SampleLevel(LinearSampler, uv, 0);
+}
+)";
+
+    inline const char* CS_MotionProject = R"(
+Texture2D<float2> MotionHistory : register(t0); // Last frame's final motion (flow resolution)
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] Current frame at the output level
+Texture2D<float> TexPrev : register(t2); // Previous frame at the output level
+RWTexture2D<float2> OutputPredicted : register(u0);
+RWStructuredBuffer<uint> WarmStartStats : register(u1); // [0] = Pixels with a poor prediction (optional)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float ResidualTolerance; // Luma abs diff above which the prediction counts as poor
+    float3 Padding;
+};
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputPredicted.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    uint hw, hh;
+    MotionHistory.GetDimensions(hw, hh);
+    float2 histSize = float2(hw, hh);
+    float2 outSize = float2(w, h);
+
+    // Output may be a coarser pyramid level than the history, vectors shrink with it
+    float2 levelScale = outSize / histSize;
+    float2 uv = (float2(pos) + 0.5f) / outSize;
+
+    // Forward projection under constant velocity:
+    // Content at q in frame N was at q + v in frame N-1, where last frame's field stored the same v.
+    // One fixed-point step solves v = V(q + v) without a scatter pass.
+    float2 v0 = MotionHistory.SampleLevel(LinearSampler, uv, 0);
+    float2 v = MotionHistory.SampleLevel(LinearSampler, uv + v0 / histSize, 0);
+    float2 predicted = v * levelScale;
+
+    OutputPredicted[pos] = predicted;
+
+    // [Residual] How well does the prediction explain this frame?
+    float matched = TexPrev.SampleLevel(LinearSampler, uv + predicted / outSize, 0);
+    if (abs(TexCurrent[pos] - matched) > ResidualTolerance)
+    {
+        InterlockedAdd(WarmStartStats[0], 1);
+    }
+}
+)";
+
+    inline const char* CS_MotionResolve = R"(
+Texture2D<float2> TexMotion : register(t0); // Current -> Previous, per pixel or one vector per NxN block
+Texture2D<uint> InputSplat : register(t1); // CS_MotionSplat claims
+RWTexture2D<float2> OutputMotion : register(u0); // Per-pixel motion valid at time 'Factor'
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float Factor;
+    float MotionBlockSize;
+    int UseVisibility;
+    float VisibilityScale;
+};
+
+// [Forward Warp] Pass 2: a claimed pixel takes the vector of its claimant, which is the motion of the content
+// actually sitting there at time 'Factor'. Unclaimed pixels are being uncovered (or stretched apart) and take
+// the slowest claim around them, the background (same rule as CS_FlowInvert / CS_Extrapolate).
+
+#define EMPTY 0xFFFFFFFFu
+#define OFFSET_BIAS 2048
+#define HOLE_RADIUS 16
+
+float2 SourceMotion(int2 pos)
+{
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    return TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * float2(mw, mh)), 0);
+}
+
+bool ClaimedVector(int2 pos, out float2 v)
+{
+    uint packed = InputSplat[pos];
+    v = float2(0, 0);
+    if (packed == EMPTY) return false;
+
+    int2 offset = int2((packed >> 12) & 0xFFF, packed & 0xFFF) - OFFSET_BIAS;
+    v = SourceMotion(pos + offset);
+    return true;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    InputSplat.GetDimensions(w, h);
+    int2 size = int2(w, h);
+
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= size.x || pos.y >= size.y) return;
+
+    float2 v;
+    if (ClaimedVector(pos, v))
+    {
+        OutputMotion[pos] = v;
+        return;
+    }
+
+    // [Hole Filling] Nearest claim along 8 directions (stepping 1, 2, 4 ...), slowest one wins.
+    // Nothing claimed around: keep the backward-lookup vector.
+    const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+    float2 best = SourceMotion(pos);
+    float bestLengthSq = 1e9f;
+    for (int d = 0; d < 8; ++d)
+    {
+        for (int r = 1; r <= HOLE_RADIUS; r *= 2)
+        {
+            int2 p = pos + dirs[d] * r;
+            if (any(p < 0) || p.x >= size.x || p.y >= size.y) break;
+            if (!ClaimedVector(p, v)) continue;
+
+            if (dot(v, v) < bestLengthSq)
+            {
+                bestLengthSq = dot(v, v);
+                best = v;
+            }
+            break;
+        }
+    }
+
+    OutputMotion[pos] = best;
+}
+)";
+
+    inline const char* CS_MotionSmooth = R"(
+Texture2D<float2> InputMotion : register(t0);
+RWTexture2D<float2> OutputMotion : register(u0);
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    
+    // Simple 3x3 Box Blur for Motion Smoothing
+    // (5x5 might be too heavy for this stage, let's start with 3x3)
+    float2 sum = float2(0, 0);
+    float weight = 0.0f;
+    
+    // We strictly clamp to borders? Or just check bounds.
+    // HLSL Loads return 0 out of bounds usually (depending on state), but safe to check.
+    
+    uint w, h;
+    InputMotion.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 offsetPos = pos + int2(x, y);
+             if (offsetPos.x >= 0 && offsetPos.y >= 0 && offsetPos.x < w && offsetPos.y < h)
+             {
+                 sum += InputMotion[offsetPos];
+                 weight += 1.0f;
+             }
+        }
+    }
+    
+    OutputMotion[pos] = sum / weight;
+}
+)";
+
+    inline const char* CS_MotionSplat = R"(
+Texture2D<float2> TexMotion : register(t0); // Current -> Previous, per pixel or one vector per NxN block
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] Flow resolution
+Texture2D<float> TexPrev : register(t2);
+Texture2D<float2> TexVisibility : register(t3); // [Occlusion] Optional, x: current pixel seen in prev
+RWTexture2D<uint> OutputSplat : register(u0); // Cleared to 0xFFFFFFFF (empty)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float Factor; // 0 = prev, 1 = current
+    float MotionBlockSize;
+    int UseVisibility;
+    float VisibilityScale;
+};
+
+// [Forward Warp] Pass 1: every pixel of the current frame is projected to where its content sits at time 'Factor'.
+// The content at p in the current frame was at p + v in the previous one, so at time t it is at p + v * (1 - t).
+// Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12) and resolved with InterlockedMin (same layout as
+// CS_FlowSplat). Without depth the priority is how much the vector can be trusted: its 3x3 match cost, plus
+// the forward/backward disagreement when a visibility map is bound. Uncovered background has no true match,
+// so the occluder in front of it wins the collision.
+
+#define OFFSET_BIAS 2048 // 12-bit signed offsets, +-2047 pixels
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 size = int2(w, h);
+
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= size.x || pos.y >= size.y) return;
+
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 v = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * float2(mw, mh)), 0);
+
+    int2 target = int2(round(float2(pos) + v * (1.0f - Factor)));
+    if (any(target < 0) || target.x >= size.x || target.y >= size.y) return; // Leaves the frame
+    if (any(abs(pos - target) >= OFFSET_BIAS)) return; // Not representable
+
+    // 3x3 window, a single pixel matches too easily to rank vectors
+    int2 match = int2(round(float2(pos) + v));
+    int2 maxPos = size - 1;
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            sad += abs(TexCurrent[clamp(pos + int2(x, y), int2(0, 0), maxPos)] - TexPrev[clamp(match + int2(x, y), int2(0, 0), maxPos)]);
+        }
+    }
+    float cost = sad / 9.0f;
+
+    if (UseVisibility)
+    {
+        uint vw, vh;
+        TexVisibility.GetDimensions(vw, vh);
+        cost += 1.0f - TexVisibility.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (VisibilityScale * float2(vw, vh)), 0).x;
+    }
+
+    uint quantized = (uint)(saturate(cost) * 255.0f + 0.5f);
+    int2 offset = pos - target + OFFSET_BIAS;
+    uint packed = (quantized << 24) | ((uint)offset.x << 12) | (uint)offset.y;
+    InterlockedMin(OutputSplat[target], packed);
+}
+)";
+
+    inline const char* CS_MotionStats = R"(
+Texture2D<float2> InputMotion : register(t0); // Final motion at flow resolution
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] level 0
+Texture2D<float> TexPrev : register(t2);
+Texture2D<float> InputTileMax : register(t3); // CSTileRadius: CSTileStats' tile maxima
+RWStructuredBuffer<uint> Readback : register(u0); // CSTileStats: AdaptiveRadius readback layout, cleared per frame
+RWTexture2D<float> OutputTileMax : register(u1); // CSTileStats: longest vector per tile
+RWTexture2D<float> OutputTileRadius : register(u2); // CSTileRadius: next frame's bound per tile
+
+cbuffer CB : register(b0)
+{
+    int TilesX;
+    int TilesY;
+    float Margin;
+    float Padding;
+};
+
+// [Adaptive Radius] Motion statistics of the final field for AdaptiveRadius (read back one frame late) and the
+// per-tile bounds of next frame's coarsest search, which stay on the GPU. Port: CPUOpticalFlow::MeasureMotion.
+
+#define TILE 16 // FlowTuning::FlowTileSize
+#define HISTOGRAM_BINS 64 // AdaptiveRadius::HistogramBins
+#define READBACK_MAX 64 // AdaptiveRadius::ReadbackMax
+#define READBACK_RESIDUAL 65
+#define READBACK_TILES 66
+#define RESIDUAL_SCALE 4096.0f
+
+groupshared uint gs_Histogram[HISTOGRAM_BINS];
+groupshared float gs_Max[TILE * TILE];
+groupshared float gs_Residual[TILE * TILE];
+
+float PrevBilinear(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = TexPrev[clamp(p, int2(0, 0), maxPos)];
+    float b = TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float c = TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float d = TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// One group per tile: length histogram and residual of every pixel, the tile's maximum
+[numthreads(TILE, TILE, 1)]
+void CSTileStats(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < HISTOGRAM_BINS) gs_Histogram[groupIndex] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+    int2 pos = int2(groupId.xy) * TILE + int2(groupThreadId.xy);
+    bool inside = pos.x <= maxPos.x && pos.y <= maxPos.y;
+
+    float len = 0.0f;
+    float residual = 0.0f;
+    if (inside)
+    {
+        float2 v = InputMotion[pos];
+        len = length(v);
+        residual = abs(TexCurrent[pos] - PrevBilinear(float2(pos) + v, maxPos));
+        InterlockedAdd(gs_Histogram[min((uint)len, HISTOGRAM_BINS - 1)], 1);
+    }
+    gs_Max[groupIndex] = len;
+    gs_Residual[groupIndex] = residual;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = TILE * TILE / 2; s > 0; s >>= 1)
+    {
+        if (groupIndex < s)
+        {
+            gs_Max[groupIndex] = max(gs_Max[groupIndex], gs_Max[groupIndex + s]);
+            gs_Residual[groupIndex] += gs_Residual[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex < HISTOGRAM_BINS && gs_Histogram[groupIndex] > 0)
+        InterlockedAdd(Readback[groupIndex], gs_Histogram[groupIndex]);
+
+    if (groupIndex == 0)
+    {
+        int2 size = min(int2(TILE, TILE), maxPos + 1 - int2(groupId.xy) * TILE);
+        float meanResidual = gs_Residual[0] / (size.x * size.y);
+        OutputTileMax[groupId.xy] = gs_Max[0];
+        InterlockedMax(Readback[READBACK_MAX], asuint(gs_Max[0])); // Non-negative floats order as their bits
+        InterlockedAdd(Readback[READBACK_RESIDUAL], (uint)round(meanResidual * RESIDUAL_SCALE));
+        InterlockedAdd(Readback[READBACK_TILES], 1);
+    }
+}
+
+// One thread per tile: the longest vector around it (motion crosses into the neighbours by the next frame)
+[numthreads(8, 8, 1)]
+void CSTileRadius(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    float longest = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 t = clamp(int2(id.xy) + int2(x, y), int2(0, 0), int2(TilesX - 1, TilesY - 1));
+            longest = max(longest, InputTileMax[t]);
+        }
+    }
+    OutputTileRadius[id.xy] = ceil(longest * Margin) + Padding;
+}
+)";
+
+    inline const char* CS_PhaseCorrelation = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid] PhaseCorrelation::CandidateLevel
+Texture2D<float> TexPrev : register(t1);
+RWTexture2D<float4> OutputCandidates : register(u0); // Two vectors per tile (xy strongest, zw second), level pixels
+
+// [Phase Correlation] One group per TILE x TILE tile: the N x N window centered on it is correlated against the
+// previous frame in the frequency domain, and the two strongest separate peaks become the tile's candidate
+// vectors for the coarsest search. Costs the same for a 1 pixel or a 15 pixel shift.
+// Both frames share one complex FFT (current = real part, previous = imaginary part), split again by symmetry.
+// Port: PhaseCorrelation::Correlate (CPU), constants must match PhaseCorrelation.
+
+#define N 32 // TileWindow, power of two
+#define LOG_N 5
+#define TILE 16 // TileSize
+#define MIN_PEAK 0.1f // MinTilePeak
+#define PEAK_EXCLUSION 2
+#define PI 3.14159265f
+
+groupshared float gs_Re[N * N];
+groupshared float gs_Im[N * N];
+groupshared float gs_CrossRe[N * N];
+groupshared float gs_CrossIm[N * N];
+groupshared float gs_Sum[2 * N]; // Row sums (current, previous), then row peaks
+groupshared uint gs_PeakIndex[N];
+
+// In-place radix-2 FFT of the N values 'stride' apart from 'base', inverse (sign = +1) without the 1/N scale.
+// One thread per row / column, the group transforms all N at once.
+void FFT(uint base, uint stride, float sign)
+{
+    for (uint i = 0; i < N; ++i)
+    {
+        uint j = reversebits(i) >> (32 - LOG_N);
+        if (i < j)
+        {
+            uint a = base + i * stride;
+            uint b = base + j * stride;
+            float re = gs_Re[a]; gs_Re[a] = gs_Re[b]; gs_Re[b] = re;
+            float im = gs_Im[a]; gs_Im[a] = gs_Im[b]; gs_Im[b] = im;
+        }
+    }
+
+    [loop]
+    for (uint len = 2; len <= N; len <<= 1)
+    {
+        uint half = len >> 1;
+        float angle = sign * 2.0f * PI / len;
+        for (uint start = 0; start < N; start += len)
+        {
+            for (uint k = 0; k < half; ++k)
+            {
+                float s, c;
+                sincos(angle * k, s, c);
+                uint a = base + (start + k) * stride;
+                uint b = a + half * stride;
+                float tRe = gs_Re[b] * c - gs_Im[b] * s;
+                float tIm = gs_Re[b] * s + gs_Im[b] * c;
+                gs_Re[b] = gs_Re[a] - tRe;
+                gs_Im[b] = gs_Im[a] - tIm;
+                gs_Re[a] += tRe;
+                gs_Im[a] += tIm;
+            }
+        }
+    }
+}
+
+// Rows then columns, every thread its own row and column
+void FFT2D(uint t, float sign)
+{
+    FFT(t * N, 1, sign);
+    GroupMemoryBarrierWithGroupSync();
+    FFT(t, N, sign);
+    GroupMemoryBarrierWithGroupSync();
+}
+
+float Window(uint i)
+{
+    return 0.5f - 0.5f * cos(2.0f * PI * (i + 0.5f) / N);
+}
+
+float Surface(int x, int y)
+{
+    return gs_Re[(uint)(y & (N - 1)) * N + (uint)(x & (N - 1))];
+}
+
+// Same estimator as PhaseCorrelation PeakOffset
+float PeakOffset(float l, float c, float r)
+{
+    if (r >= l && r > 0.0f) return r / (r + c);
+    if (l > 0.0f) return -l / (l + c);
+    return 0.0f;
+}
+
+// Strongest value of row t outside the exclusion square around 'exclude' (x = N: none), into gs_Sum / gs_PeakIndex
+void RowPeak(uint t, uint2 exclude)
+{
+    float best = -1e30f;
+    uint bestX = 0;
+    for (uint x = 0; x < N; ++x)
+    {
+        int dx = abs((int)x - (int)exclude.x); dx = min(dx, N - dx);
+        int dy = abs((int)t - (int)exclude.y); dy = min(dy, N - dy);
+        if (exclude.x < N && dx <= PEAK_EXCLUSION && dy <= PEAK_EXCLUSION) continue;
+
+        float v = gs_Re[t * N + x];
+        if (v > best)
+        {
+            best = v;
+            bestX = x;
+        }
+    }
+    gs_Sum[t] = best;
+    gs_PeakIndex[t] = t * N + bestX;
+}
+
+// Row with the strongest row peak, every thread gets the same answer
+uint2 BestPeak()
+{
+    uint best = 0;
+    for (uint y = 1; y < N; ++y)
+    {
+        if (gs_Sum[y] > gs_Sum[best]) best = y;
+    }
+    uint index = gs_PeakIndex[best];
+    return uint2(index % N, index / N);
+}
+
+// Shift of the peak at 'p' (current(q) = previous(q + d) puts it at -d), zero if too weak to trust
+float2 PeakVector(uint2 p)
+{
+    int2 ip = int2(p);
+    float c = Surface(ip.x, ip.y);
+    if (c / (N * N) < MIN_PEAK) return float2(0.0f, 0.0f);
+
+    float fx = ip.x + PeakOffset(Surface(ip.x - 1, ip.y), c, Surface(ip.x + 1, ip.y));
+    float fy = ip.y + PeakOffset(Surface(ip.x, ip.y - 1), c, Surface(ip.x, ip.y + 1));
+    if (fx > N / 2) fx -= N;
+    if (fy > N / 2) fy -= N;
+    return float2(-fx, -fy);
+}
+
+[numthreads(N, 1, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint t = groupThreadId.x;
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+
+    // The window centered on the tile, moved inside the frame at the borders (clamped texels correlate with
+    // themselves at zero motion). Still clamped per texel on levels smaller than the window.
+    int2 origin = int2(groupId.xy) * TILE + TILE / 2 - N / 2;
+    origin = max(min(origin, int2(w, h) - N), int2(0, 0));
+
+    // 1. Row t of both windows, and the row sums for the means
+    float sumCurrent = 0.0f;
+    float sumPrev = 0.0f;
+    for (uint x = 0; x < N; ++x)
+    {
+        int2 p = clamp(origin + int2(x, t), int2(0, 0), maxPos);
+        float current = TexCurrent[p];
+        float prev = TexPrev[p];
+        gs_Re[t * N + x] = current;
+        gs_Im[t * N + x] = prev;
+        sumCurrent += current;
+        sumPrev += prev;
+    }
+    gs_Sum[t] = sumCurrent;
+    gs_Sum[N + t] = sumPrev;
+    GroupMemoryBarrierWithGroupSync();
+
+    // 2. Mean removed and Hann windowed, so the window borders do not correlate with themselves
+    float meanCurrent = 0.0f;
+    float meanPrev = 0.0f;
+    for (uint r = 0; r < N; ++r)
+    {
+        meanCurrent += gs_Sum[r];
+        meanPrev += gs_Sum[N + r];
+    }
+    meanCurrent /= N * N;
+    meanPrev /= N * N;
+
+    float wy = Window(t);
+    for (uint x = 0; x < N; ++x)
+    {
+        float wxy = Window(x) * wy;
+        gs_Re[t * N + x] = (gs_Re[t * N + x] - meanCurrent) * wxy;
+        gs_Im[t * N + x] = (gs_Im[t * N + x] - meanPrev) * wxy;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    FFT2D(t, -1.0f);
+
+    // 3. Split the two spectra (C(k) = (Z(k) + Z*(-k)) / 2, P(k) = (Z(k) - Z*(-k)) / 2i) and keep the phase of C P*
+    for (uint c = 0; c < N; ++c)
+    {
+        uint i = t * N + c;
+        uint j = ((N - t) & (N - 1)) * N + ((N - c) & (N - 1));
+        float cRe = gs_Re[i] + gs_Re[j];
+        float cIm = gs_Im[i] - gs_Im[j];
+        float pRe = gs_Im[i] + gs_Im[j];
+        float pIm = gs_Re[j] - gs_Re[i];
+
+        float re = cRe * pRe + cIm * pIm;
+        float im = cIm * pRe - cRe * pIm;
+        float magnitude = sqrt(re * re + im * im);
+        bool keep = i != 0 && magnitude > 1e-12f; // DC carries no shift
+        gs_CrossRe[i] = keep ? re / magnitude : 0.0f;
+        gs_CrossIm[i] = keep ? im / magnitude : 0.0f;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint c2 = 0; c2 < N; ++c2)
+    {
+        gs_Re[t * N + c2] = gs_CrossRe[t * N + c2];
+        gs_Im[t * N + c2] = gs_CrossIm[t * N + c2];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 4. Back to the correlation surface (real part)
+    FFT2D(t, 1.0f);
+
+    // 5. Strongest peak, then the strongest one clear of it
+    RowPeak(t, uint2(N, N));
+    GroupMemoryBarrierWithGroupSync();
+    uint2 first = BestPeak();
+    GroupMemoryBarrierWithGroupSync();
+
+    RowPeak(t, first);
+    GroupMemoryBarrierWithGroupSync();
+    if (t != 0) return;
+
+    uint2 second = BestPeak();
+    OutputCandidates[groupId.xy] = float4(PeakVector(first), PeakVector(second));
+}
+)";
+
+    inline const char* CS_QuadtreeSearch = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float> TexVariance : register(t2); // CS_AdaptiveVariance, one value per 16x16
+Texture2D<float2> InputParentField : register(t3); // Leaf field before this pass (parent + neighbour vectors)
+Texture2D<float2> InputHistory : register(t4); // Last frame's leaf field (temporal candidate)
+RWTexture2D<float2> OutputField : register(u0); // One vector per 4x4 cell
+RWTexture2D<uint> LeafSize : register(u1); // Size of the node owning each cell
+RWStructuredBuffer<uint> GlobalStats : register(u2); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int NodeSize; // 32, 16, 8 or 4 (one pass per level, coarse to fine)
+    int SearchRadius; // Around the parent's vector
+    int EnableSubPixel;
+    int UseHistory;
+    float VarianceThreshold; // Below: flat, nodes stop at 16x16
+    float ResidualThreshold; // Average SAD per pixel above which a node splits
+};
+
+// Quadtree motion estimation, one group per node of the current level.
+// A node searches around its parent's vector, then either stays a leaf or hands its four children to the next pass:
+// flat nodes (low variance) stop at 16x16, textured nodes split down to 4x4 while the match residual stays high.
+
+#define CELL 4
+#define MAX_NODE 32
+#define NUM_EXTRA 5 // History + 4 neighbours
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+
+groupshared float gs_Block[MAX_NODE * MAX_NODE];
+groupshared float gs_Cost[64];
+groupshared int gs_Index[64];
+groupshared float gs_SubCost[4];
+groupshared float3 gs_Result; // Vector, split
+
+// Average SAD per pixel, checkerboard from 16x16 (same as CS_BlockSearch)
+float NodeCost(int2 origin, int2 extent, float2 v, bool bilinear)
+{
+    float2 texSize = float2(Width, Height);
+    int decimation = (NodeSize >= 16) ? 2 : 1;
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (decimation == 2 && ((x + y) & 1)) continue;
+
+            float target = gs_Block[y * NodeSize + x];
+            float candidate;
+            if (bilinear)
+            {
+                float2 uv = (float2(origin + int2(x, y)) + 0.5f + v) / texSize;
+                candidate = TexPrev.SampleLevel(LinearSampler, uv, 0);
+            }
+            else
+            {
+                int2 p = clamp(origin + int2(x, y) + int2(v), int2(0, 0), int2(Width - 1, Height - 1));
+                candidate = TexPrev[p];
+            }
+            sad += abs(target - candidate);
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    uint fw, fh;
+    OutputField.GetDimensions(fw, fh);
+    int2 maxCell = int2(fw - 1, fh - 1);
+
+    int2 origin = int2(groupId.xy) * NodeSize;
+    int2 extent = min(int2(NodeSize, NodeSize), int2(Width, Height) - origin);
+    int2 cell = origin / CELL;
+    int cellsPerNode = NodeSize / CELL;
+
+    // The node exists if its parent split (or it is a root). Not an early return:
+    // the barriers below must be reached by every thread, inactive groups just skip the work.
+    bool active = LeafSize[cell] == (uint)NodeSize;
+
+    // [Cache] Current block
+    int cached = active ? NodeSize * NodeSize : 0;
+    for (int i = (int)groupIndex; i < cached; i += 64)
+    {
+        int2 p = origin + int2(i % NodeSize, i / NodeSize);
+        gs_Block[i] = TexCurrent[min(p, int2(Width - 1, Height - 1))];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Candidates] Window around the parent's vector, then history and the neighbouring nodes' vectors
+    float2 parentVec = InputParentField[cell];
+    int2 center = int2(round(parentVec.x), round(parentVec.y));
+
+    int2 extra[NUM_EXTRA];
+    float2 historyVec = UseHistory ? InputHistory[min(cell + cellsPerNode / 2, maxCell)] : parentVec;
+    extra[0] = int2(round(historyVec.x), round(historyVec.y));
+    int2 neighbours[4] = { int2(-1, 0), int2(1, 0), int2(0, -1), int2(0, 1) };
+    [unroll] for (int n = 0; n < 4; ++n)
+    {
+        float2 nv = InputParentField[clamp(cell + neighbours[n] * cellsPerNode, int2(0, 0), maxCell)];
+        extra[n + 1] = int2(round(nv.x), round(nv.y));
+    }
+
+    int side = 2 * SearchRadius + 1;
+    int gridCount = side * side;
+    int total = active ? gridCount + NUM_EXTRA : 0;
+
+    float bestCost = 999999.0f;
+    int bestIndex = 0;
+    for (int k = (int)groupIndex; k < total; k += 64)
+    {
+        int2 v = (k < gridCount) ? center + int2(k % side - SearchRadius, k / side - SearchRadius) : extra[k - gridCount];
+        float cost = NodeCost(origin, extent, float2(v), false) + VECTOR_BIAS * length(float2(v));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestIndex = k;
+        }
+    }
+
+    gs_Cost[groupIndex] = bestCost;
+    gs_Index[groupIndex] = bestIndex;
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction] Min cost
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s && gs_Cost[groupIndex + s] < gs_Cost[groupIndex])
+        {
+            gs_Cost[groupIndex] = gs_Cost[groupIndex + s];
+            gs_Index[groupIndex] = gs_Index[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    int best = gs_Index[0];
+    float minCost = gs_Cost[0];
+    int2 bestVec = (best < gridCount) ? center + int2(best % side - SearchRadius, best / side - SearchRadius) : extra[best - gridCount];
+    float2 finalVector = float2(bestVec);
+
+    // [Sub-Pixel Refinement] One half-pel offset per thread, kept only by leaves
+    float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+    if (EnableSubPixel > 0)
+    {
+        if (groupIndex < 4)
+        {
+            float2 v = finalVector + offsets[groupIndex];
+            gs_SubCost[groupIndex] = active ? NodeCost(origin, extent, v, true) + VECTOR_BIAS * length(v) : 999999.0f;
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    // [Split Decision] Variance sets how deep a node may go, the residual decides whether it does
+    if (groupIndex == 0)
+    {
+        float variance = 0.0f;
+        int2 varCell = origin / 16;
+        int varCells = max(NodeSize / 16, 1);
+        for (int vy = 0; vy < varCells; ++vy)
+            for (int vx = 0; vx < varCells; ++vx)
+                variance = max(variance, TexVariance[varCell + int2(vx, vy)]);
+
+        int minSize = (variance > VarianceThreshold) ? CELL : 16;
+        bool split = NodeSize > minSize && minCost > ResidualThreshold;
+
+        if (!split && EnableSubPixel > 0)
+        {
+            float2 bestSub = finalVector;
+            for (int j = 0; j < 4; ++j)
+            {
+                if (gs_SubCost[j] < minCost)
+                {
+                    minCost = gs_SubCost[j];
+                    bestSub = finalVector + offsets[j];
+                }
+            }
+            finalVector = bestSub;
+        }
+
+        gs_Result = float3(finalVector, split ? 1.0f : 0.0f);
+
+        // [Scene Change Detection] Leaves only, counted per pixel
+        if (active && !split && minCost > 0.15f)
+        {
+            InterlockedAdd(GlobalStats[0], (uint)(extent.x * extent.y));
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Write] One cell per thread (at most 8x8 cells per node)
+    if (active && (int)groupIndex < cellsPerNode * cellsPerNode)
+    {
+        int2 c = cell + int2((int)groupIndex % cellsPerNode, (int)groupIndex / cellsPerNode);
+        if (c.x <= maxCell.x && c.y <= maxCell.y)
+        {
+            bool split = gs_Result.z > 0.5f;
+            OutputField[c] = gs_Result.xy;
+            LeafSize[c] = split ? (uint)(NodeSize / 2) : (uint)NodeSize;
+        }
+    }
+}
+)";
+
+    inline const char* CS_RCAS = R"(
+Texture2D<float4> InputTexture : register(t0);
+RWTexture2D<float4> OutputTexture : register(u0);
+StructuredBuffer<uint> TileList : register(t1); // [Tile Skip] CSTiles: TileClassifier's list, dynamic tiles first
+
+cbuffer Constants : register(b0)
+{
+    float Sharpness; // 0.0 to 1.0
+    float3 Padding;
+}
+
+// AMD FidelityFX CAS-like Implementation
+// "Contrast Adaptive Sharpening"
+// Uses a negative lobe to validly sharpen the image while preserving coherence.
+void RCAS(uint2 pos, float sharpness, uint width, uint height)
+{
+    if (pos.x >= width || pos.y >= height) return;
+    
+    // 1. Fetch Center and Neighbors (Cross)
+    float4 c = InputTexture[pos];
+    float3 n = InputTexture[int2(pos.x, max(0, (int)pos.y - 1))].rgb;
+    float3 s = InputTexture[int2(pos.x, min((int)height - 1, (int)pos.y + 1))].rgb;
+    float3 w = InputTexture[int2(max(0, (int)pos.x - 1), pos.y)].rgb;
+    float3 e = InputTexture[int2(min((int)width - 1, (int)pos.x + 1), pos.y)].rgb;
+
+    // 2. Calculate Lobe Weight
+    // Sharpness 0.0 -> Lobe 0.0 (Identity)
+    // Sharpness 1.0 -> Lobe -0.2 (Strong Sharpening)
+    // The typical CAS limit involves a negative lobe.
+    float lobe = lerp(0.0f, -0.2f, sharpness);
+    
+    // 3. Apply CAS Convolution
+    // Formula: (Center + Lobe * SumNeighbors) / (1 + 4 * Lobe)
+    float3 neighborSum = n + s + w + e;
+    float3 numerator = c.rgb + lobe * neighborSum;
+    float denominator = 1.0f + 4.0f * lobe;
+    
+    // Avoid division by zero (though denominator won't be 0 with lobe > -0.25)
+    float3 result = numerator / denominator;
+    
+    // 4. Output (Saturate to keep valid color range)
+    OutputTexture[pos] = float4(saturate(result), c.a);
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    InputTexture.GetDimensions(w, h);
+    RCAS(dispatchThreadId.xy, Sharpness, w, h);
+}
+
+// [Tile Skip] Indirect, one 16x16 group per dynamic tile (packed y << 16 | x)
+[numthreads(16, 16, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    uint w, h;
+    InputTexture.GetDimensions(w, h);
+    RCAS(uint2(tile & 0xFFFF, tile >> 16) * 16 + groupThreadId.xy, Sharpness, w, h);
+}
+)";
+
+    // Manually fixing the RCAS string since I can't edit the literal in thought process mid-stream easily.
+    // I'll rewrite the RCAS part correctly in the tool call.
+
+    inline const char* CS_RecursiveSearch = R"(
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> SpatialField : register(t2); // Block vectors of the previous scan
+Texture2D<float2> TemporalField : register(t3); // Block vectors of the previous frame
+Texture2D<float> TexUnchanged : register(t4); // [Tile Hash] 16x16 tiles, 1 = identical to last frame
+RWTexture2D<float2> OutputField : register(u0); // One vector per block
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize;
+    int ScanDirection; // +1 = Top-left to bottom-right, -1 = Reversed
+    int FrameIndex; // Seeds the update vectors
+    int EnableSubPixel;
+    int2 Padding;
+};
+
+// 3-D Recursive Search (de Haan et al.)
+// Instead of a full window, each block tests a handful of candidates taken from already
+// estimated neighbors (spatial), last frame's field (temporal) and small random updates.
+// A sequential meandering scan is not possible on the GPU, so the scan is emulated with
+// alternating passes: each pass reads the neighbors from the previous pass in its direction.
+
+#define NUM_CANDIDATES 7
+
+// Penalties (avg luma SAD per pixel) bias toward smooth, consistent fields
+#define PENALTY_TEMPORAL 0.0033f
+#define PENALTY_UPDATE 0.01f
+#define PENALTY_ZERO 0.0017f
+
+static const float2 UpdateSet[12] =
+{
+    float2(0, 1), float2(0, -1), float2(1, 0), float2(-1, 0),
+    float2(0, 2), float2(0, -2), float2(3, 0), float2(-3, 0),
+    // Quarter-pel (EnableSubPixel only)
+    float2(0.25f, 0), float2(-0.25f, 0), float2(0, 0.25f), float2(0, -0.25f)
+};
+
+groupshared float gs_SAD[NUM_CANDIDATES][64];
+
+uint Hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+int2 ClampBlock(int2 b, int2 blocks)
+{
+    return clamp(b, int2(0, 0), blocks - 1);
+}
+
+// [Tile Hash] Every 16x16 hash tile the block touches is identical to last frame (mask unbound = 0)
+bool BlockUnchanged(int2 origin, int2 extent)
+{
+    int2 first = origin / 16;
+    int2 last = (origin + extent - 1) / 16;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            if (TexUnchanged[int2(x, y)] <= 0.5f) return false;
+        }
+    }
+    return true;
+}
+
+// One group per block, 8x8 threads stride over the block
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint bw, bh;
+    OutputField.GetDimensions(bw, bh);
+    int2 blocks = int2(bw, bh);
+    int2 block = int2(groupId.xy);
+    if (block.x >= blocks.x || block.y >= blocks.y) return; // Uniform across the group
+
+    if (BlockUnchanged(block * BlockSize, min(int2(BlockSize, BlockSize), int2(Width, Height) - block * BlockSize)))
+    {
+        if (groupIndex == 0) OutputField[block] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // [Candidates] (identical for every thread of the group)
+    int d = ScanDirection;
+    float2 sa = SpatialField[ClampBlock(block - int2(d, 0), blocks)]; // Same row, behind
+    float2 sb = SpatialField[ClampBlock(block + int2(d, -d), blocks)]; // Previous row, ahead
+
+    uint rnd = Hash((uint)(block.x + block.y * 4096) ^ Hash((uint)FrameIndex));
+    uint updateCount = EnableSubPixel ? 12 : 8;
+
+    float2 candidates[NUM_CANDIDATES];
+    float penalties[NUM_CANDIDATES];
+    candidates[0] = sa; penalties[0] = 0.0f;
+    candidates[1] = sb; penalties[1] = 0.0f;
+    candidates[2] = sa + UpdateSet[rnd % updateCount]; penalties[2] = PENALTY_UPDATE;
+    candidates[3] = sb + UpdateSet[(rnd >> 8) % updateCount]; penalties[3] = PENALTY_UPDATE;
+    candidates[4] = TemporalField[ClampBlock(block + int2(0, d), blocks)]; penalties[4] = PENALTY_TEMPORAL; // Not yet visited this scan
+    candidates[5] = TemporalField[block]; penalties[5] = PENALTY_TEMPORAL;
+    candidates[6] = float2(0, 0); penalties[6] = PENALTY_ZERO;
+
+    // [Block SAD] Partial sums per thread
+    float2 texSize = float2(Width, Height);
+    int2 origin = block * BlockSize;
+
+    float partial[NUM_CANDIDATES];
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) partial[c] = 0.0f;
+
+    for (int py = (int)threadId.y; py < BlockSize; py += 8)
+    {
+        for (int px = (int)threadId.x; px < BlockSize; px += 8)
+        {
+            int2 pos = origin + int2(px, py);
+            if (pos.x >= Width || pos.y >= Height) continue;
+
+            float target = TexCurrent[pos];
+            [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c)
+            {
+                float2 uv = (float2(pos) + 0.5f + candidates[c]) / texSize;
+                partial[c] += abs(target - TexPrev.SampleLevel(LinearSampler, uv, 0));
+            }
+        }
+    }
+
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) gs_SAD[c][groupIndex] = partial[c];
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction]
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s)
+        {
+            [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) gs_SAD[c][groupIndex] += gs_SAD[c][groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex != 0) return;
+
+    int2 extent = min(int2(BlockSize, BlockSize), int2(Width, Height) - origin);
+    float count = (float)max(1, extent.x * extent.y);
+
+    float bestCost = 999999.0f;
+    float bestSAD = 0.0f;
+    float2 bestVector = float2(0, 0);
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c)
+    {
+        float cost = gs_SAD[c][0] / count + penalties[c];
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSAD = gs_SAD[c][0];
+            bestVector = candidates[c];
+        }
+    }
+
+    OutputField[block] = bestVector;
+
+    // [Scene Change Detection] Same normalization as CS_BlockMatching, counted per pixel
+    if (bestSAD / count > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], (uint)count);
+    }
+}
+)";
+
+    inline const char* CS_SceneCut = R"(
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1);
+StructuredBuffer<uint> HashStats : register(t2); // CSResolve: CS_FrameHash stats (UseHashStats)
+RWStructuredBuffer<uint> SceneStats : register(u0); // Cleared to 0 every frame, layout below
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int ThumbWidth;
+    int ThumbHeight;
+    float HistogramThreshold; // Normalized L1 histogram distance (0 - 1) a cut must exceed
+    float SADThreshold; // Mean thumbnail luma difference (0 - 1) a cut must exceed
+    int UseHashStats; // CSResolve: a frame without a changed tile is a duplicate
+    int DetectCuts; // 0 = CSMain was not dispatched, only duplicates are detected
+    float2 Padding;
+};
+
+// [Scene Cut] Runs before any motion estimation, on a thumbnail sampled straight from both frames.
+// A cut needs both a different color distribution and a large plain difference: a fast pan changes
+// the SAD but not the histograms, a fade changes the histograms but barely the SAD between frames.
+// Whatever this misses is still caught by the GlobalStats counter of the block search.
+// [Tile Hash] A duplicate frame (every tile hash matches the last frame) gets the same verdict: nothing to
+// estimate or synthesize, the real frame is shown again.
+
+#define LUMA_BINS 32
+#define CHROMA_BINS 16
+
+#define LUMA_CURR 0
+#define LUMA_PREV (LUMA_CURR + LUMA_BINS)
+#define CB_CURR (LUMA_PREV + LUMA_BINS)
+#define CB_PREV (CB_CURR + CHROMA_BINS)
+#define CR_CURR (CB_PREV + CHROMA_BINS)
+#define CR_PREV (CR_CURR + CHROMA_BINS)
+#define HISTOGRAM_SIZE (CR_PREV + CHROMA_BINS)
+#define SAD_SUM HISTOGRAM_SIZE // Sum of |luma difference| * SAD_SCALE
+#define VERDICT (SAD_SUM + 1) // 1 = cut or duplicate (read by PS_SceneCut)
+
+#define SAD_SCALE 1024.0f
+
+groupshared uint gs_Histogram[HISTOGRAM_SIZE];
+
+// Rec.709 luma + chroma, remapped to 0 - 1
+float3 LumaChroma(float3 rgb)
+{
+    float y = dot(rgb, float3(0.2126f, 0.7152f, 0.0722f));
+    return float3(y, saturate((rgb.b - y) / 1.8556f + 0.5f), saturate((rgb.r - y) / 1.5748f + 0.5f));
+}
+
+// Box of 4 bilinear taps around the thumbnail cell center
+float3 Thumbnail(Texture2D<float4> tex, float2 uv, float2 cellSize)
+{
+    float3 sum = tex.SampleLevel(LinearSampler, uv + cellSize * float2(-0.25f, -0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(0.25f, -0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(-0.25f, 0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(0.25f, 0.25f), 0).rgb;
+    return sum * 0.25f;
+}
+
+uint Bin(float value, uint bins)
+{
+    return min((uint)(value * bins), bins - 1);
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < HISTOGRAM_SIZE) gs_Histogram[groupIndex] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    // No early return: every thread has to reach the barriers
+    bool valid = (int)dispatchThreadId.x < ThumbWidth && (int)dispatchThreadId.y < ThumbHeight;
+    if (valid)
+    {
+        float2 cellSize = 1.0f / float2(ThumbWidth, ThumbHeight);
+        float2 uv = (float2(dispatchThreadId.xy) + 0.5f) * cellSize;
+        float3 curr = LumaChroma(Thumbnail(TexCurrent, uv, cellSize));
+        float3 prev = LumaChroma(Thumbnail(TexPrev, uv, cellSize));
+
+        InterlockedAdd(gs_Histogram[LUMA_CURR + Bin(curr.x, LUMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[LUMA_PREV + Bin(prev.x, LUMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CB_CURR + Bin(curr.y, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CB_PREV + Bin(prev.y, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CR_CURR + Bin(curr.z, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CR_PREV + Bin(prev.z, CHROMA_BINS)], 1);
+
+        InterlockedAdd(SceneStats[SAD_SUM], (uint)(abs(curr.x - prev.x) * SAD_SCALE + 0.5f));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex < HISTOGRAM_SIZE && gs_Histogram[groupIndex] > 0)
+        InterlockedAdd(SceneStats[groupIndex], gs_Histogram[groupIndex]);
+}
+
+// Half the L1 distance between two normalized histograms (0 = identical, 1 = disjoint)
+float HistogramDistance(uint curr, uint prev, uint bins, float cells)
+{
+    uint sum = 0;
+    for (uint i = 0; i < bins; ++i)
+    {
+        uint a = SceneStats[curr + i];
+        uint b = SceneStats[prev + i];
+        sum += (a > b) ? (a - b) : (b - a);
+    }
+    return (float)sum / (2.0f * cells);
+}
+
+// CS_FrameHash layout
+#define CHANGED_TILES 0
+#define HAS_HISTORY 1
+
+// Single thread, after CSMain: 64 histogram bins are not worth a reduction
+[numthreads(1, 1, 1)]
+void CSResolve()
+{
+    bool duplicate = UseHashStats && HashStats[HAS_HISTORY] != 0 && HashStats[CHANGED_TILES] == 0;
+    if (!DetectCuts || duplicate)
+    {
+        SceneStats[VERDICT] = duplicate ? 1 : 0;
+        return;
+    }
+
+    float cells = (float)(ThumbWidth * ThumbHeight);
+
+    float distance = HistogramDistance(LUMA_CURR, LUMA_PREV, LUMA_BINS, cells);
+    distance = max(distance, HistogramDistance(CB_CURR, CB_PREV, CHROMA_BINS, cells));
+    distance = max(distance, HistogramDistance(CR_CURR, CR_PREV, CHROMA_BINS, cells));
+
+    float meanSAD = (float)SceneStats[SAD_SUM] / (SAD_SCALE * cells);
+
+    SceneStats[VERDICT] = (distance > HistogramThreshold && meanSAD > SADThreshold) ? 1 : 0;
+}
+)";
+
+    inline const char* CS_SplitScreen = R"(
+Texture2D<float4> TexGen : register(t0);
+Texture2D<float4> TexReal : register(t1);
+
+RWTexture2D<float4> Output : register(u0);
+
+cbuffer CB : register(b0)
+{
+	float SplitPos; // 0.0 - 1.0 (Normalized screen width)
+	float3 Padding;
+};
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+	uint width, height;
+	Output.GetDimensions(width, height);
+
+	if (id.x >= width || id.y >= height) return;
+
+	float u = (float)id.x / (float)width;
+	float4 color;
+
+	// Use Integer logic for stability
+	int splitX = (int)(SplitPos * (float)width);
+	int px = (int)id.x;
+
+	// Draw 2px Line
+	if (abs(px - splitX) <= 1)
+	{
+		// Draw White Line
+		color = float4(1.0, 1.0, 1.0, 1.0);
+	}
+	else if (u < SplitPos)
+	{
+		// Left: Generated Frame (Frame Gen ON)
+		color = TexGen[id.xy];
+	}
+	else
+	{
+		// Right: Real Frame (Frame Gen OFF - simulating simple repeat)
+		color = TexReal[id.xy];
+	}
+
+	Output[id.xy] = color;
+}
+)";
+
+    inline const char* CS_TileClassify = R"(
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1); // CSClassify
+Texture2D<float2> TexMotion : register(t2); // CSClassify: the field synthesis samples (flow resolution)
+Texture2D<float> TexMask : register(t3); // CSClassify: HUD mask
+StructuredBuffer<uint> GlobalStats : register(t4); // CSClassify: [Scene Change Stats]
+StructuredBuffer<uint> TileListIn : register(t5); // CSStatic
+
+RWStructuredBuffer<uint> TileList : register(u0); // CSClassify: dynamic tiles from the front, static tiles from the back
+RWBuffer<uint> DispatchArgs : register(u1); // CSClassify: [0-2] dynamic groups, [3-5] static groups (cleared to 0)
+RWTexture2D<float4> OutputFrame : register(u0); // CSStatic
+RWTexture2D<float4> OutputCopy : register(u1); // CSStatic: RCAS input of the dynamic tiles (WriteCopy)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int SceneChangeThreshold; // Same test as CS_Interpolate
+    float2 FlowScale; // Output pixels per flow pixel
+    uint TileCount;
+    float StaticMotion; // Output pixels, a static pixel moves less
+    float StaticDiff; // Sum of the RGB differences, a static pixel changes less
+    float Sharpness; // CSStatic: RCAS strength of the real frame, 0 = plain copy
+    int WriteCopy;
+    float3 Padding;
+};
+
+// [Tile Skip] A 16x16 tile is static when none of its pixels would come out of synthesis different from the
+// real frame: no motion and no change between the frames, or covered by the HUD / a scene change (both of which
+// synthesis answers with TexCurrent anyway). Only dynamic tiles are warped, static ones are the real frame.
+
+#define TILE_SIZE 16
+
+groupshared uint gs_Dynamic;
+
+// Tiles are packed as y << 16 | x
+uint2 TileOrigin(uint tile)
+{
+    return uint2(tile & 0xFFFF, tile >> 16) * TILE_SIZE;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSClassify(uint3 groupId : SV_GroupID, uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gs_Dynamic = 0;
+
+        // The counts are the only atomics, the Y / Z group counts are plain stores
+        if (groupId.x == 0 && groupId.y == 0)
+        {
+            DispatchArgs[1] = 1;
+            DispatchArgs[2] = 1;
+            DispatchArgs[4] = 1;
+            DispatchArgs[5] = 1;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    uint2 pos = dispatchThreadId.xy;
+
+    if (pos.x < w && pos.y < h && GlobalStats[0] <= (uint)SceneChangeThreshold && TexMask[pos] <= 0.5f)
+    {
+        // Sampled exactly like CS_Interpolate does
+        uint mw, mh;
+        TexMotion.GetDimensions(mw, mh);
+        float2 motion = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * FlowScale * float2(mw, mh)), 0) * FlowScale;
+
+        float3 diff = abs(TexCurrent[pos].rgb - TexPrev[pos].rgb);
+
+        if (dot(motion, motion) > StaticMotion * StaticMotion || diff.r + diff.g + diff.b > StaticDiff)
+        {
+            gs_Dynamic = 1; // Any writer, same value
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint tile = (groupId.y << 16) | groupId.x;
+        uint slot;
+        if (gs_Dynamic)
+        {
+            InterlockedAdd(DispatchArgs[0], 1, slot);
+            TileList[slot] = tile;
+        }
+        else
+        {
+            InterlockedAdd(DispatchArgs[3], 1, slot);
+            TileList[TileCount - 1 - slot] = tile;
+        }
+    }
+}
+
+// Same lobe as CS_RCAS, on the real frame
+float4 SharpenCurrent(int2 pos, int w, int h)
+{
+    float4 c = TexCurrent[pos];
+    float3 n = TexCurrent[int2(pos.x, max(0, pos.y - 1))].rgb;
+    float3 s = TexCurrent[int2(pos.x, min(h - 1, pos.y + 1))].rgb;
+    float3 wv = TexCurrent[int2(max(0, pos.x - 1), pos.y)].rgb;
+    float3 e = TexCurrent[int2(min(w - 1, pos.x + 1), pos.y)].rgb;
+
+    float lobe = lerp(0.0f, -0.2f, Sharpness);
+    float3 result = (c.rgb + lobe * (n + s + wv + e)) / (1.0f + 4.0f * lobe);
+    return float4(saturate(result), c.a);
+}
+
+// Indirect over the static tiles: the real frame, as it is presented (sharpened when the generated frames are)
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSStatic(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    uint2 pos = TileOrigin(TileListIn[TileCount - 1 - groupId.x]) + groupThreadId.xy;
+    if (pos.x >= w || pos.y >= h) return;
+
+    float4 color = TexCurrent[pos];
+    if (WriteCopy) OutputCopy[pos] = color;
+    OutputFrame[pos] = Sharpness > 0.0f ? SharpenCurrent(int2(pos), (int)w, (int)h) : color;
+}
+)";
+
+    inline const char* CS_Upsample = R"(
+Texture2D<float2> InputMotion : register(t0); // Coarse level
+Texture2D<float> GuideFine : register(t1); // [Guided Upsample] Luma at the output level (optional)
+Texture2D<float> GuideCoarse : register(t2); // Luma at the input level
+RWTexture2D<float2> OutputMotion : register(u0);
+
+cbuffer CB : register(b0)
+{
+    int UseGuide; // 0 = nearest coarse vector
+    float RangeSigma; // Luma difference at which a coarse vector's weight falls to exp(-1/2)
+    float2 Padding;
+};
+
+// [Guided Upsample] Joint bilateral upsampling: each output pixel blends the 3x3 nearest coarse vectors, weighted by
+// distance and by how close their luma is to the pixel's own. Vectors stay on their side of an object edge
+// instead of coming out as 2x2 blocks. Evaluated separably (3 taps across, then 3 down) so the CPU port
+// (CPUOpticalFlow::Upsample) can run it as two 1D passes: the horizontal pass is guided by the output row pair
+// averaged onto the coarse row.
+
+#define SPATIAL_SIGMA 1.0f // Coarse pixels
+#define RANGE_FLOOR 0.001f // Keeps an all-edges neighbourhood at plain spatial weights
+
+float SpatialWeight(float d)
+{
+    return exp(-d * d / (2.0f * SPATIAL_SIGMA * SPATIAL_SIGMA));
+}
+
+float RangeWeight(float d)
+{
+    return exp(-d * d / (2.0f * RangeSigma * RangeSigma)) + RANGE_FLOOR;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 dstPos = int2(dispatchThreadId.xy);
+    uint fw, fh, cw, ch;
+    OutputMotion.GetDimensions(fw, fh);
+    InputMotion.GetDimensions(cw, ch);
+    if (dstPos.x >= (int)fw || dstPos.y >= (int)fh) return;
+
+    // Source index is half of destination, a motion of 1 coarse pixel is 2 fine pixels
+    int2 srcPos = min(dstPos / 2, int2(cw, ch) - 1);
+
+    if (!UseGuide)
+    {
+        OutputMotion[dstPos] = InputMotion[srcPos] * 2.0f;
+        return;
+    }
+
+    float2 center = (float2(dstPos) + 0.5f) * 0.5f - 0.5f; // Output pixel in coarse pixel coordinates
+    float guide = GuideFine[dstPos];
+
+    float2 sum = 0.0f;
+    float weightSum = 0.0f;
+
+    [unroll]
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+        int j = clamp(srcPos.y + dy, 0, (int)ch - 1);
+
+        // Horizontal pass at coarse row j, guided by the output column averaged over the row pair j covers
+        float rowGuide = 0.5f * (GuideFine[int2(dstPos.x, min(2 * j, (int)fh - 1))] + GuideFine[int2(dstPos.x, min(2 * j + 1, (int)fh - 1))]);
+        float2 rowSum = 0.0f;
+        float rowWeight = 0.0f;
+
+        [unroll]
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            int i = clamp(srcPos.x + dx, 0, (int)cw - 1);
+            float w = SpatialWeight(i - center.x) * RangeWeight(rowGuide - GuideCoarse[int2(i, j)]);
+            rowSum += InputMotion[int2(i, j)] * w;
+            rowWeight += w;
+        }
+
+        // Vertical pass
+        float w = SpatialWeight(j - center.y) * RangeWeight(guide - rowGuide);
+        sum += (rowSum / rowWeight) * w;
+        weightSum += w;
+    }
+
+    OutputMotion[dstPos] = (sum / weightSum) * 2.0f;
+}
+)";
+
+    inline const char* CS_Upscale = R"(
+Texture2D<float4> Input : register(t0);
+RWTexture2D<float4> Output : register(u0);
+SamplerState LinearSampler : register(s0);
+SamplerState PointSampler : register(s1);
+
+cbuffer CBUpscale : register(b0)
+{
+    int Mode; // 0=Nearest, 1=Bilinear, 2=Bicubic, 3=Lanczos
+    int Radius; // For Lanczos (e.g., 2 or 3)
+    float2 InputSize; // Width, Height
+    float Sharpness; // [Fused RCAS] CSUpscaleRCAS only, same as CS_RCAS
+    int StorageFormat; // [Fused RCAS] Precision the two-pass chain stored the upscaled frame at: 0 = Float, 1 = UNORM8, 2 = FLOAT16
+    float2 Padding;
+}
+
+// Helper: Cubic Weight
+float CubicWeight(float x)
+{
+    const float B = 0.0f;
+    const float C = 0.5f;
+    float ax = abs(x);
+    if (ax < 1.0f)
+        return ((12 - 9 * B - 6 * C) * ax * ax * ax + (-18 + 12 * B + 6 * C) * ax * ax + (6 - 2 * B)) / 6.0f;
+    else if (ax < 2.0f)
+        return ((-B - 6 * C) * ax * ax * ax + (6 * B + 30 * C) * ax * ax + (-12 * B - 48 * C) * ax + (8 * B + 24 * C)) / 6.0f;
+    else
+        return 0.0f;
+}
+
+// Helper: Sinc function
+float Sinc(float x)
+{
+    if (x == 0.0f) return 1.0f;
+    float pi_x = 3.14159265f * x;
+    return sin(pi_x) / pi_x;
+}
+
+// Helper: Lanczos Weight
+float LanczosWeight(float x, int a)
+{
+    if (abs(x) >= a) return 0.0f;
+    return Sinc(x) * Sinc(x / a);
+}
+
+float4 SampleNearest(int2 coord)
+{
+    return Input[coord]; // Direct texel fetch
+}
+
+float4 SampleBilinear(float2 uv)
+{
+    return Input.SampleLevel(LinearSampler, uv, 0);
+}
+
+// Bicubic Sampling (Catmull-Rom)
+float4 SampleBicubic(float2 uv)
+{
+    float2 texSize = InputSize;
+    float2 samplePos = uv * texSize - 0.5f;
+    int2 tc = floor(samplePos);
+    float2 f = samplePos - tc;
+
+    float4 sum = 0;
+    float totalWeight = 0;
+    
+    // 4x4 Neighborhood
+    [unroll]
+    for (int y = -1; y <= 2; y++)
+    {
+        [unroll]
+        for (int x = -1; x <= 2; x++)
+        {
+            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
+            float w = CubicWeight(x - f.x) * CubicWeight(y - f.y);
+            sum += Input[coord] * w;
+            totalWeight += w;
+        }
+    }
+    return sum / totalWeight; // Normalization helps if edge clamping issues occur
+}
+
+// Lanczos Sampling
+float4 SampleLanczos(float2 uv, int a)
+{
+    float2 texSize = InputSize;
+    float2 samplePos = uv * texSize - 0.5f;
+    int2 tc = floor(samplePos);
+    float2 f = samplePos - tc;
+
+    float4 sum = 0;
+    float totalWeight = 0;
+
+    // Window size: -a+1 to a
+    for (int y = -a + 1; y <= a; y++)
+    {
+        for (int x = -a + 1; x <= a; x++)
+        {
+            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
+            float w = LanczosWeight(float(x) - f.x, a) * LanczosWeight(float(y) - f.y, a);
+            sum += Input[coord] * w;
+            totalWeight += w;
+        }
+    }
+    
+    // Prevent ringing artifacts (optional clamp or just raw)
+    // For now, raw output, but weight normalization is key.
+    return (totalWeight > 0.0001f) ? (sum / totalWeight) : float4(0,0,0,0);
+}
+
+float4 Upscale(uint2 pos, uint outW, uint outH)
+{
+    float2 uv = (float2(pos) + 0.5f) / float2(outW, outH);
+    
+    float4 color = 0;
+    
+    // Switch is acceptable here
+    // Mode 0 = Native (Should probably not be dispatched, but behaves like Nearest/Copy if hit)
+    
+    if (Mode == 1) // Nearest
+    {
+        float2 iUV = uv * InputSize;
+        color = Input[int2(iUV)]; // or simple cast
+    }
+    else if (Mode == 2) // Bilinear
+    {
+        color = SampleBilinear(uv);
+    }
+    else if (Mode == 3) // Bicubic
+    {
+        color = SampleBicubic(uv);
+    }
+    else if (Mode == 4) // Lanczos
+    {
+        color = SampleLanczos(uv, Radius);
+    }
+    else // Fallback (Native or Invalid)
+    {
+        // For Native, we essentially want 1:1 copy, which Nearest handles correctly if sizes match
+        float2 iUV = uv * InputSize;
+        color = Input[int2(iUV)]; 
+    }
+
+    return color;
+}
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    uint outW, outH;
+    Output.GetDimensions(outW, outH);
+    if (id.x >= outW || id.y >= outH) return;
+
+    Output[id.xy] = Upscale(id.xy, outW, outH);
+}
+
+// [Fused RCAS] Upscale + CS_RCAS in one pass: each group upscales its 16x16 tile plus a 1 pixel apron into
+// groupshared memory, then sharpens from there. The apron uses the same edge clamping as CS_RCAS, and the
+// upscaled colors are rounded to the storage format first, so the output matches main -> CS_RCAS.
+#define TILE_SIZE 16
+#define APRON_SIZE (TILE_SIZE + 2)
+
+groupshared float4 gs_Upscaled[APRON_SIZE * APRON_SIZE];
+
+float4 RoundToStorage(float4 color)
+{
+    if (StorageFormat == 1) return round(saturate(color) * 255.0f) / 255.0f;
+    if (StorageFormat == 2) return f16tof32(f32tof16(color));
+    return color;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSUpscaleRCAS(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint outW, outH;
+    Output.GetDimensions(outW, outH);
+    int2 tileOrigin = int2(groupId.xy) * TILE_SIZE - 1;
+
+    // 1. Upscaled tile + apron (324 texels, 256 threads)
+    for (uint i = groupIndex; i < APRON_SIZE * APRON_SIZE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int2 pos = tileOrigin + int2(i % APRON_SIZE, i / APRON_SIZE);
+        pos = clamp(pos, int2(0, 0), int2(outW, outH) - 1);
+        gs_Upscaled[i] = RoundToStorage(Upscale(uint2(pos), outW, outH));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint2 pos = groupId.xy * TILE_SIZE + groupThreadId.xy;
+    if (pos.x >= outW || pos.y >= outH) return;
+
+    // 2. RCAS (CS_RCAS), neighbors from the tile
+    uint center = (groupThreadId.y + 1) * APRON_SIZE + groupThreadId.x + 1;
+    float4 c = gs_Upscaled[center];
+    float3 n = gs_Upscaled[center - APRON_SIZE].rgb;
+    float3 s = gs_Upscaled[center + APRON_SIZE].rgb;
+    float3 w = gs_Upscaled[center - 1].rgb;
+    float3 e = gs_Upscaled[center + 1].rgb;
+
+    float lobe = lerp(0.0f, -0.2f, Sharpness);
+    float3 neighborSum = n + s + w + e;
+    float3 numerator = c.rgb + lobe * neighborSum;
+    float denominator = 1.0f + 4.0f * lobe;
+
+    Output[pos] = float4(saturate(numerator / denominator), c.a);
+}
+)";
+
+    inline const char* CS_WarpError = R"(
+Texture2D<float4> TexCurrent : register(t0); // Captured frames (native resolution)
+Texture2D<float4> TexPrev : register(t1);
+Texture2D<float2> InputMotion : register(t2); // Final motion (flow resolution, or the block field)
+RWStructuredBuffer<uint> Stats : register(u0); // [0] error sum (ERROR_SCALE fixed point), [1] pixels, cleared per measurement
+
+cbuffer CB : register(b0)
+{
+    float MotionScale; // Frame pixels per flow pixel
+    int Step; // Every Step-th pixel in x and y
+    float Padding[2];
+};
+
+// [Auto-Tune] Self-consistency of a configuration: the previous frame warped onto the current one by the final
+// motion, mean luma difference at the frames' resolution (so every Render Scale is measured alike). WarpError reads
+// it back; the dispatch sits inside the scene cut predicate, a cut leaves the pixel count at zero.
+
+#define GROUP 16
+#define ERROR_SCALE 256.0f
+
+static const float3 LumaWeights = float3(0.2126f, 0.7152f, 0.0722f); // Rec. 709, as CS_LumaPyramid
+
+groupshared float gs_Error[GROUP * GROUP];
+groupshared uint gs_Count;
+
+float PrevLuma(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = dot(TexPrev[clamp(p, int2(0, 0), maxPos)].rgb, LumaWeights);
+    float b = dot(TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)].rgb, LumaWeights);
+    float c = dot(TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)].rgb, LumaWeights);
+    float d = dot(TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)].rgb, LumaWeights);
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// Motion under frame pixel 'pos', bilinear on whatever grid the field has
+float2 MotionAt(int2 pos, int2 frameSize)
+{
+    uint mw, mh;
+    InputMotion.GetDimensions(mw, mh);
+    int2 maxPos = int2(mw, mh) - 1;
+    float2 q = (float2(pos) + 0.5f) * float2(mw, mh) / float2(frameSize) - 0.5f;
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float2 a = InputMotion[clamp(p, int2(0, 0), maxPos)];
+    float2 b = InputMotion[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float2 c = InputMotion[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float2 d = InputMotion[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+[numthreads(GROUP, GROUP, 1)]
+void CSWarpError(uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0) gs_Count = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 frameSize = int2(w, h);
+    int2 pos = int2(dispatchThreadId.xy) * Step;
+
+    float error = 0.0f;
+    if (pos.x < frameSize.x && pos.y < frameSize.y)
+    {
+        float2 v = MotionAt(pos, frameSize) * MotionScale;
+        // Clamped for HDR frames, the sum stays in 32 bits up to 8K
+        error = saturate(abs(dot(TexCurrent[pos].rgb, LumaWeights) - PrevLuma(float2(pos) + v, frameSize - 1)));
+        InterlockedAdd(gs_Count, 1);
+    }
+    gs_Error[groupIndex] = error;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = GROUP * GROUP / 2; s > 0; s >>= 1)
+    {
+        if (groupIndex < s) gs_Error[groupIndex] += gs_Error[groupIndex + s];
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex == 0 && gs_Count > 0)
+    {
+        InterlockedAdd(Stats[0], (uint)round(gs_Error[0] * ERROR_SCALE));
+        InterlockedAdd(Stats[1], gs_Count);
+    }
+}
+)";
+
+    inline const char* PS_SceneCut = R"(
+StructuredBuffer<uint> SceneStats : register(t0); // CS_SceneCut output
+
+// [Scene Cut] A single point on a 1x1 target, drawn inside an occlusion predicate.
+// It only survives when the frame is NOT a cut (or duplicate), so work predicated on it is dropped on a cut
+// by the GPU itself, without reading the verdict back.
+
+#define VERDICT 129 // CS_SceneCut layout
+
+float4 VSMain(uint vertexId : SV_VertexID) : SV_Position
+{
+    return float4(0.0f, 0.0f, 0.5f, 1.0f); // Center of the target
+}
+
+float4 PSMain(float4 position : SV_Position) : SV_Target
+{
+    if (SceneStats[VERDICT] != 0) discard;
+    return float4(1.0f, 1.0f, 1.0f, 1.0f);
+}
+)";
+
+} // namespace EmbeddedShaders
@@ -1,51 +1,92 @@
-Texture2D<float2> FwdFlow : register(t0);
-Texture2D<float2> BwdFlow : register(t1);
-
-RWTexture2D<float2> OutputFlow : register(u0);
-RWTexture2D<float> OutputConfidence : register(u1); // Optional confidence map
-
-cbuffer CB : register(b0)
-{
-	float Tolerance; // e.g. 1.0 - 5.0 pixels
-	float3 Padding;
-};
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-	uint width, height;
-	OutputFlow.GetDimensions(width, height);
-	if (id.x >= width || id.y >= height) return;
-
-	float2 fwd = FwdFlow[id.xy];
-	
-	// Backward flow is at the position pointed to by forward flow
-	int2 targetPos = int2(id.x + fwd.x, id.y + fwd.y);
-	
-	// Boundary check
-	float confidence = 1.0f;
-	if (targetPos.x < 0 || targetPos.y < 0 || targetPos.x >= (int)width || targetPos.y >= (int)height)
-	{
-		confidence = 0.0f;
-	}
-	else
-	{
-		float2 bwd = BwdFlow[targetPos];
-		
-		// Ideally: Fwd + Bwd approx 0.
-		// Delta = |Fwd + Bwd|
-		float2 diff = abs(fwd + bwd);
-		float dist = length(diff);
-		
-		if (dist > Tolerance)
-		{
-			// Occlusion or Bad Match
-			confidence = max(0.0f, 1.0f - (dist - Tolerance) * 0.5f);
-		}
-	}
-	
-	// Write sanitized flow (maybe damped by confidence, or just passed through)
-	// For now, we pass through Forward Flow, but write Confidence for the Interpolator to use.
-	OutputFlow[id.xy] = fwd;
-	OutputConfidence[id.xy] = confidence;
-}
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous (OpticalFlow convention)
+Texture2D<float2> BwdFlow : register(t1); // Previous -> Current
+
+RWTexture2D<float2> OutputFlow : register(u0); // Forward flow, occluded vectors replaced by the background
+
+// [Occlusion] One texel per Scale x Scale pixels
+// x: content of the current frame is visible in the previous one
+// y: content of the previous frame is still visible in the current one
+RWTexture2D<float2> OutputVisibility : register(u1);
+
+cbuffer CB : register(b0)
+{
+	float Tolerance; // e.g. 1.0 - 5.0 pixels
+	int Scale;
+	int RepairRadius; // Farthest neighbour (pixels) an occluded vector is taken from
+	float Padding;
+};
+
+// Follows 'flow' from pos and checks that 'reverse' brings it back.
+// Ideally: Flow + Reverse approx 0. Delta = |Flow + Reverse|
+float Consistency(Texture2D<float2> flow, Texture2D<float2> reverse, int2 pos, int2 size)
+{
+	float2 v = flow[pos];
+	int2 targetPos = int2(round(float2(pos) + v));
+
+	// Leaves the frame: nothing to match on the other side
+	if (any(targetPos < 0) || any(targetPos >= size)) return 0.0f;
+
+	float dist = length(v + reverse[targetPos]);
+
+	// Occlusion or Bad Match past the tolerance
+	return saturate(1.0f - (dist - Tolerance) * 0.5f);
+}
+
+// Uncovered content has no true match, so its vector is noise. It belongs to the background,
+// which is the slowest consistent vector around it (same rule as the CS_Extrapolate hole filling).
+float2 RepairVector(int2 pos, int2 size)
+{
+	const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+
+	float2 best = FwdFlow[pos];
+	float bestLengthSq = 1e9f;
+	for (int d = 0; d < 8; ++d)
+	{
+		// Nearest consistent pixel along each direction, stepping 2, 4, 8 ...
+		for (int r = 2; r <= RepairRadius; r *= 2)
+		{
+			int2 p = pos + dirs[d] * r;
+			if (any(p < 0) || any(p >= size)) break;
+			if (Consistency(FwdFlow, BwdFlow, p, size) < 0.5f) continue;
+
+			float2 v = FwdFlow[p];
+			if (dot(v, v) < bestLengthSq)
+			{
+				bestLengthSq = dot(v, v);
+				best = v;
+			}
+			break;
+		}
+	}
+	return best;
+}
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+	uint width, height;
+	FwdFlow.GetDimensions(width, height);
+	int2 size = int2(width, height);
+
+	int2 origin = int2(id.xy) * Scale;
+	if (origin.x >= size.x || origin.y >= size.y) return;
+
+	// Least visible pixel of the cell, a partly occluded cell counts as occluded
+	float2 visibility = float2(1.0f, 1.0f);
+	for (int y = 0; y < Scale; ++y)
+	{
+		for (int x = 0; x < Scale; ++x)
+		{
+			int2 pos = origin + int2(x, y);
+			if (pos.x >= size.x || pos.y >= size.y) continue;
+
+			float forward = Consistency(FwdFlow, BwdFlow, pos, size);
+			visibility.x = min(visibility.x, forward);
+			visibility.y = min(visibility.y, Consistency(BwdFlow, FwdFlow, pos, size));
+
+			OutputFlow[pos] = (forward < 0.5f) ? RepairVector(pos, size) : FwdFlow[pos];
+		}
+	}
+
+	OutputVisibility[id.xy] = visibility;
+}
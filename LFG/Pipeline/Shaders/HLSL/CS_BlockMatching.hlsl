@@ -1,150 +1,245 @@
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float2> InputInitMotion : register(t2); // NEW: Initial guess from lower level
-RWTexture2D<float2> OutputMotion : register(u0);
-RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
-
-SamplerState LinearSampler : register(s0);
-
-// Parameters
-cbuffer CB : register(b0)
-{
-    int Width;
-    int Height;
-    int BlockSize; 
-    int SearchRadius; 
-    int EnableSubPixel;
-    int UseInitMotion; // NEW: 0 or 1
-    int2 Padding;      // Alignment
-};
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    // Global pixel position
-    int2 pos = int2(dispatchThreadId.xy);
-    
-    if (pos.x >= Width || pos.y >= Height)
-        return;
-
-    // Center pixel of the block
-    float4 targetPixel = TexCurrent[pos];
-    
-    // Initial Guess
-    int2 searchCenter = int2(0, 0);
-    if (UseInitMotion)
-    {
-        // Read from lower level (already upsampled or same size)
-        float2 initVec = InputInitMotion[pos];
-        searchCenter = int2(round(initVec.x), round(initVec.y));
-    }
-
-    // [Ultra Optimization] Fast Path for Static/Perfect Guess
-    // Check the exact guess position first.
-    {
-         int2 searchPos = pos + searchCenter;
-         if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
-         {
-             float4 candidatePixel = TexPrev[searchPos];
-             float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-             float sad = diff.r + diff.g + diff.b;
-             
-             if (sad < 0.001f) // Virtually identical
-             {
-                 OutputMotion[pos] = float2(searchCenter.x, searchCenter.y);
-                 return; // <--- EARLY EXIT: Skip entire loop
-             }
-         }
-    }
-
-    float minSAD = 999999.0f;
-    int2 bestVector = searchCenter; // Default to initial guess
-
-    // Refined Search around Center (Reduced radius is adequate if guess is good)
-    // If not using init motion, we search full radius.
-    // If using init motion, we could technically search a smaller radius, but for safety lets keep it.
-    
-    [loop] // Use loop for variable radius, unroll is only for constant
-    for (int y = -SearchRadius; y <= SearchRadius; ++y)
-    {
-        for (int x = -SearchRadius; x <= SearchRadius; ++x)
-        {
-            int2 offset = int2(x, y);
-            int2 searchPos = pos + searchCenter + offset;
-            
-            // Boundary check
-            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
-                continue;
-
-            float4 candidatePixel = TexPrev[searchPos];
-            
-            float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-            float sad = diff.r + diff.g + diff.b;
-
-            if (sad < minSAD)
-            {
-                minSAD = sad;
-                bestVector = searchCenter + offset;
-                
-                // Early Exit: Perfect match found (SAD ~ 0)
-                // This speeds up static areas massively (HUD, Skyboxes)
-                if (sad < 0.001f) 
-                {
-                     // Break outer loop manually
-                     y = SearchRadius + 1; 
-                     break;
-                }
-            }
-        }
-    }
-
-    // Write integer result first
-    float2 finalVector = float2(bestVector.x, bestVector.y);
-    
-    // [Scene Change Detection]
-    // If the best match is still terrible, it means we found NOTHING similar.
-    // If many blocks fail, it's a scene change.
-    // Normalized threshold: 0.15 (15% avg diff per pixel)
-    // Scale: Sad is sum of 3 channels * BlockSize^2
-    float avgDiff = minSAD / (max(1, BlockSize * BlockSize) * 3.0f);
-    if (avgDiff > 0.15f)
-    {
-        InterlockedAdd(GlobalStats[0], 1);
-    }
-    
-
-
-    // Sub-Pixel Refinement (Bilinear Check)
-    if (EnableSubPixel > 0)
-    {
-        float2 bestSub = finalVector;
-        float minSubSAD = minSAD;
-        
-        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
-        
-        uint w, h;
-        TexPrev.GetDimensions(w, h);
-        float2 texSize = float2(w, h);
-        
-        for(int i=0; i<4; ++i)
-        {
-             // Candidate Pos in Prev: Original Pos + BestIntegerVec + Offset
-             float2 checkPos = float2(pos) + finalVector + offsets[i];
-             float2 uv = (checkPos + 0.5f) / texSize;
-             
-             float4 candidatePixel = TexPrev.SampleLevel(LinearSampler, uv, 0);
-             
-             float3 diff = abs(targetPixel.rgb - candidatePixel.rgb);
-             float sad = diff.r + diff.g + diff.b;
-             
-             if (sad < minSubSAD)
-             {
-                 minSubSAD = sad;
-                 bestSub = finalVector + offsets[i];
-             }
-        }
-        finalVector = bestSub;
-    }
-    
-    OutputMotion[pos] = finalVector;
-}
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitMotion : register(t2); // NEW: Initial guess from lower level
+Texture2D<float2> InputPredictedMotion : register(t3); // [Temporal Warm-Start] Last frame's motion, projected
+Texture2D<float> TexUnchanged : register(t4); // [Tile Hash] 1 = tile identical to last frame
+Texture2D<float4> InputTileCandidates : register(t5); // [Phase Correlation] Two vectors per tile, CS_PhaseCorrelation
+StructuredBuffer<uint> TileList : register(t6); // [Hybrid Flow] Tiles CS_FlowSelect gave to BlockMatching (CSTiles only)
+Texture2D<float> InputTileRadius : register(t7); // [Adaptive Radius] Flow resolution bound per tile, CS_MotionStats
+RWTexture2D<float2> OutputMotion : register(u0);
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+// Parameters
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; 
+    int SearchRadius; 
+    int EnableSubPixel;
+    int UseInitMotion; // NEW: 0 or 1
+    int UsePredictedMotion; // 0 or 1
+    int UnchangedTileSize; // [Tile Hash] Level pixels per TexUnchanged texel, 0 = no mask
+    int UseTileCandidates; // [Phase Correlation] 0 or 1
+    float CandidateScale; // Level pixels per pixel of the candidates' level
+    int UseTileRadius; // [Adaptive Radius] 0 or 1
+    float TileRadiusScale; // Level pixels per flow resolution pixel
+};
+
+#define CANDIDATE_TILE 16 // PhaseCorrelation::TileSize
+#define FLOW_TILE 16 // FlowTuning::FlowTileSize
+#define RADIUS_TILE 16 // FlowTuning::FlowTileSize
+#define MIN_RADIUS 2 // Pyramid::MinSearchRadius
+
+// [Phase Correlation] Candidates of the tile covering 'pos', scaled to this level
+float4 TileCandidates(int2 pos)
+{
+    uint cw, ch;
+    InputTileCandidates.GetDimensions(cw, ch);
+    uint2 tile = min(uint2(float2(pos) / (CANDIDATE_TILE * CandidateScale)), uint2(cw, ch) - 1);
+    return InputTileCandidates[tile] * CandidateScale;
+}
+
+// [Adaptive Radius] SearchRadius narrowed to last frame's motion around the tile covering 'pos' (CS_MotionStats)
+int TileSearchRadius(int2 pos)
+{
+    if (!UseTileRadius) return SearchRadius;
+    uint tw, th;
+    InputTileRadius.GetDimensions(tw, th);
+    uint2 tile = min(uint2(float2(pos) / (RADIUS_TILE * TileRadiusScale)), uint2(tw, th) - 1);
+    return min(max((int)ceil(InputTileRadius[tile] * TileRadiusScale), MIN_RADIUS), SearchRadius);
+}
+
+void MatchPixel(int2 pos)
+{
+    if (pos.x >= Width || pos.y >= Height)
+        return;
+
+    // [Tile Hash] Same content as last frame: zero motion, no search
+    if (UnchangedTileSize > 0 && TexUnchanged[pos / UnchangedTileSize] > 0.5f)
+    {
+        OutputMotion[pos] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // Center pixel of the block
+    float targetPixel = TexCurrent[pos];
+    
+    // Initial Guess
+    int2 searchCenter = int2(0, 0);
+    if (UseInitMotion)
+    {
+        // Read from lower level (already upsampled or same size)
+        float2 initVec = InputInitMotion[pos];
+        searchCenter = int2(round(initVec.x), round(initVec.y));
+    }
+
+    // [Ultra Optimization] Fast Path for Static/Perfect Guess
+    // Check the exact guess position first.
+    {
+         int2 searchPos = pos + searchCenter;
+         if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
+         {
+             float sad = abs(targetPixel - TexPrev[searchPos]);
+             
+             if (sad < 0.00033f) // Virtually identical
+             {
+                 OutputMotion[pos] = float2(searchCenter.x, searchCenter.y);
+                 return; // <--- EARLY EXIT: Skip entire loop
+             }
+         }
+    }
+
+    float minSAD = 999999.0f;
+    int2 bestVector = searchCenter; // Default to initial guess
+
+    // [Temporal Warm-Start]
+    // The projected vector competes as a candidate. It may lie outside the search window,
+    // so a bad prediction (e.g. after a cut) can never pull the window away from the real match.
+    if (UsePredictedMotion)
+    {
+        float2 predVec = InputPredictedMotion[pos];
+        int2 candidate = int2(round(predVec.x), round(predVec.y));
+        int2 searchPos = pos + candidate;
+        if (searchPos.x >= 0 && searchPos.y >= 0 && searchPos.x < Width && searchPos.y < Height)
+        {
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+
+            if (sad < 0.00033f)
+            {
+                OutputMotion[pos] = float2(candidate.x, candidate.y);
+                return; // Prediction holds, skip the search
+            }
+
+            minSAD = sad;
+            bestVector = candidate;
+        }
+    }
+
+    // [Phase Correlation] The tile's correlation peaks compete the same way, reaching shifts the window does not
+    if (UseTileCandidates)
+    {
+        float4 tileVec = TileCandidates(pos);
+        float2 peaks[2] = { tileVec.xy, tileVec.zw };
+        for (int i = 0; i < 2; ++i)
+        {
+            int2 candidate = int2(round(peaks[i].x), round(peaks[i].y));
+            int2 searchPos = pos + candidate;
+            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
+                continue;
+
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+            if (sad < 0.00033f)
+            {
+                OutputMotion[pos] = float2(candidate.x, candidate.y);
+                return;
+            }
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    // Refined Search around Center (Reduced radius is adequate if guess is good)
+    // If not using init motion, we search full radius.
+    // If using init motion, we could technically search a smaller radius, but for safety lets keep it.
+    
+    int radius = TileSearchRadius(pos);
+
+    [loop] // Use loop for variable radius, unroll is only for constant
+    for (int y = -radius; y <= radius; ++y)
+    {
+        for (int x = -radius; x <= radius; ++x)
+        {
+            int2 offset = int2(x, y);
+            int2 searchPos = pos + searchCenter + offset;
+            
+            // Boundary check
+            if (searchPos.x < 0 || searchPos.y < 0 || searchPos.x >= Width || searchPos.y >= Height)
+                continue;
+
+            float sad = abs(targetPixel - TexPrev[searchPos]);
+
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = searchCenter + offset;
+                
+                // Early Exit: Perfect match found (SAD ~ 0)
+                // This speeds up static areas massively (HUD, Skyboxes)
+                if (sad < 0.00033f) 
+                {
+                     // Break outer loop manually
+                     y = radius + 1; 
+                     break;
+                }
+            }
+        }
+    }
+
+    // Write integer result first
+    float2 finalVector = float2(bestVector.x, bestVector.y);
+    
+    // [Scene Change Detection]
+    // If the best match is still terrible, it means we found NOTHING similar.
+    // If many blocks fail, it's a scene change.
+    // Normalized threshold: 0.15 (15% avg diff per pixel)
+    // Scale: Sad is luma * BlockSize^2
+    float avgDiff = minSAD / max(1, BlockSize * BlockSize);
+    if (avgDiff > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], 1);
+    }
+    
+
+
+    // Sub-Pixel Refinement (Bilinear Check)
+    if (EnableSubPixel > 0)
+    {
+        float2 bestSub = finalVector;
+        float minSubSAD = minSAD;
+        
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+        
+        uint w, h;
+        TexPrev.GetDimensions(w, h);
+        float2 texSize = float2(w, h);
+        
+        for(int i=0; i<4; ++i)
+        {
+             // Candidate Pos in Prev: Original Pos + BestIntegerVec + Offset
+             float2 checkPos = float2(pos) + finalVector + offsets[i];
+             float2 uv = (checkPos + 0.5f) / texSize;
+             
+             float sad = abs(targetPixel - TexPrev.SampleLevel(LinearSampler, uv, 0));
+             
+             if (sad < minSubSAD)
+             {
+                 minSubSAD = sad;
+                 bestSub = finalVector + offsets[i];
+             }
+        }
+        finalVector = bestSub;
+    }
+    
+    OutputMotion[pos] = finalVector;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    // Global pixel position
+    MatchPixel(int2(dispatchThreadId.xy));
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(FLOW_TILE, FLOW_TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    MatchPixel(int2(tile & 0xFFFF, tile >> 16) * FLOW_TILE + int2(groupThreadId.xy));
+}
@@ -0,0 +1,186 @@
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitField : register(t2); // Last frame's block field (extra candidate)
+Texture2D<float> TexUnchanged : register(t3); // [Tile Hash] 16x16 tiles, 1 = identical to last frame
+RWTexture2D<float2> OutputField : register(u0); // One vector per block
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; // 4 - 32
+    int SearchRadius;
+    int EnableSubPixel;
+    int UseInitField;
+    int Decimation; // 1 = Every pixel, 2 = Checkerboard
+    int Padding;
+};
+
+// Block-granular full search: one vector per block with the SAD aggregated over the block.
+// The group's threads split the candidate offsets between them and reduce to the best one.
+
+#define MAX_BLOCK 32
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+
+groupshared float gs_Block[MAX_BLOCK * MAX_BLOCK];
+groupshared float gs_Cost[64];
+groupshared int gs_Index[64];
+groupshared float gs_SubCost[4];
+
+// Average SAD per pixel for an integer offset
+float BlockCost(int2 origin, int2 extent, int2 v)
+{
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (Decimation == 2 && ((x + y) & 1)) continue;
+
+            int2 p = clamp(origin + int2(x, y) + v, int2(0, 0), int2(Width - 1, Height - 1));
+            sad += abs(gs_Block[y * BlockSize + x] - TexPrev[p]);
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+// Same for a fractional offset (bilinear)
+float BlockCostBilinear(int2 origin, int2 extent, float2 v)
+{
+    float2 texSize = float2(Width, Height);
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (Decimation == 2 && ((x + y) & 1)) continue;
+
+            float2 uv = (float2(origin + int2(x, y)) + 0.5f + v) / texSize;
+            sad += abs(gs_Block[y * BlockSize + x] - TexPrev.SampleLevel(LinearSampler, uv, 0));
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+// [Tile Hash] Every 16x16 hash tile the block touches is identical to last frame (mask unbound = 0)
+bool BlockUnchanged(int2 origin, int2 extent)
+{
+    int2 first = origin / 16;
+    int2 last = (origin + extent - 1) / 16;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            if (TexUnchanged[int2(x, y)] <= 0.5f) return false;
+        }
+    }
+    return true;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    uint bw, bh;
+    OutputField.GetDimensions(bw, bh);
+    int2 block = int2(groupId.xy);
+    if (block.x >= (int)bw || block.y >= (int)bh) return; // Uniform across the group
+
+    int2 origin = block * BlockSize;
+    int2 extent = min(int2(BlockSize, BlockSize), int2(Width, Height) - origin);
+
+    if (BlockUnchanged(origin, extent)) // Uniform across the group
+    {
+        if (groupIndex == 0) OutputField[block] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // [Cache] Current block
+    for (int i = (int)groupIndex; i < BlockSize * BlockSize; i += 64)
+    {
+        int2 p = origin + int2(i % BlockSize, i / BlockSize);
+        gs_Block[i] = TexCurrent[min(p, int2(Width - 1, Height - 1))];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Search] Window around zero, plus last frame's vector for this block
+    int side = 2 * SearchRadius + 1;
+    int gridCount = side * side;
+    int total = gridCount + (UseInitField ? 1 : 0);
+    float2 initVec = UseInitField ? InputInitField[block] : float2(0, 0);
+    int2 initInt = int2(round(initVec.x), round(initVec.y));
+
+    float bestCost = 999999.0f;
+    int bestIndex = 0;
+    for (int k = (int)groupIndex; k < total; k += 64)
+    {
+        int2 v = (k < gridCount) ? int2(k % side - SearchRadius, k / side - SearchRadius) : initInt;
+        float cost = BlockCost(origin, extent, v) + VECTOR_BIAS * length(float2(v));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestIndex = k;
+        }
+    }
+
+    gs_Cost[groupIndex] = bestCost;
+    gs_Index[groupIndex] = bestIndex;
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction] Min cost
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s && gs_Cost[groupIndex + s] < gs_Cost[groupIndex])
+        {
+            gs_Cost[groupIndex] = gs_Cost[groupIndex + s];
+            gs_Index[groupIndex] = gs_Index[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    int best = gs_Index[0];
+    float minCost = gs_Cost[0];
+    float2 finalVector = (best < gridCount) ? float2(best % side - SearchRadius, best / side - SearchRadius) : float2(initInt);
+
+    // [Sub-Pixel Refinement] One half-pel offset per thread
+    if (EnableSubPixel > 0)
+    {
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+        if (groupIndex < 4)
+        {
+            float2 v = finalVector + offsets[groupIndex];
+            gs_SubCost[groupIndex] = BlockCostBilinear(origin, extent, v) + VECTOR_BIAS * length(v);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        if (groupIndex == 0)
+        {
+            float2 bestSub = finalVector;
+            for (int j = 0; j < 4; ++j)
+            {
+                if (gs_SubCost[j] < minCost)
+                {
+                    minCost = gs_SubCost[j];
+                    bestSub = finalVector + offsets[j];
+                }
+            }
+            finalVector = bestSub;
+        }
+    }
+
+    if (groupIndex != 0) return;
+
+    OutputField[block] = finalVector;
+
+    // [Scene Change Detection] Same normalization as CS_BlockMatching, counted per pixel
+    if (minCost > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], (uint)(extent.x * extent.y));
+    }
+}
@@ -0,0 +1,258 @@
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputInitMotion : register(t2); // Initial guess from lower level
+Texture2D<float2> InputPredictedMotion : register(t3); // [Temporal Warm-Start] Last frame's motion, projected
+Texture2D<float4> InputTileCandidates : register(t5); // [Phase Correlation] Two vectors per tile, CS_PhaseCorrelation
+StructuredBuffer<uint> TileList : register(t6); // [Hybrid Flow] Tiles CS_FlowSelect gave to BlockMatching (CSTiles only)
+Texture2D<float> InputTileRadius : register(t7); // [Adaptive Radius] Flow resolution bound per tile, CS_MotionStats
+RWTexture2D<float2> OutputMotion : register(u0);
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+// Same layout as CS_BlockMatching
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize; // Matching window (1 - 32)
+    int SearchRadius;
+    int EnableSubPixel;
+    int UseInitMotion;
+    int UsePredictedMotion;
+    int UnchangedTileSize; // Unused here
+    int UseTileCandidates;
+    float CandidateScale;
+    int UseTileRadius;
+    float TileRadiusScale;
+};
+
+// Dense per-pixel matching with the SAD aggregated over a BlockSize x BlockSize window around each pixel.
+// The candidates are shared by the 16x16 tile, so one absolute difference image per candidate serves every
+// window in the tile: row and column prefix sums then give each windowed SAD in O(1), whatever the window size.
+
+#define TILE 16 // FlowTuning::FlowTileSize as well
+#define MAX_WINDOW 32
+#define MAX_APRON (TILE + MAX_WINDOW - 1)
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+#define CANDIDATE_TILE 16 // PhaseCorrelation::TileSize
+#define RADIUS_TILE 16 // FlowTuning::FlowTileSize
+#define MIN_RADIUS 2 // Pyramid::MinSearchRadius
+
+groupshared float gs_Row[MAX_APRON * (MAX_APRON + 1)]; // Abs diff, then exclusive prefix sums per row
+groupshared float gs_Col[(MAX_APRON + 1) * TILE]; // Row box sums, then exclusive prefix sums per column
+
+// Windowed SAD of candidate 'v' for this thread's pixel. Called by the whole group (contains barriers).
+float WindowSAD(int2 apronOrigin, int apron, int2 v, uint groupIndex, uint2 tid)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    int stride = apron + 1;
+
+    // 1. Abs diff over the tile plus apron
+    for (int i = (int)groupIndex; i < apron * apron; i += TILE * TILE)
+    {
+        int2 a = int2(i % apron, i / apron);
+        int2 p = apronOrigin + a;
+        gs_Row[a.y * stride + a.x + 1] = abs(TexCurrent[clamp(p, int2(0, 0), maxPos)] - TexPrev[clamp(p + v, int2(0, 0), maxPos)]);
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 2. Prefix sums along the rows (one row per thread)
+    if ((int)groupIndex < apron)
+    {
+        int row = groupIndex * stride;
+        float sum = 0.0f;
+        gs_Row[row] = 0.0f;
+        for (int x = 1; x <= apron; ++x)
+        {
+            sum += gs_Row[row + x];
+            gs_Row[row + x] = sum;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 3. Horizontal window sums for the tile's columns
+    for (int j = (int)groupIndex; j < apron * TILE; j += TILE * TILE)
+    {
+        int y = j / TILE;
+        int x = j % TILE;
+        gs_Col[(y + 1) * TILE + x] = gs_Row[y * stride + x + BlockSize] - gs_Row[y * stride + x];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 4. Prefix sums down the columns (one column per thread)
+    if (groupIndex < TILE)
+    {
+        float sum = 0.0f;
+        gs_Col[groupIndex] = 0.0f;
+        for (int y = 1; y <= apron; ++y)
+        {
+            sum += gs_Col[y * TILE + groupIndex];
+            gs_Col[y * TILE + groupIndex] = sum;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Safe without a trailing barrier: the next call only rewrites gs_Col after two more barriers
+    return gs_Col[(tid.y + BlockSize) * TILE + tid.x] - gs_Col[tid.y * TILE + tid.x];
+}
+
+// [Adaptive Radius] SearchRadius narrowed to last frame's motion around the tile covering 'pos' (CS_MotionStats)
+int TileSearchRadius(int2 pos)
+{
+    if (!UseTileRadius) return SearchRadius;
+    uint tw, th;
+    InputTileRadius.GetDimensions(tw, th);
+    uint2 tile = min(uint2(float2(pos) / (RADIUS_TILE * TileRadiusScale)), uint2(tw, th) - 1);
+    return min(max((int)ceil(InputTileRadius[tile] * TileRadiusScale), MIN_RADIUS), SearchRadius);
+}
+
+// Half-pel check on a 3x3 window (the bilinear taps differ per pixel, nothing to share)
+float SubPixelSAD(int2 pos, float2 v, float2 texSize)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 p = clamp(pos + int2(x, y), int2(0, 0), maxPos);
+            float2 uv = (float2(p) + 0.5f + v) / texSize;
+            sad += abs(TexCurrent[p] - TexPrev.SampleLevel(LinearSampler, uv, 0));
+        }
+    }
+    return sad;
+}
+
+// Called by the whole group for the tile at 'tileOrigin' (contains barriers)
+void MatchTile(int2 tileOrigin, uint2 groupThreadId, uint groupIndex)
+{
+    int2 pos = tileOrigin + int2(groupThreadId);
+    bool inside = pos.x < Width && pos.y < Height; // Outside threads still take part in the barriers
+
+    int apron = TILE + BlockSize - 1;
+    int2 apronOrigin = tileOrigin - BlockSize / 2;
+    float norm = 1.0f / (float)(BlockSize * BlockSize);
+
+    // Search center shared by the tile: the initial guess at the tile center
+    int2 tileCenter = min(tileOrigin + TILE / 2, int2(Width - 1, Height - 1));
+    int2 searchCenter = int2(0, 0);
+    if (UseInitMotion)
+    {
+        float2 initVec = InputInitMotion[tileCenter];
+        searchCenter = int2(round(initVec.x), round(initVec.y));
+    }
+
+    // Guess first so it wins ties. No early exit: every candidate loop below contains group barriers,
+    // so all threads of the tile run the same candidates.
+    float sad = WindowSAD(apronOrigin, apron, searchCenter, groupIndex, groupThreadId);
+    float bestCost = sad * norm + VECTOR_BIAS * length(float2(searchCenter));
+    float bestSAD = sad;
+    int2 bestVector = searchCenter;
+
+    // [Temporal Warm-Start] The tile's projected vector competes as a candidate
+    if (UsePredictedMotion)
+    {
+        float2 predVec = InputPredictedMotion[tileCenter];
+        int2 candidate = int2(round(predVec.x), round(predVec.y));
+        sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+        float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSAD = sad;
+            bestVector = candidate;
+        }
+    }
+
+    // [Phase Correlation] The correlation peaks of the tile's center, scaled to this level
+    if (UseTileCandidates)
+    {
+        uint cw, ch;
+        InputTileCandidates.GetDimensions(cw, ch);
+        uint2 tile = min(uint2(float2(tileCenter) / (CANDIDATE_TILE * CandidateScale)), uint2(cw, ch) - 1);
+        float4 tileVec = InputTileCandidates[tile] * CandidateScale;
+        float2 peaks[2] = { tileVec.xy, tileVec.zw };
+        for (int i = 0; i < 2; ++i)
+        {
+            int2 candidate = int2(round(peaks[i].x), round(peaks[i].y));
+            sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+            float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    // One window for the whole tile, the loops stay group uniform
+    int radius = TileSearchRadius(tileCenter);
+
+    [loop]
+    for (int y = -radius; y <= radius; ++y)
+    {
+        [loop]
+        for (int x = -radius; x <= radius; ++x)
+        {
+            if (x == 0 && y == 0) continue; // The guess, evaluated above
+
+            int2 candidate = searchCenter + int2(x, y);
+            sad = WindowSAD(apronOrigin, apron, candidate, groupIndex, groupThreadId);
+            float cost = sad * norm + VECTOR_BIAS * length(float2(candidate));
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    if (!inside) return;
+
+    float2 finalVector = float2(bestVector);
+
+    // [Scene Change Detection] Average per-pixel diff over the window, same tolerance as CS_BlockMatching
+    if (bestSAD * norm > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], 1);
+    }
+
+    // Sub-Pixel Refinement (Bilinear Check)
+    if (EnableSubPixel > 0)
+    {
+        float2 texSize = float2(Width, Height);
+        float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+
+        float2 bestSub = finalVector;
+        float minSubSAD = SubPixelSAD(pos, finalVector, texSize);
+        for (int i = 0; i < 4; ++i)
+        {
+            float subSAD = SubPixelSAD(pos, finalVector + offsets[i], texSize);
+            if (subSAD < minSubSAD)
+            {
+                minSubSAD = subSAD;
+                bestSub = finalVector + offsets[i];
+            }
+        }
+        finalVector = bestSub;
+    }
+
+    OutputMotion[pos] = finalVector;
+}
+
+[numthreads(TILE, TILE, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    MatchTile(int2(groupId.xy) * TILE, groupThreadId.xy, groupIndex);
+}
+
+// [Hybrid Flow] One group per listed tile, dispatched indirectly with the count CS_FlowSelect wrote
+[numthreads(TILE, TILE, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint tile = TileList[groupId.x];
+    MatchTile(int2(tile & 0xFFFF, tile >> 16) * TILE, groupThreadId.xy, groupIndex);
+}
@@ -0,0 +1,116 @@
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1); // Unused (kept so bindings match CS_Interpolate)
+Texture2D<float2> TexMotion : register(t2);
+Texture2D<float> TexMask : register(t3);
+StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
+StructuredBuffer<uint> TileList : register(t6); // [Tile Skip] CSTiles: TileClassifier's list, dynamic tiles first
+
+RWTexture2D<float4> OutputFrame : register(u0);
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer Settings : register(b0)
+{
+    float Factor; // Prediction distance past the current frame (0.0 - 1.0 of a real frame interval)
+    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
+    float GhostingStrength;
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int UseVisibility; // Unused (CS_Interpolate layout)
+    float VisibilityScale;
+    float2 FlowScale; // [Native Synthesis] Output pixels per flow pixel, TexMotion is at flow resolution
+}
+
+// Vector disagreement (pixels) above which the pixel is treated as a disocclusion
+#define HOLE_TOLERANCE 1.0f
+
+void Synthesize(uint2 pos)
+{
+    // [Scene Change Safety]
+    if (GlobalStats[0] > (uint)SceneChangeThreshold)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+
+    float mask = TexMask[pos];
+    if (mask > 0.5f)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    float2 texSize = float2(w, h);
+    float2 uv = (float2(pos) + 0.5f) / texSize;
+
+    // Block fields are sampled bilinearly, each vector sits at its block center
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 motionScale = texSize / (MotionBlockSize * FlowScale * float2(mw, mh)); // Frame UV -> Motion UV
+
+    // Motion points from frame N back to frame N-1, so content at 'pos' in frame N+Factor
+    // was at 'pos + motion * Factor' in frame N.
+    float2 motion = TexMotion.SampleLevel(LinearSampler, uv * motionScale, 0) * FlowScale;
+    float2 srcUV = uv + (motion / texSize) * Factor;
+
+    // [Hole Filling]
+    // If the vector at the source disagrees with ours, 'pos' is being uncovered (or covered).
+    // The revealed content belongs to the background, which is the slower of the two vectors.
+    float2 srcMotion = TexMotion.SampleLevel(LinearSampler, srcUV * motionScale, 0) * FlowScale;
+    if (length(srcMotion - motion) > HOLE_TOLERANCE)
+    {
+        if (dot(srcMotion, srcMotion) < dot(motion, motion)) motion = srcMotion;
+        srcUV = uv + (motion / texSize) * Factor;
+    }
+
+    float4 result;
+    if (any(srcUV < 0.0f) || any(srcUV > 1.0f))
+    {
+        // Nothing to pull from outside the frame, hold the real pixel
+        result = TexCurrent[pos];
+    }
+    else
+    {
+        result = TexCurrent.SampleLevel(LinearSampler, srcUV, 0);
+    }
+
+    // [Ghosting Reduction]
+    if (GhostingStrength > 0.0f)
+    {
+        // 5-tap neighborhood (Center + Plus)
+        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
+        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
+        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
+        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
+        float4 wv = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
+
+        float4 minColor = min(c, min(n, min(s, min(e, wv))));
+        float4 maxColor = max(c, max(n, max(s, max(e, wv))));
+
+        float4 clamped = clamp(result, minColor, maxColor);
+        result = lerp(result, clamped, GhostingStrength);
+    }
+
+    OutputFrame[pos] = result;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    Synthesize(dispatchThreadId.xy);
+}
+
+// [Tile Skip] Indirect, one 16x16 group per dynamic tile (packed y << 16 | x)
+[numthreads(16, 16, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    uint2 pos = uint2(tile & 0xFFFF, tile >> 16) * 16 + groupThreadId.xy;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    Synthesize(pos);
+}
@@ -0,0 +1,121 @@
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t2);
+Texture2D<uint> InputSplat : register(t3); // CS_FlowSplat claims
+RWTexture2D<float2> OutputBackward : register(u0); // Previous -> Current
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int RefineRadius; // Re-search window around the filled guess
+    float CostTolerance; // Claim cost (avg 3x3 luma abs diff) above which the claim is re-searched
+};
+
+// [Flow Inversion] Pass 2: the backward vector of a claimed pixel is minus the forward vector of its claimant.
+// Empty pixels (covered in the current frame, or stretched apart) take the slowest claimed neighbour, the
+// background. Only those and poorly matched claims run a small search, everything else is two fetches.
+
+#define EMPTY 0xFFFFFFFFu
+#define OFFSET_BIAS 2048
+#define HOLE_RADIUS 16
+
+// Backward vector implied by the claim at 'pos' (false if unclaimed)
+bool ClaimedVector(int2 pos, out float2 v, out float cost)
+{
+    uint packed = InputSplat[pos];
+    v = float2(0, 0);
+    cost = 1.0f;
+    if (packed == EMPTY) return false;
+
+    int2 offset = int2((packed >> 12) & 0xFFF, packed & 0xFFF) - OFFSET_BIAS;
+    v = -FwdFlow[pos + offset];
+    cost = (float)(packed >> 24) / 255.0f;
+    return true;
+}
+
+// 3x3 SAD of the previous frame at 'pos' against the current frame displaced by 'v'
+float WindowSAD(int2 pos, float2 v, float2 texSize)
+{
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 p = clamp(pos + int2(x, y), int2(0, 0), maxPos);
+            float2 uv = (float2(p) + 0.5f + v) / texSize;
+            sad += abs(TexPrev[p] - TexCurrent.SampleLevel(LinearSampler, uv, 0));
+        }
+    }
+    return sad;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= Width || pos.y >= Height) return;
+
+    float2 guess;
+    float cost;
+    bool claimed = ClaimedVector(pos, guess, cost);
+    if (claimed && cost <= CostTolerance)
+    {
+        OutputBackward[pos] = guess;
+        return;
+    }
+
+    // [Hole Filling] Unclaimed: nearest claim along 8 directions (stepping 1, 2, 4 ...), slowest one wins.
+    // A poor claim keeps its own vector as the guess.
+    if (!claimed)
+    {
+        const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+        float bestLengthSq = 1e9f;
+        for (int d = 0; d < 8; ++d)
+        {
+            for (int r = 1; r <= HOLE_RADIUS; r *= 2)
+            {
+                int2 p = pos + dirs[d] * r;
+                if (any(p < 0) || p.x >= Width || p.y >= Height) break;
+
+                float2 v;
+                float c;
+                if (!ClaimedVector(p, v, c)) continue;
+                if (dot(v, v) < bestLengthSq)
+                {
+                    bestLengthSq = dot(v, v);
+                    guess = v;
+                }
+                break;
+            }
+        }
+    }
+
+    // [Re-Search] Small window around the guess, the guess wins ties
+    float2 texSize = float2(Width, Height);
+    float2 bestVector = guess;
+    float minSAD = WindowSAD(pos, guess, texSize);
+
+    [loop]
+    for (int dy = -RefineRadius; dy <= RefineRadius; ++dy)
+    {
+        [loop]
+        for (int dx = -RefineRadius; dx <= RefineRadius; ++dx)
+        {
+            if (dx == 0 && dy == 0) continue;
+
+            float2 candidate = guess + float2(dx, dy);
+            float sad = WindowSAD(pos, candidate, texSize);
+            if (sad < minSAD)
+            {
+                minSAD = sad;
+                bestVector = candidate;
+            }
+        }
+    }
+
+    OutputBackward[pos] = bestVector;
+}
@@ -0,0 +1,102 @@
+Texture2D<float> TexCurrent : register(t0); // CSStats: [Luma Pyramid] level 0
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> InputMotion : register(t2); // CSStats: this frame's refined motion
+Texture2D<float> InputVariance : register(t3); // CSSelect: CS_AdaptiveVariance grid of the current frame
+Texture2D<float2> InputStats : register(t4); // CSSelect: last frame's CSStats
+RWTexture2D<float2> OutputStats : register(u0); // CSStats: (residual, motion spread) per tile
+RWTexture2D<uint> TileAlgorithm : register(u0); // CSSelect: FlowAlgorithm per tile, last frame's choice on entry
+RWStructuredBuffer<uint> TileLists : register(u1); // CSSelect: MaxTiles packed tiles (x | y << 16) per algorithm
+RWBuffer<uint> TileArgs : register(u2); // CSSelect: DispatchIndirect arguments (count, 1, 1) per algorithm
+
+cbuffer CB : register(b0)
+{
+    int TilesX;
+    int TilesY;
+    int MaxTiles;
+    int UseStats; // InputStats and TileAlgorithm hold last frame's tiles
+    float FlatVariance;
+    float LowResidual;
+    float HighResidual;
+    float MaxSpread;
+};
+
+// [Hybrid Flow] Per-tile choice between the full resolution refinements: Farneback (one 5x5 solve), BlockMatching
+// (a search, early exits on a good guess) and DIS (up to four 8x8 iterations). Flat tiles take Farneback, there is
+// nothing to search or iterate on. Otherwise last frame's outcome decides: a motion boundary (large spread) needs the
+// search, a small residual is fine with Farneback, a large one on smooth motion goes to DIS, anything in between
+// keeps DIS once it got there so the tile does not flip every frame. Port: CPUOpticalFlow::SelectTiles / MeasureTiles.
+
+#define TILE 16 // FlowTuning::FlowTileSize, the variance grid's block
+#define ALGO_BLOCK_MATCHING 0 // FlowAlgorithm values
+#define ALGO_FARNEBACK 1
+#define ALGO_DIS 2
+
+float PrevBilinear(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = TexPrev[clamp(p, int2(0, 0), maxPos)];
+    float b = TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float c = TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float d = TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// One thread per tile: mean warp residual of the refined motion and the spread of its vectors, every other pixel
+[numthreads(8, 8, 1)]
+void CSStats(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+
+    float residual = 0.0f;
+    float2 sum = float2(0.0f, 0.0f);
+    float sumSq = 0.0f;
+    for (int y = 0; y < TILE; y += 2)
+    {
+        for (int x = 0; x < TILE; x += 2)
+        {
+            int2 p = min(int2(id.xy) * TILE + int2(x, y), maxPos);
+            float2 v = InputMotion[p];
+            residual += abs(TexCurrent[p] - PrevBilinear(float2(p) + v, maxPos));
+            sum += v;
+            sumSq += dot(v, v);
+        }
+    }
+
+    const float count = (TILE / 2) * (TILE / 2);
+    float2 mean = sum / count;
+    float spread = sqrt(max(sumSq / count - dot(mean, mean), 0.0f));
+    OutputStats[id.xy] = float2(residual / count, spread);
+}
+
+// One thread per tile: pick the algorithm and append the tile to its list
+[numthreads(8, 8, 1)]
+void CSSelect(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    uint algo = ALGO_BLOCK_MATCHING; // Nothing known yet: the plain search
+    if (InputVariance[id.xy] < FlatVariance)
+    {
+        algo = ALGO_FARNEBACK;
+    }
+    else if (UseStats)
+    {
+        float2 stats = InputStats[id.xy];
+        uint last = TileAlgorithm[id.xy];
+        if (stats.y > MaxSpread) algo = ALGO_BLOCK_MATCHING;
+        else if (stats.x > HighResidual) algo = ALGO_DIS;
+        else if (stats.x < LowResidual) algo = ALGO_FARNEBACK;
+        else algo = last == ALGO_DIS ? ALGO_DIS : ALGO_FARNEBACK;
+    }
+    TileAlgorithm[id.xy] = algo;
+
+    uint index;
+    InterlockedAdd(TileArgs[algo * 3], 1, index);
+    TileLists[algo * MaxTiles + index] = id.x | (id.y << 16);
+}
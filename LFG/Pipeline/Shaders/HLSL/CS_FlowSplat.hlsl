@@ -0,0 +1,47 @@
+Texture2D<float2> FwdFlow : register(t0); // Current -> Previous
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t2);
+RWTexture2D<uint> OutputSplat : register(u0); // Cleared to 0xFFFFFFFF (empty)
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int RefineRadius;
+    float CostTolerance;
+};
+
+// [Flow Inversion] Pass 1: every pixel of the current frame claims the previous-frame pixel its vector lands on.
+// Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12) and resolved with InterlockedMin, so when several
+// pixels land on the same target (occlusion) the best photometric match wins. The offset points back to the
+// claiming pixel, CS_FlowInvert reads its exact (sub-pixel) vector from there.
+
+#define OFFSET_BIAS 2048 // 12-bit signed offsets, +-2047 pixels
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= Width || pos.y >= Height) return;
+
+    float2 v = FwdFlow[pos];
+    int2 target = int2(round(float2(pos) + v));
+    if (any(target < 0) || target.x >= Width || target.y >= Height) return; // Leaves the frame
+    if (any(abs(pos - target) >= OFFSET_BIAS)) return; // Not representable
+
+    // 3x3 window: a single pixel matches too easily for the claim to vouch for the vector
+    int2 maxPos = int2(Width - 1, Height - 1);
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            sad += abs(TexCurrent[clamp(pos + int2(x, y), int2(0, 0), maxPos)] - TexPrev[clamp(target + int2(x, y), int2(0, 0), maxPos)]);
+        }
+    }
+    uint cost = (uint)(saturate(sad / 9.0f) * 255.0f + 0.5f);
+
+    int2 offset = pos - target + OFFSET_BIAS;
+    uint packed = (cost << 24) | ((uint)offset.x << 12) | (uint)offset.y;
+    InterlockedMin(OutputSplat[target], packed);
+}
@@ -0,0 +1,116 @@
+Texture2D<float4> TexFrame : register(t0); // Captured frame, capture resolution
+StructuredBuffer<uint> PrevHashes : register(t1); // Last frame's tile hashes
+Texture2D<float> FrameUnchanged : register(t2); // CSMapTiles: TileUnchanged of this frame
+
+RWStructuredBuffer<uint> Hashes : register(u0); // One per 16x16 tile, row major
+RWTexture2D<float> TileUnchanged : register(u1); // R8_UNORM tile grid, 1 = same hash as last frame
+RWStructuredBuffer<uint> HashStats : register(u2); // Cleared to 0 every frame, layout below
+RWTexture2D<float> FlowUnchanged : register(u3); // CSMapTiles: R8_UNORM grid of 16x16 flow resolution tiles
+
+cbuffer CB : register(b0)
+{
+    int HasHistory; // PrevHashes belongs to a frame of the same size
+    int Padding;
+    float2 FrameScale; // CSMapTiles: capture pixels per flow pixel
+};
+
+// [Tile Hash] xxHash32 rounds over the raw texel bits. Every texel is seeded with its position in the tile,
+// so the lanes can be summed in any order and a moved texel still changes the hash.
+// Matching tiles are unchanged: the searches write zero motion there, a frame without a changed tile is a duplicate.
+// The frame is hashed at capture resolution: a downscaled one (Nearest in particular) can hide a change between
+// the texels it samples. CSMapTiles carries the verdict over to the tiles of a scaled flow.
+
+#define TILE_SIZE 16
+
+#define CHANGED_TILES 0 // Tiles whose hash differs from last frame
+#define HAS_HISTORY 1 // 0 = nothing to compare against. Read by CS_SceneCut: history and no changed tile = duplicate
+
+#define FILTER_REACH 4 // Capture pixels CS_Upscale reads around a sample (Lanczos Radius up to 4)
+
+#define PRIME32_1 2654435761u
+#define PRIME32_2 2246822519u
+#define PRIME32_3 3266489917u
+#define PRIME32_4 668265263u
+#define PRIME32_5 374761393u
+
+groupshared uint gs_Hash;
+
+uint RotateLeft(uint x, uint r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+uint Round(uint acc, uint input)
+{
+    return RotateLeft(acc + input * PRIME32_2, 13) * PRIME32_1;
+}
+
+uint Avalanche(uint h)
+{
+    h ^= h >> 15;
+    h *= PRIME32_2;
+    h ^= h >> 13;
+    h *= PRIME32_3;
+    h ^= h >> 16;
+    return h;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSHash(uint3 groupId : SV_GroupID, uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0) gs_Hash = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    // No early return: every thread has to reach the barriers
+    uint w, h;
+    TexFrame.GetDimensions(w, h);
+    if (dispatchThreadId.x < w && dispatchThreadId.y < h)
+    {
+        uint4 bits = asuint(TexFrame[dispatchThreadId.xy]);
+        uint lane = PRIME32_5 + groupIndex * PRIME32_4;
+        lane = Round(lane, bits.r);
+        lane = Round(lane, bits.g);
+        lane = Round(lane, bits.b);
+        lane = Round(lane, bits.a);
+        InterlockedAdd(gs_Hash, Avalanche(lane));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint tilesX = (w + TILE_SIZE - 1) / TILE_SIZE;
+        uint tile = groupId.y * tilesX + groupId.x;
+        uint hash = Avalanche(gs_Hash);
+
+        bool unchanged = HasHistory && PrevHashes[tile] == hash;
+        Hashes[tile] = hash;
+        TileUnchanged[groupId.xy] = unchanged ? 1.0f : 0.0f;
+        if (!unchanged) InterlockedAdd(HashStats[CHANGED_TILES], 1);
+
+        if (groupId.x == 0 && groupId.y == 0) HashStats[HAS_HISTORY] = HasHistory ? 1 : 0;
+    }
+}
+
+// One thread per flow tile: unchanged only if every capture tile its texels sample from is
+[numthreads(8, 8, 1)]
+void CSMapTiles(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint fw, fh;
+    FlowUnchanged.GetDimensions(fw, fh);
+    if (dispatchThreadId.x >= fw || dispatchThreadId.y >= fh) return;
+
+    uint tw, th;
+    FrameUnchanged.GetDimensions(tw, th);
+    float2 lo = float2(dispatchThreadId.xy * TILE_SIZE) * FrameScale - FILTER_REACH;
+    float2 hi = float2((dispatchThreadId.xy + 1) * TILE_SIZE) * FrameScale + FILTER_REACH;
+    int2 first = max(int2(floor(lo / TILE_SIZE)), 0);
+    int2 last = min(int2(floor(hi / TILE_SIZE)), int2(tw, th) - 1);
+
+    float unchanged = 1.0f;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+            unchanged = min(unchanged, FrameUnchanged[int2(x, y)]);
+    }
+    FlowUnchanged[dispatchThreadId.xy] = unchanged;
+}
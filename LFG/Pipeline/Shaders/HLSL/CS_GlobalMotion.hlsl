@@ -0,0 +1,88 @@
+Texture2D<float2> InputMotion : register(t0); // CSGather: final motion (flow resolution)
+Texture2D<float> LumaCurrent : register(t1); // CSThumbnail: [Luma Pyramid] coarsest level
+Texture2D<float> LumaPrev : register(t2);
+RWStructuredBuffer<float> Readback : register(u0); // CSGather / CSThumbnail, layout below
+RWTexture2D<float2> OutputMotion : register(u0); // CSSeed: initial guess at a pyramid level
+
+cbuffer CB : register(b0)
+{
+    float4 Row0; // CSSeed: current -> previous position in flow pixels (homography rows)
+    float4 Row1;
+    float4 Row2;
+    float LevelScale; // CSSeed: flow pixels per output pixel
+    int SampleGrid; // Must match GlobalMotion::SampleGrid
+    int ThumbnailSize; // Must match GlobalMotion::ThumbnailSize
+    float Padding;
+};
+
+// [Global Motion] One readback per frame, fixed size whatever the resolution:
+// [0, 4 * SampleGrid^2)  (x, y, u, v) per sample, GlobalMotion::Sample
+// then ThumbnailSize^2   current luma thumbnail (phase correlation fallback)
+// then ThumbnailSize^2   previous luma thumbnail
+
+// A SampleGrid x SampleGrid grid of vectors over the whole field, fitted on the CPU one frame later
+[numthreads(8, 8, 1)]
+void CSGather(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 cell = dispatchThreadId.xy;
+    if (cell.x >= (uint)SampleGrid || cell.y >= (uint)SampleGrid) return;
+
+    uint w, h;
+    InputMotion.GetDimensions(w, h);
+    uint2 pos = min(uint2((float2(cell) + 0.5f) * float2(w, h) / SampleGrid), uint2(w, h) - 1);
+    float2 motion = InputMotion[pos];
+
+    uint index = (cell.y * SampleGrid + cell.x) * 4;
+    Readback[index + 0] = pos.x;
+    Readback[index + 1] = pos.y;
+    Readback[index + 2] = motion.x;
+    Readback[index + 3] = motion.y;
+}
+
+// Box average of each thumbnail texel's footprint, both frames
+[numthreads(8, 8, 1)]
+void CSThumbnail(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 cell = dispatchThreadId.xy;
+    if (cell.x >= (uint)ThumbnailSize || cell.y >= (uint)ThumbnailSize) return;
+
+    uint w, h;
+    LumaCurrent.GetDimensions(w, h);
+    uint2 begin = cell * uint2(w, h) / ThumbnailSize;
+    uint2 end = max((cell + 1) * uint2(w, h) / ThumbnailSize, begin + 1);
+    end = min(end, uint2(w, h));
+
+    float current = 0.0f;
+    float prev = 0.0f;
+    for (uint y = begin.y; y < end.y; ++y)
+    {
+        for (uint x = begin.x; x < end.x; ++x)
+        {
+            current += LumaCurrent[uint2(x, y)];
+            prev += LumaPrev[uint2(x, y)];
+        }
+    }
+    float count = (float)((end.x - begin.x) * (end.y - begin.y));
+
+    uint offset = SampleGrid * SampleGrid * 4;
+    uint index = cell.y * ThumbnailSize + cell.x;
+    Readback[offset + index] = current / count;
+    Readback[offset + ThumbnailSize * ThumbnailSize + index] = prev / count;
+}
+
+// The fitted model as every pixel's initial guess, at the level of OutputMotion
+[numthreads(8, 8, 1)]
+void CSSeed(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputMotion.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    // Texel centers, level -> flow pixels and back
+    float3 p = float3((float2(pos) + 0.5f) * LevelScale - 0.5f, 1.0f);
+    float3 q = float3(dot(Row0.xyz, p), dot(Row1.xyz, p), dot(Row2.xyz, p));
+    float2 matched = q.xy / (abs(q.z) > 1e-6f ? q.z : 1e-6f);
+
+    OutputMotion[pos] = (matched - p.xy) / LevelScale;
+}
@@ -1,72 +1,129 @@
-Texture2D<float4> TexCurrent : register(t0);
-Texture2D<float4> TexPrev : register(t1);
-Texture2D<float2> TexMotion : register(t2);
-Texture2D<float> TexMask : register(t3);
-StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
-
-RWTexture2D<float4> OutputFrame : register(u0);
-
-SamplerState LinearSampler : register(s0);
-
-cbuffer Settings : register(b0)
-{
-    float Factor; // Interpolation factor (0.0 - 1.0)
-    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
-    float GhostingStrength;
-    float Padding;
-}
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    uint2 pos = dispatchThreadId.xy;
-    
-    // [Scene Change Safety]
-    if (GlobalStats[0] > (uint)SceneChangeThreshold)
-    {
-        OutputFrame[pos] = TexCurrent[pos];
-        return;
-    }
-    
-    float mask = TexMask[pos];
-    if (mask > 0.5f)
-    {
-        OutputFrame[pos] = TexCurrent[pos];
-        return;
-    }
-    
-    // Fetch Motion Vector (in pixels)
-    float2 motion = TexMotion[pos];
-    
-    uint w, h;
-    TexCurrent.GetDimensions(w, h);
-    float2 texSize = float2(w, h);
-    float2 uv = (float2(pos) + 0.5f) / texSize;
-    float2 motionUV = motion / texSize;
-    
-    // Interpolate
-    float4 pixelPrev = TexPrev.SampleLevel(LinearSampler, uv + motionUV * Factor, 0);
-    float4 pixelCurr = TexCurrent.SampleLevel(LinearSampler, uv - motionUV * (1.0f - Factor), 0);
-    
-    float4 result = lerp(pixelPrev, pixelCurr, Factor);
-
-    // [Ghosting Reduction]
-    // Clamp result to the neighborhood of the Current frame at the target location.
-    if (GhostingStrength > 0.0f)
-    {
-        // 5-tap neighborhood (Center + Plus)
-        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
-        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
-        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
-        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
-        float4 w = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
-        
-        float4 minColor = min(c, min(n, min(s, min(e, w))));
-        float4 maxColor = max(c, max(n, max(s, max(e, w))));
-        
-        float4 clamped = clamp(result, minColor, maxColor);
-        result = lerp(result, clamped, GhostingStrength);
-    }
-
-    OutputFrame[pos] = result;
-}
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1);
+Texture2D<float2> TexMotion : register(t2);
+Texture2D<float> TexMask : register(t3);
+StructuredBuffer<uint> GlobalStats : register(t4); // [Scene Change Stats]
+Texture2D<float2> TexVisibility : register(t5); // [Occlusion] x: current pixel seen in prev, y: prev pixel seen in current
+StructuredBuffer<uint> TileList : register(t6); // [Tile Skip] CSTiles: TileClassifier's list, dynamic tiles first
+
+RWTexture2D<float4> OutputFrame : register(u0);
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer Settings : register(b0)
+{
+    float Factor; // Interpolation factor (0.0 - 1.0)
+    int SceneChangeThreshold; // If GlobalStats[0] > Threshold, SKIP
+    float GhostingStrength;
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int UseVisibility;
+    float VisibilityScale; // One visibility texel per NxN pixels
+    float2 FlowScale; // [Native Synthesis] Output pixels per flow pixel, TexMotion / TexVisibility are at flow resolution
+}
+
+// Visibility above which both sources are trusted and the Ghosting clamp is skipped
+#define CONSISTENT_LEVEL 0.99f
+
+void Synthesize(uint2 pos)
+{
+    // [Scene Change Safety]
+    if (GlobalStats[0] > (uint)SceneChangeThreshold)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+    
+    float mask = TexMask[pos];
+    if (mask > 0.5f)
+    {
+        OutputFrame[pos] = TexCurrent[pos];
+        return;
+    }
+    
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    float2 texSize = float2(w, h);
+
+    // Fetch Motion Vector (in pixels)
+    // Block fields are sampled bilinearly, each vector sits at its block center.
+    // [Native Synthesis] A low-res field is sampled the same way, its vectors scaled to output pixels.
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 motion = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * FlowScale * float2(mw, mh)), 0) * FlowScale;
+    
+    float2 uv = (float2(pos) + 0.5f) / texSize;
+    float2 motionUV = motion / texSize;
+    
+    // Interpolate
+    float2 uvPrev = uv + motionUV * Factor;
+    float2 uvCurr = uv - motionUV * (1.0f - Factor);
+    float4 pixelPrev = TexPrev.SampleLevel(LinearSampler, uvPrev, 0);
+    float4 pixelCurr = TexCurrent.SampleLevel(LinearSampler, uvCurr, 0);
+    
+    float4 result = lerp(pixelPrev, pixelCurr, Factor);
+
+    // [Occlusion]
+    // Content of the current frame with no match in the previous one (uncovered) makes the previous sample wrong,
+    // and previous content that is covered in the current frame makes the current sample wrong: drop that source.
+    float consistency = 0.0f; // Unknown without a visibility map, always clamp
+    if (UseVisibility)
+    {
+        uint vw, vh;
+        TexVisibility.GetDimensions(vw, vh);
+        float2 visibilityScale = texSize / (VisibilityScale * FlowScale * float2(vw, vh)); // Frame UV -> Visibility UV
+
+        float currVisible = TexVisibility.SampleLevel(LinearSampler, uvCurr * visibilityScale, 0).x;
+        float prevVisible = TexVisibility.SampleLevel(LinearSampler, uvPrev * visibilityScale, 0).y;
+
+        float weightPrev = (1.0f - Factor) * currVisible;
+        float weightCurr = Factor * prevVisible;
+        float weightSum = weightPrev + weightCurr;
+        if (weightSum > 1e-3f)
+        {
+            result = (pixelPrev * weightPrev + pixelCurr * weightCurr) / weightSum;
+        }
+
+        consistency = min(currVisible, prevVisible);
+    }
+
+    // [Ghosting Reduction]
+    // Clamp result to the neighborhood of the Current frame at the target location.
+    // Not needed where both flows agree.
+    if (GhostingStrength > 0.0f && consistency < CONSISTENT_LEVEL)
+    {
+        // 5-tap neighborhood (Center + Plus)
+        float4 c = TexCurrent.SampleLevel(LinearSampler, uv, 0);
+        float4 n = TexCurrent.SampleLevel(LinearSampler, uv + float2(0, 1) / texSize, 0);
+        float4 s = TexCurrent.SampleLevel(LinearSampler, uv - float2(0, 1) / texSize, 0);
+        float4 e = TexCurrent.SampleLevel(LinearSampler, uv + float2(1, 0) / texSize, 0);
+        float4 w = TexCurrent.SampleLevel(LinearSampler, uv - float2(1, 0) / texSize, 0);
+        
+        float4 minColor = min(c, min(n, min(s, min(e, w))));
+        float4 maxColor = max(c, max(n, max(s, max(e, w))));
+        
+        float4 clamped = clamp(result, minColor, maxColor);
+        result = lerp(result, clamped, GhostingStrength);
+    }
+
+    OutputFrame[pos] = result;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    Synthesize(dispatchThreadId.xy);
+}
+
+// [Tile Skip] Indirect, one 16x16 group per dynamic tile (packed y << 16 | x)
+[numthreads(16, 16, 1)]
+void CSTiles(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint tile = TileList[groupId.x];
+    uint2 pos = uint2(tile & 0xFFFF, tile >> 16) * 16 + groupThreadId.xy;
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    Synthesize(pos);
+}
@@ -0,0 +1,39 @@
+Texture2D<float4> InputColor : register(t0); // CSLuma: captured frame (flow resolution)
+Texture2D<float> InputLuma : register(t0); // CSDownsample: finer pyramid level
+RWTexture2D<float> Output : register(u0); // R8_UNORM, or R16_FLOAT for HDR swapchains
+
+// [Luma Pyramid] The one luminance definition every analysis pass works on (flow, variance, edges, splat cost).
+// Built once per real frame, the previous frame's pyramid is kept and reused as 'prev'.
+
+static const float3 LumaWeights = float3(0.2126f, 0.7152f, 0.0722f); // Rec. 709
+
+[numthreads(8, 8, 1)]
+void CSLuma(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    Output.GetDimensions(w, h);
+    if (dispatchThreadId.x >= w || dispatchThreadId.y >= h) return;
+
+    Output[dispatchThreadId.xy] = dot(InputColor[dispatchThreadId.xy].rgb, LumaWeights);
+}
+
+[numthreads(8, 8, 1)]
+void CSDownsample(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    Output.GetDimensions(w, h);
+    if (dispatchThreadId.x >= w || dispatchThreadId.y >= h) return;
+
+    // 2x2 box filter, clamped so odd sizes don't read past the edge
+    uint sw, sh;
+    InputLuma.GetDimensions(sw, sh);
+    uint2 maxPos = uint2(sw - 1, sh - 1);
+    uint2 srcPos = dispatchThreadId.xy * 2;
+
+    float l0 = InputLuma[min(srcPos + uint2(0, 0), maxPos)];
+    float l1 = InputLuma[min(srcPos + uint2(1, 0), maxPos)];
+    float l2 = InputLuma[min(srcPos + uint2(0, 1), maxPos)];
+    float l3 = InputLuma[min(srcPos + uint2(1, 1), maxPos)];
+
+    Output[dispatchThreadId.xy] = (l0 + l1 + l2 + l3) * 0.25f;
+}
@@ -0,0 +1,28 @@
+Texture2D<float2> InputField : register(t0); // One vector per block
+RWTexture2D<float2> OutputMotion : register(u0); // One vector per pixel
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int BlockSize;
+    int3 Padding;
+};
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputMotion.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    uint bw, bh;
+    InputField.GetDimensions(bw, bh);
+
+    // Block vectors sit at block centers and are already in pixels (no scaling)
+    float2 blockCoord = (float2(pos) + 0.5f) / BlockSize;
+    float2 uv = blockCoord / float2(bw, bh);
+
+    OutputMotion[pos] = InputField.SampleLevel(LinearSampler, uv, 0);
+}
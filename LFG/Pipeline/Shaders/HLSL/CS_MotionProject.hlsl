@@ -0,0 +1,47 @@
+Texture2D<float2> MotionHistory : register(t0); // Last frame's final motion (flow resolution)
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] Current frame at the output level
+Texture2D<float> TexPrev : register(t2); // Previous frame at the output level
+RWTexture2D<float2> OutputPredicted : register(u0);
+RWStructuredBuffer<uint> WarmStartStats : register(u1); // [0] = Pixels with a poor prediction (optional)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float ResidualTolerance; // Luma abs diff above which the prediction counts as poor
+    float3 Padding;
+};
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint2 pos = dispatchThreadId.xy;
+    uint w, h;
+    OutputPredicted.GetDimensions(w, h);
+    if (pos.x >= w || pos.y >= h) return;
+
+    uint hw, hh;
+    MotionHistory.GetDimensions(hw, hh);
+    float2 histSize = float2(hw, hh);
+    float2 outSize = float2(w, h);
+
+    // Output may be a coarser pyramid level than the history, vectors shrink with it
+    float2 levelScale = outSize / histSize;
+    float2 uv = (float2(pos) + 0.5f) / outSize;
+
+    // Forward projection under constant velocity:
+    // Content at q in frame N was at q + v in frame N-1, where last frame's field stored the same v.
+    // One fixed-point step solves v = V(q + v) without a scatter pass.
+    float2 v0 = MotionHistory.SampleLevel(LinearSampler, uv, 0);
+    float2 v = MotionHistory.SampleLevel(LinearSampler, uv + v0 / histSize, 0);
+    float2 predicted = v * levelScale;
+
+    OutputPredicted[pos] = predicted;
+
+    // [Residual] How well does the prediction explain this frame?
+    float matched = TexPrev.SampleLevel(LinearSampler, uv + predicted / outSize, 0);
+    if (abs(TexCurrent[pos] - matched) > ResidualTolerance)
+    {
+        InterlockedAdd(WarmStartStats[0], 1);
+    }
+}
@@ -0,0 +1,81 @@
+Texture2D<float2> TexMotion : register(t0); // Current -> Previous, per pixel or one vector per NxN block
+Texture2D<uint> InputSplat : register(t1); // CS_MotionSplat claims
+RWTexture2D<float2> OutputMotion : register(u0); // Per-pixel motion valid at time 'Factor'
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float Factor;
+    float MotionBlockSize;
+    int UseVisibility;
+    float VisibilityScale;
+};
+
+// [Forward Warp] Pass 2: a claimed pixel takes the vector of its claimant, which is the motion of the content
+// actually sitting there at time 'Factor'. Unclaimed pixels are being uncovered (or stretched apart) and take
+// the slowest claim around them, the background (same rule as CS_FlowInvert / CS_Extrapolate).
+
+#define EMPTY 0xFFFFFFFFu
+#define OFFSET_BIAS 2048
+#define HOLE_RADIUS 16
+
+float2 SourceMotion(int2 pos)
+{
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    return TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * float2(mw, mh)), 0);
+}
+
+bool ClaimedVector(int2 pos, out float2 v)
+{
+    uint packed = InputSplat[pos];
+    v = float2(0, 0);
+    if (packed == EMPTY) return false;
+
+    int2 offset = int2((packed >> 12) & 0xFFF, packed & 0xFFF) - OFFSET_BIAS;
+    v = SourceMotion(pos + offset);
+    return true;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    InputSplat.GetDimensions(w, h);
+    int2 size = int2(w, h);
+
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= size.x || pos.y >= size.y) return;
+
+    float2 v;
+    if (ClaimedVector(pos, v))
+    {
+        OutputMotion[pos] = v;
+        return;
+    }
+
+    // [Hole Filling] Nearest claim along 8 directions (stepping 1, 2, 4 ...), slowest one wins.
+    // Nothing claimed around: keep the backward-lookup vector.
+    const int2 dirs[8] = { int2(1, 0), int2(-1, 0), int2(0, 1), int2(0, -1), int2(1, 1), int2(-1, 1), int2(1, -1), int2(-1, -1) };
+    float2 best = SourceMotion(pos);
+    float bestLengthSq = 1e9f;
+    for (int d = 0; d < 8; ++d)
+    {
+        for (int r = 1; r <= HOLE_RADIUS; r *= 2)
+        {
+            int2 p = pos + dirs[d] * r;
+            if (any(p < 0) || p.x >= size.x || p.y >= size.y) break;
+            if (!ClaimedVector(p, v)) continue;
+
+            if (dot(v, v) < bestLengthSq)
+            {
+                bestLengthSq = dot(v, v);
+                best = v;
+            }
+            break;
+        }
+    }
+
+    OutputMotion[pos] = best;
+}
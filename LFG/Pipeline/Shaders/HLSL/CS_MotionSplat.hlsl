@@ -0,0 +1,68 @@
+Texture2D<float2> TexMotion : register(t0); // Current -> Previous, per pixel or one vector per NxN block
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] Flow resolution
+Texture2D<float> TexPrev : register(t2);
+Texture2D<float2> TexVisibility : register(t3); // [Occlusion] Optional, x: current pixel seen in prev
+RWTexture2D<uint> OutputSplat : register(u0); // Cleared to 0xFFFFFFFF (empty)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float Factor; // 0 = prev, 1 = current
+    float MotionBlockSize;
+    int UseVisibility;
+    float VisibilityScale;
+};
+
+// [Forward Warp] Pass 1: every pixel of the current frame is projected to where its content sits at time 'Factor'.
+// The content at p in the current frame was at p + v in the previous one, so at time t it is at p + v * (1 - t).
+// Claims are packed as Cost(8) | OffsetX(12) | OffsetY(12) and resolved with InterlockedMin (same layout as
+// CS_FlowSplat). Without depth the priority is how much the vector can be trusted: its 3x3 match cost, plus
+// the forward/backward disagreement when a visibility map is bound. Uncovered background has no true match,
+// so the occluder in front of it wins the collision.
+
+#define OFFSET_BIAS 2048 // 12-bit signed offsets, +-2047 pixels
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 size = int2(w, h);
+
+    int2 pos = int2(dispatchThreadId.xy);
+    if (pos.x >= size.x || pos.y >= size.y) return;
+
+    uint mw, mh;
+    TexMotion.GetDimensions(mw, mh);
+    float2 v = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * float2(mw, mh)), 0);
+
+    int2 target = int2(round(float2(pos) + v * (1.0f - Factor)));
+    if (any(target < 0) || target.x >= size.x || target.y >= size.y) return; // Leaves the frame
+    if (any(abs(pos - target) >= OFFSET_BIAS)) return; // Not representable
+
+    // 3x3 window, a single pixel matches too easily to rank vectors
+    int2 match = int2(round(float2(pos) + v));
+    int2 maxPos = size - 1;
+    float sad = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            sad += abs(TexCurrent[clamp(pos + int2(x, y), int2(0, 0), maxPos)] - TexPrev[clamp(match + int2(x, y), int2(0, 0), maxPos)]);
+        }
+    }
+    float cost = sad / 9.0f;
+
+    if (UseVisibility)
+    {
+        uint vw, vh;
+        TexVisibility.GetDimensions(vw, vh);
+        cost += 1.0f - TexVisibility.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (VisibilityScale * float2(vw, vh)), 0).x;
+    }
+
+    uint quantized = (uint)(saturate(cost) * 255.0f + 0.5f);
+    int2 offset = pos - target + OFFSET_BIAS;
+    uint packed = (quantized << 24) | ((uint)offset.x << 12) | (uint)offset.y;
+    InterlockedMin(OutputSplat[target], packed);
+}
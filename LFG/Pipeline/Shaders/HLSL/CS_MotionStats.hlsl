@@ -0,0 +1,110 @@
+Texture2D<float2> InputMotion : register(t0); // Final motion at flow resolution
+Texture2D<float> TexCurrent : register(t1); // [Luma Pyramid] level 0
+Texture2D<float> TexPrev : register(t2);
+Texture2D<float> InputTileMax : register(t3); // CSTileRadius: CSTileStats' tile maxima
+RWStructuredBuffer<uint> Readback : register(u0); // CSTileStats: AdaptiveRadius readback layout, cleared per frame
+RWTexture2D<float> OutputTileMax : register(u1); // CSTileStats: longest vector per tile
+RWTexture2D<float> OutputTileRadius : register(u2); // CSTileRadius: next frame's bound per tile
+
+cbuffer CB : register(b0)
+{
+    int TilesX;
+    int TilesY;
+    float Margin;
+    float Padding;
+};
+
+// [Adaptive Radius] Motion statistics of the final field for AdaptiveRadius (read back one frame late) and the
+// per-tile bounds of next frame's coarsest search, which stay on the GPU. Port: CPUOpticalFlow::MeasureMotion.
+
+#define TILE 16 // FlowTuning::FlowTileSize
+#define HISTOGRAM_BINS 64 // AdaptiveRadius::HistogramBins
+#define READBACK_MAX 64 // AdaptiveRadius::ReadbackMax
+#define READBACK_RESIDUAL 65
+#define READBACK_TILES 66
+#define RESIDUAL_SCALE 4096.0f
+
+groupshared uint gs_Histogram[HISTOGRAM_BINS];
+groupshared float gs_Max[TILE * TILE];
+groupshared float gs_Residual[TILE * TILE];
+
+float PrevBilinear(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = TexPrev[clamp(p, int2(0, 0), maxPos)];
+    float b = TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float c = TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float d = TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// One group per tile: length histogram and residual of every pixel, the tile's maximum
+[numthreads(TILE, TILE, 1)]
+void CSTileStats(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < HISTOGRAM_BINS) gs_Histogram[groupIndex] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+    int2 pos = int2(groupId.xy) * TILE + int2(groupThreadId.xy);
+    bool inside = pos.x <= maxPos.x && pos.y <= maxPos.y;
+
+    float len = 0.0f;
+    float residual = 0.0f;
+    if (inside)
+    {
+        float2 v = InputMotion[pos];
+        len = length(v);
+        residual = abs(TexCurrent[pos] - PrevBilinear(float2(pos) + v, maxPos));
+        InterlockedAdd(gs_Histogram[min((uint)len, HISTOGRAM_BINS - 1)], 1);
+    }
+    gs_Max[groupIndex] = len;
+    gs_Residual[groupIndex] = residual;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = TILE * TILE / 2; s > 0; s >>= 1)
+    {
+        if (groupIndex < s)
+        {
+            gs_Max[groupIndex] = max(gs_Max[groupIndex], gs_Max[groupIndex + s]);
+            gs_Residual[groupIndex] += gs_Residual[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex < HISTOGRAM_BINS && gs_Histogram[groupIndex] > 0)
+        InterlockedAdd(Readback[groupIndex], gs_Histogram[groupIndex]);
+
+    if (groupIndex == 0)
+    {
+        int2 size = min(int2(TILE, TILE), maxPos + 1 - int2(groupId.xy) * TILE);
+        float meanResidual = gs_Residual[0] / (size.x * size.y);
+        OutputTileMax[groupId.xy] = gs_Max[0];
+        InterlockedMax(Readback[READBACK_MAX], asuint(gs_Max[0])); // Non-negative floats order as their bits
+        InterlockedAdd(Readback[READBACK_RESIDUAL], (uint)round(meanResidual * RESIDUAL_SCALE));
+        InterlockedAdd(Readback[READBACK_TILES], 1);
+    }
+}
+
+// One thread per tile: the longest vector around it (motion crosses into the neighbours by the next frame)
+[numthreads(8, 8, 1)]
+void CSTileRadius(uint3 id : SV_DispatchThreadID)
+{
+    if ((int)id.x >= TilesX || (int)id.y >= TilesY) return;
+
+    float longest = 0.0f;
+    for (int y = -1; y <= 1; ++y)
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            int2 t = clamp(int2(id.xy) + int2(x, y), int2(0, 0), int2(TilesX - 1, TilesY - 1));
+            longest = max(longest, InputTileMax[t]);
+        }
+    }
+    OutputTileRadius[id.xy] = ceil(longest * Margin) + Padding;
+}
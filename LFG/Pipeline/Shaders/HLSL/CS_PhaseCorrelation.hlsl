@@ -0,0 +1,233 @@
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid] PhaseCorrelation::CandidateLevel
+Texture2D<float> TexPrev : register(t1);
+RWTexture2D<float4> OutputCandidates : register(u0); // Two vectors per tile (xy strongest, zw second), level pixels
+
+// [Phase Correlation] One group per TILE x TILE tile: the N x N window centered on it is correlated against the
+// previous frame in the frequency domain, and the two strongest separate peaks become the tile's candidate
+// vectors for the coarsest search. Costs the same for a 1 pixel or a 15 pixel shift.
+// Both frames share one complex FFT (current = real part, previous = imaginary part), split again by symmetry.
+// Port: PhaseCorrelation::Correlate (CPU), constants must match PhaseCorrelation.
+
+#define N 32 // TileWindow, power of two
+#define LOG_N 5
+#define TILE 16 // TileSize
+#define MIN_PEAK 0.1f // MinTilePeak
+#define PEAK_EXCLUSION 2
+#define PI 3.14159265f
+
+groupshared float gs_Re[N * N];
+groupshared float gs_Im[N * N];
+groupshared float gs_CrossRe[N * N];
+groupshared float gs_CrossIm[N * N];
+groupshared float gs_Sum[2 * N]; // Row sums (current, previous), then row peaks
+groupshared uint gs_PeakIndex[N];
+
+// In-place radix-2 FFT of the N values 'stride' apart from 'base', inverse (sign = +1) without the 1/N scale.
+// One thread per row / column, the group transforms all N at once.
+void FFT(uint base, uint stride, float sign)
+{
+    for (uint i = 0; i < N; ++i)
+    {
+        uint j = reversebits(i) >> (32 - LOG_N);
+        if (i < j)
+        {
+            uint a = base + i * stride;
+            uint b = base + j * stride;
+            float re = gs_Re[a]; gs_Re[a] = gs_Re[b]; gs_Re[b] = re;
+            float im = gs_Im[a]; gs_Im[a] = gs_Im[b]; gs_Im[b] = im;
+        }
+    }
+
+    [loop]
+    for (uint len = 2; len <= N; len <<= 1)
+    {
+        uint half = len >> 1;
+        float angle = sign * 2.0f * PI / len;
+        for (uint start = 0; start < N; start += len)
+        {
+            for (uint k = 0; k < half; ++k)
+            {
+                float s, c;
+                sincos(angle * k, s, c);
+                uint a = base + (start + k) * stride;
+                uint b = a + half * stride;
+                float tRe = gs_Re[b] * c - gs_Im[b] * s;
+                float tIm = gs_Re[b] * s + gs_Im[b] * c;
+                gs_Re[b] = gs_Re[a] - tRe;
+                gs_Im[b] = gs_Im[a] - tIm;
+                gs_Re[a] += tRe;
+                gs_Im[a] += tIm;
+            }
+        }
+    }
+}
+
+// Rows then columns, every thread its own row and column
+void FFT2D(uint t, float sign)
+{
+    FFT(t * N, 1, sign);
+    GroupMemoryBarrierWithGroupSync();
+    FFT(t, N, sign);
+    GroupMemoryBarrierWithGroupSync();
+}
+
+float Window(uint i)
+{
+    return 0.5f - 0.5f * cos(2.0f * PI * (i + 0.5f) / N);
+}
+
+float Surface(int x, int y)
+{
+    return gs_Re[(uint)(y & (N - 1)) * N + (uint)(x & (N - 1))];
+}
+
+// Same estimator as PhaseCorrelation PeakOffset
+float PeakOffset(float l, float c, float r)
+{
+    if (r >= l && r > 0.0f) return r / (r + c);
+    if (l > 0.0f) return -l / (l + c);
+    return 0.0f;
+}
+
+// Strongest value of row t outside the exclusion square around 'exclude' (x = N: none), into gs_Sum / gs_PeakIndex
+void RowPeak(uint t, uint2 exclude)
+{
+    float best = -1e30f;
+    uint bestX = 0;
+    for (uint x = 0; x < N; ++x)
+    {
+        int dx = abs((int)x - (int)exclude.x); dx = min(dx, N - dx);
+        int dy = abs((int)t - (int)exclude.y); dy = min(dy, N - dy);
+        if (exclude.x < N && dx <= PEAK_EXCLUSION && dy <= PEAK_EXCLUSION) continue;
+
+        float v = gs_Re[t * N + x];
+        if (v > best)
+        {
+            best = v;
+            bestX = x;
+        }
+    }
+    gs_Sum[t] = best;
+    gs_PeakIndex[t] = t * N + bestX;
+}
+
+// Row with the strongest row peak, every thread gets the same answer
+uint2 BestPeak()
+{
+    uint best = 0;
+    for (uint y = 1; y < N; ++y)
+    {
+        if (gs_Sum[y] > gs_Sum[best]) best = y;
+    }
+    uint index = gs_PeakIndex[best];
+    return uint2(index % N, index / N);
+}
+
+// Shift of the peak at 'p' (current(q) = previous(q + d) puts it at -d), zero if too weak to trust
+float2 PeakVector(uint2 p)
+{
+    int2 ip = int2(p);
+    float c = Surface(ip.x, ip.y);
+    if (c / (N * N) < MIN_PEAK) return float2(0.0f, 0.0f);
+
+    float fx = ip.x + PeakOffset(Surface(ip.x - 1, ip.y), c, Surface(ip.x + 1, ip.y));
+    float fy = ip.y + PeakOffset(Surface(ip.x, ip.y - 1), c, Surface(ip.x, ip.y + 1));
+    if (fx > N / 2) fx -= N;
+    if (fy > N / 2) fy -= N;
+    return float2(-fx, -fy);
+}
+
+[numthreads(N, 1, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint t = groupThreadId.x;
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 maxPos = int2(w, h) - 1;
+
+    // The window centered on the tile, moved inside the frame at the borders (clamped texels correlate with
+    // themselves at zero motion). Still clamped per texel on levels smaller than the window.
+    int2 origin = int2(groupId.xy) * TILE + TILE / 2 - N / 2;
+    origin = max(min(origin, int2(w, h) - N), int2(0, 0));
+
+    // 1. Row t of both windows, and the row sums for the means
+    float sumCurrent = 0.0f;
+    float sumPrev = 0.0f;
+    for (uint x = 0; x < N; ++x)
+    {
+        int2 p = clamp(origin + int2(x, t), int2(0, 0), maxPos);
+        float current = TexCurrent[p];
+        float prev = TexPrev[p];
+        gs_Re[t * N + x] = current;
+        gs_Im[t * N + x] = prev;
+        sumCurrent += current;
+        sumPrev += prev;
+    }
+    gs_Sum[t] = sumCurrent;
+    gs_Sum[N + t] = sumPrev;
+    GroupMemoryBarrierWithGroupSync();
+
+    // 2. Mean removed and Hann windowed, so the window borders do not correlate with themselves
+    float meanCurrent = 0.0f;
+    float meanPrev = 0.0f;
+    for (uint r = 0; r < N; ++r)
+    {
+        meanCurrent += gs_Sum[r];
+        meanPrev += gs_Sum[N + r];
+    }
+    meanCurrent /= N * N;
+    meanPrev /= N * N;
+
+    float wy = Window(t);
+    for (uint x = 0; x < N; ++x)
+    {
+        float wxy = Window(x) * wy;
+        gs_Re[t * N + x] = (gs_Re[t * N + x] - meanCurrent) * wxy;
+        gs_Im[t * N + x] = (gs_Im[t * N + x] - meanPrev) * wxy;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    FFT2D(t, -1.0f);
+
+    // 3. Split the two spectra (C(k) = (Z(k) + Z*(-k)) / 2, P(k) = (Z(k) - Z*(-k)) / 2i) and keep the phase of C P*
+    for (uint c = 0; c < N; ++c)
+    {
+        uint i = t * N + c;
+        uint j = ((N - t) & (N - 1)) * N + ((N - c) & (N - 1));
+        float cRe = gs_Re[i] + gs_Re[j];
+        float cIm = gs_Im[i] - gs_Im[j];
+        float pRe = gs_Im[i] + gs_Im[j];
+        float pIm = gs_Re[j] - gs_Re[i];
+
+        float re = cRe * pRe + cIm * pIm;
+        float im = cIm * pRe - cRe * pIm;
+        float magnitude = sqrt(re * re + im * im);
+        bool keep = i != 0 && magnitude > 1e-12f; // DC carries no shift
+        gs_CrossRe[i] = keep ? re / magnitude : 0.0f;
+        gs_CrossIm[i] = keep ? im / magnitude : 0.0f;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint c2 = 0; c2 < N; ++c2)
+    {
+        gs_Re[t * N + c2] = gs_CrossRe[t * N + c2];
+        gs_Im[t * N + c2] = gs_CrossIm[t * N + c2];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // 4. Back to the correlation surface (real part)
+    FFT2D(t, 1.0f);
+
+    // 5. Strongest peak, then the strongest one clear of it
+    RowPeak(t, uint2(N, N));
+    GroupMemoryBarrierWithGroupSync();
+    uint2 first = BestPeak();
+    GroupMemoryBarrierWithGroupSync();
+
+    RowPeak(t, first);
+    GroupMemoryBarrierWithGroupSync();
+    if (t != 0) return;
+
+    uint2 second = BestPeak();
+    OutputCandidates[groupId.xy] = float4(PeakVector(first), PeakVector(second));
+}
@@ -0,0 +1,207 @@
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float> TexVariance : register(t2); // CS_AdaptiveVariance, one value per 16x16
+Texture2D<float2> InputParentField : register(t3); // Leaf field before this pass (parent + neighbour vectors)
+Texture2D<float2> InputHistory : register(t4); // Last frame's leaf field (temporal candidate)
+RWTexture2D<float2> OutputField : register(u0); // One vector per 4x4 cell
+RWTexture2D<uint> LeafSize : register(u1); // Size of the node owning each cell
+RWStructuredBuffer<uint> GlobalStats : register(u2); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int NodeSize; // 32, 16, 8 or 4 (one pass per level, coarse to fine)
+    int SearchRadius; // Around the parent's vector
+    int EnableSubPixel;
+    int UseHistory;
+    float VarianceThreshold; // Below: flat, nodes stop at 16x16
+    float ResidualThreshold; // Average SAD per pixel above which a node splits
+};
+
+// Quadtree motion estimation, one group per node of the current level.
+// A node searches around its parent's vector, then either stays a leaf or hands its four children to the next pass:
+// flat nodes (low variance) stop at 16x16, textured nodes split down to 4x4 while the match residual stays high.
+
+#define CELL 4
+#define MAX_NODE 32
+#define NUM_EXTRA 5 // History + 4 neighbours
+#define VECTOR_BIAS 0.00033f // Per pixel of vector length, picks the shorter vector in flat areas
+
+groupshared float gs_Block[MAX_NODE * MAX_NODE];
+groupshared float gs_Cost[64];
+groupshared int gs_Index[64];
+groupshared float gs_SubCost[4];
+groupshared float3 gs_Result; // Vector, split
+
+// Average SAD per pixel, checkerboard from 16x16 (same as CS_BlockSearch)
+float NodeCost(int2 origin, int2 extent, float2 v, bool bilinear)
+{
+    float2 texSize = float2(Width, Height);
+    int decimation = (NodeSize >= 16) ? 2 : 1;
+    float sad = 0.0f;
+    float count = 0.0f;
+    for (int y = 0; y < extent.y; ++y)
+    {
+        for (int x = 0; x < extent.x; ++x)
+        {
+            if (decimation == 2 && ((x + y) & 1)) continue;
+
+            float target = gs_Block[y * NodeSize + x];
+            float candidate;
+            if (bilinear)
+            {
+                float2 uv = (float2(origin + int2(x, y)) + 0.5f + v) / texSize;
+                candidate = TexPrev.SampleLevel(LinearSampler, uv, 0);
+            }
+            else
+            {
+                int2 p = clamp(origin + int2(x, y) + int2(v), int2(0, 0), int2(Width - 1, Height - 1));
+                candidate = TexPrev[p];
+            }
+            sad += abs(target - candidate);
+            count += 1.0f;
+        }
+    }
+    return sad / max(count, 1.0f);
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex)
+{
+    uint fw, fh;
+    OutputField.GetDimensions(fw, fh);
+    int2 maxCell = int2(fw - 1, fh - 1);
+
+    int2 origin = int2(groupId.xy) * NodeSize;
+    int2 extent = min(int2(NodeSize, NodeSize), int2(Width, Height) - origin);
+    int2 cell = origin / CELL;
+    int cellsPerNode = NodeSize / CELL;
+
+    // The node exists if its parent split (or it is a root). Not an early return:
+    // the barriers below must be reached by every thread, inactive groups just skip the work.
+    bool active = LeafSize[cell] == (uint)NodeSize;
+
+    // [Cache] Current block
+    int cached = active ? NodeSize * NodeSize : 0;
+    for (int i = (int)groupIndex; i < cached; i += 64)
+    {
+        int2 p = origin + int2(i % NodeSize, i / NodeSize);
+        gs_Block[i] = TexCurrent[min(p, int2(Width - 1, Height - 1))];
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Candidates] Window around the parent's vector, then history and the neighbouring nodes' vectors
+    float2 parentVec = InputParentField[cell];
+    int2 center = int2(round(parentVec.x), round(parentVec.y));
+
+    int2 extra[NUM_EXTRA];
+    float2 historyVec = UseHistory ? InputHistory[min(cell + cellsPerNode / 2, maxCell)] : parentVec;
+    extra[0] = int2(round(historyVec.x), round(historyVec.y));
+    int2 neighbours[4] = { int2(-1, 0), int2(1, 0), int2(0, -1), int2(0, 1) };
+    [unroll] for (int n = 0; n < 4; ++n)
+    {
+        float2 nv = InputParentField[clamp(cell + neighbours[n] * cellsPerNode, int2(0, 0), maxCell)];
+        extra[n + 1] = int2(round(nv.x), round(nv.y));
+    }
+
+    int side = 2 * SearchRadius + 1;
+    int gridCount = side * side;
+    int total = active ? gridCount + NUM_EXTRA : 0;
+
+    float bestCost = 999999.0f;
+    int bestIndex = 0;
+    for (int k = (int)groupIndex; k < total; k += 64)
+    {
+        int2 v = (k < gridCount) ? center + int2(k % side - SearchRadius, k / side - SearchRadius) : extra[k - gridCount];
+        float cost = NodeCost(origin, extent, float2(v), false) + VECTOR_BIAS * length(float2(v));
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestIndex = k;
+        }
+    }
+
+    gs_Cost[groupIndex] = bestCost;
+    gs_Index[groupIndex] = bestIndex;
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction] Min cost
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s && gs_Cost[groupIndex + s] < gs_Cost[groupIndex])
+        {
+            gs_Cost[groupIndex] = gs_Cost[groupIndex + s];
+            gs_Index[groupIndex] = gs_Index[groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    int best = gs_Index[0];
+    float minCost = gs_Cost[0];
+    int2 bestVec = (best < gridCount) ? center + int2(best % side - SearchRadius, best / side - SearchRadius) : extra[best - gridCount];
+    float2 finalVector = float2(bestVec);
+
+    // [Sub-Pixel Refinement] One half-pel offset per thread, kept only by leaves
+    float2 offsets[4] = { float2(0.5, 0), float2(-0.5, 0), float2(0, 0.5), float2(0, -0.5) };
+    if (EnableSubPixel > 0)
+    {
+        if (groupIndex < 4)
+        {
+            float2 v = finalVector + offsets[groupIndex];
+            gs_SubCost[groupIndex] = active ? NodeCost(origin, extent, v, true) + VECTOR_BIAS * length(v) : 999999.0f;
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    // [Split Decision] Variance sets how deep a node may go, the residual decides whether it does
+    if (groupIndex == 0)
+    {
+        float variance = 0.0f;
+        int2 varCell = origin / 16;
+        int varCells = max(NodeSize / 16, 1);
+        for (int vy = 0; vy < varCells; ++vy)
+            for (int vx = 0; vx < varCells; ++vx)
+                variance = max(variance, TexVariance[varCell + int2(vx, vy)]);
+
+        int minSize = (variance > VarianceThreshold) ? CELL : 16;
+        bool split = NodeSize > minSize && minCost > ResidualThreshold;
+
+        if (!split && EnableSubPixel > 0)
+        {
+            float2 bestSub = finalVector;
+            for (int j = 0; j < 4; ++j)
+            {
+                if (gs_SubCost[j] < minCost)
+                {
+                    minCost = gs_SubCost[j];
+                    bestSub = finalVector + offsets[j];
+                }
+            }
+            finalVector = bestSub;
+        }
+
+        gs_Result = float3(finalVector, split ? 1.0f : 0.0f);
+
+        // [Scene Change Detection] Leaves only, counted per pixel
+        if (active && !split && minCost > 0.15f)
+        {
+            InterlockedAdd(GlobalStats[0], (uint)(extent.x * extent.y));
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Write] One cell per thread (at most 8x8 cells per node)
+    if (active && (int)groupIndex < cellsPerNode * cellsPerNode)
+    {
+        int2 c = cell + int2((int)groupIndex % cellsPerNode, (int)groupIndex / cellsPerNode);
+        if (c.x <= maxCell.x && c.y <= maxCell.y)
+        {
+            bool split = gs_Result.z > 0.5f;
+            OutputField[c] = gs_Result.xy;
+            LeafSize[c] = split ? (uint)(NodeSize / 2) : (uint)NodeSize;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+Texture2D<float> TexCurrent : register(t0); // [Luma Pyramid]
+Texture2D<float> TexPrev : register(t1);
+Texture2D<float2> SpatialField : register(t2); // Block vectors of the previous scan
+Texture2D<float2> TemporalField : register(t3); // Block vectors of the previous frame
+Texture2D<float> TexUnchanged : register(t4); // [Tile Hash] 16x16 tiles, 1 = identical to last frame
+RWTexture2D<float2> OutputField : register(u0); // One vector per block
+RWStructuredBuffer<uint> GlobalStats : register(u1); // [Counter]
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int Width;
+    int Height;
+    int BlockSize;
+    int ScanDirection; // +1 = Top-left to bottom-right, -1 = Reversed
+    int FrameIndex; // Seeds the update vectors
+    int EnableSubPixel;
+    int2 Padding;
+};
+
+// 3-D Recursive Search (de Haan et al.)
+// Instead of a full window, each block tests a handful of candidates taken from already
+// estimated neighbors (spatial), last frame's field (temporal) and small random updates.
+// A sequential meandering scan is not possible on the GPU, so the scan is emulated with
+// alternating passes: each pass reads the neighbors from the previous pass in its direction.
+
+#define NUM_CANDIDATES 7
+
+// Penalties (avg luma SAD per pixel) bias toward smooth, consistent fields
+#define PENALTY_TEMPORAL 0.0033f
+#define PENALTY_UPDATE 0.01f
+#define PENALTY_ZERO 0.0017f
+
+static const float2 UpdateSet[12] =
+{
+    float2(0, 1), float2(0, -1), float2(1, 0), float2(-1, 0),
+    float2(0, 2), float2(0, -2), float2(3, 0), float2(-3, 0),
+    // Quarter-pel (EnableSubPixel only)
+    float2(0.25f, 0), float2(-0.25f, 0), float2(0, 0.25f), float2(0, -0.25f)
+};
+
+groupshared float gs_SAD[NUM_CANDIDATES][64];
+
+uint Hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+int2 ClampBlock(int2 b, int2 blocks)
+{
+    return clamp(b, int2(0, 0), blocks - 1);
+}
+
+// [Tile Hash] Every 16x16 hash tile the block touches is identical to last frame (mask unbound = 0)
+bool BlockUnchanged(int2 origin, int2 extent)
+{
+    int2 first = origin / 16;
+    int2 last = (origin + extent - 1) / 16;
+    for (int y = first.y; y <= last.y; ++y)
+    {
+        for (int x = first.x; x <= last.x; ++x)
+        {
+            if (TexUnchanged[int2(x, y)] <= 0.5f) return false;
+        }
+    }
+    return true;
+}
+
+// One group per block, 8x8 threads stride over the block
+[numthreads(8, 8, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint bw, bh;
+    OutputField.GetDimensions(bw, bh);
+    int2 blocks = int2(bw, bh);
+    int2 block = int2(groupId.xy);
+    if (block.x >= blocks.x || block.y >= blocks.y) return; // Uniform across the group
+
+    if (BlockUnchanged(block * BlockSize, min(int2(BlockSize, BlockSize), int2(Width, Height) - block * BlockSize)))
+    {
+        if (groupIndex == 0) OutputField[block] = float2(0.0f, 0.0f);
+        return;
+    }
+
+    // [Candidates] (identical for every thread of the group)
+    int d = ScanDirection;
+    float2 sa = SpatialField[ClampBlock(block - int2(d, 0), blocks)]; // Same row, behind
+    float2 sb = SpatialField[ClampBlock(block + int2(d, -d), blocks)]; // Previous row, ahead
+
+    uint rnd = Hash((uint)(block.x + block.y * 4096) ^ Hash((uint)FrameIndex));
+    uint updateCount = EnableSubPixel ? 12 : 8;
+
+    float2 candidates[NUM_CANDIDATES];
+    float penalties[NUM_CANDIDATES];
+    candidates[0] = sa; penalties[0] = 0.0f;
+    candidates[1] = sb; penalties[1] = 0.0f;
+    candidates[2] = sa + UpdateSet[rnd % updateCount]; penalties[2] = PENALTY_UPDATE;
+    candidates[3] = sb + UpdateSet[(rnd >> 8) % updateCount]; penalties[3] = PENALTY_UPDATE;
+    candidates[4] = TemporalField[ClampBlock(block + int2(0, d), blocks)]; penalties[4] = PENALTY_TEMPORAL; // Not yet visited this scan
+    candidates[5] = TemporalField[block]; penalties[5] = PENALTY_TEMPORAL;
+    candidates[6] = float2(0, 0); penalties[6] = PENALTY_ZERO;
+
+    // [Block SAD] Partial sums per thread
+    float2 texSize = float2(Width, Height);
+    int2 origin = block * BlockSize;
+
+    float partial[NUM_CANDIDATES];
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) partial[c] = 0.0f;
+
+    for (int py = (int)threadId.y; py < BlockSize; py += 8)
+    {
+        for (int px = (int)threadId.x; px < BlockSize; px += 8)
+        {
+            int2 pos = origin + int2(px, py);
+            if (pos.x >= Width || pos.y >= Height) continue;
+
+            float target = TexCurrent[pos];
+            [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c)
+            {
+                float2 uv = (float2(pos) + 0.5f + candidates[c]) / texSize;
+                partial[c] += abs(target - TexPrev.SampleLevel(LinearSampler, uv, 0));
+            }
+        }
+    }
+
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) gs_SAD[c][groupIndex] = partial[c];
+    GroupMemoryBarrierWithGroupSync();
+
+    // [Reduction]
+    [unroll] for (uint s = 32; s > 0; s >>= 1)
+    {
+        if (groupIndex < s)
+        {
+            [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c) gs_SAD[c][groupIndex] += gs_SAD[c][groupIndex + s];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex != 0) return;
+
+    int2 extent = min(int2(BlockSize, BlockSize), int2(Width, Height) - origin);
+    float count = (float)max(1, extent.x * extent.y);
+
+    float bestCost = 999999.0f;
+    float bestSAD = 0.0f;
+    float2 bestVector = float2(0, 0);
+    [unroll] for (int c = 0; c < NUM_CANDIDATES; ++c)
+    {
+        float cost = gs_SAD[c][0] / count + penalties[c];
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSAD = gs_SAD[c][0];
+            bestVector = candidates[c];
+        }
+    }
+
+    OutputField[block] = bestVector;
+
+    // [Scene Change Detection] Same normalization as CS_BlockMatching, counted per pixel
+    if (bestSAD / count > 0.15f)
+    {
+        InterlockedAdd(GlobalStats[0], (uint)count);
+    }
+}
@@ -0,0 +1,132 @@
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1);
+StructuredBuffer<uint> HashStats : register(t2); // CSResolve: CS_FrameHash stats (UseHashStats)
+RWStructuredBuffer<uint> SceneStats : register(u0); // Cleared to 0 every frame, layout below
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    int ThumbWidth;
+    int ThumbHeight;
+    float HistogramThreshold; // Normalized L1 histogram distance (0 - 1) a cut must exceed
+    float SADThreshold; // Mean thumbnail luma difference (0 - 1) a cut must exceed
+    int UseHashStats; // CSResolve: a frame without a changed tile is a duplicate
+    int DetectCuts; // 0 = CSMain was not dispatched, only duplicates are detected
+    float2 Padding;
+};
+
+// [Scene Cut] Runs before any motion estimation, on a thumbnail sampled straight from both frames.
+// A cut needs both a different color distribution and a large plain difference: a fast pan changes
+// the SAD but not the histograms, a fade changes the histograms but barely the SAD between frames.
+// Whatever this misses is still caught by the GlobalStats counter of the block search.
+// [Tile Hash] A duplicate frame (every tile hash matches the last frame) gets the same verdict: nothing to
+// estimate or synthesize, the real frame is shown again.
+
+#define LUMA_BINS 32
+#define CHROMA_BINS 16
+
+#define LUMA_CURR 0
+#define LUMA_PREV (LUMA_CURR + LUMA_BINS)
+#define CB_CURR (LUMA_PREV + LUMA_BINS)
+#define CB_PREV (CB_CURR + CHROMA_BINS)
+#define CR_CURR (CB_PREV + CHROMA_BINS)
+#define CR_PREV (CR_CURR + CHROMA_BINS)
+#define HISTOGRAM_SIZE (CR_PREV + CHROMA_BINS)
+#define SAD_SUM HISTOGRAM_SIZE // Sum of |luma difference| * SAD_SCALE
+#define VERDICT (SAD_SUM + 1) // 1 = cut or duplicate (read by PS_SceneCut)
+
+#define SAD_SCALE 1024.0f
+
+groupshared uint gs_Histogram[HISTOGRAM_SIZE];
+
+// Rec.709 luma + chroma, remapped to 0 - 1
+float3 LumaChroma(float3 rgb)
+{
+    float y = dot(rgb, float3(0.2126f, 0.7152f, 0.0722f));
+    return float3(y, saturate((rgb.b - y) / 1.8556f + 0.5f), saturate((rgb.r - y) / 1.5748f + 0.5f));
+}
+
+// Box of 4 bilinear taps around the thumbnail cell center
+float3 Thumbnail(Texture2D<float4> tex, float2 uv, float2 cellSize)
+{
+    float3 sum = tex.SampleLevel(LinearSampler, uv + cellSize * float2(-0.25f, -0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(0.25f, -0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(-0.25f, 0.25f), 0).rgb;
+    sum += tex.SampleLevel(LinearSampler, uv + cellSize * float2(0.25f, 0.25f), 0).rgb;
+    return sum * 0.25f;
+}
+
+uint Bin(float value, uint bins)
+{
+    return min((uint)(value * bins), bins - 1);
+}
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex < HISTOGRAM_SIZE) gs_Histogram[groupIndex] = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    // No early return: every thread has to reach the barriers
+    bool valid = (int)dispatchThreadId.x < ThumbWidth && (int)dispatchThreadId.y < ThumbHeight;
+    if (valid)
+    {
+        float2 cellSize = 1.0f / float2(ThumbWidth, ThumbHeight);
+        float2 uv = (float2(dispatchThreadId.xy) + 0.5f) * cellSize;
+        float3 curr = LumaChroma(Thumbnail(TexCurrent, uv, cellSize));
+        float3 prev = LumaChroma(Thumbnail(TexPrev, uv, cellSize));
+
+        InterlockedAdd(gs_Histogram[LUMA_CURR + Bin(curr.x, LUMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[LUMA_PREV + Bin(prev.x, LUMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CB_CURR + Bin(curr.y, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CB_PREV + Bin(prev.y, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CR_CURR + Bin(curr.z, CHROMA_BINS)], 1);
+        InterlockedAdd(gs_Histogram[CR_PREV + Bin(prev.z, CHROMA_BINS)], 1);
+
+        InterlockedAdd(SceneStats[SAD_SUM], (uint)(abs(curr.x - prev.x) * SAD_SCALE + 0.5f));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex < HISTOGRAM_SIZE && gs_Histogram[groupIndex] > 0)
+        InterlockedAdd(SceneStats[groupIndex], gs_Histogram[groupIndex]);
+}
+
+// Half the L1 distance between two normalized histograms (0 = identical, 1 = disjoint)
+float HistogramDistance(uint curr, uint prev, uint bins, float cells)
+{
+    uint sum = 0;
+    for (uint i = 0; i < bins; ++i)
+    {
+        uint a = SceneStats[curr + i];
+        uint b = SceneStats[prev + i];
+        sum += (a > b) ? (a - b) : (b - a);
+    }
+    return (float)sum / (2.0f * cells);
+}
+
+// CS_FrameHash layout
+#define CHANGED_TILES 0
+#define HAS_HISTORY 1
+
+// Single thread, after CSMain: 64 histogram bins are not worth a reduction
+[numthreads(1, 1, 1)]
+void CSResolve()
+{
+    bool duplicate = UseHashStats && HashStats[HAS_HISTORY] != 0 && HashStats[CHANGED_TILES] == 0;
+    if (!DetectCuts || duplicate)
+    {
+        SceneStats[VERDICT] = duplicate ? 1 : 0;
+        return;
+    }
+
+    float cells = (float)(ThumbWidth * ThumbHeight);
+
+    float distance = HistogramDistance(LUMA_CURR, LUMA_PREV, LUMA_BINS, cells);
+    distance = max(distance, HistogramDistance(CB_CURR, CB_PREV, CHROMA_BINS, cells));
+    distance = max(distance, HistogramDistance(CR_CURR, CR_PREV, CHROMA_BINS, cells));
+
+    float meanSAD = (float)SceneStats[SAD_SUM] / (SAD_SCALE * cells);
+
+    SceneStats[VERDICT] = (distance > HistogramThreshold && meanSAD > SADThreshold) ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+Texture2D<float4> TexCurrent : register(t0);
+Texture2D<float4> TexPrev : register(t1); // CSClassify
+Texture2D<float2> TexMotion : register(t2); // CSClassify: the field synthesis samples (flow resolution)
+Texture2D<float> TexMask : register(t3); // CSClassify: HUD mask
+StructuredBuffer<uint> GlobalStats : register(t4); // CSClassify: [Scene Change Stats]
+StructuredBuffer<uint> TileListIn : register(t5); // CSStatic
+
+RWStructuredBuffer<uint> TileList : register(u0); // CSClassify: dynamic tiles from the front, static tiles from the back
+RWBuffer<uint> DispatchArgs : register(u1); // CSClassify: [0-2] dynamic groups, [3-5] static groups (cleared to 0)
+RWTexture2D<float4> OutputFrame : register(u0); // CSStatic
+RWTexture2D<float4> OutputCopy : register(u1); // CSStatic: RCAS input of the dynamic tiles (WriteCopy)
+
+SamplerState LinearSampler : register(s0);
+
+cbuffer CB : register(b0)
+{
+    float MotionBlockSize; // 1 = Per-pixel motion, N = One vector per NxN block
+    int SceneChangeThreshold; // Same test as CS_Interpolate
+    float2 FlowScale; // Output pixels per flow pixel
+    uint TileCount;
+    float StaticMotion; // Output pixels, a static pixel moves less
+    float StaticDiff; // Sum of the RGB differences, a static pixel changes less
+    float Sharpness; // CSStatic: RCAS strength of the real frame, 0 = plain copy
+    int WriteCopy;
+    float3 Padding;
+};
+
+// [Tile Skip] A 16x16 tile is static when none of its pixels would come out of synthesis different from the
+// real frame: no motion and no change between the frames, or covered by the HUD / a scene change (both of which
+// synthesis answers with TexCurrent anyway). Only dynamic tiles are warped, static ones are the real frame.
+
+#define TILE_SIZE 16
+
+groupshared uint gs_Dynamic;
+
+// Tiles are packed as y << 16 | x
+uint2 TileOrigin(uint tile)
+{
+    return uint2(tile & 0xFFFF, tile >> 16) * TILE_SIZE;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSClassify(uint3 groupId : SV_GroupID, uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gs_Dynamic = 0;
+
+        // The counts are the only atomics, the Y / Z group counts are plain stores
+        if (groupId.x == 0 && groupId.y == 0)
+        {
+            DispatchArgs[1] = 1;
+            DispatchArgs[2] = 1;
+            DispatchArgs[4] = 1;
+            DispatchArgs[5] = 1;
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    uint2 pos = dispatchThreadId.xy;
+
+    if (pos.x < w && pos.y < h && GlobalStats[0] <= (uint)SceneChangeThreshold && TexMask[pos] <= 0.5f)
+    {
+        // Sampled exactly like CS_Interpolate does
+        uint mw, mh;
+        TexMotion.GetDimensions(mw, mh);
+        float2 motion = TexMotion.SampleLevel(LinearSampler, (float2(pos) + 0.5f) / (MotionBlockSize * FlowScale * float2(mw, mh)), 0) * FlowScale;
+
+        float3 diff = abs(TexCurrent[pos].rgb - TexPrev[pos].rgb);
+
+        if (dot(motion, motion) > StaticMotion * StaticMotion || diff.r + diff.g + diff.b > StaticDiff)
+        {
+            gs_Dynamic = 1; // Any writer, same value
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint tile = (groupId.y << 16) | groupId.x;
+        uint slot;
+        if (gs_Dynamic)
+        {
+            InterlockedAdd(DispatchArgs[0], 1, slot);
+            TileList[slot] = tile;
+        }
+        else
+        {
+            InterlockedAdd(DispatchArgs[3], 1, slot);
+            TileList[TileCount - 1 - slot] = tile;
+        }
+    }
+}
+
+// Same lobe as CS_RCAS, on the real frame
+float4 SharpenCurrent(int2 pos, int w, int h)
+{
+    float4 c = TexCurrent[pos];
+    float3 n = TexCurrent[int2(pos.x, max(0, pos.y - 1))].rgb;
+    float3 s = TexCurrent[int2(pos.x, min(h - 1, pos.y + 1))].rgb;
+    float3 wv = TexCurrent[int2(max(0, pos.x - 1), pos.y)].rgb;
+    float3 e = TexCurrent[int2(min(w - 1, pos.x + 1), pos.y)].rgb;
+
+    float lobe = lerp(0.0f, -0.2f, Sharpness);
+    float3 result = (c.rgb + lobe * (n + s + wv + e)) / (1.0f + 4.0f * lobe);
+    return float4(saturate(result), c.a);
+}
+
+// Indirect over the static tiles: the real frame, as it is presented (sharpened when the generated frames are)
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSStatic(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID)
+{
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    uint2 pos = TileOrigin(TileListIn[TileCount - 1 - groupId.x]) + groupThreadId.xy;
+    if (pos.x >= w || pos.y >= h) return;
+
+    float4 color = TexCurrent[pos];
+    if (WriteCopy) OutputCopy[pos] = color;
+    OutputFrame[pos] = Sharpness > 0.0f ? SharpenCurrent(int2(pos), (int)w, (int)h) : color;
+}
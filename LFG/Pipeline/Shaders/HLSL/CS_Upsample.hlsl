@@ -1,30 +1,82 @@
-Texture2D<float2> InputMotion : register(t0);
-RWTexture2D<float2> OutputMotion : register(u0);
-
-SamplerState LinearSampler : register(s0);
-
-[numthreads(8, 8, 1)]
-void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
-{
-    // Target resolution (upsampled) coordinates
-    uint2 dstPos = dispatchThreadId.xy;
-    
-    // We map the target integer coordinate to UV [0,1]
-    // But since we are in a Compute Shader, we might just sample using integer indices if we want nearest, 
-    // or we need normalized UVs for bilinear.
-    
-    // Simple Nearest Neighbor Upscale for now (or basic bilinear logic manually):
-    // Source index is roughly half of destination
-    uint2 srcPos = dstPos / 2;
-    
-    // Read the coarse motion vector
-    float2 coarseVector = InputMotion[srcPos];
-    
-    // Scale the vector by 2.0 because the image domain is 2x larger
-    // Motion of 1 pixel in coarse level corresponds to 2 pixels in fine level (usually)
-    // IMPORTANT: Check coordinate system. If normalized, no scale needed? 
-    // Usually motion vectors are in pixels. So we multiply by 2.
-    float2 fineVector = coarseVector * 2.0f;
-    
-    OutputMotion[dstPos] = fineVector;
-}
+Texture2D<float2> InputMotion : register(t0); // Coarse level
+Texture2D<float> GuideFine : register(t1); // [Guided Upsample] Luma at the output level (optional)
+Texture2D<float> GuideCoarse : register(t2); // Luma at the input level
+RWTexture2D<float2> OutputMotion : register(u0);
+
+cbuffer CB : register(b0)
+{
+    int UseGuide; // 0 = nearest coarse vector
+    float RangeSigma; // Luma difference at which a coarse vector's weight falls to exp(-1/2)
+    float2 Padding;
+};
+
+// [Guided Upsample] Joint bilateral upsampling: each output pixel blends the 3x3 nearest coarse vectors, weighted by
+// distance and by how close their luma is to the pixel's own. Vectors stay on their side of an object edge
+// instead of coming out as 2x2 blocks. Evaluated separably (3 taps across, then 3 down) so the CPU port
+// (CPUOpticalFlow::Upsample) can run it as two 1D passes: the horizontal pass is guided by the output row pair
+// averaged onto the coarse row.
+
+#define SPATIAL_SIGMA 1.0f // Coarse pixels
+#define RANGE_FLOOR 0.001f // Keeps an all-edges neighbourhood at plain spatial weights
+
+float SpatialWeight(float d)
+{
+    return exp(-d * d / (2.0f * SPATIAL_SIGMA * SPATIAL_SIGMA));
+}
+
+float RangeWeight(float d)
+{
+    return exp(-d * d / (2.0f * RangeSigma * RangeSigma)) + RANGE_FLOOR;
+}
+
+[numthreads(8, 8, 1)]
+void CSMain(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    int2 dstPos = int2(dispatchThreadId.xy);
+    uint fw, fh, cw, ch;
+    OutputMotion.GetDimensions(fw, fh);
+    InputMotion.GetDimensions(cw, ch);
+    if (dstPos.x >= (int)fw || dstPos.y >= (int)fh) return;
+
+    // Source index is half of destination, a motion of 1 coarse pixel is 2 fine pixels
+    int2 srcPos = min(dstPos / 2, int2(cw, ch) - 1);
+
+    if (!UseGuide)
+    {
+        OutputMotion[dstPos] = InputMotion[srcPos] * 2.0f;
+        return;
+    }
+
+    float2 center = (float2(dstPos) + 0.5f) * 0.5f - 0.5f; // Output pixel in coarse pixel coordinates
+    float guide = GuideFine[dstPos];
+
+    float2 sum = 0.0f;
+    float weightSum = 0.0f;
+
+    [unroll]
+    for (int dy = -1; dy <= 1; ++dy)
+    {
+        int j = clamp(srcPos.y + dy, 0, (int)ch - 1);
+
+        // Horizontal pass at coarse row j, guided by the output column averaged over the row pair j covers
+        float rowGuide = 0.5f * (GuideFine[int2(dstPos.x, min(2 * j, (int)fh - 1))] + GuideFine[int2(dstPos.x, min(2 * j + 1, (int)fh - 1))]);
+        float2 rowSum = 0.0f;
+        float rowWeight = 0.0f;
+
+        [unroll]
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            int i = clamp(srcPos.x + dx, 0, (int)cw - 1);
+            float w = SpatialWeight(i - center.x) * RangeWeight(rowGuide - GuideCoarse[int2(i, j)]);
+            rowSum += InputMotion[int2(i, j)] * w;
+            rowWeight += w;
+        }
+
+        // Vertical pass
+        float w = SpatialWeight(j - center.y) * RangeWeight(guide - rowGuide);
+        sum += (rowSum / rowWeight) * w;
+        weightSum += w;
+    }
+
+    OutputMotion[dstPos] = (sum / weightSum) * 2.0f;
+}
@@ -1,147 +1,204 @@
-Texture2D<float4> Input : register(t0);
-RWTexture2D<float4> Output : register(u0);
-SamplerState LinearSampler : register(s0);
-SamplerState PointSampler : register(s1);
-
-cbuffer CBUpscale : register(b0)
-{
-    int Mode; // 0=Nearest, 1=Bilinear, 2=Bicubic, 3=Lanczos
-    int Radius; // For Lanczos (e.g., 2 or 3)
-    float2 InputSize; // Width, Height
-    float2 Padding;
-}
-
-// Helper: Cubic Weight
-float CubicWeight(float x)
-{
-    const float B = 0.0f;
-    const float C = 0.5f;
-    float ax = abs(x);
-    if (ax < 1.0f)
-        return ((12 - 9 * B - 6 * C) * ax * ax * ax + (-18 + 12 * B + 6 * C) * ax * ax + (6 - 2 * B)) / 6.0f;
-    else if (ax < 2.0f)
-        return ((-B - 6 * C) * ax * ax * ax + (6 * B + 30 * C) * ax * ax + (-12 * B - 48 * C) * ax + (8 * B + 24 * C)) / 6.0f;
-    else
-        return 0.0f;
-}
-
-// Helper: Sinc function
-float Sinc(float x)
-{
-    if (x == 0.0f) return 1.0f;
-    float pi_x = 3.14159265f * x;
-    return sin(pi_x) / pi_x;
-}
-
-// Helper: Lanczos Weight
-float LanczosWeight(float x, int a)
-{
-    if (abs(x) >= a) return 0.0f;
-    return Sinc(x) * Sinc(x / a);
-}
-
-float4 SampleNearest(int2 coord)
-{
-    return Input[coord]; // Direct texel fetch
-}
-
-float4 SampleBilinear(float2 uv)
-{
-    return Input.SampleLevel(LinearSampler, uv, 0);
-}
-
-// Bicubic Sampling (Catmull-Rom)
-float4 SampleBicubic(float2 uv)
-{
-    float2 texSize = InputSize;
-    float2 samplePos = uv * texSize - 0.5f;
-    int2 tc = floor(samplePos);
-    float2 f = samplePos - tc;
-
-    float4 sum = 0;
-    float totalWeight = 0;
-    
-    // 4x4 Neighborhood
-    [unroll]
-    for (int y = -1; y <= 2; y++)
-    {
-        [unroll]
-        for (int x = -1; x <= 2; x++)
-        {
-            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
-            float w = CubicWeight(x - f.x) * CubicWeight(y - f.y);
-            sum += Input[coord] * w;
-            totalWeight += w;
-        }
-    }
-    return sum / totalWeight; // Normalization helps if edge clamping issues occur
-}
-
-// Lanczos Sampling
-float4 SampleLanczos(float2 uv, int a)
-{
-    float2 texSize = InputSize;
-    float2 samplePos = uv * texSize - 0.5f;
-    int2 tc = floor(samplePos);
-    float2 f = samplePos - tc;
-
-    float4 sum = 0;
-    float totalWeight = 0;
-
-    // Window size: -a+1 to a
-    for (int y = -a + 1; y <= a; y++)
-    {
-        for (int x = -a + 1; x <= a; x++)
-        {
-            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
-            float w = LanczosWeight(float(x) - f.x, a) * LanczosWeight(float(y) - f.y, a);
-            sum += Input[coord] * w;
-            totalWeight += w;
-        }
-    }
-    
-    // Prevent ringing artifacts (optional clamp or just raw)
-    // For now, raw output, but weight normalization is key.
-    return (totalWeight > 0.0001f) ? (sum / totalWeight) : float4(0,0,0,0);
-}
-
-[numthreads(16, 16, 1)]
-void main(uint3 id : SV_DispatchThreadID)
-{
-    uint outW, outH;
-    Output.GetDimensions(outW, outH);
-    if (id.x >= outW || id.y >= outH) return;
-
-    float2 uv = (float2(id.xy) + 0.5f) / float2(outW, outH);
-    
-    float4 color = 0;
-    
-    // Switch is acceptable here
-    // Mode 0 = Native (Should probably not be dispatched, but behaves like Nearest/Copy if hit)
-    
-    if (Mode == 1) // Nearest
-    {
-        float2 iUV = uv * InputSize;
-        color = Input[int2(iUV)]; // or simple cast
-    }
-    else if (Mode == 2) // Bilinear
-    {
-        color = SampleBilinear(uv);
-    }
-    else if (Mode == 3) // Bicubic
-    {
-        color = SampleBicubic(uv);
-    }
-    else if (Mode == 4) // Lanczos
-    {
-        color = SampleLanczos(uv, Radius);
-    }
-    else // Fallback (Native or Invalid)
-    {
-        // For Native, we essentially want 1:1 copy, which Nearest handles correctly if sizes match
-        float2 iUV = uv * InputSize;
-        color = Input[int2(iUV)]; 
-    }
-
-    Output[id.xy] = color;
-}
+Texture2D<float4> Input : register(t0);
+RWTexture2D<float4> Output : register(u0);
+SamplerState LinearSampler : register(s0);
+SamplerState PointSampler : register(s1);
+
+cbuffer CBUpscale : register(b0)
+{
+    int Mode; // 0=Nearest, 1=Bilinear, 2=Bicubic, 3=Lanczos
+    int Radius; // For Lanczos (e.g., 2 or 3)
+    float2 InputSize; // Width, Height
+    float Sharpness; // [Fused RCAS] CSUpscaleRCAS only, same as CS_RCAS
+    int StorageFormat; // [Fused RCAS] Precision the two-pass chain stored the upscaled frame at: 0 = Float, 1 = UNORM8, 2 = FLOAT16
+    float2 Padding;
+}
+
+// Helper: Cubic Weight
+float CubicWeight(float x)
+{
+    const float B = 0.0f;
+    const float C = 0.5f;
+    float ax = abs(x);
+    if (ax < 1.0f)
+        return ((12 - 9 * B - 6 * C) * ax * ax * ax + (-18 + 12 * B + 6 * C) * ax * ax + (6 - 2 * B)) / 6.0f;
+    else if (ax < 2.0f)
+        return ((-B - 6 * C) * ax * ax * ax + (6 * B + 30 * C) * ax * ax + (-12 * B - 48 * C) * ax + (8 * B + 24 * C)) / 6.0f;
+    else
+        return 0.0f;
+}
+
+// Helper: Sinc function
+float Sinc(float x)
+{
+    if (x == 0.0f) return 1.0f;
+    float pi_x = 3.14159265f * x;
+    return sin(pi_x) / pi_x;
+}
+
+// Helper: Lanczos Weight
+float LanczosWeight(float x, int a)
+{
+    if (abs(x) >= a) return 0.0f;
+    return Sinc(x) * Sinc(x / a);
+}
+
+float4 SampleNearest(int2 coord)
+{
+    return Input[coord]; // Direct texel fetch
+}
+
+float4 SampleBilinear(float2 uv)
+{
+    return Input.SampleLevel(LinearSampler, uv, 0);
+}
+
+// Bicubic Sampling (Catmull-Rom)
+float4 SampleBicubic(float2 uv)
+{
+    float2 texSize = InputSize;
+    float2 samplePos = uv * texSize - 0.5f;
+    int2 tc = floor(samplePos);
+    float2 f = samplePos - tc;
+
+    float4 sum = 0;
+    float totalWeight = 0;
+    
+    // 4x4 Neighborhood
+    [unroll]
+    for (int y = -1; y <= 2; y++)
+    {
+        [unroll]
+        for (int x = -1; x <= 2; x++)
+        {
+            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
+            float w = CubicWeight(x - f.x) * CubicWeight(y - f.y);
+            sum += Input[coord] * w;
+            totalWeight += w;
+        }
+    }
+    return sum / totalWeight; // Normalization helps if edge clamping issues occur
+}
+
+// Lanczos Sampling
+float4 SampleLanczos(float2 uv, int a)
+{
+    float2 texSize = InputSize;
+    float2 samplePos = uv * texSize - 0.5f;
+    int2 tc = floor(samplePos);
+    float2 f = samplePos - tc;
+
+    float4 sum = 0;
+    float totalWeight = 0;
+
+    // Window size: -a+1 to a
+    for (int y = -a + 1; y <= a; y++)
+    {
+        for (int x = -a + 1; x <= a; x++)
+        {
+            int2 coord = clamp(tc + int2(x, y), int2(0,0), int2(texSize)-1);
+            float w = LanczosWeight(float(x) - f.x, a) * LanczosWeight(float(y) - f.y, a);
+            sum += Input[coord] * w;
+            totalWeight += w;
+        }
+    }
+    
+    // Prevent ringing artifacts (optional clamp or just raw)
+    // For now, raw output, but weight normalization is key.
+    return (totalWeight > 0.0001f) ? (sum / totalWeight) : float4(0,0,0,0);
+}
+
+float4 Upscale(uint2 pos, uint outW, uint outH)
+{
+    float2 uv = (float2(pos) + 0.5f) / float2(outW, outH);
+    
+    float4 color = 0;
+    
+    // Switch is acceptable here
+    // Mode 0 = Native (Should probably not be dispatched, but behaves like Nearest/Copy if hit)
+    
+    if (Mode == 1) // Nearest
+    {
+        float2 iUV = uv * InputSize;
+        color = Input[int2(iUV)]; // or simple cast
+    }
+    else if (Mode == 2) // Bilinear
+    {
+        color = SampleBilinear(uv);
+    }
+    else if (Mode == 3) // Bicubic
+    {
+        color = SampleBicubic(uv);
+    }
+    else if (Mode == 4) // Lanczos
+    {
+        color = SampleLanczos(uv, Radius);
+    }
+    else // Fallback (Native or Invalid)
+    {
+        // For Native, we essentially want 1:1 copy, which Nearest handles correctly if sizes match
+        float2 iUV = uv * InputSize;
+        color = Input[int2(iUV)]; 
+    }
+
+    return color;
+}
+
+[numthreads(16, 16, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    uint outW, outH;
+    Output.GetDimensions(outW, outH);
+    if (id.x >= outW || id.y >= outH) return;
+
+    Output[id.xy] = Upscale(id.xy, outW, outH);
+}
+
+// [Fused RCAS] Upscale + CS_RCAS in one pass: each group upscales its 16x16 tile plus a 1 pixel apron into
+// groupshared memory, then sharpens from there. The apron uses the same edge clamping as CS_RCAS, and the
+// upscaled colors are rounded to the storage format first, so the output matches main -> CS_RCAS.
+#define TILE_SIZE 16
+#define APRON_SIZE (TILE_SIZE + 2)
+
+groupshared float4 gs_Upscaled[APRON_SIZE * APRON_SIZE];
+
+float4 RoundToStorage(float4 color)
+{
+    if (StorageFormat == 1) return round(saturate(color) * 255.0f) / 255.0f;
+    if (StorageFormat == 2) return f16tof32(f32tof16(color));
+    return color;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSUpscaleRCAS(uint3 groupId : SV_GroupID, uint3 groupThreadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    uint outW, outH;
+    Output.GetDimensions(outW, outH);
+    int2 tileOrigin = int2(groupId.xy) * TILE_SIZE - 1;
+
+    // 1. Upscaled tile + apron (324 texels, 256 threads)
+    for (uint i = groupIndex; i < APRON_SIZE * APRON_SIZE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int2 pos = tileOrigin + int2(i % APRON_SIZE, i / APRON_SIZE);
+        pos = clamp(pos, int2(0, 0), int2(outW, outH) - 1);
+        gs_Upscaled[i] = RoundToStorage(Upscale(uint2(pos), outW, outH));
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    uint2 pos = groupId.xy * TILE_SIZE + groupThreadId.xy;
+    if (pos.x >= outW || pos.y >= outH) return;
+
+    // 2. RCAS (CS_RCAS), neighbors from the tile
+    uint center = (groupThreadId.y + 1) * APRON_SIZE + groupThreadId.x + 1;
+    float4 c = gs_Upscaled[center];
+    float3 n = gs_Upscaled[center - APRON_SIZE].rgb;
+    float3 s = gs_Upscaled[center + APRON_SIZE].rgb;
+    float3 w = gs_Upscaled[center - 1].rgb;
+    float3 e = gs_Upscaled[center + 1].rgb;
+
+    float lobe = lerp(0.0f, -0.2f, Sharpness);
+    float3 neighborSum = n + s + w + e;
+    float3 numerator = c.rgb + lobe * neighborSum;
+    float denominator = 1.0f + 4.0f * lobe;
+
+    Output[pos] = float4(saturate(numerator / denominator), c.a);
+}
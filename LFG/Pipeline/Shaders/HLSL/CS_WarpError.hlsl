@@ -0,0 +1,88 @@
+Texture2D<float4> TexCurrent : register(t0); // Captured frames (native resolution)
+Texture2D<float4> TexPrev : register(t1);
+Texture2D<float2> InputMotion : register(t2); // Final motion (flow resolution, or the block field)
+RWStructuredBuffer<uint> Stats : register(u0); // [0] error sum (ERROR_SCALE fixed point), [1] pixels, cleared per measurement
+
+cbuffer CB : register(b0)
+{
+    float MotionScale; // Frame pixels per flow pixel
+    int Step; // Every Step-th pixel in x and y
+    float Padding[2];
+};
+
+// [Auto-Tune] Self-consistency of a configuration: the previous frame warped onto the current one by the final
+// motion, mean luma difference at the frames' resolution (so every Render Scale is measured alike). WarpError reads
+// it back; the dispatch sits inside the scene cut predicate, a cut leaves the pixel count at zero.
+
+#define GROUP 16
+#define ERROR_SCALE 256.0f
+
+static const float3 LumaWeights = float3(0.2126f, 0.7152f, 0.0722f); // Rec. 709, as CS_LumaPyramid
+
+groupshared float gs_Error[GROUP * GROUP];
+groupshared uint gs_Count;
+
+float PrevLuma(float2 q, int2 maxPos)
+{
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float a = dot(TexPrev[clamp(p, int2(0, 0), maxPos)].rgb, LumaWeights);
+    float b = dot(TexPrev[clamp(p + int2(1, 0), int2(0, 0), maxPos)].rgb, LumaWeights);
+    float c = dot(TexPrev[clamp(p + int2(0, 1), int2(0, 0), maxPos)].rgb, LumaWeights);
+    float d = dot(TexPrev[clamp(p + int2(1, 1), int2(0, 0), maxPos)].rgb, LumaWeights);
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+// Motion under frame pixel 'pos', bilinear on whatever grid the field has
+float2 MotionAt(int2 pos, int2 frameSize)
+{
+    uint mw, mh;
+    InputMotion.GetDimensions(mw, mh);
+    int2 maxPos = int2(mw, mh) - 1;
+    float2 q = (float2(pos) + 0.5f) * float2(mw, mh) / float2(frameSize) - 0.5f;
+    float2 f = floor(q);
+    float2 t = q - f;
+    int2 p = int2(f);
+    float2 a = InputMotion[clamp(p, int2(0, 0), maxPos)];
+    float2 b = InputMotion[clamp(p + int2(1, 0), int2(0, 0), maxPos)];
+    float2 c = InputMotion[clamp(p + int2(0, 1), int2(0, 0), maxPos)];
+    float2 d = InputMotion[clamp(p + int2(1, 1), int2(0, 0), maxPos)];
+    return lerp(lerp(a, b, t.x), lerp(c, d, t.x), t.y);
+}
+
+[numthreads(GROUP, GROUP, 1)]
+void CSWarpError(uint3 dispatchThreadId : SV_DispatchThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0) gs_Count = 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint w, h;
+    TexCurrent.GetDimensions(w, h);
+    int2 frameSize = int2(w, h);
+    int2 pos = int2(dispatchThreadId.xy) * Step;
+
+    float error = 0.0f;
+    if (pos.x < frameSize.x && pos.y < frameSize.y)
+    {
+        float2 v = MotionAt(pos, frameSize) * MotionScale;
+        // Clamped for HDR frames, the sum stays in 32 bits up to 8K
+        error = saturate(abs(dot(TexCurrent[pos].rgb, LumaWeights) - PrevLuma(float2(pos) + v, frameSize - 1)));
+        InterlockedAdd(gs_Count, 1);
+    }
+    gs_Error[groupIndex] = error;
+    GroupMemoryBarrierWithGroupSync();
+
+    [unroll]
+    for (uint s = GROUP * GROUP / 2; s > 0; s >>= 1)
+    {
+        if (groupIndex < s) gs_Error[groupIndex] += gs_Error[groupIndex + s];
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex == 0 && gs_Count > 0)
+    {
+        InterlockedAdd(Stats[0], (uint)round(gs_Error[0] * ERROR_SCALE));
+        InterlockedAdd(Stats[1], gs_Count);
+    }
+}
@@ -0,0 +1,18 @@
+StructuredBuffer<uint> SceneStats : register(t0); // CS_SceneCut output
+
+// [Scene Cut] A single point on a 1x1 target, drawn inside an occlusion predicate.
+// It only survives when the frame is NOT a cut (or duplicate), so work predicated on it is dropped on a cut
+// by the GPU itself, without reading the verdict back.
+
+#define VERDICT 129 // CS_SceneCut layout
+
+float4 VSMain(uint vertexId : SV_VertexID) : SV_Position
+{
+    return float4(0.0f, 0.0f, 0.5f, 1.0f); // Center of the target
+}
+
+float4 PSMain(float4 position : SV_Position) : SV_Target
+{
+    if (SceneStats[VERDICT] != 0) discard;
+    return float4(1.0f, 1.0f, 1.0f, 1.0f);
+}
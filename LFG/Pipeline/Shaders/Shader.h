@@ -1,14 +1,21 @@
-#pragma once
-#include <d3d11.h>
-#include <string>
-#include <wrl/client.h>
-#include <d3dcompiler.h>
-
-using Microsoft::WRL::ComPtr;
-
-class Shader
-{
-public:
-	static bool CompileComputeShader(ID3D11Device* device, const std::wstring& filePath, const std::string& entryPoint, ID3D11ComputeShader** outShader);
-	static bool CompileComputeShaderFromMemory(ID3D11Device* device, const std::string& shaderSource, const std::string& entryPoint, ID3D11ComputeShader** outShader);
-};
+#pragma once
+#include <d3d11.h>
+#include <string>
+#include <wrl/client.h>
+#include <d3dcompiler.h>
+
+using Microsoft::WRL::ComPtr;
+
+class Shader
+{
+public:
+	static bool CompileComputeShader(ID3D11Device* device, const std::wstring& filePath, const std::string& entryPoint, ID3D11ComputeShader** outShader);
+	static bool CompileComputeShaderFromMemory(ID3D11Device* device, const std::string& shaderSource, const std::string& entryPoint, ID3D11ComputeShader** outShader);
+
+	// [Scene Cut] Graphics stages, only used to feed an occlusion predicate
+	static bool CompileVertexShaderFromMemory(ID3D11Device* device, const std::string& shaderSource, const std::string& entryPoint, ID3D11VertexShader** outShader);
+	static bool CompilePixelShaderFromMemory(ID3D11Device* device, const std::string& shaderSource, const std::string& entryPoint, ID3D11PixelShader** outShader);
+
+private:
+	static bool CompileBlobFromMemory(const std::string& shaderSource, const std::string& entryPoint, const char* target, ID3DBlob** outBlob);
+};
@@ -1,343 +1,280 @@
-#include "Menu.h"
-#include <Dependencies/ImGui/imgui.h>
-#include "../Pipeline/Generation/FrameGeneration.h"
-
-// Helper to check if current settings match a preset
-static int GetBestMatchingPreset(const FrameGeneration::FrameGenSettings& s)
-{
-    // 0: Ultra Performance
-    // Check all relevant settings for Ultra Performance preset
-    if (s.RenderScale == 0.33f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Nearest && 
-        s.EnableAggressiveDynamicMode &&
-        !s.EnableBiDirFlow && !s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 0 && 
-        s.BlockSize == 32 && s.SearchRadius == 4 && s.MaxPyramidLevel == 2 && s.MinPyramidLevel == 2 && 
-        !s.EnableSubPixel && !s.EnableMotionSmoothing &&
-        s.RcasStrength == 0.0f && s.GhostingReduction == 0.0f && !s.EnableEdgeProtection &&
-        s.EnableAsyncCompute && s.LowLatencyMode && s.DisableVSync) return 0;
-        
-    // 1: Performance
-    // Check all relevant settings for Performance preset
-    if (s.RenderScale == 0.5f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Bilinear && 
-        !s.EnableAggressiveDynamicMode &&
-        !s.EnableBiDirFlow && !s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 0 && 
-        s.BlockSize == 16 && s.SearchRadius == 8 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 1 && 
-        !s.EnableSubPixel && !s.EnableMotionSmoothing &&
-        s.RcasStrength == 0.2f && s.GhostingReduction == 0.1f && !s.EnableEdgeProtection) return 1;
-
-    // 2: Balanced
-    // Check all relevant settings for Balanced preset
-    if (s.RenderScale == 0.67f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Bicubic && 
-        !s.EnableAggressiveDynamicMode &&
-        !s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && 
-        s.BlockSize == 16 && s.SearchRadius == 16 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 0 && 
-        s.EnableSubPixel && !s.EnableMotionSmoothing &&
-        s.RcasStrength == 0.5f && s.GhostingReduction == 0.3f && s.EnableEdgeProtection) return 2;
-
-    // 3: Quality
-    // Check all relevant settings for Quality preset
-    if (s.RenderScale == 0.85f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos && 
-        s.LanczosRadius == 2 && !s.EnableAggressiveDynamicMode &&
-        s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && 
-        s.BlockSize == 8 && s.SearchRadius == 24 && s.MaxPyramidLevel == 1 && s.MinPyramidLevel == 0 && 
-        s.EnableSubPixel && s.EnableMotionSmoothing &&
-        s.RcasStrength == 0.7f && s.GhostingReduction == 0.5f && s.EnableEdgeProtection) return 3;
-
-    // 4: Cinematic
-    // Check all relevant settings for Cinematic preset
-    if (s.RenderScale == 1.0f && s.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos && 
-        s.LanczosRadius == 3 && !s.EnableAggressiveDynamicMode &&
-        s.EnableBiDirFlow && s.EnableAdaptiveBlock && s.OpticalFlowAlgorithm == 1 && // Note: Original had DIS, but then changed to Farneback. Using Farneback for preset check.
-        s.BlockSize == 4 && s.SearchRadius == 32 && s.MaxPyramidLevel == 0 && s.MinPyramidLevel == 0 && 
-        s.EnableSubPixel && s.EnableMotionSmoothing &&
-        s.RcasStrength == 0.9f && s.GhostingReduction == 0.8f && s.EnableEdgeProtection) return 4;
-
-    return -1; // Custom
-}
-
-void UI::Menu::Render(bool& open)
-{
-	if (!open) return;
-
-	if (ImGui::Begin("Lufzy's Frame Generation", &open, ImGuiWindowFlags_AlwaysAutoResize))
-	{
-		bool isEnabled = FrameGeneration::Instance().IsEnabled();
-		if (ImGui::Checkbox("Enable", &isEnabled))
-		{
-			FrameGeneration::Instance().SetEnabled(isEnabled);
-		}
-		
-		ImGui::Separator();
-		auto& settings = FrameGeneration::Instance().GetSettings();
-
-        // ---------------------------------------------------------
-        // PRESETS (Common)
-        // ---------------------------------------------------------
-        // Sync UI state with actual settings
-        static int preset = 2; // Default Balanced
-        int detected = GetBestMatchingPreset(settings);
-        
-        if (preset != detected)
-        {
-            preset = detected; 
-        }
-
-        const char* presets[] = { "Ultra Performance", "Performance", "Balanced", "Quality", "Cinematic", "Custom" };
-        int currentComboValue = (preset == -1) ? 5 : preset; // 5 is Custom index
-        
-        if (ImGui::Combo("Performance Profile", &currentComboValue, presets, IM_ARRAYSIZE(presets)))
-        {
-            if (currentComboValue != 5) // If not Custom
-            {
-                preset = currentComboValue;
-                // Apply Preset
-                if (preset == 0) // Ultra Performance
-                {
-                    settings.RenderScale = 0.33f;
-                    settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Nearest;
-                    settings.EnableAggressiveDynamicMode = true; 
-                    
-                    settings.EnableBiDirFlow = false;
-                    settings.EnableAdaptiveBlock = false;
-                    settings.OpticalFlowAlgorithm = 0; // Block Matching
-                    settings.BlockSize = 32; settings.SearchRadius = 4;
-                    settings.MaxPyramidLevel = 2; settings.MinPyramidLevel = 2; // Coarse
-                    settings.EnableSubPixel = false;
-                    settings.EnableMotionSmoothing = false;
-                    
-                    settings.RcasStrength = 0.0f;
-                    settings.GhostingReduction = 0.0f;
-                    settings.EnableEdgeProtection = false;
-                    
-                    settings.EnableAsyncCompute = true;
-                    settings.LowLatencyMode = true;
-                    settings.DisableVSync = true;
-                }
-                else if (preset == 1) // Performance
-                {
-                    settings.RenderScale = 0.5f;
-                    settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Bilinear;
-                    settings.EnableAggressiveDynamicMode = false;
-                    
-                    settings.EnableBiDirFlow = false;
-                    settings.EnableAdaptiveBlock = false;
-                    settings.OpticalFlowAlgorithm = 0; // Block Matching
-                    settings.BlockSize = 16; settings.SearchRadius = 8;
-                    settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 1; // Half Res
-                    settings.EnableSubPixel = false;
-                    settings.EnableMotionSmoothing = false;
-                    
-                    settings.GhostingReduction = 0.1f;
-                    settings.EnableEdgeProtection = false;
-                }
-                else if (preset == 2) // Balanced
-                {
-                    settings.RenderScale = 0.67f;
-                    settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Bicubic;
-                    settings.EnableAggressiveDynamicMode = false;
-                    
-                    settings.EnableBiDirFlow = false;
-                    settings.EnableAdaptiveBlock = true; // [Adaptive]
-                    settings.OpticalFlowAlgorithm = 1; // Farneback (Smoother)
-                    settings.BlockSize = 16; settings.SearchRadius = 16;
-                    settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 0; // Refine to Native
-                    settings.EnableSubPixel = true;
-                    settings.EnableMotionSmoothing = false;
-                    
-                    settings.GhostingReduction = 0.3f;
-                    settings.EnableEdgeProtection = true;
-                }
-                else if (preset == 3) // Quality
-                {
-                    settings.RenderScale = 0.85f; // High but not full
-                    settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Lanczos;
-                    settings.LanczosRadius = 2;
-                    settings.EnableAggressiveDynamicMode = false;
-                    
-                    settings.EnableBiDirFlow = true; // [Bi-Dir]
-                    settings.EnableAdaptiveBlock = true;
-                    settings.OpticalFlowAlgorithm = 1; // Farneback
-                    settings.BlockSize = 8; settings.SearchRadius = 24;
-                    settings.MaxPyramidLevel = 1; settings.MinPyramidLevel = 0;
-                    settings.EnableSubPixel = true;
-                    settings.EnableMotionSmoothing = true; // [Motion Smooth]
-                    
-                    settings.GhostingReduction = 0.5f;
-                    settings.EnableEdgeProtection = true;
-                }
-                else if (preset == 4) // Cinematic
-                {
-                    settings.RenderScale = 1.0f; // Native
-                    settings.UpscaleMode = FrameGeneration::FrameGenSettings::UpscaleType::Lanczos;
-                    settings.LanczosRadius = 3; // Max Sharpness
-                    settings.EnableAggressiveDynamicMode = false;
-                    
-                    settings.EnableBiDirFlow = true;
-                    settings.EnableAdaptiveBlock = true;
-                    settings.OpticalFlowAlgorithm = 1; // Farneback (Still using Farneback as per safe default logic)
-                    
-                    settings.BlockSize = 4; // Detail
-                    settings.SearchRadius = 32; // Wide
-                    settings.MaxPyramidLevel = 0; settings.MinPyramidLevel = 0; // Full Search
-                    settings.EnableSubPixel = true;
-                    settings.EnableMotionSmoothing = true;
-                    
-                    settings.GhostingReduction = 0.8f;
-                    settings.EnableEdgeProtection = true;
-                }
-            }
-        }
-        
-        ImGui::Dummy(ImVec2(0, 5));
-        
-        // ---------------------------------------------------------
-        // DETAILED TABS
-        // ---------------------------------------------------------
-		if (ImGui::BeginTabBar("LFG_Tabs"))
-		{
-			// [Tab 1: Pipeline]
-			if (ImGui::BeginTabItem("Pipeline"))
-			{
-                ImGui::Spacing();
-                ImGui::Text("Optical Flow");
-				const char* flowAlgos[] = { "Block Matching", "Farneback", "DIS" };
-				ImGui::Combo("Algorithm", &settings.OpticalFlowAlgorithm, flowAlgos, IM_ARRAYSIZE(flowAlgos));
-                
-				ImGui::SliderInt("Block Size", &settings.BlockSize, 4, 32);
-				ImGui::SliderInt("Search Radius", &settings.SearchRadius, 4, 32);
-				ImGui::Checkbox("Sub-Pixel Flow", &settings.EnableSubPixel);
-                
-                ImGui::Text("Pyramid Levels");
-                ImGui::SliderInt("Start Level", &settings.MaxPyramidLevel, 0, 4, "Level %d");
-                if (ImGui::IsItemHovered()) ImGui::SetTooltip("0 = Full Res (Slow), 1 = Half, 2 = Quarter...\nHigher start means coarser initial search.");
-                
-                ImGui::SliderInt("End Level", &settings.MinPyramidLevel, 0, settings.MaxPyramidLevel, "Level %d");
-                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Lowest level to search.\n0 = Refine to Full Res, 1 = Stop at Half Res.");
-                
-				ImGui::Separator();
-				ImGui::Text("Resolution & Scaling");
-				
-                const char* upscaleModes[] = { "Native", "Nearest", "Bilinear", "Bicubic", "Lanczos" };
-				int currentMode = (int)settings.UpscaleMode;
-				if (ImGui::Combo("Upscale Method", &currentMode, upscaleModes, IM_ARRAYSIZE(upscaleModes)))
-                {
-					settings.UpscaleMode = (FrameGeneration::FrameGenSettings::UpscaleType)currentMode;
-                    // Force Native Scale if Native Mode selected
-                    if (settings.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Native)
-                    {
-                        settings.RenderScale = 1.0f;
-                    }
-                }
-
-                // Only show Render Scale if NOT Native
-                if (settings.UpscaleMode != FrameGeneration::FrameGenSettings::UpscaleType::Native)
-                {
-    				if (ImGui::SliderFloat("Render Scale", &settings.RenderScale, 0.1f, 1.0f, "%.2fx"))
-    				{
-    					if (settings.RenderScale > 0.99f) settings.RenderScale = 1.0f;
-    				}
-                }
-                    
-				if (settings.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos)
-					ImGui::SliderInt("Lanczos Radius", &settings.LanczosRadius, 1, 4);
-                    
-                ImGui::Separator();
-                ImGui::Text("Advanced Quality");
-                ImGui::Checkbox("Bi-Directional Flow", &settings.EnableBiDirFlow);
-				ImGui::Checkbox("Adaptive Block Size", &settings.EnableAdaptiveBlock);
-				ImGui::Checkbox("Motion Smoothing", &settings.EnableMotionSmoothing); // Post-process vector smooth
-
-                ImGui::EndTabItem();
-            }
-
-			// [Tab 2: Post-Process]
-			if (ImGui::BeginTabItem("PostFX"))
-			{
-				ImGui::Spacing();
-				ImGui::Text("Visual Enhancements");
-
-				ImGui::SliderFloat("Sharpening (RCAS)", &settings.RcasStrength, 0.0f, 1.0f, "%.2f");
-				ImGui::SliderFloat("Ghosting Reduction", &settings.GhostingReduction, 0.0f, 1.0f, "%.2f");
-				
-				ImGui::Separator();
-				ImGui::Checkbox("Edge Protection (Sobel)", &settings.EnableEdgeProtection);
-				ImGui::SliderInt("Scene Change Threshold", &settings.SceneChangeThreshold, 0, 5000);
-
-				ImGui::EndTabItem();
-			}
-            
-            // [Tab 3: System]
-            if (ImGui::BeginTabItem("System"))
-            {
-                ImGui::Spacing();
-                ImGui::Text("Generation");
-                const char* multiModes[] = { "Off", "2x (1 Frame)", "3x (2 Frames)", "4x (3 Frames)", "Dynamic" };
-                int currentGenMode = settings.EnableDynamicRatio ? 4 : settings.MultiFrameCount;
-                
-                if (ImGui::Combo("Generation Mode", &currentGenMode, multiModes, IM_ARRAYSIZE(multiModes)))
-                {
-                    if (currentGenMode == 4)
-                    {
-                        settings.EnableDynamicRatio = true;
-                    }
-                    else
-                    {
-                        settings.EnableDynamicRatio = false;
-                        settings.MultiFrameCount = currentGenMode;
-                        settings.EnableAggressiveDynamicMode = false;
-                    }
-                }
-
-				if (settings.EnableDynamicRatio)
-				{
-					ImGui::SliderInt("Dynamic Target", &settings.DynamicTargetFPS, 30, 1000);
-                    
-                    // Added Aggressive Mode Checkbox here as well
-                    ImGui::Checkbox("Aggressive Mode (6x)", &settings.EnableAggressiveDynamicMode);
-                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("Allows generating up to 6 frames if needed to reach target.");
-				}
-
-                ImGui::Separator();
-
-                ImGui::Checkbox("Limit FPS", &settings.FPSCap);
-				if (settings.FPSCap)
-				{
-					ImGui::SliderInt("Limit", &settings.TargetFPS, 0, 1000);
-                    const char* capModes[] = { "Native", "Display" };
-					int currentMode = (int)settings.CapMode;
-					if (ImGui::Combo("Cap Mode", &currentMode, capModes, IM_ARRAYSIZE(capModes)))
-						settings.CapMode = (FrameGeneration::FrameGenSettings::FpsCapMode)currentMode;
-                }   
-                
-                ImGui::Separator();
-                ImGui::Checkbox("Disable VSync", &settings.DisableVSync);
-                ImGui::Checkbox("Low Latency Mode", &settings.LowLatencyMode);
-                ImGui::Checkbox("Async Compute", &settings.EnableAsyncCompute);
-                
-                ImGui::EndTabItem();
-            }
-
-			// [Tab 4: Debug]
-			if (ImGui::BeginTabItem("Debug"))
-			{
-				ImGui::Checkbox("Split-Screen Comparison", &settings.EnableSplitScreen);
-				if (settings.EnableSplitScreen) ImGui::SliderFloat("Split Pos", &settings.SplitScreenPosition, 0.0f, 1.0f);
-
-				ImGui::Checkbox("Overlay", &settings.ShowDebugOverlay);
-				const char* debugModes[] = { "Off", "Motion Vectors", "HUD Mask" };
-				ImGui::Combo("View Mode", &settings.DebugViewMode, debugModes, IM_ARRAYSIZE(debugModes));
-
-				ImGui::SliderFloat("Motion Sensitivity", &settings.MotionSensitivity, 0.1f, 5.0f, "%.1f");
-				ImGui::SliderFloat("HUD Threshold", &settings.HUDThreshold, 0.0f, 0.2f, "%.3f");
-
-				ImGui::EndTabItem();
-			}
-
-			ImGui::EndTabBar();
-        }
-        
-        ImGui::Dummy(ImVec2(0, 5));
-        ImGui::Separator();
-        ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 0.8f), "github.com/furkan-1337");
-	}
-	ImGui::End();
-}
+#include "Menu.h"
+#include <Dependencies/ImGui/imgui.h>
+#include "../Pipeline/Generation/FrameGeneration.h"
+#include "../Pipeline/Generation/Presets.h"
+
+void UI::Menu::Render(bool& open)
+{
+	if (!open) return;
+
+	if (ImGui::Begin("Lufzy's Frame Generation", &open, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		bool isEnabled = FrameGeneration::Instance().IsEnabled();
+		if (ImGui::Checkbox("Enable", &isEnabled))
+		{
+			FrameGeneration::Instance().SetEnabled(isEnabled);
+		}
+		
+		ImGui::Separator();
+		auto& settings = FrameGeneration::Instance().GetSettings();
+
+        // ---------------------------------------------------------
+        // PRESETS (Common)
+        // ---------------------------------------------------------
+        // Sync UI state with actual settings
+        static int preset = 2; // Default Balanced
+        int detected = Presets::Match(settings);
+        
+        if (preset != detected)
+        {
+            preset = detected; 
+        }
+
+        const char* presets[] = { "Ultra Performance", "Performance", "Balanced", "Quality", "Cinematic", "Custom" };
+        int currentComboValue = (preset == -1) ? 5 : preset; // 5 is Custom index
+        
+        if (ImGui::Combo("Performance Profile", &currentComboValue, presets, IM_ARRAYSIZE(presets)))
+        {
+            if (currentComboValue != 5) // If not Custom
+            {
+                preset = currentComboValue;
+                // Apply Preset
+                Presets::Apply(preset, settings);
+            }
+        }
+
+        ImGui::Checkbox("Auto-Tune", &settings.EnableAutoTune);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Tries every profile (and a Render Scale step above and below each) on the running game for a few seconds,\nthen keeps the one with the least warp error whose GPU time fits Generation Budget.\nStored per game and resolution, calibrated again only on request.");
+        if (settings.EnableAutoTune)
+        {
+            const AutoTuner& tuner = FrameGeneration::Instance().GetAutoTuner();
+            ImGui::SliderFloat("Generation Budget##AutoTune", &settings.GenerationBudget, 1.0f, 16.0f, "%.1f ms");
+            if (tuner.IsRunning())
+            {
+                ImGui::Text("Calibrating... %d%%", (int)(tuner.GetProgress() * 100.0f));
+            }
+            else
+            {
+                // The profile runs over the settings below, they stay as set
+                if (const AutoTuner::Candidate* tune = FrameGeneration::Instance().GetAppliedTune())
+                    ImGui::Text("Running %s at %.2fx", Presets::Names[tune->Preset], tune->RenderScale);
+                if (ImGui::Button("Recalibrate"))
+                {
+                    FrameGeneration::Instance().RequestCalibration();
+                }
+            }
+        }
+
+        ImGui::Dummy(ImVec2(0, 5));
+        
+        // ---------------------------------------------------------
+        // DETAILED TABS
+        // ---------------------------------------------------------
+		if (ImGui::BeginTabBar("LFG_Tabs"))
+		{
+			// [Tab 1: Pipeline]
+			if (ImGui::BeginTabItem("Pipeline"))
+			{
+                ImGui::Spacing();
+                ImGui::Text("Optical Flow");
+				const char* flowAlgos[] = { "Block Matching", "Farneback", "DIS", "3DRS", "Hybrid" };
+				ImGui::Combo("Algorithm", &settings.OpticalFlowAlgorithm, flowAlgos, IM_ARRAYSIZE(flowAlgos));
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("3DRS: Recursive search, a few candidate vectors per block (Block Size) instead of a full window.\nIgnores Search Radius and Pyramid Levels, converges over a few frames.\nHybrid: Block Matching, Farneback or DIS per 16x16 tile, picked from last frame's residual and motion spread.");
+                
+				ImGui::SliderInt("Block Size", &settings.BlockSize, 4, 32);
+				ImGui::SliderInt("Search Radius", &settings.SearchRadius, 4, 32);
+				ImGui::Checkbox("Sub-Pixel Flow", &settings.EnableSubPixel);
+				ImGui::Checkbox("Temporal Warm-Start", &settings.EnableTemporalWarmStart);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Seeds the search with last frame's motion.\nWhen the prediction holds, coarse levels are skipped and the search radius shrinks.");
+				ImGui::Checkbox("Global Motion", &settings.EnableGlobalMotion);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Fits the camera motion (pan / zoom / roll) to last frame's vectors and seeds the pyramid with it.\nThe search only corrects what moves on its own; pans beyond Search Radius are found by phase correlation.\nBlock Matching / Farneback / DIS / Hybrid with Adaptive Block Size and Bi-Directional Flow off.");
+				ImGui::Checkbox("Phase Correlation", &settings.EnablePhaseCorrelation);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Correlates 16x16 tiles of the quarter res luma in the frequency domain; each tile's two strongest shifts\nare tested by the coarsest search level. Catches flicks far beyond Search Radius at a fixed cost.\nSame modes as Global Motion.");
+				ImGui::Checkbox("Adaptive Radius", &settings.EnableAdaptiveRadius);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Sizes the search from last frame's motion (95th percentile vector length plus a margin), capped by Search Radius.\nSlow scenes search fewer pixels and pyramid levels; the coarsest level is also bounded per 16x16 tile.\nOpens up to Search Radius for a few frames when the warp residual spikes.\nNot with 3DRS or Block Motion.");
+                
+                ImGui::Text("Pyramid Levels");
+                ImGui::SliderInt("Start Level", &settings.MaxPyramidLevel, 0, 4, "Level %d");
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("0 = Full Res (Slow), 1 = Half, 2 = Quarter...\nHigher start means coarser initial search.\nEvery level searches Search Radius >> Start Level pixels: deep pyramids catch fast pans with a small window.");
+                
+                ImGui::SliderInt("End Level", &settings.MinPyramidLevel, 0, settings.MaxPyramidLevel, "Level %d");
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Lowest level to search.\n0 = Refine to Full Res, 1 = Stop at Half Res.\nLevels below it are upsampled edge-aware (guided by the full res luma).");
+                
+				ImGui::Separator();
+				ImGui::Text("Resolution & Scaling");
+				
+                const char* upscaleModes[] = { "Native", "Nearest", "Bilinear", "Bicubic", "Lanczos" };
+				int currentMode = (int)settings.UpscaleMode;
+				if (ImGui::Combo("Upscale Method", &currentMode, upscaleModes, IM_ARRAYSIZE(upscaleModes)))
+                {
+					settings.UpscaleMode = (FrameGeneration::FrameGenSettings::UpscaleType)currentMode;
+                    // Force Native Scale if Native Mode selected
+                    if (settings.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Native)
+                    {
+                        settings.RenderScale = 1.0f;
+                    }
+                }
+
+                // Only show Render Scale if NOT Native
+                if (settings.UpscaleMode != FrameGeneration::FrameGenSettings::UpscaleType::Native)
+                {
+    				if (ImGui::SliderFloat("Render Scale", &settings.RenderScale, 0.1f, 1.0f, "%.2fx"))
+    				{
+    					if (settings.RenderScale > 0.99f) settings.RenderScale = 1.0f;
+    				}
+
+                    ImGui::Checkbox("Dynamic Resolution", &settings.EnableDynamicResolution);
+                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("Render Scale becomes the top step: the flow resolution steps down (each step ~71%% of the area, down to 0.33x)\nwhile the measured GPU time of the generation stays over the budget, and back up once the next step fits with room to spare.");
+                    if (settings.EnableDynamicResolution)
+                    {
+                        ImGui::SliderFloat("Generation Budget", &settings.GenerationBudget, 1.0f, 16.0f, "%.1f ms");
+                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("GPU time per real frame: the flow plus every generated frame.");
+                    }
+                }
+                    
+				if (settings.UpscaleMode == FrameGeneration::FrameGenSettings::UpscaleType::Lanczos)
+					ImGui::SliderInt("Lanczos Radius", &settings.LanczosRadius, 1, 4);
+
+                ImGui::Checkbox("Native Resolution Synthesis", &settings.EnableNativeSynthesis);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Flow runs at Render Scale, generated frames are warped at native resolution.\nOff: generate at Render Scale and upscale every frame (real frames too).");
+                    
+                ImGui::Separator();
+                ImGui::Text("Advanced Quality");
+                ImGui::Checkbox("Bi-Directional Flow", &settings.EnableBiDirFlow);
+                if (settings.EnableBiDirFlow)
+                {
+                    ImGui::Checkbox("Occlusion-Aware Blend", &settings.EnableOcclusionBlend);
+                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("Uncovered / covered pixels take only the frame they are visible in.\nGhosting Reduction is skipped where forward and backward flow agree.");
+                    ImGui::Checkbox("Invert Backward Flow", &settings.EnableFlowInversion);
+                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("With Windowed Matching Cost: derive the backward flow from the forward one\ninstead of a second full search (only holes and poor matches are searched).");
+                }
+				ImGui::Checkbox("Adaptive Block Size", &settings.EnableAdaptiveBlock);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Quadtree search: flat areas keep 32x32 / 16x16 blocks, detailed areas split down to 4x4.");
+				ImGui::Checkbox("Motion Smoothing", &settings.EnableMotionSmoothing); // Post-process vector smooth
+				ImGui::Checkbox("Forward-Splat Warp", &settings.EnableForwardWarp);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Interpolation: project the motion to the generated frame's time before warping,\nso each pixel uses the vector of the content actually there (less ghosting on moving edges).");
+				ImGui::Checkbox("Block Motion Field", &settings.EnableBlockMotion);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Block Matching / 3DRS: one vector per Block Size block, sampled bilinearly when generating.\nMuch less search work and memory. Needs Adaptive Block Size and Bi-Directional Flow off.");
+
+				ImGui::Checkbox("Windowed Matching Cost", &settings.EnableCostAggregation);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Block Matching: compare a Block Size window around each pixel instead of the pixel alone.\nMuch more robust on noise and flat areas, same cost for any Block Size (1 - 32).");
+
+                ImGui::Checkbox("Quality Ladder", &settings.EnableQualityLadder);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("While the GPU time of the generation exceeds Ladder Budget of the real frame interval, gives up in turn:\nBi-Directional Flow, Sub-Pixel, Edge Protection, Motion Smoothing, the finest pyramid level, then anything above 2x.\nRestored in reverse order once the last one fits again. Your settings are not changed.");
+                if (settings.EnableQualityLadder)
+                {
+                    ImGui::SliderFloat("Ladder Budget", &settings.LadderBudget, 0.1f, 1.0f, "%.2f x frame");
+                    const QualityLadder& ladder = FrameGeneration::Instance().GetQualityLadder();
+                    int last = ladder.GetLastDropped();
+                    ImGui::Text("Dropped: %d%s%s", ladder.GetDroppedCount(), last >= 0 ? ", last " : "", last >= 0 ? QualityLadder::Rungs[last].Name : "");
+                }
+
+                ImGui::EndTabItem();
+            }
+
+			// [Tab 2: Post-Process]
+			if (ImGui::BeginTabItem("PostFX"))
+			{
+				ImGui::Spacing();
+				ImGui::Text("Visual Enhancements");
+
+				ImGui::SliderFloat("Sharpening (RCAS)", &settings.RcasStrength, 0.0f, 1.0f, "%.2f");
+				ImGui::SliderFloat("Ghosting Reduction", &settings.GhostingReduction, 0.0f, 1.0f, "%.2f");
+				
+				ImGui::Separator();
+				ImGui::Checkbox("Edge Protection (Sobel)", &settings.EnableEdgeProtection);
+				ImGui::SliderInt("Scene Change Threshold", &settings.SceneChangeThreshold, 0, 5000);
+				ImGui::Checkbox("Early Scene Cut Detection", &settings.EnableSceneCutPrepass);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Compare thumbnail histograms before motion estimation.\nOn a cut (loading screens, menus, camera cuts) flow and generation are skipped entirely.");
+
+				ImGui::Checkbox("Static Tile Skip", &settings.EnableTileSkip);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Classify the frame in 16x16 tiles: only tiles with motion or change are warped and sharpened.\nStatic tiles (HUD, still backgrounds) are copied from the real frame.");
+
+				ImGui::Checkbox("Unchanged Tile Skip", &settings.EnableTileHash);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Hash every 16x16 tile of the captured frame: tiles identical to the last frame get zero motion without a search.\nDuplicate frames (no tile changed) skip flow and generation, the real frame is shown again.");
+
+				ImGui::EndTabItem();
+			}
+            
+            // [Tab 3: System]
+            if (ImGui::BeginTabItem("System"))
+            {
+                ImGui::Spacing();
+                ImGui::Text("Generation");
+                const char* multiModes[] = { "Off", "2x (1 Frame)", "3x (2 Frames)", "4x (3 Frames)", "Dynamic" };
+                int currentGenMode = settings.EnableDynamicRatio ? 4 : settings.MultiFrameCount;
+                
+                if (ImGui::Combo("Generation Mode", &currentGenMode, multiModes, IM_ARRAYSIZE(multiModes)))
+                {
+                    if (currentGenMode == 4)
+                    {
+                        settings.EnableDynamicRatio = true;
+                    }
+                    else
+                    {
+                        settings.EnableDynamicRatio = false;
+                        settings.MultiFrameCount = currentGenMode;
+                        settings.EnableAggressiveDynamicMode = false;
+                    }
+                }
+
+                const char* genTypes[] = { "Interpolation", "Extrapolation (Low Latency)" };
+                int currentGenType = (int)settings.GenerationMode;
+                if (ImGui::Combo("Generation Type", &currentGenType, genTypes, IM_ARRAYSIZE(genTypes)))
+                    settings.GenerationMode = (FrameGeneration::FrameGenSettings::GenerationType)currentGenType;
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("Interpolation holds the real frame back by one frame.\nExtrapolation predicts past the latest real frame (no added latency, some artifacts at disocclusions).");
+
+				if (settings.EnableDynamicRatio)
+				{
+					ImGui::SliderInt("Dynamic Target", &settings.DynamicTargetFPS, 30, 1000);
+                    
+                    // Added Aggressive Mode Checkbox here as well
+                    ImGui::Checkbox("Aggressive Mode (6x)", &settings.EnableAggressiveDynamicMode);
+                    if (ImGui::IsItemHovered()) ImGui::SetTooltip("Allows generating up to 6 frames if needed to reach target.");
+				}
+
+                ImGui::Separator();
+
+                ImGui::Checkbox("Limit FPS", &settings.FPSCap);
+				if (settings.FPSCap)
+				{
+					ImGui::SliderInt("Limit", &settings.TargetFPS, 0, 1000);
+                    const char* capModes[] = { "Native", "Display" };
+					int currentMode = (int)settings.CapMode;
+					if (ImGui::Combo("Cap Mode", &currentMode, capModes, IM_ARRAYSIZE(capModes)))
+						settings.CapMode = (FrameGeneration::FrameGenSettings::FpsCapMode)currentMode;
+                }   
+                
+                ImGui::Separator();
+                ImGui::Checkbox("Disable VSync", &settings.DisableVSync);
+                ImGui::Checkbox("Low Latency Mode", &settings.LowLatencyMode);
+                ImGui::Checkbox("Async Compute", &settings.EnableAsyncCompute);
+                
+                ImGui::EndTabItem();
+            }
+
+			// [Tab 4: Debug]
+			if (ImGui::BeginTabItem("Debug"))
+			{
+				ImGui::Checkbox("Split-Screen Comparison", &settings.EnableSplitScreen);
+				if (settings.EnableSplitScreen) ImGui::SliderFloat("Split Pos", &settings.SplitScreenPosition, 0.0f, 1.0f);
+
+				ImGui::Checkbox("Overlay", &settings.ShowDebugOverlay);
+				const char* debugModes[] = { "Off", "Motion Vectors", "HUD Mask" };
+				ImGui::Combo("View Mode", &settings.DebugViewMode, debugModes, IM_ARRAYSIZE(debugModes));
+
+				ImGui::SliderFloat("Motion Sensitivity", &settings.MotionSensitivity, 0.1f, 5.0f, "%.1f");
+				ImGui::SliderFloat("HUD Threshold", &settings.HUDThreshold, 0.0f, 0.2f, "%.3f");
+
+				ImGui::EndTabItem();
+			}
+
+			ImGui::EndTabBar();
+        }
+        
+        ImGui::Dummy(ImVec2(0, 5));
+        ImGui::Separator();
+        ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 0.8f), "github.com/furkan-1337");
+	}
+	ImGui::End();
+}
@@ -1,10 +1,10 @@
-#pragma once
-
-namespace UI
-{
-	class Menu
-	{
-	public:
-		static void Render(bool& isOpen);
-	};
-}
+#pragma once
+
+namespace UI
+{
+	class Menu
+	{
+	public:
+		static void Render(bool& isOpen);
+	};
+}
@@ -0,0 +1,125 @@
+#include "TestCommon.h"
+#include <Pipeline/OpticalFlow/AdaptiveRadius.h>
+#include <Pipeline/OpticalFlow/PyramidSchedule.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// [Adaptive Radius] AdaptiveRadius replayed on CS_MotionStats readbacks of a synthetic scene: every vector 'Motion'
+// pixels long, cut short by the window it was searched with, a few stray zero vectors, and a mean residual.
+static constexpr int MaxRadius = 32;
+static constexpr int Vectors = 1000;
+static constexpr int Strays = 5;
+
+struct Scene
+{
+	float Motion = 0.0f;
+	float Residual = 0.01f;
+};
+
+static std::vector<uint32_t> Readback(const Scene& scene, int searchedRadius)
+{
+	std::vector<uint32_t> readback(AdaptiveRadius::ReadbackSize, 0);
+	const float length = std::min(scene.Motion, (float)searchedRadius);
+	readback[std::min((int)length, AdaptiveRadius::HistogramBins - 1)] += Vectors - Strays;
+	readback[0] += Strays;
+	std::memcpy(&readback[AdaptiveRadius::ReadbackMax], &length, sizeof(float));
+	const uint32_t tiles = 100;
+	readback[AdaptiveRadius::ReadbackResidual] = (uint32_t)std::lround(scene.Residual * AdaptiveRadius::ResidualScale * tiles);
+	readback[AdaptiveRadius::ReadbackTiles] = tiles;
+	return readback;
+}
+
+// Searches 'frames' frames with the current reach, feeds back what was measured and returns the reach of every frame
+static std::vector<int> Replay(AdaptiveRadius& radius, const Scene& scene, int frames)
+{
+	std::vector<int> reach;
+	for (int frame = 0; frame < frames; ++frame)
+	{
+		const int searched = radius.GetRadius(MaxRadius);
+		reach.push_back(searched);
+		radius.Update(AdaptiveRadius::Summarize(Readback(scene, searched).data()), searched, MaxRadius);
+	}
+	return reach;
+}
+
+static void Print(const char* name, const std::vector<int>& reach)
+{
+	std::printf("%-10s", name);
+	for (int r : reach) std::printf(" %d", r);
+	std::printf("\n");
+}
+
+int main()
+{
+	// Nothing measured: the full reach
+	{
+		AdaptiveRadius radius;
+		CHECK(radius.GetRadius(MaxRadius) == MaxRadius && !radius.TileBounds());
+		CHECK(!AdaptiveRadius::Summarize(nullptr).Valid);
+		CHECK(!AdaptiveRadius::Summarize(std::vector<uint32_t>(AdaptiveRadius::ReadbackSize, 0).data()).Valid);
+	}
+
+	// Static scene: after a cleared readback (full reach for OpenFrames frames) the reach shrinks ShrinkStep a frame
+	// and settles at +-Padding
+	{
+		AdaptiveRadius radius;
+		radius.Update({}, MaxRadius, MaxRadius);
+		const std::vector<int> reach = Replay(radius, {}, 60);
+		Print("static", reach);
+		for (int frame = 0; frame < AdaptiveRadius::OpenFrames; ++frame) CHECK(reach[frame] == MaxRadius);
+		for (size_t frame = AdaptiveRadius::OpenFrames + 1; frame < reach.size(); ++frame)
+			CHECK(reach[frame] == std::max(reach[frame - 1] - AdaptiveRadius::ShrinkStep, AdaptiveRadius::Padding));
+		CHECK(reach.back() == AdaptiveRadius::Padding && AdaptiveRadius::Padding >= Pyramid::MinSearchRadius);
+		CHECK(radius.TileBounds());
+	}
+
+	// Saturated histogram: a 20 pixel pan found with the +-Padding reach of a static scene. While the vectors pile up
+	// at the window's edge the reach at least doubles every frame, then it settles just above the motion
+	{
+		AdaptiveRadius radius;
+		Replay(radius, {}, 40);
+		CHECK(radius.GetRadius(MaxRadius) == AdaptiveRadius::Padding);
+		const Scene pan{ 20.0f };
+		const std::vector<int> reach = Replay(radius, pan, 20);
+		Print("saturated", reach);
+		int grown = 0;
+		while (grown + 1 < (int)reach.size() && reach[grown] < pan.Motion + 1)
+		{
+			CHECK(reach[grown + 1] >= std::min(2 * reach[grown], MaxRadius));
+			++grown;
+		}
+		CHECK(grown <= 4);
+		for (size_t frame = grown; frame < reach.size(); ++frame) CHECK(reach[frame] > pan.Motion);
+		CHECK(reach.back() == (int)std::ceil(pan.Motion * AdaptiveRadius::Margin) + AdaptiveRadius::Padding);
+	}
+
+	// Residual spike: a residual above SpikeRatio times its running average opens the full reach for OpenFrames
+	// frames (no per-tile bounds meanwhile), then it shrinks back. Below the ratio or the floor it stays put
+	{
+		AdaptiveRadius radius;
+		const Scene settled{ 0.0f, 0.03f };
+		Replay(radius, settled, 40);
+		CHECK(radius.GetRadius(MaxRadius) == AdaptiveRadius::Padding);
+
+		Replay(radius, { 0.0f, settled.Residual * AdaptiveRadius::SpikeRatio * 0.9f }, 1);
+		CHECK(radius.GetRadius(MaxRadius) == AdaptiveRadius::Padding && radius.TileBounds());
+
+		Replay(radius, { 0.0f, settled.Residual * AdaptiveRadius::SpikeRatio * 1.5f }, 1);
+		CHECK(radius.GetRadius(MaxRadius) == MaxRadius && !radius.TileBounds());
+		const std::vector<int> reach = Replay(radius, settled, 12);
+		Print("spike", reach);
+		for (int frame = 0; frame < AdaptiveRadius::OpenFrames; ++frame) CHECK(reach[frame] == MaxRadius);
+		CHECK(reach[AdaptiveRadius::OpenFrames] == MaxRadius - AdaptiveRadius::ShrinkStep);
+		CHECK(radius.TileBounds());
+
+		AdaptiveRadius quiet;
+		const float floor = AdaptiveRadius::SpikeFloor * 0.25f;
+		Replay(quiet, { 0.0f, floor }, 40);
+		Replay(quiet, { 0.0f, AdaptiveRadius::SpikeFloor * 0.9f }, 1);
+		CHECK(quiet.GetRadius(MaxRadius) == AdaptiveRadius::Padding);
+	}
+
+	return Test::Result();
+}
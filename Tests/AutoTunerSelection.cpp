@@ -0,0 +1,233 @@
+#include "TestCommon.h"
+#include <Pipeline/Generation/AutoTuner.h>
+#include <Pipeline/Generation/ScaleController.h>
+#include <clocale>
+#include <filesystem>
+#include <fstream>
+#include <locale>
+#include <vector>
+
+// [Auto-Tune] BuildCandidates around the preset scales, Select on recorded blocks, a live calibration with lagged,
+// noisy and missing samples, and the results file. Candidate cost grows with the preset and the area, the error
+// falls with both.
+static constexpr float PresetScales[] = { 0.33f, 0.5f, 0.67f, 0.85f, 1.0f }; // Presets::RenderScales
+static constexpr int PresetCount = (int)std::size(PresetScales);
+
+struct DecimalComma : std::numpunct<char>
+{
+	char do_decimal_point() const override { return ','; }
+};
+
+static float Cost(const AutoTuner::Candidate& c)
+{
+	static constexpr float PresetCost[PresetCount] = { 1.0f, 1.6f, 2.6f, 4.5f, 7.0f };
+	return PresetCost[c.Preset] * c.RenderScale * c.RenderScale * 2.0f + 0.3f;
+}
+
+static float Error(const AutoTuner::Candidate& c)
+{
+	static constexpr float PresetError[PresetCount] = { 0.05f, 0.04f, 0.03f, 0.022f, 0.018f };
+	return PresetError[c.Preset] * (1.3f - 0.3f * c.RenderScale);
+}
+
+// Both rounds of every candidate, round 1 on content with 1.6x the error
+static std::vector<AutoTuner::Measurement> Record(const std::vector<AutoTuner::Candidate>& candidates)
+{
+	std::vector<AutoTuner::Measurement> measurements;
+	for (int round = 0; round < AutoTuner::Rounds; ++round)
+	{
+		for (int c = 0; c < (int)candidates.size(); ++c)
+			measurements.push_back({ c, round, Cost(candidates[c]), Error(candidates[c]) * (round ? 1.6f : 1.0f) });
+	}
+	return measurements;
+}
+
+// Lowest error within the budget, -1 when nothing fits
+static int BestFit(const std::vector<AutoTuner::Candidate>& candidates, float budget)
+{
+	int best = -1;
+	for (int c = 0; c < (int)candidates.size(); ++c)
+	{
+		if (Cost(candidates[c]) <= budget && (best < 0 || Error(candidates[c]) < Error(candidates[best]))) best = c;
+	}
+	return best;
+}
+
+int main()
+{
+	const std::vector<AutoTuner::Candidate> candidates = AutoTuner::BuildCandidates(PresetScales, PresetCount);
+	std::printf("%zu candidates:", candidates.size());
+	for (const AutoTuner::Candidate& c : candidates) std::printf(" %d@%.2f", c.Preset, c.RenderScale);
+	std::printf("\n");
+
+	// Every preset at its scale and a step either side, within MinScale - 1 and without duplicates
+	for (int preset = 0; preset < PresetCount; ++preset)
+	{
+		int count = 0;
+		bool own = false;
+		for (const AutoTuner::Candidate& c : candidates)
+		{
+			if (c.Preset != preset) continue;
+			++count;
+			own |= c.RenderScale == PresetScales[preset];
+			CHECK(c.RenderScale <= 1.0f && c.RenderScale >= ScaleController::MinScale);
+		}
+		CHECK(own);
+		// No step below the lowest preset, none above 1
+		const int expected = 1 + (PresetScales[preset] < 1.0f) + (PresetScales[preset] * ScaleController::StepRatio >= ScaleController::MinScale);
+		CHECK(count == expected);
+	}
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		for (size_t j = i + 1; j < candidates.size(); ++j)
+			CHECK(candidates[i].Preset != candidates[j].Preset || std::fabs(candidates[i].RenderScale - candidates[j].RenderScale) >= 0.01f);
+	}
+	// A step up clamped onto the preset's own scale is the same candidate, presets sharing a scale are not
+	{
+		const float nearFull[] = { 0.995f };
+		CHECK(AutoTuner::BuildCandidates(nearFull, 1).size() == 2);
+		const float shared[] = { 0.5f, 0.5f };
+		CHECK(AutoTuner::BuildCandidates(shared, 2).size() == 6);
+	}
+
+	// Select: the lowest error that fits, within ErrorTolerance of the best one found by brute force
+	const std::vector<AutoTuner::Measurement> recorded = Record(candidates);
+	for (float budget : { 0.5f, 1.0f, 2.0f, 4.0f, 8.0f, 20.0f })
+	{
+		const int selected = AutoTuner::Select(recorded, (int)candidates.size(), budget);
+		const int best = BestFit(candidates, budget);
+		std::printf("budget %5.1f ms -> %d@%.2f cost %.2f error %.4f (best %d)\n", budget, candidates[selected].Preset,
+			candidates[selected].RenderScale, Cost(candidates[selected]), Error(candidates[selected]), best);
+		if (best >= 0)
+		{
+			CHECK(Cost(candidates[selected]) <= budget);
+			CHECK(Error(candidates[selected]) <= Error(candidates[best]) * (1.0f + AutoTuner::ErrorTolerance));
+		}
+		else
+		{
+			// Nothing fits: the cheapest
+			for (const AutoTuner::Candidate& c : candidates) CHECK(Cost(candidates[selected]) <= Cost(c));
+		}
+	}
+	CHECK(AutoTuner::Select({}, (int)candidates.size(), 4.0f) == -1);
+
+	// Errors compare within a round: a candidate only measured on the harder content is not worse for it
+	{
+		std::vector<AutoTuner::Measurement> rounds = {
+			{ 0, 0, 1.0f, 0.010f }, { 1, 0, 1.0f, 0.020f },
+			{ 0, 1, 1.0f, 0.040f }, { 1, 1, 1.0f, 0.080f }, { 2, 1, 1.0f, 0.030f },
+		};
+		CHECK(AutoTuner::Select(rounds, 3, 2.0f) == 2);
+	}
+
+	// Near ties go to the cheaper candidate, clear wins do not
+	{
+		std::vector<AutoTuner::Measurement> tie = { { 0, 0, 3.0f, 0.0500f }, { 1, 0, 2.0f, 0.0505f }, { 2, 0, 1.0f, 0.0600f } };
+		CHECK(AutoTuner::Select(tie, 3, 4.0f) == 1);
+		// Out of budget it can't win the tie
+		CHECK(AutoTuner::Select(tie, 3, 1.5f) == 2);
+		// Candidates without a block are never picked
+		CHECK(AutoTuner::Select(tie, 5, 4.0f) == 1);
+	}
+
+	// Live calibration: samples arrive 4 frames late (timestamps in flight), some are missing (scene cuts, a
+	// disjoint timer), with noise and the content drifting
+	{
+		AutoTuner tuner;
+		tuner.Start(candidates, 4.0f);
+		std::mt19937 rng(5);
+		std::normal_distribution<float> noise(1.0f, 0.06f);
+		AutoTuner::Candidate current = tuner.GetCurrent();
+		AutoTuner::Candidate lag[5];
+		for (AutoTuner::Candidate& l : lag) l = current;
+		int frames = 0;
+		int switches = 0;
+		while (tuner.IsRunning() && frames < 5000)
+		{
+			++frames;
+			const float drift = 1.0f + 0.5f * std::sin(frames * 0.01f);
+			const AutoTuner::Candidate measured = lag[4];
+			for (int i = 4; i > 0; --i) lag[i] = lag[i - 1];
+			lag[0] = current;
+			if (tuner.Update(frames % 7 != 0, Cost(measured) * noise(rng), frames % 11 != 0, Error(measured) * drift * noise(rng)))
+			{
+				++switches;
+				if (tuner.IsRunning()) current = tuner.GetCurrent();
+			}
+		}
+		CHECK(tuner.IsFinished() && tuner.GetProgress() == 1.0f);
+		const AutoTuner::Candidate& result = tuner.GetResult();
+		std::printf("live: %d frames, %d switches, %zu blocks, result %d@%.2f cost %.2f error %.4f\n", frames, switches,
+			tuner.GetMeasurements().size(), result.Preset, result.RenderScale, Cost(result), Error(result));
+		CHECK((int)tuner.GetMeasurements().size() == (int)candidates.size() * AutoTuner::Rounds);
+		CHECK(Cost(result) <= 4.0f);
+		CHECK(Error(result) <= Error(candidates[BestFit(candidates, 4.0f)]) * 1.05f);
+
+		tuner.Stop();
+		CHECK(!tuner.IsRunning() && !tuner.IsFinished());
+	}
+
+	// Results file: other keys are kept, a key is replaced rather than repeated, broken lines are skipped
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "LFGAutoTunerSelection.txt";
+		std::filesystem::remove(path);
+		const AutoTuner::Candidate quality{ 3, 0.7148f };
+		const AutoTuner::Candidate performance{ 1, 0.5f };
+		AutoTuner::Candidate loaded;
+		CHECK(!AutoTuner::Load(path, "game.exe|2560x1440", loaded));
+
+		CHECK(AutoTuner::Save(path, "game.exe|2560x1440", quality));
+		CHECK(AutoTuner::Save(path, "a=b.exe|1920x1080", performance));
+		CHECK(AutoTuner::Load(path, "game.exe|2560x1440", loaded) && loaded.Preset == 3 && std::fabs(loaded.RenderScale - 0.7148f) < 1e-4f);
+		CHECK(AutoTuner::Save(path, "game.exe|2560x1440", performance));
+		CHECK(AutoTuner::Load(path, "game.exe|2560x1440", loaded) && loaded.Preset == 1 && loaded.RenderScale == 0.5f);
+		CHECK(AutoTuner::Load(path, "a=b.exe|1920x1080", loaded) && loaded.Preset == 1 && loaded.RenderScale == 0.5f);
+		CHECK(!AutoTuner::Load(path, "game.exe|2560x14", loaded));
+		CHECK(!AutoTuner::Load(path, "game.exe", loaded));
+
+		{
+			std::ofstream file(path, std::ios::app);
+			file << "broken.exe|1280x720=2\n" << "comma.exe|1280x720=2;0.5\n" << "garbage\n";
+		}
+		CHECK(!AutoTuner::Load(path, "broken.exe|1280x720", loaded));
+		CHECK(!AutoTuner::Load(path, "comma.exe|1280x720", loaded));
+
+		int lines = 0;
+		int gameLines = 0;
+		{
+			std::ifstream file(path);
+			std::string line;
+			while (std::getline(file, line))
+			{
+				std::printf("  %s\n", line.c_str());
+				++lines;
+				gameLines += line.rfind("game.exe|2560x1440=", 0) == 0;
+			}
+		}
+		CHECK(lines == 5 && gameLines == 1);
+
+		// A decimal comma locale (the C++ one for streams, the C one if installed) neither changes what is written
+		// nor how it is read
+		const std::locale previous = std::locale::global(std::locale(std::locale::classic(), new DecimalComma));
+		if (!std::setlocale(LC_ALL, "de_DE.UTF-8") && !std::setlocale(LC_ALL, "fr_FR.UTF-8"))
+			std::printf("no decimal comma C locale installed, only the C++ one is set\n");
+		CHECK(AutoTuner::Save(path, "locale.exe|3840x2160", quality));
+		CHECK(AutoTuner::Load(path, "locale.exe|3840x2160", loaded) && loaded.Preset == 3 && std::fabs(loaded.RenderScale - 0.7148f) < 1e-4f);
+		CHECK(AutoTuner::Load(path, "a=b.exe|1920x1080", loaded) && loaded.RenderScale == 0.5f);
+		std::setlocale(LC_ALL, "C");
+		std::locale::global(previous);
+
+		{
+			std::ifstream file(path);
+			std::string line;
+			while (std::getline(file, line))
+			{
+				if (line.rfind("game.exe|2560x1440=", 0) == 0) CHECK(line == "game.exe|2560x1440=1,0.5000");
+				if (line.rfind("locale.exe|3840x2160=", 0) == 0) CHECK(line == "locale.exe|3840x2160=3,0.7148");
+			}
+		}
+		std::filesystem::remove(path);
+	}
+
+	return Test::Result();
+}
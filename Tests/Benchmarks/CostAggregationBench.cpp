@@ -0,0 +1,129 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPULumaPyramid.h>
+#include <Pipeline/CPU/CPUOpticalFlow.h>
+#include <iterator>
+
+// [Cost Aggregation] Windowed per-pixel BlockMatching against the plain per-pixel SAD, windows 4 - 32. The sliding
+// box sums make the absolute differences per pixel and candidate (nearly) independent of the window, a direct window
+// SAD would grow with its area (64x from 4 to 32). Prints time, work and endpoint error on a clean and a noisy pan.
+static constexpr int SearchRadius = 6;
+static constexpr int Candidates = (2 * SearchRadius + 1) * (2 * SearchRadius + 1);
+static constexpr int Windows[] = { 4, 8, 16, 32 };
+
+struct Result
+{
+	double Ms = 0.0;
+	double AbsDiffPerPixel = 0.0; // Per candidate
+	double EPE = 0.0;
+};
+
+static Result Run(int width, int height, int frames, float noise, bool aggregate, int window)
+{
+	const Test::Motion motion = { -5.0f, 2.0f, 4.0f, -3.0f };
+	CPULumaPyramid luma;
+	CPUOpticalFlow flow;
+	CPU::MotionField output, truth;
+	Result result;
+	int measured = 0;
+	for (int t = 0; t <= frames; ++t)
+	{
+		CPU::ColorImage frame = Test::Frame(width, height, t, motion, &truth);
+		Test::AddNoise(frame, noise, 100 + t);
+		luma.Build(frame);
+		if (t == 0) continue;
+
+		double start = Test::NowMs();
+		flow.Dispatch(luma.GetCurrent(), luma.GetPrevious(), output, window, SearchRadius, true, FlowAlgorithm::BlockMatching, false, false, aggregate);
+		result.Ms += Test::NowMs() - start;
+		result.AbsDiffPerPixel += (double)flow.GetSADCount() / ((double)width * height * Candidates);
+		result.EPE += Test::EndpointError(output, truth, 16);
+		++measured;
+	}
+	result.Ms /= measured;
+	result.AbsDiffPerPixel /= measured;
+	result.EPE /= measured;
+	return result;
+}
+
+// Windowed result against a direct window SAD argmin (no sub-pixel, whole frame one region)
+static int BruteForceMismatches()
+{
+	const int width = 64, height = 48, window = 8, radius = 3;
+	const Test::Motion motion = { -2.0f, 1.0f, 2.0f, -1.0f };
+	CPULumaPyramid luma;
+	luma.Build(Test::Frame(width, height, 0, motion));
+	luma.Build(Test::Frame(width, height, 1, motion));
+	const CPU::LumaImage& current = luma.GetCurrent();
+	const CPU::LumaImage& prev = luma.GetPrevious();
+
+	CPUOpticalFlow flow;
+	CPU::MotionField output;
+	flow.Dispatch(current, prev, output, window, radius, false, FlowAlgorithm::BlockMatching, false, false, true);
+
+	int mismatches = 0;
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			auto cost = [&](int vx, int vy)
+			{
+				float sum = 0.0f;
+				for (int j = -window / 2; j < window / 2; ++j)
+				{
+					for (int i = -window / 2; i < window / 2; ++i)
+						sum += CPU::AbsDiff(current.Clamped(x + i, y + j), prev.Clamped(x + i + vx, y + j + vy));
+				}
+				return sum / (window * window) + FlowTuning::CostAggregationVectorBias * std::sqrt((float)(vx * vx + vy * vy));
+			};
+			float best = cost(0, 0);
+			int bestX = 0, bestY = 0;
+			for (int vy = -radius; vy <= radius; ++vy)
+			{
+				for (int vx = -radius; vx <= radius; ++vx)
+				{
+					float c = cost(vx, vy);
+					if (c < best - 1e-5f)
+					{
+						best = c;
+						bestX = vx;
+						bestY = vy;
+					}
+				}
+			}
+			if (output.At(x, y).x != bestX || output.At(x, y).y != bestY) ++mismatches;
+		}
+	}
+	return mismatches;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = Test::Quick(argc, argv);
+	const int width = quick ? 160 : 640;
+	const int height = quick ? 96 : 360;
+	const int frames = quick ? 2 : 6;
+
+	std::printf("%dx%d, search radius %d, %d frames\n", width, height, SearchRadius, frames);
+	double absDiff[std::size(Windows)] = {};
+	for (float noise : { 0.0f, 0.05f })
+	{
+		std::printf("noise %.2f\n", noise);
+		Result perPixel = Run(width, height, frames, noise, false, 1);
+		std::printf("  per-pixel SAD   %7.1f ms  %5.2f AD/px/candidate  EPE %.3f\n", perPixel.Ms, perPixel.AbsDiffPerPixel, perPixel.EPE);
+		for (size_t i = 0; i < std::size(Windows); ++i)
+		{
+			Result windowed = Run(width, height, frames, noise, true, Windows[i]);
+			std::printf("  window %2d       %7.1f ms  %5.2f AD/px/candidate  EPE %.3f\n", Windows[i], windowed.Ms, windowed.AbsDiffPerPixel, windowed.EPE);
+			absDiff[i] = windowed.AbsDiffPerPixel;
+		}
+	}
+
+	// Only the apron grows with the window
+	CHECK(absDiff[std::size(Windows) - 1] <= 2.0 * absDiff[0]);
+
+	int mismatches = BruteForceMismatches();
+	std::printf("direct window SAD mismatches: %d\n", mismatches);
+	CHECK(mismatches == 0);
+
+	return Test::Result();
+}
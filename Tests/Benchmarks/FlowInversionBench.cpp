@@ -0,0 +1,93 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPUFrameInterpolation.h>
+#include <Pipeline/CPU/CPULumaPyramid.h>
+#include <Pipeline/CPU/CPUMetrics.h>
+#include <Pipeline/CPU/CPUOpticalFlow.h>
+
+// [Flow Inversion] Backward flow inverted from the forward one against the second full search, both with the windowed
+// cost (inversion needs it). Prints the search work, time, backward endpoint error, the PSNR of the halfway frame
+// and how far the occlusion verdicts of the consistency check agree between the two.
+static constexpr int BlockSize = 8;
+static constexpr int SearchRadius = 16;
+
+struct Result
+{
+	double Ms = 0.0;
+	double SAD = 0.0;
+	double BackwardEPE = 0.0;
+	double PSNR = 0.0;
+};
+
+int main(int argc, char** argv)
+{
+	const bool quick = Test::Quick(argc, argv);
+	const int width = quick ? 160 : 640;
+	const int height = quick ? 96 : 360;
+	const int pairs = quick ? 2 : 6;
+	const Test::Motion motion = { -3.0f, 1.0f, 4.0f, -3.0f };
+
+	Result results[2]; // Double search, inversion
+	double agreement = 0.0;
+	for (int k = 0; k < pairs; ++k)
+	{
+		// Every other frame is dropped and rebuilt halfway
+		CPU::MotionField truthPrev;
+		CPU::ColorImage prev = Test::Frame(width, height, 2 * k, motion, &truthPrev);
+		CPU::ColorImage halfway = Test::Frame(width, height, 2 * k + 1, motion);
+		CPU::ColorImage current = Test::Frame(width, height, 2 * k + 2, motion);
+		CPULumaPyramid luma;
+		luma.Build(prev);
+		luma.Build(current);
+
+		CPU::VisibilityMap visibility[2];
+		for (int invert = 0; invert < 2; ++invert)
+		{
+			CPUOpticalFlow flow;
+			CPU::MotionField forward;
+			double start = Test::NowMs();
+			flow.DispatchBiDirectional(luma.GetCurrent(), luma.GetPrevious(), forward, BlockSize, SearchRadius, false, true, invert != 0);
+			Result& r = results[invert];
+			r.Ms += Test::NowMs() - start;
+			r.SAD += (double)flow.GetSADCount();
+			visibility[invert] = flow.GetVisibility();
+
+			// Backward truth: previous frame content moves by twice the per-frame motion
+			double epe = 0.0;
+			const CPU::MotionField& backward = flow.GetBackwardMotion();
+			for (size_t i = 0; i < backward.Pixels.size(); ++i)
+				epe += CPU::Length(backward.Pixels[i] + truthPrev.Pixels[i] * 2.0f);
+			r.BackwardEPE += epe / backward.Pixels.size();
+
+			CPUFrameInterpolation synthesis;
+			CPU::ColorImage generated;
+			synthesis.Interpolate(current, prev, forward, generated, 0.5f, 0.3f, 1, &visibility[invert], FlowTuning::VisibilityScale);
+			r.PSNR += CPU::PSNR(generated, halfway);
+		}
+
+		long long same = 0;
+		for (size_t i = 0; i < visibility[0].Pixels.size(); ++i)
+		{
+			const CPU::Float2& a = visibility[0].Pixels[i];
+			const CPU::Float2& b = visibility[1].Pixels[i];
+			same += (a.x >= 0.5f) == (b.x >= 0.5f) && (a.y >= 0.5f) == (b.y >= 0.5f);
+		}
+		agreement += 100.0 * same / visibility[0].Pixels.size();
+	}
+
+	std::printf("%dx%d, block %d, radius %d, %d frame pairs\n", width, height, BlockSize, SearchRadius, pairs);
+	const char* names[2] = { "double search", "inversion" };
+	for (int i = 0; i < 2; ++i)
+	{
+		const Result& r = results[i];
+		std::printf("  %-14s %7.1f ms  SAD %6.2fM  backward EPE %.2f  PSNR %.2f dB\n", names[i],
+			r.Ms / pairs, r.SAD / pairs / 1e6, r.BackwardEPE / pairs, r.PSNR / pairs);
+	}
+	agreement /= pairs;
+	std::printf("  visibility agreement %.1f%%\n", agreement);
+
+	CHECK(results[1].SAD < 0.75 * results[0].SAD);
+	CHECK(agreement >= 90.0);
+	CHECK(results[1].PSNR / pairs >= results[0].PSNR / pairs - 0.5); // dB
+
+	return Test::Result();
+}
@@ -0,0 +1,107 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPULumaPyramid.h>
+#include <Pipeline/CPU/CPUOpticalFlow.h>
+#include <iterator>
+
+// [Phase Correlation] A narrow pyramid search fed with the per-tile correlation peaks against the plain narrow and a
+// wide one, on pans up to well past the narrow reach. Prints endpoint error, search work and time per frame.
+static constexpr int BlockSize = 8;
+static constexpr int MaxLevel = 2;
+
+struct Scenario
+{
+	const char* Name;
+	Test::Motion Motion;
+};
+
+struct Config
+{
+	const char* Name;
+	int SearchRadius;
+	bool PhaseCorrelation;
+	bool WarmStart;
+};
+
+static const Scenario Scenarios[] = {
+	{ "pan 10", { 10.0f, 3.0f, 4.0f, -3.0f } },
+	{ "pan 40", { 40.0f, -12.0f, 4.0f, -3.0f } },
+	{ "pan 40 + object 30", { 40.0f, -12.0f, -30.0f, 10.0f } },
+	{ "flick 56", { 56.0f, 20.0f, 0.0f, 0.0f } },
+};
+
+enum { Narrow, Wide, Correlated, CorrelatedWarm };
+static const Config Configs[] = {
+	{ "r16", 16, false, false },
+	{ "r48", 48, false, false },
+	{ "r16 + PC", 16, true, false },
+	{ "r16 + PC + WS", 16, true, true },
+};
+
+struct Result
+{
+	double EPE = 0.0;
+	double SAD = 0.0;
+	double Ms = 0.0;
+};
+
+static Result Run(const Scenario& scenario, const Config& config, int width, int height, int frames)
+{
+	CPULumaPyramid luma;
+	CPUOpticalFlow flow;
+	CPU::MotionField output, truth;
+	Result result;
+	int measured = 0;
+	for (int t = 0; t < frames; ++t)
+	{
+		luma.Build(Test::Frame(width, height, t, scenario.Motion, &truth));
+		if (t == 0) continue;
+
+		double start = Test::NowMs();
+		flow.DispatchPyramid(luma, output, BlockSize, config.SearchRadius, true, MaxLevel, 0, config.WarmStart, true, false, config.PhaseCorrelation);
+		double ms = Test::NowMs() - start;
+		// The first pair has no history (warm start, last frame's candidates)
+		if (t < 2) continue;
+		result.EPE += Test::EndpointError(output, truth);
+		result.SAD += (double)flow.GetSADCount();
+		result.Ms += ms;
+		++measured;
+	}
+	result.EPE /= measured;
+	result.SAD /= measured;
+	result.Ms /= measured;
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = Test::Quick(argc, argv);
+	// Smaller frames would be mostly the uncovered border on the large pans, --quick only measures fewer frames
+	const int width = 480;
+	const int height = 272;
+	const int frames = quick ? 3 : 8;
+	std::printf("%dx%d, block %d, levels 0 - %d, windowed cost\n", width, height, BlockSize, MaxLevel);
+
+	Result results[std::size(Scenarios)][std::size(Configs)];
+	for (size_t s = 0; s < std::size(Scenarios); ++s)
+	{
+		std::printf("%s\n", Scenarios[s].Name);
+		for (size_t c = 0; c < std::size(Configs); ++c)
+		{
+			const Result& r = results[s][c] = Run(Scenarios[s], Configs[c], width, height, frames);
+			std::printf("  %-14s EPE %6.2f  SAD %7.2fM  %7.1f ms\n", Configs[c].Name, r.EPE, r.SAD / 1e6, r.Ms);
+		}
+	}
+
+	// Past the narrow reach the peaks bring the narrow search to the wide one's error at a fraction of its work
+	for (size_t s = 1; s < std::size(Scenarios); ++s)
+	{
+		const Result* r = results[s];
+		CHECK(r[Correlated].EPE < 0.5 * r[Narrow].EPE);
+		CHECK(r[Correlated].EPE <= r[Wide].EPE + 0.5);
+		CHECK(r[Correlated].SAD < 0.5 * r[Wide].SAD);
+	}
+	// Within reach they cost little and change nothing
+	CHECK(results[0][Correlated].EPE <= results[0][Narrow].EPE + 0.1);
+
+	return Test::Result();
+}
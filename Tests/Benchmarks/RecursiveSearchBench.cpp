@@ -0,0 +1,109 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPULumaPyramid.h>
+#include <Pipeline/CPU/CPUOpticalFlow.h>
+#include <iterator>
+
+// [3DRS] RecursiveSearch against the full search of the same blocks (block-granular BlockMatching) over a sequence,
+// so the temporal candidates converge. Prints SAD evaluations per pixel, the endpoint error of the block vectors on
+// the first frame and once converged, and the time per frame.
+static constexpr int BlockSize = 8;
+static constexpr int SearchRadius = 16;
+static constexpr int Warmup = 4; // Frames before the converged average starts
+
+struct Scenario
+{
+	const char* Name;
+	Test::Motion Motion;
+};
+
+static const Scenario Scenarios[] = {
+	{ "static + object", { 0.0f, 0.0f, 4.0f, -2.0f } },
+	{ "pan 3", { 3.0f, 1.0f, -4.0f, 2.0f } },
+	{ "pan 10", { 10.0f, -4.0f, 3.0f, 3.0f } },
+};
+
+struct Result
+{
+	double SADPerPixel = 0.0;
+	double FirstEPE = 0.0;
+	double EPE = 0.0; // Converged
+	double Ms = 0.0;
+};
+
+// Mean endpoint error of a block field against the truth at the block centers, the outer ring of blocks excluded
+static double BlockEndpointError(const CPU::MotionField& blocks, const CPU::MotionField& truth)
+{
+	double sum = 0.0;
+	int count = 0;
+	for (int by = 1; by < blocks.Height - 1; ++by)
+	{
+		for (int bx = 1; bx < blocks.Width - 1; ++bx)
+		{
+			const int x = std::min(bx * BlockSize + BlockSize / 2, truth.Width - 1);
+			const int y = std::min(by * BlockSize + BlockSize / 2, truth.Height - 1);
+			sum += CPU::Length(blocks.At(bx, by) - truth.At(x, y));
+			++count;
+		}
+	}
+	return count > 0 ? sum / count : 0.0;
+}
+
+static Result Run(const Scenario& scenario, FlowAlgorithm algo, int width, int height, int frames)
+{
+	CPULumaPyramid luma;
+	CPUOpticalFlow flow;
+	CPU::MotionField output, truth;
+	Result result;
+	long long sads = 0;
+	int converged = 0;
+	for (int t = 0; t < frames; ++t)
+	{
+		CPU::ColorImage frame = Test::Frame(width, height, t, scenario.Motion, &truth);
+		Test::AddNoise(frame, 0.01f, t + 1);
+		luma.Build(frame);
+		if (t == 0) continue;
+
+		const double start = Test::NowMs();
+		flow.Dispatch(luma.GetCurrent(), luma.GetPrevious(), output, BlockSize, SearchRadius, false, algo, false, true);
+		result.Ms += Test::NowMs() - start;
+		sads += flow.GetSADCount();
+
+		const double epe = BlockEndpointError(output, truth);
+		if (t == 1) result.FirstEPE = epe;
+		if (t > Warmup)
+		{
+			result.EPE += epe;
+			++converged;
+		}
+	}
+	result.SADPerPixel = (double)sads / ((double)width * height * (frames - 1));
+	result.EPE /= std::max(converged, 1);
+	result.Ms /= frames - 1;
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = Test::Quick(argc, argv);
+	const int width = quick ? 192 : 960;
+	const int height = quick ? 128 : 540;
+	const int frames = quick ? 12 : 16;
+	std::printf("%dx%d, block %d, full search radius %d, %d frames (converged after %d)\n", width, height, BlockSize, SearchRadius, frames, Warmup);
+	std::printf("  %-16s %-5s %10s %9s %9s %9s\n", "scenario", "algo", "SAD/pixel", "EPE f1", "EPE", "ms/frame");
+
+	for (const Scenario& scenario : Scenarios)
+	{
+		const Result full = Run(scenario, FlowAlgorithm::BlockMatching, width, height, frames);
+		const Result recursive = Run(scenario, FlowAlgorithm::RecursiveSearch, width, height, frames);
+		std::printf("  %-16s %-5s %10.1f %9.3f %9.3f %9.2f\n", scenario.Name, "full", full.SADPerPixel, full.FirstEPE, full.EPE, full.Ms);
+		std::printf("  %-16s %-5s %10.1f %9.3f %9.3f %9.2f  (%.0fx fewer SADs)\n", "", "3DRS", recursive.SADPerPixel,
+			recursive.FirstEPE, recursive.EPE, recursive.Ms, full.SADPerPixel / recursive.SADPerPixel);
+
+		// The work is deterministic: a fixed candidate set per block against the whole window
+		CHECK(full.SADPerPixel >= 20.0 * recursive.SADPerPixel);
+		// Once the temporal candidates caught up, comparable vectors
+		CHECK(recursive.EPE <= full.EPE + 0.5);
+	}
+
+	return Test::Result();
+}
@@ -0,0 +1,202 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPUFrameHash.h>
+#include <Pipeline/CPU/CPULumaPyramid.h>
+#include <Pipeline/CPU/CPUOpticalFlow.h>
+#include <Pipeline/CPU/CPUUpscale.h>
+#include <algorithm>
+
+// [Frame Hash] Per-tile hashing against the motion search it lets skip. Prints the hash time next to the search time,
+// the SADs with and without the unchanged tiles and the endpoint error, on a static background with a moving object,
+// a duplicated frame and a full pan (every tile changes, nothing to skip). Then a flow at a third of the capture
+// resolution: the capture hash carried over to the flow tiles (MapUnchanged) against hashing the downscaled frame.
+static constexpr int BlockSize = 8;
+static constexpr int SearchRadius = 8;
+
+struct Result
+{
+	double HashMs = 0.0;
+	double SearchMs[2] = {}; // Without, with the unchanged tiles
+	long long SAD[2] = {};
+	double EPE[2] = {};
+	int Changed = 0;
+	int Tiles = 0;
+	bool Duplicate = false;
+	bool Exact = true; // Hashes match CPUFrameHash::TileHash tile for tile
+};
+
+static Result Run(const char* name, const CPU::ColorImage& prev, const CPU::ColorImage& current, const CPU::MotionField& truth,
+	FlowAlgorithm algo, bool blockGranular, int repetitions)
+{
+	Result result;
+	double start = Test::NowMs();
+	for (int i = 0; i < repetitions; ++i)
+	{
+		CPUFrameHash hash;
+		hash.Hash(prev);
+		hash.Hash(current);
+	}
+	result.HashMs = (Test::NowMs() - start) / (2 * repetitions);
+
+	CPUFrameHash hash;
+	hash.Hash(prev);
+	hash.Hash(current);
+	result.Changed = hash.GetChangedCount();
+	result.Tiles = (int)hash.GetHashes().size();
+	result.Duplicate = hash.IsDuplicate();
+
+	const int tileSize = CPUFrameHash::TileSize;
+	const int tilesX = (current.Width + tileSize - 1) / tileSize;
+	for (int t = 0; t < result.Tiles; ++t)
+	{
+		int x0 = (t % tilesX) * tileSize;
+		int y0 = (t / tilesX) * tileSize;
+		uint32_t expected = CPUFrameHash::TileHash(current, x0, y0, std::min(x0 + tileSize, current.Width), std::min(y0 + tileSize, current.Height));
+		result.Exact &= hash.GetHashes()[t] == expected;
+	}
+
+	CPULumaPyramid luma;
+	luma.Build(prev);
+	luma.Build(current);
+	for (int skip = 0; skip < 2; ++skip)
+	{
+		CPUOpticalFlow flow;
+		CPU::MotionField output;
+		if (skip) flow.SetUnchangedTiles(&hash.GetUnchanged());
+		start = Test::NowMs();
+		flow.Dispatch(luma.GetCurrent(), luma.GetPrevious(), output, BlockSize, SearchRadius, false, algo, false, blockGranular);
+		result.SearchMs[skip] = Test::NowMs() - start;
+		result.SAD[skip] = flow.GetSADCount();
+		// Block-granular vectors are one per block
+		if (!blockGranular) result.EPE[skip] = Test::EndpointError(output, truth, BlockSize);
+	}
+
+	std::printf("  %-22s changed %4d/%4d%s | hash %6.2f ms | search %7.1f ms SAD %6.2fM -> %7.1f ms SAD %6.2fM | EPE %.3f -> %.3f\n",
+		name, result.Changed, result.Tiles, result.Duplicate ? " dup" : "    ", result.HashMs,
+		result.SearchMs[0], result.SAD[0] / 1e6, result.SearchMs[1], result.SAD[1] / 1e6, result.EPE[0], result.EPE[1]);
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	const bool quick = Test::Quick(argc, argv);
+	const int width = quick ? 160 : 1280;
+	const int height = quick ? 96 : 720;
+	const int repetitions = quick ? 4 : 20;
+	std::printf("%dx%d, block %d, radius %d\n", width, height, BlockSize, SearchRadius);
+
+	const Test::Motion object = { 0.0f, 0.0f, 3.0f, 1.0f };
+	CPU::MotionField truth;
+	CPU::ColorImage prev = Test::Frame(width, height, 0, object);
+	CPU::ColorImage current = Test::Frame(width, height, 1, object, &truth);
+	Result blockMatching = Run("static bg, moving obj", prev, current, truth, FlowAlgorithm::BlockMatching, false, repetitions);
+	Result recursive = Run("  (3DRS)", prev, current, truth, FlowAlgorithm::RecursiveSearch, false, repetitions);
+	Result blockGranular = Run("  (block search)", prev, current, truth, FlowAlgorithm::BlockMatching, true, repetitions);
+
+	CPU::MotionField still(width, height);
+	Result duplicate = Run("duplicate", current, Test::Frame(width, height, 1, object), still, FlowAlgorithm::BlockMatching, false, repetitions);
+
+	const Test::Motion pan = { 2.0f, 1.0f, 3.0f, 1.0f };
+	CPU::ColorImage panPrev = Test::Frame(width, height, 0, pan);
+	CPU::ColorImage panCurrent = Test::Frame(width, height, 1, pan, &truth);
+	Result fullPan = Run("full pan", panPrev, panCurrent, truth, FlowAlgorithm::BlockMatching, false, repetitions);
+
+	for (const Result* r : { &blockMatching, &recursive, &blockGranular, &duplicate, &fullPan })
+		CHECK(r->Exact);
+
+	// Hashing has to stay well below the search it saves
+	CHECK(blockMatching.HashMs < 0.5 * blockMatching.SearchMs[0]);
+	// Static background: most of the search goes, the vectors stay. The per-pixel full search already stops early on
+	// an exact match, so there is little left to save there.
+	CHECK(blockMatching.Changed < blockMatching.Tiles / 2);
+	CHECK(blockMatching.SAD[1] <= blockMatching.SAD[0]);
+	CHECK(recursive.SAD[1] < recursive.SAD[0] / 2);
+	CHECK(blockGranular.SAD[1] < blockGranular.SAD[0] / 2);
+	CHECK(recursive.EPE[1] <= recursive.EPE[0] + 0.05);
+	CHECK(blockMatching.EPE[1] <= blockMatching.EPE[0] + 0.05);
+	CHECK(duplicate.Duplicate && duplicate.SAD[1] == 0);
+	// Nothing unchanged, nothing skipped
+	CHECK(!fullPan.Duplicate && fullPan.SAD[1] == fullPan.SAD[0]);
+
+	// [Scaled Flow] Capture at 3x the flow: a change between the texels Nearest samples leaves the downscaled frames
+	// identical, only the capture hash sees it
+	{
+		const int captureWidth = width * 3;
+		const int captureHeight = height * 3;
+		CPU::ColorImage capturePrev = Test::Frame(captureWidth, captureHeight, 0, {});
+		CPU::ColorImage captureCurrent = capturePrev;
+		const int changeX = 3 * (width / 2);
+		const int changeY = 3 * (height / 2);
+		for (int y = changeY; y < changeY + 3; ++y)
+		{
+			for (int x = changeX; x < changeX + 3; ++x)
+			{
+				if (x % 3 != 1 && y % 3 != 1) captureCurrent.At(x, y) = { 1.0f, 0.0f, 1.0f, 1.0f };
+			}
+		}
+
+		CPU::ColorImage flowPrev, flowCurrent;
+		CPUUpscale::Upscale(capturePrev, flowPrev, width, height, 1, 2);
+		CPUUpscale::Upscale(captureCurrent, flowCurrent, width, height, 1, 2);
+		CPUFrameHash scaledHash;
+		scaledHash.Hash(flowPrev);
+		scaledHash.Hash(flowCurrent);
+
+		CPUFrameHash captureHash;
+		captureHash.Hash(capturePrev);
+		captureHash.Hash(captureCurrent);
+		CPU::Image<uint8_t> flowTiles;
+		captureHash.MapUnchanged(width, height, flowTiles);
+		int changed = 0;
+		for (uint8_t unchanged : flowTiles.Pixels) changed += !unchanged;
+		const int tileX = (changeX / 3) / CPUFrameHash::TileSize;
+		const int tileY = (changeY / 3) / CPUFrameHash::TileSize;
+		std::printf("  %-22s flow hash changed %d%s | capture hash changed %d%s -> flow tiles changed %d/%zu\n", "hidden by Nearest",
+			scaledHash.GetChangedCount(), scaledHash.IsDuplicate() ? " dup" : "", captureHash.GetChangedCount(),
+			captureHash.IsDuplicate() ? " dup" : "", changed, flowTiles.Pixels.size());
+		CHECK(scaledHash.IsDuplicate());
+		CHECK(!captureHash.IsDuplicate());
+		CHECK(!flowTiles.At(tileX, tileY));
+		// Only the tiles around the change
+		CHECK(changed >= 1 && changed <= 4);
+	}
+
+	// [Scaled Flow] Conservative with the widest filter: a flow tile called unchanged holds the same texels in both
+	// downscaled frames, next to the moving object as well
+	{
+		const int captureWidth = width * 3;
+		const int captureHeight = height * 3;
+		const Test::Motion moving = { 0.0f, 0.0f, 6.0f, 3.0f };
+		CPU::ColorImage capturePrev = Test::Frame(captureWidth, captureHeight, 0, moving);
+		CPU::ColorImage captureCurrent = Test::Frame(captureWidth, captureHeight, 1, moving);
+		CPUFrameHash captureHash;
+		captureHash.Hash(capturePrev);
+		captureHash.Hash(captureCurrent);
+		CPU::Image<uint8_t> flowTiles;
+		captureHash.MapUnchanged(width, height, flowTiles);
+
+		CPU::ColorImage flowPrev, flowCurrent;
+		CPUUpscale::Upscale(capturePrev, flowPrev, width, height, 4, 4);
+		CPUUpscale::Upscale(captureCurrent, flowCurrent, width, height, 4, 4);
+		int unchanged = 0;
+		bool exact = true;
+		for (int ty = 0; ty < flowTiles.Height; ++ty)
+		{
+			for (int tx = 0; tx < flowTiles.Width; ++tx)
+			{
+				if (!flowTiles.At(tx, ty)) continue;
+				++unchanged;
+				const int x0 = tx * CPUFrameHash::TileSize;
+				const int y0 = ty * CPUFrameHash::TileSize;
+				const int x1 = std::min(x0 + CPUFrameHash::TileSize, width);
+				const int y1 = std::min(y0 + CPUFrameHash::TileSize, height);
+				exact &= CPUFrameHash::TileHash(flowPrev, x0, y0, x1, y1) == CPUFrameHash::TileHash(flowCurrent, x0, y0, x1, y1);
+			}
+		}
+		std::printf("  %-22s flow tiles unchanged %d/%zu, all identical after Lanczos 4: %s\n", "moving obj, scaled",
+			unchanged, flowTiles.Pixels.size(), exact ? "yes" : "no");
+		CHECK(exact);
+		CHECK(unchanged > (int)flowTiles.Pixels.size() / 2);
+	}
+
+	return Test::Result();
+}
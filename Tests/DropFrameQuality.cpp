@@ -0,0 +1,45 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPUMetrics.h>
+
+// CPU::EvaluateDropFrame on synthetic sequences: both interpolation and extrapolation have to rebuild the dropped
+// frame clearly better than repeating its neighbour, above a minimum PSNR / SSIM.
+static constexpr int Width = 160;
+static constexpr int Height = 96;
+static constexpr int BlockSize = 8;
+static constexpr int SearchRadius = 8;
+static constexpr float MinPSNR = 23.0f;
+static constexpr float MinSSIM = 0.75f;
+static constexpr float MinGainOverHold = 3.0f; // dB
+
+static void Evaluate(const char* name, const Test::Motion& motion)
+{
+	CPU::ColorImage f0 = Test::Frame(Width, Height, 0, motion);
+	CPU::ColorImage f1 = Test::Frame(Width, Height, 1, motion);
+	CPU::ColorImage f2 = Test::Frame(Width, Height, 2, motion);
+
+	CPU::DropFrameScore score = CPU::EvaluateDropFrame(f0, f1, f2, BlockSize, SearchRadius, true, 0.0f);
+	float holdPSNR = CPU::PSNR(f1, f2);
+	std::printf("%-16s interpolation %.2f dB / %.3f  extrapolation %.2f dB / %.3f  hold %.2f dB / %.3f\n", name,
+		score.InterpolationPSNR, score.InterpolationSSIM, score.ExtrapolationPSNR, score.ExtrapolationSSIM, holdPSNR, CPU::SSIM(f1, f2));
+
+	CHECK(score.InterpolationPSNR >= MinPSNR);
+	CHECK(score.InterpolationSSIM >= MinSSIM);
+	CHECK(score.ExtrapolationPSNR >= MinPSNR);
+	CHECK(score.ExtrapolationSSIM >= MinSSIM);
+	CHECK(score.InterpolationPSNR >= holdPSNR + MinGainOverHold);
+	CHECK(score.ExtrapolationPSNR >= holdPSNR + MinGainOverHold);
+}
+
+int main()
+{
+	Evaluate("pan", { 3.0f, 1.0f, 0.0f, 0.0f });
+	Evaluate("pan + object", { 2.0f, 0.0f, -6.0f, 3.0f });
+
+	// Nothing moves: both rebuild the frame exactly
+	CPU::ColorImage still = Test::Frame(Width, Height, 0, {});
+	CPU::DropFrameScore score = CPU::EvaluateDropFrame(still, still, still, BlockSize, SearchRadius, true, 0.0f);
+	CHECK(score.InterpolationPSNR == 100.0f);
+	CHECK(score.ExtrapolationPSNR == 100.0f);
+
+	return Test::Result();
+}
@@ -0,0 +1,51 @@
+#include "TestCommon.h"
+#include <Pipeline/CPU/CPUUpscale.h>
+
+// [Fused RCAS] UpscaleRCAS has to match Upscale followed by RCAS bit for bit: every filter, Lanczos radii, light and
+// full strength, output sizes that are and are not multiples of the tile, and a 1:1 "upscale".
+struct Size
+{
+	int Width;
+	int Height;
+};
+
+static bool BitExact(const CPU::ColorImage& a, const CPU::ColorImage& b)
+{
+	return a.SameSize(b.Width, b.Height) && std::memcmp(a.Pixels.data(), b.Pixels.data(), a.Pixels.size() * sizeof(CPU::Float4)) == 0;
+}
+
+int main()
+{
+	const Test::Motion motion = { -3.0f, 1.0f, 4.0f, -3.0f };
+	CPU::ColorImage input = Test::Frame(213, 121, 3, motion);
+	// Out of range texels (HDR, noise) have to go through both paths alike
+	Test::AddNoise(input, 0.1f, 1);
+
+	const Size sizes[] = { { 320, 192 }, { 301, 177 }, { 213, 121 } };
+	const char* modes[] = { "", "Nearest", "Bilinear", "Bicubic", "Lanczos" };
+	CPUUpscale fusedUpscale;
+	for (int mode = 1; mode <= 4; ++mode)
+	{
+		for (int radius : { 2, 3 })
+		{
+			if (mode != 4 && radius != 2) continue;
+			for (float sharpness : { 0.25f, 1.0f })
+			{
+				for (const Size& size : sizes)
+				{
+					CPU::ColorImage upscaled, twoPass, fused;
+					CPUUpscale::Upscale(input, upscaled, size.Width, size.Height, mode, radius);
+					CPUUpscale::RCAS(upscaled, twoPass, sharpness);
+					fusedUpscale.UpscaleRCAS(input, fused, size.Width, size.Height, mode, radius, sharpness);
+
+					bool exact = BitExact(twoPass, fused);
+					if (!exact)
+						std::printf("%s radius %d sharpness %.2f %dx%d differs\n", modes[mode], radius, sharpness, size.Width, size.Height);
+					CHECK(exact);
+				}
+			}
+		}
+	}
+
+	return Test::Result();
+}
@@ -0,0 +1,202 @@
+#include "TestCommon.h"
+#include <Pipeline/OpticalFlow/FlowTuning.h>
+#include <Pipeline/OpticalFlow/GlobalMotion.h>
+#include <vector>
+
+// [Global Motion] GlobalMotion::Fit on the sample grid of synthetic vector fields: a pan and a zoom, both with a
+// moving object and noise, and a pan out of the search's reach whose vectors are garbage, where the thumbnails'
+// phase correlation has to take over. Checks the model's parameters, its endpoint error on the camera motion and
+// the time a fit takes.
+static constexpr int Width = 960; // Flow resolution
+static constexpr int Height = 540;
+static constexpr int SearchRadius = 16;
+
+struct Camera
+{
+	float Zoom = 1.0f; // Around the frame center
+	float PanX = 0.0f; // Current -> previous, like the flow vectors
+	float PanY = 0.0f;
+
+	void Motion(float x, float y, float& u, float& v) const
+	{
+		const float cx = (Width - 1) * 0.5f;
+		const float cy = (Height - 1) * 0.5f;
+		u = (Zoom - 1.0f) * (x - cx) + PanX;
+		v = (Zoom - 1.0f) * (y - cy) + PanY;
+	}
+};
+
+static bool InObject(float x, float y)
+{
+	return x >= Width * 0.3f && x < Width * 0.55f && y >= Height * 0.4f && y < Height * 0.75f;
+}
+
+// CSGather: the SampleGrid x SampleGrid grid, the object moves on its own, 'reachable' false: the camera motion
+// is beyond SearchRadius and every vector is whatever the search settled on
+static std::vector<GlobalMotion::Sample> Samples(const Camera& camera, bool reachable, unsigned seed)
+{
+	std::mt19937 rng(seed);
+	std::normal_distribution<float> noise(0.0f, 0.3f);
+	std::uniform_real_distribution<float> garbage(-(float)SearchRadius, (float)SearchRadius);
+	std::vector<GlobalMotion::Sample> samples;
+	const int grid = GlobalMotion::SampleGrid;
+	for (int j = 0; j < grid; ++j)
+	{
+		for (int i = 0; i < grid; ++i)
+		{
+			GlobalMotion::Sample s;
+			s.X = (float)(int)((i + 0.5f) * Width / grid);
+			s.Y = (float)(int)((j + 0.5f) * Height / grid);
+			if (!reachable)
+			{
+				s.U = garbage(rng);
+				s.V = garbage(rng);
+			}
+			else if (InObject(s.X, s.Y))
+			{
+				s.U = 9.0f + noise(rng);
+				s.V = -4.0f + noise(rng);
+			}
+			else
+			{
+				camera.Motion(s.X, s.Y, s.U, s.V);
+				s.U += noise(rng);
+				s.V += noise(rng);
+			}
+			samples.push_back(s);
+		}
+	}
+	return samples;
+}
+
+// Mean endpoint error of the model against the camera motion, object pixels excluded
+static double ModelError(const GlobalMotion::Estimate& model, const Camera& camera)
+{
+	double sum = 0.0;
+	int count = 0;
+	for (int y = 0; y < Height; y += 4)
+	{
+		for (int x = 0; x < Width; x += 4)
+		{
+			if (InObject((float)x, (float)y)) continue;
+			float u, v, tu, tv;
+			model.Evaluate((float)x, (float)y, u, v);
+			camera.Motion((float)x, (float)y, tu, tv);
+			sum += std::hypot(u - tu, v - tv);
+			++count;
+		}
+	}
+	return sum / count;
+}
+
+// CSThumbnail: box averages of a panned texture
+static std::vector<float> Thumbnail(float panX, float panY)
+{
+	const int n = GlobalMotion::ThumbnailSize;
+	std::vector<float> thumbnail((size_t)n * n);
+	for (int j = 0; j < n; ++j)
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			float sum = 0.0f;
+			int count = 0;
+			for (int y = j * Height / n; y < (j + 1) * Height / n; y += 2)
+			{
+				for (int x = i * Width / n; x < (i + 1) * Width / n; x += 2)
+				{
+					sum += Test::Texture(x - panX, y - panY, 24.0f);
+					++count;
+				}
+			}
+			thumbnail[(size_t)j * n + i] = sum / count;
+		}
+	}
+	return thumbnail;
+}
+
+static const char* Name(GlobalMotion::Model type)
+{
+	static const char* names[] = { "none", "translation", "affine", "homography" };
+	return names[(int)type];
+}
+
+static double FitMicroseconds(GlobalMotion& motion, const std::vector<GlobalMotion::Sample>& samples)
+{
+	constexpr int repetitions = 200;
+	motion.Fit(samples.data(), (int)samples.size());
+	const double start = Test::NowMs();
+	for (int i = 0; i < repetitions; ++i) motion.Fit(samples.data(), (int)samples.size());
+	return (Test::NowMs() - start) * 1000.0 / repetitions;
+}
+
+int main()
+{
+	// Pan: an affine model with the pan as its translation and identity otherwise
+	{
+		const Camera camera{ 1.0f, -11.0f, 4.5f };
+		const std::vector<GlobalMotion::Sample> samples = Samples(camera, true, 1);
+		GlobalMotion motion;
+		const GlobalMotion::Estimate model = motion.Fit(samples.data(), (int)samples.size());
+		const double epe = ModelError(model, camera);
+		const double us = FitMicroseconds(motion, samples);
+		std::printf("pan:   %s inliers %.2f H [%.3f %.3f %.2f; %.3f %.3f %.2f] EPE %.3f, %.0f us\n", Name(model.Type),
+			model.InlierRatio, model.H[0], model.H[1], model.H[2], model.H[3], model.H[4], model.H[5], epe, us);
+		CHECK(model.Type == GlobalMotion::Model::Affine);
+		CHECK(std::fabs(model.H[2] - camera.PanX) < 0.1f && std::fabs(model.H[5] - camera.PanY) < 0.1f);
+		CHECK(std::fabs(model.H[0] - 1.0f) < 1e-3f && std::fabs(model.H[4] - 1.0f) < 1e-3f);
+		CHECK(std::fabs(model.H[1]) < 1e-3f && std::fabs(model.H[3]) < 1e-3f);
+		CHECK(model.InlierRatio > 0.85f);
+		CHECK(epe < 0.05);
+		CHECK(FlowTuning::TrustGlobalMotion(model));
+		CHECK(us < 2000.0);
+	}
+
+	// Zoom: the scale on the diagonal, the translation keeps the center in place
+	{
+		const Camera camera{ 0.96f, 2.0f, 0.0f };
+		const std::vector<GlobalMotion::Sample> samples = Samples(camera, true, 2);
+		GlobalMotion motion;
+		const GlobalMotion::Estimate model = motion.Fit(samples.data(), (int)samples.size());
+		const double epe = ModelError(model, camera);
+		const double us = FitMicroseconds(motion, samples);
+		std::printf("zoom:  %s inliers %.2f H [%.3f %.3f %.2f; %.3f %.3f %.2f] EPE %.3f, %.0f us\n", Name(model.Type),
+			model.InlierRatio, model.H[0], model.H[1], model.H[2], model.H[3], model.H[4], model.H[5], epe, us);
+		CHECK(model.Type == GlobalMotion::Model::Affine);
+		CHECK(std::fabs(model.H[0] - camera.Zoom) < 1e-3f && std::fabs(model.H[4] - camera.Zoom) < 1e-3f);
+		CHECK(std::fabs(model.H[1]) < 1e-3f && std::fabs(model.H[3]) < 1e-3f);
+		float u, v;
+		model.Evaluate((Width - 1) * 0.5f, (Height - 1) * 0.5f, u, v);
+		CHECK(std::fabs(u - camera.PanX) < 0.1f && std::fabs(v - camera.PanY) < 0.1f);
+		CHECK(model.InlierRatio > 0.85f);
+		CHECK(epe < 0.05);
+		CHECK(FlowTuning::TrustGlobalMotion(model));
+		CHECK(us < 2000.0);
+	}
+
+	// Out of reach: nothing explains the vectors, the phase correlation of the thumbnails finds the pan
+	{
+		const Camera camera{ 1.0f, -60.0f, 22.0f };
+		const std::vector<GlobalMotion::Sample> samples = Samples(camera, false, 3);
+		GlobalMotion motion;
+		const GlobalMotion::Estimate fitted = motion.Fit(samples.data(), (int)samples.size());
+		const double us = FitMicroseconds(motion, samples);
+		std::printf("reach: %s inliers %.2f, %.0f us\n", Name(fitted.Type), fitted.InlierRatio, us);
+		CHECK(!fitted.Valid());
+		CHECK(us < 2000.0);
+
+		// The current frame's texture moved by -Pan since the previous one
+		const std::vector<float> current = Thumbnail(-camera.PanX, -camera.PanY);
+		const std::vector<float> previous = Thumbnail(0.0f, 0.0f);
+		const GlobalMotion::Estimate model = motion.PhaseCorrelate(current.data(), previous.data(), Width, Height);
+		const double epe = ModelError(model, camera);
+		std::printf("       %s peak %.2f (%.2f, %.2f) EPE %.3f\n", Name(model.Type), model.InlierRatio, model.H[2], model.H[5], epe);
+		CHECK(model.Type == GlobalMotion::Model::Translation);
+		CHECK(model.InlierRatio >= GlobalMotion::MinCorrelationPeak);
+		// A thumbnail texel is 15 x 8.4 flow pixels
+		CHECK(epe < 4.0);
+		// Good enough to seed the search, not to replace the coarse levels
+		CHECK(!FlowTuning::TrustGlobalMotion(model));
+	}
+
+	return Test::Result();
+}
@@ -0,0 +1,166 @@
+#include "TestCommon.h"
+#include <Pipeline/Generation/QualityLadder.h>
+#include <vector>
+
+// [Quality Ladder] QualityLadder replayed on per-rung timings: a frame costs 'Base' ms plus what every rung still
+// on costs, with optional noise.
+static constexpr float RungCost[QualityLadder::RungCount] = { 2.5f, 0.6f, 0.3f, 0.3f, 1.5f, 2.0f };
+static constexpr unsigned AllRungs = (1u << QualityLadder::RungCount) - 1;
+
+struct Timings
+{
+	float Base = 0.0f;
+	float Noise = 0.0f; // Relative standard deviation
+	std::mt19937 Rng{ 7 };
+
+	float Cost(const QualityLadder& ladder)
+	{
+		float cost = Base;
+		for (int rung = 0; rung < QualityLadder::RungCount; ++rung)
+		{
+			if (!ladder.IsDropped(rung)) cost += RungCost[rung];
+		}
+		if (Noise <= 0.0f) return cost;
+		std::normal_distribution<float> noise(1.0f, Noise);
+		return cost * noise(Rng);
+	}
+};
+
+struct Event
+{
+	int Frame;
+	int Rung;
+	bool Dropped;
+};
+
+// Replays 'frames' frames, Base from 'baseAt', and returns every drop and restore
+template<typename BaseAt>
+static std::vector<Event> Replay(QualityLadder& ladder, Timings& timings, int frames, float budget, unsigned available, BaseAt&& baseAt)
+{
+	std::vector<Event> events;
+	for (int f = 0; f < frames; ++f)
+	{
+		timings.Base = baseAt(f);
+		bool dropped[QualityLadder::RungCount];
+		for (int rung = 0; rung < QualityLadder::RungCount; ++rung) dropped[rung] = ladder.IsDropped(rung);
+		if (!ladder.Update(timings.Cost(ladder), budget, available)) continue;
+		for (int rung = 0; rung < QualityLadder::RungCount; ++rung)
+		{
+			if (ladder.IsDropped(rung) != dropped[rung]) events.push_back({ f, rung, ladder.IsDropped(rung) });
+		}
+	}
+	return events;
+}
+
+static void Print(const char* name, const std::vector<Event>& events)
+{
+	std::printf("%s:", name);
+	for (const Event& e : events) std::printf(" %c%d@%d", e.Dropped ? '-' : '+', e.Rung, e.Frame);
+	std::printf("\n");
+}
+
+int main()
+{
+	// Fits: nothing dropped
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings{ 1.0f, 0.05f };
+		auto events = Replay(ladder, timings, 3000, 10.0f, AllRungs, [](int) { return 1.0f; });
+		CHECK(events.empty());
+	}
+
+	// Heavy scene, then a light one: rungs go in ladder order until the cost fits, then come back in reverse, each
+	// only after UpFrames of fitting. Bi-Dir was dropped before its saving could be measured, the expected one
+	// (a share of the 15 ms then) keeps it out until MaxUpFrames.
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings;
+		auto events = Replay(ladder, timings, 6000, 10.0f, AllRungs, [](int f) { return f < 2000 ? 8.0f : 0.5f; });
+		Print("heavy -> light", events);
+
+		std::vector<Event> drops, restores;
+		for (const Event& e : events) (e.Dropped ? drops : restores).push_back(e);
+		// 8 + 7.2 ms: Bi-Dir, Sub-Pixel, Edge Protection, Motion Smoothing, Pyramid Level bring it to 10
+		CHECK(drops.size() == 5);
+		for (size_t i = 0; i < drops.size(); ++i) CHECK(drops[i].Rung == (int)i && drops[i].Frame < 2000);
+		CHECK(restores.size() == drops.size());
+		for (size_t i = 0; i < restores.size(); ++i) CHECK(restores[i].Rung == drops[drops.size() - 1 - i].Rung);
+		CHECK(ladder.GetDroppedCount() == 0);
+
+		int previous = 1999; // Last heavy frame
+		for (const Event& e : restores)
+		{
+			CHECK(e.Frame - previous >= QualityLadder::UpFrames);
+			previous = e.Frame;
+		}
+		if (restores.size() >= 2) CHECK(restores.back().Frame - restores[restores.size() - 2].Frame >= QualityLadder::MaxUpFrames);
+
+		// Every restore measures what the rung costs
+		for (int rung = 0; rung < (int)drops.size(); ++rung)
+		{
+			std::printf("  %-20s saving %.2f ms (costs %.2f)\n", QualityLadder::Rungs[rung].Name, ladder.GetSaving(rung), RungCost[rung]);
+			CHECK(std::fabs(ladder.GetSaving(rung) - RungCost[rung]) < 0.01f);
+		}
+	}
+
+	// A drop that ends the cascade is measured before anything else changes
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings;
+		Replay(ladder, timings, 200, 10.0f, AllRungs, [](int) { return 8.0f; });
+		CHECK(ladder.GetLastDropped() == QualityLadder::PyramidLevel);
+		CHECK(std::fabs(ladder.GetSaving(QualityLadder::PyramidLevel) - RungCost[QualityLadder::PyramidLevel]) < 0.01f);
+	}
+
+	// Steady load between the margin and the budget with noise: no flip-flopping
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings{ 2.9f, 0.08f, std::mt19937(3) };
+		auto events = Replay(ladder, timings, 20000, 7.0f, AllRungs, [](int) { return 2.9f; });
+		std::printf("boundary: %zu changes, %d dropped\n", events.size(), ladder.GetDroppedCount());
+		CHECK(events.size() <= 8);
+	}
+
+	// Rungs that change nothing for the settings are skipped
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings;
+		const unsigned available = AllRungs & ~(1u << QualityLadder::BiDirFlow) & ~(1u << QualityLadder::MotionSmoothing);
+		auto events = Replay(ladder, timings, 400, 7.0f, available, [](int) { return 8.0f; });
+		Print("unavailable rungs", events);
+		for (const Event& e : events) CHECK(e.Rung != QualityLadder::BiDirFlow && e.Rung != QualityLadder::MotionSmoothing);
+		CHECK(!events.empty() && events.front().Rung == QualityLadder::SubPixel);
+	}
+
+	// Single spikes (one frame in 50 at 2.5x) do not drop a rung
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		int changes = 0;
+		for (int f = 0; f < 3000; ++f)
+			changes += ladder.Update(f % 50 == 0 ? 12.5f : 5.0f, 7.0f, AllRungs);
+		std::printf("spikes: %d changes\n", changes);
+		CHECK(changes == 0);
+	}
+
+	// A sudden lasting overload is answered within DownFrames plus the smoothing
+	{
+		QualityLadder ladder;
+		ladder.Reset();
+		Timings timings;
+		auto events = Replay(ladder, timings, 400, 10.0f, AllRungs, [](int f) { return f < 200 ? 1.0f : 5.0f; });
+		CHECK(!events.empty() && events.front().Dropped && events.front().Frame >= 200);
+		if (!events.empty())
+		{
+			std::printf("reaction: %d frames\n", events.front().Frame - 200);
+			CHECK(events.front().Frame - 200 <= 6);
+		}
+	}
+
+	return Test::Result();
+}
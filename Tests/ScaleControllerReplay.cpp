@@ -0,0 +1,138 @@
+#include "TestCommon.h"
+#include <Pipeline/Generation/ScaleController.h>
+#include <functional>
+
+// [Dynamic Resolution] ScaleController replayed on synthetic cost traces: the generation cost of a frame is
+// 'Base' ms at full resolution scaling with the area, plus a resolution independent 'Fixed' part, with a few
+// percent of noise. Budget 4 ms throughout.
+static constexpr float Budget = 4.0f;
+
+struct Trace
+{
+	float Base = 0.0f;
+	float Fixed = 0.0f;
+	float Noise = 0.05f; // Relative standard deviation
+	unsigned Seed = 1;
+	std::function<float(int)> BaseAt = nullptr; // Optional: Base per frame
+};
+
+struct Replay
+{
+	int FinalStep = 0;
+	float FinalScale = 0.0f;
+	float FinalCost = 0.0f; // Noise free cost at the final scale
+	int Changes = 0;
+	int MaxStep = 0;
+	int LastChange = -1; // Frame
+};
+
+static Replay Run(float maxScale, int frames, const Trace& trace)
+{
+	ScaleController controller;
+	controller.Reset(maxScale);
+	std::mt19937 rng(trace.Seed);
+	std::normal_distribution<float> noise(1.0f, trace.Noise);
+	Replay replay;
+	float base = trace.Base;
+	for (int f = 0; f < frames; ++f)
+	{
+		if (trace.BaseAt) base = trace.BaseAt(f);
+		float scale = controller.GetScale();
+		float cost = (base * scale * scale + trace.Fixed) * noise(rng);
+		if (controller.Update(cost, Budget))
+		{
+			++replay.Changes;
+			replay.LastChange = f;
+		}
+		replay.MaxStep = std::max(replay.MaxStep, controller.GetStep());
+	}
+	replay.FinalStep = controller.GetStep();
+	replay.FinalScale = controller.GetScale();
+	replay.FinalCost = base * replay.FinalScale * replay.FinalScale + trace.Fixed;
+	return replay;
+}
+
+static void Print(const char* name, const Replay& r)
+{
+	std::printf("%-26s final step %d (scale %.2f, cost %.2f ms), deepest %d, %d changes, last at frame %d\n",
+		name, r.FinalStep, r.FinalScale, r.FinalCost, r.MaxStep, r.Changes, r.LastChange);
+}
+
+int main()
+{
+	// Steady load that fits: never leaves the user's scale
+	Replay fits = Run(0.67f, 2000, { .Base = 6.0f, .Fixed = 0.5f });
+	Print("steady, fits", fits);
+	CHECK(fits.Changes == 0 && fits.FinalStep == 0);
+
+	// Steady load over budget: settles on a step that fits within a few changes, and holds it
+	Replay heavy = Run(1.0f, 2000, { .Base = 10.0f, .Fixed = 0.5f });
+	Print("steady, heavy", heavy);
+	CHECK(heavy.FinalStep > 0 && heavy.Changes <= 3);
+	CHECK(heavy.FinalCost <= Budget);
+	CHECK(heavy.LastChange < 100);
+
+	// Steady load between two steps with more noise: no flip-flopping
+	Replay boundary = Run(1.0f, 5000, { .Base = 6.0f, .Fixed = 0.3f, .Noise = 0.1f, .Seed = 2 });
+	Print("steady, between steps", boundary);
+	CHECK(boundary.Changes <= 8);
+
+	// Isolated spikes (one frame in 97 five times the cost) are smoothed away
+	{
+		ScaleController controller;
+		controller.Reset(0.67f);
+		int changes = 0;
+		for (int f = 0; f < 3000; ++f)
+			changes += controller.Update(f % 97 == 0 ? 10.0f : 2.0f, Budget);
+		std::printf("%-26s step %d, %d changes\n", "isolated spikes", controller.GetStep(), changes);
+		CHECK(changes == 0 && controller.GetStep() == 0);
+	}
+
+	// Far over budget at any scale: stops at the last step (MinScale), never past it
+	Replay floor = Run(1.0f, 1000, { .Base = 100.0f, .Fixed = 10.0f });
+	Print("over budget at every step", floor);
+	CHECK(floor.FinalStep == ScaleController::StepCount(1.0f) - 1);
+	CHECK(floor.FinalScale >= ScaleController::MinScale);
+	CHECK(floor.MaxStep == floor.FinalStep);
+
+	// Nearly free: stays at step 0, the user's scale is the ceiling
+	Replay ceiling = Run(0.8f, 1000, { .Base = 0.1f, .Fixed = 0.0f });
+	Print("far under budget", ceiling);
+	CHECK(ceiling.Changes == 0 && ceiling.FinalScale == 0.8f);
+
+	// Heavy scene, then a light one: steps down, then all the way back up
+	Replay heavyToLight = Run(1.0f, 4000, { .Base = 10.0f, .Fixed = 0.5f, .BaseAt = [](int f) { return f < 1500 ? 10.0f : 2.0f; } });
+	Print("heavy -> light", heavyToLight);
+	CHECK(heavyToLight.MaxStep > 0 && heavyToLight.FinalStep == 0);
+
+	// Light, then heavy: reacts within the settle, smoothing and DownFrames delays
+	{
+		ScaleController controller;
+		controller.Reset(1.0f);
+		int reaction = -1;
+		for (int f = 0; f < 600; ++f)
+		{
+			float scale = controller.GetScale();
+			float cost = (f < 300 ? 3.0f : 9.0f) * scale * scale;
+			if (controller.Update(cost, Budget) && f >= 300 && reaction < 0) reaction = f - 300;
+		}
+		std::printf("%-26s %d frames\n", "light -> heavy reaction", reaction);
+		CHECK(reaction >= 0 && reaction <= 20);
+	}
+
+	// Cost cliff above scale 0.8 (a texture no longer fits the cache): the area model predicts every step up from
+	// below it fits, none holds. The wait doubles after each failed try, so the retries thin out.
+	{
+		ScaleController controller;
+		controller.Reset(1.0f);
+		int changes = 0;
+		for (int f = 0; f < 20000; ++f)
+			changes += controller.Update(controller.GetScale() >= 0.8f ? 6.0f : 2.0f, Budget);
+		std::printf("%-26s step %d, %d changes\n", "cost cliff retries", controller.GetStep(), changes);
+		// Retrying every UpFrames would take ~600
+		CHECK(changes <= 80);
+		CHECK(controller.GetScale() < 0.8f);
+	}
+
+	return Test::Result();
+}
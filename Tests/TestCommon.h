@@ -0,0 +1,135 @@
+#pragma once
+#include <Pipeline/CPU/CPUImage.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+// Shared helpers of the portable tests and benchmarks: a failure counter, synthetic sequences with known motion
+// and a wall clock. Every test is its own executable, main returns Test::Result().
+namespace Test
+{
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	inline int Result()
+	{
+		std::printf(Failures() ? "FAILED (%d)\n" : "OK\n", Failures());
+		return Failures() ? 1 : 0;
+	}
+
+	// Benchmarks take --quick (small frames, few repetitions) so CTest can keep them running
+	inline bool Quick(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			if (std::strcmp(argv[i], "--quick") == 0) return true;
+		}
+		return false;
+	}
+
+	inline double NowMs()
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Smooth value noise, not periodic
+	inline float Noise(float x, float y)
+	{
+		auto hash = [](int i, int j)
+		{
+			uint32_t v = (uint32_t)i * 374761393u + (uint32_t)j * 668265263u;
+			v = (v ^ (v >> 13)) * 1274126177u;
+			return (v & 0xffff) / 65535.0f;
+		};
+		int xi = (int)std::floor(x);
+		int yi = (int)std::floor(y);
+		float tx = x - xi;
+		float ty = y - yi;
+		tx = tx * tx * (3.0f - 2.0f * tx);
+		ty = ty * ty * (3.0f - 2.0f * ty);
+		return CPU::Lerp(CPU::Lerp(hash(xi, yi), hash(xi + 1, yi), tx), CPU::Lerp(hash(xi, yi + 1), hash(xi + 1, yi + 1), tx), ty);
+	}
+
+	// Two octaves, 'scale' is the coarse feature size in pixels
+	inline float Texture(float x, float y, float scale)
+	{
+		return 0.6f * Noise(x / scale, y / scale) + 0.4f * Noise(x / (scale * 0.37f) + 100.0f, y / (scale * 0.37f));
+	}
+
+	struct Motion
+	{
+		float BackgroundX = 0.0f; // Pixels per frame
+		float BackgroundY = 0.0f;
+		float ObjectX = 0.0f; // A textured square of a fifth of the width
+		float ObjectY = 0.0f;
+	};
+
+	// Frame 't' of a panning background with a moving square. 'truth' (optional): the exact motion in the
+	// OpticalFlow convention (current pixel -> its match in frame t - 1).
+	inline CPU::ColorImage Frame(int width, int height, int t, const Motion& m, CPU::MotionField* truth = nullptr)
+	{
+		CPU::ColorImage image(width, height);
+		if (truth) truth->Resize(width, height);
+
+		float ox = width * 0.3f + m.ObjectX * t;
+		float oy = height * 0.4f + m.ObjectY * t;
+		float size = (float)(width / 5);
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				bool inObject = x >= ox && x < ox + size && y >= oy && y < oy + size;
+				float v = inObject ? Texture(x - ox + 500.0f, y - oy + 500.0f, 4.0f) : Texture(x - m.BackgroundX * t, y - m.BackgroundY * t, 8.0f);
+				image.At(x, y) = { v, 0.5f * v + 0.25f, 1.0f - v, 1.0f };
+				if (truth) truth->At(x, y) = inObject ? CPU::Float2{ -m.ObjectX, -m.ObjectY } : CPU::Float2{ -m.BackgroundX, -m.BackgroundY };
+			}
+		}
+		return image;
+	}
+
+	// Gaussian noise on every channel (sensor grain, dithering)
+	inline void AddNoise(CPU::ColorImage& image, float sigma, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::normal_distribution<float> noise(0.0f, sigma);
+		for (CPU::Float4& p : image.Pixels)
+		{
+			p.r += noise(rng);
+			p.g += noise(rng);
+			p.b += noise(rng);
+		}
+	}
+
+	// Mean endpoint error, 'border' pixels excluded on every side
+	inline double EndpointError(const CPU::MotionField& motion, const CPU::MotionField& truth, int border = 0)
+	{
+		double sum = 0.0;
+		long long count = 0;
+		for (int y = border; y < truth.Height - border; ++y)
+		{
+			for (int x = border; x < truth.Width - border; ++x)
+			{
+				sum += CPU::Length(motion.At(x, y) - truth.At(x, y));
+				++count;
+			}
+		}
+		return count > 0 ? sum / count : 0.0;
+	}
+}
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+			++Test::Failures(); \
+		} \
+	} while (0)